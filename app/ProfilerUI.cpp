@@ -67,6 +67,9 @@ void ProfilerUI::update() {
         aggregatedStats[std::string(e.name)].add(e.durationMs);
     }
 
+    /* keep the latest counter values */
+    counters = ChronoProfiler::getCounters();
+
     /* increment total frames */
     totalFrames++;
 }
@@ -102,6 +105,9 @@ void ProfilerUI::render() {
 
     // display aggregated timing statistics
     renderAggregatedStats();
+
+    // display counters (e.g. GPU culling statistics)
+    renderCounters();
 }
 
 /**
@@ -159,4 +165,22 @@ void ProfilerUI::renderAggregatedStats() {
     }
 }
 
-#endif // PROFILER
\ No newline at end of file
+/**
+ * @brief Render the latest value of every counter
+ *
+ * Counters are printed in creation order; nothing is printed when the
+ * application has not set any.
+ */
+void ProfilerUI::renderCounters() {
+    if (counters.empty()) {
+        return;
+    }
+
+    std::cout << "\n-- Counters --\n";
+    for (const auto& counter : counters) {
+        std::cout << std::setw(20) << std::left << counter.name
+                  << std::fixed << std::setprecision(0) << counter.value << "\n";
+    }
+}
+
+#endif // PROFILER
@@ -142,6 +142,7 @@ public:
      *    when capacity is exceeded
      *  - update 'aggregatedStats' for each zone encountered
      *  - increment the absolute 'totalFrames' counter used for frame labels
+     *  - snapshot the ChronoProfiler counters
      *
      * Thread-safety: this function acquires 'uiMutex'.
      */
@@ -154,6 +155,7 @@ public:
      *  - a header line with the absolute frame number ('totalFrames')
      *  - an ASCII bar visualization of the most recent frame's zones
      *  - a table of aggregated statistics (Zone, Avg, Max, Count)
+     *  - the latest value of every counter
      *
      * @note 'render()' **forces output flushing** via 'std::flush'
      *       so UI updates appear immediately in interactive terminals.
@@ -187,6 +189,9 @@ private:
      */
     std::unordered_map<std::string, ZoneStats> aggregatedStats;
 
+    /** @brief Counter values captured by the last 'update()'. */
+    std::vector<ChronoProfiler::Counter> counters;
+
     std::mutex uiMutex; ///< Protects 'update()' and 'render()'.
 
     /**
@@ -219,6 +224,11 @@ private:
      * ChronoProfiler::exportToJSON() for JSON export of raw events.
      */
     void renderAggregatedStats();
+
+    /**
+     * @brief Print the latest counter values (Counter, Value).
+     */
+    void renderCounters();
 };
 
 #else // ======================= NO-OP VERSION ======================= //
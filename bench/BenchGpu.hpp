@@ -0,0 +1,186 @@
+#pragma once
+#include "../include/GpuAllocator.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+#include <vulkan/vulkan_raii.hpp>
+
+/**
+ * @file BenchGpu.hpp
+ * @brief Headless Vulkan device shared by the benches that need one.
+ *
+ * Creates an instance without layers, picks the first physical device (no
+ * window, no surface) and a device with queue 0 of one queue family, plus
+ * the allocator, a command pool and a fence on that queue:
+ *
+ * @code
+ * bench::Gpu gpu;
+ * bench::createGpu(gpu, "bench_example");
+ * vk::raii::CommandBuffer commandBuffer = bench::allocateCommandBuffer(gpu);
+ * // ... record
+ * bench::submitAndWait(gpu, commandBuffer);
+ * @endcode
+ *
+ * A bench that has to look at the physical device before the device is
+ * created calls selectGpu() and createDevice() instead of createGpu().
+ */
+namespace bench {
+
+/** @brief Chooses the queue family of Gpu::queue. */
+using FamilyFilter = std::function<bool(const vk::QueueFamilyProperties &)>;
+
+/** @brief Families that can draw (the default). */
+inline bool hasGraphics(const vk::QueueFamilyProperties &family) {
+  return static_cast<bool>(family.queueFlags & vk::QueueFlagBits::eGraphics);
+}
+
+/** @brief What a bench needs from its device. */
+struct DeviceOptions {
+  FamilyFilter family = hasGraphics;   ///< First passing family gets 'queue'
+  const void *features = nullptr;      ///< VkDeviceCreateInfo::pNext chain
+  bool deviceAddress = false;          ///< Allocator's deviceAddress flag
+  std::vector<uint32_t> otherFamilies; ///< Also get queue 0 of these
+};
+
+/** @brief Headless device, its allocator and one queue. */
+struct Gpu {
+  vk::raii::Context context;                      ///< Loader entry points
+  vk::raii::Instance instance = nullptr;          ///< Instance, no layers
+  vk::raii::PhysicalDevice physicalGPU = nullptr; ///< First device found
+  vk::raii::Device device = nullptr;              ///< Logical device
+  std::unique_ptr<GpuAllocator> allocator;        ///< All bench memory
+  uint32_t family = 0;                            ///< Family of 'queue'
+  vk::raii::Queue queue = nullptr;                ///< Queue 0 of 'family'
+  vk::raii::CommandPool commandPool = nullptr;    ///< Resettable buffers
+  vk::raii::Fence fence = nullptr;                ///< Unsignaled when idle
+};
+
+/**
+ * @brief Creates the instance and picks the first physical device.
+ *
+ * @throws std::runtime_error if there is no Vulkan device.
+ */
+inline void selectGpu(Gpu &gpu, const char *name) {
+  vk::ApplicationInfo appInfo{};
+  appInfo.pApplicationName = name;
+  appInfo.apiVersion = VK_API_VERSION_1_3;
+
+  vk::InstanceCreateInfo instanceInfo{};
+  instanceInfo.pApplicationInfo = &appInfo;
+#if defined(__APPLE__)
+  const char *portability = VK_KHR_PORTABILITY_ENUMERATION_EXTENSION_NAME;
+  instanceInfo.flags = vk::InstanceCreateFlagBits::eEnumeratePortabilityKHR;
+  instanceInfo.enabledExtensionCount = 1;
+  instanceInfo.ppEnabledExtensionNames = &portability;
+#endif
+  gpu.instance = vk::raii::Instance(gpu.context, instanceInfo);
+
+  std::vector<vk::raii::PhysicalDevice> gpus =
+      gpu.instance.enumeratePhysicalDevices();
+  if (gpus.empty()) {
+    throw std::runtime_error("No Vulkan device found");
+  }
+  gpu.physicalGPU = std::move(gpus.front());
+}
+
+/**
+ * @brief Creates the device, its queue, pool, fence and allocator on the
+ * device picked by selectGpu().
+ *
+ * @throws std::runtime_error if no queue family passes 'options.family'.
+ */
+inline void createDevice(Gpu &gpu, const DeviceOptions &options = {}) {
+  const std::vector<vk::QueueFamilyProperties> families =
+      gpu.physicalGPU.getQueueFamilyProperties();
+  const auto family =
+      std::find_if(families.begin(), families.end(), options.family);
+  if (family == families.end()) {
+    throw std::runtime_error("No suitable queue family");
+  }
+  gpu.family = static_cast<uint32_t>(std::distance(families.begin(), family));
+
+  const float priority = 1.0f;
+  std::vector<vk::DeviceQueueCreateInfo> queueInfos(1);
+  queueInfos[0].queueFamilyIndex = gpu.family;
+  queueInfos[0].queueCount = 1;
+  queueInfos[0].pQueuePriorities = &priority;
+  for (uint32_t other : options.otherFamilies) {
+    if (other != gpu.family) {
+      queueInfos.push_back(queueInfos[0]);
+      queueInfos.back().queueFamilyIndex = other;
+    }
+  }
+  vk::DeviceCreateInfo deviceInfo{};
+  deviceInfo.pNext = options.features;
+  deviceInfo.queueCreateInfoCount = static_cast<uint32_t>(queueInfos.size());
+  deviceInfo.pQueueCreateInfos = queueInfos.data();
+  gpu.device = vk::raii::Device(gpu.physicalGPU, deviceInfo);
+  gpu.allocator = std::make_unique<GpuAllocator>(
+      gpu.physicalGPU, gpu.device, GpuAllocator::kMaxBlockSize,
+      options.deviceAddress);
+  gpu.queue = vk::raii::Queue(gpu.device, gpu.family, 0);
+
+  vk::CommandPoolCreateInfo poolInfo{};
+  poolInfo.flags = vk::CommandPoolCreateFlagBits::eResetCommandBuffer |
+                   vk::CommandPoolCreateFlagBits::eTransient;
+  poolInfo.queueFamilyIndex = gpu.family;
+  gpu.commandPool = vk::raii::CommandPool(gpu.device, poolInfo);
+  gpu.fence = vk::raii::Fence(gpu.device, vk::FenceCreateInfo{});
+}
+
+/** @brief selectGpu() followed by createDevice(). */
+inline void createGpu(Gpu &gpu, const char *name,
+                      const DeviceOptions &options = {}) {
+  selectGpu(gpu, name);
+  createDevice(gpu, options);
+}
+
+/** @brief Creates a buffer and binds memory from the allocator. */
+inline vk::raii::Buffer
+createBuffer(const Gpu &gpu, vk::DeviceSize size, vk::BufferUsageFlags usage,
+             vk::MemoryPropertyFlags properties,
+             GpuAllocator::Category category, GpuAllocation &memory,
+             GpuAllocator::Usage lifetime = GpuAllocator::Usage::eGeneral) {
+  vk::BufferCreateInfo bufferInfo{};
+  bufferInfo.size = size;
+  bufferInfo.usage = usage;
+  bufferInfo.sharingMode = vk::SharingMode::eExclusive;
+  vk::raii::Buffer buffer(gpu.device, bufferInfo);
+  memory = gpu.allocator->allocate(buffer, properties, category, lifetime);
+  return buffer;
+}
+
+/** @brief Allocates a primary command buffer from the gpu's pool. */
+inline vk::raii::CommandBuffer allocateCommandBuffer(const Gpu &gpu) {
+  vk::CommandBufferAllocateInfo allocInfo{};
+  allocInfo.commandPool = *gpu.commandPool;
+  allocInfo.level = vk::CommandBufferLevel::ePrimary;
+  allocInfo.commandBufferCount = 1;
+  return std::move(vk::raii::CommandBuffers(gpu.device, allocInfo).front());
+}
+
+/**
+ * @brief Submits a recorded command buffer to the gpu's queue and waits
+ * for it.
+ *
+ * @throws std::runtime_error if the fence wait fails.
+ */
+inline void submitAndWait(const Gpu &gpu,
+                          const vk::raii::CommandBuffer &commandBuffer) {
+  vk::SubmitInfo submitInfo{};
+  submitInfo.commandBufferCount = 1;
+  submitInfo.pCommandBuffers = &*commandBuffer;
+  gpu.queue.submit(submitInfo, *gpu.fence);
+  if (gpu.device.waitForFences(*gpu.fence, vk::True, UINT64_MAX) !=
+      vk::Result::eSuccess) {
+    throw std::runtime_error("Fence wait failed");
+  }
+  gpu.device.resetFences(*gpu.fence);
+}
+
+} // namespace bench
@@ -0,0 +1,223 @@
+/**
+ * @file bench_allocator.cpp
+ * @brief Stress test of the TLSF block allocator used by GpuAllocator,
+ *        against a first-fit free list over the same blocks.
+ *
+ * Usage:
+ * @code
+ * make bench RELEASE=1
+ * ./build/bench_allocator [operations] [live]
+ * @endcode
+ *
+ * The workload mimics a renderer streaming assets: resource sizes are
+ * log-uniform between 256 B and 16 MiB (beyond that GpuAllocator makes a
+ * dedicated allocation), alignments are 256 B to 64 KiB, and after a warm
+ * up to 'live' resources (default 2000) every operation frees a random one
+ * and allocates a new one, for 'operations' operations (default 1000000).
+ * Both allocators place resources in 64 MiB blocks, trying every block
+ * before adding one, as GpuAllocator does; only offsets are managed, so no
+ * GPU is needed.
+ *
+ * Reported per allocator: ns per allocate + free, blocks at the end (the
+ * vkAllocateMemory calls that would be made), used and free bytes, and
+ * fragmentation: 1 - (sum of each block's largest free range) / (free
+ * bytes), the metric GpuAllocator publishes to the profiler.
+ */
+#include "../include/TlsfAllocator.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::high_resolution_clock;
+
+/** @brief Block size, as GpuAllocator::kMaxBlockSize. */
+constexpr uint64_t kBlockSize = 64ull << 20;
+
+/** @brief Resource size and alignment. */
+struct Request {
+  uint64_t size = 0;      ///< Bytes
+  uint64_t alignment = 0; ///< Power of two
+};
+
+/** @brief Allocation in one of the blocks of a BlockSet. */
+struct Placed {
+  size_t block = 0;                ///< Index in BlockSet
+  TlsfAllocator::Allocation range; ///< Range in that block
+};
+
+/** @brief First-fit free list (offset -> size), merging on free. */
+class FirstFit {
+public:
+  explicit FirstFit(uint64_t capacity) { freeRanges[0] = capacity; }
+
+  TlsfAllocator::Allocation allocate(uint64_t size, uint64_t alignment) {
+    for (auto it = freeRanges.begin(); it != freeRanges.end(); ++it) {
+      const uint64_t aligned =
+          (it->first + alignment - 1) / alignment * alignment;
+      const uint64_t end = it->first + it->second;
+      if (aligned + size > end) {
+        continue;
+      }
+      const uint64_t start = it->first;
+      freeRanges.erase(it);
+      if (aligned > start) {
+        freeRanges[start] = aligned - start;
+      }
+      if (end > aligned + size) {
+        freeRanges[aligned + size] = end - aligned - size;
+      }
+      usedBytes += size;
+      live++;
+      return {aligned, size, 0};
+    }
+    return {};
+  }
+
+  void free(const TlsfAllocator::Allocation &range) {
+    usedBytes -= range.size;
+    live--;
+    uint64_t start = range.offset;
+    uint64_t size = range.size;
+    auto next = freeRanges.lower_bound(start);
+    if (next != freeRanges.begin()) {
+      auto prev = std::prev(next);
+      if (prev->first + prev->second == start) {
+        start = prev->first;
+        size += prev->second;
+        freeRanges.erase(prev);
+      }
+    }
+    if (next != freeRanges.end() && next->first == range.offset + range.size) {
+      size += next->second;
+      freeRanges.erase(next);
+    }
+    freeRanges[start] = size;
+  }
+
+  uint64_t used() const { return usedBytes; }
+
+  uint64_t largestFree() const {
+    uint64_t largest = 0;
+    for (const auto &[offset, size] : freeRanges) {
+      largest = std::max(largest, size);
+    }
+    return largest;
+  }
+
+private:
+  std::map<uint64_t, uint64_t> freeRanges;
+  uint64_t usedBytes = 0;
+  size_t live = 0;
+};
+
+/** @brief 64 MiB blocks of one allocator type, grown on demand. */
+template <typename Allocator> class BlockSet {
+public:
+  Placed allocate(const Request &request) {
+    for (size_t i = 0; i < blocks.size(); i++) {
+      const TlsfAllocator::Allocation range =
+          blocks[i]->allocate(request.size, request.alignment);
+      if (range.offset != TlsfAllocator::kNoSpace) {
+        return {i, range};
+      }
+    }
+    blocks.push_back(std::make_unique<Allocator>(kBlockSize));
+    return {blocks.size() - 1,
+            blocks.back()->allocate(request.size, request.alignment)};
+  }
+
+  void free(const Placed &placed) { blocks[placed.block]->free(placed.range); }
+
+  /** @brief Prints the state of the blocks after a run. */
+  void report(const std::string &label, double nsPerOp) const {
+    uint64_t used = 0;
+    uint64_t largestFree = 0;
+    for (const std::unique_ptr<Allocator> &block : blocks) {
+      used += block->used();
+      largestFree += block->largestFree();
+    }
+    const uint64_t total = kBlockSize * blocks.size();
+    const double fragmentation =
+        total > used ? 1.0 - static_cast<double>(largestFree) /
+                                 static_cast<double>(total - used)
+                     : 0.0;
+    std::cout << "  " << std::left << std::setw(10) << label << std::right
+              << std::fixed << std::setprecision(1) << std::setw(9) << nsPerOp
+              << " ns/op" << std::setw(5) << blocks.size() << " blocks"
+              << std::setw(8) << used / (1 << 20) << " MiB used"
+              << std::setw(8) << (total - used) / (1 << 20) << " MiB free"
+              << std::setprecision(3) << std::setw(8) << fragmentation
+              << " fragmentation\n";
+  }
+
+private:
+  std::vector<std::unique_ptr<Allocator>> blocks;
+};
+
+/** @brief Runs the same request stream through one allocator type. */
+template <typename Allocator>
+void run(const std::string &label, const std::vector<Request> &requests,
+         const std::vector<uint32_t> &victims, size_t live) {
+  BlockSet<Allocator> set;
+  std::vector<Placed> placed;
+  placed.reserve(live);
+  for (size_t i = 0; i < live; i++) {
+    placed.push_back(set.allocate(requests[i]));
+  }
+
+  const Clock::time_point start = Clock::now();
+  for (size_t i = live; i < requests.size(); i++) {
+    Placed &victim = placed[victims[i - live] % live];
+    set.free(victim);
+    victim = set.allocate(requests[i]);
+  }
+  const double ns = std::chrono::duration<double, std::nano>(Clock::now() -
+                                                             start)
+                        .count() /
+                    static_cast<double>(requests.size() - live);
+  set.report(label, ns);
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  const size_t operations =
+      argc > 1 ? static_cast<size_t>(std::max(1ll, std::atoll(argv[1])))
+               : 1000000;
+  const size_t live =
+      argc > 2 ? static_cast<size_t>(std::max(1ll, std::atoll(argv[2])))
+               : 2000;
+
+  std::mt19937 rng(1);
+  std::uniform_real_distribution<double> logSize(std::log2(256.0),
+                                                 std::log2(16.0 * (1 << 20)));
+  std::uniform_int_distribution<int> logAlignment(8, 16);
+  std::vector<Request> requests(live + operations);
+  for (Request &request : requests) {
+    request.size = static_cast<uint64_t>(std::exp2(logSize(rng)));
+    request.alignment = 1ull << logAlignment(rng);
+  }
+  std::vector<uint32_t> victims(operations);
+  for (uint32_t &victim : victims) {
+    victim = static_cast<uint32_t>(rng());
+  }
+
+  std::cout << live << " live resources, " << operations
+            << " free + allocate operations, " << kBlockSize / (1 << 20)
+            << " MiB blocks\n";
+  run<TlsfAllocator>("tlsf", requests, victims, live);
+  run<FirstFit>("first-fit", requests, victims, live);
+  return EXIT_SUCCESS;
+}
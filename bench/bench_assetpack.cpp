@@ -0,0 +1,194 @@
+/**
+ * @file bench_assetpack.cpp
+ * @brief Startup I/O benchmark: loose asset files vs. one mapped asset pack.
+ *
+ * Usage:
+ * @code
+ * make bench RELEASE=1
+ * ./build/bench_assetpack [iterations] [file...]
+ * @endcode
+ *
+ * Three ways of getting every asset's bytes into a staging buffer:
+ * - loose: open + read each file into a std::vector (as vkutils::readFile
+ *   does for shaders), then memcpy it into staging; two CPU copies.
+ * - pack:  map the pack once and memcpy each blob straight from the page
+ *   cache into staging; one CPU copy.
+ * - pack (import): map the pack once and hand page-rounded blob ranges to
+ *   the driver (VK_EXT_external_memory_host); no CPU copy. Only the mapping
+ *   and the page walk are timed here, the GPU copy is not.
+ *
+ * Without file arguments the renderer's baked assets are used when present,
+ * otherwise synthetic blobs of similar sizes are generated.
+ *
+ * @note All files are read from a warm OS page cache, which is the common
+ * case for repeated launches; cold-cache reads favor the pack even more.
+ */
+#include "../include/AssetPack.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+/** @brief Milliseconds elapsed since 'start'. */
+double msSince(std::chrono::high_resolution_clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(
+             std::chrono::high_resolution_clock::now() - start)
+      .count();
+}
+
+/** @brief Reads a whole file the way vkutils::readFile() does. */
+std::vector<char> readFile(const std::string &path) {
+  std::ifstream file(path, std::ios::ate | std::ios::binary);
+  if (!file.is_open()) {
+    throw std::runtime_error("failed to open " + path);
+  }
+  std::vector<char> buffer(static_cast<size_t>(file.tellg()));
+  file.seekg(0);
+  file.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+  return buffer;
+}
+
+/** @brief Writes 'size' bytes of deterministic filler to 'path'. */
+void writeSynthetic(const std::string &path, size_t size) {
+  std::vector<char> data(size);
+  uint32_t state = static_cast<uint32_t>(size);
+  for (char &c : data) {
+    state = state * 1664525u + 1013904223u;
+    c = static_cast<char>(state >> 24);
+  }
+  std::ofstream(path, std::ios::binary)
+      .write(data.data(), static_cast<std::streamsize>(size));
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  const int iterations = argc > 1 ? std::max(1, std::atoi(argv[1])) : 20;
+  const auto tempDir = std::filesystem::temp_directory_path();
+  const std::string packPath = (tempDir / "bench_assetpack.pack").string();
+
+  std::vector<std::string> paths(argv + std::min(argc, 2), argv + argc);
+  std::vector<std::string> synthetic;
+  if (paths.empty()) {
+    for (const char *path :
+         {"models/statue.armesh", "textures/statue.artx", "shaders/vert.spv",
+          "shaders/vert_constcolor.spv", "shaders/frag.spv",
+          "shaders/cull.spv"}) {
+      if (std::filesystem::exists(path)) {
+        paths.push_back(path);
+      }
+    }
+  }
+  if (paths.empty()) {
+    // Mesh cache, BC7 texture with mips and a few shader modules
+    const size_t sizes[] = {24u << 20, 22u << 20, 6u << 10, 5u << 10,
+                            3u << 10, 9u << 10};
+    for (size_t i = 0; i < std::size(sizes); i++) {
+      synthetic.push_back(
+          (tempDir / ("bench_assetpack_" + std::to_string(i) + ".bin"))
+              .string());
+      writeSynthetic(synthetic.back(), sizes[i]);
+    }
+    paths = synthetic;
+  }
+
+  try {
+    std::vector<assetpack::Input> inputs;
+    size_t totalBytes = 0;
+    for (const std::string &path : paths) {
+      inputs.push_back({path, path});
+      totalBytes += std::filesystem::file_size(path);
+    }
+    assetpack::write(packPath, inputs);
+
+    std::vector<std::byte> staging(totalBytes);
+
+    // Loose files: read into a vector, then copy into staging
+    double looseMs = 0.0;
+    size_t looseCopied = 0;
+    for (int i = 0; i < iterations; i++) {
+      auto start = std::chrono::high_resolution_clock::now();
+      size_t offset = 0;
+      for (const std::string &path : paths) {
+        const std::vector<char> data = readFile(path);
+        std::memcpy(staging.data() + offset, data.data(), data.size());
+        offset += data.size();
+        looseCopied += 2 * data.size();
+      }
+      looseMs += msSince(start);
+    }
+
+    // Pack: map once, copy each blob from the mapping into staging
+    double packMs = 0.0;
+    size_t packCopied = 0;
+    for (int i = 0; i < iterations; i++) {
+      auto start = std::chrono::high_resolution_clock::now();
+      auto pack = assetpack::AssetPack::open(packPath);
+      if (!pack) {
+        std::cerr << "Pack rejected immediately after writing it!"
+                  << std::endl;
+        return EXIT_FAILURE;
+      }
+      size_t offset = 0;
+      for (const std::string &path : paths) {
+        const std::span<const std::byte> blob = pack->blob(path);
+        std::memcpy(staging.data() + offset, blob.data(), blob.size());
+        offset += blob.size();
+        packCopied += blob.size();
+      }
+      packMs += msSince(start);
+    }
+
+    // Pack with host-memory import: map once and fault the pages in (the
+    // driver pins them on import); the CPU copies nothing
+    double importMs = 0.0;
+    volatile uint8_t sink = 0;
+    for (int i = 0; i < iterations; i++) {
+      auto start = std::chrono::high_resolution_clock::now();
+      auto pack = assetpack::AssetPack::open(packPath);
+      for (const std::string &path : paths) {
+        const std::span<const std::byte> blob = pack->blob(path);
+        for (size_t b = 0; b < blob.size(); b += assetpack::kBlobAlignment) {
+          sink = sink + static_cast<uint8_t>(blob[b]);
+        }
+      }
+      importMs += msSince(start);
+    }
+
+    auto report = [&](const char *label, double ms, size_t copied) {
+      std::cout << std::left << std::setw(15) << label << std::right
+                << std::fixed << std::setprecision(2) << std::setw(9)
+                << ms / iterations << " ms  " << std::setw(10)
+                << copied / iterations << " bytes copied  "
+                << std::setprecision(0) << std::setw(6)
+                << totalBytes / 1e6 / (ms / iterations / 1000.0)
+                << " MB/s\n";
+    };
+    std::cout << paths.size() << " assets, " << totalBytes << " bytes"
+              << (synthetic.empty() ? "" : " (synthetic)") << ", avg of "
+              << iterations << "\n";
+    report("loose files", looseMs, looseCopied);
+    report("pack", packMs, packCopied);
+    report("pack (import)", importMs, 0);
+    std::cout << "pack speedup:  " << std::setprecision(2)
+              << looseMs / std::max(packMs, 1e-6) << "x\n";
+  } catch (const std::exception &e) {
+    std::cerr << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::filesystem::remove(packPath);
+  for (const std::string &path : synthetic) {
+    std::filesystem::remove(path);
+  }
+  return EXIT_SUCCESS;
+}
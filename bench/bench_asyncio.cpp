@@ -0,0 +1,192 @@
+/**
+ * @file bench_asyncio.cpp
+ * @brief Asset read throughput: blocking reads vs. AsyncFileReader backends.
+ *
+ * Usage:
+ * @code
+ * make bench RELEASE=1
+ * ./build/bench_asyncio [directory] [queueDepth] [blockKiB]
+ * @endcode
+ *
+ * Every regular file below 'directory' (default: textures/ and models/, or a
+ * synthetic 240 MB set when those hold less than 16 MB) is read by:
+ * - blocking:  one file at a time with std::ifstream, like vkutils::readFile
+ * - pool:      AsyncFileReader, ThreadPool backend, O_DIRECT
+ * - io_uring:  AsyncFileReader, io_uring backend, page cache
+ * - io_uring direct: AsyncFileReader, io_uring backend, O_DIRECT
+ *
+ * Wall time, throughput (GB/s) and process CPU time are reported for each.
+ * A warm-up pass loads the files into the page cache first, so buffered
+ * modes measure memory bandwidth while O_DIRECT modes always hit the device;
+ * drop the page cache (or use a larger set) to compare cold reads.
+ */
+#include "../include/AsyncFileReader.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+/** @brief Reads a whole file the way vkutils::readFile() does. */
+size_t readBlocking(const std::string &path) {
+  std::ifstream file(path, std::ios::ate | std::ios::binary);
+  if (!file.is_open()) {
+    throw std::runtime_error("failed to open " + path);
+  }
+  std::vector<char> buffer(static_cast<size_t>(file.tellg()));
+  file.seekg(0);
+  file.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+  return buffer.size();
+}
+
+/** @brief Submits every file, then takes completions as they arrive. */
+size_t readAsync(AsyncFileReader &reader,
+                 const std::vector<std::string> &paths) {
+  for (const std::string &path : paths) {
+    reader.submit(path);
+  }
+  size_t bytes = 0;
+  while (reader.pending() > 0) {
+    bytes += reader.waitAny().size;
+  }
+  return bytes;
+}
+
+/** @brief Writes 'size' bytes of deterministic filler to 'path'. */
+void writeSynthetic(const std::string &path, size_t size) {
+  std::vector<char> data(size);
+  uint32_t state = static_cast<uint32_t>(size) ^ 0x9e3779b9u;
+  for (char &c : data) {
+    state = state * 1664525u + 1013904223u;
+    c = static_cast<char>(state >> 24);
+  }
+  std::ofstream(path, std::ios::binary)
+      .write(data.data(), static_cast<std::streamsize>(size));
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  const uint32_t queueDepth =
+      argc > 2 ? static_cast<uint32_t>(std::max(1, std::atoi(argv[2]))) : 64;
+  const uint32_t blockSize =
+      argc > 3 ? static_cast<uint32_t>(std::max(4, std::atoi(argv[3]))) << 10
+               : 1u << 20;
+
+  std::vector<std::string> roots;
+  if (argc > 1) {
+    roots.push_back(argv[1]);
+  } else {
+    roots = {"textures", "models"};
+  }
+  std::vector<std::string> paths;
+  uintmax_t foundBytes = 0;
+  for (const std::string &root : roots) {
+    if (!std::filesystem::is_directory(root)) {
+      continue;
+    }
+    for (const auto &entry :
+         std::filesystem::recursive_directory_iterator(root)) {
+      if (entry.is_regular_file()) {
+        paths.push_back(entry.path().string());
+        foundBytes += entry.file_size();
+      }
+    }
+  }
+
+  const auto syntheticDir =
+      std::filesystem::temp_directory_path() / "bench_asyncio";
+  const bool synthetic = argc <= 1 && foundBytes < (16u << 20);
+  if (synthetic) {
+    paths.clear();
+    // Mix of texture-sized and mesh-sized files
+    std::filesystem::create_directories(syntheticDir);
+    for (int i = 0; i < 48; i++) {
+      const size_t size = i % 3 == 0 ? (12u << 20) + 4321 : (2u << 20) + 17;
+      paths.push_back(
+          (syntheticDir / ("asset_" + std::to_string(i) + ".bin")).string());
+      writeSynthetic(paths.back(), size);
+    }
+  }
+
+  try {
+    size_t totalBytes = 0;
+    for (const std::string &path : paths) {
+      totalBytes += readBlocking(path); // Warm-up: fill the page cache
+    }
+    std::cout << paths.size() << " files, " << totalBytes / 1e6 << " MB"
+              << (synthetic ? " (synthetic)" : "") << ", queue depth "
+              << queueDepth << ", " << (blockSize >> 10) << " KiB blocks\n";
+
+    auto run = [&](const std::string &label,
+                   const std::function<size_t()> &readAll) {
+      const std::clock_t cpuStart = std::clock();
+      const auto start = std::chrono::high_resolution_clock::now();
+      const size_t bytes = readAll();
+      const double seconds =
+          std::chrono::duration<double>(
+              std::chrono::high_resolution_clock::now() - start)
+              .count();
+      const double cpuMs =
+          1000.0 * static_cast<double>(std::clock() - cpuStart) /
+          CLOCKS_PER_SEC;
+      if (bytes != totalBytes) {
+        throw std::runtime_error(label + ": read " + std::to_string(bytes) +
+                                 " bytes, expected " +
+                                 std::to_string(totalBytes));
+      }
+      std::cout << std::left << std::setw(28) << label << std::right
+                << std::fixed << std::setprecision(1) << std::setw(9)
+                << seconds * 1000.0 << " ms " << std::setprecision(2)
+                << std::setw(7) << bytes / 1e9 / seconds << " GB/s "
+                << std::setprecision(1) << std::setw(9) << cpuMs
+                << " ms CPU\n";
+    };
+
+    run("blocking ifstream", [&]() {
+      size_t bytes = 0;
+      for (const std::string &path : paths) {
+        bytes += readBlocking(path);
+      }
+      return bytes;
+    });
+
+    AsyncFileReader::Options options;
+    options.queueDepth = queueDepth;
+    options.blockSize = blockSize;
+
+    options.forceThreadPool = true;
+    {
+      AsyncFileReader reader(options);
+      run(reader.backendName(), [&]() { return readAsync(reader, paths); });
+    }
+
+    options.forceThreadPool = false;
+    for (bool direct : {false, true}) {
+      options.direct = direct;
+      AsyncFileReader reader(options);
+      if (reader.backend() != AsyncFileReader::Backend::eIoUring) {
+        std::cout << "io_uring unavailable, skipped\n";
+        break;
+      }
+      run(reader.backendName(), [&]() { return readAsync(reader, paths); });
+    }
+  } catch (const std::exception &e) {
+    std::cerr << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  if (synthetic) {
+    std::filesystem::remove_all(syntheticDir);
+  }
+  return EXIT_SUCCESS;
+}
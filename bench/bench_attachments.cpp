@@ -0,0 +1,190 @@
+/**
+ * @file bench_attachments.cpp
+ * @brief Attachment memory per resolution and MSAA level, before and after
+ *        transient placement.
+ *
+ * Usage:
+ * @code
+ * make bench RELEASE=1
+ * ./build/bench_attachments
+ * @endcode
+ *
+ * Creates the renderer's MSAA color (B8G8R8A8Srgb) and depth attachments on
+ * a headless device (first GPU, no window) for common swapchain sizes and
+ * every sample count the device supports for both, and reports:
+ * - before: what createColorResources() and createDepthResources() used to
+ *   allocate, one device-local allocation per image (depth without
+ *   eTransientAttachment);
+ * - after: the memory backing the transient images bound by
+ *   TransientAttachments, split into lazily allocated bytes (reserved and
+ *   committed, as vkGetDeviceMemoryCommitment reports them) and shared
+ *   device-local blocks.
+ *
+ * Both images are used by the same render pass, so without lazily
+ * allocated memory (desktop GPUs) they cannot alias each other and "after"
+ * only saves an allocation. The last two columns add a single-sampled,
+ * full-size color target used by a later post-processing pass: separately
+ * allocated, and placed by TransientAttachments::plan(), which aliases it
+ * with the color and depth memory.
+ */
+#include "../include/GpuAllocator.hpp"
+#include "../include/TransientAttachments.hpp"
+#include "BenchGpu.hpp"
+
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <vulkan/vulkan_raii.hpp>
+
+namespace {
+
+using bench::Gpu;
+
+/** @brief First depth format usable as an optimal-tiling attachment. */
+vk::Format findDepthFormat(const Gpu &gpu) {
+  for (vk::Format format :
+       {vk::Format::eD32Sfloat, vk::Format::eD32SfloatS8Uint,
+        vk::Format::eD24UnormS8Uint}) {
+    if (gpu.physicalGPU.getFormatProperties(format).optimalTilingFeatures &
+        vk::FormatFeatureFlagBits::eDepthStencilAttachment) {
+      return format;
+    }
+  }
+  throw std::runtime_error("No depth attachment format");
+}
+
+/** @brief Creates an attachment image without memory. */
+vk::raii::Image createImage(const Gpu &gpu, vk::Extent2D extent,
+                            vk::SampleCountFlagBits samples,
+                            vk::Format format, vk::ImageUsageFlags usage) {
+  vk::ImageCreateInfo imageInfo{};
+  imageInfo.imageType = vk::ImageType::e2D;
+  imageInfo.format = format;
+  imageInfo.extent = vk::Extent3D{extent.width, extent.height, 1};
+  imageInfo.mipLevels = 1;
+  imageInfo.arrayLayers = 1;
+  imageInfo.samples = samples;
+  imageInfo.tiling = vk::ImageTiling::eOptimal;
+  imageInfo.usage = usage;
+  imageInfo.sharingMode = vk::SharingMode::eExclusive;
+  return vk::raii::Image(gpu.device, imageInfo);
+}
+
+/** @brief Bytes as MiB with one decimal. */
+double mib(vk::DeviceSize bytes) {
+  return static_cast<double>(bytes) / (1 << 20);
+}
+
+} // namespace
+
+int main() {
+  const vk::Extent2D extents[] = {
+      {1280, 720}, {1920, 1080}, {2560, 1440}, {3840, 2160}};
+  const vk::Format colorFormat = vk::Format::eB8G8R8A8Srgb;
+  const vk::ImageUsageFlags colorUsage =
+      vk::ImageUsageFlagBits::eTransientAttachment |
+      vk::ImageUsageFlagBits::eColorAttachment;
+  const vk::ImageUsageFlags depthUsage =
+      vk::ImageUsageFlagBits::eDepthStencilAttachment;
+
+  try {
+    Gpu gpu;
+    bench::createGpu(gpu, "bench_attachments");
+    const vk::Format depthFormat = findDepthFormat(gpu);
+    const vk::PhysicalDeviceLimits limits =
+        gpu.physicalGPU.getProperties().limits;
+    const vk::SampleCountFlags sampleCounts =
+        limits.framebufferColorSampleCounts &
+        limits.framebufferDepthSampleCounts;
+
+    std::cout << "Color " << vk::to_string(colorFormat) << " + depth "
+              << vk::to_string(depthFormat) << " on "
+              << gpu.physicalGPU.getProperties().deviceName.data() << "\n"
+              << std::setw(11) << "resolution" << std::setw(6) << "MSAA"
+              << std::setw(12) << "before MiB" << std::setw(11)
+              << "after MiB" << std::setw(10) << "lazy MiB" << std::setw(15)
+              << "committed MiB" << std::setw(13) << "shared MiB"
+              << std::setw(13) << "+post before" << std::setw(12)
+              << "+post after" << "\n";
+
+    for (vk::Extent2D extent : extents) {
+      for (vk::SampleCountFlagBits samples :
+           {vk::SampleCountFlagBits::e1, vk::SampleCountFlagBits::e2,
+            vk::SampleCountFlagBits::e4, vk::SampleCountFlagBits::e8}) {
+        if (!(sampleCounts & samples)) {
+          continue;
+        }
+
+        // Before: one allocation per image, as the renderer used to do
+        vk::DeviceSize before = 0;
+        {
+          vk::raii::Image color =
+              createImage(gpu, extent, samples, colorFormat, colorUsage);
+          vk::raii::Image depth =
+              createImage(gpu, extent, samples, depthFormat, depthUsage);
+          const GpuAllocation colorMemory = gpu.allocator->allocate(
+              color, vk::ImageTiling::eOptimal,
+              vk::MemoryPropertyFlagBits::eDeviceLocal,
+              GpuAllocator::Category::eAttachment);
+          const GpuAllocation depthMemory = gpu.allocator->allocate(
+              depth, vk::ImageTiling::eOptimal,
+              vk::MemoryPropertyFlagBits::eDeviceLocal,
+              GpuAllocator::Category::eAttachment);
+          before = colorMemory.size() + depthMemory.size();
+        }
+
+        // After: both transient, as bindTransientAttachments() binds them
+        vk::raii::Image color =
+            createImage(gpu, extent, samples, colorFormat, colorUsage);
+        vk::raii::Image depth = createImage(
+            gpu, extent, samples, depthFormat,
+            depthUsage | vk::ImageUsageFlagBits::eTransientAttachment);
+        TransientAttachments attachments(gpu.device, *gpu.allocator);
+        attachments.add(color, 0, 0);
+        attachments.add(depth, 0, 0);
+        attachments.bind();
+        const TransientAttachments::Footprint footprint =
+            attachments.footprint();
+
+        // Same images plus a single-sampled target of a later pass
+        vk::raii::Image post = createImage(
+            gpu, extent, vk::SampleCountFlagBits::e1, colorFormat,
+            vk::ImageUsageFlagBits::eColorAttachment |
+                vk::ImageUsageFlagBits::eSampled);
+        const vk::MemoryRequirements colorRequirements =
+            color.getMemoryRequirements();
+        const vk::MemoryRequirements depthRequirements =
+            depth.getMemoryRequirements();
+        const vk::MemoryRequirements postRequirements =
+            post.getMemoryRequirements();
+        const TransientAttachments::Request requests[] = {
+            {colorRequirements.size, colorRequirements.alignment,
+             colorRequirements.memoryTypeBits, 0, 0},
+            {depthRequirements.size, depthRequirements.alignment,
+             depthRequirements.memoryTypeBits, 0, 0},
+            {postRequirements.size, postRequirements.alignment,
+             postRequirements.memoryTypeBits, 1, 1}};
+        const vk::DeviceSize postBefore = before + postRequirements.size;
+        const vk::DeviceSize postAfter =
+            TransientAttachments::plan(requests).bytes();
+
+        std::cout << std::setw(5) << extent.width << "x" << std::left
+                  << std::setw(5) << extent.height << std::right
+                  << std::setw(5) << static_cast<uint32_t>(samples) << "x"
+                  << std::fixed << std::setprecision(1) << std::setw(12)
+                  << mib(before) << std::setw(11)
+                  << mib(footprint.residentBytes()) << std::setw(10)
+                  << mib(footprint.lazyBytes) << std::setw(15)
+                  << mib(footprint.committedBytes) << std::setw(13)
+                  << mib(footprint.aliasedBytes) << std::setw(13)
+                  << mib(postBefore) << std::setw(12) << mib(postAfter)
+                  << "\n";
+      }
+    }
+  } catch (const std::exception &e) {
+    std::cerr << "bench_attachments: " << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
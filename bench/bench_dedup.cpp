@@ -0,0 +1,226 @@
+/**
+ * @file bench_dedup.cpp
+ * @brief Vertex deduplication microbenchmark: unordered_map vs. flat table.
+ *
+ * Usage:
+ * @code
+ * make bench RELEASE=1
+ * ./build/bench_dedup [model.obj] [synthetic corners] [iterations]
+ * @endcode
+ *
+ * Two inputs are measured:
+ * - the corner stream of the given model (default models/statue.obj), and
+ * - a synthetic grid-aligned "scan" with the given number of corners
+ *   (default 50M; pass 0 to skip), where coordinates share most of their
+ *   bits and weak hashes cluster badly.
+ *
+ * Implementations:
+ * - **map (old)**: std::unordered_map with the previous XOR/shift glm hash
+ *   and two lookups per corner ('contains' then 'operator[]'),
+ * - **map (new hash)**: std::unordered_map with vertexhash + try_emplace,
+ * - **flat**: vertexdedup::deduplicate(),
+ * - **sharded/N**: vertexdedup::deduplicateParallel() with N threads.
+ *
+ * All outputs are checked for equality against the old implementation.
+ */
+#define GLM_ENABLE_EXPERIMENTAL
+#include <glm/glm.hpp>
+#include <glm/gtx/hash.hpp>
+
+#include "../include/MeshLoader.hpp"
+#include "../include/ThreadPool.hpp"
+#include "../include/VertexDedup.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+/** @brief Milliseconds elapsed since 'start'. */
+double msSince(std::chrono::high_resolution_clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(
+             std::chrono::high_resolution_clock::now() - start)
+      .count();
+}
+
+/** @brief The hash std::hash<Vertex> used before vertexhash existed. */
+struct LegacyVertexHash {
+  size_t operator()(const Vertex &vertex) const noexcept {
+    size_t posHash = std::hash<glm::vec3>()(vertex.position);
+    size_t colorHash = std::hash<glm::vec3>()(vertex.color);
+    size_t texHash = std::hash<glm::vec2>()(vertex.texCoord);
+    return ((posHash ^ (colorHash << 1)) >> 1) ^ (texHash << 1);
+  }
+};
+
+/** @brief The previous loader loop: two hash lookups per corner. */
+void dedupLegacy(const std::vector<Vertex> &corners, MeshData &mesh) {
+  std::unordered_map<Vertex, uint32_t, LegacyVertexHash> uniqueVertices{};
+  for (const Vertex &vertex : corners) {
+    if (!uniqueVertices.contains(vertex)) {
+      uniqueVertices[vertex] = static_cast<uint32_t>(mesh.vertices.size());
+      mesh.vertices.push_back(vertex);
+    }
+    mesh.indices.push_back(uniqueVertices[vertex]);
+  }
+}
+
+/** @brief unordered_map with the new hash and a single lookup. */
+void dedupMapNewHash(const std::vector<Vertex> &corners, MeshData &mesh) {
+  std::unordered_map<Vertex, uint32_t> uniqueVertices{};
+  for (const Vertex &vertex : corners) {
+    auto [it, inserted] = uniqueVertices.try_emplace(
+        vertex, static_cast<uint32_t>(mesh.vertices.size()));
+    if (inserted) {
+      mesh.vertices.push_back(vertex);
+    }
+    mesh.indices.push_back(it->second);
+  }
+}
+
+/**
+ * @brief Regular grid "scan": two triangles per cell, 6 corners per cell.
+ *
+ * Positions sit on a 1 mm lattice and texcoords follow the grid, which is
+ * representative of structured-light/photogrammetry output.
+ */
+std::vector<Vertex> makeGridCorners(size_t targetCorners) {
+  const size_t cells = std::max<size_t>(1, targetCorners / 6);
+  const size_t side = std::max<size_t>(
+      1, static_cast<size_t>(std::sqrt(static_cast<double>(cells))));
+
+  auto gridVertex = [&](size_t x, size_t y) {
+    Vertex vertex{};
+    vertex.position = {static_cast<float>(x) * 0.001f,
+                       static_cast<float>(y) * 0.001f, 0.0f};
+    vertex.color = {1.0f, 1.0f, 1.0f};
+    vertex.texCoord = {static_cast<float>(x) / side,
+                       1.0f - static_cast<float>(y) / side};
+    return vertex;
+  };
+
+  std::vector<Vertex> corners;
+  corners.reserve(side * side * 6);
+  for (size_t y = 0; y < side; y++) {
+    for (size_t x = 0; x < side; x++) {
+      Vertex a = gridVertex(x, y), b = gridVertex(x + 1, y),
+             c = gridVertex(x + 1, y + 1), d = gridVertex(x, y + 1);
+      corners.insert(corners.end(), {a, b, c, a, c, d});
+    }
+  }
+  return corners;
+}
+
+/** @brief True if both meshes have bit-identical vertices and indices. */
+bool identical(const MeshData &a, const MeshData &b) {
+  return a.vertices.size() == b.vertices.size() && a.indices == b.indices &&
+         std::memcmp(a.vertices.data(), b.vertices.data(),
+                     a.vertices.size() * sizeof(Vertex)) == 0;
+}
+
+/**
+ * @brief Times every implementation on one corner stream.
+ *
+ * @return false if any implementation disagrees with the old one.
+ */
+bool runAll(const std::string &label, const std::vector<Vertex> &corners,
+            int iterations) {
+  auto measure = [&](auto &&dedup, MeshData &out) {
+    double total = 0.0;
+    for (int i = 0; i < iterations; i++) {
+      out = MeshData{};
+      auto start = std::chrono::high_resolution_clock::now();
+      dedup(out);
+      total += msSince(start);
+    }
+    return total / iterations;
+  };
+
+  MeshData reference, mesh;
+  double legacyMs =
+      measure([&](MeshData &out) { dedupLegacy(corners, out); }, reference);
+
+  std::cout << "\n" << label << ": " << corners.size() << " corners -> "
+            << reference.vertices.size() << " unique vertices\n"
+            << std::left << std::setw(18) << "implementation" << std::setw(14)
+            << "ms" << std::setw(14) << "Mcorners/s" << "speedup\n";
+
+  bool ok = true;
+  auto report = [&](const std::string &name, double ms) {
+    bool match = identical(mesh, reference);
+    ok = ok && match;
+    std::cout << std::left << std::setw(18) << name << std::setw(14) << ms
+              << std::setw(14) << corners.size() / 1e3 / std::max(ms, 1e-6)
+              << legacyMs / std::max(ms, 1e-6) << "x"
+              << (match ? "" : "  MISMATCH") << "\n";
+  };
+
+  mesh = reference;
+  report("map (old)", legacyMs);
+  report("map (new hash)",
+         measure([&](MeshData &out) { dedupMapNewHash(corners, out); }, mesh));
+  report("flat",
+         measure([&](MeshData &out) { vertexdedup::deduplicate(corners, out); },
+              mesh));
+
+  const size_t hardware = std::max(1u, std::thread::hardware_concurrency());
+  for (size_t threads = 1;; threads = std::min(threads * 2, hardware)) {
+    ThreadPool pool(threads);
+    report("sharded/" + std::to_string(threads),
+           measure(
+               [&](MeshData &out) {
+                 vertexdedup::deduplicateParallel(corners, out, pool);
+               },
+               mesh));
+    if (threads == hardware) {
+      break;
+    }
+  }
+  return ok;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  const std::string modelPath = argc > 1 ? argv[1] : "models/statue.obj";
+  const size_t syntheticCorners =
+      argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 50'000'000;
+  const int iterations = argc > 3 ? std::max(1, std::atoi(argv[3])) : 3;
+
+  try {
+    bool ok = true;
+
+    // Expanding the indexed mesh reproduces the loader's corner stream
+    MeshData model = meshloader::loadObjParallel(modelPath);
+    std::vector<Vertex> corners;
+    corners.reserve(model.indices.size());
+    for (uint32_t index : model.indices) {
+      corners.push_back(model.vertices[index]);
+    }
+    ok = runAll(modelPath, corners, iterations) && ok;
+
+    if (syntheticCorners > 0) {
+      corners = makeGridCorners(syntheticCorners);
+      ok = runAll("synthetic grid", corners, iterations) && ok;
+    }
+
+    if (!ok) {
+      std::cerr << "Deduplication results differ!" << std::endl;
+      return EXIT_FAILURE;
+    }
+  } catch (const std::exception &e) {
+    std::cerr << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,114 @@
+/**
+ * @file bench_drawbatch.cpp
+ * @brief Draw list sorting: state changes and sort cost of drawbatch keys.
+ *
+ * Usage:
+ * @code
+ * make bench RELEASE=1
+ * ./build/bench_drawbatch [draws] [pipelines] [descriptorSets] [materials]
+ * @endcode
+ *
+ * Builds a synthetic draw list (default 20000 draws over 4 pipelines, 256
+ * descriptor sets and 1024 materials, in random submission order) and
+ * reports, for the list as submitted and after drawbatch::sort():
+ * - pipeline, descriptor set and material binds needed to record it
+ * - the time to sort it, against std::sort and std::stable_sort on the keys
+ */
+#include "../include/DrawBatch.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+/** @brief Prints the binds needed to record 'items' in order. */
+void printChanges(const std::string &label,
+                  const std::vector<drawbatch::DrawItem> &items) {
+  const drawbatch::StateChanges changes = drawbatch::countStateChanges(items);
+  std::cout << std::left << std::setw(12) << label << std::right
+            << std::setw(10) << changes.pipelineBinds << " pipeline "
+            << std::setw(10) << changes.descriptorBinds << " descriptor "
+            << std::setw(10) << changes.materialBinds << " material binds, "
+            << changes.drawCalls << " draws\n";
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  auto arg = [&](int index, uint32_t fallback) {
+    return argc > index
+               ? static_cast<uint32_t>(std::max(1, std::atoi(argv[index])))
+               : fallback;
+  };
+  const uint32_t drawCount = arg(1, 20000);
+  const uint32_t pipelines = arg(2, 4);
+  const uint32_t descriptorSets = arg(3, 256);
+  const uint32_t materials = arg(4, 1024);
+
+  // Each material belongs to one pipeline and descriptor set, like a
+  // material's texture and shader
+  std::mt19937 rng(42);
+  std::vector<uint64_t> materialKeys(materials);
+  for (uint32_t material = 0; material < materials; material++) {
+    materialKeys[material] = drawbatch::makeKey(
+        static_cast<uint32_t>(rng() % pipelines),
+        static_cast<uint32_t>(rng() % descriptorSets), material);
+  }
+  std::vector<drawbatch::DrawItem> submitted(drawCount);
+  for (uint32_t draw = 0; draw < drawCount; draw++) {
+    submitted[draw] = {materialKeys[rng() % materials], draw};
+  }
+
+  std::cout << drawCount << " draws, " << pipelines << " pipelines, "
+            << descriptorSets << " descriptor sets, " << materials
+            << " materials\n";
+  printChanges("submitted", submitted);
+  std::vector<drawbatch::DrawItem> sorted = submitted;
+  drawbatch::sort(sorted);
+  printChanges("sorted", sorted);
+
+  constexpr int kRuns = 50;
+  auto time = [&](const std::string &label,
+                  const std::function<void(std::vector<drawbatch::DrawItem> &)>
+                      &sortItems) {
+    double best = 1e30;
+    for (int run = 0; run < kRuns; run++) {
+      std::vector<drawbatch::DrawItem> items = submitted;
+      const auto start = std::chrono::high_resolution_clock::now();
+      sortItems(items);
+      best = std::min(best, std::chrono::duration<double, std::micro>(
+                                std::chrono::high_resolution_clock::now() -
+                                start)
+                                .count());
+      if (!std::is_sorted(items.begin(), items.end(),
+                          [](const auto &a, const auto &b) {
+                            return a.key < b.key;
+                          })) {
+        std::cerr << label << ": list not sorted\n";
+        std::exit(EXIT_FAILURE);
+      }
+    }
+    std::cout << std::left << std::setw(20) << label << std::right
+              << std::fixed << std::setprecision(1) << std::setw(10) << best
+              << " us (best of " << kRuns << ")\n";
+  };
+
+  auto byKey = [](const drawbatch::DrawItem &a, const drawbatch::DrawItem &b) {
+    return a.key < b.key;
+  };
+  time("drawbatch::sort", [](auto &items) { drawbatch::sort(items); });
+  time("std::sort", [&](auto &items) {
+    std::sort(items.begin(), items.end(), byKey);
+  });
+  time("std::stable_sort", [&](auto &items) {
+    std::stable_sort(items.begin(), items.end(), byKey);
+  });
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,159 @@
+/**
+ * @file bench_framering.cpp
+ * @brief Per-draw uniform updates: frame ring bump allocation against one
+ *        sub-allocation per draw.
+ *
+ * Usage:
+ * @code
+ * make bench RELEASE=1
+ * ./build/bench_framering [draws] [frames]
+ * @endcode
+ *
+ * Every frame writes one 96-byte record (world matrix, color, material)
+ * per draw, default 10000 draws for 1000 frames, with two frames in flight
+ * like the renderer. Each record's offset is stored as the dynamic offset
+ * the command buffer would bind. Compared, for the 64 and 256 byte
+ * minUniformBufferOffsetAlignment values common on desktop GPUs:
+ * - ring: FrameRing::push() into one partitioned buffer;
+ * - per-draw: a TlsfAllocator range per record, as GpuAllocator would
+ *   sub-allocate it, freed when the frame comes around again. This leaves
+ *   out the vkCreateBuffer and descriptor write each draw would also need,
+ *   so it understates the cost of the old path.
+ *
+ * Reported: ns per update, ms per frame and bytes allocated per frame (for
+ * the ring including alignment padding; TLSF returns padding to its free
+ * lists). Host memory stands in for the mapped buffer, so no GPU is
+ * needed.
+ */
+#include "../include/FrameRing.hpp"
+#include "../include/TlsfAllocator.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::high_resolution_clock;
+
+/** @brief Frames in flight, as MAX_FRAMES_IN_FLIGHT. */
+constexpr uint32_t kFramesInFlight = 2;
+
+/** @brief Per-draw parameters written every frame. */
+struct DrawData {
+  float world[16];     ///< Instance transform
+  float color[4];      ///< Material color
+  uint32_t material;   ///< Material index
+  uint32_t padding[3]; ///< std140 row of the uniform block
+};
+
+/** @brief Fills the record of one draw of one frame. */
+DrawData makeDraw(uint32_t draw, uint32_t frame) {
+  DrawData data{};
+  for (int i = 0; i < 16; i++) {
+    data.world[i] = static_cast<float>(draw + i + frame);
+  }
+  data.color[0] = static_cast<float>(frame & 255) / 255.0f;
+  data.material = draw & 1023;
+  return data;
+}
+
+/** @brief Prints one line of results. */
+void report(const std::string &label, uint64_t alignment, double seconds,
+            uint32_t draws, uint32_t frames, uint64_t bytesPerFrame) {
+  std::cout << "  " << std::left << std::setw(9) << label << std::right
+            << std::setw(4) << alignment << " B align" << std::fixed
+            << std::setprecision(1) << std::setw(9)
+            << seconds * 1e9 / (static_cast<double>(draws) * frames)
+            << " ns/update" << std::setprecision(3) << std::setw(9)
+            << seconds * 1e3 / frames << " ms/frame" << std::setw(10)
+            << bytesPerFrame / 1024 << " KiB/frame\n";
+}
+
+/** @brief Writes every frame's records through a FrameRing. */
+void runRing(uint64_t alignment, uint32_t draws, uint32_t frames,
+             std::vector<uint32_t> &offsets) {
+  const uint64_t record = (sizeof(DrawData) + alignment - 1) & ~(alignment - 1);
+  std::vector<std::byte> memory(record * draws * kFramesInFlight);
+  FrameRing ring(memory.data(), memory.size(), kFramesInFlight, alignment);
+
+  const Clock::time_point start = Clock::now();
+  for (uint32_t frame = 0; frame < frames; frame++) {
+    ring.begin(frame % kFramesInFlight);
+    for (uint32_t draw = 0; draw < draws; draw++) {
+      offsets[draw] = static_cast<uint32_t>(ring.push(makeDraw(draw, frame)));
+    }
+  }
+  const double seconds =
+      std::chrono::duration<double>(Clock::now() - start).count();
+  report("ring", alignment, seconds, draws, frames, ring.used());
+}
+
+/** @brief Writes every frame's records into per-draw TLSF ranges. */
+void runPerDraw(uint64_t alignment, uint32_t draws, uint32_t frames,
+                std::vector<uint32_t> &offsets) {
+  const uint64_t capacity =
+      ((sizeof(DrawData) + alignment - 1) & ~(alignment - 1)) * draws *
+      kFramesInFlight * 2;
+  std::vector<std::byte> memory(capacity);
+  TlsfAllocator tlsf(capacity);
+  std::vector<std::vector<TlsfAllocator::Allocation>> inFlight(
+      kFramesInFlight);
+
+  const Clock::time_point start = Clock::now();
+  for (uint32_t frame = 0; frame < frames; frame++) {
+    std::vector<TlsfAllocator::Allocation> &ranges =
+        inFlight[frame % kFramesInFlight];
+    for (const TlsfAllocator::Allocation &range : ranges) {
+      tlsf.free(range);
+    }
+    ranges.clear();
+    for (uint32_t draw = 0; draw < draws; draw++) {
+      const TlsfAllocator::Allocation range =
+          tlsf.allocate(sizeof(DrawData), alignment);
+      const DrawData data = makeDraw(draw, frame);
+      std::memcpy(memory.data() + range.offset, &data, sizeof(data));
+      offsets[draw] = static_cast<uint32_t>(range.offset);
+      ranges.push_back(range);
+    }
+  }
+  const double seconds =
+      std::chrono::duration<double>(Clock::now() - start).count();
+  report("per-draw", alignment, seconds, draws, frames,
+         tlsf.used() / kFramesInFlight);
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  auto arg = [&](int index, uint32_t fallback) {
+    return argc > index
+               ? static_cast<uint32_t>(std::max(1, std::atoi(argv[index])))
+               : fallback;
+  };
+  const uint32_t draws = arg(1, 10000);
+  const uint32_t frames = arg(2, 1000);
+
+  std::cout << draws << " per-draw updates of " << sizeof(DrawData)
+            << " bytes per frame, " << frames << " frames, "
+            << kFramesInFlight << " in flight\n";
+  std::vector<uint32_t> offsets(draws);
+  for (uint64_t alignment : {64, 256}) {
+    runRing(alignment, draws, frames, offsets);
+    runPerDraw(alignment, draws, frames, offsets);
+  }
+
+  // Keep the offsets observable so the writes are not optimized away
+  uint64_t checksum = 0;
+  for (uint32_t offset : offsets) {
+    checksum += offset;
+  }
+  std::cout << "offset checksum " << checksum << "\n";
+  return EXIT_SUCCESS;
+}
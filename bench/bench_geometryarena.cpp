@@ -0,0 +1,371 @@
+/**
+ * @file bench_geometryarena.cpp
+ * @brief Buffer binds and CPU record time of many meshes: a vertex and index
+ *        buffer per mesh against one GeometryArena.
+ *
+ * Usage:
+ * @code
+ * make bench RELEASE=1
+ * ./build/bench_geometryarena [meshes] [iterations]
+ * @endcode
+ *
+ * Creates 'meshes' distinct meshes (default 1000, 64 to 2048 vertices of a
+ * 12-byte position each, 6 indices per vertex) on a headless device (first
+ * GPU, no window), once with their own buffers and once in a GeometryArena,
+ * and records a command buffer drawing each mesh once (default 200 times):
+ * - separate: two buffer binds and a vkCmdDrawIndexed per mesh;
+ * - arena: one bind of each buffer, then a vkCmdDrawIndexed per mesh;
+ * - arena + MDI: one bind of each buffer and a single
+ *   vkCmdDrawIndexedIndirect over all meshes (multiDrawIndirect only).
+ *
+ * The pipeline is a vertex-only pass with rasterizer discard inside an
+ * attachment-less dynamic rendering scope; nothing is submitted, so the
+ * numbers are the driver's recording cost. Every other mesh is then freed
+ * and replaced by one of another size, showing the arena's free ranges
+ * being reused (and merged with their free neighbours).
+ */
+#include "../include/GeometryArena.hpp"
+#include "../include/GpuAllocator.hpp"
+#include "BenchGpu.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <vulkan/vulkan_raii.hpp>
+
+namespace {
+
+/**
+ * @brief SPIR-V of a vertex shader writing its vec3 position (location 0)
+ *        to gl_Position, so the bench needs no shader compiler.
+ */
+const uint32_t kVertexShader[] = {
+    0x07230203, 0x00010000, 0, 15, 0,                     // Header, bound 15
+    0x00020011, 1,                                        // Capability Shader
+    0x0003000E, 0, 1,                                     // Logical GLSL450
+    0x0007000F, 0, 11, 0x6E69616D, 0, 8, 9,               // EntryPoint "main"
+    0x00040047, 8, 30, 0,                                 // %8 Location 0
+    0x00040047, 9, 11, 0,                                 // %9 Position
+    0x00020013, 1,                                        // %1 void
+    0x00030021, 2, 1,                                     // %2 void()
+    0x00030016, 3, 32,                                    // %3 float
+    0x00040017, 4, 3, 3,                                  // %4 vec3
+    0x00040017, 5, 3, 4,                                  // %5 vec4
+    0x00040020, 6, 1, 4,                                  // %6 Input vec3*
+    0x00040020, 7, 3, 5,                                  // %7 Output vec4*
+    0x0004003B, 6, 8, 1,                                  // %8 in
+    0x0004003B, 7, 9, 3,                                  // %9 out
+    0x0004002B, 3, 10, 0x3F800000,                        // %10 1.0
+    0x00050036, 1, 11, 0, 2,                              // %11 main
+    0x000200F8, 12,                                       // %12 label
+    0x0004003D, 4, 13, 8,                                 // %13 = load in
+    0x00050050, 5, 14, 13, 10,                            // %14 = vec4(%13, 1)
+    0x0003003E, 9, 14,                                    // store out
+    0x000100FD,                                           // return
+    0x00010038};                                          // end
+
+/** @brief Bytes per vertex (one vec3 position). */
+constexpr uint32_t kStride = 12;
+
+/** @brief Offset of every vertex buffer bind. */
+constexpr vk::DeviceSize kNoOffset = 0;
+
+using bench::Gpu;
+
+/** @brief Pipeline and command buffer the draws are recorded with. */
+struct DrawPass {
+  vk::raii::CommandBuffer commandBuffer = nullptr;   ///< Re-recorded per run
+  vk::raii::PipelineLayout pipelineLayout = nullptr; ///< Empty layout
+  vk::raii::Pipeline pipeline = nullptr;             ///< Vertex only
+};
+
+/**
+ * @brief Creates the instance and a device with dynamic rendering and,
+ * where supported, multiDrawIndirect.
+ *
+ * @return Whether multiDrawIndirect is enabled.
+ */
+bool createGpu(Gpu &gpu) {
+  bench::selectGpu(gpu, "bench_geometryarena");
+
+  vk::PhysicalDeviceVulkan13Features features13{};
+  features13.dynamicRendering = VK_TRUE;
+  vk::PhysicalDeviceFeatures2 features{};
+  features.pNext = &features13;
+  features.features.multiDrawIndirect =
+      gpu.physicalGPU.getFeatures().multiDrawIndirect;
+
+  bench::DeviceOptions options;
+  options.features = &features;
+  bench::createDevice(gpu, options);
+  return features.features.multiDrawIndirect == VK_TRUE;
+}
+
+/** @brief Builds the vertex-only pipeline the draws are recorded with. */
+DrawPass createDrawPass(const Gpu &gpu) {
+  vk::ShaderModuleCreateInfo moduleInfo{};
+  moduleInfo.codeSize = sizeof(kVertexShader);
+  moduleInfo.pCode = kVertexShader;
+  const vk::raii::ShaderModule module(gpu.device, moduleInfo);
+
+  vk::PipelineShaderStageCreateInfo stage{};
+  stage.stage = vk::ShaderStageFlagBits::eVertex;
+  stage.module = *module;
+  stage.pName = "main";
+
+  const vk::VertexInputBindingDescription binding{0, kStride,
+                                                  vk::VertexInputRate::eVertex};
+  const vk::VertexInputAttributeDescription attribute{
+      0, 0, vk::Format::eR32G32B32Sfloat, 0};
+  vk::PipelineVertexInputStateCreateInfo vertexInput{};
+  vertexInput.vertexBindingDescriptionCount = 1;
+  vertexInput.pVertexBindingDescriptions = &binding;
+  vertexInput.vertexAttributeDescriptionCount = 1;
+  vertexInput.pVertexAttributeDescriptions = &attribute;
+
+  vk::PipelineInputAssemblyStateCreateInfo inputAssembly{};
+  inputAssembly.topology = vk::PrimitiveTopology::eTriangleList;
+
+  vk::PipelineRasterizationStateCreateInfo rasterizer{};
+  rasterizer.rasterizerDiscardEnable = VK_TRUE;
+  rasterizer.lineWidth = 1.0f;
+
+  DrawPass pass;
+  pass.commandBuffer = bench::allocateCommandBuffer(gpu);
+  pass.pipelineLayout =
+      vk::raii::PipelineLayout(gpu.device, vk::PipelineLayoutCreateInfo{});
+
+  vk::PipelineRenderingCreateInfo renderingInfo{}; // No attachments
+  vk::GraphicsPipelineCreateInfo pipelineInfo{};
+  pipelineInfo.pNext = &renderingInfo;
+  pipelineInfo.stageCount = 1;
+  pipelineInfo.pStages = &stage;
+  pipelineInfo.pVertexInputState = &vertexInput;
+  pipelineInfo.pInputAssemblyState = &inputAssembly;
+  pipelineInfo.pRasterizationState = &rasterizer;
+  pipelineInfo.layout = *pass.pipelineLayout;
+  pass.pipeline = vk::raii::Pipeline(gpu.device, nullptr, pipelineInfo);
+  return pass;
+}
+
+/** @brief Sizes of one mesh. */
+struct MeshSize {
+  uint32_t vertexCount = 0; ///< Vertices of kStride bytes
+  uint32_t indexCount = 0;  ///< 32-bit indices
+};
+
+/** @brief Random mesh sizes. */
+std::vector<MeshSize> randomSizes(size_t count, std::mt19937 &random) {
+  std::uniform_int_distribution<uint32_t> vertices(64, 2048);
+  std::vector<MeshSize> sizes(count);
+  for (MeshSize &size : sizes) {
+    size.vertexCount = vertices(random);
+    size.indexCount = 6 * size.vertexCount;
+  }
+  return sizes;
+}
+
+/** @brief Binds and draws of one recording. */
+struct Recording {
+  size_t vertexBinds = 0;  ///< vkCmdBindVertexBuffers calls
+  size_t indexBinds = 0;   ///< vkCmdBindIndexBuffer calls
+  size_t drawCalls = 0;    ///< Draw commands recorded
+  double microseconds = 0; ///< Mean CPU time of one recording
+};
+
+/**
+ * @brief Records 'draw' between the pipeline bind and the end of the
+ * command buffer 'iterations' times and returns the mean time.
+ */
+template <typename Draw>
+Recording record(DrawPass &pass, int iterations, Draw &&draw) {
+  vk::RenderingInfo renderingInfo{};
+  renderingInfo.renderArea = vk::Rect2D{{0, 0}, {1, 1}};
+  renderingInfo.layerCount = 1;
+
+  Recording recording;
+  double total = 0;
+  for (int i = 0; i < iterations; i++) {
+    pass.commandBuffer.reset();
+    recording = Recording{};
+    const auto start = std::chrono::steady_clock::now();
+    pass.commandBuffer.begin(vk::CommandBufferBeginInfo{
+        vk::CommandBufferUsageFlagBits::eOneTimeSubmit});
+    pass.commandBuffer.beginRendering(renderingInfo);
+    pass.commandBuffer.bindPipeline(vk::PipelineBindPoint::eGraphics,
+                                    *pass.pipeline);
+    draw(pass.commandBuffer, recording);
+    pass.commandBuffer.endRendering();
+    pass.commandBuffer.end();
+    total += std::chrono::duration<double, std::micro>(
+                 std::chrono::steady_clock::now() - start)
+                 .count();
+  }
+  recording.microseconds = total / iterations;
+  return recording;
+}
+
+/** @brief Prints one row of the results table. */
+void printRow(const std::string &label, const Recording &recording) {
+  std::cout << std::left << std::setw(14) << label << std::right
+            << std::setw(13) << recording.vertexBinds << std::setw(12)
+            << recording.indexBinds << std::setw(7) << recording.drawCalls
+            << std::fixed << std::setprecision(1) << std::setw(13)
+            << recording.microseconds << "\n";
+}
+
+/** @brief Prints the arena's use. */
+void printStats(const std::string &label, const GeometryArena &arena) {
+  const GeometryArena::Stats stats = arena.stats();
+  std::cout << std::left << std::setw(22) << label << std::right
+            << std::setw(6) << stats.meshCount << " meshes, vertices "
+            << std::fixed << std::setprecision(1)
+            << static_cast<double>(stats.vertexUsed) / (1 << 20) << "/"
+            << static_cast<double>(stats.vertexBytes) / (1 << 20)
+            << " MiB in " << stats.vertexFreeBlocks
+            << " free ranges, indices " << stats.indexUsed << "/"
+            << stats.indexCount << " in " << stats.indexFreeBlocks
+            << " free ranges\n";
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+  const size_t meshCount = argc > 1 ? std::stoul(argv[1]) : 1000;
+  const int iterations = argc > 2 ? std::stoi(argv[2]) : 200;
+
+  try {
+    Gpu gpu;
+    const bool multiDrawIndirect = createGpu(gpu);
+    DrawPass pass = createDrawPass(gpu);
+    std::mt19937 random(42);
+    const std::vector<MeshSize> sizes = randomSizes(meshCount, random);
+
+    // Separate: a vertex and index buffer per mesh
+    std::vector<vk::raii::Buffer> vertexBuffers;
+    std::vector<vk::raii::Buffer> indexBuffers;
+    std::vector<GpuAllocation> memories(2 * meshCount);
+    for (size_t i = 0; i < meshCount; i++) {
+      vertexBuffers.push_back(bench::createBuffer(
+          gpu, static_cast<vk::DeviceSize>(sizes[i].vertexCount) * kStride,
+          vk::BufferUsageFlagBits::eVertexBuffer,
+          vk::MemoryPropertyFlagBits::eDeviceLocal,
+          GpuAllocator::Category::eVertex, memories[2 * i]));
+      indexBuffers.push_back(bench::createBuffer(
+          gpu, sizeof(uint32_t) * static_cast<vk::DeviceSize>(
+                                      sizes[i].indexCount),
+          vk::BufferUsageFlagBits::eIndexBuffer,
+          vk::MemoryPropertyFlagBits::eDeviceLocal,
+          GpuAllocator::Category::eIndex, memories[2 * i + 1]));
+    }
+
+    // Arena: every mesh in the same two buffers
+    GeometryArena arena(gpu.device, *gpu.allocator);
+    std::vector<GeometryArena::Mesh> meshes;
+    for (const MeshSize &size : sizes) {
+      meshes.push_back(
+          arena.allocate(size.vertexCount, kStride, size.indexCount));
+      if (!meshes.back()) {
+        throw std::runtime_error("Geometry arena full");
+      }
+    }
+
+    // Indirect commands of the arena meshes, written once (static scene)
+    GpuAllocation indirectMemory = nullptr;
+    const vk::raii::Buffer indirectBuffer = bench::createBuffer(
+        gpu, sizeof(vk::DrawIndexedIndirectCommand) * meshCount,
+        vk::BufferUsageFlagBits::eIndirectBuffer,
+        vk::MemoryPropertyFlagBits::eHostVisible |
+            vk::MemoryPropertyFlagBits::eHostCoherent,
+        GpuAllocator::Category::eOther, indirectMemory);
+    auto *commands =
+        static_cast<vk::DrawIndexedIndirectCommand *>(indirectMemory.mapped());
+    for (size_t i = 0; i < meshCount; i++) {
+      commands[i] = vk::DrawIndexedIndirectCommand{
+          meshes[i].indexCount(), 1, meshes[i].firstIndex(),
+          meshes[i].vertexOffset(), 0};
+    }
+
+    std::cout << meshCount << " meshes on "
+              << gpu.physicalGPU.getProperties().deviceName.data() << ", "
+              << iterations << " recordings each\n"
+              << std::left << std::setw(14) << "" << std::right
+              << std::setw(13) << "vertex binds" << std::setw(12)
+              << "index binds" << std::setw(7) << "draws" << std::setw(13)
+              << "record us" << "\n";
+
+    printRow("separate",
+             record(pass, iterations, [&](const vk::raii::CommandBuffer &cmd,
+                                          Recording &recording) {
+               for (size_t i = 0; i < meshCount; i++) {
+                 cmd.bindVertexBuffers(0, *vertexBuffers[i], kNoOffset);
+                 cmd.bindIndexBuffer(*indexBuffers[i], 0,
+                                     vk::IndexType::eUint32);
+                 cmd.drawIndexed(sizes[i].indexCount, 1, 0, 0, 0);
+                 recording.vertexBinds++;
+                 recording.indexBinds++;
+                 recording.drawCalls++;
+               }
+             }));
+
+    printRow("arena",
+             record(pass, iterations, [&](const vk::raii::CommandBuffer &cmd,
+                                          Recording &recording) {
+               cmd.bindVertexBuffers(0, *arena.vertexBuffer(), kNoOffset);
+               cmd.bindIndexBuffer(*arena.indexBuffer(), 0,
+                                   vk::IndexType::eUint32);
+               recording.vertexBinds++;
+               recording.indexBinds++;
+               for (const GeometryArena::Mesh &mesh : meshes) {
+                 cmd.drawIndexed(mesh.indexCount(), 1, mesh.firstIndex(),
+                                 mesh.vertexOffset(), 0);
+                 recording.drawCalls++;
+               }
+             }));
+
+    if (multiDrawIndirect) {
+      auto drawIndirect = [&](const vk::raii::CommandBuffer &cmd,
+                              Recording &recording) {
+        cmd.bindVertexBuffers(0, *arena.vertexBuffer(), kNoOffset);
+        cmd.bindIndexBuffer(*arena.indexBuffer(), 0, vk::IndexType::eUint32);
+        cmd.drawIndexedIndirect(*indirectBuffer, 0,
+                                static_cast<uint32_t>(meshCount),
+                                sizeof(vk::DrawIndexedIndirectCommand));
+        recording.vertexBinds++;
+        recording.indexBinds++;
+        recording.drawCalls++;
+      };
+      printRow("arena + MDI", record(pass, iterations, drawIndirect));
+    } else {
+      std::cout << "arena + MDI   (multiDrawIndirect not supported)\n";
+    }
+
+    // Unload every other mesh, then load as many of other sizes
+    std::cout << "\n";
+    printStats("loaded", arena);
+    for (size_t i = 0; i < meshCount; i += 2) {
+      meshes[i].reset();
+    }
+    printStats("every other unloaded", arena);
+    size_t reloaded = 0;
+    for (const MeshSize &size : randomSizes(meshCount / 2, random)) {
+      GeometryArena::Mesh mesh =
+          arena.allocate(size.vertexCount, kStride, size.indexCount);
+      if (mesh) {
+        meshes[2 * reloaded++] = std::move(mesh);
+      }
+    }
+    printStats("reloaded", arena);
+    std::cout << reloaded << "/" << meshCount / 2
+              << " new meshes allocated\n";
+  } catch (const std::exception &e) {
+    std::cerr << "bench_geometryarena: " << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,336 @@
+/**
+ * @file bench_loadbatch.cpp
+ * @brief Startup uploads: a submission and a wait per operation against
+ *        one LoadBatch.
+ *
+ * Usage:
+ * @code
+ * make bench RELEASE=1
+ * ./build/bench_loadbatch [textureSize] [rounds]
+ * @endcode
+ *
+ * Loads two scenes on a headless device (first GPU, no window), 'rounds'
+ * times each (default 5):
+ * - statue: one mesh of 100,000 vertices;
+ * - 100 meshes: 100 meshes of 1,000 vertices.
+ * Both also load the 1x1 placeholder and a 'textureSize' texture (default
+ * 2048) whose mips are blitted on the GPU. Vertices are 32 bytes, with 3
+ * 32-bit indices per vertex. Every operation the renderer performs at
+ * startup is recorded: the texture's layout transitions, its
+ * buffer-to-image copy and mip generation, and a vertex and an index copy
+ * per mesh. Compared:
+ * - per operation: what beginSingleTimeCommands() and
+ *   endSingleTimeCommands() used to do; each operation is submitted and
+ *   waited for on its own;
+ * - load batch: everything recorded into one LoadBatch, submitted once,
+ *   waited for on one fence, and the staging ranges released together.
+ *
+ * Reported per scene and path: ms per load (best of the rounds, staging
+ * and recording included), queue submissions, and staging ranges released.
+ */
+#include "../include/GpuAllocator.hpp"
+#include "../include/LoadBatch.hpp"
+#include "../include/StagingPool.hpp"
+#include "BenchGpu.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <vulkan/vulkan_raii.hpp>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+/** @brief Bytes per vertex (position, normal, UV as in VertexFormats). */
+constexpr size_t kVertexBytes = 32;
+
+/** @brief Format of the placeholder and the texture. */
+constexpr vk::Format kTextureFormat = vk::Format::eR8G8B8A8Unorm;
+
+/** @brief Meshes and vertices per mesh of one scene. */
+struct SceneDesc {
+  const char *name;      ///< Printed label
+  uint32_t meshes;       ///< Mesh count
+  uint32_t meshVertices; ///< Vertices of each mesh
+};
+
+/** @brief The scenes loaded, as in the file comment. */
+constexpr SceneDesc kScenes[] = {{"statue", 1, 100000},
+                                 {"100 meshes", 100, 1000}};
+
+using bench::Gpu;
+
+/** @brief A device-local image and its memory. */
+struct Image {
+  vk::raii::Image image = nullptr; ///< Optimal tiling, sampled
+  GpuAllocation memory = nullptr;  ///< Its memory
+  uint32_t levels = 1;             ///< Mip levels
+};
+
+/** @brief Creates a sampled image that can be copied and blitted into. */
+Image createImage(const Gpu &gpu, uint32_t size, uint32_t levels) {
+  vk::ImageCreateInfo imageInfo{};
+  imageInfo.imageType = vk::ImageType::e2D;
+  imageInfo.format = kTextureFormat;
+  imageInfo.extent = vk::Extent3D{size, size, 1};
+  imageInfo.mipLevels = levels;
+  imageInfo.arrayLayers = 1;
+  imageInfo.samples = vk::SampleCountFlagBits::e1;
+  imageInfo.tiling = vk::ImageTiling::eOptimal;
+  imageInfo.usage = vk::ImageUsageFlagBits::eTransferSrc |
+                    vk::ImageUsageFlagBits::eTransferDst |
+                    vk::ImageUsageFlagBits::eSampled;
+  imageInfo.sharingMode = vk::SharingMode::eExclusive;
+  Image result;
+  result.image = vk::raii::Image(gpu.device, imageInfo);
+  result.memory = gpu.allocator->allocate(
+      result.image, vk::ImageTiling::eOptimal,
+      vk::MemoryPropertyFlagBits::eDeviceLocal,
+      GpuAllocator::Category::eTexture);
+  result.levels = levels;
+  return result;
+}
+
+/** @brief Records a layout transition of every level of 'image'. */
+void transition(const vk::raii::CommandBuffer &commands, const Image &image,
+                vk::ImageLayout oldLayout, vk::ImageLayout newLayout) {
+  vk::ImageMemoryBarrier barrier{};
+  barrier.oldLayout = oldLayout;
+  barrier.newLayout = newLayout;
+  barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+  barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+  barrier.image = *image.image;
+  barrier.subresourceRange = vk::ImageSubresourceRange{
+      vk::ImageAspectFlagBits::eColor, 0, image.levels, 0, 1};
+  vk::PipelineStageFlags sourceStage = vk::PipelineStageFlagBits::eTopOfPipe;
+  vk::PipelineStageFlags destinationStage =
+      vk::PipelineStageFlagBits::eTransfer;
+  barrier.dstAccessMask = vk::AccessFlagBits::eTransferWrite;
+  if (oldLayout == vk::ImageLayout::eTransferDstOptimal) {
+    barrier.srcAccessMask = vk::AccessFlagBits::eTransferWrite;
+    barrier.dstAccessMask = vk::AccessFlagBits::eShaderRead;
+    sourceStage = vk::PipelineStageFlagBits::eTransfer;
+    destinationStage = vk::PipelineStageFlagBits::eFragmentShader;
+  }
+  commands.pipelineBarrier(sourceStage, destinationStage, {}, {}, nullptr,
+                           barrier);
+}
+
+/** @brief Records a copy of 'range' into level 0 of 'image'. */
+void copyToImage(const vk::raii::CommandBuffer &commands,
+                 const StagingPool::Range &range, const Image &image,
+                 uint32_t size) {
+  vk::BufferImageCopy region{};
+  region.bufferOffset = range.offset;
+  region.imageSubresource =
+      vk::ImageSubresourceLayers{vk::ImageAspectFlagBits::eColor, 0, 0, 1};
+  region.imageExtent = vk::Extent3D{size, size, 1};
+  commands.copyBufferToImage(range.buffer, *image.image,
+                             vk::ImageLayout::eTransferDstOptimal, region);
+}
+
+/**
+ * @brief Records the blits of levels 1..n, as generateMipmaps() does,
+ * leaving every level in eShaderReadOnlyOptimal.
+ */
+void generateMipmaps(const vk::raii::CommandBuffer &commands,
+                     const Image &image, uint32_t size) {
+  vk::ImageMemoryBarrier barrier{};
+  barrier.image = *image.image;
+  barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+  barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+  barrier.subresourceRange =
+      vk::ImageSubresourceRange{vk::ImageAspectFlagBits::eColor, 0, 1, 0, 1};
+  auto width = static_cast<int32_t>(size);
+  for (uint32_t level = 1; level < image.levels; level++) {
+    barrier.subresourceRange.baseMipLevel = level - 1;
+    barrier.oldLayout = vk::ImageLayout::eTransferDstOptimal;
+    barrier.newLayout = vk::ImageLayout::eTransferSrcOptimal;
+    barrier.srcAccessMask = vk::AccessFlagBits::eTransferWrite;
+    barrier.dstAccessMask = vk::AccessFlagBits::eTransferRead;
+    commands.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer,
+                             vk::PipelineStageFlagBits::eTransfer, {}, {}, {},
+                             barrier);
+
+    const int32_t next = std::max(width / 2, 1);
+    vk::ImageBlit blit{};
+    blit.srcOffsets[1] = vk::Offset3D{width, width, 1};
+    blit.srcSubresource = vk::ImageSubresourceLayers{
+        vk::ImageAspectFlagBits::eColor, level - 1, 0, 1};
+    blit.dstOffsets[1] = vk::Offset3D{next, next, 1};
+    blit.dstSubresource =
+        vk::ImageSubresourceLayers{vk::ImageAspectFlagBits::eColor, level, 0,
+                                   1};
+    commands.blitImage(*image.image, vk::ImageLayout::eTransferSrcOptimal,
+                       *image.image, vk::ImageLayout::eTransferDstOptimal,
+                       blit, vk::Filter::eLinear);
+
+    barrier.oldLayout = vk::ImageLayout::eTransferSrcOptimal;
+    barrier.newLayout = vk::ImageLayout::eShaderReadOnlyOptimal;
+    barrier.srcAccessMask = vk::AccessFlagBits::eTransferRead;
+    barrier.dstAccessMask = vk::AccessFlagBits::eShaderRead;
+    commands.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer,
+                             vk::PipelineStageFlagBits::eFragmentShader, {},
+                             {}, {}, barrier);
+    width = next;
+  }
+  barrier.subresourceRange.baseMipLevel = image.levels - 1;
+  barrier.oldLayout = vk::ImageLayout::eTransferDstOptimal;
+  barrier.newLayout = vk::ImageLayout::eShaderReadOnlyOptimal;
+  barrier.srcAccessMask = vk::AccessFlagBits::eTransferWrite;
+  barrier.dstAccessMask = vk::AccessFlagBits::eShaderRead;
+  commands.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer,
+                           vk::PipelineStageFlagBits::eFragmentShader, {}, {},
+                           {}, barrier);
+}
+
+/** @brief Destinations of one scene, created once and reloaded each round. */
+struct Scene {
+  Image placeholder;                     ///< 1x1 white
+  Image texture;                         ///< Blitted mip chain
+  std::vector<vk::raii::Buffer> buffers; ///< Vertex, index per mesh
+  std::vector<GpuAllocation> memory;     ///< Their memory
+};
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+  const uint32_t textureSize =
+      argc > 1 ? static_cast<uint32_t>(std::max(1, std::atoi(argv[1])))
+               : 2048;
+  const uint32_t rounds =
+      argc > 2 ? static_cast<uint32_t>(std::max(1, std::atoi(argv[2]))) : 5;
+
+  try {
+    Gpu gpu;
+    bench::createGpu(gpu, "bench_loadbatch");
+    StagingPool stagingPool(gpu.device, *gpu.allocator);
+
+    // Mips only when the format can be blitted with linear filtering
+    const bool blit =
+        static_cast<bool>(gpu.physicalGPU.getFormatProperties(kTextureFormat)
+                              .optimalTilingFeatures &
+                          vk::FormatFeatureFlagBits::eSampledImageFilterLinear);
+    const uint32_t levels =
+        blit ? static_cast<uint32_t>(std::floor(std::log2(textureSize))) + 1
+             : 1;
+    std::mt19937 random(11);
+    std::vector<std::byte> pixels(size_t{textureSize} * textureSize * 4);
+    for (std::byte &byte : pixels) {
+      byte = static_cast<std::byte>(random());
+    }
+    const std::byte white[4] = {std::byte{255}, std::byte{255},
+                                std::byte{255}, std::byte{255}};
+
+    std::cout << textureSize << "x" << textureSize << " texture (" << levels
+              << " levels), " << rounds << " rounds on "
+              << gpu.physicalGPU.getProperties().deviceName.data() << "\n"
+              << std::left << std::setw(28) << "" << std::right
+              << std::setw(10) << "ms/load" << std::setw(9) << "submits"
+              << std::setw(9) << "ranges" << "\n";
+
+    for (const SceneDesc &desc : kScenes) {
+      Scene scene;
+      scene.placeholder = createImage(gpu, 1, 1);
+      scene.texture = createImage(gpu, textureSize, levels);
+      std::vector<std::byte> vertices(size_t{desc.meshVertices} *
+                                      kVertexBytes);
+      std::vector<std::byte> indices(size_t{desc.meshVertices} * 3 *
+                                     sizeof(uint32_t));
+      for (std::byte &byte : vertices) {
+        byte = static_cast<std::byte>(random());
+      }
+      for (std::byte &byte : indices) {
+        byte = static_cast<std::byte>(random());
+      }
+      for (uint32_t mesh = 0; mesh < desc.meshes; mesh++) {
+        scene.memory.emplace_back(nullptr);
+        scene.buffers.push_back(bench::createBuffer(
+            gpu, vertices.size(),
+            vk::BufferUsageFlagBits::eVertexBuffer |
+                vk::BufferUsageFlagBits::eTransferDst,
+            vk::MemoryPropertyFlagBits::eDeviceLocal,
+            GpuAllocator::Category::eOther, scene.memory.back()));
+        scene.memory.emplace_back(nullptr);
+        scene.buffers.push_back(bench::createBuffer(
+            gpu, indices.size(),
+            vk::BufferUsageFlagBits::eIndexBuffer |
+                vk::BufferUsageFlagBits::eTransferDst,
+            vk::MemoryPropertyFlagBits::eDeviceLocal,
+            GpuAllocator::Category::eOther, scene.memory.back()));
+      }
+
+      // Records the whole load; 'step' ends each operation
+      auto load = [&](LoadBatch &batch, auto &&step) {
+        auto image = [&](const Image &target, uint32_t size,
+                         std::span<const std::byte> bytes) {
+          const StagingPool::Range range = stagingPool.upload(bytes);
+          transition(batch.commands(), target, vk::ImageLayout::eUndefined,
+                     vk::ImageLayout::eTransferDstOptimal);
+          step();
+          copyToImage(batch.commands(), range, target, size);
+          batch.release(range);
+          step();
+          if (target.levels > 1) {
+            generateMipmaps(batch.commands(), target, size);
+          } else {
+            transition(batch.commands(), target,
+                       vk::ImageLayout::eTransferDstOptimal,
+                       vk::ImageLayout::eShaderReadOnlyOptimal);
+          }
+          step();
+        };
+        image(scene.placeholder, 1, white);
+        image(scene.texture, textureSize, pixels);
+        for (size_t i = 0; i < scene.buffers.size(); i++) {
+          const StagingPool::Range range =
+              stagingPool.upload(i % 2 == 0 ? vertices : indices);
+          batch.commands().copyBuffer(
+              range.buffer, *scene.buffers[i],
+              vk::BufferCopy(range.offset, 0, range.size));
+          batch.release(range);
+          step();
+        }
+        batch.submit(); // No-op when 'step' already submitted everything
+      };
+
+      auto run = [&](const std::string &label, bool batched) {
+        LoadBatch batch(gpu.device, stagingPool, gpu.family);
+        double best = 1e30;
+        for (uint32_t round = 0; round < rounds; round++) {
+          const Clock::time_point start = Clock::now();
+          load(batch, [&] {
+            if (!batched) {
+              batch.submit();
+            }
+          });
+          best = std::min(best, std::chrono::duration<double, std::milli>(
+                                    Clock::now() - start)
+                                    .count());
+          stagingPool.collect();
+        }
+        std::cout << "  " << std::left << std::setw(26)
+                  << std::string(desc.name) + ", " + label << std::right
+                  << std::fixed << std::setprecision(2) << std::setw(10)
+                  << best << std::setw(9) << batch.stats().submits / rounds
+                  << std::setw(9) << batch.stats().stagingRanges / rounds
+                  << "\n";
+      };
+      run("per operation", false);
+      run("load batch", true);
+    }
+  } catch (const std::exception &e) {
+    std::cerr << "bench_loadbatch: " << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
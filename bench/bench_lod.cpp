@@ -0,0 +1,95 @@
+/**
+ * @file bench_lod.cpp
+ * @brief LOD chain report: build time, per-level triangles/error and the
+ *        level selected at each camera distance.
+ *
+ * Usage:
+ * @code
+ * make bench RELEASE=1
+ * ./build/bench_lod [model.obj] [max pixel error]
+ * @endcode
+ *
+ * Uses the renderer's default camera (45 degree FOV, 720x540, looking at the
+ * origin along the (1,1,1) diagonal) and prints, per distance, the selected
+ * LOD, its triangle count and projected error, and the fraction of LOD 0
+ * triangles that would be submitted. GPU frame time per distance is measured
+ * in the application itself with LOD_DISTANCE_SWEEP (see render.hpp).
+ */
+#include "../include/MeshLoader.hpp"
+#include "../include/MeshSimplifier.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <glm/gtc/matrix_transform.hpp>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+namespace {
+
+/** @brief Milliseconds elapsed since 'start'. */
+double msSince(std::chrono::high_resolution_clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(
+             std::chrono::high_resolution_clock::now() - start)
+      .count();
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  const std::string modelPath = argc > 1 ? argv[1] : "models/statue.obj";
+  const float maxPixelError = argc > 2 ? std::strtof(argv[2], nullptr) : 1.0f;
+  const float width = 720.0f, height = 540.0f;
+
+  try {
+    MeshData mesh = meshloader::loadObjParallel(modelPath);
+    std::cout << "model: " << modelPath << " (" << mesh.vertices.size()
+              << " vertices, " << mesh.indices.size() / 3 << " triangles)\n";
+
+    auto start = std::chrono::high_resolution_clock::now();
+    meshlod::buildLodChain(mesh);
+    std::cout << "LOD chain built in " << std::setprecision(4)
+              << msSince(start) << " ms\n\n"
+              << std::left << std::setw(6) << "LOD" << std::setw(12)
+              << "triangles" << "error (model units)\n";
+    for (size_t level = 0; level < mesh.lods.size(); level++) {
+      std::cout << std::setw(6) << level << std::setw(12)
+                << mesh.lods[level].indexCount / 3 << mesh.lods[level].error
+                << "\n";
+    }
+
+    glm::mat4 proj = glm::perspective(glm::radians(45.0f), width / height,
+                                      0.1f, 1000.0f);
+    proj[1][1] *= -1;
+    const glm::mat4 model(1.0f);
+    const double fullTriangles = mesh.lods[0].indexCount / 3.0;
+
+    std::cout << "\nmax pixel error " << maxPixelError << "\n"
+              << std::setw(10) << "distance" << std::setw(6) << "LOD"
+              << std::setw(12) << "triangles" << std::setw(12) << "error px"
+              << "of LOD 0\n";
+    for (float distance = 1.0f; distance <= 256.0f; distance *= 2.0f) {
+      const glm::mat4 view =
+          glm::lookAt(glm::vec3(distance / std::sqrt(3.0f)), glm::vec3(0.0f),
+                      glm::vec3(0.0f, 0.0f, 1.0f));
+      const uint32_t lod =
+          meshlod::selectLod(mesh.lods, model, view, proj, mesh.boundsMin,
+                             mesh.boundsMax, height, maxPixelError);
+      const float pixels = meshlod::pixelsPerUnit(
+          model, view, proj, mesh.boundsMin, mesh.boundsMax, height);
+      const uint32_t triangles = mesh.lods[lod].indexCount / 3;
+      const float errorPixels =
+          std::isinf(pixels) ? 0.0f : mesh.lods[lod].error * pixels;
+      std::cout << std::setw(10) << distance << std::setw(6) << lod
+                << std::setw(12) << triangles << std::setw(12) << errorPixels
+                << std::setprecision(3)
+                << 100.0 * triangles / fullTriangles << " %\n"
+                << std::setprecision(4);
+    }
+  } catch (const std::exception &e) {
+    std::cerr << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,102 @@
+/**
+ * @file bench_meshlet.cpp
+ * @brief Meshlet build time and the fraction of triangles rejected by the
+ *        cluster culling test at several camera distances.
+ *
+ * Usage:
+ * @code
+ * make bench RELEASE=1
+ * ./build/bench_meshlet [model.obj]
+ * @endcode
+ *
+ * Uses the renderer's default camera (45 degree FOV, 720x540, looking at the
+ * origin along the (1,1,1) diagonal) and runs meshlet::isVisible(), the CPU
+ * reference of shaders/cull.comp, on the LOD 0 meshlets. The GPU counters are
+ * published as ChronoProfiler counters in PROFILING=1 builds.
+ */
+#include "../include/MeshLoader.hpp"
+#include "../include/MeshletBuilder.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <glm/gtc/matrix_transform.hpp>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+namespace {
+
+/** @brief Milliseconds elapsed since 'start'. */
+double msSince(std::chrono::high_resolution_clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(
+             std::chrono::high_resolution_clock::now() - start)
+      .count();
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  const std::string modelPath = argc > 1 ? argv[1] : "models/statue.obj";
+  const float width = 720.0f, height = 540.0f;
+
+  try {
+    MeshData mesh = meshloader::loadObjParallel(modelPath);
+    std::cout << "model: " << modelPath << " (" << mesh.vertices.size()
+              << " vertices, " << mesh.indices.size() / 3 << " triangles)\n";
+
+    auto start = std::chrono::high_resolution_clock::now();
+    meshlet::MeshletSet set =
+        meshlet::buildForLods(mesh.indices, mesh.vertices, mesh.lods);
+    const double buildMs = msSince(start);
+
+    const meshlet::MeshletRange range = set.lodRanges[0];
+    double averageTriangles = 0.0, averageVertices = 0.0;
+    for (uint32_t i = range.first; i < range.first + range.count; i++) {
+      averageTriangles += set.meshlets[i].indexCount / 3.0;
+      averageVertices += set.meshlets[i].vertexCount;
+    }
+    averageTriangles /= range.count;
+    averageVertices /= range.count;
+    std::cout << range.count << " meshlets built in " << std::setprecision(4)
+              << buildMs << " ms (avg " << averageTriangles
+              << " triangles, " << averageVertices << " vertices)\n\n";
+
+    // Zero-to-one depth, as the renderer's GLM_FORCE_DEPTH_ZERO_TO_ONE
+    glm::mat4 proj = glm::perspectiveRH_ZO(glm::radians(45.0f),
+                                           width / height, 0.1f, 1000.0f);
+    proj[1][1] *= -1;
+    const glm::mat4 model(1.0f);
+
+    std::cout << std::left << std::setw(10) << "distance" << std::setw(10)
+              << "visible" << std::setw(14) << "culled tris"
+              << "culled\n";
+    for (float distance = 0.5f; distance <= 64.0f; distance *= 2.0f) {
+      const glm::mat4 view =
+          glm::lookAt(glm::vec3(distance / std::sqrt(3.0f)), glm::vec3(0.0f),
+                      glm::vec3(0.0f, 0.0f, 1.0f));
+      const meshlet::CullParams params =
+          meshlet::makeCullParams(model, view, proj, range);
+
+      uint32_t visible = 0;
+      uint64_t culledTriangles = 0, totalTriangles = 0;
+      for (uint32_t i = range.first; i < range.first + range.count; i++) {
+        const uint32_t triangles = set.meshlets[i].indexCount / 3;
+        totalTriangles += triangles;
+        if (meshlet::isVisible(set.meshlets[i], params)) {
+          visible++;
+        } else {
+          culledTriangles += triangles;
+        }
+      }
+      std::cout << std::setw(10) << distance << std::setw(10) << visible
+                << std::setw(14) << culledTriangles << std::setprecision(3)
+                << 100.0 * culledTriangles / totalTriangles << " %\n"
+                << std::setprecision(4);
+    }
+  } catch (const std::exception &e) {
+    std::cerr << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,105 @@
+/**
+ * @file bench_mipgen.cpp
+ * @brief CPU mip-chain throughput: scalar reference vs. the SIMD band
+ *        filter on pools of 1, 2, 4, ... threads.
+ *
+ * Usage:
+ * @code
+ * make bench RELEASE=1
+ * ./build/bench_mipgen [size]
+ * @endcode
+ *
+ * Uses a size x size (default 4096) pseudo-random RGBA8 image, so the
+ * numbers do not depend on a texture being present. MPix/s counts level 0
+ * texels per second of full-chain generation; compare against the
+ * "Texture mips (blit)" line the renderer prints with CPU_MIPMAPS off.
+ */
+#include "../include/MipGenerator.hpp"
+#include "../include/ThreadPool.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+/** @brief Milliseconds elapsed since 'start'. */
+double msSince(std::chrono::high_resolution_clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(
+             std::chrono::high_resolution_clock::now() - start)
+      .count();
+}
+
+/** @brief Best of 'runs' timings of 'body', in milliseconds. */
+template <typename F> double bestOf(int runs, F &&body) {
+  double best = 1e30;
+  for (int i = 0; i < runs; i++) {
+    auto start = std::chrono::high_resolution_clock::now();
+    body();
+    best = std::min(best, msSince(start));
+  }
+  return best;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  const uint32_t size =
+      argc > 1 ? static_cast<uint32_t>(std::stoul(argv[1])) : 4096;
+  const double megapixels = static_cast<double>(size) * size / 1e6;
+
+  const std::vector<mipgen::LevelLayout> levels =
+      mipgen::layoutChain(size, size);
+  std::vector<uint8_t> chain(levels.back().offset + levels.back().size);
+  std::mt19937 rng(42);
+  for (size_t i = 0; i < levels[0].size; i++) {
+    chain[i] = static_cast<uint8_t>(rng());
+  }
+  std::cout << size << "x" << size << ", " << levels.size() << " levels\n";
+
+  auto report = [&](const char *label, double ms) {
+    std::cout << std::left << std::setw(22) << label << std::right
+              << std::fixed << std::setprecision(2) << std::setw(9) << ms
+              << " ms " << std::setprecision(1) << std::setw(8)
+              << megapixels / (ms / 1000.0) << " MPix/s\n";
+  };
+
+  mipgen::MipLevel base{size, size,
+                        {chain.begin(), chain.begin() + levels[0].size}};
+  report("scalar reference", bestOf(3, [&]() {
+           mipgen::MipLevel level = base;
+           while (level.width > 1 || level.height > 1) {
+             level = mipgen::downsample(level);
+           }
+         }));
+
+  const size_t hardware = std::max(1u, std::thread::hardware_concurrency());
+  for (size_t threads = 1;; threads = std::min(threads * 2, hardware)) {
+    ThreadPool pool(threads);
+    report(("simd/" + std::to_string(threads)).c_str(), bestOf(3, [&]() {
+             mipgen::generateChain(chain.data(), levels, pool);
+           }));
+    if (threads == hardware) {
+      break;
+    }
+  }
+
+  // The parallel result must match the scalar reference bit for bit
+  mipgen::MipLevel level = base;
+  for (size_t i = 1; i < levels.size(); i++) {
+    level = mipgen::downsample(level);
+    if (std::memcmp(level.rgba.data(), chain.data() + levels[i].offset,
+                    levels[i].size) != 0) {
+      std::cerr << "mismatch at level " << i << "\n";
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,195 @@
+/**
+ * @file bench_objparse.cpp
+ * @brief OBJ loading benchmark: TinyOBJLoader vs. the parallel objparser.
+ *
+ * Usage:
+ * @code
+ * make bench RELEASE=1
+ * ./build/bench_objparse [model.obj] [iterations]
+ * ./build/bench_objparse --synthetic <megabytes> [iterations]
+ * @endcode
+ *
+ * For every thread count (1, 2, 4, ... up to the hardware concurrency) the
+ * benchmark reports:
+ * - **parse**: objparser::parse() alone (the parallel part), and
+ * - **load**: meshloader::loadObjParallel() (parse + vertex assembly + dedup),
+ * next to meshloader::loadObj() (tinyobj). The parallel result is compared
+ * against the tinyobj result and the run fails if they differ.
+ *
+ * '--synthetic' writes a tessellated grid OBJ of roughly the given size to
+ * the temp directory, which is useful for scaling runs on large inputs.
+ */
+#include "../include/MappedFile.hpp"
+#include "../include/MeshLoader.hpp"
+#include "../include/ObjParser.hpp"
+#include "../include/ThreadPool.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+/** @brief Milliseconds elapsed since 'start'. */
+double msSince(std::chrono::high_resolution_clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(
+             std::chrono::high_resolution_clock::now() - start)
+      .count();
+}
+
+/**
+ * @brief Writes a textured grid OBJ of approximately 'megabytes' MB.
+ *
+ * Uses triangles, quads and a few negative (relative) indices so all parser
+ * paths are exercised.
+ */
+void writeSyntheticObj(const std::string &path, size_t megabytes) {
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  if (!out.is_open()) {
+    throw std::runtime_error("Failed to create " + path);
+  }
+
+  // ~70 bytes per grid vertex ('v' + 'vt') and ~60 bytes per cell
+  const size_t cells =
+      std::max<size_t>(1, static_cast<size_t>(std::sqrt(
+                              static_cast<double>(megabytes) * 1e6 / 130.0)));
+  const size_t side = cells + 1;
+
+  out << std::fixed << std::setprecision(6);
+  for (size_t y = 0; y < side; y++) {
+    for (size_t x = 0; x < side; x++) {
+      float fx = static_cast<float>(x) / cells, fy = static_cast<float>(y) / cells;
+      out << "v " << fx << ' ' << fy << ' ' << 0.25f * fx * fy << '\n'
+          << "vt " << fx << ' ' << fy << '\n';
+    }
+  }
+  for (size_t y = 0; y < cells; y++) {
+    for (size_t x = 0; x < cells; x++) {
+      size_t a = y * side + x + 1, b = a + 1, c = a + side + 1, d = a + side;
+      if ((x + y) % 2 == 0) {
+        out << "f " << a << '/' << a << ' ' << b << '/' << b << ' ' << c << '/'
+            << c << ' ' << d << '/' << d << '\n';
+      } else {
+        out << "f " << a << '/' << a << ' ' << b << '/' << b << ' ' << c << '/'
+            << c << '\n'
+            << "f " << a << '/' << a << ' ' << c << '/' << c << ' ' << d << '/'
+            << d << '\n';
+      }
+    }
+  }
+  // Relative indices referencing the last grid vertices
+  out << "f -1/-1 -2/-2 -3/-3\n";
+}
+
+/** @brief True if both meshes have bit-identical vertices and indices. */
+bool identical(const MeshData &a, const MeshData &b) {
+  return a.vertices.size() == b.vertices.size() &&
+         a.indices == b.indices &&
+         std::memcmp(a.vertices.data(), b.vertices.data(),
+                     a.vertices.size() * sizeof(Vertex)) == 0;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  std::string modelPath = "models/statue.obj";
+  int iterations = 3;
+  bool synthetic = false;
+
+  int arg = 1;
+  if (argc > 2 && std::string(argv[1]) == "--synthetic") {
+    synthetic = true;
+    modelPath =
+        (std::filesystem::temp_directory_path() / "bench_objparse.obj").string();
+    arg = 3;
+  } else if (argc > 1) {
+    modelPath = argv[1];
+    arg = 2;
+  }
+  if (argc > arg) {
+    iterations = std::max(1, std::atoi(argv[arg]));
+  }
+
+  try {
+    if (synthetic) {
+      writeSyntheticObj(modelPath, std::max(1, std::atoi(argv[2])));
+    }
+    const auto fileBytes = std::filesystem::file_size(modelPath);
+
+    // Reference: tinyobj (single-threaded)
+    MeshData reference;
+    double tinyMs = 0.0;
+    for (int i = 0; i < iterations; i++) {
+      auto start = std::chrono::high_resolution_clock::now();
+      reference = meshloader::loadObj(modelPath);
+      tinyMs += msSince(start);
+    }
+    tinyMs /= iterations;
+
+    std::cout << "model:   " << modelPath << " (" << fileBytes / (1024 * 1024)
+              << " MiB, " << reference.vertices.size() << " vertices, "
+              << reference.indices.size() << " indices)\n"
+              << "tinyobj: " << tinyMs << " ms\n\n"
+              << std::left << std::setw(9) << "threads" << std::setw(13)
+              << "parse ms" << std::setw(13) << "load ms" << std::setw(13)
+              << "parse MB/s" << "vs tinyobj\n";
+
+    std::vector<size_t> threadCounts;
+    const size_t hardware = std::max(1u, std::thread::hardware_concurrency());
+    for (size_t n = 1; n < hardware; n *= 2) {
+      threadCounts.push_back(n);
+    }
+    threadCounts.push_back(hardware);
+
+    for (size_t threads : threadCounts) {
+      ThreadPool pool(threads);
+      MappedFile file(modelPath);
+
+      double parseMs = 0.0;
+      for (int i = 0; i < iterations; i++) {
+        auto start = std::chrono::high_resolution_clock::now();
+        objparser::ObjData obj = objparser::parse(file.bytes(), pool);
+        parseMs += msSince(start);
+      }
+      parseMs /= iterations;
+
+      MeshData mesh;
+      double loadMs = 0.0;
+      for (int i = 0; i < iterations; i++) {
+        auto start = std::chrono::high_resolution_clock::now();
+        mesh = meshloader::loadObjParallel(modelPath, pool);
+        loadMs += msSince(start);
+      }
+      loadMs /= iterations;
+
+      if (!identical(mesh, reference)) {
+        std::cerr << "Parallel parser output differs from tinyobj at "
+                  << threads << " threads!" << std::endl;
+        return EXIT_FAILURE;
+      }
+
+      std::cout << std::left << std::setw(9) << threads << std::setw(13)
+                << parseMs << std::setw(13) << loadMs << std::setw(13)
+                << fileBytes / 1e3 / std::max(parseMs, 1e-6)
+                << tinyMs / std::max(loadMs, 1e-6) << "x\n";
+    }
+  } catch (const std::exception &e) {
+    std::cerr << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  if (synthetic) {
+    std::filesystem::remove(modelPath);
+  }
+  return EXIT_SUCCESS;
+}
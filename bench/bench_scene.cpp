@@ -0,0 +1,126 @@
+/**
+ * @file bench_scene.cpp
+ * @brief Per-frame CPU cost of scene instances: culling, LOD selection and
+ *        instance matrix writes at 1k/10k/100k instances.
+ *
+ * Usage:
+ * @code
+ * make bench RELEASE=1
+ * ./build/bench_scene [instances...]
+ * @endcode
+ *
+ * For each instance count (default 1000, 10000 and 100000) a scene is
+ * generated with scene::generate() and its world matrices computed once,
+ * as the renderer does at startup. scene::batchInstances() is then timed
+ * for two cameras: the renderer's default view framing the whole scene, and
+ * a close view from inside it where most instances are frustum-culled. The
+ * mesh is a statue-sized box with a five-level LOD chain.
+ */
+#define GLM_FORCE_DEPTH_ZERO_TO_ONE // Vulkan clip depth, as in render.hpp
+#include "../include/Scene.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+namespace {
+
+using Clock = std::chrono::high_resolution_clock;
+
+/** @brief Frames timed per camera. */
+constexpr int kFrames = 50;
+
+/** @brief Times batchInstances() for one camera and prints the result. */
+void measure(const std::string &label, const std::vector<glm::mat4> &worlds,
+             const std::vector<uint32_t> &meshIds, scene::BatchParams params,
+             glm::vec3 eye, glm::vec3 target) {
+  params.view = glm::lookAt(eye, target, glm::vec3(0.0f, 0.0f, 1.0f));
+  params.proj = glm::perspective(glm::radians(45.0f), 720.0f / 540.0f, 0.1f,
+                                 4.0f * glm::length(eye - target) + 10.0f);
+  params.proj[1][1] *= -1;
+
+  std::vector<glm::mat4> out(worlds.size());
+  scene::InstanceBatches batches;
+  scene::batchInstances(worlds, meshIds, params, out, batches); // Warm up
+
+  const Clock::time_point start = Clock::now();
+  for (int frame = 0; frame < kFrames; frame++) {
+    params.local = glm::rotate(glm::mat4(1.0f), 0.01f * frame,
+                               glm::vec3(0.0f, 0.0f, 1.0f));
+    scene::batchInstances(worlds, meshIds, params, out, batches);
+  }
+  const double ms =
+      std::chrono::duration<double, std::milli>(Clock::now() - start)
+          .count() /
+      kFrames;
+
+  std::cout << "  " << std::left << std::setw(7) << label << std::right
+            << std::fixed << std::setprecision(3) << std::setw(9) << ms
+            << " ms/frame" << std::setprecision(1) << std::setw(8)
+            << ms * 1e6 / static_cast<double>(worlds.size())
+            << " ns/instance" << std::setw(8) << batches.visible
+            << " visible" << std::setw(8) << batches.culled
+            << " culled, per LOD:";
+  for (uint32_t count : batches.lodCount) {
+    std::cout << " " << count;
+  }
+  std::cout << "\n";
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  std::vector<size_t> counts;
+  for (int i = 1; i < argc; i++) {
+    counts.push_back(static_cast<size_t>(std::max(1ll, std::atoll(argv[i]))));
+  }
+  if (counts.empty()) {
+    counts = {1000, 10000, 100000};
+  }
+
+  std::vector<MeshLod> lods(5);
+  const float errors[] = {0.0f, 0.002f, 0.005f, 0.01f, 0.02f};
+  for (size_t i = 0; i < lods.size(); i++) {
+    lods[i].error = errors[i];
+  }
+  scene::BatchParams params;
+  params.boundsMin = glm::vec3(-0.5f, -0.5f, 0.0f);
+  params.boundsMax = glm::vec3(0.5f, 0.5f, 1.5f);
+  params.lods = lods;
+  params.viewportHeight = 540.0f;
+
+  for (size_t count : counts) {
+    const scene::Scene generated =
+        scene::generate({{"models/statue.obj", ""}}, count);
+
+    Clock::time_point start = Clock::now();
+    std::vector<glm::mat4> worlds(count);
+    scene::computeMatrices(generated.instances, worlds);
+    const double matricesMs =
+        std::chrono::duration<double, std::milli>(Clock::now() - start)
+            .count();
+
+    const float radius = scene::boundingRadius(
+        generated.instances, params.boundsMin, params.boundsMax);
+    std::cout << count << " instances (radius " << std::setprecision(1)
+              << std::fixed << radius << "), world matrices "
+              << std::setprecision(3) << matricesMs << " ms\n";
+
+    // Default renderer camera: on the diagonal, framing the whole scene
+    const float distance = radius / std::sin(glm::radians(22.5f));
+    measure("framed", worlds, generated.instances.meshIds, params,
+            glm::vec3(distance / std::sqrt(3.0f)), glm::vec3(0.0f));
+    // Close to the ground inside the grid, looking along it
+    measure("inside", worlds, generated.instances.meshIds, params,
+            glm::vec3(0.0f, -0.5f * radius, 3.0f),
+            glm::vec3(0.0f, 0.0f, 0.0f));
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,237 @@
+/**
+ * @file bench_staging.cpp
+ * @brief Mesh uploads: a staging buffer per upload against StagingPool
+ *        ranges.
+ *
+ * Usage:
+ * @code
+ * make bench RELEASE=1
+ * ./build/bench_staging [meshes] [rounds]
+ * @endcode
+ *
+ * Uploads 'meshes' small meshes (default 1000) into device-local vertex
+ * and index buffers created up front, 'rounds' times (default 5), on a
+ * headless device (first GPU, no window). Vertex counts are uniform in
+ * [64, 4096] at 32 bytes per vertex, with 1.5 32-bit indices per vertex, as
+ * a typical small asset. Compared:
+ * - per-upload: what createVertexBuffer() and createIndexBuffer() used to
+ *   do; a new transient staging buffer (vkCreateBuffer plus a GpuAllocator
+ *   allocation) per copy, a one-shot command buffer, a queue wait, and the
+ *   buffer destroyed afterwards;
+ * - pool: the same one-shot submissions from StagingPool ranges, released
+ *   after the wait;
+ * - pool, batched: every copy recorded into one command buffer, submitted
+ *   once, the ranges released after its wait. Only possible when staging
+ *   memory outlives the call that fills it.
+ *
+ * Reported per path: ms per round (best of the rounds), us per mesh, and
+ * the staging buffers created over all rounds.
+ */
+#include "../include/GpuAllocator.hpp"
+#include "../include/StagingPool.hpp"
+#include "BenchGpu.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <vulkan/vulkan_raii.hpp>
+
+namespace {
+
+using Clock = std::chrono::high_resolution_clock;
+using bench::Gpu;
+
+/** @brief Bytes per vertex (position, normal, UV as in VertexFormats). */
+constexpr size_t kVertexBytes = 32;
+
+/** @brief One mesh: its data and its device-local destination buffers. */
+struct Mesh {
+  std::vector<std::byte> vertices;         ///< Vertex data
+  std::vector<std::byte> indices;          ///< Index data
+  vk::raii::Buffer vertexBuffer = nullptr; ///< Device-local vertex buffer
+  GpuAllocation vertexMemory = nullptr;    ///< Its memory
+  vk::raii::Buffer indexBuffer = nullptr;  ///< Device-local index buffer
+  GpuAllocation indexMemory = nullptr;     ///< Its memory
+};
+
+/** @brief Generates the meshes and creates their destination buffers. */
+std::vector<Mesh> createMeshes(Gpu &gpu, uint32_t count) {
+  std::mt19937 rng(7);
+  std::uniform_int_distribution<size_t> vertexCount(64, 4096);
+  std::vector<Mesh> meshes(count);
+  for (Mesh &mesh : meshes) {
+    const size_t vertices = vertexCount(rng);
+    mesh.vertices.resize(vertices * kVertexBytes);
+    mesh.indices.resize(vertices * 3 / 2 * sizeof(uint32_t));
+    for (size_t i = 0; i < mesh.vertices.size(); i++) {
+      mesh.vertices[i] = static_cast<std::byte>(rng());
+    }
+    for (size_t i = 0; i < mesh.indices.size(); i++) {
+      mesh.indices[i] = static_cast<std::byte>(rng());
+    }
+    mesh.vertexBuffer = bench::createBuffer(
+        gpu, mesh.vertices.size(),
+        vk::BufferUsageFlagBits::eVertexBuffer |
+            vk::BufferUsageFlagBits::eTransferDst,
+        vk::MemoryPropertyFlagBits::eDeviceLocal,
+        GpuAllocator::Category::eVertex, mesh.vertexMemory);
+    mesh.indexBuffer = bench::createBuffer(
+        gpu, mesh.indices.size(),
+        vk::BufferUsageFlagBits::eIndexBuffer |
+            vk::BufferUsageFlagBits::eTransferDst,
+        vk::MemoryPropertyFlagBits::eDeviceLocal,
+        GpuAllocator::Category::eIndex, mesh.indexMemory);
+  }
+  return meshes;
+}
+
+/** @brief Records 'record' into a one-shot command buffer and waits. */
+void recordAndWait(
+    Gpu &gpu, const std::function<void(vk::raii::CommandBuffer &)> &record) {
+  vk::raii::CommandBuffer commandBuffer = bench::allocateCommandBuffer(gpu);
+  vk::CommandBufferBeginInfo beginInfo{};
+  beginInfo.flags = vk::CommandBufferUsageFlagBits::eOneTimeSubmit;
+  commandBuffer.begin(beginInfo);
+  record(commandBuffer);
+  commandBuffer.end();
+  bench::submitAndWait(gpu, commandBuffer);
+}
+
+/** @brief Old path: a staging buffer and a queue wait per copy. */
+void uploadPerBuffer(Gpu &gpu, std::vector<Mesh> &meshes) {
+  auto upload = [&](const std::vector<std::byte> &bytes,
+                    vk::raii::Buffer &target) {
+    GpuAllocation stagingMemory = nullptr;
+    const vk::raii::Buffer staging = bench::createBuffer(
+        gpu, bytes.size(), vk::BufferUsageFlagBits::eTransferSrc,
+        vk::MemoryPropertyFlagBits::eHostVisible |
+            vk::MemoryPropertyFlagBits::eHostCoherent,
+        GpuAllocator::Category::eStaging, stagingMemory,
+        GpuAllocator::Usage::eTransient);
+    memcpy(stagingMemory.mapped(), bytes.data(), bytes.size());
+    recordAndWait(gpu, [&](vk::raii::CommandBuffer &commandBuffer) {
+      commandBuffer.copyBuffer(*staging, *target,
+                               vk::BufferCopy(0, 0, bytes.size()));
+    });
+  };
+  for (Mesh &mesh : meshes) {
+    upload(mesh.vertices, mesh.vertexBuffer);
+    upload(mesh.indices, mesh.indexBuffer);
+  }
+}
+
+/** @brief Pool ranges, still with a queue wait per copy. */
+void uploadPool(Gpu &gpu, StagingPool &pool, std::vector<Mesh> &meshes) {
+  auto upload = [&](const std::vector<std::byte> &bytes,
+                    vk::raii::Buffer &target) {
+    const StagingPool::Range range = pool.upload(bytes);
+    recordAndWait(gpu, [&](vk::raii::CommandBuffer &commandBuffer) {
+      commandBuffer.copyBuffer(range.buffer, *target,
+                               vk::BufferCopy(range.offset, 0, range.size));
+    });
+    pool.release(range);
+  };
+  for (Mesh &mesh : meshes) {
+    upload(mesh.vertices, mesh.vertexBuffer);
+    upload(mesh.indices, mesh.indexBuffer);
+  }
+}
+
+/** @brief Pool ranges, all copies in one submission. */
+void uploadPoolBatched(Gpu &gpu, StagingPool &pool, std::vector<Mesh> &meshes) {
+  std::vector<StagingPool::Range> ranges;
+  recordAndWait(gpu, [&](vk::raii::CommandBuffer &commandBuffer) {
+    for (Mesh &mesh : meshes) {
+      for (auto [bytes, target] :
+           {std::pair(&mesh.vertices, &mesh.vertexBuffer),
+            std::pair(&mesh.indices, &mesh.indexBuffer)}) {
+        const StagingPool::Range range = pool.upload(*bytes);
+        commandBuffer.copyBuffer(range.buffer, **target,
+                                 vk::BufferCopy(range.offset, 0, range.size));
+        ranges.push_back(range);
+      }
+    }
+  });
+  for (const StagingPool::Range &range : ranges) {
+    pool.release(range); // recordAndWait() has waited
+  }
+  pool.collect();
+}
+
+/** @brief Runs 'upload' for each round and prints the best one. */
+void run(const std::string &label, uint32_t rounds, size_t meshCount,
+         const std::function<void()> &upload,
+         const std::function<uint64_t()> &buffersCreated) {
+  double best = 1e30;
+  for (uint32_t round = 0; round < rounds; round++) {
+    const Clock::time_point start = Clock::now();
+    upload();
+    best = std::min(
+        best, std::chrono::duration<double>(Clock::now() - start).count());
+  }
+  std::cout << "  " << std::left << std::setw(15) << label << std::right
+            << std::fixed << std::setprecision(2) << std::setw(10)
+            << best * 1e3 << " ms/round" << std::setw(9)
+            << best * 1e6 / static_cast<double>(meshCount) << " us/mesh"
+            << std::setw(8) << buffersCreated() << " staging buffers\n";
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  auto arg = [&](int index, uint32_t fallback) {
+    return argc > index
+               ? static_cast<uint32_t>(std::max(1, std::atoi(argv[index])))
+               : fallback;
+  };
+  const uint32_t meshCount = arg(1, 1000);
+  const uint32_t rounds = arg(2, 5);
+
+  try {
+    Gpu gpu;
+    // Graphics and compute queues can always transfer
+    bench::DeviceOptions options;
+    options.family = [](const vk::QueueFamilyProperties &family) {
+      return static_cast<bool>(family.queueFlags &
+                               (vk::QueueFlagBits::eGraphics |
+                                vk::QueueFlagBits::eCompute |
+                                vk::QueueFlagBits::eTransfer));
+    };
+    bench::createGpu(gpu, "bench_staging", options);
+    std::vector<Mesh> meshes = createMeshes(gpu, meshCount);
+    size_t bytes = 0;
+    for (const Mesh &mesh : meshes) {
+      bytes += mesh.vertices.size() + mesh.indices.size();
+    }
+    std::cout << meshCount << " meshes, " << bytes / 1024 << " KiB per round, "
+              << rounds << " rounds on "
+              << gpu.physicalGPU.getProperties().deviceName.data() << "\n";
+
+    run("per-upload", rounds, meshCount,
+        [&] { uploadPerBuffer(gpu, meshes); },
+        [&] { return uint64_t{2} * meshCount * rounds; });
+
+    StagingPool pool(gpu.device, *gpu.allocator);
+    run("pool", rounds, meshCount, [&] { uploadPool(gpu, pool, meshes); },
+        [&] { return pool.stats().chunksCreated; });
+
+    StagingPool batchedPool(gpu.device, *gpu.allocator);
+    run("pool, batched", rounds, meshCount,
+        [&] { uploadPoolBatched(gpu, batchedPool, meshes); },
+        [&] { return batchedPool.stats().chunksCreated; });
+
+    gpu.device.waitIdle();
+  } catch (const std::exception &e) {
+    std::cerr << "bench_staging: " << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,305 @@
+/**
+ * @file bench_upload.cpp
+ * @brief How long uploads block the frame loop: one-shot graphics queue
+ *        submissions with a queue wait per copy against UploadQueue
+ *        batches on a transfer queue.
+ *
+ * Usage:
+ * @code
+ * make bench RELEASE=1
+ * ./build/bench_upload [frames] [uploadKB]
+ * @endcode
+ *
+ * Simulates 'frames' frames (default 200), two in flight, on a headless
+ * device (first GPU, no window). Every frame uploads 'uploadKB' KiB
+ * (default 2048) in kCopies buffer copies from StagingPool ranges, then
+ * records a frame that clears a scratch buffer (the stand-in for rendering)
+ * and reads the uploaded bytes. Compared:
+ * - blocking: what copyBuffer() used to do; a one-shot command buffer per
+ *   copy on the graphics queue, submitted and followed by a queue wait,
+ *   which also drains the frame still in flight;
+ * - upload queue: the copies recorded into one UploadQueue batch on a
+ *   transfer-only queue family (the graphics family when the GPU has
+ *   none), acquired by the frame, whose submission waits for the batch on
+ *   the timeline semaphore;
+ * - upload queue, graphics family: the same on the graphics queue, when a
+ *   transfer-only family exists.
+ *
+ * Reported per path: host time blocked in uploads per frame, frame time
+ * (wall clock over all frames), and the frames that waited for a batch.
+ */
+#include "../include/GpuAllocator.hpp"
+#include "../include/StagingPool.hpp"
+#include "../include/UploadQueue.hpp"
+#include "BenchGpu.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <optional>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <vulkan/vulkan_raii.hpp>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+/** @brief Frames recorded ahead of the GPU, as in the renderer. */
+constexpr size_t kFramesInFlight = 2;
+
+/** @brief Buffer copies each frame's upload is split into. */
+constexpr uint32_t kCopies = 8;
+
+/** @brief Bytes the frame's stand-in rendering work clears. */
+constexpr vk::DeviceSize kScratchBytes = 64ull << 20;
+
+using bench::Gpu;
+
+/**
+ * @brief Creates the instance and a device with timeline semaphores, a
+ * graphics queue and, if the device has one, a transfer-only queue.
+ *
+ * @return The transfer-only family, if any.
+ */
+std::optional<uint32_t> createGpu(Gpu &gpu) {
+  bench::selectGpu(gpu, "bench_upload");
+
+  const std::vector<vk::QueueFamilyProperties> families =
+      gpu.physicalGPU.getQueueFamilyProperties();
+  const auto transfer = std::find_if(
+      families.begin(), families.end(), [](const auto &family) {
+        return (family.queueFlags & vk::QueueFlagBits::eTransfer) &&
+               !(family.queueFlags &
+                 (vk::QueueFlagBits::eGraphics | vk::QueueFlagBits::eCompute));
+      });
+
+  vk::PhysicalDeviceVulkan13Features features13{};
+  features13.synchronization2 = VK_TRUE;
+  vk::PhysicalDeviceVulkan12Features features12{};
+  features12.pNext = &features13;
+  features12.timelineSemaphore = VK_TRUE;
+  vk::PhysicalDeviceFeatures2 features{};
+  features.pNext = &features12;
+
+  bench::DeviceOptions options;
+  options.features = &features;
+  std::optional<uint32_t> transferFamily;
+  if (transfer != families.end()) {
+    transferFamily =
+        static_cast<uint32_t>(std::distance(families.begin(), transfer));
+    options.otherFamilies.push_back(*transferFamily);
+  }
+  bench::createDevice(gpu, options);
+  return transferFamily;
+}
+
+/** @brief Allocates 'count' primary command buffers from the gpu's pool. */
+std::vector<vk::raii::CommandBuffer> allocateCommandBuffers(const Gpu &gpu,
+                                                            uint32_t count) {
+  vk::CommandBufferAllocateInfo allocInfo{};
+  allocInfo.commandPool = *gpu.commandPool;
+  allocInfo.level = vk::CommandBufferLevel::ePrimary;
+  allocInfo.commandBufferCount = count;
+  vk::raii::CommandBuffers buffers(gpu.device, allocInfo);
+  return {std::make_move_iterator(buffers.begin()),
+          std::make_move_iterator(buffers.end())};
+}
+
+/** @brief Timings of one way of uploading. */
+struct Result {
+  double uploadMs = 0;  ///< Mean host time blocked in uploads per frame
+  double frameMs = 0;   ///< Mean wall time per frame
+  uint64_t waits = 0;   ///< Frames whose submission waited for an upload
+  uint64_t submits = 0; ///< Queue submissions of uploads
+};
+
+/** @brief Prints one row of the results table. */
+void printRow(const std::string &label, const Result &result) {
+  std::cout << std::left << std::setw(32) << label << std::right << std::fixed
+            << std::setprecision(3) << std::setw(11) << result.uploadMs
+            << std::setw(10) << result.frameMs << std::setw(8)
+            << result.waits << std::setw(9) << result.submits << "\n";
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+  const uint32_t frames =
+      argc > 1 ? static_cast<uint32_t>(std::max(1, std::atoi(argv[1]))) : 200;
+  const vk::DeviceSize uploadBytes =
+      (argc > 2 ? static_cast<vk::DeviceSize>(std::max(1, std::atoi(argv[2])))
+                : 2048) *
+      1024 / kCopies * kCopies;
+
+  try {
+    Gpu gpu;
+    const std::optional<uint32_t> transferFamily = createGpu(gpu);
+    StagingPool stagingPool(gpu.device, *gpu.allocator);
+
+    std::vector<std::byte> bytes(uploadBytes / kCopies);
+    std::mt19937 random(3);
+    for (std::byte &byte : bytes) {
+      byte = static_cast<std::byte>(random());
+    }
+
+    // A destination half per frame slot, a readback and the scratch buffer
+    GpuAllocation targetMemory = nullptr;
+    const vk::raii::Buffer target = bench::createBuffer(
+        gpu, kFramesInFlight * uploadBytes,
+        vk::BufferUsageFlagBits::eTransferDst |
+            vk::BufferUsageFlagBits::eTransferSrc,
+        vk::MemoryPropertyFlagBits::eDeviceLocal,
+        GpuAllocator::Category::eOther, targetMemory);
+    GpuAllocation readbackMemory = nullptr;
+    const vk::raii::Buffer readback = bench::createBuffer(
+        gpu, uploadBytes, vk::BufferUsageFlagBits::eTransferDst,
+        vk::MemoryPropertyFlagBits::eDeviceLocal,
+        GpuAllocator::Category::eOther, readbackMemory);
+    GpuAllocation scratchMemory = nullptr;
+    const vk::raii::Buffer scratch = bench::createBuffer(
+        gpu, kScratchBytes, vk::BufferUsageFlagBits::eTransferDst,
+        vk::MemoryPropertyFlagBits::eDeviceLocal,
+        GpuAllocator::Category::eOther, scratchMemory);
+
+    std::vector<vk::raii::CommandBuffer> frameCommands =
+        allocateCommandBuffers(gpu, kFramesInFlight);
+    std::vector<vk::raii::Fence> fences;
+    for (size_t i = 0; i < kFramesInFlight; i++) {
+      fences.emplace_back(gpu.device, vk::FenceCreateInfo{
+                                          vk::FenceCreateFlagBits::eSignaled});
+    }
+
+    // Runs the frame loop; 'upload' stages and copies one frame's bytes to
+    // 'offset' and 'uploadQueue' (if any) is acquired by the frame
+    auto run = [&](auto &&upload, UploadQueue *uploadQueue) {
+      Result result;
+      double uploadMs = 0;
+      const Clock::time_point start = Clock::now();
+      for (uint32_t frame = 0; frame < frames; frame++) {
+        const size_t slot = frame % kFramesInFlight;
+        if (gpu.device.waitForFences(*fences[slot], VK_TRUE, UINT64_MAX) !=
+            vk::Result::eSuccess) {
+          throw std::runtime_error("Fence wait failed");
+        }
+        gpu.device.resetFences(*fences[slot]);
+        if (uploadQueue != nullptr) {
+          uploadQueue->collect();
+        }
+        stagingPool.collect();
+
+        const Clock::time_point uploadStart = Clock::now();
+        result.submits += upload(slot * uploadBytes);
+        uploadMs += std::chrono::duration<double, std::milli>(Clock::now() -
+                                                              uploadStart)
+                        .count();
+
+        const vk::raii::CommandBuffer &cmd = frameCommands[slot];
+        cmd.reset();
+        cmd.begin(vk::CommandBufferBeginInfo{
+            vk::CommandBufferUsageFlagBits::eOneTimeSubmit});
+        // The frame reads every batch submitted so far
+        UploadQueue::Wait wait;
+        if (uploadQueue != nullptr) {
+          wait = uploadQueue->acquire(cmd, UINT64_MAX);
+        }
+        cmd.fillBuffer(*scratch, 0, kScratchBytes, frame);
+        cmd.copyBuffer(*target, *readback,
+                       vk::BufferCopy(slot * uploadBytes, 0, uploadBytes));
+        cmd.end();
+
+        vk::SemaphoreSubmitInfo waitInfo{};
+        vk::CommandBufferSubmitInfo commandBufferInfo{};
+        commandBufferInfo.commandBuffer = *cmd;
+        vk::SubmitInfo2 submitInfo{};
+        submitInfo.commandBufferInfoCount = 1;
+        submitInfo.pCommandBufferInfos = &commandBufferInfo;
+        if (wait.value > 0) {
+          waitInfo.semaphore = *uploadQueue->semaphore();
+          waitInfo.value = wait.value;
+          waitInfo.stageMask = wait.stages;
+          submitInfo.waitSemaphoreInfoCount = 1;
+          submitInfo.pWaitSemaphoreInfos = &waitInfo;
+          result.waits++;
+        }
+        gpu.queue.submit2(submitInfo, *fences[slot]);
+      }
+      gpu.device.waitIdle();
+      result.frameMs =
+          std::chrono::duration<double, std::milli>(Clock::now() - start)
+              .count() /
+          frames;
+      result.uploadMs = uploadMs / frames;
+      if (uploadQueue != nullptr) {
+        uploadQueue->collect();
+      }
+      stagingPool.collect();
+      return result;
+    };
+
+    // Blocking: a one-shot submit and a queue wait per copy
+    std::vector<vk::raii::CommandBuffer> oneShot =
+        allocateCommandBuffers(gpu, 1);
+    const Result blocking = run(
+        [&](vk::DeviceSize offset) {
+          for (uint32_t i = 0; i < kCopies; i++) {
+            const StagingPool::Range range = stagingPool.upload(bytes);
+            oneShot[0].reset();
+            oneShot[0].begin(vk::CommandBufferBeginInfo{
+                vk::CommandBufferUsageFlagBits::eOneTimeSubmit});
+            oneShot[0].copyBuffer(
+                range.buffer, *target,
+                vk::BufferCopy(range.offset, offset + i * bytes.size(),
+                               range.size));
+            oneShot[0].end();
+            vk::SubmitInfo submitInfo{};
+            submitInfo.commandBufferCount = 1;
+            submitInfo.pCommandBuffers = &*oneShot[0];
+            gpu.queue.submit(submitInfo, nullptr);
+            gpu.queue.waitIdle();
+            stagingPool.release(range);
+          }
+          return kCopies;
+        },
+        nullptr);
+
+    // Batched on an UploadQueue, acquired by the frame
+    auto queued = [&](uint32_t family) {
+      UploadQueue uploadQueue(gpu.device, stagingPool, family, gpu.family);
+      return run(
+          [&](vk::DeviceSize offset) {
+            for (uint32_t i = 0; i < kCopies; i++) {
+              uploadQueue.copy(stagingPool.upload(bytes), *target,
+                               offset + i * bytes.size(),
+                               vk::PipelineStageFlagBits2::eCopy,
+                               vk::AccessFlagBits2::eTransferRead);
+            }
+            uploadQueue.submit();
+            return 1;
+          },
+          &uploadQueue);
+    };
+
+    std::cout << frames << " frames, " << uploadBytes / 1024 << " KiB in "
+              << kCopies << " copies per frame on "
+              << gpu.physicalGPU.getProperties().deviceName.data() << "\n"
+              << std::left << std::setw(32) << "" << std::right
+              << std::setw(11) << "upload ms" << std::setw(10) << "frame ms"
+              << std::setw(8) << "waits" << std::setw(9) << "submits"
+              << "\n";
+    printRow("blocking", blocking);
+    if (transferFamily) {
+      printRow("upload queue, transfer family", queued(*transferFamily));
+    }
+    printRow("upload queue, graphics family", queued(gpu.family));
+  } catch (const std::exception &e) {
+    std::cerr << "bench_upload: " << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,70 @@
+/**
+ * @file bench_vertexformat.cpp
+ * @brief Vertex layout chosen by vertexformat::pack(), its size savings,
+ *        measured quantization error and packing time.
+ *
+ * Usage:
+ * @code
+ * make bench RELEASE=1
+ * ./build/bench_vertexformat [model.obj]
+ * @endcode
+ *
+ * Frame-time impact is measured in the application: run it with and without
+ * QUANTIZE_VERTICES (render.hpp) and compare the average frame time printed
+ * on exit.
+ */
+#include "../include/MeshLoader.hpp"
+#include "../include/VertexFormats.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+namespace {
+
+/** @brief Milliseconds elapsed since 'start'. */
+double msSince(std::chrono::high_resolution_clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(
+             std::chrono::high_resolution_clock::now() - start)
+      .count();
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  const std::string modelPath = argc > 1 ? argv[1] : "models/statue.obj";
+
+  try {
+    MeshData mesh = meshloader::loadObjParallel(modelPath);
+    std::cout << "model: " << modelPath << " (" << mesh.vertices.size()
+              << " vertices)\n\n"
+              << std::left << std::setw(10) << "options" << std::setw(48)
+              << "layout" << std::setw(10) << "B/vertex" << std::setw(10)
+              << "MiB" << std::setw(12) << "pack ms"
+              << "max error (position, UV)\n";
+
+    for (bool forceFloat : {true, false}) {
+      vertexformat::Options options;
+      options.forceFloat = forceFloat;
+
+      auto start = std::chrono::high_resolution_clock::now();
+      vertexformat::PackedVertices packed = vertexformat::pack(
+          mesh.vertices, mesh.boundsMin, mesh.boundsMax, options);
+      const double packMs = msSince(start);
+
+      std::cout << std::setw(10) << (forceFloat ? "float" : "auto")
+                << std::setw(48) << vertexformat::name(packed.layout)
+                << std::setw(10) << packed.stride << std::setw(10)
+                << std::setprecision(4)
+                << packed.data.size() / (1024.0 * 1024.0) << std::setw(12)
+                << packMs << packed.positionError << ", "
+                << packed.texCoordError << "\n";
+    }
+  } catch (const std::exception &e) {
+    std::cerr << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,460 @@
+/**
+ * @file bench_vertexpull.cpp
+ * @brief Pipelines and draw submission cost of fixed-function vertex input
+ *        against vertex pulling, for many meshes in mixed vertex layouts.
+ *
+ * Usage:
+ * @code
+ * make shaders && make bench RELEASE=1
+ * ./build/bench_vertexpull [meshes] [iterations]
+ * # On the software rasterizer (Mesa lavapipe):
+ * VK_DRIVER_FILES=/usr/share/vulkan/icd.d/lvp_icd.x86_64.json \
+ *     ./build/bench_vertexpull
+ * @endcode
+ *
+ * Uploads 'meshes' distinct meshes (default 1000, 64 to 512 vertices, 6
+ * indices per vertex) into one GeometryArena on a headless device (first
+ * GPU, no window), cycling through every vertexformat::Layout, and draws
+ * each once per frame (default 50 frames) with the renderer's vertex
+ * shaders (shaders/*.spv, run from the repository root):
+ * - vertex input: one pipeline per layout (vert.spv or vert_constcolor.spv)
+ *   bound whenever the layout changes, in submission order and with the
+ *   draws sorted by layout;
+ * - vertex pulling: the single vert_pull.spv pipeline, with the layout's
+ *   push constants updated whenever it changes.
+ *
+ * Both paths bind the arena's buffers once. Reported per path: pipelines
+ * and their creation time, pipeline binds, push constant updates, draws,
+ * CPU record time, and the submit-to-fence time of the frame. The
+ * pipelines rasterize nothing (rasterizer discard, no fragment stage), so
+ * the frame time is vertex fetch and shading; on a software ICD that is
+ * CPU time too.
+ */
+#include "../include/GeometryArena.hpp"
+#include "../include/GpuAllocator.hpp"
+#include "../include/Vertex.hpp"
+#include "../include/VertexFormats.hpp"
+#include "../include/VertexPulling.hpp"
+#include "BenchGpu.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <vulkan/vulkan_raii.hpp>
+
+namespace {
+
+/** @brief Every layout vertexformat::pack() can choose. */
+constexpr vertexformat::Layout kLayouts[] = {
+    vertexformat::Layout::eFloat,
+    vertexformat::Layout::eColorFloatTexCoord,
+    vertexformat::Layout::eColorHalfTexCoord,
+    vertexformat::Layout::eColorUnormTexCoord,
+    vertexformat::Layout::eFloatTexCoord,
+    vertexformat::Layout::eHalfTexCoord,
+    vertexformat::Layout::eUnormTexCoord};
+
+/** @brief Number of entries of kLayouts. */
+constexpr size_t kLayoutCount = std::size(kLayouts);
+
+/** @brief Offset of every vertex buffer bind. */
+constexpr vk::DeviceSize kNoOffset = 0;
+
+using bench::Gpu;
+
+/** @brief Creates the instance and a device with buffer device addresses. */
+void createGpu(Gpu &gpu) {
+  vk::PhysicalDeviceVulkan13Features features13{};
+  features13.dynamicRendering = VK_TRUE;
+  vk::PhysicalDeviceVulkan12Features features12{};
+  features12.pNext = &features13;
+  features12.bufferDeviceAddress = VK_TRUE;
+  vk::PhysicalDeviceFeatures2 features{};
+  features.pNext = &features12;
+
+  bench::DeviceOptions options;
+  options.features = &features;
+  options.deviceAddress = true;
+  bench::createGpu(gpu, "bench_vertexpull", options);
+}
+
+/** @brief Loads a SPIR-V module built by 'make shaders'. */
+vk::raii::ShaderModule loadShader(const Gpu &gpu, const std::string &path) {
+  std::ifstream file(path, std::ios::binary | std::ios::ate);
+  if (!file) {
+    throw std::runtime_error(path + " not found (run 'make shaders' and "
+                                    "start the bench from the repo root)");
+  }
+  std::vector<uint32_t> code(static_cast<size_t>(file.tellg()) /
+                             sizeof(uint32_t));
+  file.seekg(0);
+  file.read(reinterpret_cast<char *>(code.data()),
+            static_cast<std::streamsize>(code.size() * sizeof(uint32_t)));
+  vk::ShaderModuleCreateInfo moduleInfo{};
+  moduleInfo.codeSize = code.size() * sizeof(uint32_t);
+  moduleInfo.pCode = code.data();
+  return vk::raii::ShaderModule(gpu.device, moduleInfo);
+}
+
+/**
+ * @brief Builds a vertex-only pipeline with rasterizer discard.
+ *
+ * @param layout Vertex layout read by fixed-function vertex input, or none
+ * (vertex pulling) when null.
+ */
+vk::raii::Pipeline createPipeline(const Gpu &gpu,
+                                  const vk::raii::PipelineLayout &layout,
+                                  const vk::raii::ShaderModule &module,
+                                  const vertexformat::Layout *vertexLayout) {
+  vk::PipelineShaderStageCreateInfo stage{};
+  stage.stage = vk::ShaderStageFlagBits::eVertex;
+  stage.module = *module;
+  stage.pName = "main";
+
+  std::vector<vk::VertexInputBindingDescription> bindings;
+  std::vector<vk::VertexInputAttributeDescription> attributes;
+  if (vertexLayout != nullptr) {
+    vertexformat::visit(*vertexLayout, [&]<typename L>(L) {
+      bindings.push_back(L::getBindingDescription());
+      auto descriptions = L::getAttributeDescriptions();
+      attributes.assign(descriptions.begin(), descriptions.end());
+    });
+  }
+  bindings.emplace_back(1, sizeof(glm::mat4), vk::VertexInputRate::eInstance);
+  for (uint32_t column = 0; column < 4; column++) {
+    attributes.emplace_back(3 + column, 1, vk::Format::eR32G32B32A32Sfloat,
+                            column * sizeof(glm::vec4));
+  }
+  vk::PipelineVertexInputStateCreateInfo vertexInput{};
+  vertexInput.vertexBindingDescriptionCount =
+      static_cast<uint32_t>(bindings.size());
+  vertexInput.pVertexBindingDescriptions = bindings.data();
+  vertexInput.vertexAttributeDescriptionCount =
+      static_cast<uint32_t>(attributes.size());
+  vertexInput.pVertexAttributeDescriptions = attributes.data();
+
+  vk::PipelineInputAssemblyStateCreateInfo inputAssembly{};
+  inputAssembly.topology = vk::PrimitiveTopology::eTriangleList;
+
+  vk::PipelineRasterizationStateCreateInfo rasterizer{};
+  rasterizer.rasterizerDiscardEnable = VK_TRUE;
+  rasterizer.lineWidth = 1.0f;
+
+  vk::PipelineRenderingCreateInfo renderingInfo{}; // No attachments
+  vk::GraphicsPipelineCreateInfo pipelineInfo{};
+  pipelineInfo.pNext = &renderingInfo;
+  pipelineInfo.stageCount = 1;
+  pipelineInfo.pStages = &stage;
+  pipelineInfo.pVertexInputState = &vertexInput;
+  pipelineInfo.pInputAssemblyState = &inputAssembly;
+  pipelineInfo.pRasterizationState = &rasterizer;
+  pipelineInfo.layout = *layout;
+  return vk::raii::Pipeline(gpu.device, nullptr, pipelineInfo);
+}
+
+/** @brief One mesh of the scene. */
+struct Mesh {
+  size_t layout = 0;                      ///< Index into kLayouts
+  GeometryArena::Mesh geometry = nullptr; ///< Its ranges in the arena
+};
+
+/** @brief Commands and timings of one way of drawing the scene. */
+struct Result {
+  size_t pipelines = 0;     ///< Pipelines created
+  double createMs = 0;      ///< Time to create them
+  size_t pipelineBinds = 0; ///< vkCmdBindPipeline per frame
+  size_t pushes = 0;        ///< vkCmdPushConstants per frame
+  size_t draws = 0;         ///< Draws per frame
+  double recordUs = 0;      ///< Mean CPU record time of a frame
+  double frameMs = 0;       ///< Mean submit-to-fence time of a frame
+};
+
+/** @brief Prints one row of the results table. */
+void printRow(const std::string &label, const Result &result) {
+  std::cout << std::left << std::setw(24) << label << std::right
+            << std::setw(10) << result.pipelines << std::fixed
+            << std::setprecision(1) << std::setw(11) << result.createMs
+            << std::setw(7) << result.pipelineBinds << std::setw(8)
+            << result.pushes << std::setw(7) << result.draws
+            << std::setw(12) << result.recordUs << std::setw(10)
+            << result.frameMs << "\n";
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+  const size_t meshCount = argc > 1 ? std::stoul(argv[1]) : 1000;
+  const int iterations = argc > 2 ? std::stoi(argv[2]) : 50;
+
+  try {
+    Gpu gpu;
+    createGpu(gpu);
+    const vk::raii::CommandBuffer commandBuffer =
+        bench::allocateCommandBuffer(gpu);
+
+    // Meshes: random vertices in the unit cube, encoded in their layout
+    GeometryArena arena(gpu.device, *gpu.allocator,
+                        GeometryArena::kVertexBytes, GeometryArena::kIndexCount,
+                        true);
+    const vertexformat::Quantization quantization; // Unit bounding box
+    std::mt19937 random(42);
+    std::uniform_int_distribution<uint32_t> vertexCounts(64, 512);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    std::vector<Mesh> meshes(meshCount);
+    std::vector<std::byte> upload;
+    std::vector<vk::BufferCopy> vertexCopies;
+    std::vector<vk::BufferCopy> indexCopies;
+    for (size_t i = 0; i < meshCount; i++) {
+      Mesh &mesh = meshes[i];
+      mesh.layout = i % kLayoutCount;
+      const uint32_t stride = vertexformat::strideOf(kLayouts[mesh.layout]);
+      const uint32_t vertexCount = vertexCounts(random);
+      std::vector<Vertex> vertices(vertexCount);
+      for (Vertex &vertex : vertices) {
+        vertex.position = glm::vec3(unit(random), unit(random), unit(random));
+        vertex.color = glm::vec3(unit(random), unit(random), unit(random));
+        vertex.texCoord = glm::vec2(unit(random), unit(random));
+      }
+      std::vector<uint32_t> indices(6 * vertexCount);
+      for (uint32_t &index : indices) {
+        index = random() % vertexCount;
+      }
+      const auto indexCount = static_cast<uint32_t>(indices.size());
+      mesh.geometry = arena.allocate(vertexCount, stride, indexCount);
+      if (!mesh.geometry) {
+        throw std::runtime_error("Geometry arena full");
+      }
+
+      const size_t vertexStart = upload.size();
+      upload.resize(vertexStart + vertexCount * stride);
+      vertexformat::visit(kLayouts[mesh.layout], [&]<typename L>(L) {
+        L::encode(vertices, quantization, upload.data() + vertexStart);
+      });
+      vertexCopies.emplace_back(vertexStart, mesh.geometry.vertexBytes(),
+                                vertexCount * stride);
+      const size_t indexStart = (upload.size() + 3) & ~size_t{3};
+      upload.resize(indexStart + indices.size() * sizeof(uint32_t));
+      std::memcpy(upload.data() + indexStart, indices.data(),
+                  indices.size() * sizeof(uint32_t));
+      indexCopies.emplace_back(indexStart, mesh.geometry.indexBytes(),
+                               indices.size() * sizeof(uint32_t));
+    }
+
+    // One upload of every mesh through a host-visible buffer
+    {
+      GpuAllocation stagingMemory = nullptr;
+      const vk::raii::Buffer staging = bench::createBuffer(
+          gpu, upload.size(), vk::BufferUsageFlagBits::eTransferSrc,
+          vk::MemoryPropertyFlagBits::eHostVisible |
+              vk::MemoryPropertyFlagBits::eHostCoherent,
+          GpuAllocator::Category::eStaging, stagingMemory);
+      std::memcpy(stagingMemory.mapped(), upload.data(), upload.size());
+      commandBuffer.begin(vk::CommandBufferBeginInfo{
+          vk::CommandBufferUsageFlagBits::eOneTimeSubmit});
+      commandBuffer.copyBuffer(*staging, *arena.vertexBuffer(), vertexCopies);
+      commandBuffer.copyBuffer(*staging, *arena.indexBuffer(), indexCopies);
+      commandBuffer.end();
+      bench::submitAndWait(gpu, commandBuffer);
+    }
+
+    // Uniforms (identity matrices) and a single identity instance
+    const glm::mat4 matrices[3] = {glm::mat4(1.0f), glm::mat4(1.0f),
+                                   glm::mat4(1.0f)};
+    GpuAllocation uniformMemory = nullptr;
+    const vk::raii::Buffer uniforms = bench::createBuffer(
+        gpu, sizeof(matrices), vk::BufferUsageFlagBits::eUniformBuffer,
+        vk::MemoryPropertyFlagBits::eHostVisible |
+            vk::MemoryPropertyFlagBits::eHostCoherent,
+        GpuAllocator::Category::eUniform, uniformMemory);
+    std::memcpy(uniformMemory.mapped(), matrices, sizeof(matrices));
+    GpuAllocation instanceMemory = nullptr;
+    const vk::raii::Buffer instance = bench::createBuffer(
+        gpu, sizeof(glm::mat4), vk::BufferUsageFlagBits::eVertexBuffer,
+        vk::MemoryPropertyFlagBits::eHostVisible |
+            vk::MemoryPropertyFlagBits::eHostCoherent,
+        GpuAllocator::Category::eVertex, instanceMemory);
+    std::memcpy(instanceMemory.mapped(), &matrices[0], sizeof(glm::mat4));
+
+    // Descriptor set 0: the uniform buffer, as in the renderer
+    vk::DescriptorSetLayoutBinding uboBinding{};
+    uboBinding.binding = 0;
+    uboBinding.descriptorType = vk::DescriptorType::eUniformBuffer;
+    uboBinding.descriptorCount = 1;
+    uboBinding.stageFlags = vk::ShaderStageFlagBits::eVertex;
+    vk::DescriptorSetLayoutCreateInfo setLayoutInfo{};
+    setLayoutInfo.bindingCount = 1;
+    setLayoutInfo.pBindings = &uboBinding;
+    const vk::raii::DescriptorSetLayout setLayout(gpu.device, setLayoutInfo);
+    const vk::DescriptorPoolSize poolSize{vk::DescriptorType::eUniformBuffer,
+                                          1};
+    vk::DescriptorPoolCreateInfo poolInfo{};
+    poolInfo.flags = vk::DescriptorPoolCreateFlagBits::eFreeDescriptorSet;
+    poolInfo.maxSets = 1;
+    poolInfo.poolSizeCount = 1;
+    poolInfo.pPoolSizes = &poolSize;
+    const vk::raii::DescriptorPool descriptorPool(gpu.device, poolInfo);
+    vk::DescriptorSetAllocateInfo setInfo{};
+    setInfo.descriptorPool = *descriptorPool;
+    setInfo.descriptorSetCount = 1;
+    setInfo.pSetLayouts = &*setLayout;
+    const vk::raii::DescriptorSet descriptorSet =
+        std::move(vk::raii::DescriptorSets(gpu.device, setInfo).front());
+    const vk::DescriptorBufferInfo uboInfo{*uniforms, 0, sizeof(matrices)};
+    vk::WriteDescriptorSet write{};
+    write.dstSet = *descriptorSet;
+    write.dstBinding = 0;
+    write.descriptorCount = 1;
+    write.descriptorType = vk::DescriptorType::eUniformBuffer;
+    write.pBufferInfo = &uboInfo;
+    gpu.device.updateDescriptorSets(write, nullptr);
+
+    const vk::PushConstantRange pushRange{
+        vk::ShaderStageFlagBits::eVertex, vertexpull::kPushConstantOffset,
+        sizeof(vertexpull::PushConstants)};
+    vk::PipelineLayoutCreateInfo pipelineLayoutInfo{};
+    pipelineLayoutInfo.setLayoutCount = 1;
+    pipelineLayoutInfo.pSetLayouts = &*setLayout;
+    pipelineLayoutInfo.pushConstantRangeCount = 1;
+    pipelineLayoutInfo.pPushConstantRanges = &pushRange;
+    const vk::raii::PipelineLayout pipelineLayout(gpu.device,
+                                                  pipelineLayoutInfo);
+
+    // Vertex input: a pipeline per layout (and shader variant)
+    using Clock = std::chrono::steady_clock;
+    Result inputResult;
+    std::vector<vk::raii::Pipeline> inputPipelines;
+    {
+      const vk::raii::ShaderModule colorShader =
+          loadShader(gpu, "shaders/vert.spv");
+      const vk::raii::ShaderModule constantColorShader =
+          loadShader(gpu, "shaders/vert_constcolor.spv");
+      const auto start = Clock::now();
+      for (const vertexformat::Layout &layout : kLayouts) {
+        inputPipelines.push_back(createPipeline(
+            gpu, pipelineLayout,
+            vertexformat::hasColor(layout) ? colorShader : constantColorShader,
+            &layout));
+      }
+      inputResult.createMs =
+          std::chrono::duration<double, std::milli>(Clock::now() - start)
+              .count();
+      inputResult.pipelines = inputPipelines.size();
+    }
+
+    // Vertex pulling: one pipeline for every layout
+    Result pullResult;
+    vk::raii::Pipeline pullPipeline = nullptr;
+    std::vector<vertexpull::PushConstants> pullConstants;
+    {
+      const vk::raii::ShaderModule pullShader =
+          loadShader(gpu, "shaders/vert_pull.spv");
+      const auto start = Clock::now();
+      pullPipeline = createPipeline(gpu, pipelineLayout, pullShader, nullptr);
+      pullResult.createMs =
+          std::chrono::duration<double, std::milli>(Clock::now() - start)
+              .count();
+      pullResult.pipelines = 1;
+      for (const vertexformat::Layout layout : kLayouts) {
+        vertexpull::PushConstants constants;
+        constants.vertices = arena.vertexAddress();
+        constants.format = vertexpull::describe(layout);
+        pullConstants.push_back(constants);
+      }
+    }
+
+    // Draw orders: as submitted (layouts interleaved) and sorted by layout
+    std::vector<size_t> submitted(meshCount);
+    std::iota(submitted.begin(), submitted.end(), size_t{0});
+    std::vector<size_t> sorted = submitted;
+    std::stable_sort(sorted.begin(), sorted.end(), [&](size_t a, size_t b) {
+      return meshes[a].layout < meshes[b].layout;
+    });
+
+    // Records and runs 'iterations' frames drawing every mesh in 'order'
+    auto run = [&](Result result, const std::vector<size_t> &order,
+                   bool pulling) {
+      vk::RenderingInfo renderingInfo{};
+      renderingInfo.renderArea = vk::Rect2D{{0, 0}, {1, 1}};
+      renderingInfo.layerCount = 1;
+      double recordUs = 0;
+      double frameMs = 0;
+      for (int i = 0; i < iterations; i++) {
+        result.pipelineBinds = result.pushes = result.draws = 0;
+        const vk::raii::CommandBuffer &cmd = commandBuffer;
+        cmd.reset();
+        const auto start = Clock::now();
+        cmd.begin(vk::CommandBufferBeginInfo{
+            vk::CommandBufferUsageFlagBits::eOneTimeSubmit});
+        cmd.beginRendering(renderingInfo);
+        cmd.bindVertexBuffers(0, *arena.vertexBuffer(), kNoOffset);
+        cmd.bindVertexBuffers(1, *instance, kNoOffset);
+        cmd.bindIndexBuffer(*arena.indexBuffer(), 0, vk::IndexType::eUint32);
+        cmd.bindDescriptorSets(vk::PipelineBindPoint::eGraphics,
+                               *pipelineLayout, 0, *descriptorSet, nullptr);
+        if (pulling) {
+          cmd.bindPipeline(vk::PipelineBindPoint::eGraphics, *pullPipeline);
+          result.pipelineBinds++;
+        }
+        size_t previous = kLayoutCount;
+        for (size_t index : order) {
+          const Mesh &mesh = meshes[index];
+          if (mesh.layout != previous && pulling) {
+            cmd.pushConstants<vertexpull::PushConstants>(
+                *pipelineLayout, vk::ShaderStageFlagBits::eVertex,
+                vertexpull::kPushConstantOffset, pullConstants[mesh.layout]);
+            result.pushes++;
+          } else if (mesh.layout != previous) {
+            cmd.bindPipeline(vk::PipelineBindPoint::eGraphics,
+                             *inputPipelines[mesh.layout]);
+            result.pipelineBinds++;
+          }
+          previous = mesh.layout;
+          cmd.drawIndexed(mesh.geometry.indexCount(), 1,
+                          mesh.geometry.firstIndex(),
+                          mesh.geometry.vertexOffset(), 0);
+          result.draws++;
+        }
+        cmd.endRendering();
+        cmd.end();
+        const auto recorded = Clock::now();
+        bench::submitAndWait(gpu, commandBuffer);
+        recordUs +=
+            std::chrono::duration<double, std::micro>(recorded - start)
+                .count();
+        frameMs += std::chrono::duration<double, std::milli>(Clock::now() -
+                                                             recorded)
+                       .count();
+      }
+      result.recordUs = recordUs / iterations;
+      result.frameMs = frameMs / iterations;
+      return result;
+    };
+
+    std::cout << meshCount << " meshes in " << kLayoutCount
+              << " vertex layouts on "
+              << gpu.physicalGPU.getProperties().deviceName.data() << ", "
+              << iterations << " frames each\n"
+              << std::left << std::setw(24) << "" << std::right
+              << std::setw(10) << "pipelines" << std::setw(11) << "create ms"
+              << std::setw(7) << "binds" << std::setw(8) << "pushes"
+              << std::setw(7) << "draws" << std::setw(12) << "record us"
+              << std::setw(10) << "frame ms" << "\n";
+    printRow("vertex input", run(inputResult, submitted, false));
+    printRow("vertex input, sorted", run(inputResult, sorted, false));
+    printRow("vertex pulling", run(pullResult, submitted, true));
+  } catch (const std::exception &e) {
+    std::cerr << "bench_vertexpull: " << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,147 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "MappedFile.hpp"
+
+/**
+ * @file AssetPack.hpp
+ * @brief Single memory-mapped pack file holding every runtime asset.
+ *
+ * The **assetpack** namespace bundles the baked assets the renderer needs
+ * (mesh cache, baked texture, SPIR-V modules) into one file that is mapped
+ * once at startup. Each blob is page aligned, so it can be copied straight
+ * from the mapping into a staging buffer, or imported as host memory with
+ * VK_EXT_external_memory_host and copied by the GPU without any CPU copy.
+ *
+ * File layout (offsets relative to the start of the file):
+ * @code
+ * [Header][Entry x entryCount][pad to 4096][blob 0][pad to 4096][blob 1]...
+ * [pad to 4096]
+ * @endcode
+ *
+ * Blobs keep their own formats (meshcache, artx, SPIR-V) and their own
+ * staleness checks; the pack only locates them by name, which is the path
+ * the asset would otherwise be loaded from (e.g. "shaders/frag.spv").
+ *
+ * @see MappedFile
+ */
+namespace assetpack {
+
+/** @brief Magic bytes identifying an asset pack. */
+constexpr char kMagic[4] = {'A', 'R', 'P', 'K'};
+
+/** @brief Current pack format version; bump on any layout change. */
+constexpr uint32_t kVersion = 1;
+
+/**
+ * @brief Alignment (bytes) of every blob and of the file size. One page,
+ * which satisfies minImportedHostPointerAlignment on common drivers.
+ */
+constexpr uint64_t kBlobAlignment = 4096;
+
+/** @brief Longest entry name, including the terminating zero. */
+constexpr size_t kMaxNameLength = 56;
+
+/** @brief What a blob contains (informational; detected from its bytes). */
+enum class BlobType : uint32_t { eRaw, eMeshCache, eTexture, eShader };
+
+/**
+ * @struct Header
+ * @brief Fixed-size header at the start of every pack.
+ */
+struct Header {
+  char magic[4];       ///< Always kMagic
+  uint32_t version;    ///< Format version (kVersion)
+  uint64_t entryCount; ///< Number of Entry records after the header
+};
+
+/**
+ * @struct Entry
+ * @brief Table-of-contents record of one blob.
+ */
+struct Entry {
+  char name[kMaxNameLength]; ///< Zero-terminated lookup name
+  BlobType type;             ///< Content type
+  uint32_t reserved;         ///< Zero
+  uint64_t offset;           ///< Byte offset of the blob (kBlobAlignment)
+  uint64_t size;             ///< Byte size of the blob
+};
+
+/** @brief Human-readable name of a blob type. */
+const char *name(BlobType type);
+
+/**
+ * @brief Detects a blob's type from its leading bytes.
+ *
+ * @param bytes Blob contents.
+ * @return eMeshCache/eTexture by magic, eShader for SPIR-V, else eRaw.
+ */
+BlobType detectType(std::span<const std::byte> bytes);
+
+/**
+ * @class AssetPack
+ * @brief A validated, memory-mapped asset pack.
+ *
+ * Spans returned by blob() point into the mapping and stay valid for the
+ * lifetime of the AssetPack (including after moves).
+ */
+class AssetPack {
+public:
+  /**
+   * @brief Maps and validates a pack.
+   *
+   * @param path Pack file.
+   * @return The pack, or std::nullopt if it is missing or malformed.
+   */
+  static std::optional<AssetPack> open(const std::string &path);
+
+  /** @brief Table of contents. */
+  std::span<const Entry> entries() const;
+
+  /**
+   * @brief Looks up a blob by name.
+   *
+   * @param name Entry name (asset path).
+   * @return Blob bytes, or an empty span if the pack has no such entry.
+   */
+  std::span<const std::byte> blob(std::string_view name) const;
+
+  /** @brief The whole mapping, for page-rounding blobs before import. */
+  std::span<const std::byte> bytes() const { return file.bytes(); }
+
+private:
+  explicit AssetPack(MappedFile &&mappedFile) : file(std::move(mappedFile)) {}
+
+  /** @brief Mapping that backs all returned spans. */
+  MappedFile file;
+};
+
+/**
+ * @struct Input
+ * @brief One file to store in a pack.
+ */
+struct Input {
+  std::string name; ///< Lookup name (usually the file's asset path)
+  std::string path; ///< File to read
+};
+
+/**
+ * @brief Writes a pack from a list of files.
+ *
+ * Each input is mapped and written to a temporary path, which is renamed
+ * into place once complete.
+ *
+ * @param path Destination pack file.
+ * @param inputs Files to store, in order.
+ * @throws std::runtime_error If an input is missing, a name is too long or
+ * duplicated, or the pack cannot be written.
+ */
+void write(const std::string &path, std::span<const Input> inputs);
+
+} // namespace assetpack
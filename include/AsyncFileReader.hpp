@@ -0,0 +1,271 @@
+#pragma once
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <sys/uio.h>
+#include <unordered_map>
+#include <vector>
+
+#include "ThreadPool.hpp"
+
+/**
+ * @file AsyncFileReader.hpp
+ * @brief Asynchronous whole-file reads with many block reads in flight.
+ *
+ * The **AsyncFileReader** splits every submitted file into fixed-size block
+ * reads and keeps up to Options::queueDepth of them in flight, so large
+ * assets stream at device bandwidth instead of one blocking read at a time.
+ * Reads land in page-aligned buffers and files are opened with O_DIRECT
+ * (F_NOCACHE on macOS) where the file system allows it, bypassing the page
+ * cache copy.
+ *
+ * Backends:
+ * - **io_uring** (Linux): block reads are queued on a submission ring and
+ *   reaped from the completion ring, one syscall per batch.
+ * - **ThreadPool**: each block read is a blocking pread on a small reader
+ *   pool. Used on other platforms and when io_uring is unavailable (old
+ *   kernels, seccomp-restricted containers).
+ *
+ * All methods are thread-safe, so several loaders may share one reader.
+ *
+ * @code
+ * AsyncFileReader reader;
+ * auto obj = reader.submit("models/statue.obj");
+ * auto png = reader.submit("textures/statue.png");
+ * AsyncFileReader::Result text = reader.wait(obj); // png keeps loading
+ * parse(text.bytes());
+ * @endcode
+ */
+
+/**
+ * @class AlignedBuffer
+ * @brief Owned, move-only byte buffer aligned to AsyncFileReader::kAlignment.
+ *
+ * Buffers of 2 MiB or more are aligned to 2 MiB and, on Linux, marked for
+ * transparent huge pages, which cuts the page faults taken while the kernel
+ * fills them to a few per file.
+ */
+class AlignedBuffer {
+public:
+  /** @brief Creates an empty buffer. */
+  AlignedBuffer() = default;
+
+  /**
+   * @brief Allocates an uninitialized buffer.
+   *
+   * @param size Size in bytes.
+   */
+  explicit AlignedBuffer(size_t size);
+
+  /** @brief First byte (nullptr if empty). */
+  std::byte *data() { return storage.get(); }
+
+  /** @brief First byte (nullptr if empty). */
+  const std::byte *data() const { return storage.get(); }
+
+  /** @brief Size in bytes. */
+  size_t size() const { return capacity; }
+
+private:
+  /** @brief Releases memory from the aligned operator new. */
+  struct Deleter {
+    size_t alignment; ///< Alignment the memory was allocated with
+    void operator()(std::byte *bytes) const;
+  };
+
+  /** @brief Aligned allocation. */
+  std::unique_ptr<std::byte[], Deleter> storage;
+
+  /** @brief Size of 'storage' in bytes. */
+  size_t capacity = 0;
+};
+
+/**
+ * @class AsyncFileReader
+ * @brief Request/completion API for whole-file reads.
+ */
+class AsyncFileReader {
+public:
+  /** @brief Alignment of buffers, offsets and lengths (O_DIRECT). */
+  static constexpr size_t kAlignment = 4096;
+
+  /** @brief Handle of a submitted read. */
+  using RequestId = uint64_t;
+
+  /** @brief Implementation performing the reads. */
+  enum class Backend { eIoUring, eThreadPool };
+
+  /**
+   * @struct Options
+   * @brief Reader configuration.
+   */
+  struct Options {
+    uint32_t queueDepth = 64;      ///< Block reads in flight at once
+    uint32_t blockSize = 1u << 20; ///< Bytes per read (kAlignment multiple)
+    bool direct = true;            ///< Bypass the page cache when allowed
+    bool forceThreadPool = false;  ///< Skip io_uring even if available
+    size_t threadPoolThreads = 4;  ///< Reader threads of the fallback
+  };
+
+  /**
+   * @struct Result
+   * @brief Contents of one completed read.
+   */
+  struct Result {
+    RequestId id = 0;     ///< Request the data belongs to
+    std::string path;     ///< File that was read
+    AlignedBuffer buffer; ///< Data, size rounded up to kAlignment
+    size_t size = 0;      ///< File size (valid bytes in 'buffer')
+
+    /** @brief The file's bytes. */
+    std::span<const std::byte> bytes() const { return {buffer.data(), size}; }
+  };
+
+  /**
+   * @brief Creates a reader, preferring io_uring.
+   *
+   * @param options Queue depth, block size and backend selection.
+   */
+  explicit AsyncFileReader(const Options &options);
+
+  /** @brief Creates a reader with default Options. */
+  AsyncFileReader() : AsyncFileReader(Options{}) {}
+
+  /** @brief Waits for reads in flight, then releases the backend. */
+  ~AsyncFileReader();
+
+  AsyncFileReader(const AsyncFileReader &) = delete;
+  AsyncFileReader &operator=(const AsyncFileReader &) = delete;
+
+  /** @brief Backend in use. */
+  Backend backend() const {
+    return ring ? Backend::eIoUring : Backend::eThreadPool;
+  }
+
+  /** @brief Human-readable backend name (with O_DIRECT state). */
+  std::string backendName() const;
+
+  /**
+   * @brief Opens a file and queues reads of its entire contents.
+   *
+   * @param path File to read.
+   * @return Handle to pass to wait().
+   * @throws std::runtime_error If the file cannot be opened or stat'ed.
+   */
+  RequestId submit(const std::string &path);
+
+  /**
+   * @brief Blocks until a request has completed and takes its data.
+   *
+   * @param id Handle from submit(); each handle can be waited on once.
+   * @return The file contents.
+   * @throws std::runtime_error If the handle is unknown or a read failed.
+   */
+  Result wait(RequestId id);
+
+  /**
+   * @brief Blocks until any request completes and takes its data.
+   *
+   * Requests already taken with wait() are skipped. Requests finish in
+   * completion order, not submission order.
+   *
+   * @return The first completed request not yet taken.
+   * @throws std::runtime_error If nothing is pending or a read failed.
+   */
+  Result waitAny();
+
+  /** @brief Requests submitted but not yet taken. */
+  size_t pending() const;
+
+private:
+  struct Ring;
+
+  /**
+   * @struct Block
+   * @brief One read of up to Options::blockSize bytes.
+   */
+  struct Block {
+    RequestId id = 0;         ///< Owning request
+    int fd = -1;              ///< File descriptor of the request
+    uint64_t offset = 0;      ///< File offset still to read
+    std::byte *dst = nullptr; ///< Destination still to fill
+    size_t length = 0;        ///< Bytes still to read
+    iovec iov{};              ///< Read target while queued on the ring
+  };
+
+  /**
+   * @struct Request
+   * @brief Bookkeeping of one submitted file.
+   */
+  struct Request {
+    std::string path;          ///< File being read
+    int fd = -1;               ///< Open descriptor (closed when done)
+    AlignedBuffer buffer;      ///< Destination of every block
+    size_t size = 0;           ///< File size
+    std::vector<Block> blocks; ///< Stable storage for in-flight blocks
+    size_t remaining = 0;      ///< Blocks not yet completed
+    int error = 0;             ///< First errno reported by a block
+  };
+
+  /** @brief Queues every pending block the backend has room for. */
+  void submitBlocksLocked();
+
+  /**
+   * @brief Applies one block result: retries short reads, records errors
+   * and finishes the request once its last block is done.
+   *
+   * @param block Block the result belongs to.
+   * @param result Bytes read, or -errno.
+   */
+  void completeBlockLocked(Block &block, int64_t result);
+
+  /** @brief Moves a finished request's data out and forgets the request. */
+  Result takeLocked(RequestId id);
+
+  /**
+   * @brief Makes progress on the io_uring backend: reaps completions, or
+   * waits in the kernel for one if no other thread is already doing so.
+   */
+  void driveRing(std::unique_lock<std::mutex> &lock);
+
+  /** @brief Reader configuration. */
+  Options options;
+
+  /** @brief io_uring instance (nullptr = ThreadPool backend). */
+  std::unique_ptr<Ring> ring;
+
+  /** @brief Guards every member below. */
+  mutable std::mutex mutex;
+
+  /** @brief Signalled whenever a request completes. */
+  std::condition_variable completed;
+
+  /** @brief Submitted requests that have not been taken yet. */
+  std::unordered_map<RequestId, Request> requests;
+
+  /** @brief Finished requests in completion order (for waitAny()). */
+  std::deque<RequestId> finished;
+
+  /** @brief Blocks waiting for a free queue slot (io_uring only). */
+  std::deque<Block *> queuedBlocks;
+
+  /** @brief Blocks submitted to the ring and not yet reaped. */
+  uint32_t inFlight = 0;
+
+  /** @brief A thread is waiting in the kernel for io_uring completions. */
+  bool reaping = false;
+
+  /** @brief Next RequestId to hand out. */
+  RequestId nextId = 1;
+
+  /**
+   * @brief Reader threads of the fallback. Declared last so its tasks
+   * finish before the members they touch are destroyed.
+   */
+  std::unique_ptr<ThreadPool> pool;
+};
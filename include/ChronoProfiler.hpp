@@ -63,6 +63,19 @@ public:
         std::string category;  ///< Optional grouping/category for zones
     };
 
+    /**
+     * @struct Counter
+     * @brief A named numeric value sampled by the application (e.g. GPU stats).
+     *
+     * Counters are gauges: setCounter() overwrites the previous value, and the
+     * latest value is reported until it is set again.
+     */
+    struct Counter {
+        std::string_view name;                 ///< Counter name (caller-owned string literal preferred)
+        double value;                          ///< Latest value
+        std::string_view category = "counter"; ///< Grouping in the JSON export (caller-owned)
+    };
+
     /**
      * @brief Starts a new profiling frame.
      *
@@ -115,6 +128,26 @@ public:
      */
     static std::string getThreadName(uint32_t threadId);
 
+    /**
+     * @brief Sets (or creates) a named counter.
+     *
+     * Thread-safe. Typically called once per frame with values read back from
+     * the GPU, e.g. the number of triangles rejected by cluster culling.
+     *
+     * @param name Counter name
+     * @param value New value
+     * @param category Grouping written to the JSON export
+     */
+    static void setCounter(std::string_view name, double value,
+                           std::string_view category = "counter");
+
+    /**
+     * @brief Returns a snapshot of all counters in creation order.
+     *
+     * @return Copy of the counter list
+     */
+    static std::vector<Counter> getCounters();
+
     /**
      * @brief Assigns a human-readable name to the calling thread.
      *
@@ -199,6 +232,12 @@ private:
     /** @brief Mutex protecting merging of thread-local events into frameEvents. */
     static std::mutex mergeMutex;
 
+    /** @brief Latest value of every counter. */
+    static std::vector<Counter> counters;
+
+    /** @brief Mutex protecting the counters list. */
+    static std::mutex countersMutex;
+
     /** @brief Frame start timestamp. */
     static std::chrono::high_resolution_clock::time_point frameStart;
 
@@ -223,6 +262,29 @@ private:
  */
 #define PROFILE_SCOPE(name) ChronoProfiler::ScopedZone _scope_##__LINE__(name)
 
+/**
+ * @def PROFILE_COUNTER(name, value)
+ * @brief Records the latest value of a named counter.
+ *
+ * Usage:
+ * @code
+ * PROFILE_COUNTER("Culled triangles", counters.culledTriangles);
+ * @endcode
+ */
+#define PROFILE_COUNTER(name, value) ChronoProfiler::setCounter(name, static_cast<double>(value))
+
+/**
+ * @def PROFILE_COUNTER_CATEGORY(name, value, category)
+ * @brief Records a counter under its own category in the JSON export.
+ *
+ * Usage:
+ * @code
+ * PROFILE_COUNTER_CATEGORY("GPU heap 0 budget bytes", heap.budget, "memory");
+ * @endcode
+ */
+#define PROFILE_COUNTER_CATEGORY(name, value, category) \
+    ChronoProfiler::setCounter(name, static_cast<double>(value), category)
+
 // ---------------- END REAL PROFILER IMPLEMENTATION ---------------- //
 
 #else
@@ -278,6 +340,16 @@ public:
         double durationMs = 0.0;
     };
 
+    /**
+     * @struct Counter
+     * @brief Dummy counter placeholder so return types remain valid.
+     */
+    struct Counter {
+        std::string_view name;
+        double value = 0.0;
+        std::string_view category = "counter";
+    };
+
     /**
      * @brief Begin a new profiling frame.
      *
@@ -336,6 +408,23 @@ public:
      */
     static void setThreadName(const std::string& /*name*/) {}
 
+    /**
+     * @brief Set a named counter (ignored).
+     *
+     * @param name Counter name (ignored)
+     * @param value Counter value (ignored)
+     * @param category Counter category (ignored)
+     */
+    static void setCounter(std::string_view /*name*/, double /*value*/,
+                           std::string_view /*category*/ = "counter") {}
+
+    /**
+     * @brief Return the counter list (always empty).
+     *
+     * @return std::vector<Counter> Empty vector
+     */
+    static std::vector<Counter> getCounters() { return {}; }
+
     /**
      * @brief Export profiling data to JSON (ignored).
      *
@@ -389,5 +478,17 @@ public:
  */
 #define PROFILE_SCOPE(name)
 
+/**
+ * @def PROFILE_COUNTER(name, value)
+ * @brief Macro expands to nothing when profiler is disabled.
+ */
+#define PROFILE_COUNTER(name, value)
+
+/**
+ * @def PROFILE_COUNTER_CATEGORY(name, value, category)
+ * @brief Macro expands to nothing when profiler is disabled.
+ */
+#define PROFILE_COUNTER_CATEGORY(name, value, category)
+
 // end of file
 #endif
@@ -0,0 +1,115 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+/**
+ * @file DrawBatch.hpp
+ * @brief 64-bit draw sort keys that order draws by GPU state.
+ *
+ * The **drawbatch** namespace packs the state a draw needs into one integer,
+ * most expensive state change in the highest bits:
+ * @code
+ * 63        56 55                32 31          16 15          0
+ * [ pipeline ][     descriptor     ][   material   ][   order    ]
+ * @endcode
+ * Sorting a draw list by key groups draws that share a pipeline, then a
+ * descriptor set, then a material, so recording the sorted list binds each
+ * state once per run instead of once per draw. 'order' breaks ties (e.g. a
+ * depth bucket) without affecting the grouping.
+ *
+ * It holds no Vulkan state; the renderer maps its pipelines, descriptor
+ * sets and materials to small integer ids.
+ *
+ * @code
+ * items.push_back({drawbatch::makeKey(0, textureSlot, material), submesh});
+ * drawbatch::sort(items);
+ * drawbatch::StateChanges changes = drawbatch::countStateChanges(items);
+ * @endcode
+ */
+namespace drawbatch {
+
+/** @brief Bits of the pipeline id (key bits 56..63). */
+constexpr uint32_t kPipelineBits = 8;
+
+/** @brief Bits of the descriptor set id (key bits 32..55). */
+constexpr uint32_t kDescriptorBits = 24;
+
+/** @brief Bits of the material id (key bits 16..31). */
+constexpr uint32_t kMaterialBits = 16;
+
+/** @brief Bits of the tie-breaking order (key bits 0..15). */
+constexpr uint32_t kOrderBits = 16;
+
+/** @brief Lists shorter than this are sorted with std::stable_sort. */
+constexpr size_t kRadixThreshold = 256;
+
+/**
+ * @struct DrawItem
+ * @brief One draw of a list: its sort key and the caller's draw index.
+ */
+struct DrawItem {
+  uint64_t key = 0;  ///< makeKey() of the draw's state
+  uint32_t draw = 0; ///< What to draw (e.g. a submesh index)
+};
+
+/**
+ * @struct StateChanges
+ * @brief Commands needed to record a draw list in its current order.
+ */
+struct StateChanges {
+  uint32_t pipelineBinds = 0;   ///< vkCmdBindPipeline
+  uint32_t descriptorBinds = 0; ///< vkCmdBindDescriptorSets
+  uint32_t materialBinds = 0;   ///< Material constant updates
+  uint32_t drawCalls = 0;       ///< Draw commands
+};
+
+/**
+ * @brief Builds a sort key; each id is truncated to its field width.
+ *
+ * @param pipeline Pipeline id.
+ * @param descriptor Descriptor set id.
+ * @param material Material id.
+ * @param order Tie breaker within equal state.
+ */
+constexpr uint64_t makeKey(uint32_t pipeline, uint32_t descriptor,
+                           uint32_t material, uint32_t order = 0) {
+  constexpr auto mask = [](uint32_t bits) { return (1ull << bits) - 1; };
+  return (pipeline & mask(kPipelineBits)) << 56 |
+         (descriptor & mask(kDescriptorBits)) << 32 |
+         (material & mask(kMaterialBits)) << 16 | (order & mask(kOrderBits));
+}
+
+/** @brief Pipeline id of a key. */
+constexpr uint32_t pipelineOf(uint64_t key) {
+  return static_cast<uint32_t>(key >> 56);
+}
+
+/** @brief Descriptor set id of a key. */
+constexpr uint32_t descriptorOf(uint64_t key) {
+  return static_cast<uint32_t>(key >> 32) & ((1u << kDescriptorBits) - 1);
+}
+
+/** @brief Material id of a key. */
+constexpr uint32_t materialOf(uint64_t key) {
+  return static_cast<uint32_t>(key >> 16) & ((1u << kMaterialBits) - 1);
+}
+
+/**
+ * @brief Sorts draws by key; equal keys keep their input order.
+ *
+ * @param items Draw list, sorted in place.
+ */
+void sort(std::span<DrawItem> items);
+
+/**
+ * @brief Counts the binds needed to record 'items' in order, binding a
+ * state only when it differs from the previous draw's (a new pipeline also
+ * rebinds the descriptor set and material, which it may invalidate).
+ *
+ * @param items Draw list.
+ * @return Binds and draw calls.
+ */
+StateChanges countStateChanges(std::span<const DrawItem> items);
+
+} // namespace drawbatch
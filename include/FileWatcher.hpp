@@ -0,0 +1,127 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @file FileWatcher.hpp
+ * @brief Change notifications for a set of asset files.
+ *
+ * The **FileWatcher** reports files that were rewritten since the last
+ * poll(). It never blocks, so the renderer polls it once per frame.
+ *
+ * Backends:
+ * - **inotify** (Linux): the *directory* of every watched file is watched
+ *   for IN_CLOSE_WRITE and IN_MOVED_TO, which catches both in-place writes
+ *   and the write-to-temp-then-rename pattern of editors and build tools.
+ * - **Polling**: size and mtime of every watched file are compared every
+ *   Options::pollInterval. Used on other platforms and when inotify is
+ *   unavailable (e.g. the per-user watch limit is exhausted).
+ *
+ * A change is reported once no further event for the file arrived for
+ * Options::settle, so a file is not picked up half written by a tool that
+ * writes it in several steps.
+ *
+ * @code
+ * FileWatcher watcher;
+ * watcher.watch("shaders/frag.spv");
+ * for (const std::string &path : watcher.poll()) { // every frame
+ *   reload(path);
+ * }
+ * @endcode
+ */
+class FileWatcher {
+public:
+  /** @brief Implementation detecting the changes. */
+  enum class Backend { eInotify, ePolling };
+
+  /**
+   * @struct Options
+   * @brief Watcher configuration.
+   */
+  struct Options {
+    std::chrono::milliseconds settle{100};       ///< Quiet time per change
+    std::chrono::milliseconds pollInterval{250}; ///< Polling backend period
+    bool forcePolling = false;                   ///< Skip inotify
+  };
+
+  /**
+   * @brief Creates a watcher, preferring inotify.
+   *
+   * @param options Settle time and backend selection.
+   */
+  explicit FileWatcher(const Options &options);
+
+  /** @brief Creates a watcher with default Options. */
+  FileWatcher() : FileWatcher(Options{}) {}
+
+  /** @brief Closes the inotify descriptor. */
+  ~FileWatcher();
+
+  FileWatcher(const FileWatcher &) = delete;
+  FileWatcher &operator=(const FileWatcher &) = delete;
+
+  /** @brief Backend in use. */
+  Backend backend() const {
+    return fd >= 0 ? Backend::eInotify : Backend::ePolling;
+  }
+
+  /** @brief Human-readable backend name. */
+  const char *backendName() const;
+
+  /**
+   * @brief Starts watching a file. The file does not have to exist yet;
+   * watching a path twice has no effect.
+   *
+   * @param path File to watch (its directory must exist for inotify).
+   */
+  void watch(const std::string &path);
+
+  /**
+   * @brief Collects changes without blocking.
+   *
+   * @return Watched paths (as passed to watch()) that changed and have been
+   * quiet for Options::settle, each reported once per change.
+   */
+  std::vector<std::string> poll();
+
+private:
+  using Clock = std::chrono::steady_clock;
+
+  /**
+   * @struct File
+   * @brief State of one watched file.
+   */
+  struct File {
+    std::string path;            ///< Path as passed to watch()
+    std::string directory;       ///< Normalized parent directory
+    std::string name;            ///< File name within 'directory'
+    int64_t mtime = 0;           ///< Last seen mtime (polling backend)
+    uint64_t size = 0;           ///< Last seen size (polling backend)
+    bool changed = false;        ///< Change seen but not reported yet
+    Clock::time_point lastEvent; ///< Time of the latest change
+  };
+
+  /** @brief Drains the inotify queue into 'files'. */
+  void readEvents();
+
+  /** @brief Stats every file and flags size/mtime changes. */
+  void scanFiles();
+
+  /** @brief Watcher configuration. */
+  Options options;
+
+  /** @brief inotify descriptor (-1 = polling backend). */
+  int fd = -1;
+
+  /** @brief inotify watch descriptor -> watched directory. */
+  std::unordered_map<int, std::string> directories;
+
+  /** @brief Every watched file. */
+  std::vector<File> files;
+
+  /** @brief Time of the last polling scan. */
+  Clock::time_point lastScan;
+};
@@ -0,0 +1,124 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <type_traits>
+
+/**
+ * @file FrameRing.hpp
+ * @brief Bump allocator over a persistently mapped buffer, partitioned per
+ *        frame in flight.
+ *
+ * The **FrameRing** hands out aligned sub-ranges of one host-visible buffer
+ * for data rewritten every frame (uniforms, instance matrices, per-draw
+ * parameters). The buffer is split into one partition per frame in flight;
+ * begin() rewinds a frame's partition once its fence has signaled, and
+ * allocate() bumps an offset within it. Shaders reach the data through a
+ * dynamic uniform buffer descriptor (the returned offset is the dynamic
+ * offset) or a vertex buffer binding offset, so writing any amount of
+ * per-frame data needs no allocation and no descriptor update.
+ *
+ * Like TlsfAllocator it manages offsets only; the renderer owns the buffer.
+ *
+ * @code
+ * FrameRing ring(memory.mapped(), bufferSize, MAX_FRAMES_IN_FLIGHT,
+ *                limits.minUniformBufferOffsetAlignment);
+ *
+ * // Every frame, after its fence wait
+ * ring.begin(currentFrame);
+ * const uint64_t offset = ring.push(ubo);
+ * commandBuffer.bindDescriptorSets(..., set, static_cast<uint32_t>(offset));
+ * @endcode
+ */
+class FrameRing {
+public:
+  /**
+   * @struct Allocation
+   * @brief A sub-range of the current frame's partition.
+   */
+  struct Allocation {
+    uint64_t offset = 0;  ///< Offset in the buffer (aligned)
+    void *data = nullptr; ///< Mapped pointer to the range
+  };
+
+  /**
+   * @brief Partitions a mapped buffer.
+   *
+   * @param mapped Mapped start of the buffer (host coherent).
+   * @param capacity Size of the buffer.
+   * @param frameCount Frames in flight (one partition each).
+   * @param alignment Power of two every range starts at, e.g.
+   * minUniformBufferOffsetAlignment.
+   * @throws std::runtime_error on a null pointer, a non power-of-two
+   * alignment or partitions smaller than 'alignment'.
+   */
+  FrameRing(void *mapped, uint64_t capacity, uint32_t frameCount,
+            uint64_t alignment);
+
+  /**
+   * @brief Rewinds a frame's partition; everything allocated in it during
+   * its previous use must no longer be read by the GPU.
+   */
+  void begin(uint32_t frame);
+
+  /**
+   * @brief Allocates 'size' bytes in the current frame's partition.
+   *
+   * @throws std::runtime_error when the partition is full.
+   */
+  Allocation allocate(uint64_t size);
+
+  /** @brief Copies 'value' into a new range and returns its offset. */
+  template <typename T> uint64_t push(const T &value) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    const Allocation range = allocate(sizeof(T));
+    std::memcpy(range.data, &value, sizeof(T));
+    return range.offset;
+  }
+
+  /** @brief Typed view of a new range of 'count' elements. */
+  template <typename T> std::span<T> allocateArray(size_t count) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    return {static_cast<T *>(allocate(sizeof(T) * count).data), count};
+  }
+
+  /** @brief Buffer offset of a pointer returned by this ring. */
+  uint64_t offsetOf(const void *data) const {
+    return static_cast<uint64_t>(static_cast<const std::byte *>(data) - base);
+  }
+
+  /** @brief Size of each frame's partition. */
+  uint64_t partitionSize() const { return partition; }
+
+  /** @brief Bytes allocated in the current partition (with padding). */
+  uint64_t used() const { return top - partition * frame; }
+
+  /** @brief Largest used() seen at any begin(). */
+  uint64_t peakUsed() const { return peak; }
+
+  /** @brief Alignment of every range. */
+  uint64_t alignment() const { return align; }
+
+private:
+  /** @brief Mapped start of the buffer. */
+  std::byte *base = nullptr;
+
+  /** @brief Bytes per frame, a multiple of 'align'. */
+  uint64_t partition = 0;
+
+  /** @brief Number of partitions. */
+  uint32_t frames = 0;
+
+  /** @brief Range alignment. */
+  uint64_t align = 1;
+
+  /** @brief Current partition. */
+  uint32_t frame = 0;
+
+  /** @brief Next free offset in the buffer. */
+  uint64_t top = 0;
+
+  /** @brief Largest partition use so far. */
+  uint64_t peak = 0;
+};
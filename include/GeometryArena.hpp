@@ -0,0 +1,202 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vulkan/vulkan_raii.hpp>
+
+#include "GpuAllocator.hpp"
+#include "TlsfAllocator.hpp"
+
+/**
+ * @file GeometryArena.hpp
+ * @brief One device-local vertex buffer and one index buffer shared by every
+ *        mesh.
+ *
+ * A vertex and index buffer per mesh means a vertex and index buffer bind
+ * before every draw of another mesh, and draws of different meshes can
+ * never be merged into one indirect draw. The **GeometryArena** owns a
+ * single large vertex buffer and a single 32-bit index buffer and
+ * sub-allocates each mesh's vertices and indices from them. A mesh is then
+ * identified by the values a draw takes:
+ * - firstIndex: where its indices start in the index buffer;
+ * - vertexOffset: added to each index, in vertices of the mesh's stride;
+ * - indexCount.
+ *
+ * These are exactly the fields of a VkDrawIndexedIndirectCommand, so any
+ * set of meshes can be drawn with one bind and one multi-draw-indirect call.
+ *
+ * Both ranges are managed by a TlsfAllocator (vertex bytes and index
+ * counts), so the space of unloaded meshes is reused by later ones and
+ * freed neighbours merge. Meshes of different vertex strides can share the
+ * arena: a vertex range starts at a multiple of its own stride.
+ *
+ * @code
+ * GeometryArena::Mesh mesh = arena.allocate(vertexCount, stride, indexCount);
+ * uploadQueue.copy(staging, *arena.vertexBuffer(), mesh.vertexBytes(),
+ *                  vk::PipelineStageFlagBits2::eVertexAttributeInput,
+ *                  vk::AccessFlagBits2::eVertexAttributeRead);
+ * ...
+ * commandBuffer.bindVertexBuffers(0, *arena.vertexBuffer(), {0});
+ * commandBuffer.bindIndexBuffer(*arena.indexBuffer(), 0,
+ *                               vk::IndexType::eUint32);
+ * commandBuffer.drawIndexed(mesh.indexCount(), 1, mesh.firstIndex(),
+ *                           mesh.vertexOffset(), 0);
+ * @endcode
+ *
+ * A Mesh frees its ranges when destroyed, so one still drawn by a frame in
+ * flight is handed to the RetireQueue like any other GPU object. The arena
+ * is thread safe and must outlive its meshes.
+ */
+class GeometryArena {
+public:
+  /** @brief Default vertex buffer size. */
+  static constexpr vk::DeviceSize kVertexBytes = 32ull << 20;
+
+  /** @brief Default index buffer size, in 32-bit indices. */
+  static constexpr uint32_t kIndexCount = 8u << 20;
+
+  /**
+   * @class Mesh
+   * @brief Vertex and index ranges of one mesh; freed on destruction.
+   */
+  class Mesh {
+  public:
+    Mesh() = default;
+
+    /** @brief Empty mesh, for '= nullptr' like the vk::raii types. */
+    Mesh(std::nullptr_t) {}
+
+    Mesh(Mesh &&other) noexcept;
+    Mesh &operator=(Mesh &&other) noexcept;
+    Mesh(const Mesh &) = delete;
+    Mesh &operator=(const Mesh &) = delete;
+
+    ~Mesh() { reset(); }
+
+    /** @brief First index in the arena's index buffer. */
+    uint32_t firstIndex() const {
+      return static_cast<uint32_t>(indices.offset);
+    }
+
+    /** @brief Value added to each index (vertices of 'stride' bytes). */
+    int32_t vertexOffset() const { return baseVertex; }
+
+    /** @brief Number of indices. */
+    uint32_t indexCount() const { return indexTotal; }
+
+    /** @brief Byte offset of the first vertex in the vertex buffer. */
+    vk::DeviceSize vertexBytes() const {
+      return static_cast<vk::DeviceSize>(baseVertex) * vertexStride;
+    }
+
+    /** @brief Byte offset of the first index in the index buffer. */
+    vk::DeviceSize indexBytes() const {
+      return indices.offset * sizeof(uint32_t);
+    }
+
+    /** @brief True when the mesh owns ranges. */
+    explicit operator bool() const { return arena != nullptr; }
+
+    /** @brief Frees the ranges; the mesh becomes empty. */
+    void reset();
+
+  private:
+    friend class GeometryArena;
+
+    GeometryArena *arena = nullptr;       ///< Arena to free into
+    TlsfAllocator::Allocation vertices{}; ///< Vertex range (bytes)
+    TlsfAllocator::Allocation indices{};  ///< Index range (indices)
+    int32_t baseVertex = 0;               ///< vertexOffset of draws
+    uint32_t vertexStride = 0;            ///< Bytes per vertex
+    uint32_t indexTotal = 0;              ///< Number of indices
+  };
+
+  /**
+   * @struct Stats
+   * @brief Snapshot of the arena's use.
+   */
+  struct Stats {
+    size_t meshCount = 0;           ///< Live meshes
+    vk::DeviceSize vertexBytes = 0; ///< Vertex buffer size
+    vk::DeviceSize vertexUsed = 0;  ///< Allocated vertex bytes
+    uint64_t indexCount = 0;        ///< Index buffer size (indices)
+    uint64_t indexUsed = 0;         ///< Allocated indices
+    size_t vertexFreeBlocks = 0;    ///< Free ranges of the vertex buffer
+    size_t indexFreeBlocks = 0;     ///< Free ranges of the index buffer
+  };
+
+  /**
+   * @brief Creates the two device-local buffers.
+   *
+   * @param logicalDevice Device the buffers are created on.
+   * @param gpuAllocator Allocator of their memory.
+   * @param vertexBytes Vertex buffer size.
+   * @param indexCount Index buffer size, in 32-bit indices.
+   * @param deviceAddress Also let shaders read the vertex buffer through
+   * vertexAddress() (vertex pulling); 'gpuAllocator' must allocate device
+   * address memory.
+   */
+  GeometryArena(const vk::raii::Device &logicalDevice,
+                GpuAllocator &gpuAllocator,
+                vk::DeviceSize vertexBytes = kVertexBytes,
+                uint32_t indexCount = kIndexCount, bool deviceAddress = false);
+
+  ~GeometryArena();
+
+  GeometryArena(const GeometryArena &) = delete;
+  GeometryArena &operator=(const GeometryArena &) = delete;
+
+  /**
+   * @brief Reserves room for a mesh; its data is copied in by the caller.
+   *
+   * @param vertexCount Number of vertices.
+   * @param stride Bytes per vertex.
+   * @param indexCount Number of 32-bit indices.
+   * @return The mesh, or an empty one when either buffer has no free range
+   * large enough.
+   */
+  Mesh allocate(uint32_t vertexCount, uint32_t stride, uint32_t indexCount);
+
+  /** @brief Buffer holding every mesh's vertices. */
+  const vk::raii::Buffer &vertexBuffer() const { return vertices; }
+
+  /** @brief Device address of the vertex buffer (0 without 'deviceAddress'). */
+  vk::DeviceAddress vertexAddress() const { return vertexBase; }
+
+  /** @brief Buffer holding every mesh's indices (32-bit). */
+  const vk::raii::Buffer &indexBuffer() const { return indices; }
+
+  /** @brief Current use of both buffers. */
+  Stats stats() const;
+
+private:
+  /** @brief Returns a mesh's ranges (called by Mesh). */
+  void free(const Mesh &mesh);
+
+  /** @brief Vertex buffer. */
+  vk::raii::Buffer vertices = nullptr;
+
+  /** @brief Memory of the vertex buffer. */
+  GpuAllocation vertexMemory = nullptr;
+
+  /** @brief Device address of 'vertices', if requested. */
+  vk::DeviceAddress vertexBase = 0;
+
+  /** @brief Index buffer. */
+  vk::raii::Buffer indices = nullptr;
+
+  /** @brief Memory of the index buffer. */
+  GpuAllocation indexMemory = nullptr;
+
+  /** @brief Byte ranges of the vertex buffer. */
+  TlsfAllocator vertexRanges;
+
+  /** @brief Index ranges of the index buffer. */
+  TlsfAllocator indexRanges;
+
+  /** @brief Live meshes. */
+  size_t meshCount = 0;
+
+  /** @brief Guards the range allocators and 'meshCount'. */
+  mutable std::mutex mutex;
+};
@@ -0,0 +1,313 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <vulkan/vulkan_raii.hpp>
+
+#include "TlsfAllocator.hpp"
+
+/**
+ * @file GpuAllocator.hpp
+ * @brief Sub-allocates buffers and images from large device memory blocks.
+ *
+ * Calling vkAllocateMemory once per resource runs into the driver's
+ * maxMemoryAllocationCount (4096 on many drivers) and leaves every
+ * allocation with its own page-granular slack. The **GpuAllocator** instead
+ * allocates blocks of up to 64 MiB per memory type and places resources
+ * inside them:
+ * - General resources go to TLSF-managed blocks (TlsfAllocator): O(1)
+ *   allocation and free with immediate merging of free neighbours.
+ * - Transient resources (staging buffers) are bump-allocated from linear
+ *   blocks, which start over once everything in them has been freed.
+ * - Resources larger than half a block, and those the driver prefers or
+ *   requires to own their memory, get a dedicated allocation.
+ *
+ * Linear resources (buffers) and optimal-tiling images are kept in separate
+ * blocks when bufferImageGranularity is larger than 1, so they never share
+ * a granularity page. Host-visible blocks are mapped once for their
+ * lifetime; mapped() returns the pointer of an allocation.
+ *
+ * Every allocation is tagged with a Category; stats() reports the live
+ * bytes of each category and the device memory held in each heap, which
+ * MemoryBudget compares with the driver's budget.
+ *
+ * Allocations free themselves when destroyed, so a GpuAllocation is used
+ * like the vk::raii::DeviceMemory it replaces:
+ * @code
+ * GpuAllocator allocator(physicalGPU, device);
+ * vk::raii::Buffer buffer(device, bufferInfo);
+ * GpuAllocation memory = allocator.allocate(
+ *     buffer,
+ *     vk::MemoryPropertyFlagBits::eHostVisible |
+ *         vk::MemoryPropertyFlagBits::eHostCoherent,
+ *     GpuAllocator::Category::eUniform);
+ * memcpy(memory.mapped(), data, size); // Already bound to 'buffer'
+ * @endcode
+ *
+ * The allocator is thread safe and must outlive its allocations.
+ */
+class GpuAllocation;
+
+class GpuAllocator {
+public:
+  /**
+   * @enum Usage
+   * @brief Lifetime of a buffer allocation.
+   */
+  enum class Usage {
+    eGeneral,  ///< Any lifetime (TLSF blocks)
+    eTransient ///< Short-lived, e.g. staging (linear blocks)
+  };
+
+  /**
+   * @enum Category
+   * @brief What an allocation is used for, for memory accounting.
+   */
+  enum class Category {
+    eVertex,     ///< Vertex and instance buffers
+    eIndex,      ///< Index buffers
+    eTexture,    ///< Sampled images
+    eAttachment, ///< Color/depth attachments
+    eStaging,    ///< Upload sources
+    eUniform,    ///< Uniform buffers
+    eOther       ///< Storage, indirect and anything else
+  };
+
+  /** @brief Number of Category values. */
+  static constexpr size_t kCategoryCount = 7;
+
+  /** @brief Lower-case name of a category ("vertex", "index", ...). */
+  static const char *categoryName(Category category);
+
+  /**
+   * @struct Stats
+   * @brief Snapshot of the allocator's memory use.
+   */
+  struct Stats {
+    size_t blockCount = 0;             ///< Sub-allocated blocks
+    size_t dedicatedCount = 0;         ///< Dedicated allocations
+    size_t allocationCount = 0;        ///< Live sub-allocations
+    vk::DeviceSize blockBytes = 0;     ///< Size of all blocks
+    vk::DeviceSize usedBytes = 0;      ///< Sub-allocated bytes
+    vk::DeviceSize freeBytes = 0;      ///< Unused bytes in blocks
+    vk::DeviceSize dedicatedBytes = 0; ///< Size of dedicated allocations
+    float fragmentation = 0.0f;        ///< 1 - largest / total free range
+
+    /** @brief Live bytes of each Category (sub-allocated and dedicated). */
+    std::array<vk::DeviceSize, kCategoryCount> categoryBytes{};
+
+    /** @brief Device memory (blocks and dedicated) held in each heap. */
+    std::vector<vk::DeviceSize> heapBytes;
+  };
+
+  /** @brief Upper bound of the block size. */
+  static constexpr vk::DeviceSize kMaxBlockSize = 64ull << 20;
+
+  /**
+   * @brief Creates an allocator for a device.
+   *
+   * @param physicalGPU Source of memory types, heaps and limits.
+   * @param logicalDevice Device that allocates the memory; must outlive the
+   * allocator.
+   * @param blockSizeLimit Block size limit; blocks are also at most 1/8 of
+   * their heap.
+   * @param deviceAddress Allocate all memory with the device address flag,
+   * so buffers with eShaderDeviceAddress usage can be bound to it (requires
+   * the bufferDeviceAddress feature).
+   */
+  GpuAllocator(const vk::raii::PhysicalDevice &physicalGPU,
+               const vk::raii::Device &logicalDevice,
+               vk::DeviceSize blockSizeLimit = kMaxBlockSize,
+               bool deviceAddress = false);
+
+  ~GpuAllocator();
+
+  GpuAllocator(const GpuAllocator &) = delete;
+  GpuAllocator &operator=(const GpuAllocator &) = delete;
+
+  /**
+   * @brief Allocates memory for a buffer and binds it.
+   *
+   * @param buffer Buffer without memory.
+   * @param properties Required memory properties.
+   * @param category What the buffer holds.
+   * @param usage eTransient for short-lived buffers.
+   * @throws std::runtime_error if no memory type matches.
+   */
+  GpuAllocation allocate(const vk::raii::Buffer &buffer,
+                         vk::MemoryPropertyFlags properties, Category category,
+                         Usage usage = Usage::eGeneral);
+
+  /**
+   * @brief Allocates memory for an image and binds it.
+   *
+   * @param image Image without memory.
+   * @param tiling Tiling the image was created with.
+   * @param properties Required memory properties.
+   * @param category What the image is used for.
+   * @throws std::runtime_error if no memory type matches.
+   */
+  GpuAllocation allocate(const vk::raii::Image &image, vk::ImageTiling tiling,
+                         vk::MemoryPropertyFlags properties,
+                         Category category);
+
+  /**
+   * @brief Allocates memory for optimal-tiling images the caller binds
+   * itself, e.g. several aliased attachments sharing one range.
+   *
+   * @param requirements Combined size, alignment and memory type bits.
+   * @param properties Required memory properties.
+   * @param category What the images are used for.
+   * @throws std::runtime_error if no memory type matches.
+   */
+  GpuAllocation allocate(const vk::MemoryRequirements &requirements,
+                         vk::MemoryPropertyFlags properties,
+                         Category category);
+
+  /** @brief True when a memory type in 'typeBits' has 'properties'. */
+  bool hasMemoryType(uint32_t typeBits,
+                     vk::MemoryPropertyFlags properties) const;
+
+  /**
+   * @brief Takes ownership of memory allocated elsewhere (e.g. imported
+   * host memory) so it is freed and counted like a dedicated allocation.
+   *
+   * @param memory Allocated memory.
+   * @param size Its allocationSize.
+   * @param memoryType Its memoryTypeIndex.
+   * @param category What it is used for.
+   */
+  GpuAllocation adopt(vk::raii::DeviceMemory &&memory, vk::DeviceSize size,
+                      uint32_t memoryType, Category category);
+
+  /** @brief Current block and allocation statistics. */
+  Stats stats() const;
+
+private:
+  friend class GpuAllocation;
+
+  struct Block;
+
+  /**
+   * @struct Pool
+   * @brief Blocks of one memory type for one kind of resource.
+   */
+  struct Pool {
+    uint32_t memoryType = 0;                    ///< Memory type index
+    bool transient = false;                     ///< Linear blocks
+    bool optimalImages = false;                 ///< Holds optimal images
+    std::vector<std::unique_ptr<Block>> blocks; ///< Newest last
+  };
+
+  /** @brief Finds or creates the pool for a resource. */
+  Pool &pool(uint32_t memoryType, bool transient, bool optimalImages);
+
+  /** @brief Index of the first memory type in 'typeBits' with 'properties'. */
+  uint32_t findMemoryType(uint32_t typeBits,
+                          vk::MemoryPropertyFlags properties) const;
+
+  /**
+   * @brief Allocates memory for a resource with the given requirements.
+   *
+   * @param optimalImage True for optimal-tiling images.
+   * @param dedicatedPreferred The driver prefers a dedicated allocation.
+   * @param dedicatedInfo Resource handle for a dedicated allocation.
+   * @param category Accounting category of the allocation.
+   */
+  GpuAllocation
+  allocateMemory(const vk::MemoryRequirements &requirements,
+                 vk::MemoryPropertyFlags properties, Usage usage,
+                 bool optimalImage, bool dedicatedPreferred,
+                 const vk::MemoryDedicatedAllocateInfo &dedicatedInfo,
+                 Category category);
+
+  /** @brief Allocates (and maps, if host visible) a device memory block. */
+  std::unique_ptr<Block> createBlock(vk::DeviceSize size, uint32_t memoryType,
+                                     const void *next);
+
+  /** @brief Returns an allocation to its block (called by GpuAllocation). */
+  void free(Block *block, const TlsfAllocator::Allocation &range,
+            Category category);
+
+  /** @brief Device the memory belongs to. */
+  const vk::raii::Device &device;
+
+  /** @brief Memory types and heaps of the device. */
+  vk::PhysicalDeviceMemoryProperties memoryProperties;
+
+  /** @brief Alignment between buffers and optimal images sharing memory. */
+  vk::DeviceSize bufferImageGranularity = 1;
+
+  /** @brief Block size limit. */
+  vk::DeviceSize maxBlockSize = kMaxBlockSize;
+
+  /** @brief Allocate memory with vk::MemoryAllocateFlagBits::eDeviceAddress. */
+  bool deviceAddresses = false;
+
+  /** @brief Every pool created so far. */
+  std::vector<std::unique_ptr<Pool>> pools;
+
+  /** @brief Dedicated allocations. */
+  std::vector<std::unique_ptr<Block>> dedicated;
+
+  /** @brief Live bytes of each Category. */
+  std::array<vk::DeviceSize, kCategoryCount> categoryBytes{};
+
+  /** @brief Guards all of the above. */
+  mutable std::mutex mutex;
+};
+
+/**
+ * @class GpuAllocation
+ * @brief Memory range owned by one resource; freed on destruction.
+ */
+class GpuAllocation {
+public:
+  GpuAllocation() = default;
+
+  /** @brief Empty allocation, for '= nullptr' like the vk::raii types. */
+  GpuAllocation(std::nullptr_t) {}
+
+  GpuAllocation(GpuAllocation &&other) noexcept;
+  GpuAllocation &operator=(GpuAllocation &&other) noexcept;
+  GpuAllocation(const GpuAllocation &) = delete;
+  GpuAllocation &operator=(const GpuAllocation &) = delete;
+
+  ~GpuAllocation() { reset(); }
+
+  /** @brief Device memory holding the range. */
+  vk::DeviceMemory memory() const;
+
+  /** @brief Start of the range in memory(). */
+  vk::DeviceSize offset() const { return range.offset; }
+
+  /** @brief Size of the range. */
+  vk::DeviceSize size() const { return range.size; }
+
+  /** @brief Host pointer to the range, or nullptr if not host visible. */
+  void *mapped() const;
+
+  /** @brief True when the allocation owns a range. */
+  explicit operator bool() const { return block != nullptr; }
+
+  /** @brief Frees the range; the allocation becomes empty. */
+  void reset();
+
+private:
+  friend class GpuAllocator;
+
+  GpuAllocation(GpuAllocator *allocator, GpuAllocator::Block *memoryBlock,
+                const TlsfAllocator::Allocation &allocation,
+                GpuAllocator::Category tag)
+      : owner(allocator), block(memoryBlock), range(allocation),
+        category(tag) {}
+
+  GpuAllocator *owner = nullptr;         ///< Allocator to free into
+  GpuAllocator::Block *block = nullptr;  ///< Block holding the range
+  TlsfAllocator::Allocation range{0, 0}; ///< Offset, size, TLSF node
+  GpuAllocator::Category category =      ///< Accounting category
+      GpuAllocator::Category::eOther;
+};
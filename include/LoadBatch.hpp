@@ -0,0 +1,110 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <vulkan/vulkan_raii.hpp>
+
+#include "StagingPool.hpp"
+
+/**
+ * @file LoadBatch.hpp
+ * @brief One blocking submission for every load-time transfer that needs
+ *        the graphics queue.
+ *
+ * Recording each layout transition, copy and mip generation into its own
+ * command buffer and waiting for the queue to go idle after each one costs
+ * a submission and a full GPU round trip per operation. A **LoadBatch**
+ * hands out one command buffer on the graphics queue family; every loader
+ * records its transfers and barriers into it and hands over the staging
+ * ranges they read. submit() then submits once, waits on one fence, and
+ * releases all of those ranges together.
+ *
+ * @code
+ * const StagingPool::Range staging = pool.upload(pixels);
+ * const vk::raii::CommandBuffer &commands = loadBatch.commands();
+ * // ... record barriers, copyBufferToImage() and blits into 'commands'
+ * loadBatch.release(staging);
+ *
+ * loadBatch.submit(); // Once, before anything uses the images
+ * @endcode
+ *
+ * Work that does not need the graphics queue or the host to wait belongs
+ * on the UploadQueue instead. Not thread safe; the device, queue family and
+ * staging pool must outlive the batch.
+ */
+class LoadBatch {
+public:
+  /**
+   * @struct Stats
+   * @brief Totals since creation.
+   */
+  struct Stats {
+    uint64_t submits = 0;       ///< Submissions (one per non-empty batch)
+    uint64_t stagingRanges = 0; ///< Staging ranges released after them
+    double waitMs = 0;          ///< Host time spent in submit()
+  };
+
+  /**
+   * @brief Creates the command pool and fence.
+   *
+   * @param logicalDevice Device the queue family belongs to.
+   * @param stagingPool Pool the released ranges go back to.
+   * @param queueFamily Graphics family to submit to (queue 0).
+   */
+  LoadBatch(const vk::raii::Device &logicalDevice, StagingPool &stagingPool,
+            uint32_t queueFamily);
+
+  /** @brief Releases the ranges of a batch never submitted. */
+  ~LoadBatch();
+
+  LoadBatch(const LoadBatch &) = delete;
+  LoadBatch &operator=(const LoadBatch &) = delete;
+
+  /** @brief Command buffer of the current batch, begun on first use. */
+  const vk::raii::CommandBuffer &commands();
+
+  /** @brief Returns 'range' to the pool once the batch has completed. */
+  void release(const StagingPool::Range &range);
+
+  /** @brief True when nothing was recorded since the last submit(). */
+  bool empty() const { return !recording; }
+
+  /**
+   * @brief Submits the batch, waits for it and releases its staging
+   * ranges. Does nothing when the batch is empty.
+   *
+   * @throws std::runtime_error if the fence wait fails.
+   */
+  void submit();
+
+  /** @brief Totals since creation. */
+  const Stats &stats() const { return totals; }
+
+private:
+  /** @brief Device of the pool, fence and command buffer. */
+  const vk::raii::Device &device;
+
+  /** @brief Destination of the released ranges. */
+  StagingPool &staging;
+
+  /** @brief Queue 0 of the graphics family. */
+  vk::raii::Queue queue = nullptr;
+
+  /** @brief Pool of 'commandBuffer'. */
+  vk::raii::CommandPool commandPool = nullptr;
+
+  /** @brief Reset and re-recorded for every batch. */
+  vk::raii::CommandBuffer commandBuffer = nullptr;
+
+  /** @brief Signaled by the batch's submission. */
+  vk::raii::Fence fence = nullptr;
+
+  /** @brief True between the first commands() and submit(). */
+  bool recording = false;
+
+  /** @brief Ranges read by the current batch. */
+  std::vector<StagingPool::Range> ranges;
+
+  /** @brief Totals since creation. */
+  Stats totals;
+};
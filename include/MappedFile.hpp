@@ -0,0 +1,68 @@
+#pragma once
+#include <cstddef>
+#include <span>
+#include <string>
+
+/**
+ * @file MappedFile.hpp
+ * @brief Read-only, RAII-managed memory mapping of a file on disk.
+ *
+ * The **MappedFile** class wraps POSIX 'mmap' so large binary assets (mesh
+ * caches, asset packs) can be read straight out of the page cache without an
+ * intermediate 'std::vector' copy. The mapping is released automatically when
+ * the object is destroyed.
+ *
+ * @note Only read-only, whole-file mappings are supported.
+ *
+ * @code
+ * MappedFile file("models/statue.armesh");
+ * std::span<const std::byte> bytes = file.bytes();
+ * @endcode
+ */
+class MappedFile {
+public:
+  /** @brief Creates an empty (unmapped) file handle. */
+  MappedFile() = default;
+
+  /**
+   * @brief Maps the entire contents of a file into memory.
+   *
+   * @param filename Path of the file to map.
+   * @throws std::runtime_error If the file cannot be opened or mapped.
+   */
+  explicit MappedFile(const std::string &filename);
+
+  /** @brief Unmaps the file (if mapped). */
+  ~MappedFile();
+
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+
+  /** @brief Transfers ownership of a mapping. */
+  MappedFile(MappedFile &&other) noexcept;
+
+  /** @brief Transfers ownership of a mapping, releasing the current one. */
+  MappedFile &operator=(MappedFile &&other) noexcept;
+
+  /** @brief Pointer to the first mapped byte (nullptr if unmapped). */
+  const std::byte *data() const { return mappedData; }
+
+  /** @brief Size of the mapping in bytes. */
+  size_t size() const { return mappedSize; }
+
+  /** @brief Whole mapping as a byte span. */
+  std::span<const std::byte> bytes() const { return {mappedData, mappedSize}; }
+
+  /** @brief True if a file is currently mapped. */
+  bool isOpen() const { return mappedData != nullptr; }
+
+private:
+  /** @brief Base address of the mapping. */
+  const std::byte *mappedData = nullptr;
+
+  /** @brief Length of the mapping in bytes. */
+  size_t mappedSize = 0;
+
+  /** @brief Unmaps the current mapping and resets the handle. */
+  void release();
+};
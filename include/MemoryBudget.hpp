@@ -0,0 +1,102 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <utility>
+#include <vector>
+#include <vulkan/vulkan_raii.hpp>
+
+/**
+ * @file MemoryBudget.hpp
+ * @brief Per-heap memory usage against the driver's budget.
+ *
+ * The **MemoryBudget** reads, once per frame, how much of each memory heap
+ * the process uses and how much it may use before the OS starts paging or
+ * allocations fail. With VK_EXT_memory_budget both numbers come from the
+ * driver and include memory allocated outside GpuAllocator (swapchain
+ * images, driver internals); without it, usage is what GpuAllocator holds
+ * and the budget is 80% of the heap size.
+ *
+ * When a heap's usage rises above 'threshold' of its budget the callback is
+ * called with overThreshold set, so streaming systems can evict; it is
+ * called again once usage has dropped kHysteresis below the threshold.
+ *
+ * @code
+ * MemoryBudget budget(physicalGPU, extensionEnabled, 0.9f);
+ * budget.setCallback([](uint32_t heap, const MemoryBudget::Heap &state) {
+ *   if (state.overThreshold) { evict(); }
+ * });
+ *
+ * // Every frame
+ * budget.update(allocator.stats().heapBytes);
+ * @endcode
+ */
+class MemoryBudget {
+public:
+  /**
+   * @struct Heap
+   * @brief Usage and budget of one memory heap.
+   */
+  struct Heap {
+    vk::DeviceSize size = 0;      ///< Heap size
+    vk::DeviceSize budget = 0;    ///< Bytes the process may use
+    vk::DeviceSize usage = 0;     ///< Bytes the process uses
+    vk::DeviceSize allocated = 0; ///< Bytes held by GpuAllocator
+    bool deviceLocal = false;     ///< Heap is video memory
+    bool overThreshold = false;   ///< Usage is above the threshold
+  };
+
+  /** @brief Called when a heap crosses the threshold, either way. */
+  using Callback = std::function<void(uint32_t heapIndex, const Heap &heap)>;
+
+  /** @brief Fraction of the threshold usage must drop below to recover. */
+  static constexpr float kHysteresis = 0.05f;
+
+  /**
+   * @brief Reads the heaps of a device.
+   *
+   * @param physicalGPU Device queried every update(); must outlive this.
+   * @param extensionEnabled VK_EXT_memory_budget is enabled on the device.
+   * @param threshold Fraction (0, 1] of the budget that triggers the
+   * callback.
+   */
+  MemoryBudget(const vk::raii::PhysicalDevice &physicalGPU,
+               bool extensionEnabled, float threshold);
+
+  /** @brief Sets the threshold callback (replaces the previous one). */
+  void setCallback(Callback callback) { onThreshold = std::move(callback); }
+
+  /**
+   * @brief Refreshes usage and budget and calls the callback for every heap
+   * that crossed the threshold since the last update.
+   *
+   * @param allocatedPerHeap Bytes held by GpuAllocator in each heap
+   * (GpuAllocator::Stats::heapBytes).
+   */
+  void update(std::span<const vk::DeviceSize> allocatedPerHeap);
+
+  /** @brief State of every heap as of the last update(). */
+  const std::vector<Heap> &heaps() const { return heapStates; }
+
+  /** @brief True when usage and budget come from VK_EXT_memory_budget. */
+  bool supported() const { return extension; }
+
+  /** @brief Fraction of the budget that triggers the callback. */
+  float threshold() const { return limit; }
+
+private:
+  /** @brief Device whose heaps are reported. */
+  const vk::raii::PhysicalDevice &gpu;
+
+  /** @brief VK_EXT_memory_budget is enabled. */
+  bool extension = false;
+
+  /** @brief Fraction of the budget that triggers the callback. */
+  float limit = 1.0f;
+
+  /** @brief One entry per memory heap. */
+  std::vector<Heap> heapStates;
+
+  /** @brief Threshold callback (may be empty). */
+  Callback onThreshold;
+};
@@ -0,0 +1,235 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <optional>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "MappedFile.hpp"
+#include "MeshData.hpp"
+#include "Vertex.hpp"
+
+/**
+ * @file MeshCache.hpp
+ * @brief Versioned binary mesh cache that replaces OBJ parsing on warm starts.
+ *
+ * The **meshcache** namespace stores the fully processed (deduplicated) mesh
+ * next to its source asset. On the next launch the cache file is memory
+ * mapped and its vertex/index arrays are used in place, so they can be
+ * copied straight into Vulkan staging buffers without reparsing the OBJ or
+ * rebuilding the vertex deduplication table.
+ *
+ * File layout (all offsets are relative to the start of the file):
+ * @code
+ * [Header][pad to 64][Vertex x vertexCount][pad to 64][uint32_t x indexCount]
+ * [pad to 64][MeshLod x lodCount][pad to 64][MeshSubmesh x submeshCount]
+ * [pad to 64][MaterialRecord x materialCount]
+ * @endcode
+ *
+ * A cache is considered valid for a source file when:
+ * - magic, version and 'sizeof(Vertex)' match this build,
+ * - every section lies within the file and every index addresses a vertex,
+ * - the processing flags match the ones requested by the caller, and
+ * - the source size matches and either its modification time or its content
+ *   hash matches the values recorded when the cache was written.
+ *
+ * If the source file no longer exists the cache is trusted as-is, which
+ * allows shipping only the cache. The OBJ's material library is not part of
+ * the check; touch the OBJ after editing it.
+ *
+ * @note The cache is a native-endian, same-ABI format; it is not meant to be
+ * portable between machines with different architectures.
+ *
+ * @see MappedFile
+ * @see MeshData
+ */
+namespace meshcache {
+
+/** @brief Magic bytes identifying a mesh cache file. */
+constexpr char kMagic[4] = {'A', 'R', 'M', 'C'};
+
+/** @brief Current cache format version; bump on any layout change. */
+constexpr uint32_t kVersion = 3;
+
+/** @brief Alignment (bytes) of each data section inside the file. */
+constexpr uint64_t kSectionAlignment = 64;
+
+/** @brief Header flag: indices/vertices were reordered by meshopt. */
+constexpr uint32_t kFlagCacheOptimized = 1u << 0;
+
+/** @brief Header flag: triangle clusters were sorted for overdraw. */
+constexpr uint32_t kFlagOverdrawOptimized = 1u << 1;
+
+/** @brief Header flag: the LOD chain was generated by meshlod. */
+constexpr uint32_t kFlagLods = 1u << 2;
+
+/**
+ * @struct Header
+ * @brief Fixed-size header at the start of every cache file.
+ */
+struct Header {
+  char magic[4];           ///< Always kMagic
+  uint32_t version;        ///< Format version (kVersion)
+  uint32_t vertexStride;   ///< sizeof(Vertex) at write time
+  uint32_t flags;          ///< Processing flags (kFlag*)
+  uint64_t sourceSize;     ///< Size of the source asset in bytes
+  int64_t sourceMtime;     ///< Source modification time (filesystem clock)
+  uint64_t sourceHash;     ///< hashBytes() of the source contents
+  uint64_t vertexCount;    ///< Number of Vertex records
+  uint64_t indexCount;     ///< Number of uint32_t indices
+  uint64_t vertexOffset;   ///< Byte offset of the vertex array
+  uint64_t indexOffset;    ///< Byte offset of the index array
+  uint64_t lodCount;       ///< Number of MeshLod records (0 = single level)
+  uint64_t lodOffset;      ///< Byte offset of the LOD array
+  float boundsMin[3];      ///< Model-space bounding box minimum
+  float boundsMax[3];      ///< Model-space bounding box maximum
+  uint64_t submeshCount;   ///< Number of MeshSubmesh records (0 = none)
+  uint64_t submeshOffset;  ///< Byte offset of the submesh array
+  uint64_t materialCount;  ///< Number of MaterialRecord records
+  uint64_t materialOffset; ///< Byte offset of the material array
+};
+
+/**
+ * @struct MaterialRecord
+ * @brief Fixed-size, null-terminated on-disk form of a MeshMaterial.
+ */
+struct MaterialRecord {
+  char name[64];            ///< MeshMaterial::name
+  char diffuseTexture[192]; ///< MeshMaterial::diffuseTexture
+  float diffuseColor[3];    ///< MeshMaterial::diffuseColor
+  uint32_t reserved;        ///< Zero
+};
+
+/**
+ * @brief Fast, non-cryptographic 64-bit hash of a byte range.
+ *
+ * Used to detect whether a source asset really changed when only its
+ * modification time differs (e.g. after a fresh checkout).
+ *
+ * @param bytes Data to hash.
+ * @return 64-bit hash value.
+ */
+uint64_t hashBytes(std::span<const std::byte> bytes);
+
+/**
+ * @struct SourceStamp
+ * @brief Cheap identity of a source file (size + modification time).
+ */
+struct SourceStamp {
+  uint64_t size = 0;
+  int64_t mtime = 0;
+};
+
+/**
+ * @brief Reads size and modification time of a file.
+ *
+ * @param path File to inspect.
+ * @return Stamp, or std::nullopt if the file does not exist.
+ */
+std::optional<SourceStamp> stampFile(const std::string &path);
+
+/**
+ * @brief Hashes the full contents of a file with hashBytes().
+ *
+ * @param path File to hash.
+ * @return 64-bit hash.
+ * @throws std::runtime_error If the file cannot be mapped.
+ */
+uint64_t hashFile(const std::string &path);
+
+/**
+ * @class CachedMesh
+ * @brief A validated, memory-mapped mesh cache file.
+ *
+ * The vertex and index spans point directly into the mapping and remain
+ * valid for the lifetime of the CachedMesh (including after moves). A
+ * CachedMesh created with fromBytes() views memory it does not own, such as
+ * an asset pack blob, which must outlive it.
+ */
+class CachedMesh {
+public:
+  /**
+   * @brief Opens and validates a cache file for a given source asset.
+   *
+   * @param cachePath Path of the cache file.
+   * @param sourcePath Path of the asset the cache was generated from.
+   * @param flags Processing flags the cached data must have been written with.
+   * @return The mapped cache, or std::nullopt if it is missing, corrupt,
+   * stale or was processed differently.
+   */
+  static std::optional<CachedMesh> open(const std::string &cachePath,
+                                        const std::string &sourcePath,
+                                        uint32_t flags = 0);
+
+  /**
+   * @brief Validates cache contents that are already in memory.
+   *
+   * @param bytes Cache file contents (e.g. an asset pack blob); not copied.
+   * @param sourcePath Path of the asset the cache was generated from.
+   * @param flags Processing flags the cached data must have been written with.
+   * @return A view of 'bytes', or std::nullopt under the same conditions as
+   * open().
+   */
+  static std::optional<CachedMesh> fromBytes(std::span<const std::byte> bytes,
+                                             const std::string &sourcePath,
+                                             uint32_t flags = 0);
+
+  /** @brief Whole cache contents, viewed in place. */
+  std::span<const std::byte> bytes() const { return contents; }
+
+  /** @brief Deduplicated vertices stored in the cache. */
+  std::span<const Vertex> vertices() const;
+
+  /** @brief Triangle indices stored in the cache. */
+  std::span<const uint32_t> indices() const;
+
+  /** @brief LOD ranges into indices() (empty if none were stored). */
+  std::span<const MeshLod> lods() const;
+
+  /** @brief Material ranges of every LOD (empty if none were stored). */
+  std::span<const MeshSubmesh> submeshes() const;
+
+  /** @brief Materials referenced by submeshes(), decoded from the file. */
+  std::vector<MeshMaterial> materials() const;
+
+  /** @brief Minimum corner of the model-space bounding box. */
+  glm::vec3 boundsMin() const;
+
+  /** @brief Maximum corner of the model-space bounding box. */
+  glm::vec3 boundsMax() const;
+
+private:
+  explicit CachedMesh(std::span<const std::byte> bytes) : contents(bytes) {}
+
+  /** @brief Header at the start of the contents. */
+  const Header &header() const {
+    return *reinterpret_cast<const Header *>(contents.data());
+  }
+
+  /** @brief Mapping that backs all returned spans (empty for views). */
+  MappedFile file;
+
+  /** @brief Cache contents, inside 'file' or borrowed. */
+  std::span<const std::byte> contents;
+};
+
+/**
+ * @brief Writes a mesh cache for a source asset.
+ *
+ * The file is written to a temporary path and renamed into place so a
+ * crash mid-write never leaves a truncated cache behind.
+ *
+ * @param cachePath Destination path of the cache file.
+ * @param sourcePath Source asset whose size/mtime/hash are recorded.
+ * @param mesh Processed mesh to store.
+ * @param flags Processing flags applied to 'mesh' (kFlag*).
+ * @throws std::runtime_error If the cache cannot be written or a material
+ * name or texture path does not fit a MaterialRecord.
+ */
+void write(const std::string &cachePath, const std::string &sourcePath,
+           const MeshData &mesh, uint32_t flags = 0);
+
+} // namespace meshcache
@@ -0,0 +1,116 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "Vertex.hpp"
+
+/**
+ * @file MeshData.hpp
+ * @brief CPU-side container for a deduplicated, indexed triangle mesh.
+ *
+ * **MeshData** is the common currency between the mesh loaders (OBJ parsing),
+ * the binary mesh cache and the renderer. It holds exactly what the GPU vertex
+ * and index buffers are filled from, plus the model-space bounding box,
+ * optional level-of-detail ranges and the per-material ranges of each level.
+ *
+ * @see meshloader::loadObj()
+ * @see meshcache::write()
+ */
+
+/**
+ * @struct MeshLod
+ * @brief One level of detail: a contiguous range of MeshData::indices.
+ *
+ * All levels index the same vertex array, so switching LODs only changes
+ * the 'firstIndex'/'indexCount' of the draw.
+ */
+struct MeshLod {
+  uint32_t indexOffset = 0; ///< First index of this level
+  uint32_t indexCount = 0;  ///< Number of indices (3 per triangle)
+  float error = 0.0f;       ///< Max geometric deviation from LOD 0 (model units)
+  uint32_t reserved = 0;    ///< Keeps the struct 16 bytes (cache format)
+};
+
+/**
+ * @struct MeshMaterial
+ * @brief Surface description of one OBJ/MTL material.
+ */
+struct MeshMaterial {
+  std::string name;             ///< 'newmtl' / 'usemtl' name
+  std::string diffuseTexture;   ///< map_Kd path (resolved), or empty
+  glm::vec3 diffuseColor{1.0f}; ///< Kd, multiplied with the texture
+};
+
+/**
+ * @struct MeshSubmesh
+ * @brief The triangles of one material within one LOD: a contiguous range
+ * of MeshData::indices.
+ *
+ * Submeshes are ordered by LOD, then material, so the submeshes of a level
+ * tile its MeshLod range exactly and can be drawn with one indexed draw
+ * each, switching only the material between draws.
+ */
+struct MeshSubmesh {
+  uint32_t indexOffset = 0; ///< First index of the range
+  uint32_t indexCount = 0;  ///< Number of indices (3 per triangle)
+  uint32_t material = 0;    ///< Index into MeshData::materials
+  uint32_t lod = 0;         ///< Level the range belongs to
+};
+
+/**
+ * @struct MeshData
+ * @brief Unique vertices, triangle indices, bounds and LOD ranges of a mesh.
+ */
+struct MeshData {
+  /** @brief Unique vertices referenced by 'indices'. */
+  std::vector<Vertex> vertices;
+
+  /**
+   * @brief Triangle list indices into 'vertices'.
+   *
+   * When 'lods' is non-empty, every level's index range is stored here back
+   * to back (LOD 0 first).
+   */
+  std::vector<uint32_t> indices;
+
+  /** @brief Level-of-detail ranges (empty = all indices form one level). */
+  std::vector<MeshLod> lods;
+
+  /** @brief Materials referenced by 'submeshes' (empty = untextured OBJ). */
+  std::vector<MeshMaterial> materials;
+
+  /**
+   * @brief Per-material index ranges of every level (empty = one material,
+   * each level drawn as a whole).
+   */
+  std::vector<MeshSubmesh> submeshes;
+
+  /** @brief Minimum corner of the model-space bounding box. */
+  glm::vec3 boundsMin{0.0f};
+
+  /** @brief Maximum corner of the model-space bounding box. */
+  glm::vec3 boundsMax{0.0f};
+
+  /**
+   * @brief Recomputes 'boundsMin'/'boundsMax' from the vertex positions.
+   *
+   * @note An empty mesh yields a degenerate box at the origin.
+   */
+  void computeBounds() {
+    if (vertices.empty()) {
+      boundsMin = boundsMax = glm::vec3(0.0f);
+      return;
+    }
+
+    boundsMin = glm::vec3(std::numeric_limits<float>::max());
+    boundsMax = glm::vec3(std::numeric_limits<float>::lowest());
+    for (const Vertex &vertex : vertices) {
+      boundsMin = glm::min(boundsMin, vertex.position);
+      boundsMax = glm::max(boundsMax, vertex.position);
+    }
+  }
+};
@@ -0,0 +1,86 @@
+#pragma once
+#include <cstddef>
+#include <span>
+#include <string>
+
+#include "MeshData.hpp"
+#include "ThreadPool.hpp"
+
+/**
+ * @file MeshLoader.hpp
+ * @brief Source-format mesh loading (Wavefront OBJ) into MeshData.
+ *
+ * The **meshloader** namespace turns source assets into the deduplicated,
+ * indexed representation consumed by the renderer. It is kept separate from
+ * VulkanRenderer so that offline tools and benchmarks can parse meshes
+ * without creating a window or a Vulkan device.
+ *
+ * Two OBJ backends are provided: loadObjParallel() (in-tree, multi-threaded,
+ * used by the renderer) and loadObj() (TinyOBJLoader, kept as the reference
+ * implementation for benchmarks and validation). Both produce identical
+ * vertex and index arrays.
+ *
+ * Materials: when faces reference materials of the OBJ's 'mtllib' library,
+ * triangles are grouped by material (stable, before deduplication) and
+ * MeshData::materials / MeshData::submeshes describe the ranges. Only used
+ * materials are kept, in library declaration order; faces without a known
+ * material share a default material placed last. map_Kd paths are resolved
+ * against the OBJ's directory, and a Kd of zero (tinyobj's value for a
+ * missing Kd) becomes white so it does not blacken the texture.
+ *
+ * @see MeshData
+ * @see meshcache
+ * @see objparser
+ */
+namespace meshloader {
+
+/**
+ * @brief Loads an OBJ file into a deduplicated vertex/index mesh.
+ *
+ * Texture coordinates are flipped on Y to match Vulkan conventions and every
+ * vertex receives a white color. Bounds are computed before returning.
+ *
+ * @param filename Path to the OBJ file.
+ * @return MeshData with unique vertices, triangle indices, bounds and
+ * per-material ranges.
+ * @throws std::runtime_error If the file cannot be opened or parsed.
+ *
+ * @code
+ * MeshData mesh = meshloader::loadObj("models/statue.obj");
+ * @endcode
+ */
+MeshData loadObj(const std::string &filename);
+
+/**
+ * @brief Loads an OBJ file using the multi-threaded in-tree parser.
+ *
+ * Produces the same MeshData as loadObj() but parses the file in parallel
+ * chunks directly from a read-only mapping.
+ *
+ * @param filename Path to the OBJ file.
+ * @param pool Worker pool used for parsing (defaults to the global pool).
+ * @return MeshData with unique vertices, triangle indices and bounds.
+ * @throws std::runtime_error If the file cannot be opened or parsed.
+ *
+ * @see objparser::parse()
+ */
+MeshData loadObjParallel(const std::string &filename,
+                         ThreadPool &pool = ThreadPool::global());
+
+/**
+ * @brief Parses OBJ text that is already in memory with the multi-threaded
+ * in-tree parser (e.g. a buffer filled by AsyncFileReader).
+ *
+ * @param text Contents of an OBJ file.
+ * @param materialDir Directory 'mtllib' and map_Kd paths are relative to
+ * (the OBJ's directory).
+ * @param pool Worker pool used for parsing (defaults to the global pool).
+ * @return MeshData with unique vertices, triangle indices, bounds and
+ * per-material ranges.
+ * @throws std::runtime_error If the text cannot be parsed.
+ */
+MeshData loadObjParallel(std::span<const std::byte> text,
+                         const std::string &materialDir,
+                         ThreadPool &pool = ThreadPool::global());
+
+} // namespace meshloader
@@ -0,0 +1,121 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "MeshData.hpp"
+#include "Vertex.hpp"
+
+/**
+ * @file MeshOptimizer.hpp
+ * @brief Post-load index/vertex reordering for GPU cache efficiency.
+ *
+ * The **meshopt** namespace reorders an indexed triangle mesh without
+ * changing what it renders:
+ * 1. optimizeVertexCache(): Tipsify triangle reordering so the post-transform
+ *    vertex cache is reused (lower ACMR),
+ * 2. optimizeOverdraw() (optional): sorts cache-friendly triangle clusters
+ *    front-to-back from the outside, trading a little ACMR for less overdraw,
+ * 3. optimizeVertexFetch(): renumbers vertices in first-use order so vertex
+ *    fetches walk the vertex buffer mostly sequentially.
+ *
+ * Quality is reported as ACMR (transformed vertices per triangle, ~0.5-0.7
+ * is excellent) and ATVR (transformed vertices per unique vertex, 1.0 is
+ * optimal) measured with a FIFO cache simulation.
+ *
+ * @code
+ * meshopt::Report report = meshopt::optimize(mesh);
+ * std::cout << report.before.acmr << " -> " << report.after.acmr;
+ * @endcode
+ *
+ * @see VulkanRenderer::loadModel()
+ */
+namespace meshopt {
+
+/** @brief Post-transform cache size used for optimization and analysis. */
+constexpr uint32_t kDefaultCacheSize = 16;
+
+/**
+ * @struct CacheStats
+ * @brief Result of a FIFO vertex cache simulation.
+ */
+struct CacheStats {
+  double acmr = 0.0; ///< Average cache miss ratio (misses per triangle)
+  double atvr = 0.0; ///< Average transform to vertex ratio (misses per vertex)
+};
+
+/**
+ * @struct Options
+ * @brief Controls which passes optimize() runs.
+ */
+struct Options {
+  uint32_t cacheSize = kDefaultCacheSize; ///< Simulated cache entries
+  bool overdraw = false;        ///< Also run optimizeOverdraw()
+  float overdrawThreshold = 1.05f; ///< Max ACMR growth allowed by overdraw
+};
+
+/**
+ * @struct Report
+ * @brief Cache statistics before and after optimize().
+ */
+struct Report {
+  CacheStats before;
+  CacheStats after;
+};
+
+/**
+ * @brief Simulates a FIFO post-transform cache over an index buffer.
+ *
+ * @param indices Triangle list indices.
+ * @param vertexCount Number of vertices referenced by 'indices'.
+ * @param cacheSize FIFO cache size in vertices.
+ * @return ACMR and ATVR.
+ */
+CacheStats analyzeVertexCache(std::span<const uint32_t> indices,
+                              size_t vertexCount,
+                              uint32_t cacheSize = kDefaultCacheSize);
+
+/**
+ * @brief Reorders triangles for post-transform cache locality (Tipsify).
+ *
+ * @param indices Triangle list indices, reordered in place.
+ * @param vertexCount Number of vertices referenced by 'indices'.
+ * @param cacheSize Target cache size in vertices.
+ */
+void optimizeVertexCache(std::span<uint32_t> indices, size_t vertexCount,
+                         uint32_t cacheSize = kDefaultCacheSize);
+
+/**
+ * @brief Reorders cache-optimized triangle clusters to reduce overdraw.
+ *
+ * Must run after optimizeVertexCache().
+ *
+ * @param indices Cache-optimized triangle list, reordered in place.
+ * @param vertices Vertex positions used for cluster orientation.
+ * @param cacheSize Cache size used for cluster splitting.
+ * @param threshold Allowed ACMR degradation factor (e.g. 1.05 = 5%).
+ */
+void optimizeOverdraw(std::span<uint32_t> indices,
+                      std::span<const Vertex> vertices,
+                      uint32_t cacheSize = kDefaultCacheSize,
+                      float threshold = 1.05f);
+
+/**
+ * @brief Renumbers vertices in order of first use by the index buffer.
+ *
+ * Unreferenced vertices are dropped.
+ *
+ * @param mesh Mesh whose vertices and indices are rewritten.
+ */
+void optimizeVertexFetch(MeshData &mesh);
+
+/**
+ * @brief Runs the full pipeline (cache, optional overdraw, fetch).
+ *
+ * @param mesh Mesh to optimize in place (bounds are unchanged).
+ * @param options Pass selection and parameters.
+ * @return ACMR/ATVR before and after.
+ */
+Report optimize(MeshData &mesh, const Options &options = {});
+
+} // namespace meshopt
@@ -0,0 +1,121 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <span>
+#include <vector>
+
+#include "MeshData.hpp"
+#include "Vertex.hpp"
+
+/**
+ * @file MeshSimplifier.hpp
+ * @brief Quadric-error edge-collapse simplification and LOD selection.
+ *
+ * The **meshlod** namespace builds a level-of-detail chain for a mesh and
+ * picks the level to draw each frame:
+ * - simplify() performs half-edge collapses (a vertex is merged onto one of
+ *   its neighbours) ordered by quadric error. Because no new vertices are
+ *   created, every LOD indexes the original vertex buffer and all levels fit
+ *   into a single index buffer.
+ * - buildLodChain() appends successively coarser levels to MeshData::indices
+ *   and records their ranges and errors in MeshData::lods.
+ * - selectLod() projects each level's geometric error to pixels using the
+ *   model/view/projection matrices and returns the coarsest acceptable one.
+ *
+ * Border vertices (including UV/attribute seams, which are borders in the
+ * indexed topology) are locked, so silhouettes of open meshes and texture
+ * seams are preserved.
+ *
+ * @code
+ * meshlod::buildLodChain(mesh);
+ * uint32_t lod = meshlod::selectLod(mesh.lods, ubo.model, ubo.view, ubo.proj,
+ *                                   mesh.boundsMin, mesh.boundsMax, 540.0f);
+ * const MeshLod &range = mesh.lods[lod];
+ * @endcode
+ */
+namespace meshlod {
+
+/**
+ * @struct Options
+ * @brief Parameters of buildLodChain().
+ */
+struct Options {
+  size_t levelCount = 5;          ///< Levels including LOD 0
+  float reductionPerLevel = 0.5f; ///< Target triangle ratio between levels
+  float maxError = 0.05f; ///< Per-level error limit (fraction of bbox diagonal)
+  bool optimizeVertexCache = false; ///< Tipsify each generated level
+};
+
+/**
+ * @brief Simplifies a triangle list by quadric-error half-edge collapses.
+ *
+ * @param indices Input triangle list.
+ * @param vertices Vertex array referenced by 'indices'.
+ * @param targetIndexCount Desired index count (3 per triangle).
+ * @param maxError Largest allowed collapse error (model units).
+ * @param resultError Receives the largest collapse error used (may be null).
+ * @return Simplified triangle list indexing the same vertices.
+ */
+std::vector<uint32_t> simplify(std::span<const uint32_t> indices,
+                               std::span<const Vertex> vertices,
+                               size_t targetIndexCount, float maxError,
+                               float *resultError = nullptr);
+
+/**
+ * @brief Builds LOD levels and stores them in the mesh.
+ *
+ * LOD 0 is the current mesh. Generation stops early when a level cannot be
+ * reduced meaningfully within the error limit.
+ *
+ * @param mesh Mesh with computed bounds; 'indices', 'lods' and 'submeshes'
+ * are rewritten (material ranges are simplified separately).
+ * @param options Chain parameters.
+ */
+void buildLodChain(MeshData &mesh, const Options &options = {});
+
+/**
+ * @brief Picks the coarsest LOD whose projected error is below a threshold.
+ *
+ * @param lods Levels ordered from finest to coarsest.
+ * @param model Model matrix.
+ * @param view View matrix.
+ * @param proj Projection matrix (perspective).
+ * @param boundsMin Model-space bounding box minimum.
+ * @param boundsMax Model-space bounding box maximum.
+ * @param viewportHeight Viewport height in pixels.
+ * @param maxPixelError Largest acceptable screen-space error in pixels.
+ * @return Index into 'lods' (0 if 'lods' is empty).
+ */
+uint32_t selectLod(std::span<const MeshLod> lods, const glm::mat4 &model,
+                   const glm::mat4 &view, const glm::mat4 &proj,
+                   glm::vec3 boundsMin, glm::vec3 boundsMax,
+                   float viewportHeight, float maxPixelError = 1.0f);
+
+/**
+ * @brief Screen-space size, in pixels, of one model-space unit at the
+ * bounding sphere's nearest point.
+ *
+ * @return Pixels per model unit (infinity if the camera is inside the
+ * bounding sphere).
+ *
+ * @see selectLod()
+ */
+float pixelsPerUnit(const glm::mat4 &model, const glm::mat4 &view,
+                    const glm::mat4 &proj, glm::vec3 boundsMin,
+                    glm::vec3 boundsMax, float viewportHeight);
+
+/**
+ * @brief Coarsest LOD whose error stays below 'maxPixelError' at a given
+ * scale, for callers that already computed pixelsPerUnit() (e.g. to share
+ * it between LOD and texture mip selection).
+ *
+ * @param lods Levels ordered from finest to coarsest.
+ * @param pixelsPerUnit Result of pixelsPerUnit() for the model.
+ * @param maxPixelError Largest acceptable screen-space error in pixels.
+ * @return Index into 'lods' (0 if 'lods' is empty).
+ */
+uint32_t lodForPixels(std::span<const MeshLod> lods, float pixelsPerUnit,
+                      float maxPixelError = 1.0f);
+
+} // namespace meshlod
@@ -0,0 +1,162 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <span>
+#include <vector>
+
+#include "MeshData.hpp"
+#include "Vertex.hpp"
+
+/**
+ * @file MeshletBuilder.hpp
+ * @brief Meshlet (triangle cluster) generation and cluster culling.
+ *
+ * The **meshlet** namespace splits index ranges into small clusters of at
+ * most kMaxVertices unique vertices and kMaxTriangles triangles. Each meshlet
+ * is a contiguous run of the existing index buffer, so it can be drawn with a
+ * single indexed draw command and no index data is duplicated or reordered.
+ *
+ * Every meshlet carries a bounding sphere and a normal cone. The GPU cull
+ * pass (shaders/cull.comp) tests them against the view frustum and the
+ * camera position and appends a VkDrawIndexedIndirectCommand for every
+ * surviving meshlet; isVisible() is the CPU reference of the same test.
+ *
+ * @note Meshlet, CullParams and CullCounters are shared with the shader and
+ * follow std430 layout; keep them in sync with shaders/cull.comp.
+ *
+ * @code
+ * meshlet::MeshletSet set = meshlet::buildForLods(mesh.indices,
+ *                                                 mesh.vertices, mesh.lods);
+ * meshlet::CullParams params =
+ *     meshlet::makeCullParams(ubo.model, ubo.view, ubo.proj, set.lodRanges[0]);
+ * @endcode
+ */
+namespace meshlet {
+
+/** @brief Largest number of unique vertices referenced by one meshlet. */
+constexpr uint32_t kMaxVertices = 64;
+
+/** @brief Largest number of triangles in one meshlet. */
+constexpr uint32_t kMaxTriangles = 124;
+
+/** @brief Workgroup size of the cull compute shader. */
+constexpr uint32_t kCullGroupSize = 64;
+
+/**
+ * @struct Meshlet
+ * @brief One cluster: its index range plus culling bounds (48 bytes).
+ */
+struct Meshlet {
+  float center[3];      ///< Bounding sphere centre (model space)
+  float radius;         ///< Bounding sphere radius
+  float coneAxis[3];    ///< Average front-facing direction
+  float coneCutoff;     ///< sin of the cone half-angle (1 = never cull)
+  uint32_t indexOffset; ///< First index in the mesh index buffer
+  uint32_t indexCount;  ///< Number of indices (3 per triangle)
+  uint32_t vertexCount; ///< Unique vertices referenced
+  int32_t vertexOffset; ///< Added to each index (0 until uploaded)
+};
+
+/**
+ * @struct MeshletRange
+ * @brief Meshlets belonging to one LOD: [first, first + count).
+ */
+struct MeshletRange {
+  uint32_t first = 0;
+  uint32_t count = 0;
+};
+
+/**
+ * @struct MeshletSet
+ * @brief Meshlets of every LOD plus the per-LOD ranges into them.
+ */
+struct MeshletSet {
+  std::vector<Meshlet> meshlets;
+  std::vector<MeshletRange> lodRanges; ///< One entry per LOD (at least one)
+
+  /** @brief One entry per MeshData::submeshes entry (empty without). */
+  std::vector<MeshletRange> submeshRanges;
+};
+
+/**
+ * @struct CullParams
+ * @brief Push constants of the cull pass (128 bytes, the guaranteed minimum).
+ */
+struct CullParams {
+  glm::vec4 frustum[6];      ///< Model-space planes (xyz normal, w distance)
+  glm::vec4 cameraPosition;  ///< Model-space camera position (w unused)
+  uint32_t firstMeshlet = 0; ///< First meshlet to test
+  uint32_t meshletCount = 0; ///< Number of meshlets to test
+  uint32_t firstDraw = 0;    ///< Draw command slot of the range's first draw
+  uint32_t countSlot = 0;    ///< Entry of CullCounters' per-range draw counts
+};
+
+/**
+ * @struct CullCounters
+ * @brief Counters written by the cull pass.
+ *
+ * In the GPU buffer the struct is followed by one uint32_t draw count per
+ * culled range (CullParams::countSlot); those are the counts consumed by
+ * vkCmdDrawIndexedIndirectCount, 'drawCount' is their sum.
+ */
+struct CullCounters {
+  uint32_t drawCount = 0;        ///< Visible meshlets (= draws emitted)
+  uint32_t visibleTriangles = 0; ///< Triangles in visible meshlets
+  uint32_t culledTriangles = 0;  ///< Triangles in culled meshlets
+  uint32_t culledMeshlets = 0;   ///< Meshlets rejected by the tests
+};
+
+/**
+ * @brief Splits a triangle list into meshlets.
+ *
+ * @param indices Triangle list (one LOD range).
+ * @param vertices Vertex array referenced by 'indices'.
+ * @param indexOffset Position of 'indices' within the full index buffer.
+ * @param maxVertices Unique vertex limit per meshlet.
+ * @param maxTriangles Triangle limit per meshlet.
+ * @return Meshlets covering 'indices' in order.
+ */
+std::vector<Meshlet> build(std::span<const uint32_t> indices,
+                           std::span<const Vertex> vertices,
+                           uint32_t indexOffset = 0,
+                           uint32_t maxVertices = kMaxVertices,
+                           uint32_t maxTriangles = kMaxTriangles);
+
+/**
+ * @brief Builds meshlets for every LOD of a mesh.
+ *
+ * @param indices Full index buffer.
+ * @param vertices Vertex array.
+ * @param lods LOD ranges (empty = all indices are one level).
+ * @param submeshes Material ranges of the LODs (ordered by LOD; empty =
+ * each LOD is one range).
+ * @return Meshlets, one MeshletRange per LOD and one per submesh.
+ */
+MeshletSet buildForLods(std::span<const uint32_t> indices,
+                        std::span<const Vertex> vertices,
+                        std::span<const MeshLod> lods,
+                        std::span<const MeshSubmesh> submeshes = {});
+
+/**
+ * @brief Derives the cull pass parameters from the frame matrices.
+ *
+ * @param model Model matrix.
+ * @param view View matrix.
+ * @param proj Projection matrix with zero-to-one depth.
+ * @param range Meshlets to test (the selected LOD).
+ * @return Normalized model-space frustum planes, camera position and range.
+ */
+CullParams makeCullParams(const glm::mat4 &model, const glm::mat4 &view,
+                          const glm::mat4 &proj, MeshletRange range);
+
+/**
+ * @brief CPU reference of the shader's frustum + normal cone test.
+ *
+ * @param meshlet Meshlet to test.
+ * @param params Planes and camera position from makeCullParams().
+ * @return true if the meshlet may be visible.
+ */
+bool isVisible(const Meshlet &meshlet, const CullParams &params);
+
+} // namespace meshlet
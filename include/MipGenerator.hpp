@@ -0,0 +1,108 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "ThreadPool.hpp"
+
+/**
+ * @file MipGenerator.hpp
+ * @brief Parallel CPU mip-chain generation for RGBA8 sRGB images.
+ *
+ * The **mipgen** namespace builds every mip level of an image on the CPU.
+ * The renderer uses it to fill the texture staging buffer with the whole
+ * chain, so the upload is one multi-region copy instead of a blit and a
+ * barrier per level (and works on formats without linear-blit support);
+ * texbake uses it to get the levels it compresses offline.
+ *
+ * Filtering is a 2x2 box filter in linear space: color channels are decoded
+ * from sRGB before averaging and re-encoded afterwards, alpha is averaged as
+ * is. Rows of each level are split into bands across a ThreadPool, and the
+ * averaging runs four channels at a time with SSE2 or NEON when available.
+ *
+ * @code
+ * std::vector<mipgen::LevelLayout> levels = mipgen::layoutChain(w, h);
+ * std::memcpy(staging + levels[0].offset, pixels, levels[0].size);
+ * mipgen::generateChain(staging, levels);
+ * @endcode
+ */
+namespace mipgen {
+
+/** @brief Alignment (bytes) of each level inside a packed chain. */
+constexpr size_t kLevelAlignment = 16;
+
+/**
+ * @struct MipLevel
+ * @brief One level of a mip chain (tightly packed RGBA8 rows).
+ */
+struct MipLevel {
+  uint32_t width = 0;
+  uint32_t height = 0;
+  std::vector<uint8_t> rgba;
+};
+
+/**
+ * @struct LevelLayout
+ * @brief Placement of one level inside a packed chain buffer.
+ */
+struct LevelLayout {
+  uint32_t width = 0;
+  uint32_t height = 0;
+  size_t offset = 0; ///< Byte offset from the start of the chain
+  size_t size = 0;   ///< width * height * 4
+};
+
+/**
+ * @brief Number of levels in a full chain down to 1x1.
+ *
+ * @param width Level 0 width.
+ * @param height Level 0 height.
+ * @return floor(log2(max(width, height))) + 1.
+ */
+uint32_t levelCount(uint32_t width, uint32_t height);
+
+/**
+ * @brief Packs a full chain into one buffer, largest level first.
+ *
+ * @param width Level 0 width.
+ * @param height Level 0 height.
+ * @return One entry per level; the chain occupies
+ * back().offset + back().size bytes.
+ */
+std::vector<LevelLayout> layoutChain(uint32_t width, uint32_t height);
+
+/**
+ * @brief Fills levels 1..n of a packed chain from level 0.
+ *
+ * @param chain Buffer laid out by 'levels', with level 0 already written.
+ * @param levels Result of layoutChain().
+ * @param pool Pool the row bands of each level are distributed over.
+ */
+void generateChain(uint8_t *chain, std::span<const LevelLayout> levels,
+                   ThreadPool &pool = ThreadPool::global());
+
+/**
+ * @brief Builds a full mip chain, including a copy of level 0.
+ *
+ * @param rgba Level 0 pixels (width * height * 4 bytes).
+ * @param width Level 0 width.
+ * @param height Level 0 height.
+ * @param pool Pool passed to generateChain().
+ * @return levelCount(width, height) levels, largest first.
+ */
+std::vector<MipLevel> buildChain(std::span<const uint8_t> rgba, uint32_t width,
+                                 uint32_t height,
+                                 ThreadPool &pool = ThreadPool::global());
+
+/**
+ * @brief Single-threaded scalar reference of one generateChain() step.
+ *
+ * Odd dimensions are handled by clamping the 2x2 footprint to the edge.
+ *
+ * @param source Source level.
+ * @return Level of size max(1, width / 2) x max(1, height / 2).
+ */
+MipLevel downsample(const MipLevel &source);
+
+} // namespace mipgen
@@ -0,0 +1,92 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "ThreadPool.hpp"
+
+/**
+ * @file ObjParser.hpp
+ * @brief Multi-threaded Wavefront OBJ reader producing structure-of-arrays.
+ *
+ * The **objparser** namespace parses 'v', 'vt', 'vn' and 'f' records of an
+ * OBJ file in parallel. The text is split into line-aligned chunks which are
+ * parsed concurrently into per-chunk arrays; prefix sums over the per-chunk
+ * counts then give every chunk its output offsets, so stitching is a second
+ * parallel pass with no locking.
+ *
+ * Numbers are parsed with the same algorithm as TinyOBJLoader and faces are
+ * triangulated with the same rules (quads are split along their shorter
+ * diagonal), so the result matches the previous tinyobj-based loader bit for
+ * bit on triangle and quad meshes. Polygons with more than four corners are
+ * fan-triangulated.
+ *
+ * 'usemtl' assigns a material to the faces that follow it, across chunk
+ * boundaries, and 'mtllib' names are collected so the caller can read the
+ * libraries with parseMtl(). Other records ('o', 'g', 's', comments, ...)
+ * are ignored.
+ *
+ * @see meshloader::loadObjParallel()
+ */
+namespace objparser {
+
+/**
+ * @struct ObjData
+ * @brief Parsed OBJ attributes and triangulated, 0-based corner indices.
+ *
+ * Corner arrays are parallel: triangle 't' uses corners 3t, 3t+1 and 3t+2.
+ * A missing texture coordinate or normal reference is stored as -1.
+ */
+struct ObjData {
+  std::vector<float> positions; ///< x, y, z per 'v' record
+  std::vector<float> texcoords; ///< u, v per 'vt' record
+  std::vector<float> normals;   ///< x, y, z per 'vn' record
+
+  std::vector<int32_t> positionIndices; ///< Position index per corner
+  std::vector<int32_t> texcoordIndices; ///< Texcoord index per corner (or -1)
+  std::vector<int32_t> normalIndices;   ///< Normal index per corner (or -1)
+
+  std::vector<std::string> materialLibraries; ///< 'mtllib' files, in order
+  std::vector<std::string> materialNames;     ///< 'usemtl' names, first use
+
+  /**
+   * @brief Index into 'materialNames' per triangle, -1 before the first
+   * 'usemtl'. Empty when the file has no 'usemtl' record.
+   */
+  std::vector<int32_t> triangleMaterials;
+
+  /** @brief Number of triangulated corners (3 per triangle). */
+  size_t cornerCount() const { return positionIndices.size(); }
+};
+
+/**
+ * @brief Parses OBJ text in parallel.
+ *
+ * @param text Complete OBJ file contents (need not be null-terminated).
+ * @param pool Worker pool used for the chunk and stitch passes.
+ * @return Parsed attributes and triangulated corners.
+ * @throws std::runtime_error On malformed records or out-of-range indices.
+ */
+ObjData parse(std::span<const std::byte> text, ThreadPool &pool);
+
+/**
+ * @struct MtlMaterial
+ * @brief The parts of an MTL 'newmtl' block the renderer uses.
+ */
+struct MtlMaterial {
+  std::string name;                      ///< 'newmtl' name
+  float diffuse[3] = {0.0f, 0.0f, 0.0f}; ///< Kd (0 if absent, like tinyobj)
+  std::string diffuseTexture;            ///< map_Kd file (options dropped)
+};
+
+/**
+ * @brief Parses a Wavefront material library (serially; MTL files are tiny).
+ *
+ * @param text Complete MTL file contents.
+ * @return Materials in declaration order.
+ */
+std::vector<MtlMaterial> parseMtl(std::span<const std::byte> text);
+
+} // namespace objparser
@@ -0,0 +1,84 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * @file RetireQueue.hpp
+ * @brief Deferred destruction of objects still used by frames in flight.
+ *
+ * A resource replaced while earlier frames are still executing (a pipeline,
+ * an image, a buffer) cannot be destroyed right away, and waiting for the
+ * device to go idle stalls every frame in flight. The **RetireQueue** takes
+ * ownership of the old objects together with the number of the last frame
+ * that may use them, and destroys them once that frame has completed.
+ *
+ * @code
+ * retireQueue.retire(frameNumber, std::move(pipeline));
+ * pipeline = std::move(newPipeline);
+ *
+ * // Every frame, after the fence wait
+ * retireQueue.collect(completedFrame);
+ * @endcode
+ *
+ * Objects of one retire() call are destroyed in argument order, so views
+ * can be passed before their images and images before their memory.
+ */
+class RetireQueue {
+public:
+  /**
+   * @brief Takes ownership of objects until 'lastUse' has completed.
+   *
+   * @param lastUse Last frame that may reference the objects; must not be
+   * smaller than that of the previous call.
+   * @param objects Objects to destroy later (moved from).
+   */
+  template <typename... T> void retire(uint64_t lastUse, T &&...objects) {
+    static_assert((!std::is_lvalue_reference_v<T> && ...),
+                  "retire() takes ownership: pass std::move(object)");
+    Entry entry;
+    entry.lastUse = lastUse;
+    entry.objects.reserve(sizeof...(T));
+    (entry.objects.push_back(
+         std::make_shared<std::decay_t<T>>(std::forward<T>(objects))),
+     ...);
+    entries.push_back(std::move(entry));
+  }
+
+  /**
+   * @brief Destroys every entry whose last frame has completed.
+   *
+   * @param completedFrame Newest frame known to have finished on the GPU.
+   * @return Number of entries destroyed.
+   */
+  size_t collect(uint64_t completedFrame);
+
+  /** @brief Destroys every entry (the device must be idle). */
+  void clear();
+
+  /** @brief Entries waiting for their frame. */
+  size_t size() const { return entries.size(); }
+
+  /** @brief True when nothing is waiting. */
+  bool empty() const { return entries.empty(); }
+
+private:
+  /**
+   * @struct Entry
+   * @brief Objects of one retire() call.
+   */
+  struct Entry {
+    uint64_t lastUse = 0;                       ///< Last frame using them
+    std::vector<std::shared_ptr<void>> objects; ///< Type-erased owners
+  };
+
+  /** @brief Destroys an entry's objects in the order they were passed. */
+  static void release(Entry &entry);
+
+  /** @brief Entries ordered by 'lastUse'. */
+  std::deque<Entry> entries;
+};
@@ -0,0 +1,196 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "MeshData.hpp"
+
+/**
+ * @file Scene.hpp
+ * @brief Scene description: meshes plus a flat SoA store of their instances.
+ *
+ * The **scene** namespace loads and saves JSON scene files and turns the
+ * instances into per-frame draw input. A scene file lists the meshes and
+ * every instance of them:
+ * @code
+ * {
+ *   "meshes": [
+ *     { "model": "models/statue.obj", "texture": "textures/statue.png" }
+ *   ],
+ *   "instances": [
+ *     { "mesh": 0, "position": [0, 0, 0], "rotation": [0, 0, 0, 1],
+ *       "scale": 1.5 }
+ *   ]
+ * }
+ * @endcode
+ * 'rotation' is a unit quaternion in glTF order (x, y, z, w) and 'scale' a
+ * number or an [x, y, z] array; 'mesh', 'rotation' and 'scale' are optional
+ * (0, identity, 1).
+ *
+ * Instances are stored as parallel arrays (InstanceStore), so per-frame
+ * passes over tens of thousands of them touch only the fields they read.
+ * batchInstances() culls the instances of one mesh against the view
+ * frustum, picks each one's LOD and writes their matrices grouped by LOD,
+ * ready for one instanced draw per LOD.
+ *
+ * @code
+ * scene::Scene scene = scene::load("scenes/scene_10k.json");
+ * std::vector<glm::mat4> worlds(scene.instances.size());
+ * scene::computeMatrices(scene.instances, worlds);
+ * scene::batchInstances(worlds, scene.instances.meshIds, params,
+ *                       mappedInstanceBuffer, batches);
+ * @endcode
+ */
+namespace scene {
+
+/**
+ * @struct MeshAsset
+ * @brief A mesh referenced by instances.
+ */
+struct MeshAsset {
+  std::string model;   ///< OBJ path
+  std::string texture; ///< Diffuse texture (empty = the model's materials)
+};
+
+/**
+ * @struct InstanceStore
+ * @brief Instance transforms and meshes as parallel arrays (SoA); entry i of
+ * every array belongs to instance i.
+ */
+struct InstanceStore {
+  std::vector<glm::vec3> positions; ///< World-space translation
+  std::vector<glm::quat> rotations; ///< Unit quaternions
+  std::vector<glm::vec3> scales;    ///< Per-axis scale
+  std::vector<uint32_t> meshIds;    ///< Index into Scene::meshes
+
+  /** @brief Number of instances. */
+  size_t size() const { return meshIds.size(); }
+
+  /** @brief True when there are no instances. */
+  bool empty() const { return meshIds.empty(); }
+
+  /** @brief Reserves room in every array. */
+  void reserve(size_t count);
+
+  /** @brief Appends one instance. */
+  void add(glm::vec3 position, glm::quat rotation, glm::vec3 scale,
+           uint32_t meshId);
+
+  /** @brief Removes every instance. */
+  void clear();
+};
+
+/**
+ * @struct Scene
+ * @brief Meshes and their instances.
+ */
+struct Scene {
+  std::vector<MeshAsset> meshes; ///< Referenced by InstanceStore::meshIds
+  InstanceStore instances;       ///< Every instance of every mesh
+};
+
+/**
+ * @struct BatchParams
+ * @brief Inputs of batchInstances() that are shared by all instances.
+ */
+struct BatchParams {
+  uint32_t meshId = 0;           ///< Instances of this mesh are batched
+  glm::mat4 local{1.0f};         ///< Applied before each world matrix
+  glm::mat4 view{1.0f};          ///< Camera view matrix
+  glm::mat4 proj{1.0f};          ///< Perspective projection (Vulkan)
+  glm::vec3 boundsMin{0.0f};     ///< Mesh bounding box minimum
+  glm::vec3 boundsMax{0.0f};     ///< Mesh bounding box maximum
+  std::span<const MeshLod> lods; ///< Mesh LODs (empty = LOD 0 only)
+  float viewportHeight = 1.0f;   ///< Viewport height in pixels
+  float maxPixelError = 1.0f;    ///< LOD screen-space error limit
+};
+
+/**
+ * @struct InstanceBatches
+ * @brief Result of batchInstances(): visible instances grouped by LOD.
+ */
+struct InstanceBatches {
+  std::vector<uint32_t> lodFirst; ///< First output matrix of each LOD
+  std::vector<uint32_t> lodCount; ///< Visible instances of each LOD
+  uint32_t visible = 0;           ///< Instances written
+  uint32_t culled = 0;            ///< Instances outside the frustum
+  float maxPixelsPerUnit = 0.0f;  ///< Largest on-screen scale (texture mip)
+  std::vector<uint32_t> lodOf;    ///< Scratch: LOD per instance
+};
+
+/**
+ * @brief Reads a scene file.
+ *
+ * @param path JSON scene file.
+ * @return Meshes and instances; mesh references are validated.
+ * @throws std::runtime_error if the file cannot be read or is malformed.
+ */
+Scene load(const std::string &path);
+
+/**
+ * @brief Writes a scene file readable by load().
+ *
+ * @throws std::runtime_error if the file cannot be written.
+ */
+void save(const std::string &path, const Scene &scene);
+
+/**
+ * @brief Scene with one untransformed instance of one mesh.
+ */
+Scene single(const MeshAsset &mesh);
+
+/**
+ * @brief Generates a synthetic scene: 'instanceCount' instances on a square
+ * grid in the XY plane centred on the origin (Z up), each with a random
+ * jitter, yaw and uniform scale, assigned to the meshes round-robin.
+ *
+ * @param meshes Meshes to instance (at least one).
+ * @param instanceCount Number of instances.
+ * @param spacing Distance between grid cells (model units).
+ * @param seed Random seed; equal seeds give equal scenes.
+ */
+Scene generate(std::vector<MeshAsset> meshes, size_t instanceCount,
+               float spacing = 2.0f, uint32_t seed = 1);
+
+/**
+ * @brief Computes the world matrix (translation * rotation * scale) of
+ * every instance.
+ *
+ * @param instances Instance store.
+ * @param worlds Output, one matrix per instance.
+ */
+void computeMatrices(const InstanceStore &instances,
+                     std::span<glm::mat4> worlds);
+
+/**
+ * @brief Radius of a sphere around the origin containing every instance of
+ * a mesh with the given bounding box.
+ */
+float boundingRadius(const InstanceStore &instances, glm::vec3 boundsMin,
+                     glm::vec3 boundsMax);
+
+/**
+ * @brief Culls, LOD-selects and sorts the instances of one mesh.
+ *
+ * Each instance of 'params.meshId' whose bounding sphere intersects the
+ * view frustum gets the coarsest LOD within 'params.maxPixelError'. Their
+ * model matrices (world * params.local) are written to 'out' grouped by
+ * LOD, finest first, in instance order within a LOD.
+ *
+ * @param worlds World matrices from computeMatrices().
+ * @param meshIds InstanceStore::meshIds.
+ * @param params View, mesh bounds and LODs.
+ * @param out Output matrices (room for every instance of the mesh).
+ * @param batches Receives the per-LOD ranges of 'out'; its vectors are
+ * reused between calls.
+ */
+void batchInstances(std::span<const glm::mat4> worlds,
+                    std::span<const uint32_t> meshIds,
+                    const BatchParams &params, std::span<glm::mat4> out,
+                    InstanceBatches &batches);
+
+} // namespace scene
@@ -0,0 +1,149 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <vector>
+#include <vulkan/vulkan_raii.hpp>
+
+#include "GpuAllocator.hpp"
+
+/**
+ * @file StagingPool.hpp
+ * @brief Recycled sub-ranges of a few large, persistently mapped staging
+ *        buffers.
+ *
+ * Creating a staging buffer per upload costs a vkCreateBuffer, a memory
+ * allocation and a vkDestroyBuffer, and forces the upload to finish before
+ * its source can be destroyed. The **StagingPool** instead owns a few
+ * host-visible transfer-source buffers (chunks) that stay mapped for their
+ * lifetime and bump-allocates upload sources inside them.
+ *
+ * A range is released only once the submission that reads it has
+ * completed: UploadQueue releases a batch's ranges when collect() finds its
+ * timeline value signaled, and LoadBatch once its submission has been
+ * waited for. A chunk starts over as soon as all of its ranges are released.
+ * Requests larger than a chunk get a chunk of their own, destroyed once
+ * idle.
+ *
+ * @code
+ * const StagingPool::Range range = pool.upload(bytes);
+ * uploadQueue.copy(range, dst, 0, stages, access); // Released when done
+ *
+ * // Once per frame
+ * pool.collect();
+ * @endcode
+ *
+ * The pool is thread safe; the allocator and device must outlive it.
+ */
+class StagingPool {
+  struct Chunk;
+
+public:
+  /** @brief Default chunk size. */
+  static constexpr vk::DeviceSize kChunkSize = 32ull << 20;
+
+  /**
+   * @brief Default range alignment: a multiple of every texel block size
+   * and of the 4 bytes buffer copies require.
+   */
+  static constexpr vk::DeviceSize kAlignment = 16;
+
+  /** @brief Idle chunks of the default size kept for later uploads. */
+  static constexpr size_t kRetainedChunks = 4;
+
+  /**
+   * @struct Range
+   * @brief A sub-range of a staging buffer.
+   */
+  struct Range {
+    vk::Buffer buffer;         ///< Buffer to copy from
+    vk::DeviceSize offset = 0; ///< Start of the range in 'buffer'
+    vk::DeviceSize size = 0;   ///< Requested size
+    void *data = nullptr;      ///< Mapped pointer to the range
+    Chunk *chunk = nullptr;    ///< Owning chunk (null: not from a pool)
+
+    /** @brief True when the range holds memory. */
+    explicit operator bool() const { return static_cast<bool>(buffer); }
+  };
+
+  /**
+   * @struct Stats
+   * @brief Snapshot of the pool's chunks and ranges.
+   */
+  struct Stats {
+    size_t chunkCount = 0;         ///< Chunks held
+    vk::DeviceSize chunkBytes = 0; ///< Size of all chunks
+    vk::DeviceSize usedBytes = 0;  ///< Bytes bumped since their rewind
+    size_t liveRanges = 0;         ///< Ranges not yet released
+    uint64_t chunksCreated = 0;    ///< Chunks created so far
+    uint64_t rangesAllocated = 0;  ///< Ranges handed out so far
+  };
+
+  /**
+   * @brief Creates an empty pool; chunks are created on demand.
+   *
+   * @param logicalDevice Device the buffers are created on.
+   * @param gpuAllocator Allocator of the chunks' memory.
+   * @param chunkBytes Size of a chunk.
+   */
+  StagingPool(const vk::raii::Device &logicalDevice,
+              GpuAllocator &gpuAllocator,
+              vk::DeviceSize chunkBytes = kChunkSize);
+
+  ~StagingPool();
+
+  StagingPool(const StagingPool &) = delete;
+  StagingPool &operator=(const StagingPool &) = delete;
+
+  /**
+   * @brief Allocates a mapped range of 'size' bytes.
+   *
+   * @param alignment Power of two the offset is a multiple of.
+   */
+  Range allocate(vk::DeviceSize size, vk::DeviceSize alignment = kAlignment);
+
+  /** @brief Allocates a range and copies 'bytes' into it. */
+  Range upload(std::span<const std::byte> bytes,
+               vk::DeviceSize alignment = kAlignment);
+
+  /**
+   * @brief Returns a range once every submission reading it has completed.
+   *
+   * @param range Range from allocate() (ranges without a chunk are
+   * ignored).
+   */
+  void release(const Range &range);
+
+  /** @brief Destroys idle chunks beyond kRetainedChunks. */
+  void collect();
+
+  /** @brief Current chunk and range statistics. */
+  Stats stats() const;
+
+private:
+  /** @brief Creates a chunk of 'size' bytes. */
+  Chunk &createChunk(vk::DeviceSize size);
+
+  /** @brief Device of the buffers. */
+  const vk::raii::Device &device;
+
+  /** @brief Memory of the buffers. */
+  GpuAllocator &allocator;
+
+  /** @brief Size of a regular chunk. */
+  vk::DeviceSize chunkSize = kChunkSize;
+
+  /** @brief Every chunk, oldest first. */
+  std::vector<std::unique_ptr<Chunk>> chunks;
+
+  /** @brief Chunks created so far. */
+  uint64_t chunksCreated = 0;
+
+  /** @brief Ranges handed out so far. */
+  uint64_t rangesAllocated = 0;
+
+  /** @brief Guards all of the above. */
+  mutable std::mutex mutex;
+};
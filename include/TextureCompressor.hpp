@@ -0,0 +1,110 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "ThreadPool.hpp"
+
+/**
+ * @file TextureCompressor.hpp
+ * @brief CPU block compression of RGBA8 images to BC1 and BC7.
+ *
+ * The **bcn** namespace encodes 4x4 texel blocks into the GPU block formats
+ * sampled natively by desktop hardware ('textureCompressionBC'). It is used
+ * offline by texbake, so encoding speed matters less than quality, but the
+ * block rows are still spread across a ThreadPool.
+ *
+ * - BC1: 8 bytes per block (4 bpp), opaque RGB, two RGB565 endpoints.
+ * - BC7: 16 bytes per block (8 bpp), RGBA; only mode 6 (one subset, 7-bit
+ *   endpoints plus p-bits, 4-bit indices) is produced, which covers smooth
+ *   photographic content well at a fraction of a full mode search.
+ *
+ * Texel data is treated as opaque bytes, so sRGB images stay sRGB and must be
+ * uploaded as the *_SRGB_BLOCK formats.
+ *
+ * @code
+ * std::vector<uint8_t> blocks = bcn::compress(rgba, width, height,
+ *                                             bcn::Codec::eBC7);
+ * @endcode
+ */
+namespace bcn {
+
+/** @brief Supported block encodings. */
+enum class Codec : uint32_t { eBC1, eBC7 };
+
+/** @brief Bytes per 4x4 block for a codec. */
+constexpr size_t blockBytes(Codec codec) {
+  return codec == Codec::eBC1 ? 8 : 16;
+}
+
+/** @brief Total compressed size of a width x height image. */
+constexpr size_t compressedSize(Codec codec, uint32_t width, uint32_t height) {
+  return static_cast<size_t>((width + 3) / 4) * ((height + 3) / 4) *
+         blockBytes(codec);
+}
+
+/**
+ * @brief Encodes one 4x4 block as BC1 (opaque, four-color mode).
+ *
+ * @param texels 16 RGBA8 texels in row-major order (64 bytes).
+ * @param out 8-byte destination block.
+ */
+void encodeBC1(const uint8_t *texels, uint8_t *out);
+
+/**
+ * @brief Encodes one 4x4 block as BC7 mode 6.
+ *
+ * @param texels 16 RGBA8 texels in row-major order (64 bytes).
+ * @param out 16-byte destination block.
+ */
+void encodeBC7(const uint8_t *texels, uint8_t *out);
+
+/**
+ * @brief Decodes one BC1 block.
+ *
+ * @param block 8-byte source block.
+ * @param texels 16 RGBA8 texels in row-major order (64 bytes).
+ */
+void decodeBC1(const uint8_t *block, uint8_t *texels);
+
+/**
+ * @brief Decodes one BC7 mode 6 block.
+ *
+ * Blocks in other modes (never produced by encodeBC7()) decode to opaque
+ * magenta so they stand out.
+ *
+ * @param block 16-byte source block.
+ * @param texels 16 RGBA8 texels in row-major order (64 bytes).
+ */
+void decodeBC7(const uint8_t *block, uint8_t *texels);
+
+/**
+ * @brief Compresses a full image, in parallel over rows of blocks.
+ *
+ * Partial blocks at the right/bottom edge replicate the last column/row.
+ *
+ * @param rgba Tightly packed RGBA8 texels (width * height * 4 bytes).
+ * @param width Image width in texels.
+ * @param height Image height in texels.
+ * @param codec Output block format.
+ * @param pool Pool the block rows are distributed over.
+ * @return compressedSize(codec, width, height) bytes of blocks, row-major.
+ */
+std::vector<uint8_t> compress(std::span<const uint8_t> rgba, uint32_t width,
+                              uint32_t height, Codec codec,
+                              ThreadPool &pool = ThreadPool::global());
+
+/**
+ * @brief Decompresses an image produced by compress().
+ *
+ * @param blocks Compressed blocks.
+ * @param width Image width in texels.
+ * @param height Image height in texels.
+ * @param codec Block format of 'blocks'.
+ * @return Tightly packed RGBA8 texels.
+ */
+std::vector<uint8_t> decompress(std::span<const uint8_t> blocks,
+                                uint32_t width, uint32_t height, Codec codec);
+
+} // namespace bcn
@@ -0,0 +1,164 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "MappedFile.hpp"
+
+/**
+ * @file TextureFile.hpp
+ * @brief Baked texture container holding every mip level, ready to upload.
+ *
+ * The **artx** namespace reads and writes the files produced by the texbake
+ * tool: a full mip chain that is either block-compressed (BC1/BC7) or raw
+ * RGBA8, all sRGB. At runtime the file is memory mapped and each level is
+ * copied straight into the staging buffer, so neither image decoding nor
+ * mip generation happens at load time.
+ *
+ * File layout (offsets relative to the start of the file):
+ * @code
+ * [Header][LevelInfo x mipCount][pad to 16][level 0][pad to 16][level 1]...
+ * @endcode
+ *
+ * Staleness checks against the source image follow meshcache: size, then
+ * modification time, then content hash; a missing source is trusted.
+ *
+ * @see meshcache::stampFile
+ */
+namespace artx {
+
+/** @brief Magic bytes identifying a baked texture. */
+constexpr char kMagic[4] = {'A', 'R', 'T', 'X'};
+
+/** @brief Current format version; bump on any layout change. */
+constexpr uint32_t kVersion = 1;
+
+/** @brief Alignment (bytes) of each level's data, a multiple of any block. */
+constexpr uint64_t kLevelAlignment = 16;
+
+/** @brief Texel encoding of every level (all sRGB). */
+enum class Format : uint32_t { eRGBA8 = 0, eBC1 = 1, eBC7 = 2 };
+
+/**
+ * @struct Header
+ * @brief Fixed-size header at the start of every baked texture.
+ */
+struct Header {
+  char magic[4];       ///< Always kMagic
+  uint32_t version;    ///< Format version (kVersion)
+  Format format;       ///< Encoding of all levels
+  uint32_t width;      ///< Level 0 width in texels
+  uint32_t height;     ///< Level 0 height in texels
+  uint32_t mipCount;   ///< Number of LevelInfo records
+  uint64_t sourceSize; ///< Size of the source image in bytes
+  int64_t sourceMtime; ///< Source modification time (filesystem clock)
+  uint64_t sourceHash; ///< meshcache::hashBytes() of the source contents
+};
+
+/**
+ * @struct LevelInfo
+ * @brief Location and size of one mip level inside the file.
+ */
+struct LevelInfo {
+  uint64_t offset; ///< Byte offset of the level data
+  uint64_t size;   ///< Byte size of the level data
+  uint32_t width;  ///< Level width in texels
+  uint32_t height; ///< Level height in texels
+};
+
+/**
+ * @struct Level
+ * @brief One encoded level handed to write().
+ */
+struct Level {
+  uint32_t width = 0;
+  uint32_t height = 0;
+  std::vector<uint8_t> data;
+};
+
+/** @brief Human-readable name of a format ("BC7", ...). */
+const char *name(Format format);
+
+/**
+ * @class TextureFile
+ * @brief A validated, memory-mapped baked texture.
+ *
+ * Instances created with fromBytes() view memory they do not own, such as
+ * an asset pack blob, which must outlive them.
+ */
+class TextureFile {
+public:
+  /**
+   * @brief Opens and validates a baked texture for a given source image.
+   *
+   * @param path Path of the .artx file.
+   * @param sourcePath Image the file was baked from.
+   * @return The mapped file, or std::nullopt if it is missing, corrupt or
+   * stale.
+   */
+  static std::optional<TextureFile> open(const std::string &path,
+                                         const std::string &sourcePath);
+
+  /**
+   * @brief Validates baked texture contents that are already in memory.
+   *
+   * @param bytes File contents (e.g. an asset pack blob); not copied.
+   * @param sourcePath Image the file was baked from.
+   * @return A view of 'bytes', or std::nullopt under the same conditions as
+   * open().
+   */
+  static std::optional<TextureFile> fromBytes(std::span<const std::byte> bytes,
+                                              const std::string &sourcePath);
+
+  /** @brief Whole file contents, viewed in place. */
+  std::span<const std::byte> bytes() const { return contents; }
+
+  /** @brief Encoding of all levels. */
+  Format format() const { return header().format; }
+
+  /** @brief Level 0 width in texels. */
+  uint32_t width() const { return header().width; }
+
+  /** @brief Level 0 height in texels. */
+  uint32_t height() const { return header().height; }
+
+  /** @brief Level table, largest level first. */
+  std::span<const LevelInfo> levels() const;
+
+  /** @brief Encoded bytes of one level, viewed in place. */
+  std::span<const std::byte> levelData(uint32_t level) const;
+
+private:
+  explicit TextureFile(std::span<const std::byte> bytes) : contents(bytes) {}
+
+  /** @brief Header at the start of the contents. */
+  const Header &header() const {
+    return *reinterpret_cast<const Header *>(contents.data());
+  }
+
+  /** @brief Mapping that backs all returned spans (empty for views). */
+  MappedFile file;
+
+  /** @brief File contents, inside 'file' or borrowed. */
+  std::span<const std::byte> contents;
+};
+
+/**
+ * @brief Writes a baked texture for a source image.
+ *
+ * Written to a temporary path and renamed into place, like meshcache::write.
+ *
+ * @param path Destination path of the .artx file.
+ * @param sourcePath Source image whose size/mtime/hash are recorded.
+ * @param format Encoding of 'levels'.
+ * @param levels Mip chain, largest first.
+ * @throws std::runtime_error If the file cannot be written.
+ */
+void write(const std::string &path, const std::string &sourcePath,
+           Format format, std::span<const Level> levels);
+
+} // namespace artx
@@ -0,0 +1,120 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+/**
+ * @file TextureStreaming.hpp
+ * @brief Mip residency policy for progressively streamed textures.
+ *
+ * The **texstream** namespace decides, per texture and per frame, which mip
+ * levels should be resident on the GPU. It holds no Vulkan state: the
+ * renderer keeps an image that contains exactly the resident levels
+ * (residentMip .. mipCount - 1), asks nextStep() what to do, and performs
+ * the upload or eviction itself.
+ *
+ * - Start-up: only the small tail of the chain (initialMip()) is uploaded,
+ *   so the texture is drawable almost immediately.
+ * - Stream in: while the desired level (from screen coverage, see
+ *   desiredMip()) is finer than the resident one, the next finer level is
+ *   read from disk in the background and added, one level per step.
+ * - Evict: levels finer than the budget allows, or well beyond what the
+ *   current footprint needs, are dropped.
+ *
+ * @code
+ * texstream::Step step = texstream::nextStep(residency, levels, budget);
+ * @endcode
+ */
+namespace texstream {
+
+/**
+ * @struct Level
+ * @brief Encoded data of one mip level, as it will be copied to the GPU.
+ */
+struct Level {
+  uint32_t width = 0;
+  uint32_t height = 0;
+  std::span<const std::byte> data;
+};
+
+/**
+ * @struct Residency
+ * @brief Streaming state of one texture.
+ */
+struct Residency {
+  uint32_t mipCount = 0;      ///< Levels in the full chain
+  uint32_t residentMip = 0;   ///< Finest level in the GPU image
+  uint32_t desiredMip = 0;    ///< Finest level the footprint needs
+  uint64_t residentBytes = 0; ///< Bytes of levels residentMip .. mipCount - 1
+};
+
+/** @brief What the renderer should do next for one texture. */
+enum class Action { eNone, eStreamIn, eEvict };
+
+/**
+ * @struct Step
+ * @brief Action plus the residentMip it leads to.
+ */
+struct Step {
+  Action action = Action::eNone;
+  uint32_t mip = 0;
+};
+
+/**
+ * @brief Levels more than this many steps finer than desired are evicted
+ * even within budget (hysteresis against zoom in/out thrashing).
+ */
+constexpr uint32_t kEvictionSlack = 2;
+
+/**
+ * @brief Total bytes of levels firstMip .. levels.size() - 1.
+ */
+uint64_t chainBytes(std::span<const Level> levels, uint32_t firstMip);
+
+/**
+ * @brief First level no larger than 'maxSize' texels on either axis.
+ *
+ * @param levels Full chain, largest first.
+ * @param maxSize Largest dimension uploaded before any streaming.
+ * @return Initial residentMip.
+ */
+uint32_t initialMip(std::span<const Level> levels, uint32_t maxSize);
+
+/**
+ * @brief Finest level whose chain fits in a byte budget (the last level is
+ * always allowed).
+ */
+uint32_t budgetMip(std::span<const Level> levels, uint64_t budgetBytes);
+
+/**
+ * @brief Finest level worth sampling for a given screen coverage.
+ *
+ * Assumes the texture is mapped once across the object, so one texel per
+ * pixel is reached at the level whose size matches the object's projected
+ * size; every halving of the coverage drops one level.
+ *
+ * @param width Level 0 width.
+ * @param height Level 0 height.
+ * @param coveragePixels Projected size of the textured object in pixels.
+ * @param mipCount Levels in the chain.
+ * @return Desired mip in [0, mipCount - 1].
+ */
+uint32_t desiredMip(uint32_t width, uint32_t height, float coveragePixels,
+                    uint32_t mipCount);
+
+/**
+ * @brief Picks the next residency change for a texture.
+ *
+ * Over budget evicts down to the budget level; otherwise a level is
+ * streamed in when the desired one is finer than the resident one, and
+ * levels beyond kEvictionSlack of the desired one are evicted.
+ *
+ * @param residency Current state (residentMip, desiredMip).
+ * @param levels Full chain, largest first.
+ * @param budgetBytes Bytes this texture may keep resident.
+ * @return Step to perform, eNone when residency matches the target.
+ */
+Step nextStep(const Residency &residency, std::span<const Level> levels,
+              uint64_t budgetBytes);
+
+} // namespace texstream
@@ -0,0 +1,106 @@
+#pragma once
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @file ThreadPool.hpp
+ * @brief Fixed-size worker pool used for CPU-side asset processing.
+ *
+ * The **ThreadPool** runs fire-and-forget tasks ('submit') and data-parallel
+ * loops ('parallelFor'). It is used by the mesh and texture pipelines to
+ * spread parsing, deduplication and encoding work across all cores.
+ *
+ * @note 'parallelFor' may safely be called from inside a pool task: the
+ * calling thread always participates and never waits on queued-but-unstarted
+ * tasks, so nested use cannot deadlock (it only loses parallelism).
+ *
+ * @code
+ * ThreadPool &pool = ThreadPool::global();
+ * pool.parallelFor(chunks.size(), [&](size_t i) { parseChunk(chunks[i]); });
+ * auto future = pool.submit([] { return decodeImage(); });
+ * @endcode
+ */
+class ThreadPool {
+public:
+  /**
+   * @brief Starts a pool with a fixed number of workers.
+   *
+   * @param threadCount Number of worker threads; 0 selects
+   * std::thread::hardware_concurrency().
+   */
+  explicit ThreadPool(size_t threadCount = 0);
+
+  /** @brief Finishes all queued tasks and joins the workers. */
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
+  /** @brief Number of worker threads. */
+  size_t size() const { return workers.size(); }
+
+  /**
+   * @brief Queues a task and returns a future for its result.
+   *
+   * @param task Callable with no arguments.
+   * @return std::future holding the task's return value (or exception).
+   */
+  template <typename F>
+  auto submit(F &&task) -> std::future<std::invoke_result_t<std::decay_t<F>>> {
+    using Result = std::invoke_result_t<std::decay_t<F>>;
+    auto packaged =
+        std::make_shared<std::packaged_task<Result()>>(std::forward<F>(task));
+    std::future<Result> future = packaged->get_future();
+    enqueue([packaged]() { (*packaged)(); });
+    return future;
+  }
+
+  /**
+   * @brief Runs 'body(i)' for every i in [0, count) and waits for completion.
+   *
+   * Iterations are handed out dynamically, so uneven iteration costs are
+   * load-balanced. The first exception thrown by 'body' is rethrown on the
+   * calling thread after all started iterations finish.
+   *
+   * @param count Number of iterations.
+   * @param body Callable invoked once per iteration index.
+   */
+  void parallelFor(size_t count, const std::function<void(size_t)> &body);
+
+  /**
+   * @brief Process-wide pool sized to the hardware concurrency.
+   *
+   * @return Shared ThreadPool instance (created on first use).
+   */
+  static ThreadPool &global();
+
+private:
+  /** @brief Pushes a type-erased task onto the queue and wakes a worker. */
+  void enqueue(std::function<void()> task);
+
+  /** @brief Worker loop: pop and run tasks until shutdown. */
+  void workerLoop();
+
+  /** @brief Worker threads. */
+  std::vector<std::thread> workers;
+
+  /** @brief Pending tasks (FIFO). */
+  std::queue<std::function<void()>> tasks;
+
+  /** @brief Protects 'tasks' and 'stopping'. */
+  std::mutex queueMutex;
+
+  /** @brief Signals workers when tasks arrive or the pool stops. */
+  std::condition_variable queueCondition;
+
+  /** @brief Set once in the destructor to drain and exit workers. */
+  bool stopping = false;
+};
@@ -0,0 +1,155 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+/**
+ * @file TlsfAllocator.hpp
+ * @brief Two-level segregated fit (TLSF) allocator for offsets in a range.
+ *
+ * The **TlsfAllocator** hands out aligned sub-ranges of [0, capacity) in
+ * O(1): free blocks are kept in lists bucketed by size, a first level per
+ * power of two and kSecondLevels linear subdivisions of each, with one
+ * bitmap per level to find the smallest non-empty bucket that fits. Freed
+ * blocks are merged with free physical neighbours immediately, so the
+ * range never holds two adjacent free blocks.
+ *
+ * It manages numbers only; GpuAllocator uses one per device memory block.
+ *
+ * @code
+ * TlsfAllocator tlsf(64 << 20);
+ * TlsfAllocator::Allocation a = tlsf.allocate(size, alignment);
+ * if (a.offset != TlsfAllocator::kNoSpace) {
+ *   buffer.bindMemory(*block, a.offset);
+ * }
+ * tlsf.free(a);
+ * @endcode
+ */
+class TlsfAllocator {
+public:
+  /** @brief Allocation::offset when no free block can hold a request. */
+  static constexpr uint64_t kNoSpace = std::numeric_limits<uint64_t>::max();
+
+  /** @brief log2 of the number of second-level buckets per power of two. */
+  static constexpr uint32_t kSecondLevelBits = 5;
+
+  /** @brief Second-level buckets per power of two. */
+  static constexpr uint32_t kSecondLevels = 1u << kSecondLevelBits;
+
+  /**
+   * @struct Allocation
+   * @brief A range handed out by allocate(); pass it back to free().
+   */
+  struct Allocation {
+    uint64_t offset = kNoSpace; ///< Aligned start, or kNoSpace
+    uint64_t size = 0;          ///< Requested size
+    uint32_t node = 0;          ///< Internal block index
+  };
+
+  /**
+   * @brief Creates an allocator whose whole range is free.
+   *
+   * @param capacity Size of the managed range (> 0).
+   */
+  explicit TlsfAllocator(uint64_t capacity);
+
+  /**
+   * @brief Allocates 'size' bytes at a multiple of 'alignment'.
+   *
+   * @param size Bytes needed (0 is treated as 1).
+   * @param alignment Power of two.
+   * @return The allocation; its offset is kNoSpace if nothing fits.
+   */
+  Allocation allocate(uint64_t size, uint64_t alignment);
+
+  /** @brief Returns an allocation's range and merges it with neighbours. */
+  void free(const Allocation &allocation);
+
+  /** @brief Size of the managed range. */
+  uint64_t capacity() const { return capacityBytes; }
+
+  /** @brief Bytes in allocated blocks (including alignment padding). */
+  uint64_t used() const { return usedBytes; }
+
+  /** @brief Live allocations. */
+  size_t allocationCount() const { return liveAllocations; }
+
+  /** @brief True when no allocation is live. */
+  bool empty() const { return liveAllocations == 0; }
+
+  /** @brief Size of the largest free block. */
+  uint64_t largestFree() const;
+
+  /** @brief Number of free blocks. */
+  size_t freeBlockCount() const { return freeBlocks; }
+
+private:
+  /** @brief Marks the end of a list. */
+  static constexpr uint32_t kNone = std::numeric_limits<uint32_t>::max();
+
+  /** @brief Blocks smaller than this are never split off. */
+  static constexpr uint64_t kMinBlock = 16;
+
+  /** @brief First-level buckets (one per bit of a 64-bit size). */
+  static constexpr uint32_t kFirstLevels = 64;
+
+  /**
+   * @struct Node
+   * @brief A free or used block of the range.
+   */
+  struct Node {
+    uint64_t offset = 0;        ///< Start of the block
+    uint64_t size = 0;          ///< Length of the block
+    uint32_t prevPhys = kNone;  ///< Block ending at 'offset'
+    uint32_t nextPhys = kNone;  ///< Block starting at 'offset + size'
+    uint32_t prevFree = kNone;  ///< Previous block of the same bucket
+    uint32_t nextFree = kNone;  ///< Next block of the same bucket
+    bool free = false;          ///< In a free list
+  };
+
+  /** @brief Bucket (first, second level) holding blocks of 'size'. */
+  static void mapping(uint64_t size, uint32_t &fl, uint32_t &sl);
+
+  /** @brief New node from the spare list or the end of 'nodes'. */
+  uint32_t newNode();
+
+  /** @brief Puts a node on the spare list. */
+  void releaseNode(uint32_t index);
+
+  /** @brief Inserts a free block into its bucket. */
+  void insertFree(uint32_t index);
+
+  /** @brief Unlinks a free block from its bucket. */
+  void removeFree(uint32_t index);
+
+  /** @brief Free block of at least 'size' bytes, or kNone. */
+  uint32_t findFree(uint64_t size) const;
+
+  /** @brief Every block ever created (spare ones are reused). */
+  std::vector<Node> nodes;
+
+  /** @brief Indices of unused entries of 'nodes'. */
+  std::vector<uint32_t> spareNodes;
+
+  /** @brief First free block of each bucket. */
+  std::vector<uint32_t> heads;
+
+  /** @brief Bit fl set when any bucket of first level fl is non-empty. */
+  uint64_t firstLevelMap = 0;
+
+  /** @brief Bit sl of entry fl set when bucket (fl, sl) is non-empty. */
+  uint32_t secondLevelMap[kFirstLevels] = {};
+
+  /** @brief Size of the managed range. */
+  uint64_t capacityBytes = 0;
+
+  /** @brief Bytes in used blocks. */
+  uint64_t usedBytes = 0;
+
+  /** @brief Used blocks. */
+  size_t liveAllocations = 0;
+
+  /** @brief Free blocks. */
+  size_t freeBlocks = 0;
+};
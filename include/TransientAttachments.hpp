@@ -0,0 +1,158 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include <vulkan/vulkan_raii.hpp>
+
+#include "GpuAllocator.hpp"
+
+/**
+ * @file TransientAttachments.hpp
+ * @brief Memory for attachments whose contents never outlive a frame.
+ *
+ * MSAA color and depth attachments are cleared at the start of the render
+ * pass and discarded at its end (the color samples are resolved into the
+ * swapchain image), so their memory is only needed while a pass runs. The
+ * **TransientAttachments** binds such images, created with
+ * eTransientAttachment usage, in one of two ways:
+ * - eLazilyAllocated memory where the device offers it for the image (tile
+ *   based GPUs): the attachment then lives in tile memory and its backing
+ *   store is only committed if the driver ever needs to spill it;
+ * - otherwise shared device-local blocks, in which attachments whose pass
+ *   ranges do not overlap are placed at the same offsets (aliased).
+ *
+ * Aliased images must be transitioned from eUndefined at their first use in
+ * a frame, since another attachment may have overwritten them.
+ *
+ * @code
+ * attachments.reset(); // After the images using it are destroyed
+ * attachments.add(colorImage, 0, 0);
+ * attachments.add(depthImage, 0, 0);
+ * attachments.bind();  // Before creating their views
+ * @endcode
+ *
+ * The images must stay alive until reset(); the device and allocator must
+ * outlive the object.
+ */
+class TransientAttachments {
+public:
+  /**
+   * @struct Request
+   * @brief Memory requirements and pass range of one attachment.
+   */
+  struct Request {
+    vk::DeviceSize size = 0;      ///< Required size
+    vk::DeviceSize alignment = 1; ///< Required alignment
+    uint32_t memoryTypeBits = 0;  ///< Acceptable memory types
+    uint32_t firstPass = 0;       ///< First pass of the frame using it
+    uint32_t lastPass = 0;        ///< Last pass using it (inclusive)
+  };
+
+  /**
+   * @struct Placement
+   * @brief Where plan() puts one attachment.
+   */
+  struct Placement {
+    uint32_t block = 0;        ///< Index into Plan::blocks
+    vk::DeviceSize offset = 0; ///< Offset in that block
+  };
+
+  /**
+   * @struct Plan
+   * @brief Shared blocks and the placement of every request.
+   */
+  struct Plan {
+    std::vector<vk::MemoryRequirements> blocks; ///< One allocation each
+    std::vector<Placement> placements;          ///< Per request, in order
+
+    /** @brief Sum of the block sizes. */
+    vk::DeviceSize bytes() const;
+  };
+
+  /**
+   * @struct Footprint
+   * @brief Attachment memory before and after transient placement.
+   */
+  struct Footprint {
+    size_t attachments = 0;            ///< Images bound
+    vk::DeviceSize separateBytes = 0;  ///< One allocation per image
+    vk::DeviceSize lazyBytes = 0;      ///< Lazily allocated (reserved)
+    vk::DeviceSize committedBytes = 0; ///< Of lazyBytes, actually backed
+    vk::DeviceSize aliasedBytes = 0;   ///< Shared device-local blocks
+    size_t aliasedBlocks = 0;          ///< Number of shared blocks
+
+    /** @brief Device memory the attachments occupy now. */
+    vk::DeviceSize residentBytes() const {
+      return committedBytes + aliasedBytes;
+    }
+  };
+
+  /**
+   * @brief Packs attachments into as few bytes as their pass ranges allow.
+   *
+   * Requests whose pass ranges intersect never overlap in memory; the
+   * others may. Requests only share a block when their memory type bits
+   * intersect.
+   */
+  static Plan plan(std::span<const Request> requests);
+
+  /**
+   * @brief Creates an empty set.
+   *
+   * @param logicalDevice Device of the images.
+   * @param gpuAllocator Allocator of their memory.
+   * @param preferLazy Use lazily allocated memory where offered.
+   */
+  TransientAttachments(const vk::raii::Device &logicalDevice,
+                       GpuAllocator &gpuAllocator, bool preferLazy = true);
+
+  TransientAttachments(const TransientAttachments &) = delete;
+  TransientAttachments &operator=(const TransientAttachments &) = delete;
+
+  /**
+   * @brief Adds an image without memory, used from pass 'firstPass' to
+   * 'lastPass' of a frame.
+   */
+  void add(const vk::raii::Image &image, uint32_t firstPass,
+           uint32_t lastPass);
+
+  /**
+   * @brief Allocates memory for every added image and binds it.
+   *
+   * @throws std::runtime_error if no device-local memory type matches.
+   */
+  void bind();
+
+  /** @brief Frees the memory and forgets the images. */
+  void reset();
+
+  /** @brief Memory of the bound images. */
+  Footprint footprint() const;
+
+private:
+  /**
+   * @struct Entry
+   * @brief One added image.
+   */
+  struct Entry {
+    const vk::raii::Image *image = nullptr; ///< Image to bind
+    Request request;                    ///< Its requirements and passes
+    GpuAllocation lazyMemory = nullptr; ///< Lazily allocated memory, if any
+  };
+
+  /** @brief Device of the images. */
+  const vk::raii::Device &device;
+
+  /** @brief Memory of the images. */
+  GpuAllocator &allocator;
+
+  /** @brief Try eLazilyAllocated memory first. */
+  bool lazy = true;
+
+  /** @brief Added images, in order. */
+  std::vector<Entry> entries;
+
+  /** @brief Shared blocks of the aliased images. */
+  std::vector<GpuAllocation> blocks;
+};
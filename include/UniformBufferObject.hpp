@@ -30,7 +30,7 @@
  *
  */
 struct UniformBufferObject {
-    /** @brief Model matrix: transforms local object coordinates to world space. */
+    /** @brief Model matrix: maps stored (quantized) positions to model space. */
     glm::mat4 model;
 
     /** @brief View matrix: defines the camera position and orientation in the scene. */
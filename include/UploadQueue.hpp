@@ -0,0 +1,253 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <vulkan/vulkan_raii.hpp>
+
+#include "StagingPool.hpp"
+
+/**
+ * @file UploadQueue.hpp
+ * @brief Asynchronous staging uploads on a transfer queue, completed through
+ *        a timeline semaphore.
+ *
+ * Submitting each copy and waiting for the queue to go idle stalls the frame
+ * loop for the whole transfer and drains every frame in flight with it. The
+ * **UploadQueue** records copies from StagingPool ranges into a batch,
+ * submits the batch once to a transfer-only queue family (or the graphics
+ * queue when the GPU has none) and signals the batch's value on a timeline
+ * semaphore. Nothing on the host waits for it.
+ *
+ * copy() returns the timeline value of its batch. Every frame calls
+ * acquire() on its command buffer with the newest value among the uploads
+ * its draws reference, and waits for the returned Wait in its submission,
+ * only at the stages that read those uploads. Batches that had already
+ * completed at the last collect() are acquired along the way at no cost,
+ * so a resource the frame can do without (a texture still showing its
+ * placeholder) is switched to once ready() says its batch is done, and no
+ * frame waits for it. With a dedicated transfer family, every copy is
+ * followed by a queue family ownership release to the graphics family
+ * (with the final image layout), and acquire() records the matching
+ * acquire barriers.
+ *
+ * @code
+ * const uint64_t meshValue = uploadQueue.copy(
+ *     pool.upload(bytes), buffer, offset,
+ *     vk::PipelineStageFlagBits2::eIndexInput,
+ *     vk::AccessFlagBits2::eIndexRead);
+ * uploadQueue.submit(); // Once per frame, after every copy of the frame
+ *
+ * // Once per frame
+ * uploadQueue.collect();
+ * frameCommands.begin({});
+ * const UploadQueue::Wait wait = uploadQueue.acquire(frameCommands,
+ *                                                    meshValue);
+ * // ... record, then submit waiting for 'wait.value' on semaphore() at
+ * // 'wait.stages' (if the value is not 0)
+ * @endcode
+ *
+ * Staging ranges and objects passed to keepAlive() are released once their
+ * batch has completed. A destination must outlive the frame that acquires
+ * its batch, since acquire() records barriers on it. Not thread safe:
+ * record, submit and acquire from the thread that owns the graphics queue.
+ * The device and staging pool must outlive the queue.
+ */
+class UploadQueue {
+  struct Batch;
+
+public:
+  /**
+   * @struct Stats
+   * @brief Totals since creation.
+   */
+  struct Stats {
+    uint64_t batches = 0;      ///< Submissions to the transfer queue
+    uint64_t copies = 0;       ///< Buffer and image copies recorded
+    uint64_t bytes = 0;        ///< Staging bytes copied
+    uint64_t acquires = 0;     ///< Frames that waited for a running batch
+    size_t pendingBatches = 0; ///< Submitted batches not yet collected
+  };
+
+  /**
+   * @struct Wait
+   * @brief What a graphics submission waits for on semaphore().
+   */
+  struct Wait {
+    uint64_t value = 0;             ///< Timeline value, 0 for none
+    vk::PipelineStageFlags2 stages; ///< Stages reading the acquired copies
+  };
+
+  /**
+   * @brief Creates the command pool and timeline semaphore.
+   *
+   * @param logicalDevice Device both queue families belong to.
+   * @param stagingPool Pool the copied ranges come from.
+   * @param transferQueueFamily Family to submit uploads to (queue 0).
+   * @param graphicsQueueFamily Family of the queue that uses the uploads;
+   * equal to 'transferQueueFamily' when uploads share the graphics queue.
+   */
+  UploadQueue(const vk::raii::Device &logicalDevice, StagingPool &stagingPool,
+              uint32_t transferQueueFamily, uint32_t graphicsQueueFamily);
+
+  /** @brief Releases every batch's staging ranges (the device must be idle). */
+  ~UploadQueue();
+
+  UploadQueue(const UploadQueue &) = delete;
+  UploadQueue &operator=(const UploadQueue &) = delete;
+
+  /** @brief True when uploads run on their own queue family. */
+  bool dedicated() const { return transferFamily != graphicsFamily; }
+
+  /**
+   * @brief Records a copy of 'source' into 'buffer' at 'offset'.
+   *
+   * @param stages Stages that first read the range on the graphics queue.
+   * @param access How they read it.
+   * @return Timeline value of the batch the copy belongs to.
+   */
+  uint64_t copy(const StagingPool::Range &source, vk::Buffer buffer,
+                vk::DeviceSize offset, vk::PipelineStageFlags2 stages,
+                vk::AccessFlags2 access);
+
+  /**
+   * @brief Records copies of 'source' into a new image, which ends up in
+   * eShaderReadOnlyOptimal.
+   *
+   * @param regions Copy regions (offsets into the staging buffer).
+   * @param levelCount Mip levels of 'image', all of which are transitioned.
+   * @return Timeline value of the batch the copy belongs to.
+   */
+  uint64_t
+  copy(const StagingPool::Range &source, vk::Image image,
+       std::span<const vk::BufferImageCopy> regions, uint32_t levelCount,
+       vk::PipelineStageFlags2 stages =
+           vk::PipelineStageFlagBits2::eFragmentShader,
+       vk::AccessFlags2 access = vk::AccessFlagBits2::eShaderSampledRead);
+
+  /**
+   * @brief Keeps objects a recorded copy reads (e.g. an imported staging
+   * buffer) alive until the batch has completed.
+   */
+  template <typename... T> void keepAlive(T &&...objects) {
+    static_assert((!std::is_lvalue_reference_v<T> && ...),
+                  "keepAlive() takes ownership: pass std::move(object)");
+    Batch &batch = recording();
+    (keep(batch, std::make_shared<std::decay_t<T>>(std::forward<T>(objects))),
+     ...);
+  }
+
+  /**
+   * @brief Submits the copies recorded since the last call as one batch.
+   *
+   * @return Timeline value signaled when the batch completes; the previous
+   * batch's value when nothing was recorded.
+   */
+  uint64_t submit();
+
+  /**
+   * @brief Records the ownership acquires of the submitted batches not yet
+   * acquired into a graphics command buffer: those up to 'needed', and
+   * those that had completed at the last collect().
+   *
+   * @param needed Newest value of the uploads the command buffer reads.
+   * @return What the command buffer's submission must wait for; a zero
+   * value when no batch was acquired.
+   */
+  Wait acquire(const vk::raii::CommandBuffer &commandBuffer,
+               uint64_t needed = 0);
+
+  /**
+   * @brief True when the batch signaling 'value' had completed at the last
+   * collect(), so a frame can start using its uploads without waiting.
+   */
+  bool ready(uint64_t value) const { return value <= collectedValue; }
+
+  /** @brief Timeline semaphore signaled by the batches. */
+  const vk::raii::Semaphore &semaphore() const { return timeline; }
+
+  /** @brief Newest value the GPU has signaled. */
+  uint64_t completed() const;
+
+  /** @brief Blocks until the batch signaling 'value' has completed. */
+  void wait(uint64_t value) const;
+
+  /**
+   * @brief Releases the staging ranges and kept objects of completed
+   * batches and recycles their command buffers.
+   */
+  void collect();
+
+  /** @brief Totals since creation. */
+  Stats stats() const;
+
+private:
+  /**
+   * @struct Acquires
+   * @brief Acquire barriers and readers of one submitted batch.
+   */
+  struct Acquires {
+    uint64_t value = 0;                            ///< Batch's value
+    vk::PipelineStageFlags2 stages;                ///< Stages of its readers
+    std::vector<vk::BufferMemoryBarrier2> buffers; ///< Buffer acquires
+    std::vector<vk::ImageMemoryBarrier2> images;   ///< Image acquires
+  };
+
+  /** @brief Current batch, begun on first use. */
+  Batch &recording();
+
+  /** @brief Adds a type-erased owner to 'batch'. */
+  static void keep(Batch &batch, std::shared_ptr<void> object);
+
+  /** @brief Device of the pool, semaphore and command buffers. */
+  const vk::raii::Device &device;
+
+  /** @brief Source of the copied ranges. */
+  StagingPool &staging;
+
+  /** @brief Family of 'queue'. */
+  uint32_t transferFamily = 0;
+
+  /** @brief Family the uploads are used on. */
+  uint32_t graphicsFamily = 0;
+
+  /** @brief Queue 0 of 'transferFamily'. */
+  vk::raii::Queue queue = nullptr;
+
+  /** @brief Pool of the batches' command buffers. */
+  vk::raii::CommandPool commandPool = nullptr;
+
+  /** @brief Signaled with each batch's value. */
+  vk::raii::Semaphore timeline = nullptr;
+
+  /** @brief Batch being recorded (null between submit() and a copy). */
+  std::unique_ptr<Batch> current;
+
+  /** @brief Submitted batches, oldest first. */
+  std::deque<std::unique_ptr<Batch>> submitted;
+
+  /** @brief Command buffers of collected batches, reset and ready. */
+  std::vector<vk::raii::CommandBuffer> freeCommandBuffers;
+
+  /** @brief Submitted batches not yet acquired, oldest first. */
+  std::deque<Acquires> unacquired;
+
+  /** @brief Buffer barriers of one acquire(), kept for their capacity. */
+  std::vector<vk::BufferMemoryBarrier2> bufferAcquires;
+
+  /** @brief Image barriers of one acquire(), kept for their capacity. */
+  std::vector<vk::ImageMemoryBarrier2> imageAcquires;
+
+  /** @brief Value of the last batch submitted. */
+  uint64_t lastValue = 0;
+
+  /** @brief Newest value signaled at the last collect(). */
+  uint64_t collectedValue = 0;
+
+  /** @brief Totals since creation. */
+  Stats totals;
+};
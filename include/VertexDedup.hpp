@@ -0,0 +1,111 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "MeshData.hpp"
+#include "ThreadPool.hpp"
+#include "Vertex.hpp"
+#include "VertexHash.hpp"
+
+/**
+ * @file VertexDedup.hpp
+ * @brief Flat open-addressing vertex deduplication.
+ *
+ * The **vertexdedup** namespace turns a per-corner vertex stream into the
+ * unique-vertex + index representation used by MeshData. It replaces the
+ * node-based 'std::unordered_map<Vertex, uint32_t>' with a linear-probing
+ * table of 8-byte slots (32-bit hash tag + 32-bit vertex id), so a lookup
+ * touches one or two cache lines instead of chasing bucket pointers.
+ *
+ * Both entry points assign vertex ids in order of first occurrence, so their
+ * output is identical to the classic unordered_map loop (and to each other).
+ *
+ * @code
+ * MeshData mesh;
+ * vertexdedup::deduplicate(corners, mesh);                     // serial
+ * vertexdedup::deduplicateParallel(corners, mesh, pool);       // sharded
+ * @endcode
+ *
+ * @see vertexhash
+ */
+namespace vertexdedup {
+
+/** @brief Corner count above which loaders switch to the sharded mode. */
+constexpr size_t kParallelThreshold = size_t(1) << 20;
+
+/**
+ * @class DedupTable
+ * @brief Open-addressing (linear probe) set of vertex ids keyed by vertex bits.
+ *
+ * The table stores only ids; the vertices themselves live in a caller-owned
+ * array ('keys') that every id indexes into. Load factor is kept <= 1/2.
+ */
+class DedupTable {
+public:
+  /**
+   * @brief Creates a table sized for an expected number of unique vertices.
+   *
+   * @param expectedUnique Expected unique count (the table grows as needed).
+   */
+  explicit DedupTable(size_t expectedUnique = 0);
+
+  /**
+   * @brief Single-probe insert-or-find.
+   *
+   * @param bits Canonical bits of the vertex (vertexhash::canonicalBits()).
+   * @param hash vertexhash::hash() of 'bits'.
+   * @param candidate Id to insert if the vertex is not present yet.
+   * @param keys Vertex array indexed by ids; must hold every inserted id.
+   * @return {id, inserted}: the existing id or 'candidate' if it was inserted.
+   */
+  std::pair<uint32_t, bool> findOrInsert(const vertexhash::Bits &bits,
+                                         uint64_t hash, uint32_t candidate,
+                                         const Vertex *keys);
+
+  /** @brief Number of ids stored. */
+  size_t size() const { return count; }
+
+private:
+  /** @brief One table slot; 'id == kEmpty' marks a free slot. */
+  struct Slot {
+    uint32_t tag; ///< Upper 32 bits of the hash (cheap pre-compare)
+    uint32_t id;  ///< Index into the caller's key array
+  };
+
+  static constexpr uint32_t kEmpty = 0xFFFFFFFFu;
+
+  /** @brief Reallocates to 'capacity' slots and reinserts every id. */
+  void rehash(size_t capacity, const Vertex *keys);
+
+  std::vector<Slot> slots;
+  size_t mask = 0;
+  size_t count = 0;
+};
+
+/**
+ * @brief Deduplicates a corner stream on the calling thread.
+ *
+ * @param corners One vertex per triangle corner.
+ * @param mesh Receives unique vertices and one index per corner
+ * (existing contents are replaced; bounds are not touched).
+ * @throws std::runtime_error If there are more corners than 32-bit ids allow.
+ */
+void deduplicate(std::span<const Vertex> corners, MeshData &mesh);
+
+/**
+ * @brief Deduplicates a corner stream with hash-sharded parallel tables.
+ *
+ * Produces exactly the same output as deduplicate().
+ *
+ * @param corners One vertex per triangle corner.
+ * @param mesh Receives unique vertices and one index per corner.
+ * @param pool Worker pool.
+ * @throws std::runtime_error If there are more corners than 32-bit ids allow.
+ */
+void deduplicateParallel(std::span<const Vertex> corners, MeshData &mesh,
+                         ThreadPool &pool);
+
+} // namespace vertexdedup
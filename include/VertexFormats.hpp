@@ -0,0 +1,358 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <glm/glm.hpp>
+#include <span>
+#include <string>
+#include <vector>
+#include <vulkan/vulkan_raii.hpp>
+
+#include "Vertex.hpp"
+
+/**
+ * @file VertexFormats.hpp
+ * @brief Quantized GPU vertex layouts described by compile-time type lists.
+ *
+ * The renderer keeps the 32-byte Vertex on the CPU (loaders, mesh cache,
+ * LODs, meshlets) and only packs vertices when filling the GPU vertex buffer.
+ * A packed layout is a VertexLayout of Attribute types; its stride, member
+ * offsets, binding description and attribute descriptions are all computed
+ * at compile time from that list, and each Attribute knows how to encode
+ * itself from a Vertex.
+ *
+ * Positions are stored as unorm16 relative to the mesh bounding box and
+ * dequantized by Quantization::positionTransform (folded into the model
+ * matrix), so the vertex shader is unchanged. Texture coordinates use unorm16
+ * when they lie in [0, 1], half floats when those are precise enough, and
+ * 32-bit floats otherwise. The color attribute is dropped when every vertex
+ * has the same color; the vertex shader variant built with CONSTANT_COLOR
+ * receives it as specialization constants instead.
+ *
+ * @note Every format used here is in Vulkan's mandatory vertex buffer format
+ * list, so no format support queries are needed.
+ *
+ * @code
+ * vertexformat::PackedVertices packed =
+ *     vertexformat::pack(vertices, boundsMin, boundsMax);
+ * vertexformat::visit(packed.layout, [&]<typename L>(L) {
+ *   binding = L::getBindingDescription();
+ *   attributes = L::getAttributeDescriptions();
+ * });
+ * @endcode
+ */
+namespace vertexformat {
+
+/**
+ * @struct Quantization
+ * @brief Per-mesh constants shared by the attribute encoders and the shader.
+ */
+struct Quantization {
+  glm::vec3 positionOffset{0.0f}; ///< Bounding box minimum
+  glm::vec3 positionScale{1.0f};  ///< Bounding box extent (unorm 1.0)
+  glm::vec3 constantColor{1.0f};  ///< Color of every vertex when dropped
+};
+
+/** @brief Converts a float to IEEE half precision (round to nearest even). */
+uint16_t floatToHalf(float value);
+
+/** @brief Converts an IEEE half precision value to float. */
+float halfToFloat(uint16_t value);
+
+/** @brief Rounds 'value' clamped to [0, 1] to a 16-bit unorm. */
+inline uint16_t toUnorm16(float value) {
+  return static_cast<uint16_t>(std::clamp(value, 0.0f, 1.0f) * 65535.0f +
+                               0.5f);
+}
+
+/** @brief Rounds 'value' clamped to [0, 1] to an 8-bit unorm. */
+inline uint8_t toUnorm8(float value) {
+  return static_cast<uint8_t>(std::clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f);
+}
+
+/**
+ * @struct Attribute
+ * @brief Compile-time description of one vertex attribute.
+ *
+ * @tparam Location Shader input location.
+ * @tparam Format Vulkan vertex format.
+ * @tparam Size Bytes occupied in the packed vertex.
+ * @tparam Encoder Type with a static 'encode(const Vertex &, const
+ *         Quantization &, std::byte *)' writing exactly 'Size' bytes.
+ */
+template <uint32_t Location, vk::Format Format, uint32_t Size,
+          typename Encoder>
+struct Attribute {
+  static constexpr uint32_t location = Location;
+  static constexpr vk::Format format = Format;
+  static constexpr uint32_t size = Size;
+
+  static void encode(const Vertex &vertex, const Quantization &quantization,
+                     std::byte *destination) {
+    Encoder::encode(vertex, quantization, destination);
+  }
+};
+
+/**
+ * @struct VertexLayout
+ * @brief A packed vertex made of 'Attributes' in declaration order.
+ *
+ * Offsets are the running sum of the attribute sizes, so every layout is
+ * tightly packed and its binding/attribute descriptions need no hand-written
+ * offsetof() tables.
+ */
+template <typename... Attributes> struct VertexLayout {
+  static constexpr uint32_t attributeCount = sizeof...(Attributes);
+
+  /** @brief Byte offset of each attribute. */
+  static constexpr std::array<uint32_t, attributeCount> offsets = [] {
+    std::array<uint32_t, attributeCount> result{};
+    const uint32_t sizes[] = {Attributes::size...};
+    uint32_t offset = 0;
+    for (uint32_t i = 0; i < attributeCount; i++) {
+      result[i] = offset;
+      offset += sizes[i];
+    }
+    return result;
+  }();
+
+  /** @brief Bytes per vertex. */
+  static constexpr uint32_t stride = (Attributes::size + ...);
+
+  /** @brief Binding 0, per-vertex rate, 'stride' bytes apart. */
+  static constexpr vk::VertexInputBindingDescription getBindingDescription() {
+    return {0, stride, vk::VertexInputRate::eVertex};
+  }
+
+  /** @brief One description per attribute, in declaration order. */
+  static constexpr std::array<vk::VertexInputAttributeDescription,
+                              attributeCount>
+  getAttributeDescriptions() {
+    uint32_t i = 0;
+    return {vk::VertexInputAttributeDescription(
+        Attributes::location, 0, Attributes::format, offsets[i++])...};
+  }
+
+  /** @brief Encodes 'vertices' into 'destination' (stride bytes per vertex). */
+  static void encode(std::span<const Vertex> vertices,
+                     const Quantization &quantization,
+                     std::byte *destination) {
+    for (const Vertex &vertex : vertices) {
+      uint32_t i = 0;
+      (Attributes::encode(vertex, quantization, destination + offsets[i++]),
+       ...);
+      destination += stride;
+    }
+  }
+};
+
+// ================== //
+// Attribute encoders //
+// ================== //
+
+/** @brief Position as 3 x float32 (unquantized). */
+struct PositionFloatEncoder {
+  static void encode(const Vertex &vertex, const Quantization &,
+                     std::byte *destination) {
+    std::memcpy(destination, &vertex.position, sizeof(glm::vec3));
+  }
+};
+
+/** @brief Position as 4 x unorm16 relative to the bounding box (w = 0). */
+struct PositionUnorm16Encoder {
+  static void encode(const Vertex &vertex, const Quantization &quantization,
+                     std::byte *destination) {
+    const glm::vec3 unit = (vertex.position - quantization.positionOffset) /
+                           quantization.positionScale;
+    const uint16_t packed[4] = {toUnorm16(unit.x), toUnorm16(unit.y),
+                                toUnorm16(unit.z), 0};
+    std::memcpy(destination, packed, sizeof(packed));
+  }
+};
+
+/** @brief Color as 3 x float32 (unquantized). */
+struct ColorFloatEncoder {
+  static void encode(const Vertex &vertex, const Quantization &,
+                     std::byte *destination) {
+    std::memcpy(destination, &vertex.color, sizeof(glm::vec3));
+  }
+};
+
+/** @brief Color as 4 x unorm8 (alpha = 1). */
+struct ColorUnorm8Encoder {
+  static void encode(const Vertex &vertex, const Quantization &,
+                     std::byte *destination) {
+    const uint8_t packed[4] = {toUnorm8(vertex.color.x),
+                               toUnorm8(vertex.color.y),
+                               toUnorm8(vertex.color.z), 255};
+    std::memcpy(destination, packed, sizeof(packed));
+  }
+};
+
+/** @brief Texture coordinates as 2 x float32 (unquantized). */
+struct TexCoordFloatEncoder {
+  static void encode(const Vertex &vertex, const Quantization &,
+                     std::byte *destination) {
+    std::memcpy(destination, &vertex.texCoord, sizeof(glm::vec2));
+  }
+};
+
+/** @brief Texture coordinates as 2 x unorm16 (requires [0, 1] range). */
+struct TexCoordUnorm16Encoder {
+  static void encode(const Vertex &vertex, const Quantization &,
+                     std::byte *destination) {
+    const uint16_t packed[2] = {toUnorm16(vertex.texCoord.x),
+                                toUnorm16(vertex.texCoord.y)};
+    std::memcpy(destination, packed, sizeof(packed));
+  }
+};
+
+/** @brief Texture coordinates as 2 x float16. */
+struct TexCoordHalfEncoder {
+  static void encode(const Vertex &vertex, const Quantization &,
+                     std::byte *destination) {
+    const uint16_t packed[2] = {floatToHalf(vertex.texCoord.x),
+                                floatToHalf(vertex.texCoord.y)};
+    std::memcpy(destination, packed, sizeof(packed));
+  }
+};
+
+using PositionFloat =
+    Attribute<0, vk::Format::eR32G32B32Sfloat, 12, PositionFloatEncoder>;
+using PositionUnorm16 =
+    Attribute<0, vk::Format::eR16G16B16A16Unorm, 8, PositionUnorm16Encoder>;
+using ColorFloat =
+    Attribute<1, vk::Format::eR32G32B32Sfloat, 12, ColorFloatEncoder>;
+using ColorUnorm8 =
+    Attribute<1, vk::Format::eR8G8B8A8Unorm, 4, ColorUnorm8Encoder>;
+using TexCoordFloat =
+    Attribute<2, vk::Format::eR32G32Sfloat, 8, TexCoordFloatEncoder>;
+using TexCoordUnorm16 =
+    Attribute<2, vk::Format::eR16G16Unorm, 4, TexCoordUnorm16Encoder>;
+using TexCoordHalf =
+    Attribute<2, vk::Format::eR16G16Sfloat, 4, TexCoordHalfEncoder>;
+
+// ======= //
+// Layouts //
+// ======= //
+
+/** @brief The original 32-byte Vertex, attribute for attribute. */
+using FloatLayout = VertexLayout<PositionFloat, ColorFloat, TexCoordFloat>;
+
+static_assert(FloatLayout::stride == sizeof(Vertex),
+              "FloatLayout must match Vertex");
+
+/**
+ * @enum Layout
+ * @brief Every layout pack() can choose, from largest to smallest.
+ */
+enum class Layout : uint8_t {
+  eFloat,              ///< FloatLayout (32 B)
+  eColorFloatTexCoord, ///< unorm16 position, unorm8 color, float UV (20 B)
+  eColorHalfTexCoord,  ///< unorm16 position, unorm8 color, half UV (16 B)
+  eColorUnormTexCoord, ///< unorm16 position, unorm8 color, unorm16 UV (16 B)
+  eFloatTexCoord,      ///< unorm16 position, float UV (16 B)
+  eHalfTexCoord,       ///< unorm16 position, half UV (12 B)
+  eUnormTexCoord,      ///< unorm16 position, unorm16 UV (12 B)
+};
+
+/**
+ * @brief Calls 'function(L{})' with the VertexLayout type of 'layout'.
+ *
+ * This is the single place mapping the runtime choice to the compile-time
+ * layouts; pipeline creation and packing both go through it.
+ */
+template <typename Function>
+decltype(auto) visit(Layout layout, Function &&function) {
+  switch (layout) {
+  case Layout::eColorFloatTexCoord:
+    return function(
+        VertexLayout<PositionUnorm16, ColorUnorm8, TexCoordFloat>{});
+  case Layout::eColorHalfTexCoord:
+    return function(
+        VertexLayout<PositionUnorm16, ColorUnorm8, TexCoordHalf>{});
+  case Layout::eColorUnormTexCoord:
+    return function(
+        VertexLayout<PositionUnorm16, ColorUnorm8, TexCoordUnorm16>{});
+  case Layout::eFloatTexCoord:
+    return function(VertexLayout<PositionUnorm16, TexCoordFloat>{});
+  case Layout::eHalfTexCoord:
+    return function(VertexLayout<PositionUnorm16, TexCoordHalf>{});
+  case Layout::eUnormTexCoord:
+    return function(VertexLayout<PositionUnorm16, TexCoordUnorm16>{});
+  case Layout::eFloat:
+  default:
+    return function(FloatLayout{});
+  }
+}
+
+/** @brief Bytes per vertex of 'layout'. */
+inline uint32_t strideOf(Layout layout) {
+  return visit(layout, []<typename L>(L) { return L::stride; });
+}
+
+/** @brief True if 'layout' has a color attribute (location 1). */
+inline bool hasColor(Layout layout) {
+  return layout == Layout::eFloat || layout == Layout::eColorFloatTexCoord ||
+         layout == Layout::eColorHalfTexCoord ||
+         layout == Layout::eColorUnormTexCoord;
+}
+
+/** @brief Human-readable description of 'layout' for logs and benches. */
+std::string name(Layout layout);
+
+/**
+ * @struct Options
+ * @brief Error budgets deciding what counts as "lossless enough".
+ */
+struct Options {
+  /** @brief Largest position error, as a fraction of the bbox diagonal */
+  float maxPositionError = 1e-4f;
+
+  /** @brief Largest texture coordinate error (half a texel at 4096^2) */
+  float maxTexCoordError = 1.0f / 8192.0f;
+
+  /** @brief Largest color error per channel (unorm8 rounding is 1/510) */
+  float maxColorError = 1.0f / 255.0f;
+
+  /** @brief Disable quantization and always use FloatLayout */
+  bool forceFloat = false;
+};
+
+/**
+ * @struct PackedVertices
+ * @brief Output of pack(): the vertex buffer bytes and how to read them.
+ */
+struct PackedVertices {
+  Layout layout = Layout::eFloat;
+  uint32_t stride = sizeof(Vertex);
+  Quantization quantization;
+  std::vector<std::byte> data;
+
+  float positionError = 0.0f; ///< Largest measured position error
+  float texCoordError = 0.0f; ///< Largest measured UV error
+
+  /**
+   * @brief Maps unorm positions back to model space (identity for float
+   * positions). Multiply the model matrix by this before uploading it.
+   */
+  glm::mat4 positionTransform() const;
+};
+
+/**
+ * @brief Picks the smallest layout within the error budgets and packs the
+ * vertices into it.
+ *
+ * @param vertices Source vertices.
+ * @param boundsMin Model-space bounding box minimum of 'vertices'.
+ * @param boundsMax Model-space bounding box maximum of 'vertices'.
+ * @param options Error budgets.
+ * @return Packed vertex data plus the chosen layout and measured errors.
+ */
+PackedVertices pack(std::span<const Vertex> vertices,
+                    const glm::vec3 &boundsMin, const glm::vec3 &boundsMax,
+                    const Options &options = {});
+
+} // namespace vertexformat
@@ -1,55 +1,113 @@
 #pragma once
 
-#define GLM_ENABLE_EXPERIMENTAL
-#include <glm/glm.hpp>
-#include <glm/gtx/hash.hpp>
 #include "Vertex.hpp"
+#include <array>
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <functional>
 
 /**
  * @file VertexHash.hpp
- * @brief Provides a 'std::hash' specialization for the Vertex struct.
+ * @brief Bit-pattern hashing for the Vertex struct and a 'std::hash'
+ *        specialization built on it.
  *
- * This header defines a custom hash functor that enables `Vertex` objects
- * to be used as keys in unordered associative containers such as
- * 'std::unordered_set` and 'std::unordered_map'.
+ * Vertices are hashed on their raw bit pattern (after folding -0.0 onto
+ * +0.0, so the hash stays consistent with `Vertex::operator==`). Pairs of
+ * 32-bit words are combined with a 64x64->128-bit multiply-fold mixer, which
+ * avalanches every input bit. This avoids the heavy clustering the previous
+ * XOR/shift combination of glm hashes showed on grid-aligned scan data,
+ * where many coordinates share most of their bits.
  *
- * The hash function combines position, color, and texture coordinate data
- * to generate a unique hash value consistent with `Vertex::operator==`.
- *
- * @note If you modify the layout or members of `Vertex`, this hash
- *       function must be updated to maintain consistency.
+ * @note If you modify the layout or members of `Vertex`, the hash picks up
+ *       the change automatically as long as Vertex stays a tightly packed
+ *       array of 32-bit floats.
  *
  * @see Vertex
- * @see std::unordered_set
- * @see std::unordered_map
+ * @see vertexdedup::DedupTable
  *
  * @code
  * std::unordered_set<Vertex> uniqueVertices;
  * Vertex v1{{1.0f, 2.0f, 3.0f}, {0.5f, 0.5f, 0.5f}, {0.0f, 1.0f}};
  * uniqueVertices.insert(v1);
+ * uint64_t h = vertexhash::hash(v1);
  * @endcode
  *
  */
+namespace vertexhash {
+
+/** @brief Number of 32-bit words in a Vertex. */
+inline constexpr size_t kWords = sizeof(Vertex) / sizeof(uint32_t);
+
+static_assert(sizeof(Vertex) % sizeof(uint32_t) == 0,
+              "Vertex must be a packed array of 32-bit components");
+
+/** @brief Canonical bit pattern of a Vertex. */
+using Bits = std::array<uint32_t, kWords>;
+
+/**
+ * @brief Returns the vertex bit pattern with -0.0 folded onto +0.0.
+ *
+ * Two vertices compare equal with `operator==` iff their canonical bits are
+ * equal (NaN components aside, which are then deduplicated by bit pattern).
+ */
+inline Bits canonicalBits(const Vertex &vertex) {
+    Bits bits;
+    std::memcpy(bits.data(), &vertex, sizeof(Vertex));
+    for (uint32_t &word : bits) {
+        word = word == 0x80000000u ? 0u : word; // -0.0f -> +0.0f
+    }
+    return bits;
+}
+
+/**
+ * @brief 64-bit multiply-fold mixer (wyhash-style).
+ *
+ * The full 128-bit product of the two operands is folded by XOR-ing its
+ * high and low halves, so every input bit affects every output bit.
+ */
+inline uint64_t mix(uint64_t a, uint64_t b) {
+    __uint128_t product = static_cast<__uint128_t>(a) * b;
+    return static_cast<uint64_t>(product) ^ static_cast<uint64_t>(product >> 64);
+}
+
+/** @brief Hashes a canonical bit pattern. */
+inline uint64_t hash(const Bits &bits) {
+    constexpr uint64_t kSeed[] = {0xA0761D6478BD642Full, 0xE7037ED1A0B428DBull,
+                                  0x8EBC6AF09C88C6E3ull, 0x589965CC75374CC3ull};
+    uint64_t h = kSeed[0] ^ sizeof(Vertex);
+    size_t i = 0;
+    for (; i + 4 <= kWords; i += 4) {
+        uint64_t a = bits[i] | (static_cast<uint64_t>(bits[i + 1]) << 32);
+        uint64_t b = bits[i + 2] | (static_cast<uint64_t>(bits[i + 3]) << 32);
+        h = mix(a ^ kSeed[1], b ^ h);
+    }
+    for (; i < kWords; i++) {
+        h = mix(bits[i] ^ kSeed[2], h ^ kSeed[3]);
+    }
+    return mix(h ^ kSeed[1], kSeed[2]);
+}
+
+/** @brief Hashes a Vertex on its canonical bit pattern. */
+inline uint64_t hash(const Vertex &vertex) {
+    return hash(canonicalBits(vertex));
+}
+
+} // namespace vertexhash
+
+/**
+ * @brief 'std::hash' specialization so Vertex can key unordered containers.
+ */
 template <> struct std::hash<Vertex> {
     /**
-    * @brief Computes a combined hash for a Vertex object.
-    *
-    * Each attribute (position, color, and texCoord) is hashed individually
-    * using `std::hash` and then combined via bitwise XOR and shifts
-    * to produce a well-distributed composite hash.
+    * @brief Computes the hash of a Vertex object.
     *
     * @param vertex The Vertex instance to hash.
     * @return A size_t representing the hash value.
+    *
+    * @see vertexhash::hash()
     */
     size_t operator()(Vertex const &vertex) const noexcept {
-        // Hash each vector field individually.
-        size_t posHash = std::hash<glm::vec3>()(vertex.position);
-        size_t colorHash = std::hash<glm::vec3>()(vertex.color);
-        size_t texHash = std::hash<glm::vec2>()(vertex.texCoord);
-
-        // Combine using XOR and bit shifts to minimize collisions.
-        return ((posHash ^ (colorHash << 1)) >> 1) ^ (texHash << 1);
+        return static_cast<size_t>(vertexhash::hash(vertex));
     }
 };
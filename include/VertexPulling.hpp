@@ -0,0 +1,88 @@
+#pragma once
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <vulkan/vulkan_raii.hpp>
+
+#include "VertexFormats.hpp"
+
+/**
+ * @file VertexPulling.hpp
+ * @brief Vertex layouts decoded in the vertex shader instead of by
+ *        fixed-function vertex input.
+ *
+ * With fixed-function vertex input, the binding stride and attribute formats
+ * of a vertexformat layout are baked into the graphics pipeline, so every
+ * layout needs its own pipeline (and the color-less layouts their own shader
+ * variant). With vertex pulling, shaders/vert_pull.glsl reads the vertex
+ * words itself through the buffer device address of the GeometryArena's
+ * vertex buffer and decodes them as a 32-bit descriptor of the layout says:
+ * @code
+ * 31     24 23         16 15          8 7   6 5   4 3   2 1   0
+ * [stride ][ UV offset   ][color offset][ 0 ][ UV  ][color][ pos ]
+ * @endcode
+ * Pipelines then only differ in their fixed state, and a mesh in any layout
+ * is drawn after pushing its PushConstants.
+ *
+ * @code
+ * const vertexpull::PushConstants pull =
+ *     vertexpull::pushConstants(arena.vertexAddress(), packedVertices);
+ * commandBuffer.pushConstants<vertexpull::PushConstants>(
+ *     *pipelineLayout, vk::ShaderStageFlagBits::eVertex,
+ *     vertexpull::kPushConstantOffset, pull);
+ * commandBuffer.drawIndexed(mesh.indexCount(), instances, mesh.firstIndex(),
+ *                           mesh.vertexOffset(), 0);
+ * @endcode
+ *
+ * Requires the bufferDeviceAddress feature and a vertex buffer created with
+ * eShaderDeviceAddress usage in memory allocated with the device address
+ * flag (GeometryArena and GpuAllocator with 'deviceAddress' set).
+ */
+namespace vertexpull {
+
+// Position codes (descriptor bits 0-1)
+constexpr uint32_t kPositionFloat = 0;   ///< 3 x float32
+constexpr uint32_t kPositionUnorm16 = 1; ///< 4 x unorm16 (bounding box)
+
+// Color codes (descriptor bits 2-3)
+constexpr uint32_t kColorConstant = 0; ///< None: PushConstants::constantColor
+constexpr uint32_t kColorFloat = 1;    ///< 3 x float32
+constexpr uint32_t kColorUnorm8 = 2;   ///< 4 x unorm8
+
+// Texture coordinate codes (descriptor bits 4-5)
+constexpr uint32_t kTexCoordFloat = 0;   ///< 2 x float32
+constexpr uint32_t kTexCoordUnorm16 = 1; ///< 2 x unorm16
+constexpr uint32_t kTexCoordHalf = 2;    ///< 2 x float16
+
+/** @brief Push constant offset; bytes 0-15 are the material color. */
+constexpr uint32_t kPushConstantOffset = 16;
+
+/**
+ * @struct PushConstants
+ * @brief Vertex stage push constants of shaders/vert_pull.glsl.
+ */
+struct PushConstants {
+  vk::DeviceAddress vertices = 0; ///< Vertex buffer address (vertex 0)
+  uint32_t format = 0;            ///< describe() of the mesh's layout
+  uint32_t reserved = 0;          ///< Padding (vec4 alignment)
+  glm::vec4 constantColor{1.0f};  ///< Color of layouts without one
+};
+
+static_assert(sizeof(PushConstants) == 32,
+              "PushConstants must match the shader's push constant block");
+
+/**
+ * @brief Encodes a layout's stride, attribute formats and offsets.
+ *
+ * @throws std::runtime_error for an attribute format the shader cannot
+ * decode (a layout added without updating vertex pulling).
+ */
+uint32_t describe(vertexformat::Layout layout);
+
+/**
+ * @brief Push constants drawing 'vertices' from a vertex buffer at
+ * 'address' (draws add the mesh's vertexOffset).
+ */
+PushConstants pushConstants(vk::DeviceAddress address,
+                            const vertexformat::PackedVertices &vertices);
+
+} // namespace vertexpull
@@ -22,13 +22,18 @@
 // ============================ //
 #include <algorithm>
 #include <chrono>
+#include <cmath>
 #include <cstdlib>
 #include <cstring>
+#include <filesystem>
 #include <fstream>
+#include <future>
 #include <iostream>
 #include <limits>
 #include <memory>
+#include <optional>
 #include <set>
+#include <span>
 #include <stdexcept>
 #include <unordered_map>
 #include <vector>
@@ -51,11 +56,37 @@
 // =============== //
 // Project Headers //
 // =============== //
+#include "AssetPack.hpp"
+#include "AsyncFileReader.hpp"
 #include "ChronoProfiler.hpp"
+#include "DrawBatch.hpp"
+#include "FileWatcher.hpp"
+#include "FrameRing.hpp"
+#include "GeometryArena.hpp"
+#include "GpuAllocator.hpp"
+#include "LoadBatch.hpp"
+#include "MemoryBudget.hpp"
+#include "MeshCache.hpp"
+#include "MeshData.hpp"
+#include "MeshLoader.hpp"
+#include "MeshOptimizer.hpp"
+#include "MeshSimplifier.hpp"
+#include "MeshletBuilder.hpp"
+#include "MipGenerator.hpp"
 #include "ProfilerUI.hpp"
+#include "RetireQueue.hpp"
+#include "Scene.hpp"
+#include "StagingPool.hpp"
+#include "TransientAttachments.hpp"
+#include "TextureFile.hpp"
+#include "TextureStreaming.hpp"
+#include "ThreadPool.hpp"
 #include "UniformBufferObject.hpp"
+#include "UploadQueue.hpp"
 #include "Vertex.hpp"
+#include "VertexFormats.hpp"
 #include "VertexHash.hpp"
+#include "VertexPulling.hpp"
 #include "VulkanUtils.hpp"
 
 // ========= //
@@ -70,9 +101,151 @@ constexpr uint32_t HEIGHT = 540;
 /** @brief File path to the 3D model used in the scene. */
 const std::string MODEL_PATH = "models/statue.obj";
 
+/** @brief Binary mesh cache generated from MODEL_PATH on first load. */
+const std::string MODEL_CACHE_PATH = "models/statue.armesh";
+
+/**
+ * @brief Reorder freshly parsed models for vertex cache/fetch locality
+ * (meshopt::optimize()) before they are uploaded. Opt-in; the result is
+ * stored in the mesh cache.
+ */
+constexpr bool OPTIMIZE_MESH = false;
+
+/** @brief Also sort triangle clusters for overdraw when OPTIMIZE_MESH is set. */
+constexpr bool OPTIMIZE_MESH_OVERDRAW = false;
+
+/**
+ * @brief Generate a quadric-simplified LOD chain for freshly parsed models
+ * (meshlod::buildLodChain()); stored in the mesh cache.
+ */
+constexpr bool GENERATE_LODS = true;
+
+/** @brief Largest acceptable projected LOD error, in pixels. */
+constexpr float LOD_PIXEL_ERROR = 1.0f;
+
+/**
+ * @brief Benchmark mode: move the camera through LOD_SWEEP_DISTANCES, render
+ * LOD_SWEEP_FRAMES frames at each and print frame time and triangle
+ * throughput per distance, then exit.
+ */
+constexpr bool LOD_DISTANCE_SWEEP = false;
+
+/** @brief Camera distances (model units) visited by LOD_DISTANCE_SWEEP. */
+constexpr float LOD_SWEEP_DISTANCES[] = {2.0f, 4.0f, 8.0f, 16.0f, 32.0f, 64.0f};
+
+/** @brief Frames rendered per distance in LOD_DISTANCE_SWEEP mode. */
+constexpr int LOD_SWEEP_FRAMES = 300;
+
+/**
+ * @brief Split the model into meshlets, cull them in a compute pass and draw
+ * the survivors with vkCmdDrawIndexedIndirectCount. Falls back to a single
+ * drawIndexed when the GPU lacks drawIndirectCount/multiDrawIndirect.
+ */
+constexpr bool MESHLET_CULLING = true;
+
+/**
+ * @brief Pack vertices into the smallest quantized layout that stays within
+ * the vertexformat::Options error budgets. Disable to compare frame times
+ * against the 32-byte float layout.
+ */
+constexpr bool QUANTIZE_VERTICES = true;
+
+/**
+ * @brief Decode vertices in the vertex shader (shaders/vert_pull.glsl), read
+ * through the geometry arena's buffer device address, instead of with
+ * fixed-function vertex input, so one pipeline draws every vertex layout.
+ * Falls back to vertex input without bufferDeviceAddress.
+ */
+constexpr bool VERTEX_PULLING = false;
+
+/**
+ * @brief Submit uploads to a transfer-only queue family when the GPU has
+ * one, handing the resources to the graphics queue with queue family
+ * ownership transfers. Disable (or without such a family) to submit them
+ * to the graphics queue; either way nothing waits for them on the host.
+ */
+constexpr bool TRANSFER_QUEUE = true;
+
+/**
+ * @brief Load the model and decode the texture on worker threads while the
+ * window already presents frames (clear color until the model is resident,
+ * placeholder texture until the texture is). Disable to block in
+ * initVulkan() like a synchronous load.
+ */
+constexpr bool ASYNC_ASSET_LOADING = true;
+
+/**
+ * @brief Build the texture mip chain on the CPU (parallel, gamma-correct)
+ * directly into the staging buffer and upload it with one multi-region copy.
+ * Disable to blit the levels on the GPU; formats without linear-blit support
+ * always use the CPU path.
+ */
+constexpr bool CPU_MIPMAPS = true;
+
+/**
+ * @brief Stream texture mips progressively: upload the small tail first, then
+ * add finer levels in the background as the model's screen coverage needs
+ * them, evicting levels beyond TEXTURE_STREAMING_BUDGET. Disable to upload
+ * the whole chain at load time.
+ */
+constexpr bool TEXTURE_STREAMING = true;
+
+/** @brief Largest mip dimension uploaded before streaming starts. */
+constexpr uint32_t TEXTURE_STREAMING_INITIAL_SIZE = 64;
+
+/** @brief Bytes each streamed texture may keep resident on the GPU. */
+constexpr uint64_t TEXTURE_STREAMING_BUDGET = 64ull << 20;
+
+/**
+ * @brief Fraction of a device-local heap's budget (VK_EXT_memory_budget, or
+ * 80% of the heap without it) above which streamed textures are evicted.
+ */
+constexpr float MEMORY_BUDGET_THRESHOLD = 0.9f;
+
 /** @brief File path to the texture image for the model. */
 const std::string TEXTURE_PATH = "textures/statue.png";
 
+/**
+ * @brief Pre-compressed mip chain baked from TEXTURE_PATH by tools/texbake.
+ * Used instead of decoding the PNG when present, up to date and (for BC
+ * formats) supported by the GPU.
+ */
+const std::string COMPRESSED_TEXTURE_PATH = "textures/statue.artx";
+
+/**
+ * @brief Asset pack built by tools/packbuild from the baked mesh cache,
+ * texture and SPIR-V modules. Blobs found in it are used in place of the
+ * loose files, unless the loose file is newer than the pack.
+ */
+const std::string ASSET_PACK_PATH = "assets.pack";
+
+/**
+ * @brief Let the GPU read asset pack blobs straight out of the mapping
+ * (VK_EXT_external_memory_host) instead of copying them into a staging
+ * buffer. Falls back to the copy when unsupported or refused.
+ */
+constexpr bool IMPORT_HOST_MEMORY = true;
+
+/**
+ * @brief Watch MODEL_PATH, TEXTURE_PATH and the SPIR-V modules, rebuild what
+ * changed on a worker thread and swap it in at a frame boundary, without
+ * waiting for the device to go idle.
+ */
+constexpr bool HOT_RELOAD = true;
+
+/**
+ * @brief Frames slower than this (ms) while a hot reload is being built or
+ * swapped in are reported as hitches.
+ */
+constexpr double HOT_RELOAD_HITCH_MS = 25.0;
+
+/**
+ * @brief Scene file (see Scene.hpp) whose instances of MODEL_PATH are drawn.
+ * Generate one with tools/scenegen; without it the renderer draws a single
+ * instance of MODEL_PATH at the origin.
+ */
+const std::string SCENE_PATH = "scenes/scene_1k.json";
+
 /** @brief Vulkan validation layers enabled for debugging. */
 const std::vector<const char *> validationLayers = {
     "VK_LAYER_KHRONOS_validation"};
@@ -87,6 +260,127 @@ constexpr bool enableValidationLayers = true;
 /** @brief Maximum number of frames processed concurrently in the swap chain. */
 constexpr int MAX_FRAMES_IN_FLIGHT = 2;
 
+/**
+ * @brief Bytes of per-frame data (uniforms, instance matrices) each frame in
+ * flight may write to the frame ring buffer. Grown to fit the scene's
+ * instances if smaller.
+ */
+constexpr uint64_t FRAME_RING_BYTES = 4ull << 20;
+
+/**
+ * @struct MaterialTexture
+ * @brief A diffuse texture referenced by the model's materials, other than
+ * TEXTURE_PATH (which keeps its baked/streamed path and 'descriptorSets').
+ */
+struct MaterialTexture {
+  /** @brief Resolved map_Kd path */
+  std::string path;
+
+  /** @brief Decoded RGBA8 mip chain (freed after upload) */
+  std::vector<uint8_t> chain;
+
+  /** @brief Layout of 'chain' */
+  std::vector<mipgen::LevelLayout> levels;
+
+  /** @brief Uploaded mip chain */
+  vk::raii::Image image = nullptr;
+
+  /** @brief Memory backing 'image' */
+  GpuAllocation imageMemory = nullptr;
+
+  /** @brief View of every mip of 'image' */
+  vk::raii::ImageView imageView = nullptr;
+
+  /** @brief Upload batch of 'image'; sampled once it has completed */
+  uint64_t uploadValue = 0;
+
+  /** @brief UBO + this texture, one set per frame in flight */
+  std::vector<vk::raii::DescriptorSet> descriptorSets;
+
+  /** @brief Image view each set currently binds */
+  std::vector<vk::ImageView> descriptorSetImageViews;
+};
+
+/**
+ * @struct ModelState
+ * @brief Everything VulkanRenderer::buildModel() derives from MODEL_PATH on
+ * the CPU; installModel() moves it into the renderer.
+ */
+struct ModelState {
+  /** @brief Parsed mesh (empty when served from the cache) */
+  MeshData mesh;
+
+  /** @brief Mapped mesh cache (warm path) */
+  std::optional<meshcache::CachedMesh> cache;
+
+  /** @brief Vertices, viewed in 'mesh' or 'cache' */
+  std::span<const Vertex> vertices;
+
+  /** @brief Indices, viewed in 'mesh' or 'cache' */
+  std::span<const uint32_t> indices;
+
+  /** @brief LOD ranges into 'indices' (empty = draw everything) */
+  std::span<const MeshLod> lods;
+
+  /** @brief Materials; one white material when the model has none */
+  std::vector<MeshMaterial> materials;
+
+  /** @brief Material ranges of every LOD, ordered by LOD */
+  std::vector<MeshSubmesh> submeshes;
+
+  /** @brief First submesh of each LOD, plus an end entry */
+  std::vector<uint32_t> lodSubmeshStart;
+
+  /** @brief Texture slot of each material */
+  std::vector<uint32_t> textureSlots;
+
+  /** @brief map_Kd of texture slot k + 1 (a MaterialTexture each) */
+  std::vector<std::string> texturePaths;
+
+  /** @brief Model-space bounding box minimum */
+  glm::vec3 boundsMin{0.0f};
+
+  /** @brief Model-space bounding box maximum */
+  glm::vec3 boundsMax{0.0f};
+
+  /** @brief GPU vertex layout + packed vertex data */
+  vertexformat::PackedVertices packedVertices;
+
+  /** @brief Meshlets of every LOD (empty without meshlet culling) */
+  meshlet::MeshletSet meshlets;
+};
+
+/**
+ * @struct HotReload
+ * @brief One batch of changed assets, rebuilt on a worker thread and
+ * swapped in by VulkanRenderer::updateHotReload().
+ */
+struct HotReload {
+  /** @brief Changed files, as reported by the FileWatcher */
+  std::vector<std::string> paths;
+
+  /** @brief When the first change of the batch was reported */
+  std::chrono::steady_clock::time_point detected;
+
+  /** @brief Worker filling the members below */
+  std::future<void> job;
+
+  /** @brief Rebuilt model (MODEL_PATH changed) */
+  std::optional<ModelState> model;
+
+  /** @brief Graphics pipeline for new shaders or a new vertex layout */
+  vk::raii::Pipeline graphicsPipeline = nullptr;
+
+  /** @brief Compute pipeline for a new shaders/cull.spv */
+  vk::raii::Pipeline cullPipeline = nullptr;
+
+  /** @brief Decoded RGBA8 mip chain of TEXTURE_PATH */
+  std::vector<uint8_t> textureChain;
+
+  /** @brief Layout of 'textureChain' (empty = texture unchanged) */
+  std::vector<mipgen::LevelLayout> textureLayout;
+};
+
 /**
  * @class VulkanRenderer
  * @brief Encapsulates a Vulkan-based rendering engine using RAII wrappers.
@@ -148,6 +442,30 @@ private:
   /** @brief Logical Vulkan device */
   vk::raii::Device device = nullptr;
 
+  /** @brief Memory of every buffer and image (outlives them all) */
+  std::unique_ptr<GpuAllocator> allocator;
+
+  /** @brief Heap usage against budget, checked every frame */
+  std::unique_ptr<MemoryBudget> memoryBudget;
+
+  /** @brief Sub-ranges of mapped staging buffers for every upload */
+  std::unique_ptr<StagingPool> stagingPool;
+
+  /** @brief Batched staging copies, completed on a timeline semaphore */
+  std::unique_ptr<UploadQueue> uploadQueue;
+
+  /** @brief Graphics queue transfers of loads, submitted and waited once */
+  std::unique_ptr<LoadBatch> loadBatch;
+
+  /** @brief Memory of the MSAA color and depth attachments */
+  std::unique_ptr<TransientAttachments> transientAttachments;
+
+  /** @brief Shared vertex and index buffers of every mesh */
+  std::unique_ptr<GeometryArena> geometryArena;
+
+  /** @brief Profiler counter names of memory categories and heaps */
+  std::vector<std::string> memoryCounterNames;
+
   /** @brief Graphics queue */
   vk::raii::Queue graphicsQueue = nullptr;
 
@@ -184,9 +502,6 @@ private:
   /** @brief Format of the swap chain surface */
   vk::SurfaceFormatKHR swapChainSurfaceFormat;
 
-  /** @brief Vertex input state for the pipeline */
-  vk::PipelineVertexInputStateCreateInfo vertexInputInfo;
-
   /** @brief Index of the graphics queue family */
   uint32_t graphicsQueueFamilyIndex;
 
@@ -202,9 +517,6 @@ private:
   /** @brief Color image used for multisampling */
   vk::raii::Image colorImage = nullptr;
 
-  /** @brief Memory backing the color image */
-  vk::raii::DeviceMemory colorImageMemory = nullptr;
-
   /** @brief Image view for the color image */
   vk::raii::ImageView colorImageView = nullptr;
 
@@ -220,29 +532,41 @@ private:
   /** @brief Fences to synchronize CPU and GPU */
   std::vector<vk::raii::Fence> inFlightFences;
 
-  /** @brief Vertex buffer */
-  vk::raii::Buffer vertexBuffer = nullptr;
+  /** @brief The model's vertex and index ranges in 'geometryArena' */
+  GeometryArena::Mesh modelGeometry = nullptr;
 
-  /** @brief Memory backing the vertex buffer */
-  vk::raii::DeviceMemory vertexBufferMemory = nullptr;
+  /** @brief Descriptor set layout */
+  vk::raii::DescriptorSetLayout descriptorSetLayout = nullptr;
 
-  /** @brief Index buffer */
-  vk::raii::Buffer indexBuffer = nullptr;
+  /**
+   * @brief Persistently mapped buffer of all per-frame data, one partition
+   * per frame in flight (dynamic uniform buffer and instance vertex buffer)
+   */
+  vk::raii::Buffer frameRingBuffer = nullptr;
 
-  /** @brief Memory backing the index buffer */
-  vk::raii::DeviceMemory indexBufferMemory = nullptr;
+  /** @brief Memory backing 'frameRingBuffer' */
+  GpuAllocation frameRingMemory = nullptr;
 
-  /** @brief Descriptor set layout */
-  vk::raii::DescriptorSetLayout descriptorSetLayout = nullptr;
+  /** @brief Sub-allocates the current frame's partition of the ring */
+  std::optional<FrameRing> frameRing;
+
+  /** @brief Dynamic offset of this frame's UniformBufferObject */
+  uint32_t uniformOffset = 0;
+
+  /** @brief Offset of this frame's instance matrices in the ring */
+  vk::DeviceSize instanceOffset = 0;
 
-  /** @brief Uniform buffers for the swap chain */
-  std::vector<vk::raii::Buffer> uniformBuffers;
+  /** @brief Meshes and instances loaded from SCENE_PATH */
+  scene::Scene sceneData;
 
-  /** @brief Memory backing uniform buffers */
-  std::vector<vk::raii::DeviceMemory> uniformBuffersMemory;
+  /** @brief Scene mesh drawn with the loaded model (MODEL_PATH) */
+  uint32_t sceneMeshId = 0;
 
-  /** @brief Mapped pointers to uniform buffers */
-  std::vector<void *> uniformBuffersMapped;
+  /** @brief World matrix of every scene instance (static) */
+  std::vector<glm::mat4> instanceWorlds;
+
+  /** @brief This frame's visible instances, grouped by LOD */
+  scene::InstanceBatches instanceBatches;
 
   /** @brief Descriptor pool */
   vk::raii::DescriptorPool descriptorPool = nullptr;
@@ -254,32 +578,305 @@ private:
   vk::raii::Image textureImage = nullptr;
 
   /** @brief Memory backing the texture image */
-  vk::raii::DeviceMemory textureImageMemory = nullptr;
+  GpuAllocation textureImageMemory = nullptr;
 
   /** @brief Image view for the texture */
   vk::raii::ImageView textureImageView = nullptr;
 
+  /** @brief Upload batch of 'textureImage' (0 when not on 'uploadQueue') */
+  uint64_t textureUpload = 0;
+
+  /**
+   * @brief 'textureImage' replaced the placeholder once its first upload
+   * completed; a hot-reloaded image is then bound right away, and the
+   * frames sampling it wait for its batch.
+   */
+  bool textureShown = false;
+
   /** @brief Texture sampler */
   vk::raii::Sampler textureSampler = nullptr;
 
+  /** @brief 1x1 white texture sampled until the real texture is resident */
+  vk::raii::Image placeholderImage = nullptr;
+
+  /** @brief Memory backing the placeholder texture */
+  GpuAllocation placeholderImageMemory = nullptr;
+
+  /** @brief Image view for the placeholder texture */
+  vk::raii::ImageView placeholderImageView = nullptr;
+
+  /** @brief Texture view written into each frame's descriptor set */
+  std::vector<vk::ImageView> descriptorSetImageViews;
+
+  /** @brief RGBA8 pixels from decodeTexture(), freed after the upload */
+  std::unique_ptr<unsigned char, void (*)(void *)> texturePixels{nullptr,
+                                                                 std::free};
+
+  /** @brief Mapped ASSET_PACK_PATH (empty if it was not built) */
+  std::optional<assetpack::AssetPack> assetPack;
+
+  /** @brief Modification time of ASSET_PACK_PATH */
+  int64_t assetPackMtime = 0;
+
+  /** @brief minImportedHostPointerAlignment, 0 if import is unavailable */
+  vk::DeviceSize hostImportAlignment = 0;
+
+  /** @brief Bytes memcpy'd into staging buffers by stageBytes() */
+  uint64_t stagedBytesCopied = 0;
+
+  /** @brief Bytes handed to the GPU in place by stageBytes() */
+  uint64_t stagedBytesImported = 0;
+
+  /** @brief Mapped COMPRESSED_TEXTURE_PATH, replaces 'texturePixels' */
+  std::optional<artx::TextureFile> compressedTexture;
+
+  /**
+   * @brief Every mip of the texture, viewed in 'compressedTexture' (kept
+   * mapped, so levels are paged in from disk when streamed) or in
+   * 'textureChain'. Filled only with TEXTURE_STREAMING.
+   */
+  std::vector<texstream::Level> textureLevels;
+
+  /** @brief CPU mip chain built from the PNG for streaming */
+  std::vector<uint8_t> textureChain;
+
+  /** @brief Resident range of 'textureImage' within 'textureLevels' */
+  texstream::Residency textureResidency;
+
+  /**
+   * @brief Bytes the streamed texture may keep resident: the configured
+   * TEXTURE_STREAMING_BUDGET, lowered while video memory is over budget.
+   */
+  uint64_t textureStreamingBudget = TEXTURE_STREAMING_BUDGET;
+
+  /** @brief Pending copy of a level into 'textureStreamStaging' */
+  std::future<void> textureStreamFuture;
+
+  /** @brief Level being streamed in by 'textureStreamFuture' */
+  uint32_t textureStreamMip = 0;
+
+  /** @brief Staging range of the level(s) being streamed in */
+  StagingPool::Range textureStreamStaging;
+
+  /**
+   * @brief Resized streamed image whose upload is still running; it
+   * replaces 'textureImage' once its batch has completed.
+   */
+  vk::raii::Image streamedImage = nullptr;
+
+  /** @brief Memory backing 'streamedImage' */
+  GpuAllocation streamedImageMemory = nullptr;
+
+  /** @brief First level 'streamedImage' holds */
+  uint32_t streamedMip = 0;
+
+  /** @brief Upload batch of 'streamedImage' */
+  uint64_t streamedUpload = 0;
+
+  /** @brief Format of 'textureImage' (depends on the loaded file) */
+  vk::Format textureFormat = vk::Format::eR8G8B8A8Srgb;
+
+  /** @brief Width of 'texturePixels' */
+  int textureWidth = 0;
+
+  /** @brief Height of 'texturePixels' */
+  int textureHeight = 0;
+
+  /**
+   * @brief Pending loadModel() on a worker thread. The members it writes are
+   * read by the main thread only once 'modelResident' is set.
+   */
+  std::future<void> modelFuture;
+
+  /** @brief Pending decodeTexture() on a worker thread */
+  std::future<void> textureFuture;
+
+  /** @brief Pending decodeMaterialTextures() on a worker thread */
+  std::future<void> materialTextureFuture;
+
+  /**
+   * @brief Reads source files for the cold load paths; shared by the model
+   * and texture loaders, so both files are in flight together.
+   */
+  AsyncFileReader fileReader;
+
+  /** @brief Model buffers and graphics pipeline exist (main thread only) */
+  bool modelResident = false;
+
+  /** @brief Upload batch of the model's geometry and meshlets */
+  uint64_t geometryUpload = 0;
+
+  /** @brief Texture image exists and replaces the placeholder */
+  bool textureResident = false;
+
+  /** @brief Start of run(), the origin of the load metrics */
+  std::chrono::high_resolution_clock::time_point launchTime;
+
+  /** @brief Time to first frame has been reported */
+  bool firstFramePresented = false;
+
+  /** @brief Time to full quality has been reported */
+  bool fullQualityPresented = false;
+
   /** @brief Depth image */
   vk::raii::Image depthImage = nullptr;
 
-  /** @brief Memory backing the depth image */
-  vk::raii::DeviceMemory depthImageMemory = nullptr;
-
   /** @brief Image view for the depth image */
   vk::raii::ImageView depthImageView = nullptr;
 
-  /** @brief Vertices loaded from the model */
-  std::vector<Vertex> vertices;
+  /** @brief Mesh parsed from MODEL_PATH (empty when served from the cache) */
+  MeshData model;
+
+  /** @brief Memory-mapped mesh cache backing the model on warm starts */
+  std::optional<meshcache::CachedMesh> modelCache;
 
-  /** @brief Indices loaded from the model */
-  std::vector<uint32_t> indices;
+  /** @brief Vertices of the model (view into 'model' or 'modelCache') */
+  std::span<const Vertex> modelVertices;
+
+  /** @brief Indices of the model (view into 'model' or 'modelCache') */
+  std::span<const uint32_t> modelIndices;
+
+  /** @brief LOD ranges into 'modelIndices' (empty = draw everything) */
+  std::span<const MeshLod> modelLods;
+
+  /**
+   * @brief Materials of the model; one white material textured with
+   * TEXTURE_PATH when the model has none.
+   */
+  std::vector<MeshMaterial> modelMaterials;
+
+  /**
+   * @brief Material ranges of every LOD (ordered by LOD); one per LOD when
+   * the model has no materials.
+   */
+  std::vector<MeshSubmesh> modelSubmeshes;
+
+  /**
+   * @brief First entry of 'modelSubmeshes' for each LOD, plus an end entry
+   * (LOD l owns submeshes [start[l], start[l + 1])).
+   */
+  std::vector<uint32_t> lodSubmeshStart;
+
+  /**
+   * @brief Texture slot of each material: 0 = TEXTURE_PATH, k = entry k - 1
+   * of 'materialTextures'.
+   */
+  std::vector<uint32_t> materialTextureSlots;
+
+  /** @brief Pool of the 'materialTextures' descriptor sets (outlives them) */
+  vk::raii::DescriptorPool materialDescriptorPool = nullptr;
+
+  /** @brief Extra diffuse textures of the model's materials */
+  std::vector<MaterialTexture> materialTextures;
+
+  /** @brief Each LOD's submeshes, sorted by drawbatch key (see uploadModel) */
+  std::vector<std::vector<drawbatch::DrawItem>> lodDrawLists;
+
+  /** @brief Model-space bounding box minimum */
+  glm::vec3 modelBoundsMin{0.0f};
+
+  /** @brief Model-space bounding box maximum */
+  glm::vec3 modelBoundsMax{0.0f};
+
+  /** @brief GPU vertex layout + packed vertex data (freed after upload) */
+  vertexformat::PackedVertices packedVertices;
+
+  /** @brief Meshlets of every LOD (empty unless meshlet culling is enabled) */
+  meshlet::MeshletSet modelMeshlets;
+
+  /** @brief True when MESHLET_CULLING is requested and supported */
+  bool meshletCullingEnabled = false;
+
+  /** @brief True when VERTEX_PULLING is requested and supported */
+  bool vertexPullingEnabled = false;
+
+  /** @brief Vertex address and layout of the model (vertex pulling) */
+  vertexpull::PushConstants pullConstants;
+
+  /** @brief GPU samples BC1-BC7 images (textureCompressionBC enabled) */
+  bool bcTexturesSupported = false;
+
+  /** @brief Storage buffer holding 'modelMeshlets.meshlets' */
+  vk::raii::Buffer meshletBuffer = nullptr;
+
+  /** @brief Memory backing the meshlet buffer */
+  GpuAllocation meshletBufferMemory = nullptr;
+
+  /** @brief Per-frame indirect draw commands written by the cull pass */
+  std::vector<vk::raii::Buffer> drawCommandBuffers;
+
+  /** @brief Memory backing the indirect draw command buffers */
+  std::vector<GpuAllocation> drawCommandBuffersMemory;
+
+  /** @brief Per-frame draw count + culling statistics (host visible) */
+  std::vector<vk::raii::Buffer> cullCounterBuffers;
+
+  /** @brief Memory backing the cull counter buffers */
+  std::vector<GpuAllocation> cullCounterBuffersMemory;
+
+  /** @brief Mapped pointers to the cull counter buffers */
+  std::vector<meshlet::CullCounters *> cullCountersMapped;
+
+  /** @brief Descriptor set layout of the cull pass (storage buffers) */
+  vk::raii::DescriptorSetLayout cullDescriptorSetLayout = nullptr;
+
+  /** @brief Per-frame descriptor sets of the cull pass */
+  std::vector<vk::raii::DescriptorSet> cullDescriptorSets;
+
+  /** @brief Pipeline layout of the cull pass (set + push constants) */
+  vk::raii::PipelineLayout cullPipelineLayout = nullptr;
+
+  /** @brief Compute pipeline running shaders/cull.comp */
+  vk::raii::Pipeline cullPipeline = nullptr;
+
+  /** @brief Cull pass push constants for the current frame */
+  meshlet::CullParams cullParams;
+
+  /** @brief Camera distance from the origin (default eye is (2,2,2)) */
+  float cameraDistance = 3.4641016f;
+
+  /** @brief Finest LOD drawn this frame (the meshlet cull pass's LOD) */
+  uint32_t currentLod = 0;
 
   /** @brief Current frame index for multi-frame rendering */
   uint32_t currentFrame = 0;
 
+  /** @brief Frames submitted so far ('currentFrame' is its slot) */
+  uint64_t frameNumber = 0;
+
+  /** @brief Reports changes to the hot-reloaded files (HOT_RELOAD) */
+  FileWatcher assetWatcher;
+
+  /** @brief Hot reload being rebuilt on a worker (at most one at a time) */
+  std::unique_ptr<HotReload> hotReload;
+
+  /** @brief Changes reported while 'hotReload' was busy */
+  std::vector<std::string> pendingReloadPaths;
+
+  /** @brief When the first of 'pendingReloadPaths' was reported */
+  std::chrono::steady_clock::time_point pendingReloadDetected;
+
+  /**
+   * @brief Upload batch this frame's submission waits for, and the stages
+   * that read it (a zero value when the frame acquired no batch)
+   */
+  UploadQueue::Wait uploadWait;
+
+  /**
+   * @brief Objects replaced by a hot reload, destroyed once the last frame
+   * that may use them has completed (declared late: destroyed first).
+   */
+  RetireQueue retireQueue;
+
+  /** @brief Start of the previous updateHotReload(), for hitch detection */
+  std::chrono::steady_clock::time_point lastFrameStart;
+
+  /** @brief Frames after a swap that still count towards hitches */
+  uint32_t hitchWatchFrames = 0;
+
+  /** @brief Frames over HOT_RELOAD_HITCH_MS during hot reloads */
+  uint32_t hotReloadHitches = 0;
+
   /** @brief Flag for framebuffer resizing */
   bool framebufferResized = false;
 
@@ -304,17 +901,151 @@ private:
   vk::SampleCountFlagBits getMaxUsableSampleCount();
 
   /**
-   * @brief Loads a 3D model from MODEL_PATH into `vertices` and `indices`.
+   * @brief Loads the model from MODEL_CACHE_PATH, or parses MODEL_PATH and
+   * writes the cache, then points `modelVertices`/`modelIndices` at the data.
+   * CPU only; runs on a worker thread.
    *
    * @throws std::runtime_error on file I/O failure or invalid model format.
    */
   void loadModel();
 
   /**
-   * @brief Creates depth image, allocates memory, and generates depth image
-   * view.
+   * @brief CPU side of loadModel(): reads no renderer state it could race
+   * with, so hot reloads run it while the current model is drawn.
+   *
+   * @return The loaded model, ready for installModel().
+   * @throws std::runtime_error on file I/O failure or invalid model format.
+   */
+  ModelState buildModel();
+
+  /**
+   * @brief Moves a built model into the model members and creates its
+   * (not yet decoded) 'materialTextures'.
+   *
+   * @param state Result of buildModel().
+   */
+  void installModel(ModelState state);
+
+  /**
+   * @brief Maps ASSET_PACK_PATH into 'assetPack' if it exists and is valid.
+   */
+  void openAssetPack();
+
+  /**
+   * @brief Bytes of an asset from 'assetPack'.
+   *
+   * @param path Loose path of the asset (its name in the pack).
+   * @return The blob, or an empty span if the pack lacks it or the loose
+   * file has been modified since the pack was built.
+   */
+  std::span<const std::byte> packedAsset(const std::string &path) const;
+
+  /**
+   * @brief Queues loadModel() and decodeTexture() on the thread pool.
+   */
+  void startAssetLoads();
+
+  /**
+   * @brief Uploads assets whose CPU work has finished and marks them
+   * resident.
    *
-   * @throws std::runtime_error on Vulkan allocation failure.
+   * @param wait Block until both assets are loaded.
+   * @throws std::runtime_error rethrown from a failed load.
+   */
+  void pollAssets(bool wait);
+
+  /**
+   * @brief Creates the model's GPU buffers, graphics pipeline, cull and
+   * material descriptor sets, and sorts the per-LOD draw lists.
+   */
+  void uploadModel();
+
+  /**
+   * @brief Reads and decodes every entry of 'materialTextures' into an
+   * RGBA8 mip chain. CPU only; runs on a worker thread.
+   */
+  void decodeMaterialTextures();
+
+  /**
+   * @brief Uploads the decoded 'materialTextures' and frees their chains.
+   */
+  void createMaterialTextureImages();
+
+  /**
+   * @brief Allocates one descriptor set per frame for each entry of
+   * 'materialTextures', bound to the placeholder until it is uploaded.
+   */
+  void createMaterialDescriptorSets();
+
+  /**
+   * @brief Prints and records time to first frame / full quality.
+   */
+  void reportLoadMetrics();
+
+  /**
+   * @brief Publishes the GPU allocator's statistics and the heaps' usage
+   * against their budget as profiler counters.
+   */
+  void reportMemoryStats();
+
+  /**
+   * @brief Lowers (or restores) the texture streaming budget when a
+   * device-local heap crosses MEMORY_BUDGET_THRESHOLD.
+   */
+  void onMemoryBudget(uint32_t heapIndex, const MemoryBudget::Heap &heap);
+
+  /**
+   * @brief Loads SCENE_PATH (or a single instance of MODEL_PATH) and
+   * computes the instances' world matrices.
+   */
+  void loadScene();
+
+  /**
+   * @brief Registers MODEL_PATH, TEXTURE_PATH and the SPIR-V modules with
+   * 'assetWatcher'.
+   */
+  void watchAssets();
+
+  /**
+   * @brief Per-frame hot reload step: collects file changes, starts a
+   * rebuild when none is running and swaps a finished one in. Also tracks
+   * hitches while a reload is in progress.
+   */
+  void updateHotReload();
+
+  /**
+   * @brief Queues the rebuild of 'pendingReloadPaths' on the thread pool.
+   */
+  void startHotReload();
+
+  /**
+   * @brief Decodes TEXTURE_PATH into the texture members of a reload. CPU
+   * only; runs on a worker thread.
+   *
+   * @param reload Reload receiving the mip chain.
+   * @throws std::runtime_error if the file cannot be read or decoded.
+   */
+  void decodeReloadedTexture(HotReload &reload);
+
+  /**
+   * @brief Replaces the model's GPU objects with those of a rebuilt model,
+   * retiring the old ones.
+   *
+   * @param reload Finished reload holding the model and its pipeline.
+   */
+  void swapReloadedModel(HotReload &reload);
+
+  /**
+   * @brief Replaces 'textureImage' with the reloaded chain; the copy is
+   * queued on 'uploadQueue'.
+   *
+   * @param reload Finished reload holding the mip chain.
+   */
+  void swapReloadedTexture(HotReload &reload);
+
+  /**
+   * @brief Creates the transient depth image (memory and view are created
+   * by bindTransientAttachments()).
    */
   void createDepthResources();
 
@@ -356,30 +1087,94 @@ private:
   void createTextureSampler();
 
   /**
-   * @brief Begins a short-lived command buffer.
+   * @brief Maps COMPRESSED_TEXTURE_PATH into 'compressedTexture', or reads
+   * and decodes TEXTURE_PATH into 'texturePixels'. CPU only; runs on a
+   * worker thread.
    *
-   * @return Unique pointer to command buffer to be manually submitted.
+   * @throws std::runtime_error if the file is missing or cannot be decoded.
+   */
+  void decodeTexture();
+
+  /**
+   * @brief Uploads 'compressedTexture' (all baked mips) or 'texturePixels'
+   * (level 0, then generateMipmaps()) to a Vulkan image.
+   */
+  void createTextureImage();
+
+  /**
+   * @brief Uploads every baked mip of 'compressedTexture' in its stored
+   * format (BC1, BC7 or RGBA8) and releases the mapping.
    */
-  std::unique_ptr<vk::raii::CommandBuffer> beginSingleTimeCommands();
+  void createCompressedTextureImage();
 
   /**
-   * @brief Submits one-time command buffer and frees it.
+   * @brief Uploads the mip tail (TEXTURE_STREAMING_INITIAL_SIZE and smaller)
+   * of 'textureLevels' and makes the texture resident.
+   */
+  void startTextureStreaming();
+
+  /**
+   * @brief Advances texture streaming by at most one step per frame: lands
+   * a resized image whose upload has completed or a finished background
+   * level read, or starts the next stream-in or eviction chosen by
+   * texstream::nextStep().
+   */
+  void updateTextureStreaming();
+
+  /**
+   * @brief Creates 'streamedImage' holding levels firstMip .. end.
    *
-   * @param commandBuffer Command buffer created via beginSingleTimeCommands().
+   * Every level comes from 'textureStreamStaging', packed back to back;
+   * the copy runs on 'uploadQueue', and landStreamedTexture() installs the
+   * image once it has completed.
+   *
+   * @param firstMip New residentMip.
    */
-  void endSingleTimeCommands(vk::raii::CommandBuffer &commandBuffer);
+  void resizeStreamedTexture(uint32_t firstMip);
 
   /**
-   * @brief Loads texture image, uploads pixels to Vulkan image, and builds
-   * mipmaps.
+   * @brief Replaces 'textureImage' with 'streamedImage' and retires the old
+   * image.
    */
-  void createTextureImage();
+  void landStreamedTexture();
+
+  /**
+   * @brief Creates the 1x1 white placeholder texture and its view.
+   */
+  void createPlaceholderTexture();
 
   /**
-   * @brief Creates MSAA color buffer + image view.
+   * @brief Points a frame's descriptor sets (main and material) at the
+   * current texture views.
+   *
+   * @param frame Frame in flight whose fence has been waited on.
+   */
+  void updateTextureDescriptor(uint32_t frame);
+
+  /**
+   * @brief Creates the transient MSAA color image (memory and view are
+   * created by bindTransientAttachments()).
    */
   void createColorResources();
 
+  /**
+   * @brief Creates a swapchain-sized image with msaaSamples samples, without
+   * memory.
+   *
+   * @param format Pixel format.
+   * @param usage Attachment usage flags.
+   */
+  vk::raii::Image createAttachmentImage(vk::Format format,
+                                        vk::ImageUsageFlags usage);
+
+  /**
+   * @brief Binds lazily allocated or aliased memory to the color and depth
+   * images, creates their views and reports the attachment footprint.
+   *
+   * @throws std::runtime_error if no device-local memory type matches.
+   */
+  void bindTransientAttachments();
+
   /**
    * @brief Creates an image + GPU allocation + binds memory.
    *
@@ -392,16 +1187,17 @@ private:
    * @param usage Image usage flags
    * @param properties Memory requirements
    * @param image Output Vulkan image handle
-   * @param imageMemory Backing device memory
+   * @param imageMemory Backing memory (sub-allocated, bound to 'image')
    */
   void createImage(uint32_t width, uint32_t height, uint32_t mipLevels,
                    vk::SampleCountFlagBits numSamples, vk::Format format,
                    vk::ImageTiling tiling, vk::ImageUsageFlags usage,
                    vk::MemoryPropertyFlags properties, vk::raii::Image &image,
-                   vk::raii::DeviceMemory &imageMemory);
+                   GpuAllocation &imageMemory);
 
   /**
-   * @brief Transition GPU image layout (required for texture creation/staging).
+   * @brief Records a GPU image layout transition (required for texture
+   * creation/staging) into 'loadBatch'.
    *
    * @param image Target image
    * @param oldLayout Original layout
@@ -413,7 +1209,8 @@ private:
                              vk::ImageLayout newLayout, uint32_t mipLevels);
 
   /**
-   * @brief Generates mipmaps across all mipmap levels for a texture.
+   * @brief Records the generation of every mipmap level of a texture into
+   * 'loadBatch'.
    *
    * @param image Vulkan image
    * @param imageFormat Format
@@ -425,15 +1222,18 @@ private:
                        int32_t texWidth, int32_t texHeight, uint32_t mipLevels);
 
   /**
-   * @brief Copies pixel data from buffer → image.
+   * @brief Records a copy of pixel data from buffer → image into
+   * 'loadBatch'.
    *
    * @param buffer Staging buffer
    * @param image Target image
    * @param width Width in pixels
    * @param height Height in pixels
+   * @param bufferOffset Offset of the pixels in 'buffer'
    */
-  void copyBufferToImage(const vk::raii::Buffer &buffer, vk::raii::Image &image,
-                         uint32_t width, uint32_t height);
+  void copyBufferToImage(vk::Buffer buffer, vk::raii::Image &image,
+                         uint32_t width, uint32_t height,
+                         vk::DeviceSize bufferOffset = 0);
 
   /**
    * @brief Creates Vulkan descriptor pool.
@@ -446,16 +1246,23 @@ private:
   void createDescriptorSets();
 
   /**
-   * @brief Updates UBO for the current frame (camera matrices).
+   * @brief Allocates and writes the per-frame cull pass descriptor sets.
+   */
+  void createCullDescriptorSets();
+
+  /**
+   * @brief Updates UBO for the current frame (camera matrices), then culls
+   * the scene instances and writes their matrices grouped by LOD.
    *
    * @param currentImage Swapchain image index.
    */
   void updateUniformBuffer(uint32_t currentImage);
 
   /**
-   * @brief Creates one uniform buffer per swapchain frame-in-flight.
+   * @brief Creates the frame ring buffer, with room in each partition for
+   * the UBO and every scene instance's matrix.
    */
-  void createUniformBuffers();
+  void createFrameRing();
 
   /**
    * @brief Creates descriptor set layout (UBO + texture sampler).
@@ -463,14 +1270,22 @@ private:
   void createDescriptorSetLayout();
 
   /**
-   * @brief Copies GPU buffer → GPU buffer (e.g. staging → device-local).
+   * @brief Makes host bytes available as a transfer source for one upload.
+   *
+   * Imports the pages holding 'bytes' when they lie inside 'assetPack' and
+   * VK_EXT_external_memory_host is enabled, otherwise copies them into a
+   * range of 'stagingPool'. Copy it with 'uploadQueue', which releases it
+   * to the pool (a no-op for imported bytes), and hand 'importBuffer' and
+   * 'importMemory' to its keepAlive().
    *
-   * @param srcBuffer Source buffer
-   * @param dstBuffer Destination buffer
-   * @param size Size (bytes)
+   * @param bytes Data to upload; must stay alive until the copy completes.
+   * @param importBuffer Output buffer of imported pages (else unchanged)
+   * @param importMemory Output memory backing 'importBuffer'
+   * @return Buffer and offset of bytes[0].
    */
-  void copyBuffer(vk::raii::Buffer &srcBuffer, vk::raii::Buffer &dstBuffer,
-                  vk::DeviceSize size);
+  StagingPool::Range stageBytes(std::span<const std::byte> bytes,
+                                vk::raii::Buffer &importBuffer,
+                                GpuAllocation &importMemory);
 
   /**
    * @brief Creates GPU buffer (vertex/index/uniform).
@@ -479,20 +1294,59 @@ private:
    * @param usage Usage flags
    * @param properties Memory properties
    * @param buffer Output RAII VkBuffer
-   * @param bufferMemory Output device memory
+   * @param bufferMemory Output memory (sub-allocated, bound to 'buffer')
+   * @param lifetime eTransient for staging buffers freed after the upload
    */
-  void createBuffer(vk::DeviceSize size, vk::BufferUsageFlags usage,
-                    vk::MemoryPropertyFlags properties,
-                    vk::raii::Buffer &buffer,
-                    vk::raii::DeviceMemory &bufferMemory);
+  void createBuffer(
+      vk::DeviceSize size, vk::BufferUsageFlags usage,
+      vk::MemoryPropertyFlags properties, vk::raii::Buffer &buffer,
+      GpuAllocation &bufferMemory,
+      GpuAllocator::Usage lifetime = GpuAllocator::Usage::eGeneral);
 
   /**
-   * @brief Creates index buffer on GPU.
+   * @brief Reserves the model's vertex and index ranges in 'geometryArena',
+   * replacing the arena by a larger one when they do not fit.
+   */
+  void allocateModelGeometry();
+
+  /**
+   * @brief Uploads the indices into the model's index range.
    */
   void createIndexBuffer();
 
   /**
-   * @brief Creates vertex buffer on GPU.
+   * @brief Uploads the meshlets and creates the per-frame indirect draw and
+   * cull counter buffers.
+   */
+  void createMeshletBuffers();
+
+  /**
+   * @brief Creates the cull pass descriptor set layout and compute pipeline.
+   */
+  void createCullPipeline();
+
+  /**
+   * @brief Builds the cull compute pipeline from shaders/cull.spv. Safe to
+   * call from a worker thread once the cull pipeline layout exists.
+   *
+   * @return The pipeline.
+   */
+  vk::raii::Pipeline buildCullPipeline();
+
+  /**
+   * @brief Publishes the counters of this frame slot's previous cull pass to
+   * ChronoProfiler (must run after its fence was waited on).
+   */
+  void readCullCounters();
+
+  /**
+   * @brief Records the cull dispatch and the barriers that make its output
+   * visible to the indirect draw.
+   */
+  void recordCullPass();
+
+  /**
+   * @brief Uploads the packed vertices into the model's vertex range.
    */
   void createVertexBuffer();
 
@@ -559,12 +1413,32 @@ private:
   void createGraphicsPipeline();
 
   /**
-   * @brief Creates a Vulkan shader module from a SPIR-V file.
+   * @brief Builds the graphics pipeline for a vertex layout. Safe to call
+   * from a worker thread once 'pipelineLayout' exists.
+   *
+   * @param vertices Packed vertices whose layout the pipeline reads (any
+   * layout with vertex pulling).
+   * @return The pipeline.
+   */
+  vk::raii::Pipeline
+  buildGraphicsPipeline(const vertexformat::PackedVertices &vertices);
+
+  /**
+   * @brief Creates a Vulkan shader module from SPIR-V bytecode.
+   *
+   * @param code Binary SPIR-V shader bytecode (4-byte aligned)
+   * @return ShaderModule RAII handle
+   */
+  vk::raii::ShaderModule createShaderModule(std::span<const std::byte> code);
+
+  /**
+   * @brief Creates a shader module from the asset pack blob of 'path', or
+   * from the loose file when the pack does not have it.
    *
-   * @param code Binary SPIR-V shader bytecode
+   * @param path SPIR-V file, e.g. "shaders/frag.spv"
    * @return ShaderModule RAII handle
    */
-  vk::raii::ShaderModule createShaderModule(const std::vector<char> &code);
+  vk::raii::ShaderModule loadShaderModule(const std::string &path);
 
   /**
    * @brief Creates a Vulkan surface from GLFW window.
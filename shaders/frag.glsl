@@ -2,11 +2,16 @@
 
 layout(binding = 1) uniform sampler2D texSampler;
 
+// Diffuse color (MTL Kd) of the material being drawn
+layout(push_constant) uniform Material {
+    vec4 diffuse;
+} material;
+
 layout(location = 0) in vec3 fragColor;
 layout(location = 1) in vec2 fragTexCoord;
 
 layout(location = 0) out vec4 outColor;
 
 void main() {
-    outColor = texture(texSampler, fragTexCoord);
+    outColor = texture(texSampler, fragTexCoord) * material.diffuse;
 }
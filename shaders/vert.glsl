@@ -6,16 +6,31 @@ layout(binding = 0) uniform UniformBufferObject {
     mat4 proj;
 } ubo;
 
+// Quantized layouts feed unorm16 positions in [0, 1]; ubo.model is the
+// bounding box transform that maps them back to model space.
 layout(location = 0) in vec3 inPosition;
+#ifdef CONSTANT_COLOR
+// Layouts without a color attribute get the shared color as spec constants
+layout(constant_id = 0) const float colorR = 1.0;
+layout(constant_id = 1) const float colorG = 1.0;
+layout(constant_id = 2) const float colorB = 1.0;
+#else
 layout(location = 1) in vec3 inColor;
+#endif
 layout(location = 2) in vec2 inTexCoord;
+// Per-instance model matrix (binding 1): scene transform * rotation
+layout(location = 3) in mat4 inInstance;
 
 layout(location = 0) out vec3 fragColor;
 layout(location = 1) out vec2 fragTexCoord;
 
 void main() {
-    gl_Position = ubo.proj * ubo.view * ubo.model * vec4(inPosition, 1.0);
+    gl_Position =
+        ubo.proj * ubo.view * inInstance * ubo.model * vec4(inPosition, 1.0);
+#ifdef CONSTANT_COLOR
+    fragColor = vec3(colorR, colorG, colorB);
+#else
     fragColor = inColor;
+#endif
     fragTexCoord = inTexCoord;
 }
-
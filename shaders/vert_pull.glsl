@@ -0,0 +1,85 @@
+#version 450
+#extension GL_EXT_buffer_reference : require
+
+// Vertex pulling: the same pipeline draws every vertex layout. Vertices are
+// read from the geometry arena through its buffer device address and decoded
+// as described by vertexpull::PushConstants (VertexPulling.hpp).
+
+layout(binding = 0) uniform UniformBufferObject {
+    mat4 model;
+    mat4 view;
+    mat4 proj;
+} ubo;
+
+layout(buffer_reference, std430, buffer_reference_align = 4) readonly buffer Words {
+    uint words[];
+};
+
+// Bytes 0-15 hold the fragment shader's material color
+layout(push_constant) uniform VertexPull {
+    layout(offset = 16) Words vertices; // First byte of the geometry arena
+    uint format;       // vertexpull::describe() of the mesh's layout
+    uint reserved;
+    vec4 constantColor; // Color of layouts without one
+} pull;
+
+// Per-instance model matrix (binding 1): scene transform * rotation
+layout(location = 3) in mat4 inInstance;
+
+layout(location = 0) out vec3 fragColor;
+layout(location = 1) out vec2 fragTexCoord;
+
+// Must match vertexpull::k* in VertexPulling.hpp
+const uint POSITION_UNORM16 = 1u;
+const uint COLOR_FLOAT = 1u;
+const uint COLOR_UNORM8 = 2u;
+const uint TEXCOORD_UNORM16 = 1u;
+const uint TEXCOORD_HALF = 2u;
+
+uint word(uint byteOffset) {
+    return pull.vertices.words[byteOffset >> 2];
+}
+
+vec3 floats3(uint byteOffset) {
+    return uintBitsToFloat(uvec3(word(byteOffset), word(byteOffset + 4u),
+                                 word(byteOffset + 8u)));
+}
+
+void main() {
+    // gl_VertexIndex includes the draw's vertexOffset, which the arena
+    // expresses in vertices of this mesh's stride
+    uint base = uint(gl_VertexIndex) * (pull.format >> 24);
+    uint colorOffset = base + ((pull.format >> 8) & 0xFFu);
+    uint texCoordOffset = base + ((pull.format >> 16) & 0xFFu);
+
+    // Quantized positions are unorm16 in [0, 1]; ubo.model maps them back
+    vec3 position;
+    if ((pull.format & 3u) == POSITION_UNORM16) {
+        position = vec3(unpackUnorm2x16(word(base)),
+                        unpackUnorm2x16(word(base + 4u)).x);
+    } else {
+        position = floats3(base);
+    }
+
+    uint colorFormat = (pull.format >> 2) & 3u;
+    if (colorFormat == COLOR_FLOAT) {
+        fragColor = floats3(colorOffset);
+    } else if (colorFormat == COLOR_UNORM8) {
+        fragColor = unpackUnorm4x8(word(colorOffset)).rgb;
+    } else {
+        fragColor = pull.constantColor.rgb;
+    }
+
+    uint texCoordFormat = (pull.format >> 4) & 3u;
+    if (texCoordFormat == TEXCOORD_UNORM16) {
+        fragTexCoord = unpackUnorm2x16(word(texCoordOffset));
+    } else if (texCoordFormat == TEXCOORD_HALF) {
+        fragTexCoord = unpackHalf2x16(word(texCoordOffset));
+    } else {
+        fragTexCoord = uintBitsToFloat(uvec2(word(texCoordOffset),
+                                             word(texCoordOffset + 4u)));
+    }
+
+    gl_Position =
+        ubo.proj * ubo.view * inInstance * ubo.model * vec4(position, 1.0);
+}
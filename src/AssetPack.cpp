@@ -0,0 +1,190 @@
+/**
+ * @file AssetPack.cpp
+ * @brief Asset pack reading (mmap) and writing.
+ *
+ * @see AssetPack.hpp for the on-disk layout.
+ */
+#include "../include/AssetPack.hpp"
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <set>
+#include <stdexcept>
+#include <vector>
+
+#include "../include/MeshCache.hpp"
+#include "../include/TextureFile.hpp"
+
+namespace assetpack {
+
+namespace {
+
+/** @brief Rounds 'value' up to the next multiple of 'alignment'. */
+constexpr uint64_t alignUp(uint64_t value, uint64_t alignment) {
+  return (value + alignment - 1) / alignment * alignment;
+}
+
+/** @brief First word of every SPIR-V module. */
+constexpr uint32_t kSpirvMagic = 0x07230203;
+
+} // namespace
+
+const char *name(BlobType type) {
+  switch (type) {
+  case BlobType::eMeshCache:
+    return "mesh";
+  case BlobType::eTexture:
+    return "texture";
+  case BlobType::eShader:
+    return "shader";
+  case BlobType::eRaw:
+  default:
+    return "raw";
+  }
+}
+
+BlobType detectType(std::span<const std::byte> bytes) {
+  if (bytes.size() < 4) {
+    return BlobType::eRaw;
+  }
+  if (std::memcmp(bytes.data(), meshcache::kMagic, 4) == 0) {
+    return BlobType::eMeshCache;
+  }
+  if (std::memcmp(bytes.data(), artx::kMagic, 4) == 0) {
+    return BlobType::eTexture;
+  }
+  uint32_t word = 0;
+  std::memcpy(&word, bytes.data(), sizeof(word));
+  return word == kSpirvMagic ? BlobType::eShader : BlobType::eRaw;
+}
+
+/**
+ * @details Checks the header, that the table fits and that every blob is
+ * aligned and lies inside the file; blob contents are validated by their
+ * own loaders.
+ */
+std::optional<AssetPack> AssetPack::open(const std::string &path) {
+  if (!std::filesystem::exists(path)) {
+    return std::nullopt;
+  }
+
+  MappedFile file;
+  try {
+    file = MappedFile(path);
+  } catch (const std::exception &) {
+    return std::nullopt;
+  }
+
+  if (file.size() < sizeof(Header)) {
+    return std::nullopt;
+  }
+  const Header &header = *reinterpret_cast<const Header *>(file.data());
+  if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 ||
+      header.version != kVersion ||
+      header.entryCount > (file.size() - sizeof(Header)) / sizeof(Entry)) {
+    return std::nullopt;
+  }
+
+  const auto *entries =
+      reinterpret_cast<const Entry *>(file.data() + sizeof(Header));
+  for (uint64_t i = 0; i < header.entryCount; i++) {
+    if (entries[i].name[kMaxNameLength - 1] != '\0' ||
+        entries[i].offset % kBlobAlignment != 0 ||
+        entries[i].offset > file.size() ||
+        entries[i].size > file.size() - entries[i].offset) {
+      return std::nullopt;
+    }
+  }
+
+  return AssetPack(std::move(file));
+}
+
+std::span<const Entry> AssetPack::entries() const {
+  const Header &header = *reinterpret_cast<const Header *>(file.data());
+  return {reinterpret_cast<const Entry *>(file.data() + sizeof(Header)),
+          static_cast<size_t>(header.entryCount)};
+}
+
+std::span<const std::byte> AssetPack::blob(std::string_view name) const {
+  for (const Entry &entry : entries()) {
+    if (name == entry.name) {
+      return {file.data() + entry.offset, static_cast<size_t>(entry.size)};
+    }
+  }
+  return {};
+}
+
+void write(const std::string &path, std::span<const Input> inputs) {
+  std::vector<MappedFile> files;
+  std::vector<Entry> entries(inputs.size());
+  std::set<std::string> names;
+  uint64_t offset = alignUp(sizeof(Header) + inputs.size() * sizeof(Entry),
+                            kBlobAlignment);
+  for (size_t i = 0; i < inputs.size(); i++) {
+    if (inputs[i].name.size() >= kMaxNameLength) {
+      throw std::runtime_error("Asset pack entry name too long: " +
+                               inputs[i].name);
+    }
+    if (!names.insert(inputs[i].name).second) {
+      throw std::runtime_error("Duplicate asset pack entry: " +
+                               inputs[i].name);
+    }
+    if (!std::filesystem::exists(inputs[i].path)) {
+      throw std::runtime_error("Asset pack input not found: " +
+                               inputs[i].path);
+    }
+
+    files.emplace_back(inputs[i].path);
+    Entry &entry = entries[i];
+    std::memcpy(entry.name, inputs[i].name.data(), inputs[i].name.size());
+    entry.type = detectType(files.back().bytes());
+    entry.offset = offset;
+    entry.size = files.back().size();
+    offset = alignUp(offset + entry.size, kBlobAlignment);
+  }
+
+  Header header{};
+  std::memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.version = kVersion;
+  header.entryCount = entries.size();
+
+  const std::string tmpPath = path + ".tmp";
+  {
+    std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+      throw std::runtime_error("Failed to create asset pack: " + tmpPath);
+    }
+
+    const std::vector<char> padding(kBlobAlignment, 0);
+    auto padTo = [&](uint64_t target) {
+      const auto position = static_cast<uint64_t>(out.tellp());
+      out.write(padding.data(),
+                static_cast<std::streamsize>(target - position));
+    };
+
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char *>(entries.data()),
+              static_cast<std::streamsize>(entries.size() * sizeof(Entry)));
+    for (size_t i = 0; i < entries.size(); i++) {
+      padTo(entries[i].offset);
+      out.write(reinterpret_cast<const char *>(files[i].data()),
+                static_cast<std::streamsize>(files[i].size()));
+    }
+    // Pad the tail so page-rounded imports of the last blob stay in the file
+    padTo(offset);
+
+    if (!out.good()) {
+      throw std::runtime_error("Failed to write asset pack: " + tmpPath);
+    }
+  }
+
+  std::error_code ec;
+  std::filesystem::rename(tmpPath, path, ec);
+  if (ec) {
+    std::filesystem::remove(tmpPath, ec);
+    throw std::runtime_error("Failed to move asset pack into place: " + path);
+  }
+}
+
+} // namespace assetpack
@@ -0,0 +1,513 @@
+/**
+ * @file AsyncFileReader.cpp
+ * @brief io_uring and ThreadPool backends of the AsyncFileReader.
+ *
+ * The io_uring backend talks to the kernel through the raw syscalls and the
+ * ring layout from <linux/io_uring.h>, so no liburing dependency is needed.
+ * It uses IORING_OP_READV (Linux 5.1+).
+ *
+ * @see AsyncFileReader.hpp
+ */
+#include "../include/AsyncFileReader.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <new>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#endif
+
+namespace {
+
+/** @brief Rounds 'value' up to the next multiple of 'alignment'. */
+constexpr size_t alignUp(size_t value, size_t alignment) {
+  return (value + alignment - 1) / alignment * alignment;
+}
+
+/**
+ * @brief Opens a file for reading, bypassing the page cache if possible.
+ *
+ * @return Descriptor, or -1 with errno set.
+ */
+int openForRead(const std::string &path, bool direct) {
+#ifdef O_DIRECT
+  if (direct) {
+    int fd = ::open(path.c_str(), O_RDONLY | O_DIRECT | O_CLOEXEC);
+    if (fd >= 0 || errno != EINVAL) {
+      return fd;
+    }
+    // EINVAL: the file system (e.g. tmpfs) does not support O_DIRECT
+  }
+  return ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+#else
+  int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+#ifdef F_NOCACHE
+  if (fd >= 0 && direct) {
+    ::fcntl(fd, F_NOCACHE, 1);
+  }
+#endif
+  return fd;
+#endif
+}
+
+} // namespace
+
+AlignedBuffer::AlignedBuffer(size_t size) : capacity(size) {
+  if (size == 0) {
+    return;
+  }
+  constexpr size_t kHugePage = 2u << 20;
+  const size_t alignment =
+      size >= kHugePage ? kHugePage : AsyncFileReader::kAlignment;
+  storage = std::unique_ptr<std::byte[], Deleter>(
+      static_cast<std::byte *>(
+          ::operator new(size, std::align_val_t{alignment})),
+      Deleter{alignment});
+#ifdef MADV_HUGEPAGE
+  if (alignment == kHugePage) {
+    ::madvise(storage.get(), size, MADV_HUGEPAGE);
+  }
+#endif
+}
+
+void AlignedBuffer::Deleter::operator()(std::byte *bytes) const {
+  ::operator delete(bytes, std::align_val_t{alignment});
+}
+
+#ifdef __linux__
+
+/**
+ * @struct AsyncFileReader::Ring
+ * @brief Mapped submission/completion rings of one io_uring instance.
+ *
+ * Only the owning reader writes the submission queue (under its mutex) and
+ * only the reaping thread reads the completion queue, so the shared indices
+ * need nothing stronger than acquire/release ordering.
+ */
+struct AsyncFileReader::Ring {
+  int fd = -1;
+  void *sqRing = MAP_FAILED;
+  size_t sqRingSize = 0;
+  void *cqRing = MAP_FAILED;
+  size_t cqRingSize = 0;
+  io_uring_sqe *sqes = static_cast<io_uring_sqe *>(MAP_FAILED);
+  size_t sqesSize = 0;
+
+  unsigned *sqHead = nullptr, *sqTail = nullptr, *sqMask = nullptr;
+  unsigned *sqArray = nullptr;
+  unsigned sqEntries = 0;
+  unsigned *cqHead = nullptr, *cqTail = nullptr, *cqMask = nullptr;
+  io_uring_cqe *cqes = nullptr;
+
+  /**
+   * @brief Sets up a ring with at least 'entries' submission slots.
+   *
+   * @return The ring, or nullptr if io_uring is unavailable.
+   */
+  static std::unique_ptr<Ring> create(uint32_t entries) {
+    io_uring_params params{};
+    int ringFd =
+        static_cast<int>(::syscall(__NR_io_uring_setup, entries, &params));
+    if (ringFd < 0) {
+      return nullptr; // ENOSYS, or blocked by seccomp/sysctl
+    }
+
+    auto ring = std::make_unique<Ring>();
+    ring->fd = ringFd;
+    ring->sqRingSize =
+        params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    ring->cqRingSize =
+        params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    const bool singleMmap = params.features & IORING_FEAT_SINGLE_MMAP;
+    if (singleMmap) {
+      ring->sqRingSize = ring->cqRingSize =
+          std::max(ring->sqRingSize, ring->cqRingSize);
+    }
+
+    ring->sqRing =
+        ::mmap(nullptr, ring->sqRingSize, PROT_READ | PROT_WRITE,
+               MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_SQ_RING);
+    if (ring->sqRing == MAP_FAILED) {
+      return nullptr;
+    }
+    if (singleMmap) {
+      ring->cqRing = ring->sqRing;
+    } else {
+      ring->cqRing =
+          ::mmap(nullptr, ring->cqRingSize, PROT_READ | PROT_WRITE,
+                 MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_CQ_RING);
+      if (ring->cqRing == MAP_FAILED) {
+        return nullptr;
+      }
+    }
+    ring->sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+    void *sqes = ::mmap(nullptr, ring->sqesSize, PROT_READ | PROT_WRITE,
+                        MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_SQES);
+    if (sqes == MAP_FAILED) {
+      return nullptr;
+    }
+    ring->sqes = static_cast<io_uring_sqe *>(sqes);
+
+    auto *sq = static_cast<char *>(ring->sqRing);
+    auto *cq = static_cast<char *>(ring->cqRing);
+    ring->sqHead = reinterpret_cast<unsigned *>(sq + params.sq_off.head);
+    ring->sqTail = reinterpret_cast<unsigned *>(sq + params.sq_off.tail);
+    ring->sqMask = reinterpret_cast<unsigned *>(sq + params.sq_off.ring_mask);
+    ring->sqArray = reinterpret_cast<unsigned *>(sq + params.sq_off.array);
+    ring->sqEntries = params.sq_entries;
+    ring->cqHead = reinterpret_cast<unsigned *>(cq + params.cq_off.head);
+    ring->cqTail = reinterpret_cast<unsigned *>(cq + params.cq_off.tail);
+    ring->cqMask = reinterpret_cast<unsigned *>(cq + params.cq_off.ring_mask);
+    ring->cqes = reinterpret_cast<io_uring_cqe *>(cq + params.cq_off.cqes);
+    return ring;
+  }
+
+  ~Ring() {
+    if (sqes != MAP_FAILED) {
+      ::munmap(sqes, sqesSize);
+    }
+    if (cqRing != MAP_FAILED && cqRing != sqRing) {
+      ::munmap(cqRing, cqRingSize);
+    }
+    if (sqRing != MAP_FAILED) {
+      ::munmap(sqRing, sqRingSize);
+    }
+    if (fd >= 0) {
+      ::close(fd);
+    }
+  }
+
+  /**
+   * @brief Appends a readv of 'block' to the submission queue.
+   *
+   * @return False if the queue is full.
+   */
+  bool push(Block &block) {
+    const unsigned tail = *sqTail;
+    const unsigned head =
+        std::atomic_ref(*sqHead).load(std::memory_order_acquire);
+    if (tail - head == sqEntries) {
+      return false;
+    }
+    const unsigned index = tail & *sqMask;
+    io_uring_sqe &sqe = sqes[index];
+    std::memset(&sqe, 0, sizeof(sqe));
+    block.iov = {block.dst, block.length};
+    sqe.opcode = IORING_OP_READV;
+    sqe.fd = block.fd;
+    sqe.off = block.offset;
+    sqe.addr = reinterpret_cast<uint64_t>(&block.iov);
+    sqe.len = 1;
+    sqe.user_data = reinterpret_cast<uint64_t>(&block);
+    sqArray[index] = index;
+    std::atomic_ref(*sqTail).store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * @brief Submits queued entries and optionally waits for a completion.
+   *
+   * @throws std::runtime_error On an unexpected io_uring_enter() failure.
+   */
+  void enter(unsigned toSubmit, unsigned minComplete) {
+    const unsigned flags = minComplete ? IORING_ENTER_GETEVENTS : 0;
+    for (;;) {
+      long submitted = ::syscall(__NR_io_uring_enter, fd, toSubmit,
+                                 minComplete, flags, nullptr, 0);
+      if (submitted >= 0) {
+        toSubmit -= std::min<unsigned>(toSubmit, submitted);
+        if (toSubmit == 0) {
+          return;
+        }
+      } else if (errno != EINTR && errno != EAGAIN && errno != EBUSY) {
+        throw std::runtime_error(std::string("io_uring_enter failed: ") +
+                                 std::strerror(errno));
+      }
+    }
+  }
+
+  /**
+   * @brief Pops every available completion.
+   *
+   * @param visit Called with (block, result) for each completion.
+   */
+  template <typename F> void reap(F &&visit) {
+    unsigned head = *cqHead;
+    const unsigned tail =
+        std::atomic_ref(*cqTail).load(std::memory_order_acquire);
+    for (; head != tail; head++) {
+      const io_uring_cqe &cqe = cqes[head & *cqMask];
+      visit(*reinterpret_cast<Block *>(cqe.user_data),
+            static_cast<int64_t>(cqe.res));
+    }
+    std::atomic_ref(*cqHead).store(head, std::memory_order_release);
+  }
+};
+
+#else
+
+/** @brief Placeholder: io_uring is Linux only. */
+struct AsyncFileReader::Ring {
+  static std::unique_ptr<Ring> create(uint32_t) { return nullptr; }
+  bool push(Block &) { return false; }
+  void enter(unsigned, unsigned) {}
+  template <typename F> void reap(F &&) {}
+};
+
+#endif
+
+AsyncFileReader::AsyncFileReader(const Options &readerOptions)
+    : options(readerOptions) {
+  options.queueDepth = std::max(1u, options.queueDepth);
+  options.blockSize = static_cast<uint32_t>(
+      alignUp(std::max<size_t>(options.blockSize, kAlignment), kAlignment));
+  if (!options.forceThreadPool) {
+    ring = Ring::create(options.queueDepth);
+  }
+  if (!ring) {
+    pool = std::make_unique<ThreadPool>(options.threadPoolThreads);
+  }
+}
+
+/**
+ * @details The kernel (or a reader thread) may still be writing into the
+ * buffers of unfinished requests, so every request is run to completion
+ * before anything is released.
+ */
+AsyncFileReader::~AsyncFileReader() {
+  std::unique_lock<std::mutex> lock(mutex);
+  auto unfinished = [this]() {
+    return std::any_of(requests.begin(), requests.end(),
+                       [](const auto &entry) {
+                         return entry.second.remaining > 0;
+                       });
+  };
+  while (unfinished()) {
+    if (ring) {
+      driveRing(lock);
+    } else {
+      completed.wait(lock);
+    }
+  }
+  lock.unlock();
+  pool.reset();
+}
+
+std::string AsyncFileReader::backendName() const {
+  std::string name = ring ? "io_uring" : "thread pool";
+  return options.direct ? name + " (direct)" : name;
+}
+
+/**
+ * @details The destination buffer is rounded up to kAlignment and every
+ * block but the last is exactly Options::blockSize, so offsets, lengths and
+ * addresses all satisfy O_DIRECT; the final block simply reads short at
+ * end of file.
+ */
+AsyncFileReader::RequestId AsyncFileReader::submit(const std::string &path) {
+  const int fd = openForRead(path, options.direct);
+  if (fd < 0) {
+    throw std::runtime_error("Failed to open file: " + path);
+  }
+  struct stat st {};
+  if (::fstat(fd, &st) != 0) {
+    ::close(fd);
+    throw std::runtime_error("Failed to stat file: " + path);
+  }
+
+  std::unique_lock<std::mutex> lock(mutex);
+  const RequestId id = nextId++;
+  Request &request = requests[id];
+  request.path = path;
+  request.fd = fd;
+  request.size = static_cast<size_t>(st.st_size);
+  request.buffer = AlignedBuffer(alignUp(request.size, kAlignment));
+
+  const size_t blockCount =
+      (request.buffer.size() + options.blockSize - 1) / options.blockSize;
+  request.blocks.resize(blockCount);
+  request.remaining = blockCount;
+  for (size_t i = 0; i < blockCount; i++) {
+    Block &block = request.blocks[i];
+    block.id = id;
+    block.fd = fd;
+    block.offset = i * static_cast<uint64_t>(options.blockSize);
+    block.dst = request.buffer.data() + block.offset;
+    block.length = std::min<size_t>(options.blockSize,
+                                    request.buffer.size() - block.offset);
+    queuedBlocks.push_back(&block);
+  }
+
+  if (blockCount == 0) {
+    ::close(fd);
+    request.fd = -1;
+    finished.push_back(id);
+    completed.notify_all();
+  }
+  submitBlocksLocked();
+  return id;
+}
+
+/**
+ * @details io_uring: fills free submission slots up to Options::queueDepth
+ * and submits them with one io_uring_enter(). Thread pool: hands every
+ * queued block to a reader thread, which performs a blocking pread and
+ * reports back under the mutex.
+ */
+void AsyncFileReader::submitBlocksLocked() {
+  if (!ring) {
+    for (Block *block : queuedBlocks) {
+      pool->submit([this, block]() {
+        const ssize_t result = ::pread(block->fd, block->dst, block->length,
+                                       static_cast<off_t>(block->offset));
+        std::lock_guard<std::mutex> lock(mutex);
+        completeBlockLocked(*block, result < 0 ? -errno : result);
+      });
+    }
+    queuedBlocks.clear();
+    return;
+  }
+
+  unsigned pushed = 0;
+  while (!queuedBlocks.empty() && inFlight < options.queueDepth &&
+         ring->push(*queuedBlocks.front())) {
+    queuedBlocks.pop_front();
+    inFlight++;
+    pushed++;
+  }
+  if (pushed > 0) {
+    ring->enter(pushed, 0);
+  }
+}
+
+void AsyncFileReader::completeBlockLocked(Block &block, int64_t result) {
+  Request &request = requests.at(block.id);
+  if (result == -EINTR || result == -EAGAIN) {
+    result = 0; // Transient: retry the whole block
+  } else if (result < 0) {
+    request.error = request.error ? request.error : static_cast<int>(-result);
+    result = static_cast<int64_t>(block.length); // Give up on this block
+  } else if (result == 0 && block.offset < request.size) {
+    request.error = request.error ? request.error : EIO; // File shrank
+    result = static_cast<int64_t>(block.length);
+  }
+
+  block.offset += static_cast<uint64_t>(result);
+  block.dst += result;
+  block.length -= static_cast<size_t>(result);
+  if (block.length > 0 && block.offset < request.size) {
+    // Short read before end of file: read the rest of the block
+    queuedBlocks.push_back(&block);
+    if (!ring) {
+      submitBlocksLocked();
+    }
+    return;
+  }
+
+  if (--request.remaining == 0) {
+    ::close(request.fd);
+    request.fd = -1;
+    finished.push_back(block.id);
+    completed.notify_all();
+  }
+}
+
+/**
+ * @details Only one thread at a time waits inside io_uring_enter(); the
+ * others sleep on 'completed' and are woken once it has reaped, so a
+ * completion is never consumed twice and the mutex is never held across the
+ * blocking syscall.
+ */
+void AsyncFileReader::driveRing(std::unique_lock<std::mutex> &lock) {
+  if (reaping) {
+    completed.wait(lock);
+    return;
+  }
+  reaping = true;
+  const bool wait = inFlight > 0;
+  lock.unlock();
+  try {
+    if (wait) {
+      ring->enter(0, 1);
+    }
+  } catch (...) {
+    lock.lock();
+    reaping = false;
+    throw;
+  }
+  lock.lock();
+  ring->reap([this](Block &block, int64_t result) {
+    inFlight--;
+    completeBlockLocked(block, result);
+  });
+  submitBlocksLocked();
+  reaping = false;
+  completed.notify_all();
+}
+
+AsyncFileReader::Result AsyncFileReader::takeLocked(RequestId id) {
+  auto it = requests.find(id);
+  Request &request = it->second;
+  const int error = request.error;
+  Result result;
+  result.id = id;
+  result.path = std::move(request.path);
+  result.buffer = std::move(request.buffer);
+  result.size = request.size;
+  requests.erase(it);
+  finished.erase(std::find(finished.begin(), finished.end(), id));
+  if (error != 0) {
+    throw std::runtime_error("Failed to read file: " + result.path + " (" +
+                             std::strerror(error) + ")");
+  }
+  return result;
+}
+
+AsyncFileReader::Result AsyncFileReader::wait(RequestId id) {
+  std::unique_lock<std::mutex> lock(mutex);
+  for (;;) {
+    auto it = requests.find(id);
+    if (it == requests.end()) {
+      throw std::runtime_error("Unknown or already taken file read request");
+    }
+    if (it->second.remaining == 0) {
+      return takeLocked(id);
+    }
+    if (ring) {
+      driveRing(lock);
+    } else {
+      completed.wait(lock);
+    }
+  }
+}
+
+AsyncFileReader::Result AsyncFileReader::waitAny() {
+  std::unique_lock<std::mutex> lock(mutex);
+  for (;;) {
+    if (!finished.empty()) {
+      return takeLocked(finished.front());
+    }
+    if (requests.empty()) {
+      throw std::runtime_error("No file read requests pending");
+    }
+    if (ring) {
+      driveRing(lock);
+    } else {
+      completed.wait(lock);
+    }
+  }
+}
+
+size_t AsyncFileReader::pending() const {
+  std::lock_guard<std::mutex> lock(mutex);
+  return requests.size();
+}
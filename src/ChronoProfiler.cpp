@@ -48,6 +48,12 @@ std::mutex ChronoProfiler::threadNamesMutex;
  * vector. */
 std::mutex ChronoProfiler::mergeMutex;
 
+/** @brief Latest value of every named counter. */
+std::vector<ChronoProfiler::Counter> ChronoProfiler::counters;
+
+/** @brief Mutex protecting the counters list. */
+std::mutex ChronoProfiler::countersMutex;
+
 /** @brief Timestamp indicating the start of the current frame. */
 std::chrono::high_resolution_clock::time_point ChronoProfiler::frameStart;
 
@@ -209,12 +215,45 @@ std::string ChronoProfiler::getThreadName(uint32_t threadId) {
              : "<unnamed>"; // return name if found, else "<unnamed>"
 }
 
+/**
+ * @brief Set the latest value of a named counter.
+ * @param name Counter name (caller-owned string)
+ * @param value New value
+ * @param category Grouping in the JSON export (caller-owned string)
+ *
+ * @details Counters are few (a handful per application), so a linear search
+ *          over the list is cheaper than a map and keeps creation order.
+ */
+void ChronoProfiler::setCounter(std::string_view name, double value,
+                                std::string_view category) {
+  std::lock_guard<std::mutex> lock(countersMutex);
+  for (auto &counter : counters) {
+    if (counter.name == name) {
+      counter.value = value;
+      counter.category = category;
+      return;
+    }
+  }
+  counters.push_back({name, value, category});
+}
+
+/**
+ * @brief Snapshot of all counters.
+ * @return Copy of the counters list (safe to use across frames)
+ */
+std::vector<ChronoProfiler::Counter> ChronoProfiler::getCounters() {
+  std::lock_guard<std::mutex> lock(countersMutex);
+  return counters;
+}
+
 /**
  * @brief Export current frame events to a JSON file.
  * @param filename Path to output JSON file
  *
  * @details Each Event object is serialized with name, timestamps, duration,
- *          thread ID, thread name, color, and category.
+ *          thread ID, thread name, color, and category. Counters follow as
+ *          entries with a "value" field and their category ("counter"
+ *          unless set otherwise, e.g. "memory" for heap usage and budget).
  */
 void ChronoProfiler::exportToJSON(const std::string &filename) {
   nlohmann::json j; // JSON array to store all frame events
@@ -230,6 +269,12 @@ void ChronoProfiler::exportToJSON(const std::string &filename) {
                  {"category", evt.category}});
   }
 
+  for (const auto &counter : getCounters()) {
+    j.push_back({{"name", counter.name},
+                 {"value", counter.value},
+                 {"category", counter.category}});
+  }
+
   std::ofstream ofs(filename); // open the file for writing
   if (ofs.is_open()) {
     ofs << std::setw(2) << j << std::endl; // write formatted JSON to file
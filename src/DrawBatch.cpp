@@ -0,0 +1,86 @@
+/**
+ * @file DrawBatch.cpp
+ * @brief Draw list sorting (radix sort on 64-bit keys) and bind counting.
+ *
+ * @see DrawBatch.hpp for the key layout.
+ */
+#include "../include/DrawBatch.hpp"
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+namespace drawbatch {
+
+/**
+ * @details
+ * Short lists (the usual per-frame case) use std::stable_sort. Longer ones
+ * use an LSD radix sort with 8-bit digits: one pass builds the histograms of
+ * all eight digits, then each digit is a stable scatter between the list
+ * and a scratch buffer. Digits that are equal in every key (typically the
+ * pipeline byte and the high descriptor bytes) are skipped, so a list
+ * spanning a few pipelines and materials takes three or four passes.
+ */
+void sort(std::span<DrawItem> items) {
+  if (items.size() < kRadixThreshold) {
+    std::stable_sort(items.begin(), items.end(),
+                     [](const DrawItem &a, const DrawItem &b) {
+                       return a.key < b.key;
+                     });
+    return;
+  }
+
+  constexpr int kDigits = 8;
+  std::array<std::array<size_t, 256>, kDigits> counts{};
+  for (const DrawItem &item : items) {
+    for (int digit = 0; digit < kDigits; digit++) {
+      counts[digit][(item.key >> (8 * digit)) & 0xFF]++;
+    }
+  }
+
+  std::vector<DrawItem> scratch(items.size());
+  std::span<DrawItem> from = items;
+  std::span<DrawItem> to = scratch;
+  for (int digit = 0; digit < kDigits; digit++) {
+    const int shift = 8 * digit;
+    std::array<size_t, 256> &count = counts[digit];
+    if (count[(items[0].key >> shift) & 0xFF] == items.size()) {
+      continue; // Same digit in every key
+    }
+
+    size_t offset = 0;
+    for (size_t &bucket : count) {
+      const size_t size = bucket;
+      bucket = offset;
+      offset += size;
+    }
+    for (const DrawItem &item : from) {
+      to[count[(item.key >> shift) & 0xFF]++] = item;
+    }
+    std::swap(from, to);
+  }
+
+  if (from.data() != items.data()) {
+    std::copy(from.begin(), from.end(), items.begin());
+  }
+}
+
+StateChanges countStateChanges(std::span<const DrawItem> items) {
+  StateChanges changes;
+  for (size_t i = 0; i < items.size(); i++) {
+    const uint64_t key = items[i].key;
+    const bool newPipeline =
+        i == 0 || pipelineOf(key) != pipelineOf(items[i - 1].key);
+    const bool newDescriptor =
+        newPipeline || descriptorOf(key) != descriptorOf(items[i - 1].key);
+    const bool newMaterial =
+        newPipeline || materialOf(key) != materialOf(items[i - 1].key);
+    changes.pipelineBinds += newPipeline;
+    changes.descriptorBinds += newDescriptor;
+    changes.materialBinds += newMaterial;
+    changes.drawCalls++;
+  }
+  return changes;
+}
+
+} // namespace drawbatch
@@ -0,0 +1,173 @@
+/**
+ * @file FileWatcher.cpp
+ * @brief inotify and polling backends of the FileWatcher.
+ *
+ * @see FileWatcher.hpp
+ */
+#include "../include/FileWatcher.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <filesystem>
+#include <tuple>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#endif
+
+namespace {
+
+/** @brief Size and mtime of a file (zero if it cannot be stat'ed). */
+std::pair<uint64_t, int64_t> statFile(const std::string &path) {
+  std::error_code ec;
+  const uintmax_t size = std::filesystem::file_size(path, ec);
+  if (ec) {
+    return {0, 0};
+  }
+  const auto mtime = std::filesystem::last_write_time(path, ec);
+  if (ec) {
+    return {0, 0};
+  }
+  return {static_cast<uint64_t>(size),
+          static_cast<int64_t>(mtime.time_since_epoch().count())};
+}
+
+} // namespace
+
+FileWatcher::FileWatcher(const Options &watcherOptions)
+    : options(watcherOptions), lastScan(Clock::now()) {
+#ifdef __linux__
+  if (!options.forcePolling) {
+    fd = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  }
+#endif
+}
+
+FileWatcher::~FileWatcher() {
+  if (fd >= 0) {
+    ::close(fd);
+  }
+}
+
+const char *FileWatcher::backendName() const {
+  return backend() == Backend::eInotify ? "inotify" : "polling";
+}
+
+/**
+ * @details Paths are compared in lexically normal form, so "shaders/a.spv"
+ * and "./shaders/a.spv" are the same file. If inotify refuses the directory
+ * (watch limit, missing directory) the watcher falls back to polling for
+ * every file rather than silently missing this one.
+ */
+void FileWatcher::watch(const std::string &path) {
+  const std::filesystem::path normal =
+      std::filesystem::path(path).lexically_normal();
+  File file;
+  file.path = path;
+  file.directory = normal.parent_path().generic_string();
+  if (file.directory.empty()) {
+    file.directory = ".";
+  }
+  file.name = normal.filename().generic_string();
+  if (std::any_of(files.begin(), files.end(), [&](const File &watched) {
+        return watched.directory == file.directory && watched.name == file.name;
+      })) {
+    return;
+  }
+  std::tie(file.size, file.mtime) = statFile(path);
+
+#ifdef __linux__
+  const bool directoryWatched = std::any_of(
+      directories.begin(), directories.end(),
+      [&](const auto &entry) { return entry.second == file.directory; });
+  if (fd >= 0 && !directoryWatched) {
+    const int wd = ::inotify_add_watch(fd, file.directory.c_str(),
+                                       IN_CLOSE_WRITE | IN_MOVED_TO);
+    if (wd >= 0) {
+      directories[wd] = file.directory;
+    } else {
+      ::close(fd); // Polling covers every file from now on
+      fd = -1;
+      directories.clear();
+    }
+  }
+#endif
+  files.push_back(std::move(file));
+}
+
+/**
+ * @details inotify events carry the file name relative to the watched
+ * directory; names of unwatched files are ignored. A queue overflow loses
+ * events, so every file is treated as changed.
+ */
+void FileWatcher::readEvents() {
+#ifdef __linux__
+  alignas(inotify_event) char buffer[16384];
+  for (;;) {
+    const ssize_t length = ::read(fd, buffer, sizeof(buffer));
+    if (length <= 0) {
+      break; // EAGAIN: queue drained
+    }
+    const Clock::time_point now = Clock::now();
+    for (ssize_t offset = 0; offset < length;) {
+      const auto *event =
+          reinterpret_cast<const inotify_event *>(buffer + offset);
+      offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+
+      if (event->mask & IN_Q_OVERFLOW) {
+        for (File &file : files) {
+          file.changed = true;
+          file.lastEvent = now;
+        }
+        continue;
+      }
+      auto directory = directories.find(event->wd);
+      if (directory == directories.end() || event->len == 0) {
+        continue;
+      }
+      for (File &file : files) {
+        if (file.directory == directory->second && file.name == event->name) {
+          file.changed = true;
+          file.lastEvent = now;
+        }
+      }
+    }
+  }
+#endif
+}
+
+void FileWatcher::scanFiles() {
+  const Clock::time_point now = Clock::now();
+  if (now - lastScan < options.pollInterval) {
+    return;
+  }
+  lastScan = now;
+  for (File &file : files) {
+    const auto [size, mtime] = statFile(file.path);
+    if (size != file.size || mtime != file.mtime) {
+      file.size = size;
+      file.mtime = mtime;
+      file.changed = true;
+      file.lastEvent = now;
+    }
+  }
+}
+
+std::vector<std::string> FileWatcher::poll() {
+  if (fd >= 0) {
+    readEvents();
+  } else {
+    scanFiles();
+  }
+
+  std::vector<std::string> changed;
+  const Clock::time_point now = Clock::now();
+  for (File &file : files) {
+    if (file.changed && now - file.lastEvent >= options.settle) {
+      file.changed = false;
+      changed.push_back(file.path);
+    }
+  }
+  return changed;
+}
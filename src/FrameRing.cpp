@@ -0,0 +1,54 @@
+/**
+ * @file FrameRing.cpp
+ * @brief Per-frame bump allocation in a mapped buffer.
+ *
+ * @see FrameRing.hpp
+ */
+#include "../include/FrameRing.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+FrameRing::FrameRing(void *mapped, uint64_t capacity, uint32_t frameCount,
+                     uint64_t alignment)
+    : base(static_cast<std::byte *>(mapped)), frames(frameCount),
+      align(std::max<uint64_t>(alignment, 1)) {
+  if (mapped == nullptr) {
+    throw std::runtime_error("Frame ring buffer is not mapped");
+  }
+  if ((align & (align - 1)) != 0) {
+    throw std::runtime_error("Frame ring alignment must be a power of two");
+  }
+  partition = frameCount > 0 ? (capacity / frameCount) & ~(align - 1) : 0;
+  if (partition == 0) {
+    throw std::runtime_error("Frame ring buffer too small for " +
+                             std::to_string(frameCount) + " frames");
+  }
+}
+
+void FrameRing::begin(uint32_t frameIndex) {
+  peak = std::max(peak, used());
+  frame = frameIndex % frames;
+  top = partition * frame;
+}
+
+/**
+ * @details Sizes are rounded up to the alignment, so the next range starts
+ * aligned and the bump is a single add. A full partition is a
+ * configuration error (FRAME_RING_BYTES too small for the scene) rather
+ * than something to recover from mid-frame.
+ */
+FrameRing::Allocation FrameRing::allocate(uint64_t size) {
+  const uint64_t rounded = (size + align - 1) & ~(align - 1);
+  const uint64_t end = partition * (frame + 1);
+  if (rounded > end - top) {
+    throw std::runtime_error(
+        "Frame ring partition full: " + std::to_string(used()) + " of " +
+        std::to_string(partition) + " bytes used, " + std::to_string(size) +
+        " requested");
+  }
+  const Allocation range{top, base + top};
+  top += rounded;
+  return range;
+}
@@ -0,0 +1,136 @@
+/**
+ * @file GeometryArena.cpp
+ * @brief Shared vertex and index buffers sub-allocated per mesh.
+ *
+ * @see GeometryArena.hpp
+ */
+#include "../include/GeometryArena.hpp"
+
+#include <iostream>
+#include <stdexcept>
+#include <utility>
+
+GeometryArena::Mesh::Mesh(Mesh &&other) noexcept
+    : arena(std::exchange(other.arena, nullptr)), vertices(other.vertices),
+      indices(other.indices), baseVertex(other.baseVertex),
+      vertexStride(other.vertexStride), indexTotal(other.indexTotal) {}
+
+GeometryArena::Mesh &GeometryArena::Mesh::operator=(Mesh &&other) noexcept {
+  if (this != &other) {
+    reset();
+    arena = std::exchange(other.arena, nullptr);
+    vertices = other.vertices;
+    indices = other.indices;
+    baseVertex = other.baseVertex;
+    vertexStride = other.vertexStride;
+    indexTotal = other.indexTotal;
+  }
+  return *this;
+}
+
+void GeometryArena::Mesh::reset() {
+  if (arena != nullptr) {
+    arena->free(*this);
+    arena = nullptr;
+  }
+}
+
+GeometryArena::GeometryArena(const vk::raii::Device &logicalDevice,
+                             GpuAllocator &gpuAllocator,
+                             vk::DeviceSize vertexBytes, uint32_t indexCount,
+                             bool deviceAddress)
+    : vertexRanges(vertexBytes), indexRanges(indexCount) {
+  vk::BufferCreateInfo bufferInfo{};
+  bufferInfo.size = vertexBytes;
+  bufferInfo.usage = vk::BufferUsageFlagBits::eVertexBuffer |
+                     vk::BufferUsageFlagBits::eTransferDst;
+  if (deviceAddress) {
+    bufferInfo.usage |= vk::BufferUsageFlagBits::eStorageBuffer |
+                        vk::BufferUsageFlagBits::eShaderDeviceAddress;
+  }
+  bufferInfo.sharingMode = vk::SharingMode::eExclusive;
+  vertices = vk::raii::Buffer(logicalDevice, bufferInfo);
+  vertexMemory =
+      gpuAllocator.allocate(vertices, vk::MemoryPropertyFlagBits::eDeviceLocal,
+                            GpuAllocator::Category::eVertex);
+  if (deviceAddress) {
+    vertexBase = logicalDevice.getBufferAddress(
+        vk::BufferDeviceAddressInfo{*vertices});
+  }
+
+  bufferInfo.size = sizeof(uint32_t) * static_cast<vk::DeviceSize>(indexCount);
+  bufferInfo.usage = vk::BufferUsageFlagBits::eIndexBuffer |
+                     vk::BufferUsageFlagBits::eTransferDst;
+  indices = vk::raii::Buffer(logicalDevice, bufferInfo);
+  indexMemory =
+      gpuAllocator.allocate(indices, vk::MemoryPropertyFlagBits::eDeviceLocal,
+                            GpuAllocator::Category::eIndex);
+}
+
+GeometryArena::~GeometryArena() {
+  if (meshCount > 0) {
+    std::cerr << "Warning: geometry arena destroyed with " << meshCount
+              << " live meshes" << std::endl;
+  }
+}
+
+/**
+ * @details Power-of-two strides are passed to the TLSF as the alignment.
+ * Other strides (e.g. 12 or 20 bytes of a quantized layout) cannot be, so
+ * the range is over-allocated by stride - 1 bytes and its first vertex
+ * starts at the next multiple of the stride inside it.
+ */
+GeometryArena::Mesh GeometryArena::allocate(uint32_t vertexCount,
+                                            uint32_t stride,
+                                            uint32_t indexCount) {
+  if (stride == 0) {
+    throw std::runtime_error("Geometry arena: vertex stride must not be 0");
+  }
+  const bool powerOfTwo = (stride & (stride - 1)) == 0;
+  const uint64_t bytes = static_cast<uint64_t>(vertexCount) * stride;
+
+  std::lock_guard<std::mutex> lock(mutex);
+  const TlsfAllocator::Allocation vertexRange =
+      powerOfTwo ? vertexRanges.allocate(bytes, stride)
+                 : vertexRanges.allocate(bytes + stride - 1, 4);
+  if (vertexRange.offset == TlsfAllocator::kNoSpace) {
+    return nullptr;
+  }
+  const TlsfAllocator::Allocation indexRange =
+      indexRanges.allocate(indexCount, 1);
+  if (indexRange.offset == TlsfAllocator::kNoSpace) {
+    vertexRanges.free(vertexRange);
+    return nullptr;
+  }
+
+  Mesh mesh;
+  mesh.arena = this;
+  mesh.vertices = vertexRange;
+  mesh.indices = indexRange;
+  mesh.baseVertex =
+      static_cast<int32_t>((vertexRange.offset + stride - 1) / stride);
+  mesh.vertexStride = stride;
+  mesh.indexTotal = indexCount;
+  meshCount++;
+  return mesh;
+}
+
+void GeometryArena::free(const Mesh &mesh) {
+  std::lock_guard<std::mutex> lock(mutex);
+  vertexRanges.free(mesh.vertices);
+  indexRanges.free(mesh.indices);
+  meshCount--;
+}
+
+GeometryArena::Stats GeometryArena::stats() const {
+  std::lock_guard<std::mutex> lock(mutex);
+  Stats stats;
+  stats.meshCount = meshCount;
+  stats.vertexBytes = vertexRanges.capacity();
+  stats.vertexUsed = vertexRanges.used();
+  stats.indexCount = indexRanges.capacity();
+  stats.indexUsed = indexRanges.used();
+  stats.vertexFreeBlocks = vertexRanges.freeBlockCount();
+  stats.indexFreeBlocks = indexRanges.freeBlockCount();
+  return stats;
+}
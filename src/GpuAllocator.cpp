@@ -0,0 +1,415 @@
+/**
+ * @file GpuAllocator.cpp
+ * @brief Block-based device memory sub-allocator.
+ *
+ * @see GpuAllocator.hpp
+ */
+#include "../include/GpuAllocator.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+
+/**
+ * @struct GpuAllocator::Block
+ * @brief One vkAllocateMemory allocation: a pool block or a dedicated
+ * allocation.
+ */
+struct GpuAllocator::Block {
+  vk::raii::DeviceMemory memory = nullptr; ///< Owned device memory
+  vk::DeviceSize size = 0;                 ///< Allocation size
+  uint32_t memoryType = 0;                 ///< Memory type index
+  void *mapped = nullptr;                  ///< Persistent mapping, if any
+  Pool *pool = nullptr;                    ///< Owning pool (null: dedicated)
+  std::unique_ptr<TlsfAllocator> tlsf;     ///< Ranges of general blocks
+  vk::DeviceSize top = 0;                  ///< Linear blocks: next offset
+  size_t live = 0;                         ///< Linear blocks: allocations
+
+  /** @brief True when no allocation uses the block. */
+  bool empty() const { return tlsf ? tlsf->empty() : live == 0; }
+};
+
+GpuAllocator::GpuAllocator(const vk::raii::PhysicalDevice &physicalGPU,
+                           const vk::raii::Device &logicalDevice,
+                           vk::DeviceSize blockSizeLimit,
+                           bool deviceAddress)
+    : device(logicalDevice),
+      memoryProperties(physicalGPU.getMemoryProperties()),
+      bufferImageGranularity(
+          physicalGPU.getProperties().limits.bufferImageGranularity),
+      maxBlockSize(blockSizeLimit), deviceAddresses(deviceAddress) {}
+
+const char *GpuAllocator::categoryName(Category category) {
+  switch (category) {
+  case Category::eVertex:
+    return "vertex";
+  case Category::eIndex:
+    return "index";
+  case Category::eTexture:
+    return "texture";
+  case Category::eAttachment:
+    return "attachment";
+  case Category::eStaging:
+    return "staging";
+  case Category::eUniform:
+    return "uniform";
+  case Category::eOther:
+    break;
+  }
+  return "other";
+}
+
+GpuAllocator::~GpuAllocator() {
+  const Stats current = stats();
+  if (current.allocationCount + current.dedicatedCount > 0) {
+    std::cerr << "Warning: GPU allocator destroyed with "
+              << current.allocationCount + current.dedicatedCount
+              << " live allocations" << std::endl;
+  }
+}
+
+uint32_t
+GpuAllocator::findMemoryType(uint32_t typeBits,
+                             vk::MemoryPropertyFlags properties) const {
+  for (uint32_t i = 0; i < memoryProperties.memoryTypeCount; i++) {
+    if ((typeBits & (1u << i)) &&
+        (memoryProperties.memoryTypes[i].propertyFlags & properties) ==
+            properties) {
+      return i;
+    }
+  }
+  throw std::runtime_error("Failed to find suitable memory type!");
+}
+
+bool GpuAllocator::hasMemoryType(uint32_t typeBits,
+                                 vk::MemoryPropertyFlags properties) const {
+  for (uint32_t i = 0; i < memoryProperties.memoryTypeCount; i++) {
+    if ((typeBits & (1u << i)) &&
+        (memoryProperties.memoryTypes[i].propertyFlags & properties) ==
+            properties) {
+      return true;
+    }
+  }
+  return false;
+}
+
+GpuAllocator::Pool &GpuAllocator::pool(uint32_t memoryType, bool transient,
+                                       bool optimalImages) {
+  for (const std::unique_ptr<Pool> &existing : pools) {
+    if (existing->memoryType == memoryType &&
+        existing->transient == transient &&
+        existing->optimalImages == optimalImages) {
+      return *existing;
+    }
+  }
+  pools.push_back(std::make_unique<Pool>());
+  pools.back()->memoryType = memoryType;
+  pools.back()->transient = transient;
+  pools.back()->optimalImages = optimalImages;
+  return *pools.back();
+}
+
+std::unique_ptr<GpuAllocator::Block>
+GpuAllocator::createBlock(vk::DeviceSize size, uint32_t memoryType,
+                          const void *next) {
+  vk::MemoryAllocateFlagsInfo flagsInfo{};
+  flagsInfo.pNext = next;
+  flagsInfo.flags = vk::MemoryAllocateFlagBits::eDeviceAddress;
+
+  vk::MemoryAllocateInfo allocInfo{};
+  allocInfo.pNext = deviceAddresses ? &flagsInfo : next;
+  allocInfo.allocationSize = size;
+  allocInfo.memoryTypeIndex = memoryType;
+
+  auto block = std::make_unique<Block>();
+  block->memory = vk::raii::DeviceMemory(device, allocInfo);
+  block->size = size;
+  block->memoryType = memoryType;
+  if (memoryProperties.memoryTypes[memoryType].propertyFlags &
+      vk::MemoryPropertyFlagBits::eHostVisible) {
+    block->mapped = block->memory.mapMemory(0, vk::WholeSize);
+  }
+  return block;
+}
+
+GpuAllocation GpuAllocator::allocate(const vk::raii::Buffer &buffer,
+                                     vk::MemoryPropertyFlags properties,
+                                     Category category, Usage usage) {
+  const auto requirements =
+      device.getBufferMemoryRequirements2<vk::MemoryRequirements2,
+                                          vk::MemoryDedicatedRequirements>(
+          vk::BufferMemoryRequirementsInfo2{*buffer});
+  const vk::MemoryDedicatedRequirements &dedicatedRequirements =
+      requirements.get<vk::MemoryDedicatedRequirements>();
+
+  vk::MemoryDedicatedAllocateInfo dedicatedInfo{};
+  dedicatedInfo.buffer = *buffer;
+  GpuAllocation allocation = allocateMemory(
+      requirements.get<vk::MemoryRequirements2>().memoryRequirements,
+      properties, usage, false,
+      dedicatedRequirements.prefersDedicatedAllocation ||
+          dedicatedRequirements.requiresDedicatedAllocation,
+      dedicatedInfo, category);
+  buffer.bindMemory(allocation.memory(), allocation.offset());
+  return allocation;
+}
+
+GpuAllocation GpuAllocator::allocate(const vk::raii::Image &image,
+                                     vk::ImageTiling tiling,
+                                     vk::MemoryPropertyFlags properties,
+                                     Category category) {
+  const auto requirements =
+      device.getImageMemoryRequirements2<vk::MemoryRequirements2,
+                                         vk::MemoryDedicatedRequirements>(
+          vk::ImageMemoryRequirementsInfo2{*image});
+  const vk::MemoryDedicatedRequirements &dedicatedRequirements =
+      requirements.get<vk::MemoryDedicatedRequirements>();
+
+  vk::MemoryDedicatedAllocateInfo dedicatedInfo{};
+  dedicatedInfo.image = *image;
+  GpuAllocation allocation = allocateMemory(
+      requirements.get<vk::MemoryRequirements2>().memoryRequirements,
+      properties, Usage::eGeneral, tiling == vk::ImageTiling::eOptimal,
+      dedicatedRequirements.prefersDedicatedAllocation ||
+          dedicatedRequirements.requiresDedicatedAllocation,
+      dedicatedInfo, category);
+  image.bindMemory(allocation.memory(), allocation.offset());
+  return allocation;
+}
+
+GpuAllocation GpuAllocator::allocate(const vk::MemoryRequirements &requirements,
+                                     vk::MemoryPropertyFlags properties,
+                                     Category category) {
+  return allocateMemory(requirements, properties, Usage::eGeneral, true, false,
+                        vk::MemoryDedicatedAllocateInfo{}, category);
+}
+
+/**
+ * @details
+ * Blocks are min(maxBlockSize, heap size / 8), so small heaps (e.g. the
+ * 256 MiB host-visible device-local heap) are not exhausted by a few
+ * blocks. Pools are keyed by memory type and by kind:
+ * - transient buffers: linear blocks, bump allocated;
+ * - optimal-tiling images: their own TLSF blocks when bufferImageGranularity
+ *   is larger than 1, so no buffer ends up on the same granularity page;
+ * - everything else: TLSF blocks.
+ *
+ * If a new block cannot be allocated (the heap is nearly full), the
+ * resource falls back to a dedicated allocation of exactly its size.
+ */
+GpuAllocation GpuAllocator::allocateMemory(
+    const vk::MemoryRequirements &requirements,
+    vk::MemoryPropertyFlags properties, Usage usage, bool optimalImage,
+    bool dedicatedPreferred,
+    const vk::MemoryDedicatedAllocateInfo &dedicatedInfo, Category category) {
+  const uint32_t memoryType =
+      findMemoryType(requirements.memoryTypeBits, properties);
+  const vk::DeviceSize heapSize =
+      memoryProperties
+          .memoryHeaps[memoryProperties.memoryTypes[memoryType].heapIndex]
+          .size;
+  const vk::DeviceSize blockSize = std::min(maxBlockSize, heapSize / 8);
+  const vk::DeviceSize alignment = std::max<vk::DeviceSize>(
+      requirements.alignment, 1);
+
+  std::lock_guard<std::mutex> lock(mutex);
+  categoryBytes[static_cast<size_t>(category)] += requirements.size;
+  if (!dedicatedPreferred && requirements.size <= blockSize / 2) {
+    Pool &target = pool(memoryType, usage == Usage::eTransient,
+                        optimalImage && bufferImageGranularity > 1);
+
+    if (target.transient) {
+      for (const std::unique_ptr<Block> &block : target.blocks) {
+        const vk::DeviceSize offset =
+            (block->top + alignment - 1) / alignment * alignment;
+        if (offset + requirements.size <= block->size) {
+          block->top = offset + requirements.size;
+          block->live++;
+          return GpuAllocation(this, block.get(),
+                               {offset, requirements.size, 0}, category);
+        }
+      }
+    } else {
+      for (const std::unique_ptr<Block> &block : target.blocks) {
+        const TlsfAllocator::Allocation range =
+            block->tlsf->allocate(requirements.size, alignment);
+        if (range.offset != TlsfAllocator::kNoSpace) {
+          return GpuAllocation(this, block.get(), range, category);
+        }
+      }
+    }
+
+    std::unique_ptr<Block> block;
+    try {
+      block = createBlock(blockSize, memoryType, nullptr);
+    } catch (const vk::OutOfDeviceMemoryError &) {
+    } catch (const vk::OutOfHostMemoryError &) {
+    }
+    if (block) {
+      block->pool = &target;
+      TlsfAllocator::Allocation range{0, requirements.size, 0};
+      if (target.transient) {
+        block->top = requirements.size;
+        block->live = 1;
+      } else {
+        block->tlsf = std::make_unique<TlsfAllocator>(blockSize);
+        range = block->tlsf->allocate(requirements.size, alignment);
+      }
+      target.blocks.push_back(std::move(block));
+      return GpuAllocation(this, target.blocks.back().get(), range,
+                           category);
+    }
+  }
+
+  try {
+    dedicated.push_back(
+        createBlock(requirements.size, memoryType, &dedicatedInfo));
+  } catch (...) {
+    categoryBytes[static_cast<size_t>(category)] -= requirements.size;
+    throw;
+  }
+  return GpuAllocation(this, dedicated.back().get(),
+                       {0, requirements.size, 0}, category);
+}
+
+GpuAllocation GpuAllocator::adopt(vk::raii::DeviceMemory &&memory,
+                                  vk::DeviceSize size, uint32_t memoryType,
+                                  Category category) {
+  auto block = std::make_unique<Block>();
+  block->memory = std::move(memory);
+  block->size = size;
+  block->memoryType = memoryType;
+
+  std::lock_guard<std::mutex> lock(mutex);
+  dedicated.push_back(std::move(block));
+  categoryBytes[static_cast<size_t>(category)] += size;
+  return GpuAllocation(this, dedicated.back().get(), {0, size, 0}, category);
+}
+
+/**
+ * @details Dedicated allocations are freed right away. A pool block that
+ * becomes empty is kept for reuse, unless the pool already has another
+ * empty block, so that a burst of frees does not keep memory around and
+ * alternating allocate/free does not reallocate a block every time.
+ */
+void GpuAllocator::free(Block *block, const TlsfAllocator::Allocation &range,
+                        Category category) {
+  std::lock_guard<std::mutex> lock(mutex);
+  categoryBytes[static_cast<size_t>(category)] -= range.size;
+  Pool *owner = block->pool;
+  if (owner == nullptr) {
+    std::erase_if(dedicated, [block](const std::unique_ptr<Block> &entry) {
+      return entry.get() == block;
+    });
+    return;
+  }
+
+  if (block->tlsf) {
+    block->tlsf->free(range);
+  } else if (--block->live == 0) {
+    block->top = 0;
+  }
+  if (!block->empty()) {
+    return;
+  }
+  const bool otherEmpty = std::any_of(
+      owner->blocks.begin(), owner->blocks.end(),
+      [block](const std::unique_ptr<Block> &entry) {
+        return entry.get() != block && entry->empty();
+      });
+  if (otherEmpty) {
+    std::erase_if(owner->blocks, [block](const std::unique_ptr<Block> &entry) {
+      return entry.get() == block;
+    });
+  }
+}
+
+/**
+ * @details Fragmentation is measured per block: 1 - (sum of the largest
+ * free range of each block) / (sum of free bytes). It is 0 when every
+ * block's free space is one range and approaches 1 when free space is
+ * scattered in small holes that larger resources cannot use.
+ *
+ * heapBytes counts whole blocks, free space included, since that is what
+ * the driver charges against the heap's budget.
+ */
+GpuAllocator::Stats GpuAllocator::stats() const {
+  std::lock_guard<std::mutex> lock(mutex);
+  Stats result;
+  result.categoryBytes = categoryBytes;
+  result.heapBytes.assign(memoryProperties.memoryHeapCount, 0);
+  const auto heapOf = [this](const Block &block) {
+    return memoryProperties.memoryTypes[block.memoryType].heapIndex;
+  };
+  vk::DeviceSize largestFree = 0;
+  for (const std::unique_ptr<Pool> &entry : pools) {
+    for (const std::unique_ptr<Block> &block : entry->blocks) {
+      result.blockCount++;
+      result.blockBytes += block->size;
+      result.heapBytes[heapOf(*block)] += block->size;
+      if (block->tlsf) {
+        result.allocationCount += block->tlsf->allocationCount();
+        result.usedBytes += block->tlsf->used();
+        largestFree += block->tlsf->largestFree();
+      } else {
+        result.allocationCount += block->live;
+        result.usedBytes += block->top;
+        largestFree += block->size - block->top;
+      }
+    }
+  }
+  for (const std::unique_ptr<Block> &block : dedicated) {
+    result.dedicatedCount++;
+    result.dedicatedBytes += block->size;
+    result.heapBytes[heapOf(*block)] += block->size;
+  }
+  result.freeBytes = result.blockBytes - result.usedBytes;
+  if (result.freeBytes > 0) {
+    result.fragmentation =
+        1.0f - static_cast<float>(static_cast<double>(largestFree) /
+                                  static_cast<double>(result.freeBytes));
+  }
+  return result;
+}
+
+GpuAllocation::GpuAllocation(GpuAllocation &&other) noexcept
+    : owner(other.owner), block(other.block), range(other.range),
+      category(other.category) {
+  other.owner = nullptr;
+  other.block = nullptr;
+  other.range = {0, 0};
+}
+
+GpuAllocation &GpuAllocation::operator=(GpuAllocation &&other) noexcept {
+  if (this != &other) {
+    reset();
+    owner = other.owner;
+    block = other.block;
+    range = other.range;
+    category = other.category;
+    other.owner = nullptr;
+    other.block = nullptr;
+    other.range = {0, 0};
+  }
+  return *this;
+}
+
+vk::DeviceMemory GpuAllocation::memory() const {
+  return block != nullptr ? *block->memory : vk::DeviceMemory{};
+}
+
+void *GpuAllocation::mapped() const {
+  if (block == nullptr || block->mapped == nullptr) {
+    return nullptr;
+  }
+  return static_cast<std::byte *>(block->mapped) + range.offset;
+}
+
+void GpuAllocation::reset() {
+  if (block != nullptr) {
+    owner->free(block, range, category);
+    owner = nullptr;
+    block = nullptr;
+    range = {0, 0};
+  }
+}
@@ -0,0 +1,84 @@
+/**
+ * @file LoadBatch.cpp
+ * @brief Load-time graphics queue transfers recorded into one command
+ *        buffer and waited for once.
+ *
+ * @see LoadBatch.hpp
+ */
+#include "../include/LoadBatch.hpp"
+
+#include <chrono>
+#include <stdexcept>
+
+LoadBatch::LoadBatch(const vk::raii::Device &logicalDevice,
+                     StagingPool &stagingPool, uint32_t queueFamily)
+    : device(logicalDevice), staging(stagingPool),
+      queue(logicalDevice, queueFamily, 0) {
+  vk::CommandPoolCreateInfo poolInfo{};
+  poolInfo.flags = vk::CommandPoolCreateFlagBits::eResetCommandBuffer |
+                   vk::CommandPoolCreateFlagBits::eTransient;
+  poolInfo.queueFamilyIndex = queueFamily;
+  commandPool = vk::raii::CommandPool(device, poolInfo);
+
+  vk::CommandBufferAllocateInfo allocInfo{};
+  allocInfo.commandPool = *commandPool;
+  allocInfo.level = vk::CommandBufferLevel::ePrimary;
+  allocInfo.commandBufferCount = 1;
+  commandBuffer =
+      std::move(vk::raii::CommandBuffers(device, allocInfo).front());
+  fence = vk::raii::Fence(device, vk::FenceCreateInfo{});
+}
+
+/** @details The GPU never saw the ranges of an unsubmitted batch. */
+LoadBatch::~LoadBatch() {
+  for (const StagingPool::Range &range : ranges) {
+    staging.release(range);
+  }
+}
+
+const vk::raii::CommandBuffer &LoadBatch::commands() {
+  if (!recording) {
+    commandBuffer.begin(vk::CommandBufferBeginInfo{
+        vk::CommandBufferUsageFlagBits::eOneTimeSubmit});
+    recording = true;
+  }
+  return commandBuffer;
+}
+
+void LoadBatch::release(const StagingPool::Range &range) {
+  ranges.push_back(range);
+}
+
+/**
+ * @details The fence is waited for right away, so the ranges go back
+ * without it and the command buffer can be reset for the next batch.
+ */
+void LoadBatch::submit() {
+  if (!recording) {
+    return;
+  }
+  const auto start = std::chrono::steady_clock::now();
+  commandBuffer.end();
+  recording = false;
+
+  vk::SubmitInfo submitInfo{};
+  submitInfo.commandBufferCount = 1;
+  submitInfo.pCommandBuffers = &*commandBuffer;
+  queue.submit(submitInfo, *fence);
+  if (device.waitForFences(*fence, VK_TRUE, UINT64_MAX) !=
+      vk::Result::eSuccess) {
+    throw std::runtime_error("Load batch fence wait failed");
+  }
+  device.resetFences(*fence);
+  commandBuffer.reset();
+
+  for (const StagingPool::Range &range : ranges) {
+    staging.release(range); // The batch has completed
+  }
+  totals.stagingRanges += ranges.size();
+  ranges.clear();
+  totals.submits++;
+  totals.waitMs += std::chrono::duration<double, std::milli>(
+                       std::chrono::steady_clock::now() - start)
+                       .count();
+}
@@ -0,0 +1,80 @@
+/**
+ * @file MappedFile.cpp
+ * @brief POSIX implementation of the read-only MappedFile wrapper.
+ *
+ * @note Empty files are represented as an open handle with a null data
+ * pointer, since 'mmap' rejects zero-length mappings.
+ */
+#include "../include/MappedFile.hpp"
+
+#include <fcntl.h>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utility>
+
+/**
+ * @brief Opens and maps an entire file read-only.
+ *
+ * @param filename Path of the file to map.
+ * @throws std::runtime_error If the file cannot be opened, stat'ed or mapped.
+ *
+ * @details
+ * The file descriptor is closed immediately after mapping; POSIX keeps the
+ * mapping valid until 'munmap'. The kernel is advised that the mapping will
+ * be read sequentially so read-ahead can stream it in large chunks.
+ */
+MappedFile::MappedFile(const std::string &filename) {
+  int fd = ::open(filename.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw std::runtime_error("Failed to open file: " + filename);
+  }
+
+  struct stat st {};
+  if (::fstat(fd, &st) != 0) {
+    ::close(fd);
+    throw std::runtime_error("Failed to stat file: " + filename);
+  }
+
+  mappedSize = static_cast<size_t>(st.st_size);
+  if (mappedSize > 0) {
+    void *ptr = ::mmap(nullptr, mappedSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (ptr == MAP_FAILED) {
+      ::close(fd);
+      mappedSize = 0;
+      throw std::runtime_error("Failed to map file: " + filename);
+    }
+    ::madvise(ptr, mappedSize, MADV_SEQUENTIAL); // Hint: linear read-ahead
+    mappedData = static_cast<const std::byte *>(ptr);
+  }
+
+  ::close(fd); // Mapping stays valid after the descriptor is closed
+}
+
+/** @brief Releases the mapping. */
+MappedFile::~MappedFile() { release(); }
+
+/** @brief Steals the mapping from another MappedFile. */
+MappedFile::MappedFile(MappedFile &&other) noexcept
+    : mappedData(std::exchange(other.mappedData, nullptr)),
+      mappedSize(std::exchange(other.mappedSize, 0)) {}
+
+/** @brief Releases the current mapping and steals another one. */
+MappedFile &MappedFile::operator=(MappedFile &&other) noexcept {
+  if (this != &other) {
+    release();
+    mappedData = std::exchange(other.mappedData, nullptr);
+    mappedSize = std::exchange(other.mappedSize, 0);
+  }
+  return *this;
+}
+
+/** @brief Unmaps the file and resets the handle to the empty state. */
+void MappedFile::release() {
+  if (mappedData) {
+    ::munmap(const_cast<std::byte *>(mappedData), mappedSize);
+  }
+  mappedData = nullptr;
+  mappedSize = 0;
+}
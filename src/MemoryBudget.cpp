@@ -0,0 +1,69 @@
+/**
+ * @file MemoryBudget.cpp
+ * @brief Heap usage and budget tracking.
+ *
+ * @see MemoryBudget.hpp
+ */
+#include "../include/MemoryBudget.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+MemoryBudget::MemoryBudget(const vk::raii::PhysicalDevice &physicalGPU,
+                           bool extensionEnabled, float threshold)
+    : gpu(physicalGPU), extension(extensionEnabled), limit(threshold) {
+  if (!(threshold > 0.0f && threshold <= 1.0f)) {
+    throw std::runtime_error("Memory budget threshold must be in (0, 1]");
+  }
+  const vk::PhysicalDeviceMemoryProperties properties =
+      gpu.getMemoryProperties();
+  heapStates.resize(properties.memoryHeapCount);
+  for (uint32_t i = 0; i < properties.memoryHeapCount; i++) {
+    heapStates[i].size = properties.memoryHeaps[i].size;
+    heapStates[i].budget = properties.memoryHeaps[i].size / 5 * 4;
+    heapStates[i].deviceLocal = static_cast<bool>(
+        properties.memoryHeaps[i].flags & vk::MemoryHeapFlagBits::eDeviceLocal);
+  }
+}
+
+/**
+ * @details The extension's numbers are a snapshot that the driver refreshes
+ * at its own pace (typically on allocation and on queue submission), so
+ * querying them once per frame is both cheap and as fresh as they get.
+ * GpuAllocator cannot see the driver's own allocations, hence usage is
+ * never taken below what it holds.
+ */
+void MemoryBudget::update(std::span<const vk::DeviceSize> allocatedPerHeap) {
+  vk::PhysicalDeviceMemoryBudgetPropertiesEXT budgetProperties{};
+  if (extension) {
+    budgetProperties =
+        gpu.getMemoryProperties2<vk::PhysicalDeviceMemoryProperties2,
+                                 vk::PhysicalDeviceMemoryBudgetPropertiesEXT>()
+            .get<vk::PhysicalDeviceMemoryBudgetPropertiesEXT>();
+  }
+
+  for (uint32_t i = 0; i < heapStates.size(); i++) {
+    Heap &heap = heapStates[i];
+    heap.allocated = i < allocatedPerHeap.size() ? allocatedPerHeap[i] : 0;
+    heap.usage = heap.allocated;
+    if (extension) {
+      heap.usage = std::max(heap.usage, budgetProperties.heapUsage[i]);
+      heap.budget = std::min(heap.size, budgetProperties.heapBudget[i]);
+    }
+
+    const double used = static_cast<double>(heap.usage);
+    const double budget = static_cast<double>(heap.budget);
+    bool over = heap.overThreshold;
+    if (!over && used > budget * limit) {
+      over = true;
+    } else if (over && used < budget * (limit - kHysteresis)) {
+      over = false;
+    }
+    if (over != heap.overThreshold) {
+      heap.overThreshold = over;
+      if (onThreshold) {
+        onThreshold(i, heap);
+      }
+    }
+  }
+}
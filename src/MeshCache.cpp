@@ -0,0 +1,387 @@
+/**
+ * @file MeshCache.cpp
+ * @brief Binary mesh cache reading (mmap) and writing.
+ *
+ * @see MeshCache.hpp for the on-disk layout and validation rules.
+ */
+#include "../include/MeshCache.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+namespace meshcache {
+
+namespace {
+
+/** @brief Rounds 'value' up to the next multiple of 'alignment'. */
+constexpr uint64_t alignUp(uint64_t value, uint64_t alignment) {
+  return (value + alignment - 1) / alignment * alignment;
+}
+
+/**
+ * @brief True when 'count' elements of 'elementSize' bytes at 'offset' fit
+ * in 'size' bytes. The count is checked before it is multiplied, so header
+ * values read from disk cannot wrap around.
+ */
+constexpr bool sectionFits(uint64_t offset, uint64_t count,
+                           uint64_t elementSize, uint64_t size) {
+  return count <= size / elementSize && offset <= size - count * elementSize;
+}
+
+} // namespace
+
+/**
+ * @brief Hashes a byte range 8 bytes at a time.
+ *
+ * @param bytes Data to hash.
+ * @return 64-bit hash.
+ *
+ * @details
+ * Each 64-bit word is multiplied by a large odd constant, xor-folded into the
+ * running state and rotated; a splitmix64 finalizer avalanches the result.
+ * This runs at several GB/s, which keeps revalidating a multi-hundred MB OBJ
+ * far cheaper than reparsing it.
+ */
+uint64_t hashBytes(std::span<const std::byte> bytes) {
+  constexpr uint64_t kMul = 0x9E3779B97F4A7C15ull;
+  const std::byte *ptr = bytes.data();
+  const size_t size = bytes.size();
+
+  uint64_t hash = 0x27D4EB2F165667C5ull ^ (size * kMul);
+  size_t i = 0;
+  for (; i + 8 <= size; i += 8) {
+    uint64_t word;
+    std::memcpy(&word, ptr + i, 8); // Unaligned-safe load
+    hash ^= word * kMul;
+    hash = ((hash << 31) | (hash >> 33)) * 0x94D049BB133111EBull;
+  }
+
+  // Fold the remaining 0-7 bytes into one final word
+  uint64_t tail = 0;
+  std::memcpy(&tail, ptr + i, size - i);
+  hash ^= tail * kMul;
+
+  // splitmix64 finalizer
+  hash ^= hash >> 30;
+  hash *= 0xBF58476D1CE4E5B9ull;
+  hash ^= hash >> 27;
+  hash *= 0x94D049BB133111EBull;
+  hash ^= hash >> 31;
+  return hash;
+}
+
+/**
+ * @details Missing files and filesystem errors both map to std::nullopt.
+ */
+std::optional<SourceStamp> stampFile(const std::string &path) {
+  std::error_code ec;
+  auto size = std::filesystem::file_size(path, ec);
+  if (ec) {
+    return std::nullopt;
+  }
+  auto mtime = std::filesystem::last_write_time(path, ec);
+  if (ec) {
+    return std::nullopt;
+  }
+  return SourceStamp{static_cast<uint64_t>(size),
+                     static_cast<int64_t>(mtime.time_since_epoch().count())};
+}
+
+/** @details Maps the file temporarily so no copy of it is made. */
+uint64_t hashFile(const std::string &path) {
+  MappedFile source(path);
+  return hashBytes(source.bytes());
+}
+
+/**
+ * @brief Maps a cache file and checks it against its source asset.
+ *
+ * @param cachePath Path of the cache file.
+ * @param sourcePath Path of the asset the cache was built from.
+ * @param flags Required processing flags.
+ * @return Mapped cache, or std::nullopt if missing/corrupt/stale or if it
+ * was written with different processing flags.
+ *
+ * @details
+ * Validation order is cheapest first: header fields and section bounds,
+ * one pass over the indices, then source size, then mtime. Only if the
+ * mtime differs is the source hashed, so touching or re-checking-out the
+ * OBJ does not force a reparse.
+ */
+std::optional<CachedMesh> CachedMesh::open(const std::string &cachePath,
+                                           const std::string &sourcePath,
+                                           uint32_t flags) {
+  if (!std::filesystem::exists(cachePath)) {
+    return std::nullopt;
+  }
+
+  MappedFile file;
+  try {
+    file = MappedFile(cachePath);
+  } catch (const std::exception &) {
+    return std::nullopt;
+  }
+
+  auto mesh = fromBytes(file.bytes(), sourcePath, flags);
+  if (mesh) {
+    // The mapping's address survives the move, so 'contents' stays valid
+    mesh->file = std::move(file);
+  }
+  return mesh;
+}
+
+std::optional<CachedMesh>
+CachedMesh::fromBytes(std::span<const std::byte> bytes,
+                      const std::string &sourcePath, uint32_t flags) {
+  // Structural validation: header, version, layout, flags, section bounds
+  if (bytes.size() < sizeof(Header)) {
+    return std::nullopt;
+  }
+  const Header &header = *reinterpret_cast<const Header *>(bytes.data());
+  if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 ||
+      header.version != kVersion || header.vertexStride != sizeof(Vertex) ||
+      header.flags != flags) {
+    return std::nullopt;
+  }
+  if (header.vertexOffset % alignof(Vertex) != 0 ||
+      header.indexOffset % alignof(uint32_t) != 0 ||
+      !sectionFits(header.vertexOffset, header.vertexCount, sizeof(Vertex),
+                   bytes.size()) ||
+      !sectionFits(header.indexOffset, header.indexCount, sizeof(uint32_t),
+                   bytes.size()) ||
+      header.lodOffset % alignof(MeshLod) != 0 ||
+      !sectionFits(header.lodOffset, header.lodCount, sizeof(MeshLod),
+                   bytes.size())) {
+    return std::nullopt;
+  }
+  // Consumers index the vertex array with these unchecked
+  const auto *indices =
+      reinterpret_cast<const uint32_t *>(bytes.data() + header.indexOffset);
+  for (uint64_t i = 0; i < header.indexCount; i++) {
+    if (indices[i] >= header.vertexCount) {
+      return std::nullopt;
+    }
+  }
+  const auto *lods =
+      reinterpret_cast<const MeshLod *>(bytes.data() + header.lodOffset);
+  for (uint64_t i = 0; i < header.lodCount; i++) {
+    if (static_cast<uint64_t>(lods[i].indexOffset) + lods[i].indexCount >
+        header.indexCount) {
+      return std::nullopt;
+    }
+  }
+  if (header.submeshOffset % alignof(MeshSubmesh) != 0 ||
+      !sectionFits(header.submeshOffset, header.submeshCount,
+                   sizeof(MeshSubmesh), bytes.size()) ||
+      header.materialOffset % alignof(MaterialRecord) != 0 ||
+      !sectionFits(header.materialOffset, header.materialCount,
+                   sizeof(MaterialRecord), bytes.size())) {
+    return std::nullopt;
+  }
+  const auto *submeshes = reinterpret_cast<const MeshSubmesh *>(
+      bytes.data() + header.submeshOffset);
+  for (uint64_t i = 0; i < header.submeshCount; i++) {
+    if (static_cast<uint64_t>(submeshes[i].indexOffset) +
+                submeshes[i].indexCount >
+            header.indexCount ||
+        submeshes[i].material >= header.materialCount ||
+        submeshes[i].lod >= std::max<uint64_t>(header.lodCount, 1)) {
+      return std::nullopt;
+    }
+  }
+  const auto *materials = reinterpret_cast<const MaterialRecord *>(
+      bytes.data() + header.materialOffset);
+  for (uint64_t i = 0; i < header.materialCount; i++) {
+    if (!std::memchr(materials[i].name, 0, sizeof(materials[i].name)) ||
+        !std::memchr(materials[i].diffuseTexture, 0,
+                     sizeof(materials[i].diffuseTexture))) {
+      return std::nullopt;
+    }
+  }
+
+  // Freshness validation against the source asset (if it still exists)
+  if (auto stamp = stampFile(sourcePath)) {
+    if (stamp->size != header.sourceSize) {
+      return std::nullopt;
+    }
+    if (stamp->mtime != header.sourceMtime &&
+        hashFile(sourcePath) != header.sourceHash) {
+      return std::nullopt;
+    }
+  }
+
+  return CachedMesh(bytes);
+}
+
+/** @brief Vertex array viewed in place inside the mapping. */
+std::span<const Vertex> CachedMesh::vertices() const {
+  const std::byte *base = contents.data() + header().vertexOffset;
+  return {reinterpret_cast<const Vertex *>(base),
+          static_cast<size_t>(header().vertexCount)};
+}
+
+/** @brief Index array viewed in place inside the mapping. */
+std::span<const uint32_t> CachedMesh::indices() const {
+  const std::byte *base = contents.data() + header().indexOffset;
+  return {reinterpret_cast<const uint32_t *>(base),
+          static_cast<size_t>(header().indexCount)};
+}
+
+/** @brief LOD ranges viewed in place inside the mapping. */
+std::span<const MeshLod> CachedMesh::lods() const {
+  const std::byte *base = contents.data() + header().lodOffset;
+  return {reinterpret_cast<const MeshLod *>(base),
+          static_cast<size_t>(header().lodCount)};
+}
+
+/** @brief Submesh ranges viewed in place inside the mapping. */
+std::span<const MeshSubmesh> CachedMesh::submeshes() const {
+  const std::byte *base = contents.data() + header().submeshOffset;
+  return {reinterpret_cast<const MeshSubmesh *>(base),
+          static_cast<size_t>(header().submeshCount)};
+}
+
+/** @details Strings were checked for termination by fromBytes(). */
+std::vector<MeshMaterial> CachedMesh::materials() const {
+  const auto *records = reinterpret_cast<const MaterialRecord *>(
+      contents.data() + header().materialOffset);
+  std::vector<MeshMaterial> result(header().materialCount);
+  for (size_t i = 0; i < result.size(); i++) {
+    result[i].name = records[i].name;
+    result[i].diffuseTexture = records[i].diffuseTexture;
+    result[i].diffuseColor = {records[i].diffuseColor[0],
+                              records[i].diffuseColor[1],
+                              records[i].diffuseColor[2]};
+  }
+  return result;
+}
+
+/** @brief Bounding box minimum recorded at write time. */
+glm::vec3 CachedMesh::boundsMin() const {
+  return {header().boundsMin[0], header().boundsMin[1], header().boundsMin[2]};
+}
+
+/** @brief Bounding box maximum recorded at write time. */
+glm::vec3 CachedMesh::boundsMax() const {
+  return {header().boundsMax[0], header().boundsMax[1], header().boundsMax[2]};
+}
+
+/**
+ * @brief Serializes a mesh and its source identity to a cache file.
+ *
+ * @param cachePath Destination path.
+ * @param sourcePath Source asset (size, mtime and content hash recorded).
+ * @param mesh Mesh to store.
+ * @param flags Processing flags recorded in the header.
+ * @throws std::runtime_error On any I/O failure.
+ */
+void write(const std::string &cachePath, const std::string &sourcePath,
+           const MeshData &mesh, uint32_t flags) {
+  auto stamp = stampFile(sourcePath);
+  if (!stamp) {
+    throw std::runtime_error("Mesh cache source not found: " + sourcePath);
+  }
+
+  Header header{};
+  std::memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.version = kVersion;
+  header.vertexStride = sizeof(Vertex);
+  header.flags = flags;
+  header.sourceSize = stamp->size;
+  header.sourceMtime = stamp->mtime;
+  header.sourceHash = hashFile(sourcePath);
+  header.vertexCount = mesh.vertices.size();
+  header.indexCount = mesh.indices.size();
+  header.vertexOffset = alignUp(sizeof(Header), kSectionAlignment);
+  header.indexOffset =
+      alignUp(header.vertexOffset + header.vertexCount * sizeof(Vertex),
+              kSectionAlignment);
+  header.lodCount = mesh.lods.size();
+  header.lodOffset =
+      alignUp(header.indexOffset + header.indexCount * sizeof(uint32_t),
+              kSectionAlignment);
+  for (int axis = 0; axis < 3; axis++) {
+    header.boundsMin[axis] = mesh.boundsMin[axis];
+    header.boundsMax[axis] = mesh.boundsMax[axis];
+  }
+  header.submeshCount = mesh.submeshes.size();
+  header.submeshOffset =
+      alignUp(header.lodOffset + header.lodCount * sizeof(MeshLod),
+              kSectionAlignment);
+  header.materialCount = mesh.materials.size();
+  header.materialOffset =
+      alignUp(header.submeshOffset + header.submeshCount * sizeof(MeshSubmesh),
+              kSectionAlignment);
+
+  std::vector<MaterialRecord> materials(mesh.materials.size());
+  for (size_t i = 0; i < materials.size(); i++) {
+    const MeshMaterial &material = mesh.materials[i];
+    if (material.name.size() >= sizeof(materials[i].name) ||
+        material.diffuseTexture.size() >=
+            sizeof(materials[i].diffuseTexture)) {
+      throw std::runtime_error("Material '" + material.name +
+                               "' does not fit the mesh cache");
+    }
+    std::memcpy(materials[i].name, material.name.data(),
+                material.name.size());
+    std::memcpy(materials[i].diffuseTexture, material.diffuseTexture.data(),
+                material.diffuseTexture.size());
+    for (int channel = 0; channel < 3; channel++) {
+      materials[i].diffuseColor[channel] = material.diffuseColor[channel];
+    }
+  }
+
+  // Write to a temporary file first so readers never see a partial cache
+  const std::string tmpPath = cachePath + ".tmp";
+  {
+    std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+      throw std::runtime_error("Failed to create mesh cache: " + tmpPath);
+    }
+
+    const std::vector<char> padding(kSectionAlignment, 0);
+    auto padTo = [&](uint64_t offset) {
+      out.write(padding.data(), static_cast<std::streamsize>(
+                                    offset - static_cast<uint64_t>(out.tellp())));
+    };
+
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    padTo(header.vertexOffset);
+    out.write(reinterpret_cast<const char *>(mesh.vertices.data()),
+              static_cast<std::streamsize>(mesh.vertices.size() *
+                                           sizeof(Vertex)));
+    padTo(header.indexOffset);
+    out.write(reinterpret_cast<const char *>(mesh.indices.data()),
+              static_cast<std::streamsize>(mesh.indices.size() *
+                                           sizeof(uint32_t)));
+    padTo(header.lodOffset);
+    out.write(reinterpret_cast<const char *>(mesh.lods.data()),
+              static_cast<std::streamsize>(mesh.lods.size() * sizeof(MeshLod)));
+    padTo(header.submeshOffset);
+    out.write(reinterpret_cast<const char *>(mesh.submeshes.data()),
+              static_cast<std::streamsize>(mesh.submeshes.size() *
+                                           sizeof(MeshSubmesh)));
+    padTo(header.materialOffset);
+    out.write(reinterpret_cast<const char *>(materials.data()),
+              static_cast<std::streamsize>(materials.size() *
+                                           sizeof(MaterialRecord)));
+
+    if (!out.good()) {
+      throw std::runtime_error("Failed to write mesh cache: " + tmpPath);
+    }
+  }
+
+  std::error_code ec;
+  std::filesystem::rename(tmpPath, cachePath, ec);
+  if (ec) {
+    std::filesystem::remove(tmpPath, ec);
+    throw std::runtime_error("Failed to move mesh cache into place: " +
+                             cachePath);
+  }
+}
+
+} // namespace meshcache
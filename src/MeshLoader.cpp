@@ -0,0 +1,305 @@
+/**
+ * @file MeshLoader.cpp
+ * @brief OBJ loading into MeshData (TinyOBJLoader and parallel backends).
+ *
+ * @note This translation unit owns the TinyOBJLoader implementation.
+ */
+#define TINYOBJLOADER_IMPLEMENTATION
+#if __has_include(<tiny_obj_loader.h>)
+#include <tiny_obj_loader.h>
+#else
+#include "../external/tinyobjloader/tiny_obj_loader.h"
+#endif
+
+#include "../include/MappedFile.hpp"
+#include "../include/MeshLoader.hpp"
+#include "../include/ObjParser.hpp"
+#include "../include/VertexDedup.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <stdexcept>
+
+namespace meshloader {
+
+namespace {
+
+/**
+ * @brief Converts one library material to a MeshMaterial.
+ *
+ * @param name Material name.
+ * @param diffuse Kd; all zero (absent) becomes white.
+ * @param texture map_Kd as written in the library (may be empty).
+ * @param materialDir Directory the library paths are relative to.
+ */
+MeshMaterial makeMaterial(const std::string &name, const float diffuse[3],
+                          const std::string &texture,
+                          const std::filesystem::path &materialDir) {
+  MeshMaterial material;
+  material.name = name;
+  if (diffuse[0] != 0.0f || diffuse[1] != 0.0f || diffuse[2] != 0.0f) {
+    material.diffuseColor = {diffuse[0], diffuse[1], diffuse[2]};
+  }
+  if (!texture.empty()) {
+    material.diffuseTexture =
+        (materialDir / texture).lexically_normal().generic_string();
+  }
+  return material;
+}
+
+/**
+ * @brief Groups triangles by material and records the ranges.
+ *
+ * @param corners Per-corner vertices (3 per triangle), reordered in place.
+ * @param triangleMaterials Library material per triangle (-1 = none).
+ * @param library Every material of the library, in declaration order.
+ * @param mesh Receives 'materials' and the LOD 0 'submeshes'. Its index
+ * ranges refer to the reordered corners, i.e. to the indices produced by
+ * deduplicating them.
+ *
+ * @details A stable counting sort: one histogram pass, a prefix sum and a
+ * scatter, so triangles keep their file order within a material. Nothing
+ * is recorded (and nothing moves) unless some triangle uses a library
+ * material.
+ */
+void groupByMaterial(std::vector<Vertex> &corners,
+                     std::span<const int32_t> triangleMaterials,
+                     std::span<const MeshMaterial> library, MeshData &mesh) {
+  // Histogram over library ids, with the "no material" bucket last
+  const size_t defaultBucket = library.size();
+  std::vector<size_t> counts(library.size() + 1, 0);
+  for (int32_t material : triangleMaterials) {
+    const bool known =
+        material >= 0 && static_cast<size_t>(material) < library.size();
+    counts[known ? static_cast<size_t>(material) : defaultBucket]++;
+  }
+  if (counts[defaultBucket] == triangleMaterials.size()) {
+    return;
+  }
+
+  // Used buckets become materials and LOD 0 submeshes; 'starts' are the
+  // first triangle of each bucket
+  std::vector<size_t> starts(counts.size(), 0);
+  size_t triangle = 0;
+  for (size_t bucket = 0; bucket < counts.size(); bucket++) {
+    starts[bucket] = triangle;
+    if (counts[bucket] == 0) {
+      continue;
+    }
+    MeshSubmesh submesh;
+    submesh.indexOffset = static_cast<uint32_t>(triangle * 3);
+    submesh.indexCount = static_cast<uint32_t>(counts[bucket] * 3);
+    submesh.material = static_cast<uint32_t>(mesh.materials.size());
+    mesh.submeshes.push_back(submesh);
+    mesh.materials.push_back(bucket == defaultBucket ? MeshMaterial{}
+                                                     : library[bucket]);
+    triangle += counts[bucket];
+  }
+  if (mesh.submeshes.size() == 1) {
+    return; // One material: the file order is already grouped
+  }
+
+  std::vector<Vertex> grouped(corners.size());
+  for (size_t t = 0; t < triangleMaterials.size(); t++) {
+    const int32_t material = triangleMaterials[t];
+    const bool known =
+        material >= 0 && static_cast<size_t>(material) < library.size();
+    const size_t to =
+        3 * starts[known ? static_cast<size_t>(material) : defaultBucket]++;
+    std::copy_n(corners.begin() + static_cast<ptrdiff_t>(3 * t), 3,
+                grouped.begin() + static_cast<ptrdiff_t>(to));
+  }
+  corners = std::move(grouped);
+}
+
+/**
+ * @brief Reads every 'mtllib' library that exists (missing ones are
+ * skipped, like tinyobj does).
+ */
+std::vector<MeshMaterial>
+loadLibraries(const std::vector<std::string> &libraries,
+              const std::filesystem::path &materialDir) {
+  std::vector<MeshMaterial> materials;
+  for (const std::string &library : libraries) {
+    const std::filesystem::path path = materialDir / library;
+    std::error_code ec;
+    if (!std::filesystem::is_regular_file(path, ec)) {
+      continue;
+    }
+    MappedFile file(path.string());
+    for (const objparser::MtlMaterial &material :
+         objparser::parseMtl(file.bytes())) {
+      materials.push_back(makeMaterial(material.name, material.diffuse,
+                                       material.diffuseTexture, materialDir));
+    }
+  }
+  return materials;
+}
+
+} // namespace
+
+/**
+ * @brief Loads a 3D model from an OBJ file into vertex and index arrays.
+ *
+ * @param filename Path to the OBJ file.
+ * @return MeshData containing unique vertices, indices and bounds.
+ *
+ * @details
+ * Uses TinyOBJLoader to parse the OBJ file.
+ * The function:
+ * - Reads vertex positions and texture coordinates
+ * - Flips the Y-axis of texture coordinates to match Vulkan convention
+ * - Assigns a default vertex color
+ * - Groups triangles by material (materials from the 'mtllib' library)
+ * - Deduplicates vertices with vertexdedup::deduplicate()
+ * - Computes the model-space bounding box
+ *
+ * @throws std::runtime_error If the OBJ file cannot be loaded or parsed.
+ *
+ * @note Vulkan expects a single contiguous vertex buffer and an index buffer
+ * for drawing, which is why duplicate vertices are eliminated.
+ */
+MeshData loadObj(const std::string &filename) {
+  tinyobj::attrib_t attrib;
+  std::vector<tinyobj::shape_t> shapes;
+  std::vector<tinyobj::material_t> materials;
+  std::string warn, err;
+
+  // Parses OBJ file from disk; 'mtllib' paths are relative to the OBJ
+  const std::filesystem::path materialDir =
+      std::filesystem::path(filename).parent_path();
+  const std::string mtlBaseDir =
+      materialDir.empty() ? std::string() : materialDir.string() + "/";
+  if (!LoadObj(&attrib, &shapes, &materials, &warn, &err, filename.c_str(),
+               mtlBaseDir.empty() ? nullptr : mtlBaseDir.c_str())) {
+    throw std::runtime_error(warn + err);
+  }
+
+  // Iterate over meshes / faces
+  std::vector<Vertex> corners;
+  std::vector<int32_t> triangleMaterials;
+  for (const auto &shape : shapes) {
+    triangleMaterials.insert(triangleMaterials.end(),
+                             shape.mesh.material_ids.begin(),
+                             shape.mesh.material_ids.end());
+    for (const auto &index : shape.mesh.indices) {
+
+      Vertex vertex{};
+      // Extract vertex position from indexed OBJ arrays
+      vertex.position = {attrib.vertices[3 * index.vertex_index + 0],
+                         attrib.vertices[3 * index.vertex_index + 1],
+                         attrib.vertices[3 * index.vertex_index + 2]};
+
+      // Extract texture coordinates (flip Y axis for Vulkan)
+      vertex.texCoord = {attrib.texcoords[2 * index.texcoord_index + 0],
+                         1.0f - attrib.texcoords[2 * index.texcoord_index + 1]};
+
+      vertex.color = {1.0f, 1.0f, 1.0f}; // Default white vertex color
+
+      corners.push_back(vertex);
+    }
+  }
+
+  std::vector<MeshMaterial> library;
+  for (const tinyobj::material_t &material : materials) {
+    library.push_back(makeMaterial(material.name, material.diffuse,
+                                   material.diffuse_texname, materialDir));
+  }
+
+  // Group by material, then collapse equal corners into unique vertices +
+  // indices
+  MeshData mesh;
+  groupByMaterial(corners, triangleMaterials, library, mesh);
+  vertexdedup::deduplicate(corners, mesh);
+
+  mesh.computeBounds();
+  return mesh;
+}
+
+/**
+ * @brief Loads an OBJ file with the multi-threaded objparser backend.
+ *
+ * @param filename Path to the OBJ file.
+ * @param pool Worker pool used for parsing and vertex assembly.
+ * @return MeshData containing unique vertices, indices and bounds.
+ *
+ * @details
+ * - Maps the file read-only (no intermediate copy of the text)
+ * - Parses and triangulates it in parallel via objparser::parse()
+ * - Assembles one Vertex per corner in parallel (flipped V, white color)
+ * - Reads the 'mtllib' libraries and groups triangles by material
+ * - Deduplicates in corner order, exactly like loadObj(), so the resulting
+ *   vertex order and indices are identical to the tinyobj path (meshes of
+ *   vertexdedup::kParallelThreshold corners or more use the sharded mode)
+ *
+ * A corner without a texture coordinate gets (0, 1), i.e. OBJ (0, 0).
+ *
+ * @throws std::runtime_error If the file cannot be mapped or parsed.
+ */
+MeshData loadObjParallel(const std::string &filename, ThreadPool &pool) {
+  MappedFile file(filename);
+  return loadObjParallel(
+      file.bytes(), std::filesystem::path(filename).parent_path().string(),
+      pool);
+}
+
+MeshData loadObjParallel(std::span<const std::byte> text,
+                         const std::string &materialDir, ThreadPool &pool) {
+  objparser::ObjData obj = objparser::parse(text, pool);
+
+  // Build per-corner vertices in parallel (fixed-size slices)
+  const size_t cornerCount = obj.cornerCount();
+  std::vector<Vertex> corners(cornerCount);
+  constexpr size_t kSliceSize = 64 * 1024;
+  const size_t sliceCount = (cornerCount + kSliceSize - 1) / kSliceSize;
+  pool.parallelFor(sliceCount, [&](size_t slice) {
+    const size_t end = std::min(cornerCount, (slice + 1) * kSliceSize);
+    for (size_t c = slice * kSliceSize; c < end; c++) {
+      const size_t p = 3 * static_cast<size_t>(obj.positionIndices[c]);
+      Vertex &vertex = corners[c];
+      vertex.position = {obj.positions[p + 0], obj.positions[p + 1],
+                         obj.positions[p + 2]};
+
+      const int32_t t = obj.texcoordIndices[c];
+      vertex.texCoord =
+          t < 0 ? glm::vec2(0.0f, 1.0f)
+                : glm::vec2(obj.texcoords[2 * static_cast<size_t>(t) + 0],
+                            1.0f - obj.texcoords[2 * static_cast<size_t>(t) + 1]);
+
+      vertex.color = {1.0f, 1.0f, 1.0f}; // Default white vertex color
+    }
+  });
+
+  MeshData mesh;
+  if (!obj.triangleMaterials.empty()) {
+    // Usemtl names -> library ids (-1 if the library lacks the name)
+    const std::vector<MeshMaterial> library =
+        loadLibraries(obj.materialLibraries, materialDir);
+    std::vector<int32_t> libraryIds(obj.materialNames.size(), -1);
+    for (size_t i = 0; i < obj.materialNames.size(); i++) {
+      for (size_t m = 0; m < library.size(); m++) {
+        if (library[m].name == obj.materialNames[i]) {
+          libraryIds[i] = static_cast<int32_t>(m);
+          break;
+        }
+      }
+    }
+    for (int32_t &material : obj.triangleMaterials) {
+      material = material < 0 ? -1 : libraryIds[static_cast<size_t>(material)];
+    }
+    groupByMaterial(corners, obj.triangleMaterials, library, mesh);
+  }
+
+  // Deduplicate in corner order so output matches loadObj(); large meshes
+  // use the sharded parallel mode (same result)
+  if (cornerCount >= vertexdedup::kParallelThreshold && pool.size() > 1) {
+    vertexdedup::deduplicateParallel(corners, mesh, pool);
+  } else {
+    vertexdedup::deduplicate(corners, mesh);
+  }
+
+  mesh.computeBounds();
+  return mesh;
+}
+
+} // namespace meshloader
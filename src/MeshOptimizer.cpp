@@ -0,0 +1,360 @@
+/**
+ * @file MeshOptimizer.cpp
+ * @brief Tipsify vertex cache optimization, cluster overdraw sorting and
+ *        vertex fetch remapping.
+ *
+ * @see MeshOptimizer.hpp
+ */
+#include "../include/MeshOptimizer.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+namespace meshopt {
+
+namespace {
+
+/** @brief Smallest cluster optimizeOverdraw() will cut off. */
+constexpr size_t kMinClusterTriangles = 32;
+
+/** @brief Marker for "not yet assigned" in remap tables. */
+constexpr uint32_t kUnassigned = std::numeric_limits<uint32_t>::max();
+
+/**
+ * @class FifoCache
+ * @brief Timestamp-based FIFO cache simulation.
+ *
+ * A vertex is resident iff fewer than 'size' misses happened since it was
+ * last inserted. reset() empties the cache in O(1) by advancing the clock.
+ */
+class FifoCache {
+public:
+  FifoCache(size_t vertexCount, uint32_t cacheSize)
+      : insertTime(vertexCount, 0), size(cacheSize), time(cacheSize + 1) {}
+
+  /** @brief Touches a vertex; returns true on a miss. */
+  bool access(uint32_t vertex) {
+    if (time - insertTime[vertex] > size) {
+      insertTime[vertex] = time++;
+      return true;
+    }
+    return false;
+  }
+
+  /** @brief Evicts everything. */
+  void reset() { time += size + 1; }
+
+private:
+  std::vector<uint64_t> insertTime;
+  uint64_t size;
+  uint64_t time;
+};
+
+} // namespace
+
+/**
+ * @brief FIFO cache simulation over a triangle list.
+ *
+ * @param indices Triangle list.
+ * @param vertexCount Size of the vertex array.
+ * @param cacheSize Cache entries.
+ * @return ACMR (misses / triangles) and ATVR (misses / referenced vertices).
+ */
+CacheStats analyzeVertexCache(std::span<const uint32_t> indices,
+                              size_t vertexCount, uint32_t cacheSize) {
+  CacheStats stats;
+  const size_t triangleCount = indices.size() / 3;
+  if (triangleCount == 0) {
+    return stats;
+  }
+
+  FifoCache cache(vertexCount, cacheSize);
+  std::vector<uint8_t> referenced(vertexCount, 0);
+  size_t misses = 0, unique = 0;
+  for (size_t i = 0; i < triangleCount * 3; i++) {
+    misses += cache.access(indices[i]);
+    unique += referenced[indices[i]] == 0;
+    referenced[indices[i]] = 1;
+  }
+
+  stats.acmr = static_cast<double>(misses) / triangleCount;
+  stats.atvr = static_cast<double>(misses) / std::max<size_t>(1, unique);
+  return stats;
+}
+
+/**
+ * @brief Tipsify triangle reordering (Sander, Nehab, Barczak 2007).
+ *
+ * @param indices Triangle list, rewritten in place.
+ * @param vertexCount Size of the vertex array.
+ * @param cacheSize Target cache size.
+ *
+ * @details
+ * Emits all remaining triangles around a "fanning" vertex, then picks the
+ * next fanning vertex among the ones just touched: the one that entered the
+ * cache earliest but will still be resident after emitting its remaining
+ * triangles (2 new vertices per triangle in the worst case). When no
+ * candidate qualifies, the most recently touched vertex with live triangles
+ * is taken from a dead-end stack, and as a last resort the next vertex with
+ * live triangles in index order. Runs in linear time.
+ */
+void optimizeVertexCache(std::span<uint32_t> indices, size_t vertexCount,
+                         uint32_t cacheSize) {
+  const size_t triangleCount = indices.size() / 3;
+  if (triangleCount == 0) {
+    return;
+  }
+
+  // Vertex -> triangle adjacency (CSR) and live triangle counts
+  std::vector<uint32_t> liveTriangles(vertexCount, 0);
+  for (size_t i = 0; i < triangleCount * 3; i++) {
+    liveTriangles[indices[i]]++;
+  }
+  std::vector<uint32_t> offsets(vertexCount + 1, 0);
+  std::partial_sum(liveTriangles.begin(), liveTriangles.end(),
+                   offsets.begin() + 1);
+  std::vector<uint32_t> adjacency(triangleCount * 3);
+  {
+    std::vector<uint32_t> cursor(offsets.begin(), offsets.end() - 1);
+    for (size_t i = 0; i < triangleCount * 3; i++) {
+      adjacency[cursor[indices[i]]++] = static_cast<uint32_t>(i / 3);
+    }
+  }
+
+  std::vector<uint64_t> cacheTime(vertexCount, 0);
+  std::vector<uint8_t> emitted(triangleCount, 0);
+  std::vector<uint32_t> deadEnd;
+  std::vector<uint32_t> candidates;
+  std::vector<uint32_t> output;
+  deadEnd.reserve(triangleCount * 3);
+  output.reserve(triangleCount * 3);
+
+  uint64_t time = cacheSize + 1;
+  size_t scanCursor = 0;
+  int64_t fanning = indices[0];
+
+  while (fanning >= 0) {
+    const uint32_t f = static_cast<uint32_t>(fanning);
+    candidates.clear();
+
+    // Emit every remaining triangle around the fanning vertex
+    for (uint32_t k = offsets[f]; k < offsets[f + 1]; k++) {
+      const uint32_t triangle = adjacency[k];
+      if (emitted[triangle]) {
+        continue;
+      }
+      emitted[triangle] = 1;
+      for (int corner = 0; corner < 3; corner++) {
+        const uint32_t v = indices[triangle * 3 + corner];
+        output.push_back(v);
+        deadEnd.push_back(v);
+        candidates.push_back(v);
+        liveTriangles[v]--;
+        if (time - cacheTime[v] > cacheSize) {
+          cacheTime[v] = time++;
+        }
+      }
+    }
+
+    // Next fanning vertex: oldest candidate that stays resident
+    fanning = -1;
+    int64_t bestPriority = -1;
+    for (uint32_t v : candidates) {
+      if (liveTriangles[v] == 0) {
+        continue;
+      }
+      int64_t priority = 0;
+      if (time - cacheTime[v] + 2 * liveTriangles[v] <= cacheSize) {
+        priority = static_cast<int64_t>(time - cacheTime[v]);
+      }
+      if (priority > bestPriority) {
+        bestPriority = priority;
+        fanning = v;
+      }
+    }
+
+    // Dead end: most recently touched live vertex, then any live vertex
+    while (fanning < 0 && !deadEnd.empty()) {
+      const uint32_t v = deadEnd.back();
+      deadEnd.pop_back();
+      if (liveTriangles[v] > 0) {
+        fanning = v;
+      }
+    }
+    while (fanning < 0 && scanCursor < vertexCount) {
+      if (liveTriangles[scanCursor] > 0) {
+        fanning = static_cast<int64_t>(scanCursor);
+      }
+      scanCursor++;
+    }
+  }
+
+  std::copy(output.begin(), output.end(), indices.begin());
+}
+
+/**
+ * @brief Cluster-based overdraw reduction (Sander et al. 2007, section 4).
+ *
+ * @param indices Cache-optimized triangle list, rewritten in place.
+ * @param vertices Vertex positions.
+ * @param cacheSize Cache size for the split simulation.
+ * @param threshold Allowed ACMR growth factor.
+ *
+ * @details
+ * The cache-optimized sequence is cut into clusters: a cluster ends as soon
+ * as its own ACMR (simulated from a cold cache) drops to 'threshold' times
+ * the ACMR of the whole sequence, so concatenating clusters in any order
+ * keeps the overall ACMR within that bound. Clusters are then sorted by how
+ * far they face outward from the mesh centroid,
+ * dot(clusterCentroid - meshCentroid, clusterNormal), largest first, so
+ * occluding outer surfaces tend to be drawn before what they hide.
+ */
+void optimizeOverdraw(std::span<uint32_t> indices,
+                      std::span<const Vertex> vertices, uint32_t cacheSize,
+                      float threshold) {
+  const size_t triangleCount = indices.size() / 3;
+  if (triangleCount <= kMinClusterTriangles) {
+    return;
+  }
+
+  const double targetAcmr =
+      analyzeVertexCache(indices, vertices.size(), cacheSize).acmr * threshold;
+
+  // Split into clusters
+  std::vector<size_t> clusterStart{0};
+  FifoCache cache(vertices.size(), cacheSize);
+  size_t misses = 0, clusterTriangles = 0;
+  for (size_t t = 0; t < triangleCount; t++) {
+    for (int corner = 0; corner < 3; corner++) {
+      misses += cache.access(indices[t * 3 + corner]);
+    }
+    clusterTriangles++;
+    if (clusterTriangles >= kMinClusterTriangles &&
+        misses <= targetAcmr * clusterTriangles && t + 1 < triangleCount) {
+      clusterStart.push_back(t + 1);
+      misses = clusterTriangles = 0;
+      cache.reset();
+    }
+  }
+  clusterStart.push_back(triangleCount);
+  const size_t clusterCount = clusterStart.size() - 1;
+  if (clusterCount < 2) {
+    return;
+  }
+
+  // Area-weighted centroid and normal per cluster
+  std::vector<glm::vec3> centroids(clusterCount, glm::vec3(0.0f));
+  std::vector<glm::vec3> normals(clusterCount, glm::vec3(0.0f));
+  std::vector<float> areas(clusterCount, 0.0f);
+  glm::vec3 meshCentroid(0.0f);
+  float meshArea = 0.0f;
+  for (size_t c = 0; c < clusterCount; c++) {
+    for (size_t t = clusterStart[c]; t < clusterStart[c + 1]; t++) {
+      const glm::vec3 &p0 = vertices[indices[t * 3 + 0]].position;
+      const glm::vec3 &p1 = vertices[indices[t * 3 + 1]].position;
+      const glm::vec3 &p2 = vertices[indices[t * 3 + 2]].position;
+      const glm::vec3 normal = glm::cross(p1 - p0, p2 - p0); // |n| = 2 * area
+      const float area = glm::length(normal);
+      centroids[c] += (p0 + p1 + p2) * (area / 3.0f);
+      normals[c] += normal;
+      areas[c] += area;
+    }
+    meshCentroid += centroids[c];
+    meshArea += areas[c];
+  }
+  if (meshArea > 0.0f) {
+    meshCentroid /= meshArea;
+  }
+
+  std::vector<float> sortKey(clusterCount, 0.0f);
+  for (size_t c = 0; c < clusterCount; c++) {
+    const float normalLength = glm::length(normals[c]);
+    if (areas[c] > 0.0f && normalLength > 0.0f) {
+      sortKey[c] = glm::dot(centroids[c] / areas[c] - meshCentroid,
+                            normals[c] / normalLength);
+    }
+  }
+
+  std::vector<size_t> order(clusterCount);
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+    return sortKey[a] > sortKey[b];
+  });
+
+  std::vector<uint32_t> sorted;
+  sorted.reserve(triangleCount * 3);
+  for (size_t c : order) {
+    sorted.insert(sorted.end(), indices.begin() + clusterStart[c] * 3,
+                  indices.begin() + clusterStart[c + 1] * 3);
+  }
+  std::copy(sorted.begin(), sorted.end(), indices.begin());
+}
+
+/**
+ * @brief First-use vertex renumbering.
+ *
+ * @param mesh Mesh rewritten in place.
+ *
+ * @details After cache optimization, first use order is also (nearly) the
+ * order in which the GPU fetches vertices, so the vertex buffer is read
+ * close to sequentially.
+ */
+void optimizeVertexFetch(MeshData &mesh) {
+  std::vector<uint32_t> remap(mesh.vertices.size(), kUnassigned);
+  std::vector<Vertex> reordered;
+  reordered.reserve(mesh.vertices.size());
+
+  for (uint32_t &index : mesh.indices) {
+    if (remap[index] == kUnassigned) {
+      remap[index] = static_cast<uint32_t>(reordered.size());
+      reordered.push_back(mesh.vertices[index]);
+    }
+    index = remap[index];
+  }
+
+  mesh.vertices = std::move(reordered);
+}
+
+/**
+ * @brief Runs the configured optimization passes.
+ *
+ * @param mesh Mesh optimized in place.
+ * @param options Passes and parameters.
+ * @return Cache statistics before and after.
+ *
+ * @details With material ranges (MeshData::submeshes) the cache and
+ * overdraw passes run on each range separately.
+ */
+Report optimize(MeshData &mesh, const Options &options) {
+  Report report;
+  report.before =
+      analyzeVertexCache(mesh.indices, mesh.vertices.size(), options.cacheSize);
+
+  // Triangles are reordered within each material range only, so the ranges
+  // stay valid
+  std::vector<std::span<uint32_t>> ranges;
+  for (const MeshSubmesh &submesh : mesh.submeshes) {
+    ranges.push_back(std::span<uint32_t>(mesh.indices)
+                         .subspan(submesh.indexOffset, submesh.indexCount));
+  }
+  if (ranges.empty()) {
+    ranges.push_back(mesh.indices);
+  }
+  for (std::span<uint32_t> range : ranges) {
+    optimizeVertexCache(range, mesh.vertices.size(), options.cacheSize);
+    if (options.overdraw) {
+      optimizeOverdraw(range, mesh.vertices, options.cacheSize,
+                       options.overdrawThreshold);
+    }
+  }
+  optimizeVertexFetch(mesh);
+
+  report.after =
+      analyzeVertexCache(mesh.indices, mesh.vertices.size(), options.cacheSize);
+  return report;
+}
+
+} // namespace meshopt
@@ -0,0 +1,486 @@
+/**
+ * @file MeshSimplifier.cpp
+ * @brief Quadric half-edge-collapse simplifier, LOD chain builder and
+ *        screen-space error LOD selection.
+ *
+ * @see MeshSimplifier.hpp
+ */
+#include "../include/MeshSimplifier.hpp"
+#include "../include/MeshOptimizer.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+namespace meshlod {
+
+namespace {
+
+/** @brief Generated levels must drop at least this fraction of triangles. */
+constexpr float kMinLevelReduction = 0.05f;
+
+/** @brief Collapses may rotate a face normal by at most ~75 degrees. */
+constexpr float kMinNormalCosine = 0.25f;
+
+/**
+ * @struct Quadric
+ * @brief Symmetric 4x4 error quadric (Garland & Heckbert) plus its weight.
+ *
+ * Stores the upper triangle of sum(w * p * p^T) for planes p = (n, d).
+ */
+struct Quadric {
+  double a00 = 0, a01 = 0, a02 = 0, a03 = 0;
+  double a11 = 0, a12 = 0, a13 = 0;
+  double a22 = 0, a23 = 0;
+  double a33 = 0;
+  double weight = 0;
+
+  /** @brief Adds the plane n.x + d = 0 with weight w. */
+  void addPlane(const glm::vec3 &n, double d, double w) {
+    a00 += w * n.x * n.x, a01 += w * n.x * n.y, a02 += w * n.x * n.z;
+    a03 += w * n.x * d, a11 += w * n.y * n.y, a12 += w * n.y * n.z;
+    a13 += w * n.y * d, a22 += w * n.z * n.z, a23 += w * n.z * d;
+    a33 += w * d * d;
+    weight += w;
+  }
+
+  Quadric &operator+=(const Quadric &o) {
+    a00 += o.a00, a01 += o.a01, a02 += o.a02, a03 += o.a03;
+    a11 += o.a11, a12 += o.a12, a13 += o.a13;
+    a22 += o.a22, a23 += o.a23, a33 += o.a33;
+    weight += o.weight;
+    return *this;
+  }
+
+  /** @brief Weighted sum of squared distances of p to all planes. */
+  double evaluate(const glm::vec3 &p) const {
+    const double x = p.x, y = p.y, z = p.z;
+    return a00 * x * x + 2 * a01 * x * y + 2 * a02 * x * z + 2 * a03 * x +
+           a11 * y * y + 2 * a12 * y * z + 2 * a13 * y + a22 * z * z +
+           2 * a23 * z + a33;
+  }
+};
+
+/** @brief Packs an undirected edge into a sortable key. */
+inline uint64_t edgeKey(uint32_t a, uint32_t b) {
+  return a < b ? (static_cast<uint64_t>(a) << 32) | b
+               : (static_cast<uint64_t>(b) << 32) | a;
+}
+
+/**
+ * @struct Collapse
+ * @brief Candidate half-edge collapse 'from' -> 'to' with its error.
+ */
+struct Collapse {
+  uint32_t from;
+  uint32_t to;
+  float error; ///< Squared distance error (model units^2)
+};
+
+/**
+ * @brief Marks vertices on borders or non-manifold edges as locked.
+ *
+ * An edge used by exactly one triangle is a border; with indexed vertices
+ * this includes attribute seams, so seams are never collapsed.
+ */
+void findLockedVertices(std::span<const uint32_t> indices,
+                        std::vector<uint8_t> &locked) {
+  std::vector<uint64_t> edges;
+  edges.reserve(indices.size());
+  for (size_t t = 0; t + 2 < indices.size(); t += 3) {
+    for (int e = 0; e < 3; e++) {
+      edges.push_back(edgeKey(indices[t + e], indices[t + (e + 1) % 3]));
+    }
+  }
+  std::sort(edges.begin(), edges.end());
+
+  for (size_t i = 0; i < edges.size();) {
+    size_t j = i + 1;
+    while (j < edges.size() && edges[j] == edges[i]) {
+      j++;
+    }
+    if (j - i != 2) { // Border (1) or non-manifold (>2) edge
+      locked[edges[i] >> 32] = 1;
+      locked[edges[i] & 0xFFFFFFFFu] = 1;
+    }
+    i = j;
+  }
+}
+
+/** @brief Unnormalized face normal (length = 2 * area). */
+inline glm::vec3 faceNormal(const glm::vec3 &a, const glm::vec3 &b,
+                            const glm::vec3 &c) {
+  return glm::cross(b - a, c - a);
+}
+
+} // namespace
+
+/**
+ * @brief Quadric-error simplification by half-edge collapse.
+ *
+ * @param indices Input triangles.
+ * @param vertices Vertex positions.
+ * @param targetIndexCount Stop once the result has at most this many indices.
+ * @param maxError Largest allowed per-collapse error (model units).
+ * @param resultError Optional output: largest error actually used.
+ * @return Simplified index list.
+ *
+ * @details
+ * Works in passes. Each pass:
+ * 1. builds vertex->triangle adjacency for the current triangles,
+ * 2. evaluates every interior edge in both directions with the summed
+ *    quadric of its endpoints at the surviving vertex's position, keeping
+ *    the cheaper valid direction,
+ * 3. sorts candidates by error and applies them greedily, skipping any
+ *    collapse that touches a vertex whose one-ring already changed in this
+ *    pass (so the validity checks below stay exact), that fails the link
+ *    condition (would create non-manifold edges), or that flips a face,
+ * 4. rewrites the triangles and drops the degenerate ones.
+ * Passes repeat until the target is met or nothing can be collapsed.
+ */
+std::vector<uint32_t> simplify(std::span<const uint32_t> indices,
+                               std::span<const Vertex> vertices,
+                               size_t targetIndexCount, float maxError,
+                               float *resultError) {
+  std::vector<uint32_t> result(indices.begin(),
+                               indices.begin() + indices.size() / 3 * 3);
+  const size_t vertexCount = vertices.size();
+  const double maxErrorSq = static_cast<double>(maxError) * maxError;
+  float worstErrorSq = 0.0f;
+
+  // Area-weighted plane quadrics from the input triangles
+  std::vector<Quadric> quadrics(vertexCount);
+  for (size_t t = 0; t < result.size(); t += 3) {
+    const glm::vec3 &p0 = vertices[result[t + 0]].position;
+    const glm::vec3 &p1 = vertices[result[t + 1]].position;
+    const glm::vec3 &p2 = vertices[result[t + 2]].position;
+    glm::vec3 normal = faceNormal(p0, p1, p2);
+    const float length = glm::length(normal);
+    if (length <= 0.0f) {
+      continue;
+    }
+    normal /= length;
+    const double d = -glm::dot(normal, p0);
+    for (int c = 0; c < 3; c++) {
+      quadrics[result[t + c]].addPlane(normal, d, 0.5 * length);
+    }
+  }
+
+  std::vector<uint8_t> locked(vertexCount, 0);
+  findLockedVertices(result, locked);
+
+  std::vector<uint32_t> offsets(vertexCount + 1);
+  std::vector<uint32_t> adjacency;
+  std::vector<Collapse> collapses;
+  std::vector<uint8_t> touched(vertexCount);
+  std::vector<uint32_t> remap(vertexCount);
+  std::vector<uint32_t> ringU, ringV;
+
+  while (result.size() > targetIndexCount) {
+    const size_t triangleCount = result.size() / 3;
+
+    // 1. Vertex -> triangle adjacency (CSR)
+    std::fill(offsets.begin(), offsets.end(), 0);
+    for (uint32_t v : result) {
+      offsets[v + 1]++;
+    }
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+    adjacency.resize(result.size());
+    {
+      std::vector<uint32_t> cursor(offsets.begin(), offsets.end() - 1);
+      for (size_t i = 0; i < result.size(); i++) {
+        adjacency[cursor[result[i]]++] = static_cast<uint32_t>(i / 3);
+      }
+    }
+
+    // 2. Candidate collapses (each interior edge once, cheaper direction)
+    collapses.clear();
+    for (size_t t = 0; t < triangleCount; t++) {
+      for (int e = 0; e < 3; e++) {
+        const uint32_t a = result[t * 3 + e];
+        const uint32_t b = result[t * 3 + (e + 1) % 3];
+        if (a > b || (locked[a] && locked[b])) {
+          continue;
+        }
+        Quadric combined = quadrics[a];
+        combined += quadrics[b];
+        const double weight = std::max(combined.weight, 1e-30);
+        const double errorAB = locked[a] ? std::numeric_limits<double>::max()
+                                         : combined.evaluate(vertices[b].position) / weight;
+        const double errorBA = locked[b] ? std::numeric_limits<double>::max()
+                                         : combined.evaluate(vertices[a].position) / weight;
+        const bool aToB = errorAB <= errorBA;
+        const double error = std::max(0.0, aToB ? errorAB : errorBA);
+        if (error <= maxErrorSq) {
+          collapses.push_back({aToB ? a : b, aToB ? b : a,
+                               static_cast<float>(error)});
+        }
+      }
+    }
+    if (collapses.empty()) {
+      break;
+    }
+    std::sort(collapses.begin(), collapses.end(),
+              [](const Collapse &x, const Collapse &y) {
+                return x.error < y.error;
+              });
+
+    // 3. Greedy application
+    std::fill(touched.begin(), touched.end(), 0);
+    std::iota(remap.begin(), remap.end(), 0);
+    const size_t trianglesToRemove = triangleCount - targetIndexCount / 3;
+    size_t removed = 0;
+    size_t applied = 0;
+
+    for (const Collapse &collapse : collapses) {
+      const uint32_t u = collapse.from, v = collapse.to;
+      if (touched[u] || touched[v]) {
+        continue;
+      }
+
+      // Link condition: common neighbours must be exactly the opposite
+      // vertices of the triangles sharing the edge
+      ringU.clear();
+      ringV.clear();
+      size_t shared = 0;
+      for (uint32_t k = offsets[u]; k < offsets[u + 1]; k++) {
+        const uint32_t *tri = &result[adjacency[k] * 3];
+        bool hasV = tri[0] == v || tri[1] == v || tri[2] == v;
+        shared += hasV;
+        for (int c = 0; c < 3; c++) {
+          if (tri[c] != u && tri[c] != v) {
+            ringU.push_back(tri[c]);
+          }
+        }
+      }
+      for (uint32_t k = offsets[v]; k < offsets[v + 1]; k++) {
+        const uint32_t *tri = &result[adjacency[k] * 3];
+        for (int c = 0; c < 3; c++) {
+          if (tri[c] != u && tri[c] != v) {
+            ringV.push_back(tri[c]);
+          }
+        }
+      }
+      std::sort(ringU.begin(), ringU.end());
+      ringU.erase(std::unique(ringU.begin(), ringU.end()), ringU.end());
+      std::sort(ringV.begin(), ringV.end());
+      ringV.erase(std::unique(ringV.begin(), ringV.end()), ringV.end());
+      size_t common = 0;
+      for (size_t i = 0, j = 0; i < ringU.size() && j < ringV.size();) {
+        if (ringU[i] < ringV[j]) {
+          i++;
+        } else if (ringU[i] > ringV[j]) {
+          j++;
+        } else {
+          common++, i++, j++;
+        }
+      }
+      if (shared == 0 || common > shared) {
+        continue;
+      }
+
+      // Reject collapses that flip (or nearly flip) a remaining face
+      bool flips = false;
+      for (uint32_t k = offsets[u]; k < offsets[u + 1] && !flips; k++) {
+        const uint32_t *tri = &result[adjacency[k] * 3];
+        if (tri[0] == v || tri[1] == v || tri[2] == v) {
+          continue; // Collapses away
+        }
+        glm::vec3 p[3], q[3];
+        for (int c = 0; c < 3; c++) {
+          p[c] = vertices[tri[c]].position;
+          q[c] = tri[c] == u ? vertices[v].position : p[c];
+        }
+        const glm::vec3 before = faceNormal(p[0], p[1], p[2]);
+        const glm::vec3 after = faceNormal(q[0], q[1], q[2]);
+        flips = glm::dot(before, after) <=
+                kMinNormalCosine * glm::length(before) * glm::length(after);
+      }
+      if (flips) {
+        continue;
+      }
+
+      // Apply: merge quadrics, freeze u's one-ring for the rest of the pass
+      remap[u] = v;
+      quadrics[v] += quadrics[u];
+      touched[u] = touched[v] = 1;
+      for (uint32_t w : ringU) {
+        touched[w] = 1;
+      }
+      worstErrorSq = std::max(worstErrorSq, collapse.error);
+      removed += shared;
+      applied++;
+      if (removed >= trianglesToRemove) {
+        break;
+      }
+    }
+    if (applied == 0) {
+      break;
+    }
+
+    // 4. Rewrite triangles and drop degenerates
+    size_t write = 0;
+    for (size_t t = 0; t < triangleCount; t++) {
+      const uint32_t a = remap[result[t * 3 + 0]];
+      const uint32_t b = remap[result[t * 3 + 1]];
+      const uint32_t c = remap[result[t * 3 + 2]];
+      if (a != b && b != c && a != c) {
+        result[write++] = a;
+        result[write++] = b;
+        result[write++] = c;
+      }
+    }
+    result.resize(write);
+  }
+
+  if (resultError) {
+    *resultError = std::sqrt(worstErrorSq);
+  }
+  return result;
+}
+
+/**
+ * @brief Appends coarser levels to the mesh index buffer.
+ *
+ * @param mesh Mesh (bounds must be valid).
+ * @param options Level count, reduction ratio and error limit.
+ *
+ * @details Each level is simplified from the previous one, and its recorded
+ * error is the sum of the per-level errors, which bounds the deviation from
+ * LOD 0.
+ *
+ * Material ranges (MeshData::submeshes) are simplified separately and get
+ * one submesh per level. The edges a range shares with other materials are
+ * open borders of that range, so they are locked and neighbouring materials
+ * still meet without cracks. A range that cannot be reduced further keeps
+ * its previous level; the level is dropped when the mesh as a whole shrinks
+ * by less than kMinLevelReduction.
+ */
+void buildLodChain(MeshData &mesh, const Options &options) {
+  // Restart from LOD 0 if the mesh already carries a chain
+  const uint32_t baseCount = mesh.lods.empty()
+                                 ? static_cast<uint32_t>(mesh.indices.size())
+                                 : mesh.lods[0].indexCount;
+  mesh.indices.resize(baseCount);
+  mesh.lods.assign(1, MeshLod{0, baseCount, 0.0f, 0});
+  std::erase_if(mesh.submeshes,
+                [](const MeshSubmesh &submesh) { return submesh.lod != 0; });
+
+  const float diagonal = glm::length(mesh.boundsMax - mesh.boundsMin);
+  const float maxError = options.maxError * diagonal;
+
+  // One group per material range (or the whole mesh)
+  const std::vector<MeshSubmesh> baseSubmeshes = mesh.submeshes;
+  std::vector<std::vector<uint32_t>> previous;
+  for (const MeshSubmesh &submesh : baseSubmeshes) {
+    auto first = mesh.indices.begin() + submesh.indexOffset;
+    previous.emplace_back(first, first + submesh.indexCount);
+  }
+  if (previous.empty()) {
+    previous.emplace_back(mesh.indices.begin(), mesh.indices.end());
+  }
+
+  float accumulatedError = 0.0f;
+  for (size_t level = 1; level < options.levelCount; level++) {
+    std::vector<std::vector<uint32_t>> current;
+    size_t previousCount = 0, currentCount = 0;
+    float error = 0.0f;
+    for (const std::vector<uint32_t> &group : previous) {
+      const size_t target = static_cast<size_t>(
+          group.size() / 3 * options.reductionPerLevel) * 3;
+      float groupError = 0.0f;
+      std::vector<uint32_t> lod =
+          simplify(group, mesh.vertices, target, maxError, &groupError);
+      if (lod.empty() ||
+          lod.size() > group.size() * (1.0f - kMinLevelReduction)) {
+        lod = group; // This group cannot go further, keep its last level
+        groupError = 0.0f;
+      } else if (options.optimizeVertexCache) {
+        meshopt::optimizeVertexCache(lod, mesh.vertices.size());
+      }
+      previousCount += group.size();
+      currentCount += lod.size();
+      error = std::max(error, groupError);
+      current.push_back(std::move(lod));
+    }
+    if (currentCount == 0 ||
+        currentCount > previousCount * (1.0f - kMinLevelReduction)) {
+      break; // Cannot simplify further within the error limit
+    }
+
+    accumulatedError += error;
+    mesh.lods.push_back(MeshLod{static_cast<uint32_t>(mesh.indices.size()),
+                                static_cast<uint32_t>(currentCount),
+                                accumulatedError, 0});
+    for (size_t g = 0; g < baseSubmeshes.size(); g++) {
+      mesh.submeshes.push_back(
+          MeshSubmesh{static_cast<uint32_t>(mesh.indices.size()),
+                      static_cast<uint32_t>(current[g].size()),
+                      baseSubmeshes[g].material, static_cast<uint32_t>(level)});
+      mesh.indices.insert(mesh.indices.end(), current[g].begin(),
+                          current[g].end());
+    }
+    if (baseSubmeshes.empty()) {
+      mesh.indices.insert(mesh.indices.end(), current[0].begin(),
+                          current[0].end());
+    }
+    previous = std::move(current);
+  }
+}
+
+/**
+ * @brief Pixels covered by one model unit at the nearest point of the
+ * model's bounding sphere.
+ *
+ * @details
+ * For a perspective projection, a length L at view depth z covers
+ * L * proj[1][1] * viewportHeight / (2 * z) pixels. The model scale is the
+ * largest column length of the model matrix, and the depth is the distance
+ * to the sphere centre minus its radius (conservative).
+ */
+float pixelsPerUnit(const glm::mat4 &model, const glm::mat4 &view,
+                    const glm::mat4 &proj, glm::vec3 boundsMin,
+                    glm::vec3 boundsMax, float viewportHeight) {
+  const glm::vec3 center = (boundsMin + boundsMax) * 0.5f;
+  const float scale = std::max({glm::length(glm::vec3(model[0])),
+                                glm::length(glm::vec3(model[1])),
+                                glm::length(glm::vec3(model[2]))});
+  const float radius = glm::length(boundsMax - boundsMin) * 0.5f * scale;
+
+  const glm::vec3 viewCenter(view * (model * glm::vec4(center, 1.0f)));
+  const float distance = glm::length(viewCenter) - radius;
+  if (distance <= 1e-6f) {
+    return std::numeric_limits<float>::infinity();
+  }
+  return scale * std::abs(proj[1][1]) * viewportHeight / (2.0f * distance);
+}
+
+/**
+ * @brief Coarsest level whose error projects to at most 'maxPixelError'.
+ */
+uint32_t selectLod(std::span<const MeshLod> lods, const glm::mat4 &model,
+                   const glm::mat4 &view, const glm::mat4 &proj,
+                   glm::vec3 boundsMin, glm::vec3 boundsMax,
+                   float viewportHeight, float maxPixelError) {
+  if (lods.size() <= 1) {
+    return 0;
+  }
+  return lodForPixels(
+      lods,
+      pixelsPerUnit(model, view, proj, boundsMin, boundsMax, viewportHeight),
+      maxPixelError);
+}
+
+uint32_t lodForPixels(std::span<const MeshLod> lods, float pixelsPerUnit,
+                      float maxPixelError) {
+  for (size_t level = lods.empty() ? 0 : lods.size() - 1; level > 0;
+       level--) {
+    if (lods[level].error * pixelsPerUnit <= maxPixelError) {
+      return static_cast<uint32_t>(level);
+    }
+  }
+  return 0;
+}
+
+} // namespace meshlod
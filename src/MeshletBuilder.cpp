@@ -0,0 +1,248 @@
+/**
+ * @file MeshletBuilder.cpp
+ * @brief Meshlet splitting, bounds/normal cone computation and the CPU
+ *        reference of the cluster culling test.
+ *
+ * @see MeshletBuilder.hpp
+ */
+#include "../include/MeshletBuilder.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace meshlet {
+
+namespace {
+
+/** @brief Cones narrower than this (min dot with the axis) are not culled. */
+constexpr float kMinConeDot = 0.1f;
+
+/**
+ * @brief Computes the bounding sphere and normal cone of a finished meshlet.
+ *
+ * @details
+ * The sphere is centred on the AABB of the meshlet's vertices. The cone axis
+ * is the normalized sum of the unit triangle normals, and 'coneCutoff' is
+ * sin(acos(min dot(axis, normal))), as used by the conservative test
+ * dot(center - camera, axis) >= cutoff * |center - camera| + radius.
+ */
+void computeBounds(Meshlet &meshlet, std::span<const uint32_t> indices,
+                   std::span<const Vertex> vertices) {
+  glm::vec3 boxMin(std::numeric_limits<float>::max());
+  glm::vec3 boxMax(std::numeric_limits<float>::lowest());
+  for (uint32_t index : indices) {
+    boxMin = glm::min(boxMin, vertices[index].position);
+    boxMax = glm::max(boxMax, vertices[index].position);
+  }
+  const glm::vec3 center = (boxMin + boxMax) * 0.5f;
+  float radius = 0.0f;
+  for (uint32_t index : indices) {
+    radius = std::max(radius, glm::length(vertices[index].position - center));
+  }
+
+  std::vector<glm::vec3> normals;
+  normals.reserve(indices.size() / 3);
+  glm::vec3 axis(0.0f);
+  for (size_t t = 0; t + 2 < indices.size(); t += 3) {
+    const glm::vec3 &p0 = vertices[indices[t + 0]].position;
+    const glm::vec3 &p1 = vertices[indices[t + 1]].position;
+    const glm::vec3 &p2 = vertices[indices[t + 2]].position;
+    const glm::vec3 normal = glm::cross(p1 - p0, p2 - p0);
+    const float length = glm::length(normal);
+    if (length > 0.0f) {
+      normals.push_back(normal / length);
+      axis += normals.back();
+    }
+  }
+
+  float cutoff = 1.0f; // Default: cone test never rejects
+  const float axisLength = glm::length(axis);
+  if (axisLength > 0.0f) {
+    axis /= axisLength;
+    float minDot = 1.0f;
+    for (const glm::vec3 &normal : normals) {
+      minDot = std::min(minDot, glm::dot(axis, normal));
+    }
+    if (minDot > kMinConeDot) {
+      cutoff = std::sqrt(1.0f - minDot * minDot);
+    }
+  }
+
+  for (int axisIndex = 0; axisIndex < 3; axisIndex++) {
+    meshlet.center[axisIndex] = center[axisIndex];
+    meshlet.coneAxis[axisIndex] = axis[axisIndex];
+  }
+  meshlet.radius = radius;
+  meshlet.coneCutoff = cutoff;
+}
+
+} // namespace
+
+/**
+ * @brief Greedy in-order meshlet split.
+ *
+ * @details
+ * Triangles are appended to the current meshlet until either limit would be
+ * exceeded. Because the triangle order is kept, each meshlet is one
+ * contiguous index range; spatial coherence comes from the input order
+ * (OBJ face order, or Tipsify order when OPTIMIZE_MESH is set).
+ */
+std::vector<Meshlet> build(std::span<const uint32_t> indices,
+                           std::span<const Vertex> vertices,
+                           uint32_t indexOffset, uint32_t maxVertices,
+                           uint32_t maxTriangles) {
+  std::vector<Meshlet> meshlets;
+  const size_t triangleCount = indices.size() / 3;
+  if (triangleCount == 0) {
+    return meshlets;
+  }
+  meshlets.reserve(triangleCount / maxTriangles + 1);
+
+  // 'owner[v] == meshlets.size()' marks v as used by the open meshlet
+  std::vector<uint32_t> owner(vertices.size(),
+                              std::numeric_limits<uint32_t>::max());
+  uint32_t start = 0, vertexCount = 0;
+
+  auto finish = [&](uint32_t end) {
+    Meshlet meshlet{};
+    meshlet.indexOffset = indexOffset + start;
+    meshlet.indexCount = end - start;
+    meshlet.vertexCount = vertexCount;
+    computeBounds(meshlet, indices.subspan(start, end - start), vertices);
+    meshlets.push_back(meshlet);
+    start = end;
+    vertexCount = 0;
+  };
+
+  // Distinct vertices of a triangle not yet used by meshlet 'id'
+  auto countNew = [&](const uint32_t *triangle, uint32_t id) {
+    uint32_t count = 0;
+    for (int c = 0; c < 3; c++) {
+      count += owner[triangle[c]] != id &&
+               (c < 1 || triangle[c] != triangle[0]) &&
+               (c < 2 || triangle[c] != triangle[1]);
+    }
+    return count;
+  };
+
+  for (size_t t = 0; t < triangleCount; t++) {
+    const uint32_t *triangle = &indices[t * 3];
+    uint32_t id = static_cast<uint32_t>(meshlets.size());
+    uint32_t newVertices = countNew(triangle, id);
+
+    const uint32_t triangles = (static_cast<uint32_t>(t * 3) - start) / 3;
+    if (vertexCount + newVertices > maxVertices || triangles >= maxTriangles) {
+      finish(static_cast<uint32_t>(t * 3));
+      id = static_cast<uint32_t>(meshlets.size());
+      newVertices = countNew(triangle, id);
+    }
+
+    for (int c = 0; c < 3; c++) {
+      owner[triangle[c]] = id;
+    }
+    vertexCount += newVertices;
+  }
+  finish(static_cast<uint32_t>(triangleCount * 3));
+  return meshlets;
+}
+
+/**
+ * @brief Runs build() on every LOD range (or every material range of it)
+ * and records where each range's meshlets start.
+ *
+ * @details Meshlets never straddle two material ranges, so each range can
+ * be culled into its own draw list. A LOD's material ranges are adjacent
+ * in the index buffer, which keeps the LOD's meshlets contiguous too.
+ */
+MeshletSet buildForLods(std::span<const uint32_t> indices,
+                        std::span<const Vertex> vertices,
+                        std::span<const MeshLod> lods,
+                        std::span<const MeshSubmesh> submeshes) {
+  MeshletSet set;
+  const MeshLod whole{0, static_cast<uint32_t>(indices.size()), 0.0f, 0};
+  const std::span<const MeshLod> levels =
+      lods.empty() ? std::span<const MeshLod>(&whole, 1) : lods;
+
+  auto append = [&](uint32_t indexOffset, uint32_t indexCount) {
+    std::vector<Meshlet> meshlets = build(
+        indices.subspan(indexOffset, indexCount), vertices, indexOffset);
+    const MeshletRange range{static_cast<uint32_t>(set.meshlets.size()),
+                             static_cast<uint32_t>(meshlets.size())};
+    set.meshlets.insert(set.meshlets.end(), meshlets.begin(), meshlets.end());
+    return range;
+  };
+
+  for (uint32_t level = 0; level < levels.size(); level++) {
+    if (submeshes.empty()) {
+      set.lodRanges.push_back(
+          append(levels[level].indexOffset, levels[level].indexCount));
+      continue;
+    }
+    MeshletRange lodRange{static_cast<uint32_t>(set.meshlets.size()), 0};
+    for (const MeshSubmesh &submesh : submeshes) {
+      if (submesh.lod == level) {
+        set.submeshRanges.push_back(
+            append(submesh.indexOffset, submesh.indexCount));
+        lodRange.count += set.submeshRanges.back().count;
+      }
+    }
+    set.lodRanges.push_back(lodRange);
+  }
+  return set;
+}
+
+/**
+ * @brief Extracts normalized frustum planes in model space.
+ *
+ * @details
+ * Planes come from the rows of proj * view * model (Gribb & Hartmann), so a
+ * model-space sphere can be tested directly without transforming it. The
+ * projection maps depth to 0..w (GLM_FORCE_DEPTH_ZERO_TO_ONE, as Vulkan
+ * expects), so the near plane is z >= 0 rather than OpenGL's z >= -w.
+ */
+CullParams makeCullParams(const glm::mat4 &model, const glm::mat4 &view,
+                          const glm::mat4 &proj, MeshletRange range) {
+  const glm::mat4 m = proj * view * model;
+  auto row = [&](int r) {
+    return glm::vec4(m[0][r], m[1][r], m[2][r], m[3][r]);
+  };
+
+  CullParams params;
+  params.frustum[0] = row(3) + row(0); // Left
+  params.frustum[1] = row(3) - row(0); // Right
+  params.frustum[2] = row(3) + row(1); // Bottom / top (Y is flipped)
+  params.frustum[3] = row(3) - row(1);
+  params.frustum[4] = row(2);          // Near (zero-to-one depth)
+  params.frustum[5] = row(3) - row(2); // Far
+  for (glm::vec4 &plane : params.frustum) {
+    const float length = glm::length(glm::vec3(plane));
+    if (length > 0.0f) {
+      plane = plane * (1.0f / length);
+    }
+  }
+
+  params.cameraPosition = glm::inverse(view * model) * glm::vec4(0, 0, 0, 1);
+  params.firstMeshlet = range.first;
+  params.meshletCount = range.count;
+  return params;
+}
+
+/** @brief Same test as shaders/cull.comp. */
+bool isVisible(const Meshlet &meshlet, const CullParams &params) {
+  const glm::vec3 center(meshlet.center[0], meshlet.center[1],
+                         meshlet.center[2]);
+  for (const glm::vec4 &plane : params.frustum) {
+    if (glm::dot(glm::vec3(plane), center) + plane.w < -meshlet.radius) {
+      return false;
+    }
+  }
+
+  const glm::vec3 axis(meshlet.coneAxis[0], meshlet.coneAxis[1],
+                       meshlet.coneAxis[2]);
+  const glm::vec3 toCenter = center - glm::vec3(params.cameraPosition);
+  return glm::dot(toCenter, axis) <
+         meshlet.coneCutoff * glm::length(toCenter) + meshlet.radius;
+}
+
+} // namespace meshlet
@@ -0,0 +1,264 @@
+/**
+ * @file MipGenerator.cpp
+ * @brief Gamma-correct 2x2 box filter and parallel mip chain construction.
+ *
+ * @see MipGenerator.hpp
+ */
+#include "../include/MipGenerator.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define MIPGEN_SSE2
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define MIPGEN_NEON
+#endif
+
+namespace mipgen {
+
+namespace {
+
+/** @brief Entries in the linear -> sRGB table (12-bit linear precision). */
+constexpr int kLinearSteps = 4096;
+
+/** @brief Destination rows per parallelFor iteration. */
+constexpr uint32_t kBandRows = 16;
+
+/**
+ * @brief Byte -> [0, 1] tables: sRGB decode for color, identity for alpha.
+ */
+struct DecodeTables {
+  std::array<float, 256> srgb;
+  std::array<float, 256> unorm;
+};
+
+const DecodeTables &decodeTables() {
+  static const DecodeTables tables = [] {
+    DecodeTables result{};
+    for (int i = 0; i < 256; i++) {
+      const float c = i / 255.0f;
+      result.srgb[i] = c <= 0.04045f ? c / 12.92f
+                                     : std::pow((c + 0.055f) / 1.055f, 2.4f);
+      result.unorm[i] = c;
+    }
+    return result;
+  }();
+  return tables;
+}
+
+/**
+ * @brief [0, kLinearSteps] -> byte tables: sRGB encode for color, identity
+ * for alpha.
+ */
+struct EncodeTables {
+  std::array<uint8_t, kLinearSteps + 1> srgb;
+  std::array<uint8_t, kLinearSteps + 1> unorm;
+};
+
+const EncodeTables &encodeTables() {
+  static const EncodeTables tables = [] {
+    EncodeTables result{};
+    for (int i = 0; i <= kLinearSteps; i++) {
+      const float l = static_cast<float>(i) / kLinearSteps;
+      const float c = l <= 0.0031308f
+                          ? l * 12.92f
+                          : 1.055f * std::pow(l, 1.0f / 2.4f) - 0.055f;
+      result.srgb[i] =
+          static_cast<uint8_t>(std::clamp(c, 0.0f, 1.0f) * 255.0f + 0.5f);
+      result.unorm[i] = static_cast<uint8_t>(l * 255.0f + 0.5f);
+    }
+    return result;
+  }();
+  return tables;
+}
+
+/**
+ * @brief Decodes 'count' texels of a source row to linear RGBA floats.
+ *
+ * Texels past the end of the row repeat the last one, which implements the
+ * edge clamp for a 1-texel-wide source.
+ */
+void decodeRow(const uint8_t *row, uint32_t rowWidth, uint32_t count,
+               float *out) {
+  const DecodeTables &tables = decodeTables();
+  for (uint32_t i = 0; i < count; i++) {
+    const uint8_t *texel = row + std::min(i, rowWidth - 1) * 4;
+    out[i * 4 + 0] = tables.srgb[texel[0]];
+    out[i * 4 + 1] = tables.srgb[texel[1]];
+    out[i * 4 + 2] = tables.srgb[texel[2]];
+    out[i * 4 + 3] = tables.unorm[texel[3]];
+  }
+}
+
+/**
+ * @brief Averages 2x2 footprints of two decoded rows and encodes the result.
+ *
+ * @param top Decoded source row 2y (2 * width texels).
+ * @param bottom Decoded source row 2y + 1 (2 * width texels).
+ * @param width Destination row width.
+ * @param out Destination RGBA8 row.
+ */
+void filterRow(const float *top, const float *bottom, uint32_t width,
+               uint8_t *out) {
+  const EncodeTables &tables = encodeTables();
+  alignas(16) int32_t index[4];
+  for (uint32_t x = 0; x < width; x++) {
+    const float *a = top + x * 8, *b = bottom + x * 8;
+#if defined(MIPGEN_SSE2)
+    const __m128 sum =
+        _mm_add_ps(_mm_add_ps(_mm_loadu_ps(a), _mm_loadu_ps(a + 4)),
+                   _mm_add_ps(_mm_loadu_ps(b), _mm_loadu_ps(b + 4)));
+    _mm_store_si128(
+        reinterpret_cast<__m128i *>(index),
+        _mm_cvtps_epi32(_mm_mul_ps(sum, _mm_set1_ps(0.25f * kLinearSteps))));
+#elif defined(MIPGEN_NEON)
+    const float32x4_t sum =
+        vaddq_f32(vaddq_f32(vld1q_f32(a), vld1q_f32(a + 4)),
+                  vaddq_f32(vld1q_f32(b), vld1q_f32(b + 4)));
+    vst1q_s32(index, vcvtnq_s32_f32(vmulq_n_f32(sum, 0.25f * kLinearSteps)));
+#else
+    for (int c = 0; c < 4; c++) {
+      index[c] = static_cast<int32_t>(std::nearbyint(
+          ((a[c] + a[c + 4]) + (b[c] + b[c + 4])) * (0.25f * kLinearSteps)));
+    }
+#endif
+    out[x * 4 + 0] = tables.srgb[index[0]];
+    out[x * 4 + 1] = tables.srgb[index[1]];
+    out[x * 4 + 2] = tables.srgb[index[2]];
+    out[x * 4 + 3] = tables.unorm[index[3]];
+  }
+}
+
+/**
+ * @brief Computes destination rows [firstRow, lastRow) of the next level.
+ *
+ * @param scratch Per-call buffer for two decoded source rows.
+ */
+void downsampleRows(const uint8_t *source, const LevelLayout &sourceLevel,
+                    uint8_t *destination, const LevelLayout &destinationLevel,
+                    uint32_t firstRow, uint32_t lastRow,
+                    std::vector<float> &scratch) {
+  const uint32_t texels = destinationLevel.width * 2;
+  scratch.resize(static_cast<size_t>(texels) * 8);
+  float *top = scratch.data(), *bottom = scratch.data() + texels * 4;
+
+  const size_t sourcePitch = static_cast<size_t>(sourceLevel.width) * 4;
+  const size_t destinationPitch =
+      static_cast<size_t>(destinationLevel.width) * 4;
+  for (uint32_t y = firstRow; y < lastRow; y++) {
+    const uint32_t y0 = std::min(2 * y, sourceLevel.height - 1);
+    const uint32_t y1 = std::min(2 * y + 1, sourceLevel.height - 1);
+    decodeRow(source + y0 * sourcePitch, sourceLevel.width, texels, top);
+    decodeRow(source + y1 * sourcePitch, sourceLevel.width, texels, bottom);
+    filterRow(top, bottom, destinationLevel.width,
+              destination + y * destinationPitch);
+  }
+}
+
+} // namespace
+
+uint32_t levelCount(uint32_t width, uint32_t height) {
+  return std::bit_width(std::max({width, height, 1u}));
+}
+
+std::vector<LevelLayout> layoutChain(uint32_t width, uint32_t height) {
+  std::vector<LevelLayout> levels(levelCount(width, height));
+  size_t offset = 0;
+  for (LevelLayout &level : levels) {
+    level.width = width;
+    level.height = height;
+    level.offset = offset;
+    level.size = static_cast<size_t>(width) * height * 4;
+    offset = (offset + level.size + kLevelAlignment - 1) / kLevelAlignment *
+             kLevelAlignment;
+    width = std::max(1u, width / 2);
+    height = std::max(1u, height / 2);
+  }
+  return levels;
+}
+
+/**
+ * @details
+ * Levels depend on each other, so they are produced in order; within a
+ * level, bands of kBandRows destination rows are independent and handed to
+ * the pool. Each level reads the previous one back from 'chain' (so it is
+ * filtered from 8-bit sRGB, like the GPU blit), keeping the working set to
+ * two decoded rows per thread instead of a float copy of the image.
+ */
+void generateChain(uint8_t *chain, std::span<const LevelLayout> levels,
+                   ThreadPool &pool) {
+  for (size_t i = 1; i < levels.size(); i++) {
+    const LevelLayout &source = levels[i - 1], &destination = levels[i];
+    const uint32_t bands = (destination.height + kBandRows - 1) / kBandRows;
+    pool.parallelFor(bands, [&](size_t band) {
+      thread_local std::vector<float> scratch;
+      const uint32_t firstRow = static_cast<uint32_t>(band) * kBandRows;
+      downsampleRows(chain + source.offset, source, chain + destination.offset,
+                     destination, firstRow,
+                     std::min(firstRow + kBandRows, destination.height),
+                     scratch);
+    });
+  }
+}
+
+std::vector<MipLevel> buildChain(std::span<const uint8_t> rgba, uint32_t width,
+                                 uint32_t height, ThreadPool &pool) {
+  const std::vector<LevelLayout> levels = layoutChain(width, height);
+  std::vector<uint8_t> packed(levels.back().offset + levels.back().size);
+  std::memcpy(packed.data(), rgba.data(), levels[0].size);
+  generateChain(packed.data(), levels, pool);
+
+  std::vector<MipLevel> chain;
+  chain.reserve(levels.size());
+  for (const LevelLayout &level : levels) {
+    chain.push_back({level.width, level.height,
+                     {packed.begin() + level.offset,
+                      packed.begin() + level.offset + level.size}});
+  }
+  return chain;
+}
+
+MipLevel downsample(const MipLevel &source) {
+  const DecodeTables &decode = decodeTables();
+  const EncodeTables &encode = encodeTables();
+
+  MipLevel level;
+  level.width = std::max(1u, source.width / 2);
+  level.height = std::max(1u, source.height / 2);
+  level.rgba.resize(static_cast<size_t>(level.width) * level.height * 4);
+
+  for (uint32_t y = 0; y < level.height; y++) {
+    const uint32_t y0 = std::min(2 * y, source.height - 1);
+    const uint32_t y1 = std::min(2 * y + 1, source.height - 1);
+    for (uint32_t x = 0; x < level.width; x++) {
+      const uint32_t x0 = std::min(2 * x, source.width - 1);
+      const uint32_t x1 = std::min(2 * x + 1, source.width - 1);
+      const uint8_t *texels[4] = {
+          &source.rgba[(static_cast<size_t>(y0) * source.width + x0) * 4],
+          &source.rgba[(static_cast<size_t>(y0) * source.width + x1) * 4],
+          &source.rgba[(static_cast<size_t>(y1) * source.width + x0) * 4],
+          &source.rgba[(static_cast<size_t>(y1) * source.width + x1) * 4]};
+
+      uint8_t *out =
+          &level.rgba[(static_cast<size_t>(y) * level.width + x) * 4];
+      for (int c = 0; c < 4; c++) {
+        const std::array<float, 256> &table =
+            c < 3 ? decode.srgb : decode.unorm;
+        const float linear = (table[texels[0][c]] + table[texels[1][c]]) +
+                             (table[texels[2][c]] + table[texels[3][c]]);
+        const auto index =
+            static_cast<int>(std::nearbyint(linear * (0.25f * kLinearSteps)));
+        out[c] = c < 3 ? encode.srgb[index] : encode.unorm[index];
+      }
+    }
+  }
+  return level;
+}
+
+} // namespace mipgen
@@ -0,0 +1,651 @@
+/**
+ * @file ObjParser.cpp
+ * @brief Chunked, multi-threaded OBJ parsing with prefix-sum stitching.
+ *
+ * @see ObjParser.hpp for the supported subset and output layout.
+ */
+#include "../include/ObjParser.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+
+namespace objparser {
+
+namespace {
+
+/** @brief Chunks smaller than this are not worth a task of their own. */
+constexpr size_t kMinChunkBytes = 256 * 1024;
+
+/** @brief Chunks per worker; >1 lets the pool load-balance uneven chunks. */
+constexpr size_t kChunksPerThread = 4;
+
+/** @brief Chunk-local marker for an absent 'vt'/'vn' reference. */
+constexpr int32_t kMissing = std::numeric_limits<int32_t>::min();
+
+inline bool isSpace(char c) { return c == ' ' || c == '\t'; }
+inline bool isDigit(char c) { return c >= '0' && c <= '9'; }
+inline bool isTokenEnd(char c) { return c == ' ' || c == '\t' || c == '\r'; }
+
+/**
+ * @struct Chunk
+ * @brief Parse output of one line-aligned slice of the file.
+ *
+ * Positive OBJ indices are stored as absolute 0-based indices. Negative
+ * (relative) indices can only be resolved once the number of elements in
+ * preceding chunks is known, so they are stored relative to the chunk start
+ * and their slots are recorded in 'relativeSlots' for the stitch pass.
+ */
+struct Chunk {
+  const char *begin = nullptr;
+  const char *end = nullptr;
+
+  std::vector<float> positions;
+  std::vector<float> texcoords;
+  std::vector<float> normals;
+
+  std::vector<int32_t> cornerPositions; ///< Polygon corners, untriangulated
+  std::vector<int32_t> cornerTexcoords;
+  std::vector<int32_t> cornerNormals;
+  std::vector<uint32_t> faceSizes;      ///< Corner count per polygon
+  std::vector<size_t> relativeSlots;    ///< corner * 3 + attribute
+
+  std::vector<std::string> libraries;     ///< 'mtllib' file names
+  std::vector<std::string> materialNames; ///< 'usemtl' names, in order
+  std::vector<size_t> materialFaces;      ///< Polygon each 'usemtl' precedes
+  std::vector<int32_t> materialIds;       ///< Global id of each 'usemtl'
+  int32_t incomingMaterial = -1;          ///< Material active at the start
+
+  size_t triangleCount = 0;
+
+  // Exclusive prefix sums over preceding chunks (filled before stitching)
+  size_t positionBase = 0;
+  size_t texcoordBase = 0;
+  size_t normalBase = 0;
+  size_t triangleBase = 0;
+};
+
+/**
+ * @brief TinyOBJLoader-compatible floating point parser.
+ *
+ * @param s Start of the token.
+ * @param end One past the last character of the token.
+ * @param result Receives the parsed value on success.
+ * @return true if a number was parsed.
+ *
+ * @details
+ * This deliberately mirrors tinyobj's tryParseDouble() (mantissa accumulated
+ * in double, exponent applied via pow(5)/ldexp) instead of using a correctly
+ * rounded parser, so positions and texture coordinates are bit-identical to
+ * the tinyobj path and existing mesh caches/dedup results do not change.
+ */
+bool parseDouble(const char *s, const char *end, double *result) {
+  if (s >= end) {
+    return false;
+  }
+
+  double mantissa = 0.0;
+  int exponent = 0;
+  char sign = '+';
+  char expSign = '+';
+  const char *curr = s;
+  int read = 0;
+  bool leadingDot = false;
+
+  if (*curr == '+' || *curr == '-') {
+    sign = *curr;
+    curr++;
+    if (curr != end && *curr == '.') {
+      leadingDot = true;
+    }
+  } else if (*curr == '.') {
+    leadingDot = true;
+  } else if (!isDigit(*curr)) {
+    return false;
+  }
+
+  // Integer part
+  if (!leadingDot) {
+    while (curr != end && isDigit(*curr)) {
+      mantissa *= 10;
+      mantissa += static_cast<int>(*curr - '0');
+      curr++;
+      read++;
+    }
+    if (read == 0) {
+      return false;
+    }
+  }
+
+  // Fractional part
+  if (curr != end && *curr == '.') {
+    static const double powLut[] = {1.0,    0.1,     0.01,     0.001,
+                                    0.0001, 0.00001, 0.000001, 0.0000001};
+    constexpr int lutEntries = sizeof(powLut) / sizeof(powLut[0]);
+    curr++;
+    read = 1;
+    while (curr != end && isDigit(*curr)) {
+      mantissa += static_cast<int>(*curr - '0') *
+                  (read < lutEntries ? powLut[read] : std::pow(10.0, -read));
+      read++;
+      curr++;
+    }
+  }
+
+  // Exponent part
+  if (curr != end && (*curr == 'e' || *curr == 'E')) {
+    curr++;
+    if (curr != end && (*curr == '+' || *curr == '-')) {
+      expSign = *curr;
+      curr++;
+    } else if (curr == end || !isDigit(*curr)) {
+      return false;
+    }
+
+    read = 0;
+    while (curr != end && isDigit(*curr)) {
+      if (exponent > std::numeric_limits<int>::max() / 10) {
+        return false; // Exponent overflow
+      }
+      exponent *= 10;
+      exponent += static_cast<int>(*curr - '0');
+      curr++;
+      read++;
+    }
+    exponent *= (expSign == '+' ? 1 : -1);
+    if (read == 0) {
+      return false;
+    }
+  }
+
+  *result = (sign == '+' ? 1 : -1) *
+            (exponent ? std::ldexp(mantissa * std::pow(5.0, exponent), exponent)
+                      : mantissa);
+  return true;
+}
+
+/**
+ * @brief Parses the next whitespace-separated real on a line.
+ *
+ * Missing or malformed values yield 'fallback', matching tinyobj.
+ */
+float parseReal(const char *&p, const char *lineEnd, double fallback = 0.0) {
+  while (p < lineEnd && isSpace(*p)) {
+    p++;
+  }
+  const char *tokenEnd = p;
+  while (tokenEnd < lineEnd && !isTokenEnd(*tokenEnd)) {
+    tokenEnd++;
+  }
+
+  double value = fallback;
+  parseDouble(p, tokenEnd, &value);
+  p = tokenEnd;
+  return static_cast<float>(value);
+}
+
+/** @brief atoi() on a bounded range: optional sign followed by digits. */
+int parseInt(const char *&p, const char *lineEnd) {
+  bool negative = false;
+  if (p < lineEnd && (*p == '+' || *p == '-')) {
+    negative = *p == '-';
+    p++;
+  }
+  int value = 0;
+  while (p < lineEnd && isDigit(*p)) {
+    value = value * 10 + (*p - '0');
+    p++;
+  }
+  return negative ? -value : value;
+}
+
+/**
+ * @brief Moves 'p' to the start of the next whitespace-separated token.
+ *
+ * @return End of that token ('p' == return value once the line is done).
+ */
+const char *nextToken(const char *&p, const char *lineEnd) {
+  while (p < lineEnd && isSpace(*p)) {
+    p++;
+  }
+  const char *tokenEnd = p;
+  while (tokenEnd < lineEnd && !isTokenEnd(*tokenEnd)) {
+    tokenEnd++;
+  }
+  return tokenEnd;
+}
+
+/**
+ * @brief Rest of a line without surrounding whitespace (material names may
+ * contain spaces).
+ */
+std::string restOfLine(const char *p, const char *lineEnd) {
+  while (p < lineEnd && isSpace(*p)) {
+    p++;
+  }
+  while (lineEnd > p && isTokenEnd(lineEnd[-1])) {
+    lineEnd--;
+  }
+  return std::string(p, lineEnd);
+}
+
+/** @brief True if the line starts with 'keyword' followed by whitespace. */
+bool startsWith(const char *p, size_t length, const char *keyword) {
+  const size_t keywordLength = std::strlen(keyword);
+  return length > keywordLength &&
+         std::memcmp(p, keyword, keywordLength) == 0 &&
+         isSpace(p[keywordLength]);
+}
+
+/**
+ * @brief Converts a raw OBJ index to the chunk-local encoding.
+ *
+ * @param raw 1-based (positive) or relative (negative) OBJ index.
+ * @param localCount Elements of this kind parsed so far in the chunk.
+ * @param chunk Chunk receiving the relative slot, if any.
+ * @param slot Slot id (corner * 3 + attribute) for relative fix-ups.
+ * @return Encoded index.
+ * @throws std::runtime_error If 'raw' is zero (invalid in OBJ).
+ */
+int32_t encodeIndex(int raw, size_t localCount, Chunk &chunk, size_t slot) {
+  if (raw > 0) {
+    return raw - 1;
+  }
+  if (raw == 0) {
+    throw std::runtime_error("Invalid zero index in OBJ 'f' record");
+  }
+  chunk.relativeSlots.push_back(slot);
+  return static_cast<int32_t>(static_cast<int64_t>(localCount) + raw);
+}
+
+/**
+ * @brief Parses one 'f' record ("v", "v/vt", "v//vn" or "v/vt/vn" corners).
+ */
+void parseFace(const char *p, const char *lineEnd, Chunk &chunk) {
+  const size_t positionCount = chunk.positions.size() / 3;
+  const size_t texcoordCount = chunk.texcoords.size() / 2;
+  const size_t normalCount = chunk.normals.size() / 3;
+
+  uint32_t corners = 0;
+  while (p < lineEnd && isSpace(*p)) {
+    p++;
+  }
+  while (p < lineEnd && *p != '\r') {
+    const size_t corner = chunk.cornerPositions.size();
+    int32_t texcoord = kMissing;
+    int32_t normal = kMissing;
+
+    int32_t position =
+        encodeIndex(parseInt(p, lineEnd), positionCount, chunk, corner * 3 + 0);
+    while (p < lineEnd && *p != '/' && !isTokenEnd(*p)) {
+      p++;
+    }
+    if (p < lineEnd && *p == '/') {
+      p++;
+      if (p < lineEnd && *p != '/') { // v/vt or v/vt/vn
+        texcoord = encodeIndex(parseInt(p, lineEnd), texcoordCount, chunk,
+                               corner * 3 + 1);
+        while (p < lineEnd && *p != '/' && !isTokenEnd(*p)) {
+          p++;
+        }
+      }
+      if (p < lineEnd && *p == '/') { // v//vn or v/vt/vn
+        p++;
+        normal = encodeIndex(parseInt(p, lineEnd), normalCount, chunk,
+                             corner * 3 + 2);
+        while (p < lineEnd && *p != '/' && !isTokenEnd(*p)) {
+          p++;
+        }
+      }
+    }
+
+    chunk.cornerPositions.push_back(position);
+    chunk.cornerTexcoords.push_back(texcoord);
+    chunk.cornerNormals.push_back(normal);
+    corners++;
+
+    while (p < lineEnd && isTokenEnd(*p)) {
+      p++;
+    }
+  }
+
+  chunk.faceSizes.push_back(corners);
+  if (corners >= 3) {
+    chunk.triangleCount += corners - 2;
+  }
+}
+
+/**
+ * @brief Parses every line of a chunk into its per-chunk arrays.
+ */
+void parseChunk(Chunk &chunk) {
+  const char *p = chunk.begin;
+  while (p < chunk.end) {
+    const char *lineEnd = static_cast<const char *>(
+        std::memchr(p, '\n', static_cast<size_t>(chunk.end - p)));
+    if (!lineEnd) {
+      lineEnd = chunk.end;
+    }
+
+    while (p < lineEnd && isSpace(*p)) {
+      p++;
+    }
+    const size_t length = static_cast<size_t>(lineEnd - p);
+
+    if (length >= 2 && p[0] == 'v' && isSpace(p[1])) {
+      p += 2;
+      float x = parseReal(p, lineEnd);
+      float y = parseReal(p, lineEnd);
+      float z = parseReal(p, lineEnd);
+      chunk.positions.insert(chunk.positions.end(), {x, y, z});
+    } else if (length >= 3 && p[0] == 'v' && p[1] == 't' && isSpace(p[2])) {
+      p += 3;
+      float u = parseReal(p, lineEnd);
+      float v = parseReal(p, lineEnd);
+      chunk.texcoords.insert(chunk.texcoords.end(), {u, v});
+    } else if (length >= 3 && p[0] == 'v' && p[1] == 'n' && isSpace(p[2])) {
+      p += 3;
+      float x = parseReal(p, lineEnd);
+      float y = parseReal(p, lineEnd);
+      float z = parseReal(p, lineEnd);
+      chunk.normals.insert(chunk.normals.end(), {x, y, z});
+    } else if (length >= 2 && p[0] == 'f' && isSpace(p[1])) {
+      parseFace(p + 2, lineEnd, chunk);
+    } else if (startsWith(p, length, "usemtl")) {
+      chunk.materialNames.push_back(restOfLine(p + 6, lineEnd));
+      chunk.materialFaces.push_back(chunk.faceSizes.size());
+    } else if (startsWith(p, length, "mtllib")) {
+      p += 6;
+      for (const char *end = nextToken(p, lineEnd); p != end;
+           end = nextToken(p, lineEnd)) {
+        chunk.libraries.emplace_back(p, end);
+        p = end;
+      }
+    }
+
+    p = lineEnd + 1;
+  }
+}
+
+/**
+ * @brief Splits the text into roughly equal, line-aligned chunks.
+ *
+ * @param text Start of the file contents.
+ * @param size Size of the file contents in bytes.
+ * @param chunkCount Desired number of chunks.
+ * @return Chunks covering the text exactly once, each ending after a '\n'
+ * (except possibly the last).
+ */
+std::vector<Chunk> splitChunks(const char *text, size_t size,
+                               size_t chunkCount) {
+  std::vector<Chunk> chunks;
+  chunks.reserve(chunkCount);
+
+  const char *end = text + size;
+  const char *begin = text;
+  for (size_t i = 1; i <= chunkCount && begin < end; i++) {
+    const char *split = i == chunkCount ? end : text + size * i / chunkCount;
+    if (split < begin) {
+      split = begin;
+    }
+    if (split < end) {
+      const char *newline = static_cast<const char *>(
+          std::memchr(split, '\n', static_cast<size_t>(end - split)));
+      split = newline ? newline + 1 : end;
+    }
+
+    Chunk chunk;
+    chunk.begin = begin;
+    chunk.end = split;
+    chunks.push_back(std::move(chunk));
+    begin = split;
+  }
+  return chunks;
+}
+
+/**
+ * @brief Resolves a chunk-encoded index to an absolute one and range checks it.
+ *
+ * @return Absolute 0-based index, or -1 for an absent optional attribute.
+ * @throws std::runtime_error If the index is outside the attribute array.
+ */
+int32_t resolveIndex(int32_t encoded, size_t count, const char *kind) {
+  if (encoded == kMissing) {
+    return -1;
+  }
+  if (encoded < 0 || static_cast<size_t>(encoded) >= count) {
+    throw std::runtime_error(std::string("OBJ face references missing ") +
+                             kind + " " + std::to_string(encoded + 1));
+  }
+  return encoded;
+}
+
+} // namespace
+
+/**
+ * @brief Parses OBJ text using all workers of 'pool'.
+ *
+ * @param text File contents.
+ * @param pool Worker pool.
+ * @return Attribute arrays and triangulated corner indices.
+ *
+ * @details
+ * Three phases:
+ * 1. **Parse** (parallel): each line-aligned chunk is parsed into its own
+ *    SoA arrays with no shared state.
+ * 2. **Prefix sums** (serial, O(chunks)): per-chunk element and triangle
+ *    counts become output offsets; relative indices get their base.
+ * 3. **Stitch** (parallel): attribute arrays are copied to their offsets,
+ *    then indices are resolved and faces triangulated in place. The quad
+ *    split needs positions from any chunk, hence the separate copy pass.
+ *
+ * @throws std::runtime_error On invalid face indices.
+ */
+ObjData parse(std::span<const std::byte> text, ThreadPool &pool) {
+  const char *data = reinterpret_cast<const char *>(text.data());
+  const size_t size = text.size();
+
+  size_t chunkCount = std::max<size_t>(1, pool.size() * kChunksPerThread);
+  chunkCount = std::min(chunkCount, std::max<size_t>(1, size / kMinChunkBytes));
+  std::vector<Chunk> chunks = splitChunks(data, size, chunkCount);
+
+  // 1. Parse chunks independently
+  pool.parallelFor(chunks.size(), [&](size_t i) { parseChunk(chunks[i]); });
+
+  // 2. Exclusive prefix sums give each chunk its output offsets
+  size_t positionCount = 0, texcoordCount = 0, normalCount = 0,
+         triangleCount = 0;
+  for (Chunk &chunk : chunks) {
+    chunk.positionBase = positionCount;
+    chunk.texcoordBase = texcoordCount;
+    chunk.normalBase = normalCount;
+    chunk.triangleBase = triangleCount;
+    positionCount += chunk.positions.size() / 3;
+    texcoordCount += chunk.texcoords.size() / 2;
+    normalCount += chunk.normals.size() / 3;
+    triangleCount += chunk.triangleCount;
+  }
+  if (positionCount > static_cast<size_t>(std::numeric_limits<int32_t>::max())) {
+    throw std::runtime_error("OBJ has too many vertices for 32-bit indices");
+  }
+
+  // Material names get global ids in first-use order; faces at the start of
+  // a chunk inherit the material left active by the chunks before it
+  ObjData result;
+  std::unordered_map<std::string, int32_t> materialIds;
+  int32_t activeMaterial = -1;
+  for (Chunk &chunk : chunks) {
+    chunk.incomingMaterial = activeMaterial;
+    for (std::string &name : chunk.materialNames) {
+      auto [it, inserted] = materialIds.try_emplace(
+          name, static_cast<int32_t>(result.materialNames.size()));
+      if (inserted) {
+        result.materialNames.push_back(std::move(name));
+      }
+      chunk.materialIds.push_back(it->second);
+      activeMaterial = it->second;
+    }
+    result.materialLibraries.insert(result.materialLibraries.end(),
+                                    chunk.libraries.begin(),
+                                    chunk.libraries.end());
+  }
+  result.positions.resize(positionCount * 3);
+  result.texcoords.resize(texcoordCount * 2);
+  result.normals.resize(normalCount * 3);
+  result.positionIndices.resize(triangleCount * 3);
+  result.texcoordIndices.resize(triangleCount * 3);
+  result.normalIndices.resize(triangleCount * 3);
+  if (!result.materialNames.empty()) {
+    result.triangleMaterials.resize(triangleCount);
+  }
+
+  // 3a. Copy attribute arrays into place
+  pool.parallelFor(chunks.size(), [&](size_t i) {
+    Chunk &chunk = chunks[i];
+    std::copy(chunk.positions.begin(), chunk.positions.end(),
+              result.positions.begin() + chunk.positionBase * 3);
+    std::copy(chunk.texcoords.begin(), chunk.texcoords.end(),
+              result.texcoords.begin() + chunk.texcoordBase * 2);
+    std::copy(chunk.normals.begin(), chunk.normals.end(),
+              result.normals.begin() + chunk.normalBase * 3);
+    chunk.positions = {};
+    chunk.texcoords = {};
+    chunk.normals = {};
+  });
+
+  // 3b. Resolve indices and triangulate
+  pool.parallelFor(chunks.size(), [&](size_t i) {
+    Chunk &chunk = chunks[i];
+
+    // Relative indices become absolute once the chunk's base is known
+    for (size_t slot : chunk.relativeSlots) {
+      const size_t corner = slot / 3;
+      switch (slot % 3) {
+      case 0:
+        chunk.cornerPositions[corner] += static_cast<int32_t>(chunk.positionBase);
+        break;
+      case 1:
+        chunk.cornerTexcoords[corner] += static_cast<int32_t>(chunk.texcoordBase);
+        break;
+      default:
+        chunk.cornerNormals[corner] += static_cast<int32_t>(chunk.normalBase);
+        break;
+      }
+    }
+
+    for (size_t c = 0; c < chunk.cornerPositions.size(); c++) {
+      chunk.cornerPositions[c] =
+          resolveIndex(chunk.cornerPositions[c], positionCount, "vertex");
+      chunk.cornerTexcoords[c] =
+          resolveIndex(chunk.cornerTexcoords[c], texcoordCount, "texcoord");
+      chunk.cornerNormals[c] =
+          resolveIndex(chunk.cornerNormals[c], normalCount, "normal");
+    }
+
+    size_t out = chunk.triangleBase * 3;
+    size_t first = 0;
+    auto emit = [&](size_t corner) {
+      result.positionIndices[out] = chunk.cornerPositions[first + corner];
+      result.texcoordIndices[out] = chunk.cornerTexcoords[first + corner];
+      result.normalIndices[out] = chunk.cornerNormals[first + corner];
+      out++;
+    };
+
+    int32_t material = chunk.incomingMaterial;
+    size_t nextSwitch = 0;
+    for (size_t face = 0; face < chunk.faceSizes.size(); face++) {
+      const uint32_t corners = chunk.faceSizes[face];
+      while (nextSwitch < chunk.materialFaces.size() &&
+             chunk.materialFaces[nextSwitch] == face) {
+        material = chunk.materialIds[nextSwitch++];
+      }
+      const size_t firstTriangle = out / 3;
+
+      if (corners == 3) {
+        emit(0), emit(1), emit(2);
+      } else if (corners == 4) {
+        // Split along the shorter diagonal (same rule as tinyobj)
+        auto position = [&](size_t corner) {
+          return &result.positions[3 * static_cast<size_t>(
+                                           chunk.cornerPositions[first + corner])];
+        };
+        const float *v0 = position(0), *v1 = position(1), *v2 = position(2),
+                    *v3 = position(3);
+        float e02x = v2[0] - v0[0], e02y = v2[1] - v0[1], e02z = v2[2] - v0[2];
+        float e13x = v3[0] - v1[0], e13y = v3[1] - v1[1], e13z = v3[2] - v1[2];
+        float sqr02 = e02x * e02x + e02y * e02y + e02z * e02z;
+        float sqr13 = e13x * e13x + e13y * e13y + e13z * e13z;
+        if (sqr02 < sqr13) {
+          emit(0), emit(1), emit(2);
+          emit(0), emit(2), emit(3);
+        } else {
+          emit(0), emit(1), emit(3);
+          emit(1), emit(2), emit(3);
+        }
+      } else if (corners > 4) {
+        for (uint32_t k = 1; k + 1 < corners; k++) { // Fan
+          emit(0), emit(k), emit(k + 1);
+        }
+      }
+      if (!result.triangleMaterials.empty()) {
+        std::fill(result.triangleMaterials.begin() + firstTriangle,
+                  result.triangleMaterials.begin() + out / 3, material);
+      }
+      first += corners;
+    }
+  });
+
+  return result;
+}
+
+/**
+ * @details Recognizes 'newmtl', 'Kd' and 'map_Kd'; everything else
+ * (specular terms, other maps, ...) is skipped. For map_Kd the last token is
+ * the file name, which drops options such as '-s 1 1 1' in front of it.
+ */
+std::vector<MtlMaterial> parseMtl(std::span<const std::byte> text) {
+  std::vector<MtlMaterial> materials;
+  const char *p = reinterpret_cast<const char *>(text.data());
+  const char *end = p + text.size();
+  while (p < end) {
+    const char *lineEnd = static_cast<const char *>(
+        std::memchr(p, '\n', static_cast<size_t>(end - p)));
+    if (!lineEnd) {
+      lineEnd = end;
+    }
+
+    while (p < lineEnd && isSpace(*p)) {
+      p++;
+    }
+    const size_t length = static_cast<size_t>(lineEnd - p);
+
+    if (startsWith(p, length, "newmtl")) {
+      materials.emplace_back();
+      materials.back().name = restOfLine(p + 6, lineEnd);
+    } else if (!materials.empty() && startsWith(p, length, "Kd")) {
+      p += 2;
+      for (float &channel : materials.back().diffuse) {
+        channel = parseReal(p, lineEnd);
+      }
+    } else if (!materials.empty() && startsWith(p, length, "map_Kd")) {
+      p += 6;
+      const char *last = p, *lastEnd = p;
+      for (const char *tokenEnd = nextToken(p, lineEnd); p != tokenEnd;
+           tokenEnd = nextToken(p, lineEnd)) {
+        last = p;
+        lastEnd = tokenEnd;
+        p = tokenEnd;
+      }
+      materials.back().diffuseTexture.assign(last, lastEnd);
+    }
+
+    p = lineEnd + 1;
+  }
+  return materials;
+}
+
+} // namespace objparser
@@ -0,0 +1,34 @@
+/**
+ * @file RetireQueue.cpp
+ * @brief Frame-ordered release of retired objects.
+ *
+ * @see RetireQueue.hpp
+ */
+#include "../include/RetireQueue.hpp"
+
+void RetireQueue::release(Entry &entry) {
+  for (std::shared_ptr<void> &object : entry.objects) {
+    object.reset();
+  }
+}
+
+/**
+ * @details Entries are retired in frame order, so the scan stops at the
+ * first one that is still in use.
+ */
+size_t RetireQueue::collect(uint64_t completedFrame) {
+  size_t released = 0;
+  while (!entries.empty() && entries.front().lastUse <= completedFrame) {
+    release(entries.front());
+    entries.pop_front();
+    released++;
+  }
+  return released;
+}
+
+void RetireQueue::clear() {
+  for (Entry &entry : entries) {
+    release(entry);
+  }
+  entries.clear();
+}
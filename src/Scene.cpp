@@ -0,0 +1,389 @@
+/**
+ * @file Scene.cpp
+ * @brief Scene file I/O, the synthetic scene generator and per-frame
+ *        instance culling / LOD batching.
+ *
+ * @see Scene.hpp for the file format.
+ */
+#include "../include/Scene.hpp"
+#include "../include/MeshSimplifier.hpp"
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <fstream>
+#include <initializer_list>
+#include <limits>
+#include <nlohmann/json.hpp>
+#include <random>
+#include <stdexcept>
+
+namespace scene {
+
+namespace {
+
+using json = nlohmann::json;
+
+/** @brief LOD marker of instances that are not drawn. */
+constexpr uint32_t kSkipped = std::numeric_limits<uint32_t>::max();
+
+/** @brief Quaternion from glTF-ordered components. */
+glm::quat makeQuat(float x, float y, float z, float w) {
+  glm::quat q;
+  q.x = x;
+  q.y = y;
+  q.z = z;
+  q.w = w;
+  return q;
+}
+
+/** @brief Reads a [x, y, z] array. */
+glm::vec3 readVec3(const json &value) {
+  if (!value.is_array() || value.size() != 3) {
+    throw std::runtime_error("expected [x, y, z], got " + value.dump());
+  }
+  return {value[0].get<float>(), value[1].get<float>(),
+          value[2].get<float>()};
+}
+
+/** @brief Appends the shortest text that reads back as 'value'. */
+void appendFloat(std::string &text, float value) {
+  char buffer[32];
+  const auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+  text.append(buffer, result.ptr);
+}
+
+/** @brief Appends a JSON array of floats. */
+void appendArray(std::string &text, std::initializer_list<float> values) {
+  text += '[';
+  for (const float *value = values.begin(); value != values.end(); value++) {
+    if (value != values.begin()) {
+      text += ", ";
+    }
+    appendFloat(text, *value);
+  }
+  text += ']';
+}
+
+/**
+ * @brief Frustum planes (xyz = inward normal, w = distance) of a Vulkan
+ * view-projection matrix (clip depth 0..1), normalized.
+ */
+std::array<glm::vec4, 6> frustumPlanes(const glm::mat4 &viewProj) {
+  const glm::vec4 row0(viewProj[0][0], viewProj[1][0], viewProj[2][0],
+                       viewProj[3][0]);
+  const glm::vec4 row1(viewProj[0][1], viewProj[1][1], viewProj[2][1],
+                       viewProj[3][1]);
+  const glm::vec4 row2(viewProj[0][2], viewProj[1][2], viewProj[2][2],
+                       viewProj[3][2]);
+  const glm::vec4 row3(viewProj[0][3], viewProj[1][3], viewProj[2][3],
+                       viewProj[3][3]);
+  std::array<glm::vec4, 6> planes = {row3 + row0, row3 - row0, row3 + row1,
+                                     row3 - row1, row2,        row3 - row2};
+  for (glm::vec4 &plane : planes) {
+    plane /= glm::length(glm::vec3(plane));
+  }
+  return planes;
+}
+
+/** @brief Largest axis scale of a model matrix. */
+float maxScale(const glm::mat4 &model) {
+  return std::max({glm::length(glm::vec3(model[0])),
+                   glm::length(glm::vec3(model[1])),
+                   glm::length(glm::vec3(model[2]))});
+}
+
+} // namespace
+
+void InstanceStore::reserve(size_t count) {
+  positions.reserve(count);
+  rotations.reserve(count);
+  scales.reserve(count);
+  meshIds.reserve(count);
+}
+
+void InstanceStore::add(glm::vec3 position, glm::quat rotation,
+                        glm::vec3 scale, uint32_t meshId) {
+  positions.push_back(position);
+  rotations.push_back(rotation);
+  scales.push_back(scale);
+  meshIds.push_back(meshId);
+}
+
+void InstanceStore::clear() {
+  positions.clear();
+  rotations.clear();
+  scales.clear();
+  meshIds.clear();
+}
+
+/**
+ * @details Any parse or type error is reported with the file name and, for
+ * instances, the instance index. Rotations are renormalized so hand-written
+ * files with rounded quaternions do not shear.
+ */
+Scene load(const std::string &path) {
+  std::ifstream file(path);
+  if (!file) {
+    throw std::runtime_error("failed to open scene " + path);
+  }
+
+  Scene result;
+  std::string where; // Instance being parsed, for the error message
+  try {
+    const json root = json::parse(file);
+
+    for (const json &mesh : root.at("meshes")) {
+      result.meshes.push_back(
+          {mesh.at("model").get<std::string>(), mesh.value("texture", "")});
+    }
+
+    const json &instances = root.at("instances");
+    result.instances.reserve(instances.size());
+    for (size_t index = 0; index < instances.size(); index++) {
+      const json &instance = instances[index];
+      where = " (instance " + std::to_string(index) + ")";
+      const uint32_t mesh = instance.value("mesh", 0u);
+      if (mesh >= result.meshes.size()) {
+        throw std::runtime_error("mesh " + std::to_string(mesh) +
+                                 " does not exist");
+      }
+
+      glm::quat rotation = makeQuat(0.0f, 0.0f, 0.0f, 1.0f);
+      if (instance.contains("rotation")) {
+        const json &q = instance["rotation"];
+        if (!q.is_array() || q.size() != 4) {
+          throw std::runtime_error("expected [x, y, z, w], got " + q.dump());
+        }
+        rotation = makeQuat(q[0].get<float>(), q[1].get<float>(),
+                            q[2].get<float>(), q[3].get<float>());
+        const float length = std::sqrt(rotation.x * rotation.x +
+                                       rotation.y * rotation.y +
+                                       rotation.z * rotation.z +
+                                       rotation.w * rotation.w);
+        if (!(length > 0.0f)) {
+          throw std::runtime_error("zero rotation quaternion");
+        }
+        rotation = makeQuat(rotation.x / length, rotation.y / length,
+                            rotation.z / length, rotation.w / length);
+      }
+
+      glm::vec3 scale(1.0f);
+      if (instance.contains("scale")) {
+        scale = instance["scale"].is_number()
+                    ? glm::vec3(instance["scale"].get<float>())
+                    : readVec3(instance["scale"]);
+      }
+
+      result.instances.add(readVec3(instance.at("position")), rotation, scale,
+                           mesh);
+    }
+  } catch (const std::exception &e) {
+    throw std::runtime_error("invalid scene " + path + where + ": " +
+                             e.what());
+  }
+  return result;
+}
+
+/**
+ * @details Instances are written one per line with the shortest float text
+ * that reads back exactly, which keeps a 100k-instance file around 10 MB
+ * and diffable.
+ */
+void save(const std::string &path, const Scene &scene) {
+  json meshes = json::array();
+  for (const MeshAsset &mesh : scene.meshes) {
+    meshes.push_back({{"model", mesh.model}, {"texture", mesh.texture}});
+  }
+
+  std::string text = "{\n  \"meshes\": " + meshes.dump() +
+                     ",\n  \"instances\": [\n";
+  const InstanceStore &instances = scene.instances;
+  for (size_t i = 0; i < instances.size(); i++) {
+    const glm::vec3 &p = instances.positions[i];
+    const glm::quat &q = instances.rotations[i];
+    const glm::vec3 &s = instances.scales[i];
+    text += "    {\"mesh\": " + std::to_string(instances.meshIds[i]) +
+            ", \"position\": ";
+    appendArray(text, {p.x, p.y, p.z});
+    text += ", \"rotation\": ";
+    appendArray(text, {q.x, q.y, q.z, q.w});
+    text += ", \"scale\": ";
+    if (s.x == s.y && s.x == s.z) {
+      appendFloat(text, s.x);
+    } else {
+      appendArray(text, {s.x, s.y, s.z});
+    }
+    text += i + 1 < instances.size() ? "},\n" : "}\n";
+  }
+  text += "  ]\n}\n";
+
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  if (!file.write(text.data(), static_cast<std::streamsize>(text.size()))) {
+    throw std::runtime_error("failed to write scene " + path);
+  }
+}
+
+Scene single(const MeshAsset &mesh) {
+  Scene result;
+  result.meshes.push_back(mesh);
+  result.instances.add(glm::vec3(0.0f), makeQuat(0.0f, 0.0f, 0.0f, 1.0f),
+                       glm::vec3(1.0f), 0);
+  return result;
+}
+
+Scene generate(std::vector<MeshAsset> meshes, size_t instanceCount,
+               float spacing, uint32_t seed) {
+  if (meshes.empty()) {
+    throw std::runtime_error("scene::generate() needs at least one mesh");
+  }
+  Scene result;
+  result.meshes = std::move(meshes);
+  result.instances.reserve(instanceCount);
+
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<float> jitter(-0.25f * spacing,
+                                               0.25f * spacing);
+  std::uniform_real_distribution<float> yaw(0.0f, 6.2831853f);
+  std::uniform_real_distribution<float> scale(0.75f, 1.25f);
+
+  const size_t side = static_cast<size_t>(
+      std::ceil(std::sqrt(static_cast<double>(instanceCount))));
+  const float origin = 0.5f * static_cast<float>(side - 1) * spacing;
+  for (size_t i = 0; i < instanceCount; i++) {
+    const glm::vec3 position(
+        static_cast<float>(i % side) * spacing - origin + jitter(rng),
+        static_cast<float>(i / side) * spacing - origin + jitter(rng), 0.0f);
+    const float angle = yaw(rng);
+    result.instances.add(
+        position,
+        makeQuat(0.0f, 0.0f, std::sin(0.5f * angle), std::cos(0.5f * angle)),
+        glm::vec3(scale(rng)),
+        static_cast<uint32_t>(i % result.meshes.size()));
+  }
+  return result;
+}
+
+/**
+ * @details Expands each quaternion into a rotation matrix directly (instead
+ * of composing glm::translate/mat4_cast/scale), reading only the three
+ * transform arrays.
+ */
+void computeMatrices(const InstanceStore &instances,
+                     std::span<glm::mat4> worlds) {
+  const size_t count = std::min(instances.size(), worlds.size());
+  for (size_t i = 0; i < count; i++) {
+    const glm::quat &q = instances.rotations[i];
+    const glm::vec3 &s = instances.scales[i];
+    const float xx = q.x * q.x, yy = q.y * q.y, zz = q.z * q.z;
+    const float xy = q.x * q.y, xz = q.x * q.z, yz = q.y * q.z;
+    const float wx = q.w * q.x, wy = q.w * q.y, wz = q.w * q.z;
+
+    glm::mat4 &m = worlds[i];
+    m[0] = glm::vec4(1.0f - 2.0f * (yy + zz), 2.0f * (xy + wz),
+                     2.0f * (xz - wy), 0.0f) *
+           s.x;
+    m[1] = glm::vec4(2.0f * (xy - wz), 1.0f - 2.0f * (xx + zz),
+                     2.0f * (yz + wx), 0.0f) *
+           s.y;
+    m[2] = glm::vec4(2.0f * (xz + wy), 2.0f * (yz - wx),
+                     1.0f - 2.0f * (xx + yy), 0.0f) *
+           s.z;
+    m[3] = glm::vec4(instances.positions[i], 1.0f);
+  }
+}
+
+float boundingRadius(const InstanceStore &instances, glm::vec3 boundsMin,
+                     glm::vec3 boundsMax) {
+  // Any rotation keeps the mesh within this distance of its instance origin
+  const float meshRadius = glm::length(0.5f * (boundsMin + boundsMax)) +
+                           0.5f * glm::length(boundsMax - boundsMin);
+  float radius = 0.0f;
+  for (size_t i = 0; i < instances.size(); i++) {
+    const glm::vec3 &s = instances.scales[i];
+    const float scale = std::max({std::abs(s.x), std::abs(s.y), std::abs(s.z)});
+    radius = std::max(radius, glm::length(instances.positions[i]) +
+                                  scale * meshRadius);
+  }
+  return radius;
+}
+
+/**
+ * @details
+ * Two passes over the instances, like a counting sort keyed by LOD:
+ * 1. Test each instance's bounding sphere against the six frustum planes
+ *    and pick the LOD of the visible ones (meshlod::pixelsPerUnit() and
+ *    lodForPixels(), the same rule as the single-model path), counting the
+ *    instances per LOD.
+ * 2. Turn the counts into offsets and scatter the model matrices, using
+ *    'lodFirst' as the write cursor and rewinding it afterwards.
+ *
+ * Only 'lodOf' grows with the scene, and it keeps its capacity across
+ * frames.
+ */
+void batchInstances(std::span<const glm::mat4> worlds,
+                    std::span<const uint32_t> meshIds,
+                    const BatchParams &params, std::span<glm::mat4> out,
+                    InstanceBatches &batches) {
+  const size_t lodCount = std::max<size_t>(1, params.lods.size());
+  batches.lodFirst.assign(lodCount, 0);
+  batches.lodCount.assign(lodCount, 0);
+  batches.visible = 0;
+  batches.culled = 0;
+  batches.maxPixelsPerUnit = 0.0f;
+  batches.lodOf.resize(worlds.size());
+
+  const std::array<glm::vec4, 6> planes =
+      frustumPlanes(params.proj * params.view);
+  const glm::vec3 center = 0.5f * (params.boundsMin + params.boundsMax);
+  const float radius = 0.5f * glm::length(params.boundsMax - params.boundsMin);
+
+  for (size_t i = 0; i < worlds.size(); i++) {
+    batches.lodOf[i] = kSkipped;
+    if (meshIds[i] != params.meshId) {
+      continue;
+    }
+    const glm::mat4 model = worlds[i] * params.local;
+    const glm::vec3 worldCenter(model * glm::vec4(center, 1.0f));
+    const float worldRadius = radius * maxScale(model);
+    const bool outside =
+        std::any_of(planes.begin(), planes.end(), [&](const glm::vec4 &p) {
+          return glm::dot(glm::vec3(p), worldCenter) + p.w < -worldRadius;
+        });
+    if (outside) {
+      batches.culled++;
+      continue;
+    }
+
+    const float pixels =
+        meshlod::pixelsPerUnit(model, params.view, params.proj,
+                               params.boundsMin, params.boundsMax,
+                               params.viewportHeight);
+    const uint32_t lod =
+        meshlod::lodForPixels(params.lods, pixels, params.maxPixelError);
+    batches.maxPixelsPerUnit = std::max(batches.maxPixelsPerUnit, pixels);
+    batches.lodOf[i] = lod;
+    batches.lodCount[lod]++;
+    batches.visible++;
+  }
+
+  if (batches.visible > out.size()) {
+    throw std::runtime_error("scene::batchInstances() output too small");
+  }
+  uint32_t first = 0;
+  for (size_t lod = 0; lod < lodCount; lod++) {
+    batches.lodFirst[lod] = first;
+    first += batches.lodCount[lod];
+  }
+  for (size_t i = 0; i < worlds.size(); i++) {
+    if (batches.lodOf[i] != kSkipped) {
+      out[batches.lodFirst[batches.lodOf[i]]++] = worlds[i] * params.local;
+    }
+  }
+  for (size_t lod = 0; lod < lodCount; lod++) {
+    batches.lodFirst[lod] -= batches.lodCount[lod];
+  }
+}
+
+} // namespace scene
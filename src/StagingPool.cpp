@@ -0,0 +1,148 @@
+/**
+ * @file StagingPool.cpp
+ * @brief Recycled staging buffer chunks.
+ *
+ * @see StagingPool.hpp
+ */
+#include "../include/StagingPool.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+/**
+ * @struct StagingPool::Chunk
+ * @brief One persistently mapped transfer-source buffer.
+ */
+struct StagingPool::Chunk {
+  vk::raii::Buffer buffer = nullptr; ///< Transfer-source buffer
+  GpuAllocation memory = nullptr;    ///< Its host-visible memory
+  vk::DeviceSize size = 0;           ///< Buffer size
+  vk::DeviceSize top = 0;            ///< Next free offset
+  size_t live = 0;                   ///< Ranges not yet released
+
+  /** @brief True when no range is in use, so the chunk is rewound. */
+  bool released() const { return live == 0; }
+};
+
+StagingPool::StagingPool(const vk::raii::Device &logicalDevice,
+                         GpuAllocator &gpuAllocator, vk::DeviceSize chunkBytes)
+    : device(logicalDevice), allocator(gpuAllocator),
+      chunkSize(std::max<vk::DeviceSize>(chunkBytes, kAlignment)) {}
+
+StagingPool::~StagingPool() = default;
+
+StagingPool::Chunk &StagingPool::createChunk(vk::DeviceSize size) {
+  vk::BufferCreateInfo bufferInfo{};
+  bufferInfo.size = size;
+  bufferInfo.usage = vk::BufferUsageFlagBits::eTransferSrc;
+  bufferInfo.sharingMode = vk::SharingMode::eExclusive;
+
+  auto chunk = std::make_unique<Chunk>();
+  chunk->buffer = vk::raii::Buffer(device, bufferInfo);
+  chunk->memory = allocator.allocate(
+      chunk->buffer,
+      vk::MemoryPropertyFlagBits::eHostVisible |
+          vk::MemoryPropertyFlagBits::eHostCoherent,
+      GpuAllocator::Category::eStaging);
+  chunk->size = size;
+  chunksCreated++;
+  chunks.push_back(std::move(chunk));
+  return *chunks.back();
+}
+
+/**
+ * @details First fit over the chunks in creation order, so uploads keep
+ * filling the oldest chunks and newer ones go idle and are trimmed. A new
+ * chunk is created when none has room.
+ */
+StagingPool::Range StagingPool::allocate(vk::DeviceSize size,
+                                         vk::DeviceSize alignment) {
+  alignment = std::max<vk::DeviceSize>(alignment, 1);
+  if ((alignment & (alignment - 1)) != 0) {
+    throw std::runtime_error("Staging alignment must be a power of two");
+  }
+  size = std::max<vk::DeviceSize>(size, 1);
+
+  std::lock_guard<std::mutex> lock(mutex);
+  auto alignUp = [&](vk::DeviceSize offset) {
+    return (offset + alignment - 1) & ~(alignment - 1);
+  };
+  auto fits = [&](const Chunk &chunk) {
+    const vk::DeviceSize offset = alignUp(chunk.top);
+    return offset <= chunk.size && size <= chunk.size - offset;
+  };
+  auto find = [&]() -> Chunk * {
+    for (const std::unique_ptr<Chunk> &chunk : chunks) {
+      if (fits(*chunk)) {
+        return chunk.get();
+      }
+    }
+    return nullptr;
+  };
+
+  Chunk *chunk = find();
+  if (chunk == nullptr) {
+    chunk = &createChunk(std::max(chunkSize, size));
+  }
+
+  const vk::DeviceSize offset = alignUp(chunk->top);
+  chunk->top = offset + size;
+  chunk->live++;
+  rangesAllocated++;
+  return Range{*chunk->buffer, offset, size,
+               static_cast<std::byte *>(chunk->memory.mapped()) + offset,
+               chunk};
+}
+
+StagingPool::Range StagingPool::upload(std::span<const std::byte> bytes,
+                                       vk::DeviceSize alignment) {
+  Range range = allocate(bytes.size(), alignment);
+  if (!bytes.empty()) {
+    memcpy(range.data, bytes.data(), bytes.size());
+  }
+  return range;
+}
+
+/**
+ * @details A chunk is rewound as soon as its last range is released, so
+ * the next uploads reuse its start.
+ */
+void StagingPool::release(const Range &range) {
+  if (range.chunk == nullptr) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(mutex);
+  Chunk &chunk = *range.chunk;
+  chunk.live--;
+  if (chunk.released()) {
+    chunk.top = 0;
+  }
+}
+
+void StagingPool::collect() {
+  std::lock_guard<std::mutex> lock(mutex);
+
+  // Keep a few idle regular chunks; oversized ones are always freed
+  size_t idle = 0;
+  std::erase_if(chunks, [&](const std::unique_ptr<Chunk> &chunk) {
+    if (!chunk->released()) {
+      return false;
+    }
+    return chunk->size != chunkSize || ++idle > kRetainedChunks;
+  });
+}
+
+StagingPool::Stats StagingPool::stats() const {
+  std::lock_guard<std::mutex> lock(mutex);
+  Stats stats;
+  stats.chunkCount = chunks.size();
+  for (const std::unique_ptr<Chunk> &chunk : chunks) {
+    stats.chunkBytes += chunk->size;
+    stats.usedBytes += chunk->top;
+    stats.liveRanges += chunk->live;
+  }
+  stats.chunksCreated = chunksCreated;
+  stats.rangesAllocated = rangesAllocated;
+  return stats;
+}
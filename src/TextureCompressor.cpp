@@ -0,0 +1,531 @@
+/**
+ * @file TextureCompressor.cpp
+ * @brief BC1 and BC7 (mode 6) block encoders/decoders.
+ *
+ * @see TextureCompressor.hpp
+ */
+#include "../include/TextureCompressor.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+namespace bcn {
+
+namespace {
+
+/** @brief BC7 4-bit interpolation weights (out of 64). */
+constexpr std::array<uint32_t, 16> kBC7Weights = {
+    0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+/** @brief BC1 interpolation position of each 2-bit index (c0 -> c1). */
+constexpr std::array<float, 4> kBC1Weights = {0.0f, 1.0f, 1.0f / 3.0f,
+                                              2.0f / 3.0f};
+
+/**
+ * @brief Extremes of a block along its principal axis.
+ *
+ * The axis is the dominant eigenvector of the channel covariance, found by
+ * power iteration; 'low'/'high' are the mean plus the axis scaled by the
+ * smallest/largest projection of any texel.
+ *
+ * @tparam Channels 3 (RGB) or 4 (RGBA).
+ */
+template <int Channels>
+void principalExtremes(const uint8_t *texels, float *low, float *high) {
+  float mean[Channels] = {};
+  for (int i = 0; i < 16; i++) {
+    for (int c = 0; c < Channels; c++) {
+      mean[c] += texels[i * 4 + c];
+    }
+  }
+  for (int c = 0; c < Channels; c++) {
+    mean[c] /= 16.0f;
+  }
+
+  float covariance[Channels][Channels] = {};
+  for (int i = 0; i < 16; i++) {
+    float d[Channels];
+    for (int c = 0; c < Channels; c++) {
+      d[c] = texels[i * 4 + c] - mean[c];
+    }
+    for (int a = 0; a < Channels; a++) {
+      for (int b = 0; b < Channels; b++) {
+        covariance[a][b] += d[a] * d[b];
+      }
+    }
+  }
+
+  float axis[Channels];
+  std::fill(axis, axis + Channels, 1.0f);
+  for (int iteration = 0; iteration < 8; iteration++) {
+    float next[Channels] = {};
+    float length = 0.0f;
+    for (int a = 0; a < Channels; a++) {
+      for (int b = 0; b < Channels; b++) {
+        next[a] += covariance[a][b] * axis[b];
+      }
+      length = std::max(length, std::abs(next[a]));
+    }
+    if (length < 1e-6f) {
+      break; // Flat block: any axis works
+    }
+    for (int c = 0; c < Channels; c++) {
+      axis[c] = next[c] / length;
+    }
+  }
+  float axisLengthSquared = 0.0f;
+  for (int c = 0; c < Channels; c++) {
+    axisLengthSquared += axis[c] * axis[c];
+  }
+
+  float minT = std::numeric_limits<float>::max();
+  float maxT = std::numeric_limits<float>::lowest();
+  for (int i = 0; i < 16; i++) {
+    float t = 0.0f;
+    for (int c = 0; c < Channels; c++) {
+      t += (texels[i * 4 + c] - mean[c]) * axis[c];
+    }
+    t /= axisLengthSquared;
+    minT = std::min(minT, t);
+    maxT = std::max(maxT, t);
+  }
+  for (int c = 0; c < Channels; c++) {
+    low[c] = std::clamp(mean[c] + axis[c] * minT, 0.0f, 255.0f);
+    high[c] = std::clamp(mean[c] + axis[c] * maxT, 0.0f, 255.0f);
+  }
+}
+
+/**
+ * @brief Least-squares endpoints for fixed per-texel interpolation weights.
+ *
+ * Minimizes sum |(1 - t_i) * e0 + t_i * e1 - x_i|^2 per channel.
+ *
+ * @return false if the system is singular (all texels use one weight).
+ */
+template <int Channels>
+bool leastSquaresEndpoints(const uint8_t *texels, const float *weights,
+                           float *e0, float *e1) {
+  float a = 0.0f, b = 0.0f, c = 0.0f;
+  float x0[Channels] = {}, x1[Channels] = {};
+  for (int i = 0; i < 16; i++) {
+    const float t = weights[i], s = 1.0f - t;
+    a += s * s;
+    b += s * t;
+    c += t * t;
+    for (int ch = 0; ch < Channels; ch++) {
+      x0[ch] += s * texels[i * 4 + ch];
+      x1[ch] += t * texels[i * 4 + ch];
+    }
+  }
+  const float determinant = a * c - b * b;
+  if (std::abs(determinant) < 1e-6f) {
+    return false;
+  }
+  for (int ch = 0; ch < Channels; ch++) {
+    e0[ch] = std::clamp((c * x0[ch] - b * x1[ch]) / determinant, 0.0f, 255.0f);
+    e1[ch] = std::clamp((a * x1[ch] - b * x0[ch]) / determinant, 0.0f, 255.0f);
+  }
+  return true;
+}
+
+// ---------------------------------------------------------------- BC1 ----
+
+uint16_t toRgb565(const float *rgb) {
+  const auto r = static_cast<uint16_t>(std::lround(rgb[0] * 31.0f / 255.0f));
+  const auto g = static_cast<uint16_t>(std::lround(rgb[1] * 63.0f / 255.0f));
+  const auto b = static_cast<uint16_t>(std::lround(rgb[2] * 31.0f / 255.0f));
+  return static_cast<uint16_t>((r << 11) | (g << 5) | b);
+}
+
+void fromRgb565(uint16_t color, int *rgb) {
+  const int r = (color >> 11) & 31, g = (color >> 5) & 63, b = color & 31;
+  rgb[0] = (r << 3) | (r >> 2);
+  rgb[1] = (g << 2) | (g >> 4);
+  rgb[2] = (b << 3) | (b >> 2);
+}
+
+/** @brief Four-color BC1 palette (requires c0 > c1). */
+void bc1Palette(uint16_t c0, uint16_t c1, int palette[4][3]) {
+  fromRgb565(c0, palette[0]);
+  fromRgb565(c1, palette[1]);
+  for (int c = 0; c < 3; c++) {
+    palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+    palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+  }
+}
+
+/**
+ * @struct BC1Block
+ * @brief Candidate BC1 encoding and its squared error.
+ */
+struct BC1Block {
+  uint16_t color0 = 0;
+  uint16_t color1 = 0;
+  uint32_t indices = 0;
+  uint32_t error = std::numeric_limits<uint32_t>::max();
+};
+
+/** @brief Picks the nearest palette entry per texel for two endpoints. */
+BC1Block fitBC1(const uint8_t *texels, const float *e0, const float *e1) {
+  BC1Block block;
+  block.color0 = toRgb565(e0);
+  block.color1 = toRgb565(e1);
+  if (block.color0 < block.color1) {
+    std::swap(block.color0, block.color1);
+  }
+  if (block.color0 == block.color1) {
+    // Solid block; nudge color1 down so four-color mode stays selected
+    if (block.color1 > 0) {
+      block.color1--;
+    } else {
+      block.color0++;
+    }
+  }
+
+  int palette[4][3];
+  bc1Palette(block.color0, block.color1, palette);
+  block.error = 0;
+  for (int i = 0; i < 16; i++) {
+    uint32_t bestError = std::numeric_limits<uint32_t>::max(), best = 0;
+    for (uint32_t p = 0; p < 4; p++) {
+      uint32_t error = 0;
+      for (int c = 0; c < 3; c++) {
+        const int d = texels[i * 4 + c] - palette[p][c];
+        error += static_cast<uint32_t>(d * d);
+      }
+      if (error < bestError) {
+        bestError = error;
+        best = p;
+      }
+    }
+    block.indices |= best << (2 * i);
+    block.error += bestError;
+  }
+  return block;
+}
+
+// ---------------------------------------------------------------- BC7 ----
+
+/**
+ * @struct BC7Mode6
+ * @brief Candidate BC7 mode 6 encoding and its squared error.
+ */
+struct BC7Mode6 {
+  uint8_t endpoint[2][4] = {}; ///< 7-bit RGBA endpoints
+  uint8_t pbit[2] = {};        ///< Shared LSB of each endpoint
+  uint8_t index[16] = {};      ///< 4-bit weights indices
+  uint32_t error = std::numeric_limits<uint32_t>::max();
+};
+
+/** @brief Expands a quantized endpoint channel to 8 bits. */
+int bc7Expand(const BC7Mode6 &block, int endpoint, int channel) {
+  return (block.endpoint[endpoint][channel] << 1) | block.pbit[endpoint];
+}
+
+/** @brief The 16-entry RGBA palette of a mode 6 block. */
+void bc7Palette(const BC7Mode6 &block, int palette[16][4]) {
+  for (int c = 0; c < 4; c++) {
+    const int v0 = bc7Expand(block, 0, c), v1 = bc7Expand(block, 1, c);
+    for (int i = 0; i < 16; i++) {
+      const int w = static_cast<int>(kBC7Weights[i]);
+      palette[i][c] = ((64 - w) * v0 + w * v1 + 32) >> 6;
+    }
+  }
+}
+
+/** @brief Quantizes two float endpoints with fixed p-bits and fits indices. */
+BC7Mode6 fitBC7(const uint8_t *texels, const float *e0, const float *e1,
+                int p0, int p1) {
+  BC7Mode6 block;
+  block.pbit[0] = static_cast<uint8_t>(p0);
+  block.pbit[1] = static_cast<uint8_t>(p1);
+  for (int c = 0; c < 4; c++) {
+    block.endpoint[0][c] = static_cast<uint8_t>(
+        std::clamp<long>(std::lround((e0[c] - p0) / 2.0f), 0, 127));
+    block.endpoint[1][c] = static_cast<uint8_t>(
+        std::clamp<long>(std::lround((e1[c] - p1) / 2.0f), 0, 127));
+  }
+
+  int palette[16][4];
+  bc7Palette(block, palette);
+  block.error = 0;
+  for (int i = 0; i < 16; i++) {
+    uint32_t bestError = std::numeric_limits<uint32_t>::max(), best = 0;
+    for (uint32_t p = 0; p < 16; p++) {
+      uint32_t error = 0;
+      for (int c = 0; c < 4; c++) {
+        const int d = texels[i * 4 + c] - palette[p][c];
+        error += static_cast<uint32_t>(d * d);
+      }
+      if (error < bestError) {
+        bestError = error;
+        best = p;
+      }
+    }
+    block.index[i] = static_cast<uint8_t>(best);
+    block.error += bestError;
+  }
+  return block;
+}
+
+/** @brief Tries all four p-bit combinations, keeping the best in 'best'. */
+void tryBC7Endpoints(const uint8_t *texels, const float *e0, const float *e1,
+                     BC7Mode6 &best) {
+  for (int p0 = 0; p0 < 2; p0++) {
+    for (int p1 = 0; p1 < 2; p1++) {
+      BC7Mode6 candidate = fitBC7(texels, e0, e1, p0, p1);
+      if (candidate.error < best.error) {
+        best = candidate;
+      }
+    }
+  }
+}
+
+/**
+ * @class BitStream
+ * @brief LSB-first bit cursor over a zero-initialized block.
+ */
+class BitStream {
+public:
+  explicit BitStream(uint8_t *bytes) : data(bytes) {}
+
+  void write(uint32_t value, uint32_t bits) {
+    for (uint32_t b = 0; b < bits; b++, position++) {
+      data[position >> 3] |=
+          static_cast<uint8_t>(((value >> b) & 1u) << (position & 7));
+    }
+  }
+
+  uint32_t read(uint32_t bits) {
+    uint32_t value = 0;
+    for (uint32_t b = 0; b < bits; b++, position++) {
+      value |= static_cast<uint32_t>((data[position >> 3] >> (position & 7)) &
+                                     1u)
+               << b;
+    }
+    return value;
+  }
+
+private:
+  uint8_t *data;
+  uint32_t position = 0;
+};
+
+} // namespace
+
+/**
+ * @details
+ * Endpoints start at the principal-axis extremes of the block, get one
+ * least-squares refinement against the chosen indices, and the better of the
+ * two fits is kept. Alpha is ignored (BC1 is written in four-color mode).
+ */
+void encodeBC1(const uint8_t *texels, uint8_t *out) {
+  float low[3], high[3];
+  principalExtremes<3>(texels, low, high);
+  BC1Block best = fitBC1(texels, high, low);
+
+  float weights[16];
+  for (int i = 0; i < 16; i++) {
+    weights[i] = kBC1Weights[(best.indices >> (2 * i)) & 3u];
+  }
+  float e0[3], e1[3];
+  if (leastSquaresEndpoints<3>(texels, weights, e0, e1)) {
+    BC1Block refined = fitBC1(texels, e0, e1);
+    if (refined.error < best.error) {
+      best = refined;
+    }
+  }
+
+  const uint8_t bytes[8] = {
+      static_cast<uint8_t>(best.color0), static_cast<uint8_t>(best.color0 >> 8),
+      static_cast<uint8_t>(best.color1), static_cast<uint8_t>(best.color1 >> 8),
+      static_cast<uint8_t>(best.indices),
+      static_cast<uint8_t>(best.indices >> 8),
+      static_cast<uint8_t>(best.indices >> 16),
+      static_cast<uint8_t>(best.indices >> 24)};
+  std::memcpy(out, bytes, sizeof(bytes));
+}
+
+/**
+ * @details
+ * Same search as encodeBC1() in RGBA, with every p-bit combination tried for
+ * each endpoint pair. The anchor texel (index 0) stores only three index
+ * bits, so if its index has the MSB set the endpoints are swapped and all
+ * indices mirrored (the weight table is symmetric, so the result is
+ * identical).
+ *
+ * Layout (LSB first): mode (7 bits, 0b1000000), R0 R1 G0 G1 B0 B1 A0 A1
+ * (7 bits each), P0, P1, then 3 + 15 * 4 index bits.
+ */
+void encodeBC7(const uint8_t *texels, uint8_t *out) {
+  float low[4], high[4];
+  principalExtremes<4>(texels, low, high);
+  BC7Mode6 best;
+  tryBC7Endpoints(texels, low, high, best);
+
+  float weights[16];
+  for (int i = 0; i < 16; i++) {
+    weights[i] = kBC7Weights[best.index[i]] / 64.0f;
+  }
+  float e0[4], e1[4];
+  if (leastSquaresEndpoints<4>(texels, weights, e0, e1)) {
+    tryBC7Endpoints(texels, e0, e1, best);
+  }
+
+  if (best.index[0] & 8u) {
+    std::swap(best.endpoint[0], best.endpoint[1]);
+    std::swap(best.pbit[0], best.pbit[1]);
+    for (uint8_t &index : best.index) {
+      index = static_cast<uint8_t>(15 - index);
+    }
+  }
+
+  std::memset(out, 0, 16);
+  BitStream bits(out);
+  bits.write(1u << 6, 7);
+  for (int c = 0; c < 4; c++) {
+    bits.write(best.endpoint[0][c], 7);
+    bits.write(best.endpoint[1][c], 7);
+  }
+  bits.write(best.pbit[0], 1);
+  bits.write(best.pbit[1], 1);
+  bits.write(best.index[0], 3);
+  for (int i = 1; i < 16; i++) {
+    bits.write(best.index[i], 4);
+  }
+}
+
+void decodeBC1(const uint8_t *block, uint8_t *texels) {
+  const uint16_t c0 = static_cast<uint16_t>(block[0] | (block[1] << 8));
+  const uint16_t c1 = static_cast<uint16_t>(block[2] | (block[3] << 8));
+  const uint32_t indices = static_cast<uint32_t>(block[4]) |
+                           (static_cast<uint32_t>(block[5]) << 8) |
+                           (static_cast<uint32_t>(block[6]) << 16) |
+                           (static_cast<uint32_t>(block[7]) << 24);
+
+  int palette[4][4];
+  fromRgb565(c0, palette[0]);
+  fromRgb565(c1, palette[1]);
+  palette[0][3] = palette[1][3] = palette[2][3] = palette[3][3] = 255;
+  for (int c = 0; c < 3; c++) {
+    if (c0 > c1) {
+      palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+      palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+    } else {
+      palette[2][c] = (palette[0][c] + palette[1][c]) / 2;
+      palette[3][c] = 0;
+    }
+  }
+  if (c0 <= c1) {
+    palette[3][3] = 0; // Three-color mode: index 3 is transparent black
+  }
+
+  for (int i = 0; i < 16; i++) {
+    const uint32_t index = (indices >> (2 * i)) & 3u;
+    for (int c = 0; c < 4; c++) {
+      texels[i * 4 + c] = static_cast<uint8_t>(palette[index][c]);
+    }
+  }
+}
+
+void decodeBC7(const uint8_t *block, uint8_t *texels) {
+  if ((block[0] & 0x7f) != 0x40) {
+    for (int i = 0; i < 16; i++) {
+      texels[i * 4 + 0] = 255;
+      texels[i * 4 + 1] = 0;
+      texels[i * 4 + 2] = 255;
+      texels[i * 4 + 3] = 255;
+    }
+    return;
+  }
+
+  uint8_t copy[16];
+  std::memcpy(copy, block, sizeof(copy));
+  BitStream bits(copy);
+  bits.read(7);
+  BC7Mode6 mode6;
+  for (int c = 0; c < 4; c++) {
+    mode6.endpoint[0][c] = static_cast<uint8_t>(bits.read(7));
+    mode6.endpoint[1][c] = static_cast<uint8_t>(bits.read(7));
+  }
+  mode6.pbit[0] = static_cast<uint8_t>(bits.read(1));
+  mode6.pbit[1] = static_cast<uint8_t>(bits.read(1));
+  mode6.index[0] = static_cast<uint8_t>(bits.read(3));
+  for (int i = 1; i < 16; i++) {
+    mode6.index[i] = static_cast<uint8_t>(bits.read(4));
+  }
+
+  int palette[16][4];
+  bc7Palette(mode6, palette);
+  for (int i = 0; i < 16; i++) {
+    for (int c = 0; c < 4; c++) {
+      texels[i * 4 + c] = static_cast<uint8_t>(palette[mode6.index[i]][c]);
+    }
+  }
+}
+
+std::vector<uint8_t> compress(std::span<const uint8_t> rgba, uint32_t width,
+                              uint32_t height, Codec codec, ThreadPool &pool) {
+  if (rgba.size() < static_cast<size_t>(width) * height * 4) {
+    throw std::runtime_error("bcn::compress: pixel buffer too small");
+  }
+  const uint32_t blocksX = (width + 3) / 4, blocksY = (height + 3) / 4;
+  const size_t bytesPerBlock = blockBytes(codec);
+  std::vector<uint8_t> blocks(compressedSize(codec, width, height));
+
+  pool.parallelFor(blocksY, [&](size_t by) {
+    uint8_t texels[64];
+    for (uint32_t bx = 0; bx < blocksX; bx++) {
+      for (uint32_t i = 0; i < 16; i++) {
+        const uint32_t x = std::min(bx * 4 + i % 4, width - 1);
+        const uint32_t y = std::min(static_cast<uint32_t>(by) * 4 + i / 4,
+                                    height - 1);
+        std::memcpy(&texels[i * 4],
+                    &rgba[(static_cast<size_t>(y) * width + x) * 4], 4);
+      }
+      uint8_t *out = &blocks[(by * blocksX + bx) * bytesPerBlock];
+      if (codec == Codec::eBC1) {
+        encodeBC1(texels, out);
+      } else {
+        encodeBC7(texels, out);
+      }
+    }
+  });
+  return blocks;
+}
+
+std::vector<uint8_t> decompress(std::span<const uint8_t> blocks,
+                                uint32_t width, uint32_t height, Codec codec) {
+  if (blocks.size() < compressedSize(codec, width, height)) {
+    throw std::runtime_error("bcn::decompress: block buffer too small");
+  }
+  const uint32_t blocksX = (width + 3) / 4, blocksY = (height + 3) / 4;
+  const size_t bytesPerBlock = blockBytes(codec);
+  std::vector<uint8_t> rgba(static_cast<size_t>(width) * height * 4);
+
+  uint8_t texels[64];
+  for (uint32_t by = 0; by < blocksY; by++) {
+    for (uint32_t bx = 0; bx < blocksX; bx++) {
+      const uint8_t *block = &blocks[(by * blocksX + bx) * bytesPerBlock];
+      if (codec == Codec::eBC1) {
+        decodeBC1(block, texels);
+      } else {
+        decodeBC7(block, texels);
+      }
+      for (uint32_t i = 0; i < 16; i++) {
+        const uint32_t x = bx * 4 + i % 4, y = by * 4 + i / 4;
+        if (x < width && y < height) {
+          std::memcpy(&rgba[(static_cast<size_t>(y) * width + x) * 4],
+                      &texels[i * 4], 4);
+        }
+      }
+    }
+  }
+  return rgba;
+}
+
+} // namespace bcn
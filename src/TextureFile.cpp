@@ -0,0 +1,199 @@
+/**
+ * @file TextureFile.cpp
+ * @brief Baked texture reading (mmap) and writing.
+ *
+ * @see TextureFile.hpp for the on-disk layout.
+ */
+#include "../include/TextureFile.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+
+#include "../include/MeshCache.hpp"
+
+namespace artx {
+
+namespace {
+
+/** @brief Rounds 'value' up to the next multiple of 'alignment'. */
+constexpr uint64_t alignUp(uint64_t value, uint64_t alignment) {
+  return (value + alignment - 1) / alignment * alignment;
+}
+
+/** @brief Bytes a level of the given size needs in 'format'. */
+uint64_t levelSize(Format format, uint32_t width, uint32_t height) {
+  const uint64_t blocks =
+      static_cast<uint64_t>((width + 3) / 4) * ((height + 3) / 4);
+  switch (format) {
+  case Format::eBC1:
+    return blocks * 8;
+  case Format::eBC7:
+    return blocks * 16;
+  case Format::eRGBA8:
+  default:
+    return static_cast<uint64_t>(width) * height * 4;
+  }
+}
+
+} // namespace
+
+const char *name(Format format) {
+  switch (format) {
+  case Format::eBC1:
+    return "BC1";
+  case Format::eBC7:
+    return "BC7";
+  case Format::eRGBA8:
+  default:
+    return "RGBA8";
+  }
+}
+
+/**
+ * @details
+ * Besides the header fields, every level must lie inside the file, halve in
+ * size from its predecessor and hold exactly the bytes its format needs, so
+ * the renderer can hand the levels to vkCmdCopyBufferToImage unchecked.
+ */
+std::optional<TextureFile> TextureFile::open(const std::string &path,
+                                             const std::string &sourcePath) {
+  if (!std::filesystem::exists(path)) {
+    return std::nullopt;
+  }
+
+  MappedFile file;
+  try {
+    file = MappedFile(path);
+  } catch (const std::exception &) {
+    return std::nullopt;
+  }
+
+  auto texture = fromBytes(file.bytes(), sourcePath);
+  if (texture) {
+    // The mapping's address survives the move, so 'contents' stays valid
+    texture->file = std::move(file);
+  }
+  return texture;
+}
+
+std::optional<TextureFile>
+TextureFile::fromBytes(std::span<const std::byte> bytes,
+                       const std::string &sourcePath) {
+  if (bytes.size() < sizeof(Header)) {
+    return std::nullopt;
+  }
+  const Header &header = *reinterpret_cast<const Header *>(bytes.data());
+  if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 ||
+      header.version != kVersion ||
+      static_cast<uint32_t>(header.format) > 2 || header.width == 0 ||
+      header.height == 0 || header.mipCount == 0 || header.mipCount > 32 ||
+      sizeof(Header) + header.mipCount * sizeof(LevelInfo) > bytes.size()) {
+    return std::nullopt;
+  }
+
+  const auto *levels =
+      reinterpret_cast<const LevelInfo *>(bytes.data() + sizeof(Header));
+  uint32_t width = header.width, height = header.height;
+  for (uint32_t i = 0; i < header.mipCount; i++) {
+    if (levels[i].width != width || levels[i].height != height ||
+        levels[i].size != levelSize(header.format, width, height) ||
+        levels[i].offset % kLevelAlignment != 0 ||
+        levels[i].offset > bytes.size() ||
+        levels[i].size > bytes.size() - levels[i].offset) {
+      return std::nullopt;
+    }
+    width = std::max(1u, width / 2);
+    height = std::max(1u, height / 2);
+  }
+
+  if (auto stamp = meshcache::stampFile(sourcePath)) {
+    if (stamp->size != header.sourceSize) {
+      return std::nullopt;
+    }
+    if (stamp->mtime != header.sourceMtime &&
+        meshcache::hashFile(sourcePath) != header.sourceHash) {
+      return std::nullopt;
+    }
+  }
+
+  return TextureFile(bytes);
+}
+
+std::span<const LevelInfo> TextureFile::levels() const {
+  const std::byte *base = contents.data() + sizeof(Header);
+  return {reinterpret_cast<const LevelInfo *>(base), header().mipCount};
+}
+
+std::span<const std::byte> TextureFile::levelData(uint32_t level) const {
+  const LevelInfo &info = levels()[level];
+  return {contents.data() + info.offset, static_cast<size_t>(info.size)};
+}
+
+void write(const std::string &path, const std::string &sourcePath,
+           Format format, std::span<const Level> levels) {
+  auto stamp = meshcache::stampFile(sourcePath);
+  if (!stamp) {
+    throw std::runtime_error("Texture source not found: " + sourcePath);
+  }
+  if (levels.empty()) {
+    throw std::runtime_error("Baked texture needs at least one level: " +
+                             path);
+  }
+
+  Header header{};
+  std::memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.version = kVersion;
+  header.format = format;
+  header.width = levels[0].width;
+  header.height = levels[0].height;
+  header.mipCount = static_cast<uint32_t>(levels.size());
+  header.sourceSize = stamp->size;
+  header.sourceMtime = stamp->mtime;
+  header.sourceHash = meshcache::hashFile(sourcePath);
+
+  std::vector<LevelInfo> table(levels.size());
+  uint64_t offset = sizeof(Header) + levels.size() * sizeof(LevelInfo);
+  for (size_t i = 0; i < levels.size(); i++) {
+    offset = alignUp(offset, kLevelAlignment);
+    table[i] = {offset, levels[i].data.size(), levels[i].width,
+                levels[i].height};
+    offset += levels[i].data.size();
+  }
+
+  const std::string tmpPath = path + ".tmp";
+  {
+    std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+      throw std::runtime_error("Failed to create baked texture: " + tmpPath);
+    }
+
+    const char padding[kLevelAlignment] = {};
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char *>(table.data()),
+              static_cast<std::streamsize>(table.size() * sizeof(LevelInfo)));
+    for (size_t i = 0; i < levels.size(); i++) {
+      out.write(padding, static_cast<std::streamsize>(
+                             table[i].offset -
+                             static_cast<uint64_t>(out.tellp())));
+      out.write(reinterpret_cast<const char *>(levels[i].data.data()),
+                static_cast<std::streamsize>(levels[i].data.size()));
+    }
+
+    if (!out.good()) {
+      throw std::runtime_error("Failed to write baked texture: " + tmpPath);
+    }
+  }
+
+  std::error_code ec;
+  std::filesystem::rename(tmpPath, path, ec);
+  if (ec) {
+    std::filesystem::remove(tmpPath, ec);
+    throw std::runtime_error("Failed to move baked texture into place: " +
+                             path);
+  }
+}
+
+} // namespace artx
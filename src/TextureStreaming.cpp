@@ -0,0 +1,69 @@
+/**
+ * @file TextureStreaming.cpp
+ * @brief Mip residency policy: coverage-based desired level and budget.
+ *
+ * @see TextureStreaming.hpp
+ */
+#include "../include/TextureStreaming.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace texstream {
+
+uint64_t chainBytes(std::span<const Level> levels, uint32_t firstMip) {
+  uint64_t bytes = 0;
+  for (size_t i = firstMip; i < levels.size(); i++) {
+    bytes += levels[i].data.size();
+  }
+  return bytes;
+}
+
+uint32_t initialMip(std::span<const Level> levels, uint32_t maxSize) {
+  for (uint32_t i = 0; i < levels.size(); i++) {
+    if (std::max(levels[i].width, levels[i].height) <= maxSize) {
+      return i;
+    }
+  }
+  return static_cast<uint32_t>(levels.size()) - 1;
+}
+
+uint32_t budgetMip(std::span<const Level> levels, uint64_t budgetBytes) {
+  // Walk from the smallest level up while the chain still fits
+  uint32_t mip = static_cast<uint32_t>(levels.size()) - 1;
+  uint64_t bytes = levels[mip].data.size();
+  while (mip > 0 && bytes + levels[mip - 1].data.size() <= budgetBytes) {
+    mip--;
+    bytes += levels[mip].data.size();
+  }
+  return mip;
+}
+
+uint32_t desiredMip(uint32_t width, uint32_t height, float coveragePixels,
+                    uint32_t mipCount) {
+  const float size = static_cast<float>(std::max(width, height));
+  if (!(coveragePixels > 0.0f)) {
+    return mipCount - 1; // Off screen or degenerate: the tail is enough
+  }
+  const float mip = std::floor(std::log2(size / coveragePixels));
+  return static_cast<uint32_t>(
+      std::clamp(mip, 0.0f, static_cast<float>(mipCount - 1)));
+}
+
+Step nextStep(const Residency &residency, std::span<const Level> levels,
+              uint64_t budgetBytes) {
+  const uint32_t budget = budgetMip(levels, budgetBytes);
+  if (residency.residentMip < budget) {
+    return {Action::eEvict, budget};
+  }
+  const uint32_t target = std::max(residency.desiredMip, budget);
+  if (residency.residentMip > target) {
+    return {Action::eStreamIn, residency.residentMip - 1};
+  }
+  if (residency.residentMip + kEvictionSlack < residency.desiredMip) {
+    return {Action::eEvict, residency.desiredMip};
+  }
+  return {};
+}
+
+} // namespace texstream
@@ -0,0 +1,157 @@
+/**
+ * @file ThreadPool.cpp
+ * @brief Implementation of the worker pool and its parallel-for helper.
+ */
+#include "../include/ThreadPool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+
+/**
+ * @brief Spawns the worker threads.
+ *
+ * @param threadCount Requested worker count (0 = hardware concurrency).
+ */
+ThreadPool::ThreadPool(size_t threadCount) {
+  if (threadCount == 0) {
+    threadCount = std::max(1u, std::thread::hardware_concurrency());
+  }
+
+  workers.reserve(threadCount);
+  for (size_t i = 0; i < threadCount; i++) {
+    workers.emplace_back([this]() { workerLoop(); });
+  }
+}
+
+/**
+ * @brief Drains the queue and joins every worker.
+ */
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    stopping = true;
+  }
+  queueCondition.notify_all();
+
+  for (auto &worker : workers) {
+    worker.join();
+  }
+}
+
+/**
+ * @brief Adds a task to the queue and wakes one worker.
+ *
+ * @param task Type-erased task.
+ */
+void ThreadPool::enqueue(std::function<void()> task) {
+  {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    tasks.push(std::move(task));
+  }
+  queueCondition.notify_one();
+}
+
+/**
+ * @brief Worker main loop.
+ *
+ * @details Sleeps on the condition variable until a task is queued, then
+ * runs it outside the lock. Exits once 'stopping' is set and the queue is
+ * empty, so queued work is never dropped.
+ */
+void ThreadPool::workerLoop() {
+  for (;;) {
+    std::function<void()> task;
+    {
+      std::unique_lock<std::mutex> lock(queueMutex);
+      queueCondition.wait(lock, [this]() { return stopping || !tasks.empty(); });
+      if (stopping && tasks.empty()) {
+        return;
+      }
+      task = std::move(tasks.front());
+      tasks.pop();
+    }
+    task();
+  }
+}
+
+/**
+ * @brief Dynamically scheduled parallel loop.
+ *
+ * @param count Number of iterations.
+ * @param body Loop body, called with each index exactly once.
+ *
+ * @details
+ * Helper tasks and the calling thread pull indices from a shared atomic
+ * counter. Completion is tracked per *iteration*, not per helper task, so
+ * the caller never blocks on a helper that has not been scheduled yet; this
+ * keeps nested calls (parallelFor inside a pool task) deadlock-free.
+ */
+void ThreadPool::parallelFor(size_t count,
+                             const std::function<void(size_t)> &body) {
+  if (count == 0) {
+    return;
+  }
+  if (count == 1 || workers.empty()) {
+    for (size_t i = 0; i < count; i++) {
+      body(i);
+    }
+    return;
+  }
+
+  // Shared state outlives this call if a late helper starts after we return
+  struct LoopState {
+    std::atomic<size_t> next{0};
+    std::atomic<size_t> done{0};
+    size_t count = 0;
+    std::function<void(size_t)> body;
+    std::mutex mutex;
+    std::condition_variable finished;
+    std::exception_ptr error;
+  };
+  auto state = std::make_shared<LoopState>();
+  state->count = count;
+  state->body = body;
+
+  auto runIterations = [](const std::shared_ptr<LoopState> &loop) {
+    for (;;) {
+      size_t i = loop->next.fetch_add(1);
+      if (i >= loop->count) {
+        return;
+      }
+      try {
+        loop->body(i);
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(loop->mutex);
+        if (!loop->error) {
+          loop->error = std::current_exception();
+        }
+      }
+      if (loop->done.fetch_add(1) + 1 == loop->count) {
+        std::lock_guard<std::mutex> lock(loop->mutex);
+        loop->finished.notify_all();
+      }
+    }
+  };
+
+  // One helper per worker (capped by the iteration count); the caller helps
+  size_t helpers = std::min(workers.size(), count - 1);
+  for (size_t i = 0; i < helpers; i++) {
+    enqueue([state, runIterations]() { runIterations(state); });
+  }
+  runIterations(state);
+
+  std::unique_lock<std::mutex> lock(state->mutex);
+  state->finished.wait(lock, [&]() { return state->done.load() == count; });
+  if (state->error) {
+    std::rethrow_exception(state->error);
+  }
+}
+
+/**
+ * @brief Returns the lazily created process-wide pool.
+ */
+ThreadPool &ThreadPool::global() {
+  static ThreadPool pool;
+  return pool;
+}
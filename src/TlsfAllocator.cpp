@@ -0,0 +1,257 @@
+/**
+ * @file TlsfAllocator.cpp
+ * @brief Two-level segregated fit allocator.
+ *
+ * @see TlsfAllocator.hpp
+ */
+#include "../include/TlsfAllocator.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <stdexcept>
+#include <string>
+
+TlsfAllocator::TlsfAllocator(uint64_t capacity)
+    : heads(kFirstLevels * kSecondLevels, kNone), capacityBytes(capacity) {
+  if (capacity == 0) {
+    throw std::runtime_error("TLSF allocator capacity must not be zero");
+  }
+  const uint32_t whole = newNode();
+  nodes[whole].size = capacity;
+  insertFree(whole);
+}
+
+/**
+ * @details Sizes below kSecondLevels map linearly to first level 0. Above
+ * that, the first level is the position of the most significant bit and
+ * the second level the next kSecondLevelBits bits, so the buckets of each
+ * power of two are equally wide.
+ */
+void TlsfAllocator::mapping(uint64_t size, uint32_t &fl, uint32_t &sl) {
+  if (size < kSecondLevels) {
+    fl = 0;
+    sl = static_cast<uint32_t>(size);
+    return;
+  }
+  const uint32_t msb = 63u - static_cast<uint32_t>(std::countl_zero(size));
+  fl = msb - kSecondLevelBits + 1;
+  sl = static_cast<uint32_t>(size >> (msb - kSecondLevelBits)) ^ kSecondLevels;
+}
+
+uint32_t TlsfAllocator::newNode() {
+  if (!spareNodes.empty()) {
+    const uint32_t index = spareNodes.back();
+    spareNodes.pop_back();
+    nodes[index] = Node{};
+    return index;
+  }
+  nodes.emplace_back();
+  return static_cast<uint32_t>(nodes.size() - 1);
+}
+
+void TlsfAllocator::releaseNode(uint32_t index) {
+  spareNodes.push_back(index);
+}
+
+void TlsfAllocator::insertFree(uint32_t index) {
+  uint32_t fl = 0;
+  uint32_t sl = 0;
+  mapping(nodes[index].size, fl, sl);
+  uint32_t &head = heads[fl * kSecondLevels + sl];
+
+  Node &node = nodes[index];
+  node.free = true;
+  node.prevFree = kNone;
+  node.nextFree = head;
+  if (head != kNone) {
+    nodes[head].prevFree = index;
+  }
+  head = index;
+  firstLevelMap |= 1ull << fl;
+  secondLevelMap[fl] |= 1u << sl;
+  freeBlocks++;
+}
+
+void TlsfAllocator::removeFree(uint32_t index) {
+  Node &node = nodes[index];
+  if (node.prevFree != kNone) {
+    nodes[node.prevFree].nextFree = node.nextFree;
+  } else {
+    uint32_t fl = 0;
+    uint32_t sl = 0;
+    mapping(node.size, fl, sl);
+    heads[fl * kSecondLevels + sl] = node.nextFree;
+    if (node.nextFree == kNone) {
+      secondLevelMap[fl] &= ~(1u << sl);
+      if (secondLevelMap[fl] == 0) {
+        firstLevelMap &= ~(1ull << fl);
+      }
+    }
+  }
+  if (node.nextFree != kNone) {
+    nodes[node.nextFree].prevFree = node.prevFree;
+  }
+  node.free = false;
+  node.prevFree = kNone;
+  node.nextFree = kNone;
+  freeBlocks--;
+}
+
+/**
+ * @details The size is first rounded up to the next bucket boundary, so
+ * that every block of the bucket found is large enough (good fit rather
+ * than best fit, but without walking a list). Only when no such bucket
+ * exists is the bucket of 'size' itself searched, whose blocks may be
+ * smaller; this lets the last free block of a nearly full range be used.
+ */
+uint32_t TlsfAllocator::findFree(uint64_t size) const {
+  uint64_t rounded = size;
+  if (size >= kSecondLevels) {
+    const uint32_t msb = 63u - static_cast<uint32_t>(std::countl_zero(size));
+    rounded += (1ull << (msb - kSecondLevelBits)) - 1;
+  }
+  uint32_t fl = 0;
+  uint32_t sl = 0;
+  mapping(rounded, fl, sl);
+
+  uint32_t slMap = secondLevelMap[fl] & (~0u << sl);
+  if (slMap == 0) {
+    const uint64_t flMap =
+        fl + 1 < kFirstLevels ? firstLevelMap & (~0ull << (fl + 1)) : 0;
+    if (flMap != 0) {
+      fl = static_cast<uint32_t>(std::countr_zero(flMap));
+      slMap = secondLevelMap[fl];
+    }
+  }
+  if (slMap != 0) {
+    sl = static_cast<uint32_t>(std::countr_zero(slMap));
+    return heads[fl * kSecondLevels + sl];
+  }
+
+  mapping(size, fl, sl);
+  for (uint32_t index = heads[fl * kSecondLevels + sl]; index != kNone;
+       index = nodes[index].nextFree) {
+    if (nodes[index].size >= size) {
+      return index;
+    }
+  }
+  return kNone;
+}
+
+/**
+ * @details A block found for 'size' alone is used when its start happens
+ * to be aligned; otherwise the search is repeated with room for the worst
+ * case padding. Padding in front of the aligned offset becomes a free
+ * block of its own, and so does the tail if it is at least kMinBlock bytes.
+ */
+TlsfAllocator::Allocation TlsfAllocator::allocate(uint64_t size,
+                                                  uint64_t alignment) {
+  size = std::max<uint64_t>(size, 1);
+  alignment = std::max<uint64_t>(alignment, 1);
+  if (size > capacityBytes || alignment - 1 > capacityBytes - size) {
+    return {};
+  }
+
+  uint32_t index = findFree(size);
+  if (index != kNone && (nodes[index].offset & (alignment - 1)) != 0) {
+    index = alignment > 1 ? findFree(size + alignment - 1) : kNone;
+  }
+  if (index == kNone) {
+    return {};
+  }
+  removeFree(index);
+
+  const uint64_t aligned =
+      (nodes[index].offset + alignment - 1) & ~(alignment - 1);
+  const uint64_t padding = aligned - nodes[index].offset;
+  if (padding > 0) {
+    // Split the padding off the front; it stays free
+    const uint32_t front = newNode();
+    Node &block = nodes[index];
+    nodes[front].offset = block.offset;
+    nodes[front].size = padding;
+    nodes[front].prevPhys = block.prevPhys;
+    nodes[front].nextPhys = index;
+    if (block.prevPhys != kNone) {
+      nodes[block.prevPhys].nextPhys = front;
+    }
+    block.prevPhys = front;
+    block.offset = aligned;
+    block.size -= padding;
+    insertFree(front);
+  }
+
+  if (nodes[index].size - size >= kMinBlock) {
+    const uint32_t tail = newNode();
+    Node &block = nodes[index];
+    nodes[tail].offset = block.offset + size;
+    nodes[tail].size = block.size - size;
+    nodes[tail].prevPhys = index;
+    nodes[tail].nextPhys = block.nextPhys;
+    if (block.nextPhys != kNone) {
+      nodes[block.nextPhys].prevPhys = tail;
+    }
+    block.nextPhys = tail;
+    block.size = size;
+    insertFree(tail);
+  }
+
+  usedBytes += nodes[index].size;
+  liveAllocations++;
+  return {aligned, size, index};
+}
+
+void TlsfAllocator::free(const Allocation &allocation) {
+  if (allocation.offset == kNoSpace) {
+    return;
+  }
+  uint32_t index = allocation.node;
+  if (index >= nodes.size() || nodes[index].free ||
+      nodes[index].offset != allocation.offset) {
+    throw std::runtime_error("TLSF allocator: invalid free at offset " +
+                             std::to_string(allocation.offset));
+  }
+  usedBytes -= nodes[index].size;
+  liveAllocations--;
+
+  const uint32_t prev = nodes[index].prevPhys;
+  if (prev != kNone && nodes[prev].free) {
+    // Grow the previous block over this one
+    removeFree(prev);
+    nodes[prev].size += nodes[index].size;
+    nodes[prev].nextPhys = nodes[index].nextPhys;
+    if (nodes[index].nextPhys != kNone) {
+      nodes[nodes[index].nextPhys].prevPhys = prev;
+    }
+    releaseNode(index);
+    index = prev;
+  }
+
+  const uint32_t next = nodes[index].nextPhys;
+  if (next != kNone && nodes[next].free) {
+    removeFree(next);
+    nodes[index].size += nodes[next].size;
+    nodes[index].nextPhys = nodes[next].nextPhys;
+    if (nodes[next].nextPhys != kNone) {
+      nodes[nodes[next].nextPhys].prevPhys = index;
+    }
+    releaseNode(next);
+  }
+  insertFree(index);
+}
+
+uint64_t TlsfAllocator::largestFree() const {
+  if (firstLevelMap == 0) {
+    return 0;
+  }
+  const uint32_t fl = 63u - static_cast<uint32_t>(std::countl_zero(
+                                firstLevelMap));
+  const uint32_t sl = 31u - static_cast<uint32_t>(std::countl_zero(
+                                secondLevelMap[fl]));
+  uint64_t largest = 0;
+  for (uint32_t index = heads[fl * kSecondLevels + sl]; index != kNone;
+       index = nodes[index].nextFree) {
+    largest = std::max(largest, nodes[index].size);
+  }
+  return largest;
+}
@@ -0,0 +1,195 @@
+/**
+ * @file TransientAttachments.cpp
+ * @brief Lazily allocated or aliased attachment memory.
+ *
+ * @see TransientAttachments.hpp
+ */
+#include "../include/TransientAttachments.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+vk::DeviceSize TransientAttachments::Plan::bytes() const {
+  vk::DeviceSize total = 0;
+  for (const vk::MemoryRequirements &block : blocks) {
+    total += block.size;
+  }
+  return total;
+}
+
+/**
+ * @details Greedy placement, largest request first. In each block with
+ * compatible memory types a request starts at offset 0 and is pushed past
+ * every placed request that is live in one of its passes and overlaps it
+ * in memory, until it collides with none. It goes to the block that grows
+ * least (often not at all, when a request live in other passes already
+ * spans the range); a new block is only created when no block's memory
+ * types are compatible.
+ */
+TransientAttachments::Plan
+TransientAttachments::plan(std::span<const Request> requests) {
+  Plan result;
+  result.placements.resize(requests.size());
+  std::vector<std::vector<size_t>> members;
+
+  std::vector<size_t> order(requests.size());
+  std::iota(order.begin(), order.end(), size_t{0});
+  std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+    return requests[a].size > requests[b].size;
+  });
+
+  for (size_t index : order) {
+    const Request &request = requests[index];
+    const vk::DeviceSize alignment =
+        std::max<vk::DeviceSize>(request.alignment, 1);
+    auto alignUp = [&](vk::DeviceSize offset) {
+      return (offset + alignment - 1) / alignment * alignment;
+    };
+    auto fit = [&](size_t block) {
+      vk::DeviceSize offset = 0;
+      for (bool moved = true; moved;) {
+        moved = false;
+        for (size_t other : members[block]) {
+          const Request &placed = requests[other];
+          const vk::DeviceSize begin = result.placements[other].offset;
+          const vk::DeviceSize end = begin + placed.size;
+          const bool live = request.firstPass <= placed.lastPass &&
+                            placed.firstPass <= request.lastPass;
+          if (live && offset < end && begin < offset + request.size) {
+            offset = alignUp(end);
+            moved = true;
+          }
+        }
+      }
+      return offset;
+    };
+
+    size_t chosen = result.blocks.size();
+    vk::DeviceSize chosenOffset = 0;
+    vk::DeviceSize growth = std::numeric_limits<vk::DeviceSize>::max();
+    for (size_t block = 0; block < result.blocks.size(); block++) {
+      if ((result.blocks[block].memoryTypeBits & request.memoryTypeBits) ==
+          0) {
+        continue;
+      }
+      const vk::DeviceSize offset = fit(block);
+      const vk::DeviceSize end = offset + request.size;
+      const vk::DeviceSize grows =
+          end > result.blocks[block].size ? end - result.blocks[block].size
+                                          : 0;
+      if (grows < growth) {
+        chosen = block;
+        chosenOffset = offset;
+        growth = grows;
+      }
+    }
+    if (chosen == result.blocks.size()) {
+      result.blocks.push_back(
+          vk::MemoryRequirements{0, 1, request.memoryTypeBits});
+      members.emplace_back();
+    }
+
+    vk::MemoryRequirements &block = result.blocks[chosen];
+    block.size = std::max(block.size, chosenOffset + request.size);
+    block.alignment = std::max(block.alignment, alignment);
+    block.memoryTypeBits &= request.memoryTypeBits;
+    members[chosen].push_back(index);
+    result.placements[index] =
+        Placement{static_cast<uint32_t>(chosen), chosenOffset};
+  }
+  return result;
+}
+
+TransientAttachments::TransientAttachments(
+    const vk::raii::Device &logicalDevice, GpuAllocator &gpuAllocator,
+    bool preferLazy)
+    : device(logicalDevice), allocator(gpuAllocator), lazy(preferLazy) {}
+
+void TransientAttachments::add(const vk::raii::Image &image,
+                               uint32_t firstPass, uint32_t lastPass) {
+  const vk::MemoryRequirements requirements = image.getMemoryRequirements();
+  Entry entry;
+  entry.image = &image;
+  entry.request = Request{requirements.size, requirements.alignment,
+                          requirements.memoryTypeBits, firstPass, lastPass};
+  entries.push_back(std::move(entry));
+}
+
+/**
+ * @details Lazily allocated memory is chosen per image, since a device may
+ * offer it for some formats or sample counts only. The remaining images are
+ * placed by plan() in device-local blocks.
+ */
+void TransientAttachments::bind() {
+  const vk::MemoryPropertyFlags lazyProperties =
+      vk::MemoryPropertyFlagBits::eDeviceLocal |
+      vk::MemoryPropertyFlagBits::eLazilyAllocated;
+
+  std::vector<Request> shared;
+  std::vector<size_t> sharedEntries;
+  for (size_t i = 0; i < entries.size(); i++) {
+    Entry &entry = entries[i];
+    if (lazy &&
+        allocator.hasMemoryType(entry.request.memoryTypeBits, lazyProperties)) {
+      entry.lazyMemory = allocator.allocate(
+          *entry.image, vk::ImageTiling::eOptimal, lazyProperties,
+          GpuAllocator::Category::eAttachment);
+    } else {
+      shared.push_back(entry.request);
+      sharedEntries.push_back(i);
+    }
+  }
+
+  const Plan layout = plan(shared);
+  for (const vk::MemoryRequirements &block : layout.blocks) {
+    blocks.push_back(
+        allocator.allocate(block, vk::MemoryPropertyFlagBits::eDeviceLocal,
+                           GpuAllocator::Category::eAttachment));
+  }
+  for (size_t i = 0; i < sharedEntries.size(); i++) {
+    const Placement &placement = layout.placements[i];
+    const GpuAllocation &block = blocks[placement.block];
+    entries[sharedEntries[i]].image->bindMemory(
+        block.memory(), block.offset() + placement.offset);
+  }
+}
+
+void TransientAttachments::reset() {
+  entries.clear();
+  blocks.clear();
+}
+
+/**
+ * @details committedBytes is what vkGetDeviceMemoryCommitment reports for
+ * the lazily allocated memory objects, capped at lazyBytes since a memory
+ * object may be a block shared with other resources.
+ */
+TransientAttachments::Footprint TransientAttachments::footprint() const {
+  Footprint result;
+  std::vector<vk::DeviceMemory> lazyMemories;
+  for (const Entry &entry : entries) {
+    result.attachments++;
+    result.separateBytes += entry.request.size;
+    if (entry.lazyMemory) {
+      result.lazyBytes += entry.lazyMemory.size();
+      if (std::find(lazyMemories.begin(), lazyMemories.end(),
+                    entry.lazyMemory.memory()) == lazyMemories.end()) {
+        lazyMemories.push_back(entry.lazyMemory.memory());
+      }
+    }
+  }
+  for (vk::DeviceMemory memory : lazyMemories) {
+    VkDeviceSize committed = 0;
+    device.getDispatcher()->vkGetDeviceMemoryCommitment(
+        static_cast<VkDevice>(*device), static_cast<VkDeviceMemory>(memory),
+        &committed);
+    result.committedBytes += committed;
+  }
+  result.committedBytes = std::min(result.committedBytes, result.lazyBytes);
+  for (const GpuAllocation &block : blocks) {
+    result.aliasedBytes += block.size();
+  }
+  result.aliasedBlocks = blocks.size();
+  return result;
+}
@@ -0,0 +1,310 @@
+/**
+ * @file UploadQueue.cpp
+ * @brief Batched staging copies on a transfer queue, with queue family
+ *        ownership transfers to the graphics queue.
+ *
+ * @see UploadQueue.hpp
+ */
+#include "../include/UploadQueue.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+/**
+ * @struct UploadQueue::Batch
+ * @brief Copies submitted together, and what they read.
+ */
+struct UploadQueue::Batch {
+  vk::raii::CommandBuffer commandBuffer = nullptr;      ///< Recorded copies
+  uint64_t value = 0;                                   ///< Signaled when done
+  std::vector<StagingPool::Range> ranges;               ///< Staging read
+  std::vector<std::shared_ptr<void>> objects;           ///< From keepAlive()
+  std::vector<vk::BufferMemoryBarrier2> bufferReleases; ///< After the copies
+  std::vector<vk::ImageMemoryBarrier2> imageReleases;   ///< After the copies
+  Acquires acquires;                                    ///< For acquire()
+};
+
+UploadQueue::UploadQueue(const vk::raii::Device &logicalDevice,
+                         StagingPool &stagingPool,
+                         uint32_t transferQueueFamily,
+                         uint32_t graphicsQueueFamily)
+    : device(logicalDevice), staging(stagingPool),
+      transferFamily(transferQueueFamily),
+      graphicsFamily(graphicsQueueFamily),
+      queue(logicalDevice, transferQueueFamily, 0) {
+  vk::CommandPoolCreateInfo poolInfo{};
+  poolInfo.flags = vk::CommandPoolCreateFlagBits::eResetCommandBuffer |
+                   vk::CommandPoolCreateFlagBits::eTransient;
+  poolInfo.queueFamilyIndex = transferFamily;
+  commandPool = vk::raii::CommandPool(device, poolInfo);
+
+  vk::SemaphoreTypeCreateInfo typeInfo{};
+  typeInfo.semaphoreType = vk::SemaphoreType::eTimeline;
+  typeInfo.initialValue = 0;
+  vk::SemaphoreCreateInfo semaphoreInfo{};
+  semaphoreInfo.pNext = &typeInfo;
+  timeline = vk::raii::Semaphore(device, semaphoreInfo);
+}
+
+/**
+ * @details A batch recorded but never submitted is dropped along with the
+ * submitted ones; the GPU never saw it.
+ */
+UploadQueue::~UploadQueue() {
+  for (const std::unique_ptr<Batch> &batch : submitted) {
+    for (const StagingPool::Range &range : batch->ranges) {
+      staging.release(range);
+    }
+  }
+  if (current) {
+    for (const StagingPool::Range &range : current->ranges) {
+      staging.release(range);
+    }
+  }
+}
+
+UploadQueue::Batch &UploadQueue::recording() {
+  if (current) {
+    return *current;
+  }
+  current = std::make_unique<Batch>();
+  if (freeCommandBuffers.empty()) {
+    vk::CommandBufferAllocateInfo allocInfo{};
+    allocInfo.commandPool = *commandPool;
+    allocInfo.level = vk::CommandBufferLevel::ePrimary;
+    allocInfo.commandBufferCount = 1;
+    current->commandBuffer =
+        std::move(vk::raii::CommandBuffers(device, allocInfo).front());
+  } else {
+    current->commandBuffer = std::move(freeCommandBuffers.back());
+    freeCommandBuffers.pop_back();
+  }
+  current->commandBuffer.begin(vk::CommandBufferBeginInfo{
+      vk::CommandBufferUsageFlagBits::eOneTimeSubmit});
+  return *current;
+}
+
+void UploadQueue::keep(Batch &batch, std::shared_ptr<void> object) {
+  batch.objects.push_back(std::move(object));
+}
+
+/**
+ * @details The range is released from the transfer family right after the
+ * batch's copies; its previous contents are not read, so the transfer queue
+ * writes it without acquiring it first (a freshly allocated range of a
+ * buffer the graphics queue reads elsewhere, like the geometry arena).
+ */
+uint64_t UploadQueue::copy(const StagingPool::Range &source,
+                           vk::Buffer buffer, vk::DeviceSize offset,
+                           vk::PipelineStageFlags2 stages,
+                           vk::AccessFlags2 access) {
+  Batch &batch = recording();
+  batch.commandBuffer.copyBuffer(
+      source.buffer, buffer,
+      vk::BufferCopy(source.offset, offset, source.size));
+  batch.ranges.push_back(source);
+  batch.acquires.stages |= stages;
+  totals.copies++;
+  totals.bytes += source.size;
+
+  if (!dedicated()) {
+    return lastValue + 1; // The semaphore alone orders and publishes it
+  }
+  vk::BufferMemoryBarrier2 release{};
+  release.srcStageMask = vk::PipelineStageFlagBits2::eTransfer;
+  release.srcAccessMask = vk::AccessFlagBits2::eTransferWrite;
+  release.srcQueueFamilyIndex = transferFamily;
+  release.dstQueueFamilyIndex = graphicsFamily;
+  release.buffer = buffer;
+  release.offset = offset;
+  release.size = source.size;
+  batch.bufferReleases.push_back(release);
+
+  vk::BufferMemoryBarrier2 acquire = release;
+  acquire.srcStageMask = vk::PipelineStageFlagBits2::eAllCommands;
+  acquire.srcAccessMask = {};
+  acquire.dstStageMask = stages;
+  acquire.dstAccessMask = access;
+  batch.acquires.buffers.push_back(acquire);
+  return lastValue + 1;
+}
+
+/**
+ * @details The image goes Undefined -> eTransferDstOptimal before the copy
+ * and eTransferDstOptimal -> eShaderReadOnlyOptimal after it. With a
+ * dedicated transfer family the second transition is the ownership
+ * release, and acquire() repeats it on the graphics queue.
+ */
+uint64_t UploadQueue::copy(const StagingPool::Range &source, vk::Image image,
+                           std::span<const vk::BufferImageCopy> regions,
+                           uint32_t levelCount,
+                           vk::PipelineStageFlags2 stages,
+                           vk::AccessFlags2 access) {
+  Batch &batch = recording();
+  const vk::ImageSubresourceRange range{vk::ImageAspectFlagBits::eColor, 0,
+                                        levelCount, 0, 1};
+
+  vk::ImageMemoryBarrier2 toTransfer{};
+  toTransfer.dstStageMask = vk::PipelineStageFlagBits2::eTransfer;
+  toTransfer.dstAccessMask = vk::AccessFlagBits2::eTransferWrite;
+  toTransfer.oldLayout = vk::ImageLayout::eUndefined;
+  toTransfer.newLayout = vk::ImageLayout::eTransferDstOptimal;
+  toTransfer.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+  toTransfer.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+  toTransfer.image = image;
+  toTransfer.subresourceRange = range;
+  vk::DependencyInfo dependency{};
+  dependency.imageMemoryBarrierCount = 1;
+  dependency.pImageMemoryBarriers = &toTransfer;
+  batch.commandBuffer.pipelineBarrier2(dependency);
+
+  batch.commandBuffer.copyBufferToImage(
+      source.buffer, image, vk::ImageLayout::eTransferDstOptimal,
+      vk::ArrayProxy<const vk::BufferImageCopy>(
+          static_cast<uint32_t>(regions.size()), regions.data()));
+  batch.ranges.push_back(source);
+  batch.acquires.stages |= stages;
+  totals.copies++;
+  totals.bytes += source.size;
+
+  vk::ImageMemoryBarrier2 release = toTransfer;
+  release.srcStageMask = vk::PipelineStageFlagBits2::eTransfer;
+  release.srcAccessMask = vk::AccessFlagBits2::eTransferWrite;
+  release.dstStageMask = vk::PipelineStageFlagBits2::eAllCommands;
+  release.dstAccessMask = {};
+  release.oldLayout = vk::ImageLayout::eTransferDstOptimal;
+  release.newLayout = vk::ImageLayout::eShaderReadOnlyOptimal;
+  if (dedicated()) {
+    release.dstStageMask = vk::PipelineStageFlagBits2::eNone;
+    release.srcQueueFamilyIndex = transferFamily;
+    release.dstQueueFamilyIndex = graphicsFamily;
+
+    vk::ImageMemoryBarrier2 acquire = release;
+    acquire.srcStageMask = vk::PipelineStageFlagBits2::eAllCommands;
+    acquire.srcAccessMask = {};
+    acquire.dstStageMask = stages;
+    acquire.dstAccessMask = access;
+    batch.acquires.images.push_back(acquire);
+  }
+  batch.imageReleases.push_back(release);
+  return lastValue + 1;
+}
+
+/**
+ * @details The release barriers (or, sharing the graphics family, the
+ * final layout transitions) of every copy go into one barrier at the end
+ * of the batch.
+ */
+uint64_t UploadQueue::submit() {
+  if (!current) {
+    return lastValue;
+  }
+  std::unique_ptr<Batch> batch = std::move(current);
+  if (!batch->bufferReleases.empty() || !batch->imageReleases.empty()) {
+    vk::DependencyInfo dependency{};
+    dependency.bufferMemoryBarrierCount =
+        static_cast<uint32_t>(batch->bufferReleases.size());
+    dependency.pBufferMemoryBarriers = batch->bufferReleases.data();
+    dependency.imageMemoryBarrierCount =
+        static_cast<uint32_t>(batch->imageReleases.size());
+    dependency.pImageMemoryBarriers = batch->imageReleases.data();
+    batch->commandBuffer.pipelineBarrier2(dependency);
+  }
+  batch->commandBuffer.end();
+
+  batch->value = lastValue + 1;
+  vk::TimelineSemaphoreSubmitInfo timelineInfo{};
+  timelineInfo.signalSemaphoreValueCount = 1;
+  timelineInfo.pSignalSemaphoreValues = &batch->value;
+  vk::SubmitInfo submitInfo{};
+  submitInfo.pNext = &timelineInfo;
+  submitInfo.commandBufferCount = 1;
+  submitInfo.pCommandBuffers = &*batch->commandBuffer;
+  submitInfo.signalSemaphoreCount = 1;
+  submitInfo.pSignalSemaphores = &*timeline;
+  queue.submit(submitInfo, nullptr);
+  lastValue = batch->value;
+  totals.batches++;
+
+  batch->acquires.value = batch->value;
+  unacquired.push_back(std::move(batch->acquires));
+  submitted.push_back(std::move(batch));
+  return lastValue;
+}
+
+/**
+ * @details Every acquire barrier is recorded exactly once, in the first
+ * command buffer that needs its batch (or runs after the batch completed);
+ * that submission waits for the batch, and later submissions to the
+ * graphics queue are ordered after the barrier. Batches are acquired in
+ * submission order, so a needed batch takes the older ones along.
+ */
+UploadQueue::Wait
+UploadQueue::acquire(const vk::raii::CommandBuffer &commandBuffer,
+                     uint64_t needed) {
+  const uint64_t last = std::max(needed, collectedValue);
+  Wait wait;
+  while (!unacquired.empty() && unacquired.front().value <= last) {
+    Acquires &batch = unacquired.front();
+    bufferAcquires.insert(bufferAcquires.end(), batch.buffers.begin(),
+                          batch.buffers.end());
+    imageAcquires.insert(imageAcquires.end(), batch.images.begin(),
+                         batch.images.end());
+    wait.value = batch.value;
+    wait.stages |= batch.stages;
+    unacquired.pop_front();
+  }
+  if (!bufferAcquires.empty() || !imageAcquires.empty()) {
+    vk::DependencyInfo dependency{};
+    dependency.bufferMemoryBarrierCount =
+        static_cast<uint32_t>(bufferAcquires.size());
+    dependency.pBufferMemoryBarriers = bufferAcquires.data();
+    dependency.imageMemoryBarrierCount =
+        static_cast<uint32_t>(imageAcquires.size());
+    dependency.pImageMemoryBarriers = imageAcquires.data();
+    commandBuffer.pipelineBarrier2(dependency);
+    bufferAcquires.clear();
+    imageAcquires.clear();
+  }
+  if (wait.value > collectedValue) {
+    totals.acquires++;
+  }
+  return wait;
+}
+
+uint64_t UploadQueue::completed() const { return timeline.getCounterValue(); }
+
+void UploadQueue::wait(uint64_t value) const {
+  vk::SemaphoreWaitInfo waitInfo{};
+  waitInfo.semaphoreCount = 1;
+  waitInfo.pSemaphores = &*timeline;
+  waitInfo.pValues = &value;
+  if (device.waitSemaphores(waitInfo, UINT64_MAX) != vk::Result::eSuccess) {
+    throw std::runtime_error("Upload queue wait failed");
+  }
+}
+
+void UploadQueue::collect() {
+  if (submitted.empty()) {
+    collectedValue = lastValue;
+    return;
+  }
+  const uint64_t done = completed();
+  collectedValue = done;
+  while (!submitted.empty() && submitted.front()->value <= done) {
+    Batch &batch = *submitted.front();
+    for (const StagingPool::Range &range : batch.ranges) {
+      staging.release(range); // The copies have completed
+    }
+    batch.objects.clear();
+    batch.commandBuffer.reset();
+    freeCommandBuffers.push_back(std::move(batch.commandBuffer));
+    submitted.pop_front();
+  }
+}
+
+UploadQueue::Stats UploadQueue::stats() const {
+  Stats result = totals;
+  result.pendingBatches = submitted.size();
+  return result;
+}
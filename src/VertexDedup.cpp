@@ -0,0 +1,247 @@
+/**
+ * @file VertexDedup.cpp
+ * @brief Flat hash table and serial/sharded vertex deduplication.
+ *
+ * @see VertexDedup.hpp
+ */
+#include "../include/VertexDedup.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <limits>
+#include <stdexcept>
+
+namespace vertexdedup {
+
+namespace {
+
+/** @brief Number of hash shards in the parallel mode (power of two). */
+constexpr size_t kShardBits = 6;
+constexpr size_t kShardCount = size_t(1) << kShardBits;
+
+/** @brief Corners per slice for the parallel counting/scatter passes. */
+constexpr size_t kSliceSize = 64 * 1024;
+
+/** @brief Shard of a hash: its top bits (slot index uses the low bits). */
+inline size_t shardOf(uint64_t hash) { return hash >> (64 - kShardBits); }
+
+/** @brief Throws if corner ids would not fit in the 32-bit id space. */
+void checkCornerCount(size_t count) {
+  if (count >= std::numeric_limits<uint32_t>::max()) {
+    throw std::runtime_error("Mesh has too many corners for 32-bit indices");
+  }
+}
+
+} // namespace
+
+/**
+ * @brief Allocates a table with room for 'expectedUnique' ids at load 1/2.
+ */
+DedupTable::DedupTable(size_t expectedUnique) {
+  size_t capacity = std::bit_ceil(std::max<size_t>(16, expectedUnique * 2));
+  slots.assign(capacity, Slot{0, kEmpty});
+  mask = capacity - 1;
+}
+
+/**
+ * @brief Finds the id of an equal vertex or inserts 'candidate'.
+ *
+ * @details
+ * Linear probing from 'hash & mask'. Each slot carries the upper 32 hash
+ * bits, so the full bit-pattern compare against 'keys[id]' only runs on a
+ * (near-certain) match. Insertion happens in the first empty slot reached
+ * by the same probe, so each call walks the probe sequence exactly once.
+ */
+std::pair<uint32_t, bool>
+DedupTable::findOrInsert(const vertexhash::Bits &bits, uint64_t hash,
+                         uint32_t candidate, const Vertex *keys) {
+  if ((count + 1) * 2 > slots.size()) {
+    rehash(slots.size() * 2, keys);
+  }
+
+  const uint32_t tag = static_cast<uint32_t>(hash >> 32);
+  for (size_t i = hash & mask;; i = (i + 1) & mask) {
+    Slot &slot = slots[i];
+    if (slot.id == kEmpty) {
+      slot = Slot{tag, candidate};
+      count++;
+      return {candidate, true};
+    }
+    if (slot.tag == tag && vertexhash::canonicalBits(keys[slot.id]) == bits) {
+      return {slot.id, false};
+    }
+  }
+}
+
+/**
+ * @brief Grows the table, recomputing hashes from the key array.
+ */
+void DedupTable::rehash(size_t capacity, const Vertex *keys) {
+  std::vector<Slot> old = std::move(slots);
+  slots.assign(capacity, Slot{0, kEmpty});
+  mask = capacity - 1;
+
+  for (const Slot &entry : old) {
+    if (entry.id == kEmpty) {
+      continue;
+    }
+    uint64_t hash = vertexhash::hash(keys[entry.id]);
+    size_t i = hash & mask;
+    while (slots[i].id != kEmpty) {
+      i = (i + 1) & mask;
+    }
+    slots[i] = entry;
+  }
+}
+
+/**
+ * @brief Serial first-occurrence deduplication.
+ *
+ * @param corners Per-corner vertices.
+ * @param mesh Output mesh (vertices and indices replaced).
+ *
+ * @details Ids index 'mesh.vertices' directly, so the table never stores a
+ * copy of a vertex. The initial size assumes ~4 corners per unique vertex,
+ * which is slightly conservative for closed triangle meshes (~6).
+ */
+void deduplicate(std::span<const Vertex> corners, MeshData &mesh) {
+  checkCornerCount(corners.size());
+
+  mesh.vertices.clear();
+  mesh.indices.clear();
+  mesh.indices.reserve(corners.size());
+
+  DedupTable table(corners.size() / 4);
+  for (const Vertex &vertex : corners) {
+    const vertexhash::Bits bits = vertexhash::canonicalBits(vertex);
+    auto [id, inserted] =
+        table.findOrInsert(bits, vertexhash::hash(bits),
+                           static_cast<uint32_t>(mesh.vertices.size()),
+                           mesh.vertices.data());
+    if (inserted) {
+      mesh.vertices.push_back(vertex);
+    }
+    mesh.indices.push_back(id);
+  }
+}
+
+/**
+ * @brief Sharded parallel first-occurrence deduplication.
+ *
+ * @param corners Per-corner vertices.
+ * @param mesh Output mesh (vertices and indices replaced).
+ * @param pool Worker pool.
+ *
+ * @details
+ * Equal vertices always have equal hashes, hence land in the same shard, so
+ * shards can be deduplicated independently. Order is preserved throughout:
+ * 1. **Partition** (parallel): per-slice shard histograms, prefix sums, then
+ *    a stable scatter of corner ids into shard-contiguous order.
+ * 2. **Dedup** (parallel per shard): a DedupTable keyed by corner id maps
+ *    every corner to the *first* corner holding the same vertex.
+ * 3. **Compact** (parallel): corners that are their own first occurrence
+ *    become unique vertices, numbered by an exclusive prefix sum in corner
+ *    order, which is exactly the order the serial loop assigns.
+ * 4. **Remap** (parallel): each index is the new id of its first corner.
+ */
+void deduplicateParallel(std::span<const Vertex> corners, MeshData &mesh,
+                         ThreadPool &pool) {
+  checkCornerCount(corners.size());
+  const size_t cornerCount = corners.size();
+  const size_t sliceCount = std::max<size_t>(1, (cornerCount + kSliceSize - 1) /
+                                                    kSliceSize);
+  auto sliceRange = [&](size_t slice) {
+    return std::pair<size_t, size_t>(
+        slice * kSliceSize, std::min(cornerCount, (slice + 1) * kSliceSize));
+  };
+
+  // 1. Stable partition of corner ids by shard
+  std::vector<size_t> histogram(sliceCount * kShardCount, 0);
+  pool.parallelFor(sliceCount, [&](size_t slice) {
+    auto [begin, end] = sliceRange(slice);
+    size_t *counts = &histogram[slice * kShardCount];
+    for (size_t c = begin; c < end; c++) {
+      counts[shardOf(vertexhash::hash(corners[c]))]++;
+    }
+  });
+
+  std::vector<size_t> shardBegin(kShardCount + 1, 0);
+  size_t running = 0;
+  for (size_t shard = 0; shard < kShardCount; shard++) {
+    shardBegin[shard] = running;
+    for (size_t slice = 0; slice < sliceCount; slice++) {
+      size_t &entry = histogram[slice * kShardCount + shard];
+      size_t sliceShardCount = entry;
+      entry = running; // Becomes this slice's write cursor for the shard
+      running += sliceShardCount;
+    }
+  }
+  shardBegin[kShardCount] = running;
+
+  std::vector<uint32_t> order(cornerCount);
+  pool.parallelFor(sliceCount, [&](size_t slice) {
+    auto [begin, end] = sliceRange(slice);
+    size_t *cursor = &histogram[slice * kShardCount];
+    for (size_t c = begin; c < end; c++) {
+      order[cursor[shardOf(vertexhash::hash(corners[c]))]++] =
+          static_cast<uint32_t>(c);
+    }
+  });
+
+  // 2. Per-shard tables map each corner to its first equal corner
+  std::vector<uint32_t> firstCorner(cornerCount);
+  pool.parallelFor(kShardCount, [&](size_t shard) {
+    const size_t begin = shardBegin[shard], end = shardBegin[shard + 1];
+    DedupTable table((end - begin) / 4);
+    for (size_t i = begin; i < end; i++) {
+      const uint32_t c = order[i];
+      const vertexhash::Bits bits = vertexhash::canonicalBits(corners[c]);
+      firstCorner[c] =
+          table.findOrInsert(bits, vertexhash::hash(bits), c, corners.data())
+              .first;
+    }
+  });
+
+  // 3. Number unique vertices in corner order ('order' is reused as the map
+  //    from a first corner to its new vertex id)
+  std::vector<size_t> sliceUnique(sliceCount, 0);
+  pool.parallelFor(sliceCount, [&](size_t slice) {
+    auto [begin, end] = sliceRange(slice);
+    size_t unique = 0;
+    for (size_t c = begin; c < end; c++) {
+      unique += firstCorner[c] == c;
+    }
+    sliceUnique[slice] = unique;
+  });
+
+  size_t uniqueCount = 0;
+  for (size_t &unique : sliceUnique) {
+    size_t sliceTotal = unique;
+    unique = uniqueCount;
+    uniqueCount += sliceTotal;
+  }
+
+  mesh.vertices.resize(uniqueCount);
+  std::vector<uint32_t> &newId = order;
+  pool.parallelFor(sliceCount, [&](size_t slice) {
+    auto [begin, end] = sliceRange(slice);
+    size_t next = sliceUnique[slice];
+    for (size_t c = begin; c < end; c++) {
+      if (firstCorner[c] == c) {
+        newId[c] = static_cast<uint32_t>(next);
+        mesh.vertices[next++] = corners[c];
+      }
+    }
+  });
+
+  // 4. Indices reference the new id of each corner's first occurrence
+  mesh.indices.resize(cornerCount);
+  pool.parallelFor(sliceCount, [&](size_t slice) {
+    auto [begin, end] = sliceRange(slice);
+    for (size_t c = begin; c < end; c++) {
+      mesh.indices[c] = newId[firstCorner[c]];
+    }
+  });
+}
+
+} // namespace vertexdedup
@@ -0,0 +1,195 @@
+/**
+ * @file VertexFormats.cpp
+ * @brief Half-float conversion and the layout selection behind
+ *        vertexformat::pack().
+ *
+ * @see VertexFormats.hpp
+ */
+#include "../include/VertexFormats.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+namespace vertexformat {
+
+/**
+ * @details
+ * Handles the full float range: values too large for half become infinity,
+ * values too small become (rounded) subnormals or zero, and NaN stays NaN.
+ * Rounding is to nearest, ties to even, like the F16C instructions.
+ */
+uint16_t floatToHalf(float value) {
+  const uint32_t bits = std::bit_cast<uint32_t>(value);
+  const uint16_t sign = static_cast<uint16_t>((bits >> 16) & 0x8000u);
+  const uint32_t absolute = bits & 0x7fffffffu;
+
+  if (absolute >= 0x7f800000u) { // Inf / NaN
+    return sign | 0x7c00u | (absolute > 0x7f800000u ? 0x200u : 0u);
+  }
+  if (absolute >= 0x477ff000u) { // Rounds to >= 65520: overflow to Inf
+    return sign | 0x7c00u;
+  }
+  if (absolute < 0x38800000u) { // Below the smallest normal half (2^-14)
+    if (absolute < 0x33000000u) { // Below half the smallest subnormal
+      return sign;
+    }
+    const uint32_t exponent = absolute >> 23;
+    const uint32_t mantissa = (absolute & 0x7fffffu) | 0x800000u;
+    const uint32_t shift = 126 - exponent; // 14..24
+    uint32_t half = mantissa >> shift;
+    const uint32_t remainder = mantissa & ((1u << shift) - 1);
+    const uint32_t halfway = 1u << (shift - 1);
+    if (remainder > halfway || (remainder == halfway && (half & 1u))) {
+      half++;
+    }
+    return sign | static_cast<uint16_t>(half);
+  }
+
+  // Normal range: rebias the exponent, round the mantissa to 10 bits
+  uint32_t half = (absolute - 0x38000000u) >> 13;
+  const uint32_t remainder = absolute & 0x1fffu;
+  if (remainder > 0x1000u || (remainder == 0x1000u && (half & 1u))) {
+    half++; // May carry into the exponent, which is still correct
+  }
+  return sign | static_cast<uint16_t>(half);
+}
+
+float halfToFloat(uint16_t value) {
+  const uint32_t sign = static_cast<uint32_t>(value & 0x8000u) << 16;
+  const uint32_t exponent = (value >> 10) & 0x1fu;
+  const uint32_t mantissa = value & 0x3ffu;
+
+  if (exponent == 0) { // Zero / subnormal: mantissa * 2^-24
+    const float magnitude = std::ldexp(static_cast<float>(mantissa), -24);
+    return sign ? -magnitude : magnitude;
+  }
+  if (exponent == 0x1f) { // Inf / NaN
+    return std::bit_cast<float>(sign | 0x7f800000u | (mantissa << 13));
+  }
+  return std::bit_cast<float>(sign | ((exponent + 112) << 23) |
+                              (mantissa << 13));
+}
+
+std::string name(Layout layout) {
+  switch (layout) {
+  case Layout::eColorFloatTexCoord:
+    return "unorm16 position, unorm8 color, float32 UV";
+  case Layout::eColorHalfTexCoord:
+    return "unorm16 position, unorm8 color, float16 UV";
+  case Layout::eColorUnormTexCoord:
+    return "unorm16 position, unorm8 color, unorm16 UV";
+  case Layout::eFloatTexCoord:
+    return "unorm16 position, float32 UV";
+  case Layout::eHalfTexCoord:
+    return "unorm16 position, float16 UV";
+  case Layout::eUnormTexCoord:
+    return "unorm16 position, unorm16 UV";
+  case Layout::eFloat:
+  default:
+    return "float32 position/color/UV";
+  }
+}
+
+glm::mat4 PackedVertices::positionTransform() const {
+  if (layout == Layout::eFloat) {
+    return glm::mat4(1.0f);
+  }
+  glm::mat4 transform(1.0f);
+  transform[0][0] = quantization.positionScale.x;
+  transform[1][1] = quantization.positionScale.y;
+  transform[2][2] = quantization.positionScale.z;
+  transform[3] = glm::vec4(quantization.positionOffset, 1.0f);
+  return transform;
+}
+
+/**
+ * @details
+ * Selection, each step measured on the actual data by round-tripping every
+ * vertex through the candidate encoding:
+ * 1. Positions: unorm16 over the bounding box, unless that exceeds
+ *    Options::maxPositionError (then everything stays float).
+ * 2. Color: dropped when identical for all vertices, unorm8 when within
+ *    Options::maxColorError, otherwise everything stays float.
+ * 3. Texture coordinates: unorm16 when all lie in [0, 1], float16 when
+ *    within Options::maxTexCoordError, otherwise float32.
+ */
+PackedVertices pack(std::span<const Vertex> vertices,
+                    const glm::vec3 &boundsMin, const glm::vec3 &boundsMax,
+                    const Options &options) {
+  PackedVertices packed;
+
+  Quantization &quantization = packed.quantization;
+  quantization.positionOffset = boundsMin;
+  // Flat axes get a unit scale so the division in the encoder stays finite
+  quantization.positionScale =
+      glm::max(boundsMax - boundsMin, glm::vec3(1e-20f));
+  if (!vertices.empty()) {
+    quantization.constantColor = vertices[0].color;
+  }
+
+  float positionError = 0.0f, colorError = 0.0f;
+  float halfError = 0.0f;
+  bool constantColor = true, unitTexCoords = true;
+  for (const Vertex &vertex : vertices) {
+    const glm::vec3 unit = (vertex.position - quantization.positionOffset) /
+                           quantization.positionScale;
+    const glm::vec3 decoded =
+        quantization.positionOffset +
+        glm::vec3(toUnorm16(unit.x), toUnorm16(unit.y), toUnorm16(unit.z)) /
+            65535.0f * quantization.positionScale;
+    positionError =
+        std::max(positionError, glm::length(decoded - vertex.position));
+
+    constantColor &= vertex.color == quantization.constantColor;
+    for (int c = 0; c < 3; c++) {
+      colorError = std::max(colorError,
+                            std::abs(toUnorm8(vertex.color[c]) / 255.0f -
+                                     vertex.color[c]));
+    }
+
+    for (int c = 0; c < 2; c++) {
+      const float uv = vertex.texCoord[c];
+      unitTexCoords &= uv >= 0.0f && uv <= 1.0f;
+      halfError =
+          std::max(halfError, std::abs(halfToFloat(floatToHalf(uv)) - uv));
+    }
+  }
+
+  const float diagonal = glm::length(boundsMax - boundsMin);
+  const bool quantize =
+      !options.forceFloat &&
+      positionError <= options.maxPositionError * diagonal &&
+      (constantColor || colorError <= options.maxColorError);
+
+  if (!quantize) {
+    packed.layout = Layout::eFloat;
+  } else {
+    // unorm16 error on [0, 1] is at most 1 / 131070
+    const bool unormTexCoord =
+        unitTexCoords && 0.5f / 65535.0f <= options.maxTexCoordError;
+    const bool halfTexCoord = halfError <= options.maxTexCoordError;
+    if (constantColor) {
+      packed.layout = unormTexCoord  ? Layout::eUnormTexCoord
+                      : halfTexCoord ? Layout::eHalfTexCoord
+                                     : Layout::eFloatTexCoord;
+    } else {
+      packed.layout = unormTexCoord  ? Layout::eColorUnormTexCoord
+                      : halfTexCoord ? Layout::eColorHalfTexCoord
+                                     : Layout::eColorFloatTexCoord;
+    }
+    packed.positionError = positionError;
+    packed.texCoordError = unormTexCoord  ? 0.5f / 65535.0f
+                           : halfTexCoord ? halfError
+                                          : 0.0f;
+  }
+
+  packed.stride = strideOf(packed.layout);
+  packed.data.resize(static_cast<size_t>(packed.stride) * vertices.size());
+  visit(packed.layout, [&]<typename L>(L) {
+    L::encode(vertices, quantization, packed.data.data());
+  });
+  return packed;
+}
+
+} // namespace vertexformat
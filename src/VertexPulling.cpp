@@ -0,0 +1,76 @@
+/**
+ * @file VertexPulling.cpp
+ * @brief Layout descriptors and push constants of shaders/vert_pull.glsl.
+ *
+ * @see VertexPulling.hpp
+ */
+#include "../include/VertexPulling.hpp"
+
+#include <stdexcept>
+#include <string>
+
+namespace vertexpull {
+
+/**
+ * @details Built from the layout's attribute descriptions, the same ones
+ * fixed-function vertex input would use, so the shader decodes exactly what
+ * vertexformat::pack() wrote.
+ */
+uint32_t describe(vertexformat::Layout layout) {
+  return vertexformat::visit(layout, []<typename L>(L) {
+    uint32_t position = kPositionFloat;
+    uint32_t color = kColorConstant;
+    uint32_t texCoord = kTexCoordFloat;
+    uint32_t colorOffset = 0;
+    uint32_t texCoordOffset = 0;
+    for (const vk::VertexInputAttributeDescription &attribute :
+         L::getAttributeDescriptions()) {
+      switch (attribute.format) {
+      case vk::Format::eR32G32B32Sfloat:
+        if (attribute.location == 0) {
+          position = kPositionFloat;
+        } else {
+          color = kColorFloat;
+          colorOffset = attribute.offset;
+        }
+        break;
+      case vk::Format::eR16G16B16A16Unorm:
+        position = kPositionUnorm16;
+        break;
+      case vk::Format::eR8G8B8A8Unorm:
+        color = kColorUnorm8;
+        colorOffset = attribute.offset;
+        break;
+      case vk::Format::eR32G32Sfloat:
+        texCoord = kTexCoordFloat;
+        texCoordOffset = attribute.offset;
+        break;
+      case vk::Format::eR16G16Unorm:
+        texCoord = kTexCoordUnorm16;
+        texCoordOffset = attribute.offset;
+        break;
+      case vk::Format::eR16G16Sfloat:
+        texCoord = kTexCoordHalf;
+        texCoordOffset = attribute.offset;
+        break;
+      default:
+        throw std::runtime_error("Vertex pulling: unsupported format " +
+                                 vk::to_string(attribute.format));
+      }
+    }
+    return position | (color << 2) | (texCoord << 4) | (colorOffset << 8) |
+           (texCoordOffset << 16) | (L::stride << 24);
+  });
+}
+
+PushConstants pushConstants(vk::DeviceAddress address,
+                            const vertexformat::PackedVertices &vertices) {
+  PushConstants constants;
+  constants.vertices = address;
+  constants.format = describe(vertices.layout);
+  constants.constantColor =
+      glm::vec4(vertices.quantization.constantColor, 1.0f);
+  return constants;
+}
+
+} // namespace vertexpull
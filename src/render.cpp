@@ -11,13 +11,6 @@
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb/stb_image.h>
 
-#define TINYOBJLOADER_IMPLEMENTATION
-#if __has_include(<tiny_obj_loader.h>)
-#include <tiny_obj_loader.h>
-#else
-#include "../external/tinyobjloader/tiny_obj_loader.h"
-#endif
-
 #include "../include/render.hpp"
 
 /**
@@ -34,6 +27,7 @@
  * @throws std::runtime_error if any Vulkan or GLFW initialization fails.
  */
 void VulkanRenderer::run() {
+  launchTime = std::chrono::high_resolution_clock::now();
   initWindow(); // Create GLFW window + surface
   initVulkan(); // Initialize Vulkan instance, device, swapchain, pipelines
   mainLoop();   // Enter rendering loop until window closes
@@ -123,91 +117,990 @@ vk::SampleCountFlagBits VulkanRenderer::getMaxUsableSampleCount() {
 }
 
 /**
- * @brief Loads a 3D model from an OBJ file into vertex and index buffers.
+ * @brief Loads the 3D model, preferring the binary mesh cache.
  *
  * @details
- * Uses TinyOBJLoader to parse the OBJ file.
- * The function:
- * - Reads vertex positions and texture coordinates
- * - Flips the Y-axis of texture coordinates to match Vulkan convention
- * - Assigns a default vertex color
- * - Builds a map of unique vertices to avoid duplicates
- * - Fills the 'vertices' and 'indices' vectors for use in Vulkan buffers
+ * Warm start: MODEL_CACHE_PATH is viewed in the asset pack, or memory
+ * mapped on its own, and validated against
+ * MODEL_PATH (size + mtime, falling back to a content hash). On success the
+ * vertex/index spans point straight into the mapping, so no OBJ parsing or
+ * vertex deduplication happens at all; vertices are packed straight from the
+ * mapping and createIndexBuffer() copies indices from the mapped file into
+ * staging memory.
+ *
+ * Cold start: the OBJ is read through 'fileReader' (io_uring, O_DIRECT),
+ * parsed on all cores and deduplicated via
+ * meshloader::loadObjParallel(), optionally optimized and given a LOD chain
+ * (GENERATE_LODS), then the result is written to MODEL_CACHE_PATH for the
+ * next launch. A failure to write the cache is reported but is not fatal.
+ *
+ * The time spent on either path is printed so cold and warm startups can be
+ * compared directly.
+ *
+ * Materials and their per-LOD index ranges come along with the mesh; a model
+ * without materials gets one white material textured with TEXTURE_PATH.
+ * Each distinct map_Kd other than TEXTURE_PATH becomes a MaterialTexture,
+ * decoded once the model is resident (decodeMaterialTextures()).
+ *
+ * Finally the vertices are packed into the smallest GPU vertex layout that
+ * stays within the vertexformat::Options error budgets (QUANTIZE_VERTICES),
+ * and the per-vertex savings are printed.
+ *
+ * Everything lands in the returned ModelState rather than the renderer, so
+ * a hot reload can rebuild the model while the previous one is drawn.
  *
  * @throws std::runtime_error If the OBJ file cannot be loaded or parsed.
  *
- * @note Vulkan expects a single contiguous vertex buffer and an index buffer
- * for drawing, which is why duplicate vertices are eliminated.
+ * @see meshcache::CachedMesh
+ * @see meshloader::loadObjParallel()
+ * @see meshopt::optimize()
+ * @see meshlod::buildLodChain()
  */
-void VulkanRenderer::loadModel() {
-  tinyobj::attrib_t attrib;
-  std::vector<tinyobj::shape_t> shapes;
-  std::vector<tinyobj::material_t> materials;
-  std::string warn, err;
+ModelState VulkanRenderer::buildModel() {
+  PROFILE_SCOPE("buildModel()");
+  ModelState state;
+  auto startTime = std::chrono::high_resolution_clock::now();
+
+  uint32_t cacheFlags = 0;
+  if (OPTIMIZE_MESH) {
+    cacheFlags |= meshcache::kFlagCacheOptimized;
+    if (OPTIMIZE_MESH_OVERDRAW) {
+      cacheFlags |= meshcache::kFlagOverdrawOptimized;
+    }
+  }
+  if (GENERATE_LODS) {
+    cacheFlags |= meshcache::kFlagLods;
+  }
 
-  // Parses OBJ file from disk
-  if (!LoadObj(&attrib, &shapes, &materials, &warn, &err, MODEL_PATH.c_str())) {
-    throw std::runtime_error(warn + err);
+  // Warm path: use the memory-mapped cache in place (from the pack if any)
+  state.cache = meshcache::CachedMesh::fromBytes(
+      packedAsset(MODEL_CACHE_PATH), MODEL_PATH, cacheFlags);
+  const bool fromPack = state.cache.has_value();
+  if (!state.cache) {
+    state.cache =
+        meshcache::CachedMesh::open(MODEL_CACHE_PATH, MODEL_PATH, cacheFlags);
+  }
+  if (state.cache) {
+    state.vertices = state.cache->vertices();
+    state.indices = state.cache->indices();
+    state.lods = state.cache->lods();
+    state.materials = state.cache->materials();
+    const std::span<const MeshSubmesh> submeshes = state.cache->submeshes();
+    state.submeshes.assign(submeshes.begin(), submeshes.end());
+    state.boundsMin = state.cache->boundsMin();
+    state.boundsMax = state.cache->boundsMax();
+  } else {
+    // Cold path: parse + deduplicate the OBJ, then persist the result
+    AsyncFileReader::Result text =
+        fileReader.wait(fileReader.submit(MODEL_PATH));
+    MeshData &mesh = state.mesh;
+    mesh = meshloader::loadObjParallel(
+        text.bytes(), std::filesystem::path(MODEL_PATH).parent_path().string());
+    if (OPTIMIZE_MESH) {
+      meshopt::Options options;
+      options.overdraw = OPTIMIZE_MESH_OVERDRAW;
+      meshopt::Report report = meshopt::optimize(mesh, options);
+      std::cout << "Mesh optimized: ACMR " << report.before.acmr << " -> "
+                << report.after.acmr << ", ATVR " << report.before.atvr
+                << " -> " << report.after.atvr << std::endl;
+    }
+    if (GENERATE_LODS) {
+      meshlod::Options options;
+      options.optimizeVertexCache = OPTIMIZE_MESH;
+      meshlod::buildLodChain(mesh, options);
+    }
+    try {
+      meshcache::write(MODEL_CACHE_PATH, MODEL_PATH, mesh, cacheFlags);
+    } catch (const std::exception &e) {
+      std::cerr << "Warning: " << e.what() << std::endl;
+    }
+    state.vertices = mesh.vertices;
+    state.indices = mesh.indices;
+    state.lods = mesh.lods;
+    state.materials = mesh.materials;
+    state.submeshes = mesh.submeshes;
+    state.boundsMin = mesh.boundsMin;
+    state.boundsMax = mesh.boundsMax;
   }
 
-  std::unordered_map<Vertex, uint32_t> uniqueVertices{}; // Avoid duplicates
+  double elapsedMs = std::chrono::duration<double, std::milli>(
+                         std::chrono::high_resolution_clock::now() - startTime)
+                         .count();
+  std::cout << (state.cache ? "Loaded mesh cache " : "Parsed OBJ ")
+            << (state.cache ? MODEL_CACHE_PATH : MODEL_PATH)
+            << (fromPack ? " (asset pack)" : "") << " in "
+            << elapsedMs << " ms (" << state.vertices.size() << " vertices, "
+            << state.indices.size() << " indices)" << std::endl;
+  for (size_t level = 0; level < state.lods.size(); level++) {
+    std::cout << "  LOD " << level << ": " << state.lods[level].indexCount / 3
+              << " triangles, error " << state.lods[level].error << std::endl;
+  }
 
-  // Iterate over meshes / faces
-  for (const auto &shape : shapes) {
-    for (const auto &index : shape.mesh.indices) {
+  // A model without materials is one white material per LOD, textured with
+  // TEXTURE_PATH
+  if (state.submeshes.empty()) {
+    MeshMaterial material;
+    material.diffuseTexture = TEXTURE_PATH;
+    state.materials = {material};
+    if (state.lods.empty()) {
+      state.submeshes.push_back(
+          {0, static_cast<uint32_t>(state.indices.size()), 0, 0});
+    }
+    for (uint32_t level = 0; level < state.lods.size(); level++) {
+      state.submeshes.push_back({state.lods[level].indexOffset,
+                                 state.lods[level].indexCount, 0, level});
+    }
+  }
+  const size_t lodCount = std::max<size_t>(1, state.lods.size());
+  state.lodSubmeshStart.assign(lodCount + 1, 0);
+  for (const MeshSubmesh &submesh : state.submeshes) {
+    state.lodSubmeshStart[submesh.lod + 1]++;
+  }
+  for (size_t level = 0; level < lodCount; level++) {
+    state.lodSubmeshStart[level + 1] += state.lodSubmeshStart[level];
+  }
 
-      Vertex vertex{};
-      // Extract vertex position from indexed OBJ arrays
-      vertex.position = {attrib.vertices[3 * index.vertex_index + 0],
-                         attrib.vertices[3 * index.vertex_index + 1],
-                         attrib.vertices[3 * index.vertex_index + 2]};
+  // Texture slot per material: TEXTURE_PATH (or no map_Kd) keeps the baked/
+  // streamed texture, every other path gets one MaterialTexture
+  const std::string mainTexture =
+      std::filesystem::path(TEXTURE_PATH).lexically_normal().generic_string();
+  for (const MeshMaterial &material : state.materials) {
+    uint32_t slot = 0;
+    if (!material.diffuseTexture.empty() &&
+        material.diffuseTexture != mainTexture) {
+      auto it = std::find(state.texturePaths.begin(), state.texturePaths.end(),
+                          material.diffuseTexture);
+      if (it == state.texturePaths.end()) {
+        state.texturePaths.push_back(material.diffuseTexture);
+        it = state.texturePaths.end() - 1;
+      }
+      slot = static_cast<uint32_t>(it - state.texturePaths.begin()) + 1;
+    }
+    state.textureSlots.push_back(slot);
+  }
+  std::cout << "  " << state.materials.size() << " materials, "
+            << state.submeshes.size() << " submeshes, "
+            << state.texturePaths.size() + 1 << " textures" << std::endl;
+
+  // Meshlets are cheap to build (one linear pass), so they are not cached
+  if (meshletCullingEnabled) {
+    state.meshlets = meshlet::buildForLods(state.indices, state.vertices,
+                                           state.lods, state.submeshes);
+    std::cout << "  " << state.meshlets.meshlets.size() << " meshlets ("
+              << state.meshlets.lodRanges[0].count << " in LOD 0)" << std::endl;
+  }
 
-      // Extract texture coordinates (flip Y axis for Vulkan)
-      vertex.texCoord = {attrib.texcoords[2 * index.texcoord_index + 0],
-                         1.0f - attrib.texcoords[2 * index.texcoord_index + 1]};
+  // Pick the GPU vertex layout now: createGraphicsPipeline() depends on it
+  vertexformat::Options formatOptions;
+  formatOptions.forceFloat = !QUANTIZE_VERTICES;
+  state.packedVertices = vertexformat::pack(state.vertices, state.boundsMin,
+                                            state.boundsMax, formatOptions);
+  const vertexformat::PackedVertices &packed = state.packedVertices;
+  const double savedBytes =
+      static_cast<double>(sizeof(Vertex) - packed.stride) *
+      state.vertices.size();
+  std::cout << "  Vertex layout: " << vertexformat::name(packed.layout)
+            << " (" << packed.stride << " B/vertex vs " << sizeof(Vertex)
+            << " B, " << savedBytes / (1024.0 * 1024.0)
+            << " MiB saved, max error: position " << packed.positionError
+            << ", UV " << packed.texCoordError << ")" << std::endl;
+  return state;
+}
 
-      vertex.color = {1.0f, 1.0f, 1.0f}; // Default white vertex color
+void VulkanRenderer::loadModel() { installModel(buildModel()); }
 
-      // Insert vertex if it's new, otherwise reuse its index
-      if (!uniqueVertices.contains(vertex)) {
-        uniqueVertices[vertex] = static_cast<uint32_t>(vertices.size());
-        vertices.push_back(vertex);
-      }
+/**
+ * @details The spans of 'state' view memory owned by its mesh or cache,
+ * which keeps its address when moved, so they stay valid in the members.
+ */
+void VulkanRenderer::installModel(ModelState state) {
+  model = std::move(state.mesh);
+  modelCache = std::move(state.cache);
+  modelVertices = state.vertices;
+  modelIndices = state.indices;
+  modelLods = state.lods;
+  modelMaterials = std::move(state.materials);
+  modelSubmeshes = std::move(state.submeshes);
+  lodSubmeshStart = std::move(state.lodSubmeshStart);
+  materialTextureSlots = std::move(state.textureSlots);
+  materialTextures.clear();
+  for (std::string &path : state.texturePaths) {
+    materialTextures.emplace_back().path = std::move(path);
+  }
+  modelBoundsMin = state.boundsMin;
+  modelBoundsMax = state.boundsMax;
+  packedVertices = std::move(state.packedVertices);
+  modelMeshlets = std::move(state.meshlets);
+}
+
+/**
+ * @brief Maps the asset pack, if one has been built.
+ *
+ * @details The pack is mapped once for the lifetime of the renderer: the
+ * mesh cache and baked texture are viewed in place, shader modules are
+ * created from it directly and stageBytes() may import its pages, so every
+ * span into it must stay valid until the device is idle.
+ */
+void VulkanRenderer::openAssetPack() {
+  assetPack = assetpack::AssetPack::open(ASSET_PACK_PATH);
+  if (!assetPack) {
+    return;
+  }
+  if (auto stamp = meshcache::stampFile(ASSET_PACK_PATH)) {
+    assetPackMtime = stamp->mtime;
+  }
+  std::cout << "Mapped asset pack " << ASSET_PACK_PATH << " ("
+            << assetPack->entries().size() << " blobs, "
+            << assetPack->bytes().size() << " bytes)" << std::endl;
+}
+
+/**
+ * @details A loose file newer than the pack wins, so rebuilding a shader or
+ * re-baking an asset takes effect without rebuilding the pack. Mesh caches
+ * and baked textures are additionally checked against their own sources by
+ * their loaders.
+ */
+std::span<const std::byte>
+VulkanRenderer::packedAsset(const std::string &path) const {
+  if (!assetPack) {
+    return {};
+  }
+  auto stamp = meshcache::stampFile(path);
+  if (stamp && stamp->mtime > assetPackMtime) {
+    return {};
+  }
+  return assetPack->blob(path);
+}
+
+/**
+ * @brief Starts loading the model and texture in the background.
+ *
+ * @details
+ * loadModel() (cache mapping or OBJ parse, LODs, meshlets, vertex packing)
+ * and decodeTexture() (baked texture mapping or PNG decode) are queued on the
+ * global ThreadPool. Nested parallelFor() calls inside them are safe, so the
+ * OBJ parser still uses every core. Neither task touches Vulkan; pollAssets()
+ * performs the GPU uploads on the main thread.
+ */
+void VulkanRenderer::startAssetLoads() {
+  ThreadPool &pool = ThreadPool::global();
+  modelFuture = pool.submit([this]() { loadModel(); });
+  textureFuture = pool.submit([this]() { decodeTexture(); });
+}
+
+/**
+ * @brief Uploads finished assets to the GPU.
+ *
+ * @details
+ * Called once per frame from drawFrame() (or once with 'wait' set when
+ * ASYNC_ASSET_LOADING is off). 'future.get()' rethrows loader exceptions
+ * and orders the loader's writes before the main thread's reads, after
+ * which the asset is marked resident:
+ * - Texture: staging upload of the baked mips (or level 0 + generated
+ *   mipmaps), or just the mip tail with TEXTURE_STREAMING, then each frame's
+ *   descriptor set is
+ *   switched from the placeholder in updateTextureDescriptor().
+ * - Model: graphics pipeline (built for the chosen vertex layout), vertex,
+ *   index and meshlet buffers; drawing starts with the next recorded frame.
+ *   uploadModel() queues the decode of the extra material textures.
+ * - Material textures: staging upload of each decoded mip chain; the
+ *   material descriptor sets switch over in updateTextureDescriptor().
+ *
+ * The staging copies are queued on 'uploadQueue' and submitted once later
+ * in drawFrame(). The host never waits for them: textures keep sampling the
+ * placeholder until their batch has completed, and only the frames drawing
+ * the model wait for its geometry on the GPU. What needs the graphics queue
+ * (the blitted mip chain) is recorded into 'loadBatch' and submitted and
+ * waited for once at the end.
+ *
+ * @param wait Block until every load has completed.
+ */
+void VulkanRenderer::pollAssets(bool wait) {
+  auto ready = [wait](const std::future<void> &future) {
+    return future.valid() &&
+           (wait || future.wait_for(std::chrono::seconds(0)) ==
+                        std::future_status::ready);
+  };
+  auto sinceLaunch = [this]() {
+    return std::chrono::duration<double, std::milli>(
+               std::chrono::high_resolution_clock::now() - launchTime)
+        .count();
+  };
+
+  if (ready(textureFuture)) {
+    textureFuture.get();
+    if (TEXTURE_STREAMING) {
+      startTextureStreaming(); // Tail only; updateTextureStreaming() adds more
+    } else {
+      createTextureImage();
+      createTextureImageView();
+    }
+    textureResident = true;
+    std::cout << "Texture resident after " << sinceLaunch() << " ms"
+              << std::endl;
+  }
+
+  if (ready(modelFuture)) {
+    modelFuture.get();
+    uploadModel();
+    modelResident = true;
+    std::cout << "Model resident after " << sinceLaunch() << " ms"
+              << std::endl;
+  }
+
+  if (ready(materialTextureFuture)) {
+    materialTextureFuture.get();
+    createMaterialTextureImages();
+    std::cout << "Material textures resident after " << sinceLaunch()
+              << " ms" << std::endl;
+  }
+
+  loadBatch->submit(); // Graphics queue work of every load above, at once
+}
+
+/**
+ * @brief Creates every GPU object that depends on the loaded model.
+ *
+ * @details A hot-reloaded model arrives with its graphics pipeline already
+ * built on the worker, so only the first upload creates one here. The
+ * material textures are decoded on the thread pool afterwards. With a
+ * multi-instance scene the camera is moved back to frame it.
+ */
+void VulkanRenderer::uploadModel() {
+  if (!*graphicsPipeline) {
+    createGraphicsPipeline(); // Built for the chosen vertex layout
+  }
+  allocateModelGeometry();        // Vertex/index ranges in the arena
+  createVertexBuffer();           // Upload vertices to GPU
+  createIndexBuffer();            // Upload indices to GPU
+  createMeshletBuffers();         // Meshlets + indirect draw/count buffers
+  createCullDescriptorSets();     // Cull pass bindings for those buffers
+  createMaterialDescriptorSets(); // Placeholder-bound until textures load
+
+  // Materials only change with the model, so each LOD's draw list is sorted
+  // once here instead of every frame
+  lodDrawLists.assign(lodSubmeshStart.size() - 1, {});
+  for (uint32_t i = 0; i < modelSubmeshes.size(); i++) {
+    const MeshSubmesh &submesh = modelSubmeshes[i];
+    lodDrawLists[submesh.lod].push_back(
+        {drawbatch::makeKey(0, materialTextureSlots[submesh.material],
+                            submesh.material),
+         i});
+  }
+  for (std::vector<drawbatch::DrawItem> &draws : lodDrawLists) {
+    drawbatch::sort(draws);
+  }
+
+  if (!materialTextures.empty()) {
+    materialTextureFuture =
+        ThreadPool::global().submit([this]() { decodeMaterialTextures(); });
+  }
+
+  // Back the camera off until the whole scene fits the 45-degree field of
+  // view, now that the model's size is known
+  if (sceneData.instances.size() > 1 && !LOD_DISTANCE_SWEEP) {
+    cameraDistance = std::max(
+        cameraDistance, scene::boundingRadius(sceneData.instances,
+                                              modelBoundsMin, modelBoundsMax) /
+                            std::sin(glm::radians(22.5f)));
+  }
+}
+
+/**
+ * @details Every read is submitted before the first decode, so the files
+ * stream in while earlier ones are decoded. A texture that cannot be read
+ * or decoded is reported and left empty; its materials keep sampling the
+ * placeholder (white, i.e. their diffuse color alone).
+ */
+void VulkanRenderer::decodeMaterialTextures() {
+  PROFILE_SCOPE("decodeMaterialTextures()");
+
+  std::vector<std::optional<AsyncFileReader::RequestId>> reads;
+  for (const MaterialTexture &texture : materialTextures) {
+    try {
+      reads.push_back(fileReader.submit(texture.path));
+    } catch (const std::exception &e) {
+      std::cerr << "Warning: " << e.what() << std::endl;
+      reads.push_back(std::nullopt);
+    }
+  }
+
+  for (size_t i = 0; i < materialTextures.size(); i++) {
+    if (!reads[i]) {
+      continue;
+    }
+    MaterialTexture &texture = materialTextures[i];
+    AsyncFileReader::Result file = fileReader.wait(*reads[i]);
+    int width, height, channels;
+    std::unique_ptr<stbi_uc, void (*)(void *)> pixels(
+        stbi_load_from_memory(
+            reinterpret_cast<const stbi_uc *>(file.buffer.data()),
+            static_cast<int>(file.size), &width, &height, &channels,
+            STBI_rgb_alpha),
+        stbi_image_free);
+    if (!pixels) {
+      std::cerr << "Warning: failed to decode " << texture.path << ": "
+                << stbi_failure_reason() << std::endl;
+      continue;
+    }
+
+    texture.levels = mipgen::layoutChain(static_cast<uint32_t>(width),
+                                         static_cast<uint32_t>(height));
+    texture.chain.resize(texture.levels.back().offset +
+                         texture.levels.back().size);
+    memcpy(texture.chain.data(), pixels.get(), texture.levels[0].size);
+    mipgen::generateChain(texture.chain.data(), texture.levels);
+  }
+}
+
+/**
+ * @details Same upload as the CPU_MIPMAPS path of createTextureImage(): the
+ * whole chain is staged at its mipgen offsets and copied with one region
+ * per level, on 'uploadQueue' (every texture in the same batch).
+ */
+void VulkanRenderer::createMaterialTextureImages() {
+  for (MaterialTexture &texture : materialTextures) {
+    if (texture.chain.empty()) {
+      continue;
+    }
+    const uint32_t levelCount = static_cast<uint32_t>(texture.levels.size());
+
+    const StagingPool::Range staging =
+        stagingPool->upload(std::as_bytes(std::span(texture.chain)));
+
+    createImage(texture.levels[0].width, texture.levels[0].height, levelCount,
+                vk::SampleCountFlagBits::e1, vk::Format::eR8G8B8A8Srgb,
+                vk::ImageTiling::eOptimal,
+                vk::ImageUsageFlagBits::eTransferDst |
+                    vk::ImageUsageFlagBits::eSampled,
+                vk::MemoryPropertyFlagBits::eDeviceLocal, texture.image,
+                texture.imageMemory);
+
+    std::vector<vk::BufferImageCopy> regions(levelCount);
+    for (uint32_t level = 0; level < levelCount; level++) {
+      regions[level].bufferOffset =
+          staging.offset + texture.levels[level].offset;
+      regions[level].imageSubresource = vk::ImageSubresourceLayers{
+          vk::ImageAspectFlagBits::eColor, level, 0, 1};
+      regions[level].imageExtent = vk::Extent3D{
+          texture.levels[level].width, texture.levels[level].height, 1};
+    }
+    texture.uploadValue =
+        uploadQueue->copy(staging, *texture.image, regions, levelCount);
+
+    texture.imageView = vkutils::createImageView(
+        device, texture.image, vk::Format::eR8G8B8A8Srgb,
+        vk::ImageAspectFlagBits::eColor, levelCount);
+    texture.chain.clear();
+    texture.chain.shrink_to_fit();
+  }
+}
+
+/**
+ * @brief Reports the asset streaming metrics once each.
+ *
+ * @details
+ * - Time to first frame: launch until the first present, whatever is on
+ *   screen (clear color and/or placeholder texture while loading).
+ * - Time to full quality: launch until the first present that draws the
+ *   model with the real texture (with TEXTURE_STREAMING, once every level
+ *   the current coverage wants is resident) and every material texture.
+ *
+ * Both are printed and published as ChronoProfiler counters, along with
+ * the bytes stageBytes() copied or imported up to full quality. The GPU
+ * allocator's footprint at full quality is printed too.
+ */
+void VulkanRenderer::reportLoadMetrics() {
+  if (firstFramePresented && fullQualityPresented) {
+    return;
+  }
+  double elapsedMs = std::chrono::duration<double, std::milli>(
+                         std::chrono::high_resolution_clock::now() - launchTime)
+                         .count();
+
+  if (!firstFramePresented) {
+    firstFramePresented = true;
+    std::cout << "Time to first frame: " << elapsedMs << " ms" << std::endl;
+    PROFILE_COUNTER("Time to first frame (ms)", elapsedMs);
+  }
+
+  const bool mipsResident =
+      !TEXTURE_STREAMING ||
+      textureResidency.residentMip <= textureResidency.desiredMip;
+  // Textures that failed to load stay on the placeholder for good
+  const bool materialsResident =
+      modelResident && !materialTextureFuture.valid() &&
+      std::all_of(materialTextures.begin(), materialTextures.end(),
+                  [this](const MaterialTexture &texture) {
+                    return !*texture.imageView ||
+                           texture.descriptorSetImageViews[currentFrame] ==
+                               *texture.imageView;
+                  });
+  if (modelResident && textureResident && mipsResident && materialsResident &&
+      descriptorSetImageViews[currentFrame] == *textureImageView) {
+    fullQualityPresented = true;
+    std::cout << "Time to full quality: " << elapsedMs << " ms" << std::endl;
+    PROFILE_COUNTER("Time to full quality (ms)", elapsedMs);
+    std::cout << "Staged uploads: " << stagedBytesCopied
+              << " bytes copied, " << stagedBytesImported
+              << " bytes imported from the asset pack" << std::endl;
+    PROFILE_COUNTER("Staged bytes copied", stagedBytesCopied);
+    PROFILE_COUNTER("Staged bytes imported", stagedBytesImported);
+
+    const GpuAllocator::Stats memory = allocator->stats();
+    std::cout << "GPU memory: " << memory.blockCount << " blocks ("
+              << memory.blockBytes / (1 << 20) << " MiB, "
+              << memory.usedBytes / (1 << 20) << " MiB used by "
+              << memory.allocationCount << " allocations), "
+              << memory.dedicatedCount << " dedicated ("
+              << memory.dedicatedBytes / (1 << 20) << " MiB)" << std::endl;
+  }
+}
+
+/**
+ * @details Published every frame, so the profiler shows the memory held by
+ * loads, hot reloads and texture streaming over time. 'fragmentation' is
+ * the share of free block memory outside the largest free range of its
+ * block (see GpuAllocator::stats()).
+ *
+ * The live bytes of each allocation category and every heap's usage and
+ * budget go to the "memory" category of the JSON export. Their names are
+ * built once and kept in 'memoryCounterNames', since the profiler only
+ * stores views of them. Updating 'memoryBudget' here also fires its
+ * threshold callback (onMemoryBudget()).
+ */
+void VulkanRenderer::reportMemoryStats() {
+  const GpuAllocator::Stats memory = allocator->stats();
+  PROFILE_COUNTER("GPU memory blocks", memory.blockCount);
+  PROFILE_COUNTER("GPU memory block bytes", memory.blockBytes);
+  PROFILE_COUNTER("GPU memory used bytes", memory.usedBytes);
+  PROFILE_COUNTER("GPU memory free bytes", memory.freeBytes);
+  PROFILE_COUNTER("GPU memory allocations", memory.allocationCount);
+  PROFILE_COUNTER("GPU memory dedicated", memory.dedicatedCount);
+  PROFILE_COUNTER("GPU memory dedicated bytes", memory.dedicatedBytes);
+  PROFILE_COUNTER("GPU memory fragmentation", memory.fragmentation);
+  PROFILE_COUNTER("Frame ring bytes", frameRing->used());
+  [[maybe_unused]] const StagingPool::Stats staging = stagingPool->stats();
+  PROFILE_COUNTER("Staging chunk bytes", staging.chunkBytes);
+  PROFILE_COUNTER("Staging used bytes", staging.usedBytes);
+  PROFILE_COUNTER("Staging live ranges", staging.liveRanges);
+  [[maybe_unused]] const UploadQueue::Stats uploads = uploadQueue->stats();
+  PROFILE_COUNTER("Upload batches", uploads.batches);
+  PROFILE_COUNTER("Upload bytes", uploads.bytes);
+  PROFILE_COUNTER("Upload frame waits", uploads.acquires);
+  PROFILE_COUNTER("Upload pending batches", uploads.pendingBatches);
+
+  memoryBudget->update(memory.heapBytes);
+  const std::vector<MemoryBudget::Heap> &heaps = memoryBudget->heaps();
+  if (memoryCounterNames.empty()) {
+    for (size_t i = 0; i < GpuAllocator::kCategoryCount; i++) {
+      memoryCounterNames.push_back(
+          std::string("GPU memory ") +
+          GpuAllocator::categoryName(static_cast<GpuAllocator::Category>(i)) +
+          " bytes");
+    }
+    for (size_t i = 0; i < heaps.size(); i++) {
+      const std::string heap = "GPU heap " + std::to_string(i);
+      memoryCounterNames.push_back(heap + " usage bytes");
+      memoryCounterNames.push_back(heap + " budget bytes");
+    }
+  }
+
+  for (size_t i = 0; i < GpuAllocator::kCategoryCount; i++) {
+    PROFILE_COUNTER_CATEGORY(memoryCounterNames[i], memory.categoryBytes[i],
+                             "memory");
+  }
+  [[maybe_unused]] const std::string *heapNames =
+      memoryCounterNames.data() + GpuAllocator::kCategoryCount;
+  for (size_t i = 0; i < heaps.size(); i++) {
+    PROFILE_COUNTER_CATEGORY(heapNames[2 * i], heaps[i].usage, "memory");
+    PROFILE_COUNTER_CATEGORY(heapNames[2 * i + 1], heaps[i].budget, "memory");
+  }
+}
+
+/**
+ * @details Only video memory is acted upon; a host heap over budget is
+ * reported but left to the OS. While over the threshold the streamed
+ * texture may keep half of what it holds now, so texstream::nextStep()
+ * evicts at least its finest level on the next frame and streams nothing
+ * in. Once usage is back under the threshold (minus the hysteresis) the
+ * configured budget applies again and levels stream back in as needed.
+ */
+void VulkanRenderer::onMemoryBudget(uint32_t heapIndex,
+                                    const MemoryBudget::Heap &heap) {
+  if (!heap.deviceLocal) {
+    if (heap.overThreshold) {
+      std::cerr << "Warning: host memory heap " << heapIndex << " at "
+                << heap.usage / (1 << 20) << " of "
+                << heap.budget / (1 << 20) << " MiB budget" << std::endl;
+    }
+    return;
+  }
+  if (heap.overThreshold) {
+    textureStreamingBudget = textureResidency.residentBytes / 2;
+    std::cerr << "Warning: video memory heap " << heapIndex << " at "
+              << heap.usage / (1 << 20) << " of " << heap.budget / (1 << 20)
+              << " MiB budget, evicting streamed texture levels"
+              << std::endl;
+  } else {
+    textureStreamingBudget = TEXTURE_STREAMING_BUDGET;
+    std::cout << "Video memory heap " << heapIndex
+              << " back under budget threshold" << std::endl;
+  }
+}
+
+namespace {
+
+/** @brief SPIR-V modules of the graphics pipeline (every vertex variant). */
+const std::string kGraphicsShaders[] = {
+    "shaders/vert.spv", "shaders/vert_constcolor.spv",
+    "shaders/vert_pull.spv", "shaders/frag.spv"};
+
+/** @brief SPIR-V module of the cull pipeline. */
+const std::string kCullShader = "shaders/cull.spv";
+
+} // namespace
+
+/**
+ * @brief Registers the hot-reloadable files with the watcher.
+ *
+ * @details Every vertex shader variant is watched, since a reloaded model
+ * may switch between them. Called before the first loads finish, so edits
+ * made while loading are applied once everything is resident.
+ */
+void VulkanRenderer::watchAssets() {
+  if (!HOT_RELOAD) {
+    return;
+  }
+  assetWatcher.watch(MODEL_PATH);
+  assetWatcher.watch(TEXTURE_PATH);
+  for (const std::string &shader : kGraphicsShaders) {
+    assetWatcher.watch(shader);
+  }
+  assetWatcher.watch(kCullShader);
+  std::cout << "Hot reload: watching " << MODEL_PATH << ", " << TEXTURE_PATH
+            << " and shaders/*.spv (" << assetWatcher.backendName() << ")"
+            << std::endl;
+}
+
+/**
+ * @brief Applies file changes to the running renderer.
+ *
+ * @details
+ * Runs after this frame slot's fence wait and before anything of the frame
+ * is recorded, so whatever is swapped in here is what the frame draws with.
+ * Replaced objects go to 'retireQueue' tagged with this frame's number:
+ * frames recorded earlier may still use them, so they are destroyed
+ * MAX_FRAMES_IN_FLIGHT frames later instead of after a device.waitIdle().
+ *
+ * A finished reload waits for a frame in which its swap is safe:
+ * - Texture: no stream-in in flight (it reads the old levels).
+ * - Model: material textures decoded and the previous model's objects
+ *   destroyed (the descriptor pool has room for one retired generation of
+ *   cull sets).
+ *
+ * A reload that failed (parse error, invalid SPIR-V, unreadable file) is
+ * reported and the current assets stay in use.
+ *
+ * The latency from the change being reported to the swap and the swap's
+ * main-thread cost are printed and published as ChronoProfiler counters.
+ * Frame intervals over HOT_RELOAD_HITCH_MS while a reload is being built,
+ * and for MAX_FRAMES_IN_FLIGHT frames after its swap, count as hitches.
+ */
+void VulkanRenderer::updateHotReload() {
+  if (!HOT_RELOAD) {
+    return;
+  }
+  using Clock = std::chrono::steady_clock;
+  const Clock::time_point frameStart = Clock::now();
+  if (hotReload || hitchWatchFrames > 0) {
+    const double frameMs =
+        std::chrono::duration<double, std::milli>(frameStart - lastFrameStart)
+            .count();
+    if (frameMs > HOT_RELOAD_HITCH_MS) {
+      hotReloadHitches++;
+      std::cerr << "Warning: hot reload hitch, " << frameMs << " ms frame"
+                << std::endl;
+      PROFILE_COUNTER("Hot reload hitches", hotReloadHitches);
+    }
+    if (hitchWatchFrames > 0) {
+      hitchWatchFrames--;
+    }
+  }
+  lastFrameStart = frameStart;
+
+  for (std::string &path : assetWatcher.poll()) {
+    if (pendingReloadPaths.empty()) {
+      pendingReloadDetected = frameStart;
+    }
+    if (std::find(pendingReloadPaths.begin(), pendingReloadPaths.end(),
+                  path) == pendingReloadPaths.end()) {
+      pendingReloadPaths.push_back(std::move(path));
+    }
+  }
+
+  if (hotReload && hotReload->job.wait_for(std::chrono::seconds(0)) ==
+                       std::future_status::ready) {
+    HotReload &reload = *hotReload;
+    const bool texture = !reload.textureLayout.empty();
+    const bool model = reload.model.has_value();
+    const bool textureIdle =
+        textureShown && !textureStreamFuture.valid() && !*streamedImage;
+    const bool modelIdle =
+        !materialTextureFuture.valid() && retireQueue.empty();
+    if ((texture && !textureIdle) || (model && !modelIdle)) {
+      return; // Try again next frame
+    }
+
+    try {
+      reload.job.get();
+    } catch (const std::exception &e) {
+      std::cerr << "Warning: hot reload failed, keeping the current assets: "
+                << e.what() << std::endl;
+      hotReload.reset();
+      return;
+    }
 
-      // Push final vertex index
-      indices.push_back(uniqueVertices[vertex]);
+    const Clock::time_point swapStart = Clock::now();
+    if (model) {
+      swapReloadedModel(reload);
+    } else if (*reload.graphicsPipeline) {
+      retireQueue.retire(frameNumber, std::move(graphicsPipeline));
+      graphicsPipeline = std::move(reload.graphicsPipeline);
+    }
+    if (*reload.cullPipeline) {
+      retireQueue.retire(frameNumber, std::move(cullPipeline));
+      cullPipeline = std::move(reload.cullPipeline);
+    }
+    if (texture) {
+      swapReloadedTexture(reload);
     }
+    const Clock::time_point swapEnd = Clock::now();
+
+    const double latencyMs =
+        std::chrono::duration<double, std::milli>(swapEnd - reload.detected)
+            .count();
+    const double swapMs =
+        std::chrono::duration<double, std::milli>(swapEnd - swapStart)
+            .count();
+    std::cout << "Hot reloaded";
+    for (const std::string &path : reload.paths) {
+      std::cout << " " << path;
+    }
+    std::cout << ": " << latencyMs << " ms after the change, swap took "
+              << swapMs << " ms" << std::endl;
+    PROFILE_COUNTER("Hot reload latency (ms)", latencyMs);
+    PROFILE_COUNTER("Hot reload swap (ms)", swapMs);
+    hitchWatchFrames = MAX_FRAMES_IN_FLIGHT;
+    hotReload.reset();
   }
+
+  // One reload at a time, and only once the first loads have landed
+  if (!hotReload && !pendingReloadPaths.empty() && modelResident &&
+      textureResident) {
+    startHotReload();
+  }
+}
+
+/**
+ * @details The worker only creates new objects: the model from buildModel()
+ * plus a pipeline for its vertex layout, a pipeline for changed shaders, a
+ * cull pipeline and the texture's mip chain. Nothing the frames in flight
+ * use is touched until updateHotReload() swaps the results in.
+ */
+void VulkanRenderer::startHotReload() {
+  hotReload = std::make_unique<HotReload>();
+  HotReload &reload = *hotReload;
+  reload.paths = std::move(pendingReloadPaths);
+  reload.detected = pendingReloadDetected;
+  pendingReloadPaths.clear();
+
+  auto changed = [&reload](const std::string &path) {
+    return std::find(reload.paths.begin(), reload.paths.end(), path) !=
+           reload.paths.end();
+  };
+  const bool model = changed(MODEL_PATH);
+  const bool graphicsShaders = std::any_of(
+      std::begin(kGraphicsShaders), std::end(kGraphicsShaders), changed);
+  const bool cullShader = meshletCullingEnabled && changed(kCullShader);
+  const bool texture = changed(TEXTURE_PATH);
+
+  reload.job = ThreadPool::global().submit(
+      [this, &reload, model, graphicsShaders, cullShader, texture]() {
+        if (model) {
+          reload.model = buildModel();
+          reload.graphicsPipeline =
+              buildGraphicsPipeline(reload.model->packedVertices);
+        } else if (graphicsShaders) {
+          reload.graphicsPipeline = buildGraphicsPipeline(packedVertices);
+        }
+        if (cullShader) {
+          reload.cullPipeline = buildCullPipeline();
+        }
+        if (texture) {
+          decodeReloadedTexture(reload);
+        }
+      });
 }
 
 /**
- * @brief Creates depth buffer resources for the framebuffer.
+ * @details Always decodes the PNG: a baked COMPRESSED_TEXTURE_PATH was made
+ * from the previous version. The whole chain is built, as decodeTexture()
+ * does for streaming, so any level can be uploaded or streamed later.
+ */
+void VulkanRenderer::decodeReloadedTexture(HotReload &reload) {
+  PROFILE_SCOPE("decodeReloadedTexture()");
+  AsyncFileReader::Result png =
+      fileReader.wait(fileReader.submit(TEXTURE_PATH));
+  int width, height, channels;
+  std::unique_ptr<stbi_uc, void (*)(void *)> pixels(
+      stbi_load_from_memory(
+          reinterpret_cast<const stbi_uc *>(png.buffer.data()),
+          static_cast<int>(png.size), &width, &height, &channels,
+          STBI_rgb_alpha),
+      stbi_image_free);
+  if (!pixels) {
+    throw std::runtime_error("failed to decode " + TEXTURE_PATH + ": " +
+                             stbi_failure_reason());
+  }
+
+  reload.textureLayout = mipgen::layoutChain(static_cast<uint32_t>(width),
+                                             static_cast<uint32_t>(height));
+  reload.textureChain.resize(reload.textureLayout.back().offset +
+                             reload.textureLayout.back().size);
+  memcpy(reload.textureChain.data(), pixels.get(),
+         reload.textureLayout[0].size);
+  mipgen::generateChain(reload.textureChain.data(), reload.textureLayout);
+}
+
+/**
+ * @details Everything recorded frames may reference is retired as one
+ * entry: the graphics pipeline, the cull descriptor sets, the model's
+ * geometry arena ranges, the meshlet buffer, the per-frame draw and counter
+ * buffers, and the material textures (with their descriptor sets) before the
+ * pool they were allocated from. The new model is then installed and
+ * uploaded like the first one: its copies are queued on 'uploadQueue' and
+ * the frames drawing it wait for them on the GPU, so nothing on the host
+ * waits.
+ */
+void VulkanRenderer::swapReloadedModel(HotReload &reload) {
+  retireQueue.retire(
+      frameNumber, std::move(graphicsPipeline), std::move(cullDescriptorSets),
+      std::move(modelGeometry), std::move(meshletBuffer),
+      std::move(meshletBufferMemory),
+      std::move(drawCommandBuffers), std::move(drawCommandBuffersMemory),
+      std::move(cullCounterBuffers), std::move(cullCounterBuffersMemory),
+      std::move(materialTextures), std::move(materialDescriptorPool));
+  cullCountersMapped.clear();
+
+  graphicsPipeline = std::move(reload.graphicsPipeline);
+  installModel(std::move(*reload.model));
+  uploadModel();
+  currentLod = 0; // The new model may have fewer LODs
+}
+
+/**
+ * @details
+ * The new image holds the whole chain, or with TEXTURE_STREAMING only the
+ * tail startTextureStreaming() would upload, after which streaming refines
+ * it as usual. Its staging range is filled now and the copy, with its
+ * layout transitions, is queued on 'uploadQueue'; the image is bound right
+ * away, so the frames sampling it wait for its batch on the GPU and nothing
+ * on the host waits.
+ *
+ * The old view, image and memory are retired: frames in flight may sample
+ * them until their descriptor sets are rewritten by
+ * updateTextureDescriptor().
+ */
+void VulkanRenderer::swapReloadedTexture(HotReload &reload) {
+  const std::span<const std::byte> chain = std::as_bytes(
+      std::span<const uint8_t>(reload.textureChain.data(),
+                               reload.textureChain.size()));
+  std::vector<texstream::Level> levels;
+  for (const mipgen::LevelLayout &level : reload.textureLayout) {
+    levels.push_back(
+        {level.width, level.height, chain.subspan(level.offset, level.size)});
+  }
+  const uint32_t mipCount = static_cast<uint32_t>(levels.size());
+  const uint32_t firstMip =
+      TEXTURE_STREAMING
+          ? texstream::initialMip(levels, TEXTURE_STREAMING_INITIAL_SIZE)
+          : 0;
+  const uint32_t levelCount = mipCount - firstMip;
+  const size_t firstOffset = reload.textureLayout[firstMip].offset;
+  const StagingPool::Range staging =
+      stagingPool->upload(chain.subspan(firstOffset));
+
+  vk::raii::Image image = nullptr;
+  GpuAllocation imageMemory = nullptr;
+  createImage(levels[firstMip].width, levels[firstMip].height, levelCount,
+              vk::SampleCountFlagBits::e1, vk::Format::eR8G8B8A8Srgb,
+              vk::ImageTiling::eOptimal,
+              vk::ImageUsageFlagBits::eTransferDst |
+                  vk::ImageUsageFlagBits::eSampled,
+              vk::MemoryPropertyFlagBits::eDeviceLocal, image, imageMemory);
+
+  std::vector<vk::BufferImageCopy> regions(levelCount);
+  for (uint32_t level = firstMip; level < mipCount; level++) {
+    vk::BufferImageCopy &region = regions[level - firstMip];
+    region.bufferOffset =
+        staging.offset + reload.textureLayout[level].offset - firstOffset;
+    region.imageSubresource = vk::ImageSubresourceLayers{
+        vk::ImageAspectFlagBits::eColor, level - firstMip, 0, 1};
+    region.imageExtent =
+        vk::Extent3D{levels[level].width, levels[level].height, 1};
+  }
+  textureUpload = uploadQueue->copy(staging, *image, regions, levelCount);
+
+  retireQueue.retire(frameNumber, std::move(textureImageView),
+                     std::move(textureImage), std::move(textureImageMemory));
+  textureImageView = vkutils::createImageView(
+      device, image, vk::Format::eR8G8B8A8Srgb,
+      vk::ImageAspectFlagBits::eColor, levelCount);
+  textureImage = std::move(image);
+  textureImageMemory = std::move(imageMemory);
+  mipLevels = levelCount;
+  textureFormat = vk::Format::eR8G8B8A8Srgb;
+  textureWidth = static_cast<int>(levels[0].width);
+  textureHeight = static_cast<int>(levels[0].height);
+
+  if (TEXTURE_STREAMING) {
+    // The level spans view the chain's heap block, which the move keeps
+    textureChain = std::move(reload.textureChain);
+    textureLevels = std::move(levels);
+    textureResidency.mipCount = mipCount;
+    textureResidency.residentMip = firstMip;
+    textureResidency.desiredMip = firstMip;
+    textureResidency.residentBytes =
+        texstream::chainBytes(textureLevels, firstMip);
+  }
+  compressedTexture.reset(); // Stale: baked from the previous version
+
+  // A recycled handle could match the old view; force every set to rewrite
+  std::fill(descriptorSetImageViews.begin(), descriptorSetImageViews.end(),
+            vk::ImageView{});
+}
+
+/**
+ * @brief Creates the depth buffer image for the framebuffer.
  *
  * @details
  * Depth testing ensures that fragments closer to the camera overwrite
  * farther fragments. This function:
  * - Finds a supported depth format
- * - Allocates an image with device-local memory
- * - Creates an image view for the depth attachment
+ * - Creates a transient image: depth is cleared at the start of the pass and
+ *   never stored, so it can live in lazily allocated or aliased memory
+ *
+ * Memory and the image view are created by bindTransientAttachments().
  *
  * @note Depth images are used in combination with a depth/stencil attachment
  * in the Vulkan render pass.
  */
 void VulkanRenderer::createDepthResources() {
-  vk::Format depthFormat = findDepthFormat(); // Pick supported depth format
-
-  // Create depth image (device local = GPU memory only)
-  createImage(swapChainExtent.width, swapChainExtent.height,
-              1,           // no mipmaps for depth images
-              msaaSamples, // match MSAA sample count
-              depthFormat, vk::ImageTiling::eOptimal,
-              vk::ImageUsageFlagBits::eDepthStencilAttachment,
-              vk::MemoryPropertyFlagBits::eDeviceLocal, depthImage,
-              depthImageMemory);
-
-  // Create an image view so shaders can access depth image
-  depthImageView = vkutils::createImageView(device, depthImage, depthFormat,
-                                            vk::ImageAspectFlagBits::eDepth, 1);
+  depthImage = createAttachmentImage(
+      findDepthFormat(), // Pick supported depth format
+      vk::ImageUsageFlagBits::eTransientAttachment |
+          vk::ImageUsageFlagBits::eDepthStencilAttachment);
 }
 
 /**
@@ -297,9 +1190,9 @@ bool VulkanRenderer::hasStencilComponent(vk::Format format) {
  * covering all mipmap levels.
  */
 void VulkanRenderer::createTextureImageView() {
-  // Create a standard RGBA image view for the texture, including all mip levels
+  // Create a color view in the uploaded format, including all mip levels
   textureImageView =
-      vkutils::createImageView(device, textureImage, vk::Format::eR8G8B8A8Srgb,
+      vkutils::createImageView(device, textureImage, textureFormat,
                                vk::ImageAspectFlagBits::eColor, mipLevels);
 }
 
@@ -333,7 +1226,7 @@ void VulkanRenderer::createTextureSampler() {
   samplerInfo.compareEnable = VK_FALSE;
   samplerInfo.compareOp = vk::CompareOp::eAlways;
   samplerInfo.minLod = 0.0f;                          // Minimum LOD
-  samplerInfo.maxLod = static_cast<float>(mipLevels); // Maximum LOD
+  samplerInfo.maxLod = vk::LodClampNone; // Any texture (placeholder or real)
   samplerInfo.borderColor = vk::BorderColor::eIntOpaqueBlack;
   samplerInfo.unnormalizedCoordinates = VK_FALSE; // Use normalized [0,1] UVs
 
@@ -342,173 +1235,550 @@ void VulkanRenderer::createTextureSampler() {
 }
 
 /**
- * @brief Allocates and begins recording a one-time-use command buffer.
- *
- * @return std::unique_ptr<vk::raii::CommandBuffer> A command buffer ready to
- * record operations.
+ * @brief Loads a texture image from disk and decodes it to RGBA8.
  *
  * @details
- * Single-time command buffers are used for transient GPU operations like
- * image layout transitions or buffer copies. This function allocates one
- * from the existing command pool and starts recording immediately.
- */
-std::unique_ptr<vk::raii::CommandBuffer>
-VulkanRenderer::beginSingleTimeCommands() {
-  // Allocate a primary command buffer from the command pool
-  vk::CommandBufferAllocateInfo allocInfo{};
-  allocInfo.commandPool = commandPool;
-  allocInfo.level = vk::CommandBufferLevel::ePrimary;
-  allocInfo.commandBufferCount = 1;
-
-  std::unique_ptr<vk::raii::CommandBuffer> commandBuffer =
-      std::make_unique<vk::raii::CommandBuffer>(
-          std::move(vk::raii::CommandBuffers(device, allocInfo).front()));
-
-  // Begin recording commands for one-time submission
-  vk::CommandBufferBeginInfo beginInfo{};
-  beginInfo.flags = vk::CommandBufferUsageFlagBits::eOneTimeSubmit;
-  commandBuffer->begin(beginInfo);
-
-  return commandBuffer;
-}
-
-/**
- * @brief Ends recording of a single-use command buffer and submits it for
- * execution.
+ * Steps:
+ * 1. View the baked COMPRESSED_TEXTURE_PATH in the asset pack, or map it,
+ *    if it is valid for TEXTURE_PATH and its format can be sampled; if so,
+ *    stop here.
+ * 2. Verify texture file exists.
+ * 3. Read it through 'fileReader' and decode it with stb_image.
  *
- * @param commandBuffer Reference to the command buffer being submitted.
+ * Runs on a worker thread and touches no Vulkan state; the mapping or the
+ * pixels are kept until createTextureImage() uploads them.
  *
- * @details
- * Submits the command buffer to the graphics queue and waits for the GPU to
- * complete. This ensures that transient operations like buffer copies finish
- * before continuing.
+ * @throws std::runtime_error If the file cannot be loaded.
  */
-void VulkanRenderer::endSingleTimeCommands(
-    vk::raii::CommandBuffer &commandBuffer) {
-  // Finish recording commands
-  commandBuffer.end();
+void VulkanRenderer::decodeTexture() {
+  PROFILE_SCOPE("decodeTexture()");
+
+  // Prefer the baked mip chain: no PNG decode and no mip generation
+  compressedTexture = artx::TextureFile::fromBytes(
+      packedAsset(COMPRESSED_TEXTURE_PATH), TEXTURE_PATH);
+  if (!compressedTexture) {
+    compressedTexture =
+        artx::TextureFile::open(COMPRESSED_TEXTURE_PATH, TEXTURE_PATH);
+  }
+  if (compressedTexture &&
+      compressedTexture->format() != artx::Format::eRGBA8 &&
+      !bcTexturesSupported) {
+    std::cerr << "Warning: textureCompressionBC unsupported, decoding "
+              << TEXTURE_PATH << " instead of "
+              << artx::name(compressedTexture->format()) << " texture"
+              << std::endl;
+    compressedTexture.reset();
+  }
+  if (compressedTexture) {
+    switch (compressedTexture->format()) {
+    case artx::Format::eBC1:
+      textureFormat = vk::Format::eBc1RgbSrgbBlock;
+      break;
+    case artx::Format::eBC7:
+      textureFormat = vk::Format::eBc7SrgbBlock;
+      break;
+    case artx::Format::eRGBA8:
+    default:
+      textureFormat = vk::Format::eR8G8B8A8Srgb;
+      break;
+    }
+    if (TEXTURE_STREAMING) {
+      std::span<const artx::LevelInfo> levels = compressedTexture->levels();
+      for (uint32_t i = 0; i < levels.size(); i++) {
+        textureLevels.push_back({levels[i].width, levels[i].height,
+                                 compressedTexture->levelData(i)});
+      }
+    }
+    return;
+  }
 
-  // Submit the command buffer to the graphics queue
-  vk::SubmitInfo submitInfo{};
-  submitInfo.commandBufferCount = 1;
-  submitInfo.pCommandBuffers = &*commandBuffer;
+  // Read the file asynchronously (the reader reports a missing file by
+  // path), then decode it using stb_image
+  AsyncFileReader::Result png =
+      fileReader.wait(fileReader.submit(TEXTURE_PATH));
+  int texWidth, texHeight, texChannels;
+  stbi_uc *pixels = stbi_load_from_memory(
+      reinterpret_cast<const stbi_uc *>(png.buffer.data()),
+      static_cast<int>(png.size), &texWidth, &texHeight, &texChannels,
+      STBI_rgb_alpha);
 
-  graphicsQueue.submit(submitInfo, nullptr);
-  graphicsQueue.waitIdle(); // Ensure execution is complete
+  if (!pixels) {
+    std::cerr << "ERROR: Failed to load texture image " << TEXTURE_PATH
+              << ": " << stbi_failure_reason() << std::endl;
+    throw std::runtime_error("Failed to load texture image!");
+  }
+
+  texturePixels = {pixels, stbi_image_free};
+  textureWidth = texWidth;
+  textureHeight = texHeight;
+  textureFormat = vk::Format::eR8G8B8A8Srgb;
+
+  if (TEXTURE_STREAMING) {
+    // Any level may be streamed later, so build the whole chain up front
+    const std::vector<mipgen::LevelLayout> layout = mipgen::layoutChain(
+        static_cast<uint32_t>(texWidth), static_cast<uint32_t>(texHeight));
+    textureChain.resize(layout.back().offset + layout.back().size);
+    memcpy(textureChain.data(), texturePixels.get(), layout[0].size);
+    texturePixels.reset();
+    mipgen::generateChain(textureChain.data(), layout);
+
+    const std::span<const std::byte> chain = std::as_bytes(
+        std::span<const uint8_t>(textureChain.data(), textureChain.size()));
+    for (const mipgen::LevelLayout &level : layout) {
+      textureLevels.push_back(
+          {level.width, level.height, chain.subspan(level.offset, level.size)});
+    }
+  }
 }
 
 /**
- * @brief Loads a texture image from disk, creates a Vulkan image, and uploads
- * the data to the GPU.
+ * @brief Creates a Vulkan image from the decoded texture and uploads the data
+ * to the GPU.
  *
  * @details
  * Steps:
- * 1. Verify texture file exists.
- * 2. Load pixel data using stb_image.
- * 3. Compute number of mipmap levels.
- * 4. Create a staging buffer in host-visible memory and copy pixels to it.
- * 5. Create the actual Vulkan image in device-local memory.
- * 6. Transition the image layout for transfer operations.
- * 7. Copy the texture data from the staging buffer to the image.
- * 8. Generate mipmaps for all levels.
- *
- * @throws std::runtime_error If the file cannot be loaded or texture creation
- * fails.
+ * 1. Compute number of mipmap levels.
+ * 2. Create a staging buffer in host-visible memory and copy pixels to it.
+ * 3. Create the actual Vulkan image in device-local memory.
+ * 4. Transition the image layout for transfer operations.
+ * 5. Copy the texture data from the staging buffer to the image.
+ * 6. Generate mipmaps for all levels.
+ *
+ * Steps 4 to 6 are recorded into 'loadBatch', which pollAssets() submits
+ * once with every other load of the frame (blits need the graphics queue).
+ * With CPU_MIPMAPS (or when the format cannot be linearly blitted) step 2
+ * also fills levels 1..n into the staging buffer with mipgen, steps 4 and 5
+ * are queued on 'uploadQueue' (one region per level) and step 6 is skipped.
+ * The time the frame loop spent on either path and its rate (level 0
+ * MPix/s) is printed for comparison; for the blit path that excludes the
+ * batch's wait, reported with the load batch statistics.
+ *
+ * A baked texture instead stages every level, queues a copy of each into
+ * its mip on 'uploadQueue' and skips step 6 (block-compressed images cannot
+ * be blitted, and the baked mips were filtered offline anyway).
+ *
+ * @throws std::runtime_error If texture creation fails.
+ * @see decodeTexture()
  */
 void VulkanRenderer::createTextureImage() {
-  // Check if the texture file exists
-  std::ifstream testFile("textures/texture.png");
-  if (!testFile.good()) {
-    std::cerr << "ERROR: Texture file 'textures/texture.png' not found!"
-              << std::endl;
-    throw std::runtime_error("Texture file not found!");
+  if (compressedTexture) {
+    createCompressedTextureImage();
+    return;
   }
-  testFile.close();
 
-  // Load the texture using stb_image
-  int texWidth, texHeight, texChannels;
-  stbi_uc *pixels = stbi_load(TEXTURE_PATH.c_str(), &texWidth, &texHeight,
-                              &texChannels, STBI_rgb_alpha);
+  int texWidth = textureWidth, texHeight = textureHeight;
 
-  if (!pixels) {
-    std::cerr << "ERROR: Failed to load texture image: "
-              << stbi_failure_reason() << std::endl;
-    throw std::runtime_error("Failed to load texture image!");
+  // The blit path needs linear filtering support for the format
+  const bool cpuMipmaps =
+      CPU_MIPMAPS ||
+      !(physicalGPU.getFormatProperties(textureFormat).optimalTilingFeatures &
+        vk::FormatFeatureFlagBits::eSampledImageFilterLinear);
+
+  // Compute mip levels and where each one lives in the staging buffer
+  std::vector<mipgen::LevelLayout> levels = mipgen::layoutChain(
+      static_cast<uint32_t>(texWidth), static_cast<uint32_t>(texHeight));
+  mipLevels = static_cast<uint32_t>(levels.size());
+  if (!cpuMipmaps) {
+    levels.resize(1); // Only level 0 is staged, the GPU blits the rest
   }
 
-  // Compute mip levels for the texture
-  mipLevels = static_cast<uint32_t>(
-                  std::floor(std::log2(std::max(texWidth, texHeight)))) +
-              1;
+  vk::DeviceSize imageSize = levels.back().offset + levels.back().size;
 
-  vk::DeviceSize imageSize =
-      texWidth * texHeight * 4; // RGBA8 = 4 bytes per pixel
+  // Take a staging range for the texture data
+  const StagingPool::Range staging = stagingPool->allocate(imageSize);
 
-  // Allocate staging buffer for the texture data
-  vk::raii::Buffer stagingBuffer({});
-  vk::raii::DeviceMemory stagingBufferMemory({});
+  // Copy the pixel data into the (persistently mapped) staging range
+  auto start = std::chrono::high_resolution_clock::now();
+  auto *data = static_cast<uint8_t *>(staging.data);
+  memcpy(data, texturePixels.get(), levels[0].size);
+  if (cpuMipmaps) {
+    // Filter the remaining levels straight into the mapped staging memory
+    mipgen::generateChain(data, levels);
+  }
 
-  createBuffer(imageSize, vk::BufferUsageFlagBits::eTransferSrc,
-               vk::MemoryPropertyFlagBits::eHostVisible |
-                   vk::MemoryPropertyFlagBits::eHostCoherent,
-               stagingBuffer, stagingBufferMemory);
+  texturePixels.reset(); // Free CPU-side image data
 
-  // Map the buffer memory and copy the pixel data
-  void *data = stagingBufferMemory.mapMemory(0, imageSize);
-  memcpy(data, pixels, static_cast<size_t>(imageSize));
-  stagingBufferMemory.unmapMemory();
+  // Create the Vulkan image in device-local memory (blits also read from it)
+  vk::ImageUsageFlags usage =
+      vk::ImageUsageFlagBits::eTransferDst | vk::ImageUsageFlagBits::eSampled;
+  if (!cpuMipmaps) {
+    usage |= vk::ImageUsageFlagBits::eTransferSrc;
+  }
+  createImage(texWidth, texHeight, mipLevels, vk::SampleCountFlagBits::e1,
+              textureFormat, vk::ImageTiling::eOptimal, usage,
+              vk::MemoryPropertyFlagBits::eDeviceLocal, textureImage,
+              textureImageMemory);
+
+  if (cpuMipmaps) {
+    // One region per level, recorded into a single copy command on the
+    // upload queue, which also transitions the image
+    std::vector<vk::BufferImageCopy> regions(levels.size());
+    for (uint32_t level = 0; level < mipLevels; level++) {
+      regions[level].bufferOffset = staging.offset + levels[level].offset;
+      regions[level].imageSubresource = vk::ImageSubresourceLayers{
+          vk::ImageAspectFlagBits::eColor, level, 0, 1};
+      regions[level].imageExtent =
+          vk::Extent3D{levels[level].width, levels[level].height, 1};
+    }
+    textureUpload =
+        uploadQueue->copy(staging, *textureImage, regions, mipLevels);
+  } else {
+    // Transition image to the transfer destination layout
+    transitionImageLayout(textureImage, vk::ImageLayout::eUndefined,
+                          vk::ImageLayout::eTransferDstOptimal, mipLevels);
+
+    // Copy the data from the staging range to the GPU image
+    copyBufferToImage(staging.buffer, textureImage,
+                      static_cast<uint32_t>(texWidth),
+                      static_cast<uint32_t>(texHeight), staging.offset);
+
+    // Generate mipmaps for the texture (blits need the graphics queue)
+    generateMipmaps(textureImage, textureFormat, texWidth, texHeight,
+                    mipLevels);
+    loadBatch->release(staging); // Freed once the batch has run
+  }
 
-  stbi_image_free(pixels); // Free CPU-side image data
+  const double ms = std::chrono::duration<double, std::milli>(
+                        std::chrono::high_resolution_clock::now() - start)
+                        .count();
+  std::cout << "Texture mips (" << (cpuMipmaps ? "cpu" : "blit")
+            << "): " << mipLevels << " levels in " << ms << " ms, "
+            << static_cast<double>(texWidth) * texHeight / 1e3 / ms
+            << " MPix/s" << std::endl;
+}
+
+/**
+ * @brief Uploads every mip level of 'compressedTexture'.
+ *
+ * @details Levels are staged at their (16-byte aligned) file offsets, which
+ * satisfies the copy alignment rules for both block sizes and RGBA8, so the
+ * whole chain is staged as one range: a single memcpy, or none when
+ * stageBytes() imports it from the asset pack (blobs are page aligned, so
+ * the level offsets keep their alignment inside the imported range).
+ */
+void VulkanRenderer::createCompressedTextureImage() {
+  const artx::TextureFile &file = *compressedTexture;
+  std::span<const artx::LevelInfo> levels = file.levels();
+  const uint32_t texWidth = file.width(), texHeight = file.height();
+  mipLevels = static_cast<uint32_t>(levels.size());
+  const vk::DeviceSize firstOffset = levels.front().offset;
+  const vk::DeviceSize imageSize =
+      levels.back().offset + levels.back().size - firstOffset;
+
+  vk::raii::Buffer importBuffer = nullptr;
+  GpuAllocation importMemory = nullptr;
+  const StagingPool::Range staging =
+      stageBytes(file.bytes().subspan(firstOffset, imageSize), importBuffer,
+                 importMemory);
+
+  std::vector<vk::BufferImageCopy> regions(levels.size());
+  for (uint32_t level = 0; level < mipLevels; level++) {
+    regions[level].bufferOffset =
+        staging.offset + levels[level].offset - firstOffset;
+    regions[level].imageSubresource = vk::ImageSubresourceLayers{
+        vk::ImageAspectFlagBits::eColor, level, 0, 1};
+    regions[level].imageExtent =
+        vk::Extent3D{levels[level].width, levels[level].height, 1};
+  }
+
+  compressedTexture.reset(); // Unmap the file (pack blobs stay mapped)
 
-  // Create the Vulkan image in device-local memory
   createImage(texWidth, texHeight, mipLevels, vk::SampleCountFlagBits::e1,
-              vk::Format::eR8G8B8A8Srgb, vk::ImageTiling::eOptimal,
-              vk::ImageUsageFlagBits::eTransferSrc |
-                  vk::ImageUsageFlagBits::eTransferDst |
+              textureFormat, vk::ImageTiling::eOptimal,
+              vk::ImageUsageFlagBits::eTransferDst |
                   vk::ImageUsageFlagBits::eSampled,
               vk::MemoryPropertyFlagBits::eDeviceLocal, textureImage,
               textureImageMemory);
+  textureUpload =
+      uploadQueue->copy(staging, *textureImage, regions, mipLevels);
+  uploadQueue->keepAlive(std::move(importBuffer), std::move(importMemory));
+}
+
+namespace {
 
-  // Transition image to the transfer destination layout
-  transitionImageLayout(textureImage, vk::ImageLayout::eUndefined,
-                        vk::ImageLayout::eTransferDstOptimal, mipLevels);
+/** @brief Copies levels firstMip .. end of 'levels' back to back. */
+void packChain(std::span<const texstream::Level> levels, uint32_t firstMip,
+               void *destination) {
+  auto *data = static_cast<std::byte *>(destination);
+  for (size_t level = firstMip; level < levels.size(); level++) {
+    memcpy(data, levels[level].data.data(), levels[level].data.size());
+    data += levels[level].data.size();
+  }
+}
 
-  // Copy the data from the staging buffer to the GPU image
-  copyBufferToImage(stagingBuffer, textureImage,
-                    static_cast<uint32_t>(texWidth),
-                    static_cast<uint32_t>(texHeight));
+} // namespace
 
-  // Generate mipmaps for the texture
-  generateMipmaps(textureImage, vk::Format::eR8G8B8A8Srgb, texWidth, texHeight,
-                  mipLevels);
+/**
+ * @brief Uploads the mip tail of a streamed texture.
+ *
+ * @details The levels no larger than TEXTURE_STREAMING_INITIAL_SIZE are
+ * staged back to back and become the first image, a few KB that upload in
+ * well under a frame. 'desiredMip' starts at the same level, so nothing
+ * else streams until updateUniformBuffer() has measured the model on screen.
+ * The placeholder stays bound until updateTextureStreaming() lands it.
+ */
+void VulkanRenderer::startTextureStreaming() {
+  const uint32_t mipCount = static_cast<uint32_t>(textureLevels.size());
+  const uint32_t firstMip =
+      texstream::initialMip(textureLevels, TEXTURE_STREAMING_INITIAL_SIZE);
+  textureResidency.mipCount = mipCount;
+  textureResidency.residentMip = mipCount; // Nothing resident yet
+  textureResidency.desiredMip = firstMip;
+
+  textureStreamStaging = stagingPool->allocate(
+      texstream::chainBytes(textureLevels, firstMip));
+  packChain(textureLevels, firstMip, textureStreamStaging.data);
+  resizeStreamedTexture(firstMip);
+  textureStreamStaging = {}; // Released by 'uploadQueue'
 }
 
 /**
- * @brief Creates color resources for multisampled rendering.
+ * @brief Lands or starts one texture residency change.
+ *
+ * @details
+ * A stream-in takes a staging range sized for the new resident chain and
+ * copies the levels into it on a worker (for a baked texture this is where
+ * the new level's pages are read from disk); the GPU copy is queued on a
+ * later frame, once the worker is done. Evictions stage the (smaller)
+ * remaining chain right away. Either way the new image replaces the old
+ * one only once its upload has completed, so no frame waits for it.
+ */
+void VulkanRenderer::updateTextureStreaming() {
+  if (!TEXTURE_STREAMING || !textureResident) {
+    return;
+  }
+
+  if (*streamedImage) {
+    if (uploadQueue->ready(streamedUpload)) {
+      landStreamedTexture();
+    }
+  } else if (textureStreamFuture.valid()) {
+    if (textureStreamFuture.wait_for(std::chrono::seconds(0)) !=
+        std::future_status::ready) {
+      return;
+    }
+    textureStreamFuture.get();
+    resizeStreamedTexture(textureStreamMip);
+    textureStreamStaging = {}; // Released by 'uploadQueue'
+  } else {
+    const texstream::Step step = texstream::nextStep(
+        textureResidency, textureLevels, textureStreamingBudget);
+    if (step.action != texstream::Action::eNone) {
+      textureStreamStaging = stagingPool->allocate(
+          texstream::chainBytes(textureLevels, step.mip));
+    }
+    if (step.action == texstream::Action::eEvict) {
+      packChain(textureLevels, step.mip, textureStreamStaging.data);
+      resizeStreamedTexture(step.mip);
+      textureStreamStaging = {};
+    } else if (step.action == texstream::Action::eStreamIn) {
+      void *data = textureStreamStaging.data;
+      const std::span<const texstream::Level> levels = textureLevels;
+      textureStreamMip = step.mip;
+      textureStreamFuture = ThreadPool::global().submit(
+          [levels, mip = step.mip, data]() { packChain(levels, mip, data); });
+    }
+  }
+
+  PROFILE_COUNTER("Texture resident bytes: " + TEXTURE_PATH,
+                  textureResidency.residentBytes);
+  PROFILE_COUNTER("Texture resident mip: " + TEXTURE_PATH,
+                  textureResidency.residentMip);
+}
+
+/**
+ * @brief Reallocates the streamed texture for a new resident range.
+ *
+ * @details
+ * The image always holds exactly the resident levels, so evicting really
+ * frees memory and the view's level 0 is residentMip: sampling is clamped
+ * to what is resident without any shader or sampler change. The new image
+ * is filled from the staged chain by one copy on 'uploadQueue' (which also
+ * transitions it), so it never depends on the old image, and frames keep
+ * sampling the old image until the copy has completed.
+ *
+ * Restaging the levels both images hold costs at most a third of the new
+ * level's bytes, instead of an image-to-image copy that would need the old
+ * image on the transfer queue.
+ */
+void VulkanRenderer::resizeStreamedTexture(uint32_t firstMip) {
+  const uint32_t mipCount = textureResidency.mipCount;
+  const uint32_t levelCount = mipCount - firstMip;
+  const texstream::Level &top = textureLevels[firstMip];
+
+  createImage(top.width, top.height, levelCount, vk::SampleCountFlagBits::e1,
+              textureFormat, vk::ImageTiling::eOptimal,
+              vk::ImageUsageFlagBits::eTransferDst |
+                  vk::ImageUsageFlagBits::eSampled,
+              vk::MemoryPropertyFlagBits::eDeviceLocal, streamedImage,
+              streamedImageMemory);
+
+  // Every resident level comes from the staging range, packed back to back
+  std::vector<vk::BufferImageCopy> regions;
+  vk::DeviceSize offset = textureStreamStaging.offset;
+  for (uint32_t level = firstMip; level < mipCount; level++) {
+    vk::BufferImageCopy copy{};
+    copy.bufferOffset = offset;
+    copy.imageSubresource = vk::ImageSubresourceLayers{
+        vk::ImageAspectFlagBits::eColor, level - firstMip, 0, 1};
+    copy.imageExtent = vk::Extent3D{textureLevels[level].width,
+                                    textureLevels[level].height, 1};
+    regions.push_back(copy);
+    offset += textureLevels[level].data.size();
+  }
+  streamedUpload = uploadQueue->copy(textureStreamStaging, *streamedImage,
+                                     regions, levelCount);
+  streamedMip = firstMip;
+}
+
+/**
+ * @details The old view, image and memory are retired, since frames in
+ * flight may still sample them; the descriptor sets are rewritten lazily
+ * by updateTextureDescriptor(). The new image's batch has completed, so
+ * the frames sampling it do not wait.
+ */
+void VulkanRenderer::landStreamedTexture() {
+  const uint32_t mipCount = textureResidency.mipCount;
+  const uint32_t levelCount = mipCount - streamedMip;
+  const texstream::Level &top = textureLevels[streamedMip];
+
+  if (textureResidency.residentMip < mipCount) {
+    retireQueue.retire(frameNumber, std::move(textureImageView),
+                       std::move(textureImage), std::move(textureImageMemory));
+  }
+  // Old view, image and memory are released in that order
+  textureImageView = vkutils::createImageView(
+      device, streamedImage, textureFormat, vk::ImageAspectFlagBits::eColor,
+      levelCount);
+  textureImage = std::move(streamedImage);
+  textureImageMemory = std::move(streamedImageMemory);
+  textureUpload = streamedUpload;
+  mipLevels = levelCount;
+
+  // A recycled handle could match the old view; force every set to rewrite
+  std::fill(descriptorSetImageViews.begin(), descriptorSetImageViews.end(),
+            vk::ImageView{});
+
+  textureResidency.residentMip = streamedMip;
+  textureResidency.residentBytes =
+      texstream::chainBytes(textureLevels, streamedMip);
+  std::cout << "Texture mip " << streamedMip << " resident (" << top.width
+            << "x" << top.height << ", "
+            << textureResidency.residentBytes / 1024 << " KB)" << std::endl;
+}
+
+/**
+ * @brief Creates a 1x1 opaque white texture.
+ *
+ * @details Bound in every descriptor set until the real texture is resident,
+ * so the pipeline always has a valid image to sample. It is kept alive for
+ * the renderer's lifetime (4 bytes) so descriptor sets can switch away from
+ * it lazily, one frame in flight at a time. Its upload is recorded into
+ * 'loadBatch' and submitted at the end of initVulkan().
+ */
+void VulkanRenderer::createPlaceholderTexture() {
+  const uint8_t white[4] = {255, 255, 255, 255};
+
+  const StagingPool::Range staging =
+      stagingPool->upload(std::as_bytes(std::span(white)));
+
+  createImage(1, 1, 1, vk::SampleCountFlagBits::e1, vk::Format::eR8G8B8A8Srgb,
+              vk::ImageTiling::eOptimal,
+              vk::ImageUsageFlagBits::eTransferDst |
+                  vk::ImageUsageFlagBits::eSampled,
+              vk::MemoryPropertyFlagBits::eDeviceLocal, placeholderImage,
+              placeholderImageMemory);
+  transitionImageLayout(placeholderImage, vk::ImageLayout::eUndefined,
+                        vk::ImageLayout::eTransferDstOptimal, 1);
+  copyBufferToImage(staging.buffer, placeholderImage, 1, 1, staging.offset);
+  transitionImageLayout(placeholderImage, vk::ImageLayout::eTransferDstOptimal,
+                        vk::ImageLayout::eShaderReadOnlyOptimal, 1);
+  loadBatch->release(staging);
+
+  placeholderImageView = vkutils::createImageView(
+      device, placeholderImage, vk::Format::eR8G8B8A8Srgb,
+      vk::ImageAspectFlagBits::eColor, 1);
+}
+
+/**
+ * @brief Creates the color image for multisampled rendering.
  *
  * @details
  * This function sets up a color image to be used as a multisampled color
  * attachment in MSAA rendering. The image will later be resolved to the
- * swapchain image to display the final rendered output.
+ * swapchain image to display the final rendered output; its samples are not
+ * stored, so it is transient like the depth buffer.
+ *
+ * Memory and the image view are created by bindTransientAttachments().
+ */
+void VulkanRenderer::createColorResources() {
+  colorImage = createAttachmentImage(
+      swapChainImageFormat, // Use the same format as the swapchain
+      vk::ImageUsageFlagBits::eTransientAttachment |
+          vk::ImageUsageFlagBits::eColorAttachment);
+}
+
+/**
+ * @brief Creates a swapchain-sized image with msaaSamples samples and no
+ * memory.
+ */
+vk::raii::Image
+VulkanRenderer::createAttachmentImage(vk::Format format,
+                                      vk::ImageUsageFlags usage) {
+  vk::ImageCreateInfo imageInfo{};
+  imageInfo.imageType = vk::ImageType::e2D;
+  imageInfo.format = format;
+  imageInfo.extent =
+      vk::Extent3D{swapChainExtent.width, swapChainExtent.height, 1};
+  imageInfo.mipLevels = 1;
+  imageInfo.arrayLayers = 1;
+  imageInfo.samples = msaaSamples; // Match the pipeline's sample count
+  imageInfo.tiling = vk::ImageTiling::eOptimal;
+  imageInfo.usage = usage;
+  imageInfo.sharingMode = vk::SharingMode::eExclusive;
+  return vk::raii::Image(device, imageInfo);
+}
+
+/**
+ * @brief Binds memory to the color and depth images and creates their views.
+ *
+ * @details
+ * Both images are used by the one render pass of a frame (pass 0), so
+ * TransientAttachments places them in lazily allocated memory where the
+ * device offers it and otherwise side by side in one shared device-local
+ * block; attachments of later passes whose lifetimes do not overlap theirs
+ * would alias them.
+ *
+ * The footprint is printed for every resolution and MSAA level the
+ * swapchain is (re)created with: "before" is one allocation per
+ * attachment, "after" the memory actually backing them.
  */
-void VulkanRenderer::createColorResources() {
-  vk::Format colorFormat =
-      swapChainImageFormat; // Use the same format as the swapchain
-
-  // Create a multisampled image with the specified width, height, and sample
-  // count
-  createImage(
-      swapChainExtent.width, swapChainExtent.height, 1, msaaSamples,
-      colorFormat, vk::ImageTiling::eOptimal,
-      vk::ImageUsageFlagBits::eTransientAttachment |
-          vk::ImageUsageFlagBits::eColorAttachment, // Used as color attachment
-      vk::MemoryPropertyFlagBits::eDeviceLocal,     // GPU-local memory for
-                                                    // efficiency
-      colorImage, colorImageMemory);
-
-  // Create an image view so shaders can access the image
-  colorImageView = vkutils::createImageView(device, colorImage, colorFormat,
-                                            vk::ImageAspectFlagBits::eColor, 1);
+void VulkanRenderer::bindTransientAttachments() {
+  transientAttachments->reset();
+  transientAttachments->add(colorImage, 0, 0);
+  transientAttachments->add(depthImage, 0, 0);
+  transientAttachments->bind();
+
+  colorImageView =
+      vkutils::createImageView(device, colorImage, swapChainImageFormat,
+                               vk::ImageAspectFlagBits::eColor, 1);
+  depthImageView =
+      vkutils::createImageView(device, depthImage, findDepthFormat(),
+                               vk::ImageAspectFlagBits::eDepth, 1);
+
+  const TransientAttachments::Footprint footprint =
+      transientAttachments->footprint();
+  std::cout << "Attachments " << swapChainExtent.width << "x"
+            << swapChainExtent.height << " "
+            << static_cast<uint32_t>(msaaSamples) << "x MSAA: "
+            << footprint.separateBytes / 1024 << " KiB before, "
+            << footprint.residentBytes() / 1024 << " KiB after ("
+            << footprint.lazyBytes / 1024 << " KiB lazily allocated, "
+            << footprint.committedBytes / 1024 << " KiB committed; "
+            << footprint.aliasedBytes / 1024 << " KiB in "
+            << footprint.aliasedBlocks << " shared blocks)" << std::endl;
+  PROFILE_COUNTER("Attachment bytes before", footprint.separateBytes);
+  PROFILE_COUNTER("Attachment bytes after", footprint.residentBytes());
 }
 
 /**
@@ -529,7 +1799,9 @@ void VulkanRenderer::createColorResources() {
  * @details
  * This encapsulates Vulkan's boilerplate for creating images:
  * 1. Fill in vk::ImageCreateInfo structure with image parameters.
- * 2. Allocate memory suitable for the image usage.
+ * 2. Allocate memory suitable for the image usage from the GpuAllocator
+ *    (a range of a shared block, or a dedicated allocation for large
+ *    images and those the driver wants to own their memory).
  * 3. Bind memory to the image handle.
  */
 void VulkanRenderer::createImage(uint32_t width, uint32_t height,
@@ -539,7 +1811,7 @@ void VulkanRenderer::createImage(uint32_t width, uint32_t height,
                                  vk::ImageUsageFlags usage,
                                  vk::MemoryPropertyFlags properties,
                                  vk::raii::Image &image,
-                                 vk::raii::DeviceMemory &imageMemory) {
+                                 GpuAllocation &imageMemory) {
   vk::ImageCreateInfo imageInfo{};
   imageInfo.imageType = vk::ImageType::e2D;          // 2D image
   imageInfo.format = format;                         // Pixel format
@@ -555,20 +1827,14 @@ void VulkanRenderer::createImage(uint32_t width, uint32_t height,
   // Create the Vulkan image
   image = vk::raii::Image(device, imageInfo);
 
-  // Get memory requirements for the image
-  vk::MemoryRequirements memRequirements = image.getMemoryRequirements();
-
-  // Allocate memory based on requirements
-  vk::MemoryAllocateInfo allocInfo{};
-  allocInfo.allocationSize = memRequirements.size;
-  allocInfo.memoryTypeIndex =
-      findMemoryType(memRequirements.memoryTypeBits,
-                     properties); // Choose suitable memory type
-
-  imageMemory = vk::raii::DeviceMemory(device, allocInfo);
-
-  // Bind the allocated memory to the image
-  image.bindMemory(imageMemory, 0);
+  // Sub-allocate memory of a suitable type and bind it to the image
+  const bool attachment = static_cast<bool>(
+      usage & (vk::ImageUsageFlagBits::eColorAttachment |
+               vk::ImageUsageFlagBits::eDepthStencilAttachment));
+  imageMemory = allocator->allocate(
+      image, tiling, properties,
+      attachment ? GpuAllocator::Category::eAttachment
+                 : GpuAllocator::Category::eTexture);
 }
 
 /**
@@ -581,16 +1847,13 @@ void VulkanRenderer::createImage(uint32_t width, uint32_t height,
  *
  * @details
  * Vulkan requires explicit image layout transitions depending on usage.
- * This function inserts a pipeline barrier into a temporary command buffer
- * to perform the layout transition.
+ * This function records a pipeline barrier into 'loadBatch', which performs
+ * the layout transition once the batch is submitted.
  */
 void VulkanRenderer::transitionImageLayout(const vk::raii::Image &image,
                                            vk::ImageLayout oldLayout,
                                            vk::ImageLayout newLayout,
                                            uint32_t mipLevels) {
-  // Begin single-use command buffer for layout transition
-  auto commandBuffer = beginSingleTimeCommands();
-
   // Describe the image subresources affected by the transition
   vk::ImageMemoryBarrier barrier{};
   barrier.oldLayout = oldLayout;
@@ -623,12 +1886,9 @@ void VulkanRenderer::transitionImageLayout(const vk::raii::Image &image,
     throw std::invalid_argument("Unsupported layout transition!");
   }
 
-  // Insert the pipeline barrier
-  commandBuffer->pipelineBarrier(sourceStage, destinationStage, {}, {}, nullptr,
-                                 barrier);
-
-  // Submit the command buffer and wait for it to complete
-  endSingleTimeCommands(*commandBuffer);
+  // Insert the pipeline barrier into the load batch
+  loadBatch->commands().pipelineBarrier(sourceStage, destinationStage, {}, {},
+                                        nullptr, barrier);
 }
 
 /**
@@ -643,7 +1903,8 @@ void VulkanRenderer::transitionImageLayout(const vk::raii::Image &image,
  * @details
  * Mipmaps improve rendering quality and performance for textures viewed
  * at a distance. This function progressively downsamples the image level
- * by level using linear filtering and performs necessary layout transitions.
+ * by level using linear filtering and performs necessary layout transitions,
+ * all recorded into 'loadBatch' after the copy of level 0.
  */
 void VulkanRenderer::generateMipmaps(vk::raii::Image &image,
                                      vk::Format imageFormat, int32_t texWidth,
@@ -658,8 +1919,8 @@ void VulkanRenderer::generateMipmaps(vk::raii::Image &image,
         "Texture image format does not support linear blitting!");
   }
 
-  // Begin single-use command buffer for mipmap generation
-  auto commandBuffer = beginSingleTimeCommands();
+  // Recorded after the level 0 copy, in the same command buffer
+  const vk::raii::CommandBuffer &commandBuffer = loadBatch->commands();
 
   vk::ImageMemoryBarrier barrier{};
   barrier.image = *image;
@@ -682,9 +1943,9 @@ void VulkanRenderer::generateMipmaps(vk::raii::Image &image,
     barrier.dstAccessMask = vk::AccessFlagBits::eTransferRead;
 
     // Transition previous level to transfer source
-    commandBuffer->pipelineBarrier(vk::PipelineStageFlagBits::eTransfer,
-                                   vk::PipelineStageFlagBits::eTransfer, {}, {},
-                                   {}, barrier);
+    commandBuffer.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer,
+                                  vk::PipelineStageFlagBits::eTransfer, {}, {},
+                                  {}, barrier);
 
     // Configure blit from previous mip level to current
     vk::ImageBlit blit{};
@@ -704,9 +1965,9 @@ void VulkanRenderer::generateMipmaps(vk::raii::Image &image,
     blit.dstSubresource.layerCount = 1;
 
     // Execute the blit command
-    commandBuffer->blitImage(*image, vk::ImageLayout::eTransferSrcOptimal,
-                             *image, vk::ImageLayout::eTransferDstOptimal,
-                             {blit}, vk::Filter::eLinear);
+    commandBuffer.blitImage(*image, vk::ImageLayout::eTransferSrcOptimal,
+                            *image, vk::ImageLayout::eTransferDstOptimal,
+                            {blit}, vk::Filter::eLinear);
 
     // Transition the new mip level to shader read for sampling
     barrier.oldLayout = vk::ImageLayout::eTransferSrcOptimal;
@@ -714,9 +1975,9 @@ void VulkanRenderer::generateMipmaps(vk::raii::Image &image,
     barrier.srcAccessMask = vk::AccessFlagBits::eTransferRead;
     barrier.dstAccessMask = vk::AccessFlagBits::eShaderRead;
 
-    commandBuffer->pipelineBarrier(vk::PipelineStageFlagBits::eTransfer,
-                                   vk::PipelineStageFlagBits::eFragmentShader,
-                                   {}, {}, {}, barrier);
+    commandBuffer.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer,
+                                  vk::PipelineStageFlagBits::eFragmentShader,
+                                  {}, {}, {}, barrier);
 
     if (mipWidth > 1)
       mipWidth /= 2;
@@ -731,65 +1992,53 @@ void VulkanRenderer::generateMipmaps(vk::raii::Image &image,
   barrier.srcAccessMask = vk::AccessFlagBits::eTransferWrite;
   barrier.dstAccessMask = vk::AccessFlagBits::eShaderRead;
 
-  commandBuffer->pipelineBarrier(vk::PipelineStageFlagBits::eTransfer,
-                                 vk::PipelineStageFlagBits::eFragmentShader, {},
-                                 {}, {}, barrier);
-
-  // End command buffer and submit
-  endSingleTimeCommands(*commandBuffer);
+  commandBuffer.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer,
+                                vk::PipelineStageFlagBits::eFragmentShader, {},
+                                {}, {}, barrier);
 }
 
 /**
  * @brief Copies data from a Vulkan buffer to an image.
  *
  * @details
- * This function records and submits a single-use command buffer that copies
- * pixel data from a source buffer (typically a staging buffer) into a GPU
- * image (commonly a texture or framebuffer attachment). The image must already
- * be in the 'vk::ImageLayout::eTransferDstOptimal' layout for the transfer
- * to work correctly.
- *
- * The function uses a single-time command buffer via
- * @c beginSingleTimeCommands() and @c endSingleTimeCommands(), which handle
- * allocation, submission, and cleanup.
+ * This function records a copy of pixel data from a source buffer
+ * (typically a staging buffer) into a GPU image (commonly a texture or
+ * framebuffer attachment) into 'loadBatch'. The image must already be in
+ * the 'vk::ImageLayout::eTransferDstOptimal' layout for the transfer to work
+ * correctly; the copy runs when the batch is submitted.
  *
  * @param[in] buffer The Vulkan buffer containing the pixel data to copy.
  * @param[in,out] image The destination Vulkan image that will receive the data.
  * @param[in] width Width of the image in pixels.
  * @param[in] height Height of the image in pixels.
+ * @param[in] bufferOffset Offset of the pixel data in 'buffer'.
  *
  * @note The layout of the image must be transitioned to
  *       @c vk::ImageLayout::eTransferDstOptimal before calling this function.
  */
-void VulkanRenderer::copyBufferToImage(const vk::raii::Buffer &buffer,
+void VulkanRenderer::copyBufferToImage(vk::Buffer buffer,
                                        vk::raii::Image &image, uint32_t width,
-                                       uint32_t height) {
-  // Begin recording a single-use command buffer
-  std::unique_ptr<vk::raii::CommandBuffer> commandBuffer =
-      beginSingleTimeCommands();
-
+                                       uint32_t height,
+                                       vk::DeviceSize bufferOffset) {
   // Define the region of the buffer and image to copy
   vk::BufferImageCopy region{};
-  region.bufferOffset = 0;      // Start at the beginning of the buffer
-  region.bufferRowLength = 0;   // Tightly packed rows
-  region.bufferImageHeight = 0; // Tightly packed rows
-  region.imageSubresource =     // Specify the layers and mip level
+  region.bufferOffset = bufferOffset; // Start of the pixels in the buffer
+  region.bufferRowLength = 0;         // Tightly packed rows
+  region.bufferImageHeight = 0;       // Tightly packed rows
+  region.imageSubresource =           // Specify the layers and mip level
       vk::ImageSubresourceLayers{vk::ImageAspectFlagBits::eColor, 0, 0, 1};
   region.imageOffset =
       vk::Offset3D{0, 0, 0}; // Start at top-left corner of the image
   region.imageExtent =
       vk::Extent3D{width, height, 1}; // Size of the region to copy
 
-  // Record the buffer-to-image copy command into the command buffer
-  commandBuffer->copyBufferToImage(
+  // Record the buffer-to-image copy command into the load batch
+  loadBatch->commands().copyBufferToImage(
       buffer,                               // Source buffer
       image,                                // Destination image
       vk::ImageLayout::eTransferDstOptimal, // Current layout of the image
       {region}                              // Regions to copy
   );
-
-  // Submit the command buffer and wait for completion
-  endSingleTimeCommands(*commandBuffer);
 }
 
 /**
@@ -812,11 +2061,11 @@ void VulkanRenderer::copyBufferToImage(const vk::raii::Buffer &buffer,
  */
 void VulkanRenderer::createDescriptorPool() {
   // Define the number of descriptors of each type in the pool
-  std::array<vk::DescriptorPoolSize, 2> poolSizes = {};
+  std::array<vk::DescriptorPoolSize, 3> poolSizes = {};
 
-  // Pool for uniform buffer descriptors
+  // Pool for the frame ring's dynamic uniform buffer descriptors
   poolSizes[0] =
-      vk::DescriptorPoolSize(vk::DescriptorType::eUniformBuffer,
+      vk::DescriptorPoolSize(vk::DescriptorType::eUniformBufferDynamic,
                              MAX_FRAMES_IN_FLIGHT // One per frame in flight
       );
 
@@ -826,11 +2075,16 @@ void VulkanRenderer::createDescriptorPool() {
                              MAX_FRAMES_IN_FLIGHT // One per frame in flight
       );
 
+  // Pool for the cull pass storage buffers (meshlets, draws, counters), with
+  // room for the sets of a hot-reloaded model while the old ones retire
+  poolSizes[2] = vk::DescriptorPoolSize(vk::DescriptorType::eStorageBuffer,
+                                        2 * 3 * MAX_FRAMES_IN_FLIGHT);
+
   // Descriptor pool creation info
   vk::DescriptorPoolCreateInfo poolInfo;
   poolInfo.flags = vk::DescriptorPoolCreateFlagBits::eFreeDescriptorSet;
   // Allows individual descriptor sets to be freed
-  poolInfo.maxSets = MAX_FRAMES_IN_FLIGHT; // Max sets in pool
+  poolInfo.maxSets = 3 * MAX_FRAMES_IN_FLIGHT; // Graphics + 2x cull sets
   poolInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
   poolInfo.pPoolSizes = poolSizes.data(); // Pointer to pool sizes
 
@@ -842,14 +2096,15 @@ void VulkanRenderer::createDescriptorPool() {
  * @brief Allocates and writes Vulkan descriptor sets.
  *
  * Each descriptor set binds:
- * - A uniform buffer for per-frame transformation matrices.
+ * - The frame ring buffer as a dynamic uniform buffer; the offset of the
+ *   frame's transformation matrices is given when the set is bound.
  * - A texture sampler for fragment shading.
  *
  * @details The descriptor sets are allocated from the descriptor pool created
  * by 'createDescriptorPool()'. One set per frame in flight is allocated to
  * support multiple frames being processed simultaneously by the GPU.
  *
- * @see createUniformBuffers()
+ * @see createFrameRing()
  * @see updateUniformBuffer()
  */
 void VulkanRenderer::createDescriptorSets() {
@@ -875,8 +2130,8 @@ void VulkanRenderer::createDescriptorSets() {
     // Uniform buffer info //
     // ------------------- //
     vk::DescriptorBufferInfo bufferInfo;
-    bufferInfo.buffer = *uniformBuffers[i]; // GPU buffer for this frame
-    bufferInfo.offset = 0;                  // Start at beginning of buffer
+    bufferInfo.buffer = *frameRingBuffer; // Same buffer for every frame
+    bufferInfo.offset = 0;                // Dynamic offset added at bind
     bufferInfo.range = sizeof(UniformBufferObject); // Size of data to bind
 
     // Prepare a write descriptor for the uniform buffer (binding 0)
@@ -885,7 +2140,7 @@ void VulkanRenderer::createDescriptorSets() {
     descriptorWrite.dstBinding = 0;              // Matches binding in shader
     descriptorWrite.dstArrayElement = 0; // First element of array (if arrayed)
     descriptorWrite.descriptorCount = 1; // Single buffer
-    descriptorWrite.descriptorType = vk::DescriptorType::eUniformBuffer;
+    descriptorWrite.descriptorType = vk::DescriptorType::eUniformBufferDynamic;
     descriptorWrite.pBufferInfo = &bufferInfo; // Reference to buffer info
 
     // -------------------- //
@@ -894,7 +2149,9 @@ void VulkanRenderer::createDescriptorSets() {
     vk::DescriptorImageInfo imageInfo;
     imageInfo.imageLayout =
         vk::ImageLayout::eShaderReadOnlyOptimal; // Image layout for shader
-    imageInfo.imageView = *textureImageView;     // Image view
+    imageInfo.imageView = textureResident
+                              ? *textureImageView
+                              : *placeholderImageView; // Image view
     imageInfo.sampler = *textureSampler;         // Sampler
 
     // Prepare a write descriptor for the texture sampler (binding 1)
@@ -910,6 +2167,149 @@ void VulkanRenderer::createDescriptorSets() {
     std::array<vk::WriteDescriptorSet, 2> descriptorWrites = {descriptorWrite,
                                                               samplerWrite};
     device.updateDescriptorSets(descriptorWrites, {}); // Perform the updates
+    descriptorSetImageViews.push_back(imageInfo.imageView);
+  }
+}
+
+/**
+ * @brief Switches a frame's descriptor sets to the current texture views.
+ *
+ * @details Called after the frame's fence wait, when no pending command
+ * buffer uses the sets, so the update needs no extra synchronization and
+ * never stalls the other frame in flight. A texture replaces the
+ * placeholder only once its upload has completed, so no frame waits for
+ * it; a hot-reloaded main texture replaces a shown one right away.
+ */
+void VulkanRenderer::updateTextureDescriptor(uint32_t frame) {
+  auto update = [&](const vk::raii::DescriptorSet &set, vk::ImageView &bound,
+                    vk::ImageView imageView) {
+    if (bound == imageView) {
+      return;
+    }
+    vk::DescriptorImageInfo imageInfo(*textureSampler, imageView,
+                                      vk::ImageLayout::eShaderReadOnlyOptimal);
+    vk::WriteDescriptorSet samplerWrite;
+    samplerWrite.dstSet = *set;
+    samplerWrite.dstBinding = 1;
+    samplerWrite.descriptorCount = 1;
+    samplerWrite.descriptorType = vk::DescriptorType::eCombinedImageSampler;
+    samplerWrite.pImageInfo = &imageInfo;
+    device.updateDescriptorSets(samplerWrite, {});
+    bound = imageView;
+  };
+
+  textureShown = textureShown || (textureResident && *textureImageView &&
+                                  uploadQueue->ready(textureUpload));
+  update(descriptorSets[frame], descriptorSetImageViews[frame],
+         textureShown ? *textureImageView : *placeholderImageView);
+  if (!modelResident) {
+    return; // 'materialTextures' still belongs to the loader thread
+  }
+  for (MaterialTexture &texture : materialTextures) {
+    if (!texture.descriptorSets.empty()) {
+      const bool uploaded =
+          *texture.imageView && uploadQueue->ready(texture.uploadValue);
+      update(texture.descriptorSets[frame],
+             texture.descriptorSetImageViews[frame],
+             uploaded ? *texture.imageView : *placeholderImageView);
+    }
+  }
+}
+
+/**
+ * @details Each set repeats the frame ring's dynamic uniform buffer
+ * (binding 0) so a material switch is a single vkCmdBindDescriptorSets of
+ * set 0, with the same dynamic offset. The pool
+ * is sized for exactly these sets and created here, once the number of
+ * textures is known.
+ */
+void VulkanRenderer::createMaterialDescriptorSets() {
+  if (materialTextures.empty()) {
+    return;
+  }
+  const uint32_t setCount =
+      static_cast<uint32_t>(materialTextures.size()) * MAX_FRAMES_IN_FLIGHT;
+
+  std::array<vk::DescriptorPoolSize, 2> poolSizes = {
+      vk::DescriptorPoolSize(vk::DescriptorType::eUniformBufferDynamic,
+                             setCount),
+      vk::DescriptorPoolSize(vk::DescriptorType::eCombinedImageSampler,
+                             setCount)};
+  vk::DescriptorPoolCreateInfo poolInfo;
+  poolInfo.flags = vk::DescriptorPoolCreateFlagBits::eFreeDescriptorSet;
+  poolInfo.maxSets = setCount;
+  poolInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
+  poolInfo.pPoolSizes = poolSizes.data();
+  materialDescriptorPool = device.createDescriptorPool(poolInfo);
+
+  std::vector<vk::DescriptorSetLayout> layouts(MAX_FRAMES_IN_FLIGHT,
+                                               *descriptorSetLayout);
+  vk::DescriptorSetAllocateInfo allocInfo;
+  allocInfo.descriptorPool = *materialDescriptorPool;
+  allocInfo.descriptorSetCount = static_cast<uint32_t>(layouts.size());
+  allocInfo.pSetLayouts = layouts.data();
+
+  for (MaterialTexture &texture : materialTextures) {
+    texture.descriptorSets = device.allocateDescriptorSets(allocInfo);
+    texture.descriptorSetImageViews.assign(MAX_FRAMES_IN_FLIGHT,
+                                           *placeholderImageView);
+    for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
+      vk::DescriptorBufferInfo bufferInfo(*frameRingBuffer, 0,
+                                          sizeof(UniformBufferObject));
+      vk::DescriptorImageInfo imageInfo(
+          *textureSampler, *placeholderImageView,
+          vk::ImageLayout::eShaderReadOnlyOptimal);
+
+      std::array<vk::WriteDescriptorSet, 2> writes = {};
+      writes[0].dstSet = *texture.descriptorSets[i];
+      writes[0].dstBinding = 0;
+      writes[0].descriptorCount = 1;
+      writes[0].descriptorType = vk::DescriptorType::eUniformBufferDynamic;
+      writes[0].pBufferInfo = &bufferInfo;
+      writes[1].dstSet = *texture.descriptorSets[i];
+      writes[1].dstBinding = 1;
+      writes[1].descriptorCount = 1;
+      writes[1].descriptorType = vk::DescriptorType::eCombinedImageSampler;
+      writes[1].pImageInfo = &imageInfo;
+      device.updateDescriptorSets(writes, {});
+    }
+  }
+}
+
+/**
+ * @brief Allocates the meshlet cull pass descriptor sets.
+ *
+ * @details Binding 0 meshlets, 1 draw commands, 2 counters. Runs once the
+ * model is resident, since the meshlet buffer is sized from the model.
+ */
+void VulkanRenderer::createCullDescriptorSets() {
+  if (!meshletCullingEnabled) {
+    return;
+  }
+
+  std::vector<vk::DescriptorSetLayout> cullLayouts(MAX_FRAMES_IN_FLIGHT,
+                                                   *cullDescriptorSetLayout);
+  vk::DescriptorSetAllocateInfo allocInfo;
+  allocInfo.descriptorPool = *descriptorPool;
+  allocInfo.descriptorSetCount = static_cast<uint32_t>(cullLayouts.size());
+  allocInfo.pSetLayouts = cullLayouts.data();
+  cullDescriptorSets = device.allocateDescriptorSets(allocInfo);
+
+  for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
+    std::array<vk::DescriptorBufferInfo, 3> bufferInfos = {
+        vk::DescriptorBufferInfo(*meshletBuffer, 0, vk::WholeSize),
+        vk::DescriptorBufferInfo(*drawCommandBuffers[i], 0, vk::WholeSize),
+        vk::DescriptorBufferInfo(*cullCounterBuffers[i], 0, vk::WholeSize)};
+
+    std::array<vk::WriteDescriptorSet, 3> writes = {};
+    for (uint32_t binding = 0; binding < writes.size(); binding++) {
+      writes[binding].dstSet = *cullDescriptorSets[i];
+      writes[binding].dstBinding = binding;
+      writes[binding].descriptorCount = 1;
+      writes[binding].descriptorType = vk::DescriptorType::eStorageBuffer;
+      writes[binding].pBufferInfo = &bufferInfos[binding];
+    }
+    device.updateDescriptorSets(writes, {});
   }
 }
 
@@ -918,10 +2318,14 @@ void VulkanRenderer::createDescriptorSets() {
  *
  * This function recalculates transformation matrices every frame, based on
  * elapsed time. It rotates the model, positions the camera, and updates
- * projection settings.
+ * projection settings. The same matrices are then used to frustum-cull the
+ * scene instances and pick, per instance, the model LOD whose projected
+ * error stays below LOD_PIXEL_ERROR (scene::batchInstances()); the visible
+ * instances' matrices go to this frame's partition of the frame ring,
+ * grouped by LOD, right after the UBO.
  *
- * @param[in] currentImage The index of the current frame (used to select
- * buffer).
+ * @param[in] currentImage The index of the current frame, whose ring
+ * partition is rewound (its fence has been waited on).
  *
  * @note This method uses GLM for matrix math and assumes right-handed
  * coordinates.
@@ -929,6 +2333,9 @@ void VulkanRenderer::createDescriptorSets() {
  * coordinate system.
  */
 void VulkanRenderer::updateUniformBuffer(uint32_t currentImage) {
+  // Everything this frame wrote to the ring last time has been consumed
+  frameRing->begin(currentImage);
+
   // Record the start time at the first call; static keeps it persistent
   static auto startTime = std::chrono::high_resolution_clock::now();
 
@@ -944,8 +2351,9 @@ void VulkanRenderer::updateUniformBuffer(uint32_t currentImage) {
                           time * glm::radians(90.0f),   // Rotate 90°/s
                           glm::vec3(0.0f, 0.0f, 1.0f)); // Z-axis
 
-  // View matrix: camera positioned at (2,2,2), looking at origin
-  ubo.view = glm::lookAt(glm::vec3(2.0f, 2.0f, 2.0f),  // Eye/camera position
+  // View matrix: camera on the (1,1,1) diagonal, looking at origin
+  glm::vec3 eye = glm::vec3(cameraDistance / std::sqrt(3.0f));
+  ubo.view = glm::lookAt(eye,                          // Eye/camera position
                          glm::vec3(0.0f, 0.0f, 0.0f),  // Look-at target
                          glm::vec3(0.0f, 0.0f, 1.0f)); // Up vector (Z-up)
 
@@ -954,57 +2362,180 @@ void VulkanRenderer::updateUniformBuffer(uint32_t currentImage) {
       glm::radians(45.0f),
       static_cast<float>(swapChainExtent.width) /
           static_cast<float>(swapChainExtent.height), // Aspect ratio
-      0.1f, 10.0f);                                   // Near/far planes
+      0.1f, std::max(10.0f, 2.0f * cameraDistance));  // Near/far planes
 
   // Flip Y coordinate to match Vulkan's coordinate system (inverted compared to
   // OpenGL)
   ubo.proj[1][1] *= -1;
 
-  // Copy the uniform buffer object into the mapped memory of the current frame
-  // This updates the GPU-accessible buffer immediately
-  memcpy(uniformBuffersMapped[currentImage], &ubo, sizeof(ubo));
+  // Copy the uniform buffer object into this frame's ring partition; its
+  // offset is the dynamic offset recordCommandBuffer() binds. Each instance
+  // matrix carries its world transform and the rotation ('ubo.model'), so
+  // the uniform model matrix only dequantizes the packed positions.
+  UniformBufferObject gpuUbo = ubo;
+  if (modelResident) {
+    gpuUbo.model = packedVertices.positionTransform();
+  }
+  uniformOffset = static_cast<uint32_t>(frameRing->push(gpuUbo));
+
+  // Model data is owned by the loader thread until it is resident
+  if (!modelResident) {
+    instanceBatches = {};
+    return;
+  }
+
+  // Cull the instances, pick each one's LOD and write their matrices
+  // grouped by LOD for recordCommandBuffer()
+  {
+    PROFILE_SCOPE("batchInstances()");
+    scene::BatchParams params;
+    params.meshId = sceneMeshId;
+    params.local = ubo.model;
+    params.view = ubo.view;
+    params.proj = ubo.proj;
+    params.boundsMin = modelBoundsMin;
+    params.boundsMax = modelBoundsMax;
+    params.lods = modelLods;
+    params.viewportHeight = static_cast<float>(swapChainExtent.height);
+    params.maxPixelError = LOD_PIXEL_ERROR;
+    const std::span<glm::mat4> instances =
+        frameRing->allocateArray<glm::mat4>(instanceWorlds.size());
+    instanceOffset = frameRing->offsetOf(instances.data());
+    scene::batchInstances(instanceWorlds, sceneData.instances.meshIds,
+                          params, instances, instanceBatches);
+  }
+  PROFILE_COUNTER("Instances visible", instanceBatches.visible);
+  PROFILE_COUNTER("Instances culled", instanceBatches.culled);
+
+  const std::vector<uint32_t> &lodCounts = instanceBatches.lodCount;
+  currentLod = static_cast<uint32_t>(
+      std::find_if(lodCounts.begin(), lodCounts.end(),
+                   [](uint32_t count) { return count > 0; }) -
+      lodCounts.begin());
+  if (currentLod == lodCounts.size()) {
+    currentLod = 0; // Nothing visible
+  }
+
+  // Texture mip needed for the largest instance on screen this frame
+  if (TEXTURE_STREAMING && textureResident && instanceBatches.visible > 0) {
+    const float coverage = instanceBatches.maxPixelsPerUnit *
+                           glm::length(modelBoundsMax - modelBoundsMin);
+    textureResidency.desiredMip =
+        texstream::desiredMip(textureLevels[0].width, textureLevels[0].height,
+                              coverage, textureResidency.mipCount);
+  }
+
+  // Frustum planes + camera position for the meshlet cull pass (enabled
+  // only for a single instance, see loadScene())
+  if (meshletCullingEnabled) {
+    const std::vector<uint32_t> &meshIds = sceneData.instances.meshIds;
+    const size_t instance =
+        std::find(meshIds.begin(), meshIds.end(), sceneMeshId) -
+        meshIds.begin();
+    cullParams = meshlet::makeCullParams(instanceWorlds[instance] * ubo.model,
+                                         ubo.view, ubo.proj,
+                                         modelMeshlets.lodRanges[currentLod]);
+  }
 }
 
 /**
- * @brief Allocates and maps uniform buffers for each frame.
+ * @brief Allocates and maps the frame ring buffer.
  *
- * Each frame in flight gets its own uniform buffer to avoid race conditions
- * between CPU and GPU. These buffers store the transformation matrices
- * updated by @ref updateUniformBuffer().
+ * @details One host-visible coherent buffer holds every frame's uniforms
+ * and instance matrices, partitioned per frame in flight so the CPU never
+ * writes a range the GPU may still read. Ranges are aligned to
+ * minUniformBufferOffsetAlignment (a dynamic offset must be), which also
+ * satisfies the instance vertex binding. Each partition gets
+ * FRAME_RING_BYTES, or more if the scene's instances need it.
  *
- * @note Uses 'createBuffer()' helper to allocate buffer and memory.
  * @see updateUniformBuffer()
  */
-void VulkanRenderer::createUniformBuffers() {
-  // Clear any existing buffers or memory references before allocation
-  uniformBuffers.clear();
-  uniformBuffersMemory.clear();
-  uniformBuffersMapped.clear();
+void VulkanRenderer::createFrameRing() {
+  const vk::DeviceSize alignment = std::max<vk::DeviceSize>(
+      physicalGPU.getProperties().limits.minUniformBufferOffsetAlignment,
+      alignof(glm::mat4));
+  const vk::DeviceSize needed =
+      (sizeof(UniformBufferObject) + alignment) +
+      (sizeof(glm::mat4) * instanceWorlds.size() + alignment);
+  const vk::DeviceSize partition =
+      (std::max<vk::DeviceSize>(FRAME_RING_BYTES, needed) + alignment - 1) /
+      alignment * alignment;
+
+  createBuffer(partition * MAX_FRAMES_IN_FLIGHT,
+               vk::BufferUsageFlagBits::eUniformBuffer |
+                   vk::BufferUsageFlagBits::eVertexBuffer,
+               vk::MemoryPropertyFlagBits::eHostVisible |
+                   vk::MemoryPropertyFlagBits::eHostCoherent,
+               frameRingBuffer, frameRingMemory);
+  frameRing.emplace(frameRingMemory.mapped(), partition * MAX_FRAMES_IN_FLIGHT,
+                    MAX_FRAMES_IN_FLIGHT, alignment);
+}
 
-  // Loop over each frame in flight and create a separate uniform buffer
-  for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
-    // Each uniform buffer holds a UniformBufferObject (model, view, proj
-    // matrices)
-    vk::DeviceSize bufferSize = sizeof(UniformBufferObject);
+/**
+ * @details
+ * The renderer holds one model, so only the scene mesh whose model is
+ * MODEL_PATH is drawn; instances of other meshes are reported and skipped.
+ * A missing or invalid scene, or one that does not reference MODEL_PATH,
+ * falls back to one instance at the origin, which renders exactly like the
+ * renderer did before scenes existed.
+ *
+ * GPU meshlet culling tests one model transform, so it is turned off when
+ * more than one instance is drawn; the instances are frustum-culled on the
+ * CPU instead (see updateUniformBuffer()). Runs before startAssetLoads(),
+ * since buildModel() only builds meshlets when that culling is enabled.
+ */
+void VulkanRenderer::loadScene() {
+  const auto start = std::chrono::high_resolution_clock::now();
+  const scene::MeshAsset model{MODEL_PATH, TEXTURE_PATH};
+  sceneData = scene::single(model);
+  if (std::filesystem::exists(SCENE_PATH)) {
+    try {
+      sceneData = scene::load(SCENE_PATH);
+    } catch (const std::exception &e) {
+      std::cerr << "Warning: " << e.what() << std::endl;
+    }
+  } else {
+    std::cout << "Scene: " << SCENE_PATH << " not found (see tools/scenegen)"
+              << std::endl;
+  }
 
-    // Temporary buffer and memory handles to pass to createBuffer()
-    vk::raii::Buffer buffer({});
-    vk::raii::DeviceMemory bufferMem({});
+  const auto normal = [](const std::string &path) {
+    return std::filesystem::path(path).lexically_normal().generic_string();
+  };
+  const auto mesh = std::find_if(
+      sceneData.meshes.begin(), sceneData.meshes.end(),
+      [&](const scene::MeshAsset &m) {
+        return normal(m.model) == normal(MODEL_PATH);
+      });
+  sceneMeshId = static_cast<uint32_t>(mesh - sceneData.meshes.begin());
+  if (mesh == sceneData.meshes.end()) {
+    std::cerr << "Warning: " << SCENE_PATH << " does not reference "
+              << MODEL_PATH << ", drawing one instance of it" << std::endl;
+    sceneData = scene::single(model);
+    sceneMeshId = 0;
+  }
 
-    // Create the buffer: host-visible and coherent for CPU writes
-    createBuffer(bufferSize, vk::BufferUsageFlagBits::eUniformBuffer,
-                 vk::MemoryPropertyFlagBits::eHostVisible |
-                     vk::MemoryPropertyFlagBits::eHostCoherent,
-                 buffer, bufferMem);
+  const std::vector<uint32_t> &meshIds = sceneData.instances.meshIds;
+  const size_t drawn = std::count(meshIds.begin(), meshIds.end(), sceneMeshId);
+  if (drawn < meshIds.size()) {
+    std::cerr << "Warning: skipping " << meshIds.size() - drawn
+              << " scene instances of meshes other than " << MODEL_PATH
+              << std::endl;
+  }
 
-    // Store the buffer and its memory in the class vectors
-    uniformBuffers.emplace_back(std::move(buffer));
-    uniformBuffersMemory.emplace_back(std::move(bufferMem));
+  instanceWorlds.resize(sceneData.instances.size());
+  scene::computeMatrices(sceneData.instances, instanceWorlds);
 
-    // Map the buffer memory for CPU access and store the pointer
-    uniformBuffersMapped.emplace_back(
-        uniformBuffersMemory[i].mapMemory(0, bufferSize));
+  if (drawn > 1 && meshletCullingEnabled) {
+    meshletCullingEnabled = false;
+    std::cout << "Scene: meshlet culling disabled for " << drawn
+              << " instances (instances are culled on the CPU)" << std::endl;
   }
+  std::cout << "Scene: " << drawn << " instances of " << MODEL_PATH << " in "
+            << std::chrono::duration<double, std::milli>(
+                   std::chrono::high_resolution_clock::now() - start)
+                   .count()
+            << " ms" << std::endl;
 }
 
 /**
@@ -1013,7 +2544,8 @@ void VulkanRenderer::createUniformBuffers() {
  *
  * This layout defines how shader stages access resources (uniform buffers and
  * combined image samplers). The layout has two bindings:
- * - Binding 0: Vertex shader uniform buffer (e.g., transformation matrices)
+ * - Binding 0: Vertex shader dynamic uniform buffer (transformation
+ *   matrices, in the frame ring)
  * - Binding 1: Fragment shader texture sampler
  *
  * @note Must be created before allocating descriptor sets.
@@ -1024,10 +2556,11 @@ void VulkanRenderer::createDescriptorSetLayout() {
   // Step 1: Prepare descriptor set layout bindings array (two bindings)
   std::array<vk::DescriptorSetLayoutBinding, 2> bindings = {};
 
-  // Step 2: Define binding 0 for a uniform buffer accessed by the vertex shader
+  // Step 2: Define binding 0 for a uniform buffer accessed by the vertex
+  // shader, at a dynamic offset into the frame ring
   bindings[0] = vk::DescriptorSetLayoutBinding(
-      0,                                  // Binding index
-      vk::DescriptorType::eUniformBuffer, // Descriptor type
+      0,                                         // Binding index
+      vk::DescriptorType::eUniformBufferDynamic, // Descriptor type
       1,                                // Number of descriptors in this binding
       vk::ShaderStageFlagBits::eVertex, // Shader stage visibility
       nullptr // Optional sampler (not needed for uniform buffer)
@@ -1054,65 +2587,30 @@ void VulkanRenderer::createDescriptorSetLayout() {
   // Now descriptorSetLayout can be used when creating descriptor sets
 }
 
+namespace {
+
 /**
- * @brief Copies data from one Vulkan buffer to another using a command buffer.
- *
- * @param[in,out] srcBuffer The source buffer containing data.
- * @param[in,out] dstBuffer The destination buffer to receive data.
- * @param[in] size The number of bytes to copy.
- *
- * @details
- * A temporary command buffer is allocated, commands are recorded to perform
- * the copy, and then it is submitted and waited upon. This is typically used
- * to move data from a host-visible staging buffer to a device-local buffer.
- *
- * @note This function blocks until the copy finishes (uses
- * 'graphicsQueue.waitIdle()').
- * @warning This should not be used in performance-critical paths; for large
- * transfers, batch operations are preferable.
+ * @brief Memory accounting category of a buffer, from its usage flags.
+ * Buffers that are only ever copied from are staging buffers.
  */
-void VulkanRenderer::copyBuffer(vk::raii::Buffer &srcBuffer,
-                                vk::raii::Buffer &dstBuffer,
-                                vk::DeviceSize size) {
-  // Step 1: Set up command buffer allocation info
-  vk::CommandBufferAllocateInfo allocInfo{};
-  allocInfo.commandPool = *commandPool; // Command pool to allocate from
-  allocInfo.level = vk::CommandBufferLevel::ePrimary; // Primary command buffer
-  allocInfo.commandBufferCount = 1; // Allocate a single command buffer
-
-  // Step 2: Allocate the command buffer
-  auto commandBuffers = device.allocateCommandBuffers(allocInfo);
-  vk::CommandBuffer commandBuffer = *commandBuffers[0];
-
-  // Step 3: Begin recording commands in a one-time submit buffer
-  vk::CommandBufferBeginInfo beginInfo{};
-  beginInfo.flags =
-      vk::CommandBufferUsageFlagBits::eOneTimeSubmit; // Optimization hint
-  commandBuffer.begin(beginInfo);
-
-  // Step 4: Define the region of memory to copy
-  vk::BufferCopy copyRegion{};
-  copyRegion.size = size; // Copy the full size requested
-
-  // Step 5: Record the buffer copy command
-  commandBuffer.copyBuffer(*srcBuffer, *dstBuffer, copyRegion);
-
-  // Step 6: Finish recording the command buffer
-  commandBuffer.end();
-
-  // Step 7: Set up submission info for the graphics queue
-  vk::SubmitInfo submitInfo{};
-  submitInfo.commandBufferCount = 1;           // Only one command buffer
-  submitInfo.pCommandBuffers = &commandBuffer; // Pointer to the command buffer
-
-  // Step 8: Submit the command buffer to the graphics queue
-  graphicsQueue.submit(submitInfo, nullptr);
-
-  // Step 9: Wait for the copy operation to complete
-  graphicsQueue
-      .waitIdle(); // Ensures the buffer is fully copied before returning
+GpuAllocator::Category bufferCategory(vk::BufferUsageFlags usage) {
+  if (usage & vk::BufferUsageFlagBits::eVertexBuffer) {
+    return GpuAllocator::Category::eVertex;
+  }
+  if (usage & vk::BufferUsageFlagBits::eIndexBuffer) {
+    return GpuAllocator::Category::eIndex;
+  }
+  if (usage & vk::BufferUsageFlagBits::eUniformBuffer) {
+    return GpuAllocator::Category::eUniform;
+  }
+  if (usage == vk::BufferUsageFlagBits::eTransferSrc) {
+    return GpuAllocator::Category::eStaging;
+  }
+  return GpuAllocator::Category::eOther;
 }
 
+} // namespace
+
 /**
  * @brief Creates a Vulkan buffer and allocates memory for it.
  *
@@ -1129,17 +2627,22 @@ void VulkanRenderer::copyBuffer(vk::raii::Buffer &srcBuffer,
  * 1. Fills in buffer creation info (size, usage, sharing mode).
  * 2. Creates the buffer object.
  * 3. Queries the buffer's memory requirements.
- * 4. Allocates device memory of the correct type.
+ * 4. Sub-allocates memory of the correct type from the GpuAllocator
+ *    (transient buffers from its linear blocks), accounted to the category
+ *    its usage flags imply (bufferCategory()).
  * 5. Binds the allocated memory to the buffer.
  *
- * @see findMemoryType()
- * @see copyBuffer()
+ * Host-visible memory stays mapped; use bufferMemory.mapped().
+ *
+ * @see GpuAllocator
+ * @see UploadQueue::copy()
  */
 void VulkanRenderer::createBuffer(vk::DeviceSize size,
                                   vk::BufferUsageFlags usage,
                                   vk::MemoryPropertyFlags properties,
                                   vk::raii::Buffer &buffer,
-                                  vk::raii::DeviceMemory &bufferMemory) {
+                                  GpuAllocation &bufferMemory,
+                                  GpuAllocator::Usage lifetime) {
   // Step 1: Fill out buffer creation info
   vk::BufferCreateInfo bufferInfo{};
   bufferInfo.size = size;   // Size in bytes
@@ -1150,62 +2653,169 @@ void VulkanRenderer::createBuffer(vk::DeviceSize size,
   // Step 2: Create the Vulkan buffer object
   buffer = vk::raii::Buffer(device, bufferInfo);
 
-  // Step 3: Retrieve memory requirements for the buffer
-  vk::MemoryRequirements memRequirements = buffer.getMemoryRequirements();
+  // Steps 3-5: Sub-allocate memory of a suitable type and bind it
+  bufferMemory = allocator->allocate(buffer, properties, bufferCategory(usage),
+                                     lifetime);
+}
+
+/**
+ * @details
+ * Import path (VK_EXT_external_memory_host): the range is widened to
+ * 'hostImportAlignment' and must still lie inside the asset pack, whose
+ * blobs and total size are page aligned. The pages are wrapped in a buffer
+ * bound to imported memory, so the GPU reads the mapping itself and no
+ * CPU copy is made. Drivers may refuse pointers into a read-only file
+ * mapping; the first failure is reported and disables the import.
+ *
+ * Copy path: a range of 'stagingPool'; the caller releases it once the
+ * copy has completed.
+ *
+ * Either way the bytes are added to 'stagedBytesImported' or
+ * 'stagedBytesCopied', which reportLoadMetrics() prints.
+ */
+StagingPool::Range
+VulkanRenderer::stageBytes(std::span<const std::byte> bytes,
+                           vk::raii::Buffer &importBuffer,
+                           GpuAllocation &importMemory) {
+  if (hostImportAlignment != 0 && assetPack && !bytes.empty()) {
+    const std::span<const std::byte> pack = assetPack->bytes();
+    const auto packBegin = reinterpret_cast<uintptr_t>(pack.data());
+    const auto begin = reinterpret_cast<uintptr_t>(bytes.data());
+    const uintptr_t first = begin / hostImportAlignment * hostImportAlignment;
+    const uintptr_t last = (begin + bytes.size() + hostImportAlignment - 1) /
+                           hostImportAlignment * hostImportAlignment;
+    if (first >= packBegin && last <= packBegin + pack.size()) {
+      try {
+        const vk::DeviceSize size = last - first;
+        void *pointer = reinterpret_cast<void *>(first);
+        constexpr auto handleType =
+            vk::ExternalMemoryHandleTypeFlagBits::eHostAllocationEXT;
+
+        vk::StructureChain<vk::BufferCreateInfo,
+                           vk::ExternalMemoryBufferCreateInfo>
+            bufferInfo;
+        bufferInfo.get<vk::BufferCreateInfo>().size = size;
+        bufferInfo.get<vk::BufferCreateInfo>().usage =
+            vk::BufferUsageFlagBits::eTransferSrc;
+        bufferInfo.get<vk::BufferCreateInfo>().sharingMode =
+            vk::SharingMode::eExclusive;
+        bufferInfo.get<vk::ExternalMemoryBufferCreateInfo>().handleTypes =
+            handleType;
+        importBuffer =
+            vk::raii::Buffer(device, bufferInfo.get<vk::BufferCreateInfo>());
+
+        const vk::MemoryRequirements requirements =
+            importBuffer.getMemoryRequirements();
+        const vk::MemoryHostPointerPropertiesEXT hostProperties =
+            device.getMemoryHostPointerPropertiesEXT(handleType, pointer);
+        if (requirements.size > size) {
+          throw std::runtime_error("imported range too small for buffer");
+        }
+
+        vk::StructureChain<vk::MemoryAllocateInfo,
+                           vk::ImportMemoryHostPointerInfoEXT>
+            allocInfo;
+        allocInfo.get<vk::MemoryAllocateInfo>().allocationSize = size;
+        allocInfo.get<vk::MemoryAllocateInfo>().memoryTypeIndex =
+            findMemoryType(requirements.memoryTypeBits &
+                               hostProperties.memoryTypeBits,
+                           {});
+        allocInfo.get<vk::ImportMemoryHostPointerInfoEXT>().handleType =
+            handleType;
+        allocInfo.get<vk::ImportMemoryHostPointerInfoEXT>().pHostPointer =
+            pointer;
+        vk::raii::DeviceMemory imported(
+            device, allocInfo.get<vk::MemoryAllocateInfo>());
+        importBuffer.bindMemory(*imported, 0);
+        importMemory = allocator->adopt(
+            std::move(imported), size,
+            allocInfo.get<vk::MemoryAllocateInfo>().memoryTypeIndex,
+            GpuAllocator::Category::eStaging);
+
+        stagedBytesImported += bytes.size();
+        return StagingPool::Range{*importBuffer, begin - first, bytes.size()};
+      } catch (const std::exception &e) {
+        std::cerr << "Warning: host memory import failed (" << e.what()
+                  << "), copying asset pack blobs instead" << std::endl;
+        hostImportAlignment = 0;
+        importBuffer = nullptr;
+        importMemory = nullptr;
+      }
+    }
+  }
 
-  // Step 4: Allocate memory for the buffer
-  vk::MemoryAllocateInfo allocInfo{};
-  allocInfo.allocationSize = memRequirements.size; // Required memory size
-  allocInfo.memoryTypeIndex = findMemoryType(
-      memRequirements.memoryTypeBits, properties); // Find suitable memory type
+  stagedBytesCopied += bytes.size();
+  return stagingPool->upload(bytes);
+}
 
-  bufferMemory = vk::raii::DeviceMemory(device, allocInfo);
+/**
+ * @details The arena's buffers cannot grow in place, since draws address
+ * meshes by offset. When the model does not fit, the arena is retired (after
+ * any mesh of it retired earlier, so those free their ranges first) and a
+ * new one at least twice the model's size takes its place.
+ */
+void VulkanRenderer::allocateModelGeometry() {
+  const uint32_t stride = packedVertices.stride;
+  const auto vertexCount =
+      static_cast<uint32_t>(packedVertices.data.size() / stride);
+  const auto indexCount = static_cast<uint32_t>(modelIndices.size());
+
+  modelGeometry = geometryArena->allocate(vertexCount, stride, indexCount);
+  if (modelGeometry) {
+    return;
+  }
 
-  // Step 5: Bind the allocated memory to the buffer
-  buffer.bindMemory(*bufferMemory, 0);
+  const vk::DeviceSize vertexBytes =
+      std::max(GeometryArena::kVertexBytes,
+               2 * (static_cast<vk::DeviceSize>(vertexCount) + 1) * stride);
+  const auto indexCapacity = static_cast<uint32_t>(
+      std::min<uint64_t>(std::max<uint64_t>(GeometryArena::kIndexCount,
+                                            2ull * indexCount),
+                         std::numeric_limits<uint32_t>::max()));
+  std::cout << "Geometry arena full, growing to " << (vertexBytes >> 20)
+            << " MiB of vertices and " << indexCapacity << " indices"
+            << std::endl;
+  retireQueue.retire(frameNumber, std::move(geometryArena));
+  geometryArena = std::make_unique<GeometryArena>(
+      device, *allocator, vertexBytes, indexCapacity, vertexPullingEnabled);
+  modelGeometry = geometryArena->allocate(vertexCount, stride, indexCount);
+  if (!modelGeometry) {
+    throw std::runtime_error("Failed to allocate model geometry");
+  }
 }
 
 /**
- * @brief Creates the index buffer for drawing geometry.
+ * @brief Uploads the indices into the model's range of the shared index
+ * buffer.
  *
  * @details
- * Creates a host-visible staging buffer, copies the index data into it, then
- * creates a device-local index buffer and transfers the data using
- * 'copyBuffer()'. This ensures efficient GPU access for rendering.
+ * Stages the index data with 'stageBytes()' (a copy into a staging pool
+ * range, or an import when the indices live in the asset pack), then queues
+ * the copy to the range of 'geometryArena' reserved by
+ * allocateModelGeometry() on 'uploadQueue'. An imported buffer is kept
+ * alive until the copy has completed.
  *
  * @note Index buffer allows reusing vertex data for multiple primitives.
- * @see copyBuffer()
- * @see createBuffer()
+ * @see UploadQueue::copy()
  */
 void VulkanRenderer::createIndexBuffer() {
-  vk::DeviceSize bufferSize = sizeof(indices[0]) * indices.size();
-
-  // Create a host-visible staging buffer
-  vk::raii::Buffer stagingBuffer({});
-  vk::raii::DeviceMemory stagingBufferMemory({});
-  createBuffer(bufferSize, vk::BufferUsageFlagBits::eTransferSrc,
-               vk::MemoryPropertyFlagBits::eHostVisible |
-                   vk::MemoryPropertyFlagBits::eHostCoherent,
-               stagingBuffer, stagingBufferMemory);
-
-  // Map memory and copy index data into the staging buffer
-  void *data = stagingBufferMemory.mapMemory(0, bufferSize);
-  memcpy(data, indices.data(), (size_t)bufferSize);
-  stagingBufferMemory.unmapMemory();
-
-  // Create a device-local buffer for efficient GPU access
-  createBuffer(bufferSize,
-               vk::BufferUsageFlagBits::eTransferDst |
-                   vk::BufferUsageFlagBits::eIndexBuffer,
-               vk::MemoryPropertyFlagBits::eDeviceLocal, indexBuffer,
-               indexBufferMemory);
-
-  // Copy data from staging buffer to device-local index buffer
-  copyBuffer(stagingBuffer, indexBuffer, bufferSize);
+  // Stage the indices (copied, or imported straight from the asset pack)
+  vk::raii::Buffer importBuffer = nullptr;
+  GpuAllocation importMemory = nullptr;
+  const StagingPool::Range staging =
+      stageBytes(std::as_bytes(modelIndices), importBuffer, importMemory);
+
+  // Copy data from staging buffer to the model's index range
+  geometryUpload = uploadQueue->copy(
+      staging, *geometryArena->indexBuffer(), modelGeometry.indexBytes(),
+      vk::PipelineStageFlagBits2::eIndexInput,
+      vk::AccessFlagBits2::eIndexRead);
+  uploadQueue->keepAlive(std::move(importBuffer), std::move(importMemory));
 }
 
 /**
- * @brief Creates the vertex buffer for rendering geometry.
+ * @brief Uploads the packed vertices into the model's range of the shared
+ * vertex buffer.
  *
  * @details
  * Uses a staging buffer approach similar to 'createIndexBuffer()' to ensure
@@ -1215,30 +2825,114 @@ void VulkanRenderer::createIndexBuffer() {
  * @warning Ensure vertex structure matches the shader input layout.
  */
 void VulkanRenderer::createVertexBuffer() {
-  vk::DeviceSize bufferSize = sizeof(vertices[0]) * vertices.size();
+  // Copy the packed vertex data into a (mapped) staging range
+  const StagingPool::Range staging =
+      stagingPool->upload(std::as_bytes(std::span(packedVertices.data)));
+
+  // Transfer data from staging range to the model's vertex range (read by
+  // vertex input, or by the vertex shader with vertex pulling)
+  geometryUpload = uploadQueue->copy(
+      staging, *geometryArena->vertexBuffer(), modelGeometry.vertexBytes(),
+      vk::PipelineStageFlagBits2::eVertexAttributeInput |
+          vk::PipelineStageFlagBits2::eVertexShader,
+      vk::AccessFlagBits2::eVertexAttributeRead |
+          vk::AccessFlagBits2::eShaderStorageRead);
+  if (vertexPullingEnabled) {
+    pullConstants = vertexpull::pushConstants(geometryArena->vertexAddress(),
+                                              packedVertices);
+  }
 
-  // Create a host-visible staging buffer
-  vk::raii::Buffer stagingBuffer = nullptr;
-  vk::raii::DeviceMemory stagingBufferMemory = nullptr;
-  createBuffer(bufferSize, vk::BufferUsageFlagBits::eTransferSrc,
-               vk::MemoryPropertyFlagBits::eHostVisible |
-                   vk::MemoryPropertyFlagBits::eHostCoherent,
-               stagingBuffer, stagingBufferMemory);
+  // The packed copy is only needed for the upload
+  packedVertices.data.clear();
+  packedVertices.data.shrink_to_fit();
+}
+
+/**
+ * @brief Creates the buffers used by the meshlet cull pass.
+ *
+ * @details
+ * - The meshlet array is uploaded once to a device-local storage buffer.
+ * - Each frame in flight gets its own indirect draw buffer (written by the
+ *   compute pass, read by vkCmdDrawIndexedIndirectCount), sized for the LOD
+ *   with the most meshlets.
+ * - Each frame in flight also gets a small host-visible counter buffer:
+ *   meshlet::CullCounters, whose statistics the CPU reads after the frame's
+ *   fence has signaled, followed by one draw count per submesh of a LOD.
+ *
+ * @note Does nothing when meshlet culling is disabled or unsupported.
+ */
+void VulkanRenderer::createMeshletBuffers() {
+  if (!meshletCullingEnabled) {
+    return;
+  }
 
-  // Map memory and copy vertex data into staging buffer
-  void *data = stagingBufferMemory.mapMemory(0, bufferSize);
-  memcpy(data, vertices.data(), (size_t)bufferSize);
-  stagingBufferMemory.unmapMemory();
+  // Meshlets: staging upload to device-local storage buffer, addressing the
+  // model's ranges of the geometry arena
+  std::vector<meshlet::Meshlet> meshlets = modelMeshlets.meshlets;
+  for (meshlet::Meshlet &cluster : meshlets) {
+    cluster.indexOffset += modelGeometry.firstIndex();
+    cluster.vertexOffset = modelGeometry.vertexOffset();
+  }
+  vk::DeviceSize bufferSize = sizeof(meshlet::Meshlet) * meshlets.size();
+  const StagingPool::Range staging =
+      stagingPool->upload(std::as_bytes(std::span(meshlets)));
 
-  // Create a device-local vertex buffer
   createBuffer(bufferSize,
-               vk::BufferUsageFlagBits::eVertexBuffer |
+               vk::BufferUsageFlagBits::eStorageBuffer |
                    vk::BufferUsageFlagBits::eTransferDst,
-               vk::MemoryPropertyFlagBits::eDeviceLocal, vertexBuffer,
-               vertexBufferMemory);
+               vk::MemoryPropertyFlagBits::eDeviceLocal, meshletBuffer,
+               meshletBufferMemory);
+  geometryUpload = uploadQueue->copy(
+      staging, *meshletBuffer, 0, vk::PipelineStageFlagBits2::eComputeShader,
+      vk::AccessFlagBits2::eShaderStorageRead);
+
+  // Per-frame draw command and counter buffers
+  uint32_t maxDraws = 0;
+  for (const meshlet::MeshletRange &range : modelMeshlets.lodRanges) {
+    maxDraws = std::max(maxDraws, range.count);
+  }
+  uint32_t maxSubmeshes = 0;
+  for (size_t level = 0; level + 1 < lodSubmeshStart.size(); level++) {
+    maxSubmeshes = std::max(maxSubmeshes, lodSubmeshStart[level + 1] -
+                                              lodSubmeshStart[level]);
+  }
+  const vk::DeviceSize counterSize =
+      sizeof(meshlet::CullCounters) + sizeof(uint32_t) * maxSubmeshes;
+
+  drawCommandBuffers.clear();
+  drawCommandBuffersMemory.clear();
+  cullCounterBuffers.clear();
+  cullCounterBuffersMemory.clear();
+  cullCountersMapped.clear();
 
-  // Transfer data from staging buffer to device-local vertex buffer
-  copyBuffer(stagingBuffer, vertexBuffer, bufferSize);
+  for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
+    vk::raii::Buffer drawBuffer = nullptr;
+    GpuAllocation drawMemory = nullptr;
+    createBuffer(sizeof(vk::DrawIndexedIndirectCommand) * maxDraws,
+                 vk::BufferUsageFlagBits::eStorageBuffer |
+                     vk::BufferUsageFlagBits::eIndirectBuffer,
+                 vk::MemoryPropertyFlagBits::eDeviceLocal, drawBuffer,
+                 drawMemory);
+    drawCommandBuffers.emplace_back(std::move(drawBuffer));
+    drawCommandBuffersMemory.emplace_back(std::move(drawMemory));
+
+    vk::raii::Buffer counterBuffer = nullptr;
+    GpuAllocation counterMemory = nullptr;
+    createBuffer(counterSize,
+                 vk::BufferUsageFlagBits::eStorageBuffer |
+                     vk::BufferUsageFlagBits::eIndirectBuffer |
+                     vk::BufferUsageFlagBits::eTransferDst,
+                 vk::MemoryPropertyFlagBits::eHostVisible |
+                     vk::MemoryPropertyFlagBits::eHostCoherent,
+                 counterBuffer, counterMemory);
+    cullCounterBuffers.emplace_back(std::move(counterBuffer));
+    cullCounterBuffersMemory.emplace_back(std::move(counterMemory));
+
+    auto *counters = static_cast<meshlet::CullCounters *>(
+        cullCounterBuffersMemory[i].mapped());
+    memset(counters, 0, counterSize);
+    cullCountersMapped.push_back(counters);
+  }
 }
 
 /**
@@ -1327,6 +3021,25 @@ void VulkanRenderer::createSyncObjects() {
   }
 }
 
+/**
+ * @brief Publishes the previous cull results of the current frame slot.
+ *
+ * @details Called right after the slot's fence wait, so the compute writes
+ * of that submission are complete and (through the host barrier recorded in
+ * recordCullPass()) visible in the mapped counter buffer.
+ */
+void VulkanRenderer::readCullCounters() {
+  if (!meshletCullingEnabled || !modelResident) {
+    return;
+  }
+
+  const meshlet::CullCounters &counters = *cullCountersMapped[currentFrame];
+  PROFILE_COUNTER("Visible meshlets", counters.drawCount);
+  PROFILE_COUNTER("Culled meshlets", counters.culledMeshlets);
+  PROFILE_COUNTER("Visible triangles", counters.visibleTriangles);
+  PROFILE_COUNTER("Culled triangles", counters.culledTriangles);
+}
+
 /**
  * @brief Draws a single frame in the Vulkan render loop.
  *
@@ -1335,12 +3048,15 @@ void VulkanRenderer::createSyncObjects() {
  * commands, submits them, and presents the rendered image.
  *
  * Steps:
- * 1. Wait for previous frame fence
+ * 1. Wait for previous frame fence, release retired objects it used and
+ *    apply finished loads and hot reloads, submitting their uploads as one
+ *    batch
  * 2. Acquire next swapchain image
  * 3. Update uniform buffer
  * 4. Reset fence and command buffer
  * 5. Record command buffer
- * 6. Submit draw commands and signal semaphores
+ * 6. Submit draw commands (after the uploads they use) and signal
+ *    semaphores
  * 7. Present the image
  *
  * @note Automatically recreates the swapchain if needed.
@@ -1352,6 +3068,28 @@ void VulkanRenderer::drawFrame() {
       device.waitForFences(*inFlightFences[currentFrame], vk::True, UINT64_MAX))
     ;
 
+  // GPU culling results of this slot's previous frame are now readable
+  readCullCounters();
+
+  // Objects retired by hot reloads whose last frame has now completed
+  if (frameNumber >= MAX_FRAMES_IN_FLIGHT) {
+    retireQueue.collect(frameNumber - MAX_FRAMES_IN_FLIGHT);
+  }
+
+  // Completed upload batches hand their staging back; idle chunks beyond
+  // the few kept are freed
+  uploadQueue->collect();
+  stagingPool->collect();
+
+  // Upload assets that finished loading; this slot's descriptor set is idle
+  pollAssets(false);
+  updateHotReload();
+  updateTextureStreaming();
+  updateTextureDescriptor(currentFrame);
+
+  // Every copy queued above goes to the transfer queue as one batch
+  uploadQueue->submit();
+
   // Acquire next available swapchain image
   auto [result, imageIndex] = swapChain.acquireNextImage(
       UINT64_MAX, *presentCompleteSemaphores[currentFrame], nullptr);
@@ -1377,21 +3115,32 @@ void VulkanRenderer::drawFrame() {
   // Record rendering commands for this frame
   recordCommandBuffer(imageIndex);
 
-  // Prepare submission info for graphics queue
-  vk::PipelineStageFlags waitDestinationStageMask(
-      vk::PipelineStageFlagBits::eColorAttachmentOutput);
-
-  vk::SubmitInfo submitInfo;
-  submitInfo.waitSemaphoreCount = 1;
-  submitInfo.pWaitSemaphores = &*presentCompleteSemaphores[currentFrame];
-  submitInfo.pWaitDstStageMask = &waitDestinationStageMask;
-  submitInfo.commandBufferCount = 1;
-  submitInfo.pCommandBuffers = &*commandBuffers[currentFrame];
-  submitInfo.signalSemaphoreCount = 1;
-  submitInfo.pSignalSemaphores = &*renderFinishedSemaphores[currentFrame];
+  // Prepare submission info for graphics queue; a frame using new uploads
+  // also waits for their batch, only at the stages that read them
+  std::array<vk::SemaphoreSubmitInfo, 2> waitInfos;
+  waitInfos[0].semaphore = *presentCompleteSemaphores[currentFrame];
+  waitInfos[0].stageMask = vk::PipelineStageFlagBits2::eColorAttachmentOutput;
+  waitInfos[1].semaphore = *uploadQueue->semaphore();
+  waitInfos[1].value = uploadWait.value;
+  waitInfos[1].stageMask = uploadWait.stages;
+
+  vk::CommandBufferSubmitInfo commandBufferInfo;
+  commandBufferInfo.commandBuffer = *commandBuffers[currentFrame];
+
+  vk::SemaphoreSubmitInfo signalInfo;
+  signalInfo.semaphore = *renderFinishedSemaphores[currentFrame];
+  signalInfo.stageMask = vk::PipelineStageFlagBits2::eAllCommands;
+
+  vk::SubmitInfo2 submitInfo;
+  submitInfo.waitSemaphoreInfoCount = uploadWait.value > 0 ? 2 : 1;
+  submitInfo.pWaitSemaphoreInfos = waitInfos.data();
+  submitInfo.commandBufferInfoCount = 1;
+  submitInfo.pCommandBufferInfos = &commandBufferInfo;
+  submitInfo.signalSemaphoreInfoCount = 1;
+  submitInfo.pSignalSemaphoreInfos = &signalInfo;
 
   // Submit command buffer to graphics queue
-  graphicsQueue.submit(submitInfo, *inFlightFences[currentFrame]);
+  graphicsQueue.submit2(submitInfo, *inFlightFences[currentFrame]);
 
   // Prepare presentation info
   vk::PresentInfoKHR presentInfoKHR;
@@ -1413,8 +3162,12 @@ void VulkanRenderer::drawFrame() {
     throw std::runtime_error("failed to present swap chain image!");
   }
 
+  reportLoadMetrics();
+  reportMemoryStats();
+
   // Advance to the next frame in flight
   currentFrame = (currentFrame + 1) % MAX_FRAMES_IN_FLIGHT;
+  frameNumber++;
 }
 
 /**
@@ -1464,6 +3217,71 @@ void VulkanRenderer::transition_image_layout(
   commandBuffers[currentFrame].pipelineBarrier2(dependencyInfo);
 }
 
+/**
+ * @brief Records the meshlet cull compute pass for the current frame.
+ *
+ * @details
+ * 1. Zero the counter buffer (vkCmdFillBuffer) and make that visible to the
+ *    compute shader.
+ * 2. Dispatch one invocation per meshlet of the selected LOD, one dispatch
+ *    per submesh. Survivors are appended to the submesh's slice of the draw
+ *    command buffer with that submesh's atomic counter.
+ * 3. Make the commands and count visible to the indirect draw, and the
+ *    counters visible to the host for readCullCounters().
+ */
+void VulkanRenderer::recordCullPass() {
+  vk::raii::CommandBuffer &commandBuffer = commandBuffers[currentFrame];
+
+  commandBuffer.fillBuffer(*cullCounterBuffers[currentFrame], 0,
+                           vk::WholeSize, 0);
+
+  vk::MemoryBarrier2 clearBarrier;
+  clearBarrier.srcStageMask = vk::PipelineStageFlagBits2::eTransfer;
+  clearBarrier.srcAccessMask = vk::AccessFlagBits2::eTransferWrite;
+  clearBarrier.dstStageMask = vk::PipelineStageFlagBits2::eComputeShader;
+  clearBarrier.dstAccessMask = vk::AccessFlagBits2::eShaderStorageRead |
+                               vk::AccessFlagBits2::eShaderStorageWrite;
+
+  vk::DependencyInfo clearDependencyInfo;
+  clearDependencyInfo.memoryBarrierCount = 1;
+  clearDependencyInfo.pMemoryBarriers = &clearBarrier;
+  commandBuffer.pipelineBarrier2(clearDependencyInfo);
+
+  commandBuffer.bindPipeline(vk::PipelineBindPoint::eCompute, *cullPipeline);
+  commandBuffer.bindDescriptorSets(vk::PipelineBindPoint::eCompute,
+                                   *cullPipelineLayout, 0,
+                                   *cullDescriptorSets[currentFrame], nullptr);
+  // One dispatch per submesh: its survivors fill the draw slots of its
+  // meshlet range and are counted in their own count slot
+  const uint32_t firstSubmesh = lodSubmeshStart[currentLod];
+  for (uint32_t i = firstSubmesh; i < lodSubmeshStart[currentLod + 1]; i++) {
+    const meshlet::MeshletRange &range = modelMeshlets.submeshRanges[i];
+    meshlet::CullParams params = cullParams;
+    params.firstMeshlet = range.first;
+    params.meshletCount = range.count;
+    params.firstDraw = range.first - cullParams.firstMeshlet;
+    params.countSlot = i - firstSubmesh;
+    commandBuffer.pushConstants<meshlet::CullParams>(
+        *cullPipelineLayout, vk::ShaderStageFlagBits::eCompute, 0, params);
+    commandBuffer.dispatch(
+        (range.count + meshlet::kCullGroupSize - 1) / meshlet::kCullGroupSize,
+        1, 1);
+  }
+
+  vk::MemoryBarrier2 drawBarrier;
+  drawBarrier.srcStageMask = vk::PipelineStageFlagBits2::eComputeShader;
+  drawBarrier.srcAccessMask = vk::AccessFlagBits2::eShaderStorageWrite;
+  drawBarrier.dstStageMask = vk::PipelineStageFlagBits2::eDrawIndirect |
+                             vk::PipelineStageFlagBits2::eHost;
+  drawBarrier.dstAccessMask = vk::AccessFlagBits2::eIndirectCommandRead |
+                              vk::AccessFlagBits2::eHostRead;
+
+  vk::DependencyInfo drawDependencyInfo;
+  drawDependencyInfo.memoryBarrierCount = 1;
+  drawDependencyInfo.pMemoryBarriers = &drawBarrier;
+  commandBuffer.pipelineBarrier2(drawDependencyInfo);
+}
+
 /**
  * @brief Records rendering commands for the current frame into a command
  * buffer.
@@ -1472,10 +3290,19 @@ void VulkanRenderer::transition_image_layout(
  *
  * @details
  * This method performs all setup for rendering:
+ *  - Acquires the uploads of 'uploadQueue' the frame reads or that have
+ *    completed.
+ *  - Runs the meshlet cull pass (when enabled) before rendering begins.
  *  - Inserts pipeline barriers for color/depth transitions.
  *  - Begins dynamic rendering with multiple attachments.
- *  - Binds the graphics pipeline, vertex/index buffers, and descriptor sets.
- *  - Issues the draw command.
+ *  - Binds the vertex, instance and index buffers, then walks the draw list
+ *    (sorted by drawbatch key) of every LOD with visible instances, binding
+ *    the pipeline, descriptor set and material constants only when they
+ *    change.
+ *  - Issues one draw per submesh and LOD: an indirect-count draw of its
+ *    visible meshlets, or an instanced drawIndexed of its range covering
+ *    the instances updateUniformBuffer() assigned to that LOD.
+ *  - Publishes the draw calls and binds to ChronoProfiler.
  *  - Transitions the final image layout to present source.
  *
  * @note Uses Vulkan 1.3 dynamic rendering (no render pass object required).
@@ -1486,6 +3313,22 @@ void VulkanRenderer::recordCommandBuffer(uint32_t imageIndex) {
   // Begin recording commands for the current frame's command buffer
   commandBuffers[currentFrame].begin({});
 
+  // Take ownership of the uploads this frame reads (the model's geometry,
+  // a hot-reloaded texture) ahead of their first use, along with batches
+  // that have already completed; drawFrame() waits for the newest one
+  uint64_t neededUpload = modelResident ? geometryUpload : 0;
+  if (descriptorSetImageViews[currentFrame] == *textureImageView) {
+    neededUpload = std::max(neededUpload, textureUpload);
+  }
+  uploadWait = uploadQueue->acquire(commandBuffers[currentFrame],
+                                    neededUpload);
+
+  // --- MESHLET CULLING ---
+  // Must run outside dynamic rendering
+  if (meshletCullingEnabled && modelResident && instanceBatches.visible > 0) {
+    recordCullPass();
+  }
+
   // --- COLOR IMAGE BARRIER ---
   // Prepare the multisampled color image for rendering output.
   vk::ImageMemoryBarrier2 colorBarrier;
@@ -1577,7 +3420,8 @@ void VulkanRenderer::recordCommandBuffer(uint32_t imageIndex) {
   colorAttachmentInfo.imageLayout = vk::ImageLayout::eColorAttachmentOptimal;
   colorAttachmentInfo.loadOp =
       vk::AttachmentLoadOp::eClear; // Clear before rendering
-  colorAttachmentInfo.storeOp = vk::AttachmentStoreOp::eStore; // Store result
+  colorAttachmentInfo.storeOp =
+      vk::AttachmentStoreOp::eDontCare; // Samples are only needed to resolve
   colorAttachmentInfo.clearValue = clearColor;
 
   // Define resolve attachment to handle MSAA and write to swapchain
@@ -1614,31 +3458,106 @@ void VulkanRenderer::recordCommandBuffer(uint32_t imageIndex) {
   // Start dynamic rendering
   commandBuffers[currentFrame].beginRendering(renderingInfo);
 
-  // Bind the graphics pipeline to the command buffer
-  commandBuffers[currentFrame].bindPipeline(vk::PipelineBindPoint::eGraphics,
-                                            *graphicsPipeline);
-
-  // Bind vertex and index buffers
-  vk::DeviceSize offsets[] = {0};
-  commandBuffers[currentFrame].bindVertexBuffers(0, *vertexBuffer, offsets);
-  commandBuffers[currentFrame].bindIndexBuffer(*indexBuffer, 0,
-                                               vk::IndexType::eUint32);
-
-  // Bind descriptor sets for uniform data and textures
-  commandBuffers[currentFrame].bindDescriptorSets(
-      vk::PipelineBindPoint::eGraphics, *pipelineLayout, 0,
-      *descriptorSets[currentFrame], nullptr);
-
-  // Set dynamic viewport and scissor
-  commandBuffers[currentFrame].setViewport(
-      0, vk::Viewport(0.0f, 0.0f, static_cast<float>(swapChainExtent.width),
-                      static_cast<float>(swapChainExtent.height), 0.0f, 1.0f));
-  commandBuffers[currentFrame].setScissor(
-      0, vk::Rect2D(vk::Offset2D(0, 0), swapChainExtent));
-
-  // Issue indexed draw command
-  commandBuffers[currentFrame].drawIndexed(
-      static_cast<uint32_t>(indices.size()), 1, 0, 0, 0);
+  // Until the model is resident the frame only clears (no pipeline yet)
+  if (modelResident) {
+    // Bind vertex, instance (this frame's range of the ring) and index
+    // buffers
+    const vk::Buffer vertexBuffers[] = {*geometryArena->vertexBuffer(),
+                                        *frameRingBuffer};
+    const vk::DeviceSize offsets[] = {0, instanceOffset};
+    commandBuffers[currentFrame].bindVertexBuffers(0, vertexBuffers, offsets);
+    commandBuffers[currentFrame].bindIndexBuffer(
+        *geometryArena->indexBuffer(), 0, vk::IndexType::eUint32);
+
+    // Set dynamic viewport and scissor
+    commandBuffers[currentFrame].setViewport(
+        0,
+        vk::Viewport(0.0f, 0.0f, static_cast<float>(swapChainExtent.width),
+                     static_cast<float>(swapChainExtent.height), 0.0f, 1.0f));
+    commandBuffers[currentFrame].setScissor(
+        0, vk::Rect2D(vk::Offset2D(0, 0), swapChainExtent));
+
+    // Walk the state-sorted draw list of every LOD with visible instances,
+    // binding only what changes; each draw covers all of the LOD's instances
+    drawbatch::StateChanges changes;
+    uint64_t previous = 0;
+    bool first = true;
+    for (uint32_t lod = 0; lod < instanceBatches.lodCount.size() &&
+                           lod < lodDrawLists.size();
+         lod++) {
+      const uint32_t instanceCount = instanceBatches.lodCount[lod];
+      if (instanceCount == 0) {
+        continue;
+      }
+      for (const drawbatch::DrawItem &item : lodDrawLists[lod]) {
+        const uint64_t key = item.key;
+        const bool newPipeline = first || drawbatch::pipelineOf(key) !=
+                                              drawbatch::pipelineOf(previous);
+        if (newPipeline) {
+          commandBuffers[currentFrame].bindPipeline(
+              vk::PipelineBindPoint::eGraphics, *graphicsPipeline);
+          changes.pipelineBinds++;
+        }
+        if (first && vertexPullingEnabled) {
+          // Where and in which layout the shader reads the model's vertices
+          commandBuffers[currentFrame].pushConstants<vertexpull::PushConstants>(
+              *pipelineLayout, vk::ShaderStageFlagBits::eVertex,
+              vertexpull::kPushConstantOffset, pullConstants);
+        }
+
+        // Uniform data and the material's texture
+        const uint32_t slot = drawbatch::descriptorOf(key);
+        if (newPipeline || slot != drawbatch::descriptorOf(previous)) {
+          const vk::raii::DescriptorSet &set =
+              slot == 0
+                  ? descriptorSets[currentFrame]
+                  : materialTextures[slot - 1].descriptorSets[currentFrame];
+          commandBuffers[currentFrame].bindDescriptorSets(
+              vk::PipelineBindPoint::eGraphics, *pipelineLayout, 0, *set,
+              uniformOffset);
+          changes.descriptorBinds++;
+        }
+
+        const MeshSubmesh &submesh = modelSubmeshes[item.draw];
+        if (newPipeline ||
+            drawbatch::materialOf(key) != drawbatch::materialOf(previous)) {
+          const glm::vec4 diffuse(
+              modelMaterials[submesh.material].diffuseColor, 1.0f);
+          commandBuffers[currentFrame].pushConstants<glm::vec4>(
+              *pipelineLayout, vk::ShaderStageFlagBits::eFragment, 0,
+              diffuse);
+          changes.materialBinds++;
+        }
+
+        if (meshletCullingEnabled) {
+          // One draw per visible meshlet; the count comes from the cull
+          // pass. Its single instance is entry 0 of the instance range.
+          const meshlet::MeshletRange &range =
+              modelMeshlets.submeshRanges[item.draw];
+          const uint32_t countSlot = item.draw - lodSubmeshStart[currentLod];
+          commandBuffers[currentFrame].drawIndexedIndirectCount(
+              *drawCommandBuffers[currentFrame],
+              sizeof(vk::DrawIndexedIndirectCommand) *
+                  (range.first - cullParams.firstMeshlet),
+              *cullCounterBuffers[currentFrame],
+              sizeof(meshlet::CullCounters) + sizeof(uint32_t) * countSlot,
+              range.count, sizeof(vk::DrawIndexedIndirectCommand));
+        } else {
+          // Instanced draw of the submesh's range of this LOD
+          commandBuffers[currentFrame].drawIndexed(
+              submesh.indexCount, instanceCount,
+              modelGeometry.firstIndex() + submesh.indexOffset,
+              modelGeometry.vertexOffset(), instanceBatches.lodFirst[lod]);
+        }
+        changes.drawCalls++;
+        previous = key;
+        first = false;
+      }
+    }
+    PROFILE_COUNTER("Draw calls", changes.drawCalls);
+    PROFILE_COUNTER("Descriptor binds", changes.descriptorBinds);
+    PROFILE_COUNTER("Pipeline binds", changes.pipelineBinds);
+  }
 
   // End dynamic rendering
   commandBuffers[currentFrame].endRendering();
@@ -1697,16 +3616,42 @@ void VulkanRenderer::recordCommandBuffer(uint32_t imageIndex) {
  * @see createShaderModule()
  */
 void VulkanRenderer::createGraphicsPipeline() {
-  // Reset vertex input state
-  vertexInputInfo = vk::PipelineVertexInputStateCreateInfo{};
+  // Create pipeline layout (descriptor sets); shared by every rebuild
+  if (!*pipelineLayout) {
+    vk::PipelineLayoutCreateInfo pipelineLayoutInfo;
+    pipelineLayoutInfo.setLayoutCount = 1;
+    pipelineLayoutInfo.pSetLayouts = &*descriptorSetLayout;
+    // Material diffuse color, pushed per material by recordCommandBuffer(),
+    // then the vertex pulling constants of the mesh
+    const vk::PushConstantRange pushRanges[] = {
+        {vk::ShaderStageFlagBits::eFragment, 0, sizeof(glm::vec4)},
+        {vk::ShaderStageFlagBits::eVertex, vertexpull::kPushConstantOffset,
+         sizeof(vertexpull::PushConstants)}};
+    pipelineLayoutInfo.pushConstantRangeCount = vertexPullingEnabled ? 2 : 1;
+    pipelineLayoutInfo.pPushConstantRanges = pushRanges;
+    pipelineLayout = vk::raii::PipelineLayout(device, pipelineLayoutInfo);
+  }
 
-  // Read SPIR-V shader binaries from disk
-  std::vector<char> vertShaderCode = vkutils::readFile("shaders/vert.spv");
-  std::vector<char> fragShaderCode = vkutils::readFile("shaders/frag.spv");
+  graphicsPipeline = buildGraphicsPipeline(packedVertices);
+}
 
-  // Create Vulkan shader modules
-  vk::raii::ShaderModule vertShaderModule = createShaderModule(vertShaderCode);
-  vk::raii::ShaderModule fragShaderModule = createShaderModule(fragShaderCode);
+/**
+ * @details Only reads state that is fixed once the device exists (layout,
+ * formats, sample count), and every create-info lives on the stack, so hot
+ * reloads build pipelines on worker threads while the current one is used.
+ */
+vk::raii::Pipeline VulkanRenderer::buildGraphicsPipeline(
+    const vertexformat::PackedVertices &vertices) {
+  // Load SPIR-V shader binaries (asset pack or disk). Layouts without a color
+  // attribute use the CONSTANT_COLOR variant of the vertex shader; with
+  // vertex pulling one shader decodes every layout.
+  const bool vertexColor = vertexformat::hasColor(vertices.layout);
+  vk::raii::ShaderModule vertShaderModule = loadShaderModule(
+      vertexPullingEnabled ? "shaders/vert_pull.spv"
+      : vertexColor        ? "shaders/vert.spv"
+                           : "shaders/vert_constcolor.spv");
+  vk::raii::ShaderModule fragShaderModule =
+      loadShaderModule("shaders/frag.spv");
 
   // Setup shader stages
   vk::PipelineShaderStageCreateInfo vertShaderStageInfo;
@@ -1714,6 +3659,20 @@ void VulkanRenderer::createGraphicsPipeline() {
   vertShaderStageInfo.module = *vertShaderModule;
   vertShaderStageInfo.pName = "main";
 
+  // Specialization constants 0..2: the dropped per-vertex color
+  std::array<vk::SpecializationMapEntry, 3> colorEntries = {};
+  for (uint32_t c = 0; c < colorEntries.size(); c++) {
+    colorEntries[c] = vk::SpecializationMapEntry(c, c * sizeof(float),
+                                                 sizeof(float));
+  }
+  const glm::vec3 constantColor = vertices.quantization.constantColor;
+  vk::SpecializationInfo colorSpecialization(
+      static_cast<uint32_t>(colorEntries.size()), colorEntries.data(),
+      sizeof(constantColor), &constantColor);
+  if (!vertexColor && !vertexPullingEnabled) {
+    vertShaderStageInfo.pSpecializationInfo = &colorSpecialization;
+  }
+
   vk::PipelineShaderStageCreateInfo fragShaderStageInfo;
   fragShaderStageInfo.stage = vk::ShaderStageFlagBits::eFragment;
   fragShaderStageInfo.module = *fragShaderModule;
@@ -1726,12 +3685,31 @@ void VulkanRenderer::createGraphicsPipeline() {
   vk::PipelineInputAssemblyStateCreateInfo inputAssembly;
   inputAssembly.topology = vk::PrimitiveTopology::eTriangleList;
 
-  // Get vertex input descriptions
-  auto bindingDescription = Vertex::getBindingDescription();
-  auto attributeDescriptions = Vertex::getAttributeDescriptions();
+  // Get vertex input descriptions of the layout chosen by loadModel(); a
+  // pulling pipeline has none, the shader reads the vertex buffer itself
+  std::vector<vk::VertexInputBindingDescription> bindingDescriptions;
+  std::vector<vk::VertexInputAttributeDescription> attributeDescriptions;
+  if (!vertexPullingEnabled) {
+    vertexformat::visit(vertices.layout, [&]<typename L>(L) {
+      bindingDescriptions.push_back(L::getBindingDescription());
+      auto attributes = L::getAttributeDescriptions();
+      attributeDescriptions.assign(attributes.begin(), attributes.end());
+    });
+  }
+
+  // Binding 1: one model matrix per instance, locations 3-6 (one per column)
+  bindingDescriptions.emplace_back(1, sizeof(glm::mat4),
+                                   vk::VertexInputRate::eInstance);
+  for (uint32_t column = 0; column < 4; column++) {
+    attributeDescriptions.emplace_back(3 + column, 1,
+                                       vk::Format::eR32G32B32A32Sfloat,
+                                       column * sizeof(glm::vec4));
+  }
 
-  vertexInputInfo = vk::PipelineVertexInputStateCreateInfo(
-      vk::PipelineVertexInputStateCreateFlags(), 1, &bindingDescription,
+  vk::PipelineVertexInputStateCreateInfo vertexInputInfo(
+      vk::PipelineVertexInputStateCreateFlags(),
+      static_cast<uint32_t>(bindingDescriptions.size()),
+      bindingDescriptions.data(),
       static_cast<uint32_t>(attributeDescriptions.size()),
       attributeDescriptions.data());
 
@@ -1787,13 +3765,6 @@ void VulkanRenderer::createGraphicsPipeline() {
   dynamicState.dynamicStateCount = static_cast<uint32_t>(dynamicStates.size());
   dynamicState.pDynamicStates = dynamicStates.data();
 
-  // Create pipeline layout (descriptor sets)
-  vk::PipelineLayoutCreateInfo pipelineLayoutInfo;
-  pipelineLayoutInfo.setLayoutCount = 1;
-  pipelineLayoutInfo.pSetLayouts = &*descriptorSetLayout;
-  pipelineLayoutInfo.pushConstantRangeCount = 0;
-  pipelineLayout = vk::raii::PipelineLayout(device, pipelineLayoutInfo);
-
   // Specify formats for dynamic rendering
   vk::PipelineRenderingCreateInfo pipelineRenderingCreateInfo;
   pipelineRenderingCreateInfo.colorAttachmentCount = 1;
@@ -1818,19 +3789,81 @@ void VulkanRenderer::createGraphicsPipeline() {
   pipelineInfo.renderPass = nullptr; // Dynamic rendering, no render pass
 
   // Create the graphics pipeline
-  graphicsPipeline = vk::raii::Pipeline(device, nullptr, pipelineInfo);
+  return vk::raii::Pipeline(device, nullptr, pipelineInfo);
+}
+
+/**
+ * @brief Creates the compute pipeline for meshlet culling.
+ *
+ * @details
+ * The pipeline runs shaders/cull.spv with three storage buffers (meshlets,
+ * draw commands, counters) and the frustum/camera/range as a 128-byte push
+ * constant block (meshlet::CullParams).
+ *
+ * @throws std::runtime_error if the shader cannot be read.
+ */
+void VulkanRenderer::createCullPipeline() {
+  if (!meshletCullingEnabled) {
+    return;
+  }
+
+  std::array<vk::DescriptorSetLayoutBinding, 3> bindings = {};
+  for (uint32_t binding = 0; binding < bindings.size(); binding++) {
+    bindings[binding] = vk::DescriptorSetLayoutBinding(
+        binding, vk::DescriptorType::eStorageBuffer, 1,
+        vk::ShaderStageFlagBits::eCompute, nullptr);
+  }
+  vk::DescriptorSetLayoutCreateInfo layoutInfo{};
+  layoutInfo.bindingCount = static_cast<uint32_t>(bindings.size());
+  layoutInfo.pBindings = bindings.data();
+  cullDescriptorSetLayout = vk::raii::DescriptorSetLayout(device, layoutInfo);
+
+  vk::PushConstantRange pushConstantRange(vk::ShaderStageFlagBits::eCompute, 0,
+                                          sizeof(meshlet::CullParams));
+  vk::PipelineLayoutCreateInfo pipelineLayoutInfo;
+  pipelineLayoutInfo.setLayoutCount = 1;
+  pipelineLayoutInfo.pSetLayouts = &*cullDescriptorSetLayout;
+  pipelineLayoutInfo.pushConstantRangeCount = 1;
+  pipelineLayoutInfo.pPushConstantRanges = &pushConstantRange;
+  cullPipelineLayout = vk::raii::PipelineLayout(device, pipelineLayoutInfo);
+
+  cullPipeline = buildCullPipeline();
+}
+
+vk::raii::Pipeline VulkanRenderer::buildCullPipeline() {
+  vk::raii::ShaderModule cullShaderModule =
+      loadShaderModule("shaders/cull.spv");
+
+  vk::ComputePipelineCreateInfo pipelineInfo;
+  pipelineInfo.stage.stage = vk::ShaderStageFlagBits::eCompute;
+  pipelineInfo.stage.module = *cullShaderModule;
+  pipelineInfo.stage.pName = "main";
+  pipelineInfo.layout = *cullPipelineLayout;
+  return vk::raii::Pipeline(device, nullptr, pipelineInfo);
 }
 
 /**
  * @brief Creates a Vulkan shader module from SPIR-V bytecode.
  *
- * @param code Binary vector containing the SPIR-V shader code.
+ * @param code SPIR-V shader code (4-byte aligned).
  * @return vk::raii::ShaderModule Handle to the created shader module.
  * @throws std::runtime_error If shader creation fails.
  * @note Shader modules must be destroyed before the device is destroyed.
  */
 vk::raii::ShaderModule
-VulkanRenderer::createShaderModule(const std::vector<char> &code) {
+VulkanRenderer::createShaderModule(std::span<const std::byte> code) {
+  // A truncated or half-written module (e.g. caught mid-rebuild by a hot
+  // reload) must not reach the driver
+  constexpr uint32_t kSpirvMagic = 0x07230203;
+  uint32_t magic = 0;
+  if (code.size() >= sizeof(magic)) {
+    memcpy(&magic, code.data(), sizeof(magic));
+  }
+  if (code.size() % 4 != 0 || magic != kSpirvMagic) {
+    throw std::runtime_error("invalid SPIR-V module (" +
+                             std::to_string(code.size()) + " bytes)");
+  }
+
   // Setup creation info for Vulkan shader module
   vk::ShaderModuleCreateInfo createInfo;
   createInfo.codeSize = code.size();
@@ -1838,6 +3871,20 @@ VulkanRenderer::createShaderModule(const std::vector<char> &code) {
   return vk::raii::ShaderModule(device, createInfo);
 }
 
+/**
+ * @details Pack blobs are page aligned, so the module is created straight
+ * from the mapping without reading the file into a vector first.
+ */
+vk::raii::ShaderModule
+VulkanRenderer::loadShaderModule(const std::string &path) {
+  const std::span<const std::byte> packed = packedAsset(path);
+  if (!packed.empty()) {
+    return createShaderModule(packed);
+  }
+  const std::vector<char> code = vkutils::readFile(path);
+  return createShaderModule(std::as_bytes(std::span(code)));
+}
+
 /**
  * @brief Creates a Vulkan surface for rendering to a GLFW window.
  *
@@ -2311,8 +4358,22 @@ void VulkanRenderer::pickLogicalGPU() {
     throw std::runtime_error("No graphics or present queue family found!");
   }
 
+  uint32_t transferIndex = graphicsIndex;
+  for (uint32_t i = 0; TRANSFER_QUEUE && i < queueFamilyProperties.size();
+       i++) {
+    const vk::QueueFlags flags = queueFamilyProperties[i].queueFlags;
+    if ((flags & vk::QueueFlagBits::eTransfer) &&
+        !(flags & (vk::QueueFlagBits::eGraphics |
+                   vk::QueueFlagBits::eCompute))) {
+      transferIndex = i; // DMA engine: copies run beside rendering
+      break;
+    }
+  }
+  // Uploads share the graphics queue when there is no transfer-only family
+
   graphicsQueueFamilyIndex = graphicsIndex;
-  std::set<uint32_t> uniqueQueueFamilies = {graphicsIndex, presentIndex};
+  std::set<uint32_t> uniqueQueueFamilies = {graphicsIndex, presentIndex,
+                                            transferIndex};
   // Use a set so graphics/present queue isn't duplicated if they are the same
 
   std::vector<vk::DeviceQueueCreateInfo> queueCreateInfos;
@@ -2330,7 +4391,67 @@ void VulkanRenderer::pickLogicalGPU() {
   bool sampleRateShadingSupported = supportedFeatures.sampleRateShading;
   // Check if MSAA sample shading exists but only enable if available
 
+  auto supportedFeatureChain =
+      physicalGPU.getFeatures2<vk::PhysicalDeviceFeatures2,
+                               vk::PhysicalDeviceVulkan12Features>();
+  meshletCullingEnabled =
+      MESHLET_CULLING &&
+      supportedFeatureChain.get<vk::PhysicalDeviceFeatures2>()
+          .features.multiDrawIndirect &&
+      supportedFeatureChain.get<vk::PhysicalDeviceVulkan12Features>()
+          .drawIndirectCount;
+  if (MESHLET_CULLING && !meshletCullingEnabled) {
+    std::cerr << "Warning: drawIndirectCount/multiDrawIndirect unsupported, "
+                 "meshlet culling disabled"
+              << std::endl;
+  }
+  // GPU-driven meshlet culling needs indirect draws with a GPU-written count
+
+  vertexPullingEnabled =
+      VERTEX_PULLING &&
+      supportedFeatureChain.get<vk::PhysicalDeviceVulkan12Features>()
+          .bufferDeviceAddress;
+  if (VERTEX_PULLING && !vertexPullingEnabled) {
+    std::cerr << "Warning: bufferDeviceAddress unsupported, vertex pulling "
+                 "disabled"
+              << std::endl;
+  }
+  // The vertex shader then reads the vertex buffer through its address
+
+  bcTexturesSupported = supportedFeatures.textureCompressionBC;
+  // Baked BC1/BC7 textures are used only if the GPU can sample them
+
+  auto extensionProperties = physicalGPU.enumerateDeviceExtensionProperties();
+  const bool hostImportSupported = std::any_of(
+      extensionProperties.begin(), extensionProperties.end(),
+      [](vk::ExtensionProperties const &ext) {
+        return strcmp(ext.extensionName,
+                      VK_EXT_EXTERNAL_MEMORY_HOST_EXTENSION_NAME) == 0;
+      });
+  if (IMPORT_HOST_MEMORY && hostImportSupported) {
+    gpuExtensions.push_back(VK_EXT_EXTERNAL_MEMORY_HOST_EXTENSION_NAME);
+    hostImportAlignment =
+        physicalGPU
+            .getProperties2<vk::PhysicalDeviceProperties2,
+                            vk::PhysicalDeviceExternalMemoryHostPropertiesEXT>()
+            .get<vk::PhysicalDeviceExternalMemoryHostPropertiesEXT>()
+            .minImportedHostPointerAlignment;
+  }
+  // Asset pack blobs can then be copied by the GPU straight from the mapping
+
+  const bool memoryBudgetSupported = std::any_of(
+      extensionProperties.begin(), extensionProperties.end(),
+      [](vk::ExtensionProperties const &ext) {
+        return strcmp(ext.extensionName,
+                      VK_EXT_MEMORY_BUDGET_EXTENSION_NAME) == 0;
+      });
+  if (memoryBudgetSupported) {
+    gpuExtensions.push_back(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+  }
+  // Heap usage and budget then come from the driver
+
   vk::StructureChain<vk::PhysicalDeviceFeatures2,
+                     vk::PhysicalDeviceVulkan12Features,
                      vk::PhysicalDeviceVulkan13Features,
                      vk::PhysicalDeviceExtendedDynamicStateFeaturesEXT>
       featureChain;
@@ -2341,6 +4462,27 @@ void VulkanRenderer::pickLogicalGPU() {
         VK_TRUE; // Only enable MSAA shading if supported
   }
 
+  if (bcTexturesSupported) {
+    featureChain.get<vk::PhysicalDeviceFeatures2>()
+        .features.textureCompressionBC = VK_TRUE;
+  }
+
+  if (meshletCullingEnabled) {
+    featureChain.get<vk::PhysicalDeviceFeatures2>().features.multiDrawIndirect =
+        VK_TRUE;
+    featureChain.get<vk::PhysicalDeviceVulkan12Features>().drawIndirectCount =
+        true;
+  }
+
+  if (vertexPullingEnabled) {
+    featureChain.get<vk::PhysicalDeviceVulkan12Features>()
+        .bufferDeviceAddress = true;
+  }
+
+  featureChain.get<vk::PhysicalDeviceVulkan12Features>().timelineSemaphore =
+      true;
+  // Upload batches signal a timeline value frames wait for (core in 1.2)
+
   featureChain.get<vk::PhysicalDeviceVulkan13Features>().dynamicRendering =
       true;
   featureChain.get<vk::PhysicalDeviceVulkan13Features>().synchronization2 =
@@ -2364,9 +4506,44 @@ void VulkanRenderer::pickLogicalGPU() {
   device = vk::raii::Device(physicalGPU, deviceCreateInfo);
   // Logical device creation — now Vulkan can submit work
 
+  allocator = std::make_unique<GpuAllocator>(
+      physicalGPU, device, GpuAllocator::kMaxBlockSize, vertexPullingEnabled);
+  // Every buffer and image takes its memory from the allocator's blocks
+
+  memoryBudget = std::make_unique<MemoryBudget>(
+      physicalGPU, memoryBudgetSupported, MEMORY_BUDGET_THRESHOLD);
+  memoryBudget->setCallback(
+      [this](uint32_t heapIndex, const MemoryBudget::Heap &heap) {
+        onMemoryBudget(heapIndex, heap);
+      });
+  // Heap usage is compared with the budget every frame
+
+  stagingPool = std::make_unique<StagingPool>(device, *allocator);
+  // Every upload stages through the pool's persistently mapped buffers
+
+  uploadQueue = std::make_unique<UploadQueue>(device, *stagingPool,
+                                              transferIndex, graphicsIndex);
+  std::cout << "Uploads: "
+            << (uploadQueue->dedicated() ? "transfer queue family "
+                                         : "graphics queue family ")
+            << transferIndex << std::endl;
+  // Copies are batched per frame and never waited for on the host
+
+  transientAttachments =
+      std::make_unique<TransientAttachments>(device, *allocator);
+  // MSAA color and depth: lazily allocated or aliased memory
+
+  geometryArena = std::make_unique<GeometryArena>(
+      device, *allocator, GeometryArena::kVertexBytes,
+      GeometryArena::kIndexCount, vertexPullingEnabled);
+  // Every mesh's vertices and indices share one buffer of each
+
   graphicsQueue = vk::raii::Queue(device, graphicsIndex, 0);
   presentQueue = vk::raii::Queue(device, presentIndex, 0);
   // Acquire queue handles (0 = first queue of that family)
+
+  loadBatch = std::make_unique<LoadBatch>(device, *stagingPool, graphicsIndex);
+  // Load-time transitions, copies and blits share one submit and fence
 }
 
 /**
@@ -2454,6 +4631,7 @@ void VulkanRenderer::pickPhysicalGPU() {
  * @see createImageViews()
  * @see createColorResources()
  * @see createDepthResources()
+ * @see bindTransientAttachments()
  * @see createCommandBuffers()
  * @see createSyncObjects()
  */
@@ -2470,12 +4648,13 @@ void VulkanRenderer::recreateSwapChain() {
   device.waitIdle();  // Ensure GPU is not using old swapchain resources
   cleanupSwapChain(); // Release old swap chain resources
 
-  createSwapChain();      // Make new swap chain
-  createImageViews();     // Create views for each swap chain image
-  createColorResources(); // Recreate MSAA color attachments
-  createDepthResources(); // Recreate depth buffer
-  createCommandBuffers(); // Re-record rendering command buffers
-  createSyncObjects();    // Recreate semaphores/fences
+  createSwapChain();          // Make new swap chain
+  createImageViews();         // Create views for each swap chain image
+  createColorResources();     // Recreate MSAA color attachments
+  createDepthResources();     // Recreate depth buffer
+  bindTransientAttachments(); // Memory + views for both
+  createCommandBuffers();     // Re-record rendering command buffers
+  createSyncObjects();        // Recreate semaphores/fences
 }
 
 /**
@@ -2492,9 +4671,11 @@ void VulkanRenderer::recreateSwapChain() {
  * @see recreateSwapChain()
  */
 void VulkanRenderer::cleanupSwapChain() {
-  colorImageView = nullptr;   // Destroy view first
-  colorImage = nullptr;       // Destroy color attachment
-  colorImageMemory = nullptr; // Free GPU memory holding the image
+  colorImageView = nullptr;      // Destroy views first
+  depthImageView = nullptr;
+  colorImage = nullptr;          // Destroy color attachment
+  depthImage = nullptr;          // Destroy depth attachment
+  transientAttachments->reset(); // Free GPU memory holding both
 
   swapChainImageViews.clear(); // Destroy all image views
   swapChain = nullptr;         // Destroy the swap chain itself
@@ -2543,9 +4724,15 @@ void VulkanRenderer::initWindow() {
  * resources:
  * - Vulkan instance and debug messenger creation.
  * - Physical and logical device selection.
+ * - Asset loading is started on worker threads right after device creation;
+ *   the model-dependent pipeline and buffers are created by pollAssets()
+ *   once it finishes (immediately when ASYNC_ASSET_LOADING is off).
  * - Swap chain and rendering resources setup.
  * - Pipeline and buffer preparation.
  * - Descriptor sets and synchronization primitives.
+ * - The load batch (placeholder texture, and the blitted texture when
+ *   loading synchronously) is submitted once; the startup time and
+ *   submission counts are printed.
  *
  * @throws std::runtime_error If any Vulkan initialization step fails.
  */
@@ -2555,24 +4742,41 @@ void VulkanRenderer::initVulkan() {
   createSurface();             // Create window surface (GLFW → Vulkan)
   pickPhysicalGPU();           // Select discrete GPU
   pickLogicalGPU();            // Create logical device + queues
+  openAssetPack();             // Map the asset pack (if built)
+  loadScene();                // Instances to draw (before model loads)
+  watchAssets();               // Hot reload file notifications
+  startAssetLoads();           // Model + texture decode on worker threads
   createSwapChain();           // Frame presentation system
   createImageViews();          // Views for each swapchain image
   createColorResources();      // MSAA render target
-  createDescriptorSetLayout(); // Descriptors: UBOs + textures
-  createGraphicsPipeline();    // Shader + pipeline configuration
-  createCommandPool();         // Memory pool used to allocate command buffers
   createDepthResources();      // Depth buffer
-  createTextureImage();        // Load texture from disk
-  createTextureImageView();    // Image view for sampling
+  bindTransientAttachments();  // Lazily allocated or aliased memory + views
+  createDescriptorSetLayout(); // Descriptors: dynamic UBO + textures
+  createCullPipeline();        // Meshlet cull compute pipeline
+  createCommandPool();         // Memory pool used to allocate command buffers
+  createPlaceholderTexture();  // 1x1 white until the texture is resident
   createTextureSampler();      // Texture filtering sampler
-  loadModel();                 // Load vertex/index data from model
-  createVertexBuffer();        // Upload vertices to GPU
-  createIndexBuffer();         // Upload indices to GPU
-  createUniformBuffers();      // Allocate per-frame UBOs
+  createFrameRing();           // Per-frame UBOs + instance matrices
   createDescriptorPool();      // Pool for descriptor sets
   createDescriptorSets();      // Allocate + write descriptor sets
   createCommandBuffers();      // Build render command buffers
   createSyncObjects();         // Semaphores/fences for frame sync
+
+  if (!ASYNC_ASSET_LOADING) {
+    pollAssets(true); // Graphics pipeline + model/texture uploads
+  }
+  loadBatch->submit(); // Placeholder, unless pollAssets() submitted it
+
+  const LoadBatch::Stats &loads = loadBatch->stats();
+  const UploadQueue::Stats uploads = uploadQueue->stats();
+  std::cout << "Startup: "
+            << std::chrono::duration<double, std::milli>(
+                   std::chrono::high_resolution_clock::now() - launchTime)
+                   .count()
+            << " ms, " << loads.submits << " load batch submit(s) waited "
+            << loads.waitMs << " ms, " << uploads.copies
+            << " copies queued for the first frame's upload batch"
+            << std::endl;
 }
 
 /**
@@ -2582,6 +4786,10 @@ void VulkanRenderer::initVulkan() {
  * closed. Profiles CPU time per frame and outputs live ASCII visualization
  * only on selected frames to reduce terminal/UI overload.
  *
+ * With LOD_DISTANCE_SWEEP the camera steps through LOD_SWEEP_DISTANCES and
+ * the average frame time, LOD and triangle throughput are printed for each
+ * distance before the window is closed.
+ *
  * @note Exports JSON at the end of the run for offline analysis.
  */
 void VulkanRenderer::mainLoop() {
@@ -2589,6 +4797,16 @@ void VulkanRenderer::mainLoop() {
   const int profileEveryNFrames = 10;
   // Only profile every N frames to avoid terminal spam
 
+  size_t sweepStep = 0;
+  int sweepFrames = 0;
+  uint64_t sweepTriangles = 0;
+  auto sweepStart = std::chrono::high_resolution_clock::now();
+  auto loopStart = std::chrono::high_resolution_clock::now();
+  if (LOD_DISTANCE_SWEEP) {
+    cameraDistance = LOD_SWEEP_DISTANCES[0];
+    std::cout << "distance  LOD  triangles  frame ms  Mtri/s" << std::endl;
+  }
+
   while (!glfwWindowShouldClose(window)) {
     glfwPollEvents(); // Handle input + resize events
 
@@ -2609,9 +4827,62 @@ void VulkanRenderer::mainLoop() {
     }
 
     frameCounter++; // Advance frame count
+
+    if (LOD_DISTANCE_SWEEP && modelResident) {
+      if (sweepFrames++ == 0) {
+        sweepStart = std::chrono::high_resolution_clock::now(); // Loaded now
+      }
+      sweepTriangles += modelLods.empty()
+                            ? modelIndices.size() / 3
+                            : modelLods[currentLod].indexCount / 3;
+      if (sweepFrames % LOD_SWEEP_FRAMES == 0) {
+        double seconds = std::chrono::duration<double>(
+                             std::chrono::high_resolution_clock::now() -
+                             sweepStart)
+                             .count();
+        std::cout << cameraDistance << "  " << currentLod << "  "
+                  << sweepTriangles / LOD_SWEEP_FRAMES << "  "
+                  << seconds * 1000.0 / LOD_SWEEP_FRAMES << "  "
+                  << sweepTriangles / seconds / 1e6 << std::endl;
+
+        if (++sweepStep == std::size(LOD_SWEEP_DISTANCES)) {
+          glfwSetWindowShouldClose(window, GLFW_TRUE);
+        } else {
+          cameraDistance = LOD_SWEEP_DISTANCES[sweepStep];
+        }
+        sweepTriangles = 0;
+        sweepStart = std::chrono::high_resolution_clock::now();
+      }
+    }
+  }
+
+  // Loader tasks write into this renderer; let them finish before teardown
+  for (std::future<void> *future :
+       {&modelFuture, &textureFuture, &materialTextureFuture,
+        &textureStreamFuture}) {
+    if (future->valid()) {
+      future->wait();
+    }
+  }
+  if (hotReload && hotReload->job.valid()) {
+    hotReload->job.wait();
   }
 
   device.waitIdle(); // Wait for GPU to finish processing all frames
+  retireQueue.clear();
+  hotReload.reset();
+
+  // Average frame time, e.g. to compare vertex layouts (QUANTIZE_VERTICES)
+  if (frameCounter > 0) {
+    double seconds = std::chrono::duration<double>(
+                         std::chrono::high_resolution_clock::now() - loopStart)
+                         .count();
+    std::cout << frameCounter << " frames, average "
+              << seconds * 1000.0 / frameCounter << " ms/frame ("
+              << vertexformat::name(packedVertices.layout) << ", "
+              << packedVertices.stride << " B/vertex)" << std::endl;
+  }
+
   ChronoProfiler::exportToJSON("profile_output.json");
   // Save profiling data to a JSON file
 }
@@ -0,0 +1,98 @@
+/**
+ * @file scenegen.cpp
+ * @brief Synthetic scene generator: writes scene files with thousands of
+ *        instances for measuring how the renderer scales with scene size.
+ *
+ * Usage:
+ * @code
+ * make tools RELEASE=1
+ * ./build/scenegen                      # scenes/scene_{1k,10k,100k}.json
+ * ./build/scenegen 50000 scenes/big.json models/statue.obj models/a.obj
+ * @endcode
+ *
+ * Instances are laid out by scene::generate() (grid with random jitter, yaw
+ * and scale) and assigned to the given models round-robin; the default
+ * model is the statue with its texture. Each file is read back with
+ * scene::load() to report the load time the renderer will see at startup.
+ */
+#include "../include/Scene.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+/** @brief Milliseconds elapsed since 'start'. */
+double msSince(std::chrono::high_resolution_clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(
+             std::chrono::high_resolution_clock::now() - start)
+      .count();
+}
+
+/** @brief Generates, writes and reloads one scene. */
+void writeScene(const std::vector<scene::MeshAsset> &meshes, size_t count,
+                const std::string &path) {
+  auto start = std::chrono::high_resolution_clock::now();
+  const scene::Scene generated = scene::generate(meshes, count);
+  const double generateMs = msSince(start);
+
+  const std::filesystem::path parent =
+      std::filesystem::path(path).parent_path();
+  if (!parent.empty()) {
+    std::filesystem::create_directories(parent);
+  }
+  start = std::chrono::high_resolution_clock::now();
+  scene::save(path, generated);
+  const double saveMs = msSince(start);
+
+  start = std::chrono::high_resolution_clock::now();
+  const scene::Scene loaded = scene::load(path);
+  const double loadMs = msSince(start);
+  if (loaded.instances.size() != count) {
+    throw std::runtime_error(path + ": read back " +
+                             std::to_string(loaded.instances.size()) +
+                             " instances");
+  }
+
+  std::cout << path << ": " << count << " instances, "
+            << std::filesystem::file_size(path) / 1024 << " KiB, generate "
+            << generateMs << " ms, save " << saveMs << " ms, load " << loadMs
+            << " ms\n";
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  if (argc == 2 || (argc > 2 && std::atoll(argv[1]) <= 0)) {
+    std::cerr << "usage: scenegen [instances out.json [model.obj ...]]\n";
+    return EXIT_FAILURE;
+  }
+
+  try {
+    if (argc == 1) {
+      const std::vector<scene::MeshAsset> statue = {
+          {"models/statue.obj", "textures/statue.png"}};
+      writeScene(statue, 1000, "scenes/scene_1k.json");
+      writeScene(statue, 10000, "scenes/scene_10k.json");
+      writeScene(statue, 100000, "scenes/scene_100k.json");
+      return EXIT_SUCCESS;
+    }
+
+    std::vector<scene::MeshAsset> meshes;
+    for (int i = 3; i < argc; i++) {
+      meshes.push_back({argv[i], ""});
+    }
+    if (meshes.empty()) {
+      meshes.push_back({"models/statue.obj", "textures/statue.png"});
+    }
+    writeScene(meshes, static_cast<size_t>(std::atoll(argv[1])), argv[2]);
+  } catch (const std::exception &e) {
+    std::cerr << e.what() << "\n";
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
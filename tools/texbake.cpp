@@ -0,0 +1,142 @@
+/**
+ * @file texbake.cpp
+ * @brief Offline texture baker: builds the mip chain of an image, block
+ *        compresses every level and writes an .artx file for the renderer.
+ *
+ * Usage:
+ * @code
+ * make tools RELEASE=1
+ * ./build/texbake textures/statue.jpg textures/statue.artx [bc7|bc1|rgba8]
+ * @endcode
+ *
+ * Mips are generated with the gamma-correct box filter from mipgen, then each
+ * level is encoded on the global ThreadPool. Per-level encode time, MPix/s
+ * and PSNR (against the uncompressed level) are reported, along with the
+ * total size relative to uncompressed RGBA8 with mips.
+ */
+#include "../include/MipGenerator.hpp"
+#include "../include/TextureCompressor.hpp"
+#include "../include/TextureFile.hpp"
+#include "../include/ThreadPool.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <stb/stb_image.h>
+#include <string>
+#include <vector>
+
+namespace {
+
+/** @brief Milliseconds elapsed since 'start'. */
+double msSince(std::chrono::high_resolution_clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(
+             std::chrono::high_resolution_clock::now() - start)
+      .count();
+}
+
+/** @brief RGB peak signal-to-noise ratio in dB (alpha ignored). */
+double psnr(const std::vector<uint8_t> &a, const std::vector<uint8_t> &b) {
+  double sum = 0.0;
+  for (size_t i = 0; i < a.size(); i++) {
+    if (i % 4 != 3) {
+      const double d = static_cast<double>(a[i]) - b[i];
+      sum += d * d;
+    }
+  }
+  const double mse = sum / (a.size() / 4 * 3);
+  return mse == 0.0 ? std::numeric_limits<double>::infinity()
+                    : 10.0 * std::log10(255.0 * 255.0 / mse);
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  if (argc < 3) {
+    std::cerr << "usage: texbake <in.png|jpg> <out.artx> [bc7|bc1|rgba8]\n";
+    return EXIT_FAILURE;
+  }
+  const std::string inputPath = argv[1], outputPath = argv[2];
+  const std::string codecName = argc > 3 ? argv[3] : "bc7";
+
+  artx::Format format;
+  if (codecName == "bc7") {
+    format = artx::Format::eBC7;
+  } else if (codecName == "bc1") {
+    format = artx::Format::eBC1;
+  } else if (codecName == "rgba8") {
+    format = artx::Format::eRGBA8;
+  } else {
+    std::cerr << "unknown format: " << codecName << "\n";
+    return EXIT_FAILURE;
+  }
+  const bcn::Codec codec =
+      format == artx::Format::eBC1 ? bcn::Codec::eBC1 : bcn::Codec::eBC7;
+
+  try {
+    int width = 0, height = 0, channels = 0;
+    stbi_uc *pixels =
+        stbi_load(inputPath.c_str(), &width, &height, &channels, STBI_rgb_alpha);
+    if (!pixels) {
+      std::cerr << "failed to load " << inputPath << ": "
+                << stbi_failure_reason() << "\n";
+      return EXIT_FAILURE;
+    }
+
+    auto start = std::chrono::high_resolution_clock::now();
+    std::vector<mipgen::MipLevel> chain = mipgen::buildChain(
+        {pixels, static_cast<size_t>(width) * height * 4},
+        static_cast<uint32_t>(width), static_cast<uint32_t>(height));
+    stbi_image_free(pixels);
+    std::cout << inputPath << ": " << width << "x" << height << ", "
+              << chain.size() << " mips built in " << std::fixed
+              << std::setprecision(1) << msSince(start) << " ms\n";
+
+    ThreadPool &pool = ThreadPool::global();
+    std::vector<artx::Level> levels;
+    size_t rawBytes = 0, bakedBytes = 0;
+    double totalMs = 0.0;
+    for (size_t i = 0; i < chain.size(); i++) {
+      const mipgen::MipLevel &mip = chain[i];
+      artx::Level level{mip.width, mip.height, {}};
+      rawBytes += mip.rgba.size();
+
+      if (format == artx::Format::eRGBA8) {
+        level.data = mip.rgba;
+      } else {
+        start = std::chrono::high_resolution_clock::now();
+        level.data =
+            bcn::compress(mip.rgba, mip.width, mip.height, codec, pool);
+        const double ms = msSince(start);
+        totalMs += ms;
+
+        const double mpix = mip.width * static_cast<double>(mip.height) / 1e6;
+        const std::vector<uint8_t> decoded =
+            bcn::decompress(level.data, mip.width, mip.height, codec);
+        std::cout << "  mip " << std::setw(2) << i << " " << std::setw(5)
+                  << mip.width << "x" << std::left << std::setw(5)
+                  << mip.height << std::right << std::setprecision(2)
+                  << std::setw(9) << ms << " ms " << std::setprecision(1)
+                  << std::setw(8) << (ms > 0.0 ? mpix / (ms / 1000.0) : 0.0)
+                  << " MPix/s  PSNR " << std::setprecision(2)
+                  << psnr(mip.rgba, decoded) << " dB\n";
+      }
+      bakedBytes += level.data.size();
+      levels.push_back(std::move(level));
+    }
+
+    artx::write(outputPath, inputPath, format, levels);
+    std::cout << artx::name(format) << ": " << bakedBytes << " bytes ("
+              << std::setprecision(1) << 100.0 * bakedBytes / rawBytes
+              << "% of RGBA8 with mips), encode " << std::setprecision(1)
+              << totalMs << " ms on " << pool.size() << " threads -> "
+              << outputPath << "\n";
+  } catch (const std::exception &e) {
+    std::cerr << "texbake: " << e.what() << "\n";
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}